@@ -99,6 +99,10 @@ Cache<ItemObj>::clear() {
 template <typename ItemObj>
 void
 Cache<ItemObj>::print() {
+    // called around every query, skip the cache lock when the line would not be written
+    if (!LogLevelEnabled(el::Level::Debug)) {
+        return;
+    }
     std::lock_guard<std::mutex> lock(mutex_);
     size_t cache_count = lru_.size();
     // for (auto it = lru_.begin(); it != lru_.end(); ++it) {
@@ -23,6 +23,7 @@
 #include "IdBloomFilterFormat.h"
 #include "IdIndexFormat.h"
 #include "VectorIndexFormat.h"
+#include "VectorSummaryFormat.h"
 #include "VectorsFormat.h"
 #include "utils/Exception.h"
 
@@ -60,6 +61,16 @@ class Codec {
     GetIdBloomFilterFormat() {
         throw Exception(SERVER_UNSUPPORTED_ERROR, "id bloom filter not supported");
     }
+
+    virtual IdIndexFormatPtr
+    GetIdIndexFormat() {
+        throw Exception(SERVER_UNSUPPORTED_ERROR, "id index not supported");
+    }
+
+    virtual VectorSummaryFormatPtr
+    GetVectorSummaryFormat() {
+        throw Exception(SERVER_UNSUPPORTED_ERROR, "vector summary not supported");
+    }
 };
 
 }  // namespace codec
@@ -22,6 +22,7 @@
 #include <unistd.h>
 #include <algorithm>
 #include <memory>
+#include <utility>
 
 #include <boost/filesystem.hpp>
 
@@ -72,8 +73,7 @@ DefaultAttrsFormat::read_uids_internal(const storage::FSHandlerPtr& fs_ptr, cons
 
     uids.resize(num_bytes / sizeof(int64_t));
     fs_ptr->reader_ptr_->read(uids.data(), num_bytes);
-
-    fs_ptr->reader_ptr_->read(uids.data(), num_bytes);
+    fs_ptr->reader_ptr_->close();
 }
 
 void
@@ -110,7 +110,7 @@ DefaultAttrsFormat::read(const milvus::storage::FSHandlerPtr& fs_ptr, milvus::se
             size_t nbytes;
             read_attrs_internal(fs_ptr, path.string(), 0, INT64_MAX, attr_list, nbytes);
             milvus::segment::AttrPtr attr =
-                std::make_shared<milvus::segment::Attr>(attr_list, nbytes, uids, field_name);
+                std::make_shared<milvus::segment::Attr>(std::move(attr_list), nbytes, uids, field_name);
             attrs_read->attrs.insert(std::pair(field_name, attr));
         }
     }
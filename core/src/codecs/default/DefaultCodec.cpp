@@ -23,7 +23,9 @@
 #include "DefaultAttrsIndexFormat.h"
 #include "DefaultDeletedDocsFormat.h"
 #include "DefaultIdBloomFilterFormat.h"
+#include "DefaultIdIndexFormat.h"
 #include "DefaultVectorIndexFormat.h"
+#include "DefaultVectorSummaryFormat.h"
 #include "DefaultVectorsFormat.h"
 
 namespace milvus {
@@ -42,6 +44,8 @@ DefaultCodec::DefaultCodec() {
     attrs_index_format_ptr_ = std::make_shared<DefaultAttrsIndexFormat>();
     deleted_docs_format_ptr_ = std::make_shared<DefaultDeletedDocsFormat>();
     id_bloom_filter_format_ptr_ = std::make_shared<DefaultIdBloomFilterFormat>();
+    id_index_format_ptr_ = std::make_shared<DefaultIdIndexFormat>();
+    vector_summary_format_ptr_ = std::make_shared<DefaultVectorSummaryFormat>();
 }
 
 VectorsFormatPtr
@@ -74,5 +78,15 @@ DefaultCodec::GetIdBloomFilterFormat() {
     return id_bloom_filter_format_ptr_;
 }
 
+IdIndexFormatPtr
+DefaultCodec::GetIdIndexFormat() {
+    return id_index_format_ptr_;
+}
+
+VectorSummaryFormatPtr
+DefaultCodec::GetVectorSummaryFormat() {
+    return vector_summary_format_ptr_;
+}
+
 }  // namespace codec
 }  // namespace milvus
@@ -18,13 +18,18 @@
 #include "codecs/default/DefaultDeletedDocsFormat.h"
 
 #include <fcntl.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 #define BOOST_NO_CXX11_SCOPED_ENUMS
 #include <boost/filesystem.hpp>
 #undef BOOST_NO_CXX11_SCOPED_ENUMS
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "segment/Types.h"
@@ -34,112 +39,364 @@
 namespace milvus {
 namespace codec {
 
+namespace {
+
+constexpr uint32_t BITMAP_MAGIC = 0x4d424444;  // "DDBM"
+constexpr uint32_t BITMAP_VERSION = 1;
+constexpr uint32_t DELTA_MAGIC = 0x544c4544;  // "DELT"
+
+// the bitmap is cut into chunks of 64K bits, a sparse chunk keeps the low 16 bits of its offsets
+constexpr size_t CHUNK_SHIFT = 16;
+constexpr size_t CHUNK_BYTES = (1 << CHUNK_SHIFT) / 8;
+constexpr size_t ARRAY_CHUNK_MAX = CHUNK_BYTES / sizeof(uint16_t);
+
+// deltas are appended until they outgrow the base bitmap, and at least this many bytes
+constexpr size_t MIN_DELTA_BYTES = 64 * 1024;
+
+struct BitmapHeader {
+    uint32_t magic_ = BITMAP_MAGIC;
+    uint32_t version_ = BITMAP_VERSION;
+    uint64_t count_ = 0;       // deleted docs in the base bitmap
+    uint64_t num_bytes_ = 0;   // bytes of the decoded bitmap
+    uint64_t num_chunks_ = 0;  // non-empty chunks following the header
+    uint64_t base_bytes_ = 0;  // header and chunks, delta records start here
+};
+
+struct ChunkHeader {
+    uint32_t index_;
+    uint32_t cardinality_;
+};
+
+struct DeltaHeader {
+    uint32_t magic_ = DELTA_MAGIC;
+    uint32_t count_ = 0;
+};
+
 void
-DefaultDeletedDocsFormat::read(const storage::FSHandlerPtr& fs_ptr, segment::DeletedDocsPtr& deleted_docs) {
-    std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
-    const std::string del_file_path = dir_path + "/" + deleted_docs_filename_;
+ThrowIOError(ErrorCode code, const std::string& action, const std::string& path) {
+    std::string err_msg = "Failed to " + action + " file: " + path + ", error: " + std::strerror(errno);
+    LOG_ENGINE_ERROR_ << err_msg;
+    throw Exception(code, err_msg);
+}
+
+void
+ThrowCorrupted(const std::string& path) {
+    std::string err_msg = "Corrupted deleted docs file: " + path;
+    LOG_ENGINE_ERROR_ << err_msg;
+    throw Exception(SERVER_UNEXPECTED_ERROR, err_msg);
+}
 
-    int del_fd = open(del_file_path.c_str(), O_RDONLY, 00664);
-    if (del_fd == -1) {
-        std::string err_msg = "Failed to open file: " + del_file_path + ", error: " + std::strerror(errno);
-        LOG_ENGINE_ERROR_ << err_msg;
-        throw Exception(SERVER_CANNOT_CREATE_FILE, err_msg);
+// returns -1 if the file does not exist
+int
+OpenFile(const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1 && errno != ENOENT) {
+        ThrowIOError(SERVER_CANNOT_OPEN_FILE, "open", path);
     }
+    return fd;
+}
 
-    size_t num_bytes;
-    if (::read(del_fd, &num_bytes, sizeof(size_t)) == -1) {
-        std::string err_msg = "Failed to read from file: " + del_file_path + ", error: " + std::strerror(errno);
-        LOG_ENGINE_ERROR_ << err_msg;
-        throw Exception(SERVER_WRITE_ERROR, err_msg);
+size_t
+FileSize(int fd, const std::string& path) {
+    struct stat st;
+    if (fstat(fd, &st) == -1) {
+        ::close(fd);
+        ThrowIOError(SERVER_CANNOT_OPEN_FILE, "stat", path);
     }
+    return st.st_size;
+}
 
-    auto deleted_docs_size = num_bytes / sizeof(segment::offset_t);
-    std::vector<segment::offset_t> deleted_docs_list;
-    deleted_docs_list.resize(deleted_docs_size);
+// reads max_bytes from offset at most
+void
+ReadAt(int fd, const std::string& path, size_t offset, size_t max_bytes, std::vector<uint8_t>& buffer) {
+    auto file_size = FileSize(fd, path);
+    buffer.resize(offset < file_size ? std::min(file_size - offset, max_bytes) : 0);
 
-    if (::read(del_fd, deleted_docs_list.data(), num_bytes) == -1) {
-        std::string err_msg = "Failed to read from file: " + del_file_path + ", error: " + std::strerror(errno);
-        LOG_ENGINE_ERROR_ << err_msg;
-        throw Exception(SERVER_WRITE_ERROR, err_msg);
+    size_t done = 0;
+    while (done < buffer.size()) {
+        auto n = ::pread(fd, buffer.data() + done, buffer.size() - done, offset + done);
+        if (n == -1) {
+            ::close(fd);
+            ThrowIOError(SERVER_WRITE_ERROR, "read from", path);
+        }
+        if (n == 0) {
+            break;
+        }
+        done += n;
     }
+    buffer.resize(done);
+}
 
-    deleted_docs = std::make_shared<segment::DeletedDocs>(deleted_docs_list);
+void
+CloseFile(int fd, const std::string& path) {
+    if (::close(fd) == -1) {
+        ThrowIOError(SERVER_WRITE_ERROR, "close", path);
+    }
+}
 
-    if (::close(del_fd) == -1) {
-        std::string err_msg = "Failed to close file: " + del_file_path + ", error: " + std::strerror(errno);
-        LOG_ENGINE_ERROR_ << err_msg;
-        throw Exception(SERVER_WRITE_ERROR, err_msg);
+// reads max_bytes of a file at most, returns false if it does not exist
+bool
+ReadFile(const std::string& path, std::vector<uint8_t>& buffer, size_t max_bytes = SIZE_MAX) {
+    int fd = OpenFile(path);
+    if (fd == -1) {
+        return false;
     }
+    ReadAt(fd, path, 0, max_bytes, buffer);
+    CloseFile(fd, path);
+    return true;
 }
 
+// header of a bitmap file, validated against the file size
 void
-DefaultDeletedDocsFormat::write(const storage::FSHandlerPtr& fs_ptr, const segment::DeletedDocsPtr& deleted_docs) {
-    std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
-    const std::string del_file_path = dir_path + "/" + deleted_docs_filename_;
+ReadHeader(const std::vector<uint8_t>& buffer, size_t file_size, const std::string& path, BitmapHeader& header) {
+    if (buffer.size() < sizeof(BitmapHeader)) {
+        ThrowCorrupted(path);
+    }
+    memcpy(&header, buffer.data(), sizeof(BitmapHeader));
+    if (header.magic_ != BITMAP_MAGIC || header.version_ != BITMAP_VERSION || header.base_bytes_ > file_size) {
+        ThrowCorrupted(path);
+    }
+}
 
-    // Create a temporary file from the existing file
-    const std::string temp_path = dir_path + "/" + "temp_del";
-    bool exists = boost::filesystem::exists(del_file_path);
-    if (exists) {
-        boost::filesystem::copy_file(del_file_path, temp_path, boost::filesystem::copy_option::fail_if_exists);
+void
+WriteFile(const std::string& path, const uint8_t* data, size_t size, int flags) {
+    int fd = open(path.c_str(), flags, 00664);
+    if (fd == -1) {
+        ThrowIOError(SERVER_CANNOT_CREATE_FILE, "open", path);
+    }
+    // a single write, readers ignore an incomplete record at the tail
+    if (::write(fd, data, size) != static_cast<ssize_t>(size)) {
+        ::close(fd);
+        ThrowIOError(SERVER_WRITE_ERROR, "write to", path);
+    }
+    if (::close(fd) == -1) {
+        ThrowIOError(SERVER_WRITE_ERROR, "close", path);
+    }
+}
+
+// sets the bits of offsets in bitmap, growing it as needed, and counts the bits newly set
+void
+SetBits(std::vector<uint8_t>& bitmap, const segment::offset_t* offsets, size_t n, size_t& count) {
+    for (size_t i = 0; i < n; ++i) {
+        if (offsets[i] < 0) {
+            continue;
+        }
+        size_t byte = offsets[i] >> 3;
+        uint8_t mask = 0x1 << (offsets[i] & 0x7);
+        if (byte >= bitmap.size()) {
+            bitmap.resize(byte + 1, 0);
+        }
+        if (!(bitmap[byte] & mask)) {
+            bitmap[byte] |= mask;
+            ++count;
+        }
     }
+}
+
+void
+EncodeBitmap(const std::vector<uint8_t>& bitmap, size_t count, std::vector<uint8_t>& buffer) {
+    BitmapHeader header;
+    header.count_ = count;
+    header.num_bytes_ = bitmap.size();
 
-    // Write to the temp file, in order to avoid possible race condition with search (concurrent read and write)
-    int del_fd = open(temp_path.c_str(), O_RDWR | O_CREAT, 00664);
-    if (del_fd == -1) {
-        std::string err_msg = "Failed to open file: " + temp_path + ", error: " + std::strerror(errno);
-        LOG_ENGINE_ERROR_ << err_msg;
-        throw Exception(SERVER_CANNOT_CREATE_FILE, err_msg);
+    buffer.resize(sizeof(BitmapHeader));
+    for (size_t begin = 0; begin < bitmap.size(); begin += CHUNK_BYTES) {
+        size_t end = std::min(begin + CHUNK_BYTES, bitmap.size());
+        ChunkHeader chunk{static_cast<uint32_t>(begin / CHUNK_BYTES), 0};
+        for (size_t i = begin; i < end; ++i) {
+            chunk.cardinality_ += __builtin_popcount(bitmap[i]);
+        }
+        if (chunk.cardinality_ == 0) {
+            continue;
+        }
+
+        auto pos = buffer.size();
+        if (chunk.cardinality_ <= ARRAY_CHUNK_MAX) {
+            buffer.resize(pos + sizeof(ChunkHeader) + chunk.cardinality_ * sizeof(uint16_t));
+            auto lows = reinterpret_cast<uint16_t*>(buffer.data() + pos + sizeof(ChunkHeader));
+            for (size_t i = begin; i < end; ++i) {
+                for (uint32_t byte = bitmap[i]; byte != 0; byte &= byte - 1) {
+                    *lows++ = static_cast<uint16_t>(((i - begin) << 3) + __builtin_ctz(byte));
+                }
+            }
+        } else {
+            buffer.resize(pos + sizeof(ChunkHeader) + CHUNK_BYTES, 0);
+            memcpy(buffer.data() + pos + sizeof(ChunkHeader), bitmap.data() + begin, end - begin);
+        }
+        memcpy(buffer.data() + pos, &chunk, sizeof(ChunkHeader));
+        ++header.num_chunks_;
     }
 
-    size_t old_num_bytes;
-    if (exists) {
-        if (::read(del_fd, &old_num_bytes, sizeof(size_t)) == -1) {
-            std::string err_msg = "Failed to read from file: " + temp_path + ", error: " + std::strerror(errno);
-            LOG_ENGINE_ERROR_ << err_msg;
-            throw Exception(SERVER_WRITE_ERROR, err_msg);
+    header.base_bytes_ = buffer.size();
+    memcpy(buffer.data(), &header, sizeof(BitmapHeader));
+}
+
+// decodes the base bitmap and folds in the complete delta records
+void
+DecodeBitmap(const std::vector<uint8_t>& buffer, const std::string& path, std::vector<uint8_t>& bitmap,
+             size_t& count) {
+    BitmapHeader header;
+    ReadHeader(buffer, buffer.size(), path, header);
+
+    bitmap.assign(header.num_bytes_, 0);
+    count = header.count_;
+    size_t pos = sizeof(BitmapHeader);
+    for (uint64_t c = 0; c < header.num_chunks_; ++c) {
+        ChunkHeader chunk;
+        if (pos + sizeof(ChunkHeader) > header.base_bytes_) {
+            ThrowCorrupted(path);
+        }
+        memcpy(&chunk, buffer.data() + pos, sizeof(ChunkHeader));
+        pos += sizeof(ChunkHeader);
+
+        size_t begin = static_cast<size_t>(chunk.index_) * CHUNK_BYTES;
+        if (begin >= bitmap.size()) {
+            ThrowCorrupted(path);
+        }
+        if (chunk.cardinality_ <= ARRAY_CHUNK_MAX) {
+            if (pos + chunk.cardinality_ * sizeof(uint16_t) > header.base_bytes_) {
+                ThrowCorrupted(path);
+            }
+            for (uint32_t i = 0; i < chunk.cardinality_; ++i) {
+                uint16_t low;
+                memcpy(&low, buffer.data() + pos + i * sizeof(uint16_t), sizeof(uint16_t));
+                size_t byte = begin + (low >> 3);
+                if (byte < bitmap.size()) {
+                    bitmap[byte] |= 0x1 << (low & 0x7);
+                }
+            }
+            pos += chunk.cardinality_ * sizeof(uint16_t);
+        } else {
+            if (pos + CHUNK_BYTES > header.base_bytes_) {
+                ThrowCorrupted(path);
+            }
+            memcpy(bitmap.data() + begin, buffer.data() + pos, std::min(CHUNK_BYTES, bitmap.size() - begin));
+            pos += CHUNK_BYTES;
         }
-    } else {
-        old_num_bytes = 0;
     }
 
-    auto deleted_docs_list = deleted_docs->GetDeletedDocs();
-    size_t new_num_bytes = old_num_bytes + sizeof(segment::offset_t) * deleted_docs->GetSize();
+    pos = header.base_bytes_;
+    while (pos + sizeof(DeltaHeader) <= buffer.size()) {
+        DeltaHeader delta;
+        memcpy(&delta, buffer.data() + pos, sizeof(DeltaHeader));
+        if (delta.magic_ != DELTA_MAGIC) {
+            ThrowCorrupted(path);
+        }
+        pos += sizeof(DeltaHeader);
+        if (pos + delta.count_ * sizeof(segment::offset_t) > buffer.size()) {
+            break;  // being appended
+        }
+        std::vector<segment::offset_t> offsets(delta.count_);
+        memcpy(offsets.data(), buffer.data() + pos, delta.count_ * sizeof(segment::offset_t));
+        SetBits(bitmap, offsets.data(), offsets.size(), count);
+        pos += delta.count_ * sizeof(segment::offset_t);
+    }
+}
 
-    // rewind and overwrite with the new_num_bytes
-    int off = lseek(del_fd, 0, SEEK_SET);
-    if (off == -1) {
-        std::string err_msg = "Failed to seek file: " + temp_path + ", error: " + std::strerror(errno);
-        LOG_ENGINE_ERROR_ << err_msg;
-        throw Exception(SERVER_WRITE_ERROR, err_msg);
+// the legacy file is a byte count followed by the offsets
+void
+DecodeLegacy(const std::vector<uint8_t>& buffer, const std::string& path, std::vector<segment::offset_t>& offsets) {
+    size_t num_bytes;
+    if (buffer.size() < sizeof(size_t)) {
+        ThrowCorrupted(path);
     }
-    if (::write(del_fd, &new_num_bytes, sizeof(size_t)) == -1) {
-        std::string err_msg = "Failed to write to file" + temp_path + ", error: " + std::strerror(errno);
-        LOG_ENGINE_ERROR_ << err_msg;
-        throw Exception(SERVER_WRITE_ERROR, err_msg);
+    memcpy(&num_bytes, buffer.data(), sizeof(size_t));
+    num_bytes = std::min(num_bytes, buffer.size() - sizeof(size_t));
+    offsets.resize(num_bytes / sizeof(segment::offset_t));
+    memcpy(offsets.data(), buffer.data() + sizeof(size_t), offsets.size() * sizeof(segment::offset_t));
+}
+
+}  // namespace
+
+void
+DefaultDeletedDocsFormat::read(const storage::FSHandlerPtr& fs_ptr, segment::DeletedDocsPtr& deleted_docs) {
+    std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
+    const std::string del_file_path = dir_path + "/" + deleted_docs_filename_;
+
+    std::vector<uint8_t> buffer;
+    if (ReadFile(del_file_path, buffer)) {
+        std::vector<uint8_t> bitmap;
+        size_t count = 0;
+        DecodeBitmap(buffer, del_file_path, bitmap, count);
+        deleted_docs = std::make_shared<segment::DeletedDocs>(std::move(bitmap), count);
+        return;
     }
 
-    // Move to the end of file and append
-    off = lseek(del_fd, 0, SEEK_END);
-    if (off == -1) {
-        std::string err_msg = "Failed to seek file: " + temp_path + ", error: " + std::strerror(errno);
-        LOG_ENGINE_ERROR_ << err_msg;
-        throw Exception(SERVER_WRITE_ERROR, err_msg);
+    const std::string legacy_file_path = dir_path + "/" + legacy_deleted_docs_filename_;
+    if (!ReadFile(legacy_file_path, buffer)) {
+        // the legacy file is removed right after a migration
+        if (ReadFile(del_file_path, buffer)) {
+            std::vector<uint8_t> bitmap;
+            size_t count = 0;
+            DecodeBitmap(buffer, del_file_path, bitmap, count);
+            deleted_docs = std::make_shared<segment::DeletedDocs>(std::move(bitmap), count);
+            return;
+        }
+        ThrowIOError(SERVER_CANNOT_CREATE_FILE, "open", del_file_path);
     }
-    if (::write(del_fd, deleted_docs_list.data(), sizeof(segment::offset_t) * deleted_docs->GetSize()) == -1) {
-        std::string err_msg = "Failed to write to file" + temp_path + ", error: " + std::strerror(errno);
-        LOG_ENGINE_ERROR_ << err_msg;
-        throw Exception(SERVER_WRITE_ERROR, err_msg);
+    std::vector<segment::offset_t> deleted_docs_list;
+    DecodeLegacy(buffer, legacy_file_path, deleted_docs_list);
+    deleted_docs = std::make_shared<segment::DeletedDocs>(deleted_docs_list);
+}
+
+void
+DefaultDeletedDocsFormat::write(const storage::FSHandlerPtr& fs_ptr, const segment::DeletedDocsPtr& deleted_docs) {
+    std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
+    const std::string del_file_path = dir_path + "/" + deleted_docs_filename_;
+    auto& deleted_docs_list = deleted_docs->GetDeletedDocs();
+
+    struct stat st;
+    if (stat(del_file_path.c_str(), &st) == 0) {
+        if (deleted_docs_list.empty()) {
+            return;
+        }
+
+        std::vector<uint8_t> buffer;
+        ReadFile(del_file_path, buffer, sizeof(BitmapHeader));
+        BitmapHeader header;
+        ReadHeader(buffer, st.st_size, del_file_path, header);
+
+        DeltaHeader delta;
+        delta.count_ = deleted_docs_list.size();
+        size_t delta_bytes = st.st_size - header.base_bytes_;
+        size_t record_bytes = sizeof(DeltaHeader) + delta.count_ * sizeof(segment::offset_t);
+        if (delta_bytes + record_bytes <= std::max<size_t>(header.base_bytes_, MIN_DELTA_BYTES)) {
+            // append a delta record, only the new offsets are written
+            buffer.resize(record_bytes);
+            memcpy(buffer.data(), &delta, sizeof(DeltaHeader));
+            memcpy(buffer.data() + sizeof(DeltaHeader), deleted_docs_list.data(),
+                   delta.count_ * sizeof(segment::offset_t));
+            WriteFile(del_file_path, buffer.data(), buffer.size(), O_WRONLY | O_APPEND);
+            return;
+        }
+
+        // fold the deltas into a new base bitmap
+        std::vector<uint8_t> bitmap;
+        size_t count = 0;
+        ReadFile(del_file_path, buffer);
+        DecodeBitmap(buffer, del_file_path, bitmap, count);
+        SetBits(bitmap, deleted_docs_list.data(), deleted_docs_list.size(), count);
+        consolidate(dir_path, bitmap, count);
+        return;
     }
 
-    if (::close(del_fd) == -1) {
-        std::string err_msg = "Failed to close file: " + temp_path + ", error: " + std::strerror(errno);
-        LOG_ENGINE_ERROR_ << err_msg;
-        throw Exception(SERVER_WRITE_ERROR, err_msg);
+    // first write of the segment, or migration from the legacy offset list
+    std::vector<uint8_t> bitmap;
+    size_t count = 0;
+    const std::string legacy_file_path = dir_path + "/" + legacy_deleted_docs_filename_;
+    std::vector<uint8_t> buffer;
+    bool legacy = ReadFile(legacy_file_path, buffer);
+    if (legacy) {
+        std::vector<segment::offset_t> legacy_list;
+        DecodeLegacy(buffer, legacy_file_path, legacy_list);
+        SetBits(bitmap, legacy_list.data(), legacy_list.size(), count);
     }
+    SetBits(bitmap, deleted_docs_list.data(), deleted_docs_list.size(), count);
+    consolidate(dir_path, bitmap, count);
 
-    // Move temp file to delete file
-    boost::filesystem::rename(temp_path, del_file_path);
+    if (legacy) {
+        boost::filesystem::remove(legacy_file_path);
+    }
 }
 
 void
@@ -147,27 +404,53 @@ DefaultDeletedDocsFormat::readSize(const storage::FSHandlerPtr& fs_ptr, size_t&
     std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
     const std::string del_file_path = dir_path + "/" + deleted_docs_filename_;
 
-    int del_fd = open(del_file_path.c_str(), O_RDONLY, 00664);
-    if (del_fd == -1) {
-        std::string err_msg = "Failed to open file: " + del_file_path + ", error: " + std::strerror(errno);
-        LOG_ENGINE_ERROR_ << err_msg;
-        throw Exception(SERVER_CANNOT_CREATE_FILE, err_msg);
-    }
+    std::vector<uint8_t> buffer;
+    int del_fd = OpenFile(del_file_path);
+    if (del_fd != -1) {
+        // the base count is exact, a delta may repeat offsets of the base or of another delta, so it is only
+        // counted after it is folded into the bitmap the way read() does
+        auto file_size = FileSize(del_fd, del_file_path);
+        ReadAt(del_fd, del_file_path, 0, sizeof(BitmapHeader), buffer);
+        CloseFile(del_fd, del_file_path);
+        BitmapHeader header;
+        ReadHeader(buffer, file_size, del_file_path, header);
+        if (header.base_bytes_ + sizeof(DeltaHeader) > file_size) {
+            size = header.count_;
+            return;
+        }
 
-    size_t num_bytes;
-    if (::read(del_fd, &num_bytes, sizeof(size_t)) == -1) {
-        std::string err_msg = "Failed to read from file: " + del_file_path + ", error: " + std::strerror(errno);
-        LOG_ENGINE_ERROR_ << err_msg;
-        throw Exception(SERVER_WRITE_ERROR, err_msg);
+        if (!ReadFile(del_file_path, buffer)) {
+            ThrowIOError(SERVER_CANNOT_OPEN_FILE, "open", del_file_path);
+        }
+        std::vector<uint8_t> bitmap;
+        DecodeBitmap(buffer, del_file_path, bitmap, size);
+        return;
     }
 
+    const std::string legacy_file_path = dir_path + "/" + legacy_deleted_docs_filename_;
+    if (!ReadFile(legacy_file_path, buffer, sizeof(size_t))) {
+        ThrowIOError(SERVER_CANNOT_CREATE_FILE, "open", del_file_path);
+    }
+    size_t num_bytes = 0;
+    if (buffer.size() == sizeof(size_t)) {
+        memcpy(&num_bytes, buffer.data(), sizeof(size_t));
+    }
     size = num_bytes / sizeof(segment::offset_t);
+}
 
-    if (::close(del_fd) == -1) {
-        std::string err_msg = "Failed to close file: " + del_file_path + ", error: " + std::strerror(errno);
-        LOG_ENGINE_ERROR_ << err_msg;
-        throw Exception(SERVER_WRITE_ERROR, err_msg);
-    }
+void
+DefaultDeletedDocsFormat::consolidate(const std::string& dir_path, const std::vector<uint8_t>& bitmap,
+                                      size_t count) {
+    const std::string del_file_path = dir_path + "/" + deleted_docs_filename_;
+
+    // Write to a temporary file, in order to avoid possible race condition with search (concurrent read and write)
+    const std::string temp_path = dir_path + "/" + "temp_del";
+    std::vector<uint8_t> buffer;
+    EncodeBitmap(bitmap, count, buffer);
+    WriteFile(temp_path, buffer.data(), buffer.size(), O_WRONLY | O_CREAT | O_TRUNC);
+
+    // Move temp file to delete file
+    boost::filesystem::rename(temp_path, del_file_path);
 }
 
 }  // namespace codec
@@ -18,12 +18,16 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "codecs/DeletedDocsFormat.h"
 
 namespace milvus {
 namespace codec {
 
+// Deleted docs are stored as a compressed bitmap followed by the delta records appended by later writes.
+// The deltas are folded into the bitmap once they outgrow it. Segments still holding the legacy offset
+// list file are read as is and migrated on their next write.
 class DefaultDeletedDocsFormat : public DeletedDocsFormat {
  public:
     DefaultDeletedDocsFormat() = default;
@@ -47,7 +51,12 @@ class DefaultDeletedDocsFormat : public DeletedDocsFormat {
     operator=(DefaultDeletedDocsFormat&&) = delete;
 
  private:
-    const std::string deleted_docs_filename_ = "deleted_docs";
+    void
+    consolidate(const std::string& dir_path, const std::vector<uint8_t>& bitmap, size_t count);
+
+ private:
+    const std::string deleted_docs_filename_ = "deleted_docs_bitmap";
+    const std::string legacy_deleted_docs_filename_ = "deleted_docs";
 };
 
 }  // namespace codec
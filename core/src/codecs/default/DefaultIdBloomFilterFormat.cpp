@@ -17,9 +17,18 @@
 
 #include "codecs/default/DefaultIdBloomFilterFormat.h"
 
+#include <fcntl.h>
 #include <fiu-local.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define BOOST_NO_CXX11_SCOPED_ENUMS
+#include <boost/filesystem.hpp>
+#undef BOOST_NO_CXX11_SCOPED_ENUMS
+#include <cstring>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "utils/Exception.h"
 #include "utils/Log.h"
@@ -27,21 +36,72 @@
 namespace milvus {
 namespace codec {
 
+// parameters of the legacy scaling bloom filter
 constexpr unsigned int bloom_filter_capacity = 500000;
 constexpr double bloom_filter_error_rate = 0.01;
 
+namespace {
+
+constexpr uint32_t BLOOM_FILTER_MAGIC = 0x4d4f4c42;  // "BLOM"
+constexpr uint32_t BLOOM_FILTER_VERSION = 1;
+
+struct BloomFilterHeader {
+    uint32_t magic_ = BLOOM_FILTER_MAGIC;
+    uint32_t version_ = BLOOM_FILTER_VERSION;
+    uint64_t block_words_ = segment::IdBloomFilter::BLOCK_WORDS;
+    uint64_t num_blocks_ = 0;
+};
+
+void
+ThrowBloomFilterError(const std::string& action, const std::string& path) {
+    std::string err_msg = "Failed to " + action + " bloom filter file: " + path + ". " + std::strerror(errno);
+    LOG_ENGINE_ERROR_ << err_msg;
+    throw Exception(SERVER_UNEXPECTED_ERROR, err_msg);
+}
+
+}  // namespace
+
 void
 DefaultIdBloomFilterFormat::read(const storage::FSHandlerPtr& fs_ptr, segment::IdBloomFilterPtr& id_bloom_filter_ptr) {
     std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
     const std::string bloom_filter_file_path = dir_path + "/" + bloom_filter_filename_;
+
+    int fd = open(bloom_filter_file_path.c_str(), O_RDONLY);
+    fiu_do_on("bloom_filter_nullptr", {
+        if (fd != -1) {
+            ::close(fd);
+        }
+        fd = -1;
+        errno = EIO;
+    });
+    if (fd != -1) {
+        BloomFilterHeader header;
+        std::vector<uint64_t> blocks;
+        bool valid = ::read(fd, &header, sizeof(header)) == sizeof(header) && header.magic_ == BLOOM_FILTER_MAGIC &&
+                     header.version_ == BLOOM_FILTER_VERSION &&
+                     header.block_words_ == segment::IdBloomFilter::BLOCK_WORDS && header.num_blocks_ > 0;
+        if (valid) {
+            size_t num_bytes = header.num_blocks_ * header.block_words_ * sizeof(uint64_t);
+            blocks.resize(header.num_blocks_ * header.block_words_);
+            valid = ::read(fd, blocks.data(), num_bytes) == static_cast<ssize_t>(num_bytes);
+        }
+        ::close(fd);
+        if (!valid) {
+            ThrowBloomFilterError("read", bloom_filter_file_path);
+        }
+        id_bloom_filter_ptr = std::make_shared<segment::IdBloomFilter>(blocks.data(), header.num_blocks_);
+        return;
+    }
+    if (errno != ENOENT) {
+        ThrowBloomFilterError("open", bloom_filter_file_path);
+    }
+
+    // segments written before the blocked filter
+    const std::string legacy_file_path = dir_path + "/" + legacy_bloom_filter_filename_;
     scaling_bloom_t* bloom_filter =
-        new_scaling_bloom_from_file(bloom_filter_capacity, bloom_filter_error_rate, bloom_filter_file_path.c_str());
-    fiu_do_on("bloom_filter_nullptr", bloom_filter = nullptr);
+        new_scaling_bloom_from_file(bloom_filter_capacity, bloom_filter_error_rate, legacy_file_path.c_str());
     if (bloom_filter == nullptr) {
-        std::string err_msg =
-            "Failed to read bloom filter from file: " + bloom_filter_file_path + ". " + std::strerror(errno);
-        LOG_ENGINE_ERROR_ << err_msg;
-        throw Exception(SERVER_UNEXPECTED_ERROR, err_msg);
+        ThrowBloomFilterError("read", legacy_file_path);
     }
     id_bloom_filter_ptr = std::make_shared<segment::IdBloomFilter>(bloom_filter);
 }
@@ -50,29 +110,38 @@ void
 DefaultIdBloomFilterFormat::write(const storage::FSHandlerPtr& fs_ptr,
                                   const segment::IdBloomFilterPtr& id_bloom_filter_ptr) {
     std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
+    auto legacy_bloom_filter = id_bloom_filter_ptr->GetBloomFilter();
+    if (legacy_bloom_filter != nullptr) {
+        // the legacy filter is memory mapped on its file
+        if (scaling_bloom_flush(legacy_bloom_filter) == -1) {
+            ThrowBloomFilterError("write", dir_path + "/" + legacy_bloom_filter_filename_);
+        }
+        return;
+    }
+
     const std::string bloom_filter_file_path = dir_path + "/" + bloom_filter_filename_;
-    if (scaling_bloom_flush(id_bloom_filter_ptr->GetBloomFilter()) == -1) {
-        std::string err_msg =
-            "Failed to write bloom filter to file: " + bloom_filter_file_path + ". " + std::strerror(errno);
-        LOG_ENGINE_ERROR_ << err_msg;
-        throw Exception(SERVER_UNEXPECTED_ERROR, err_msg);
+    const std::string temp_path = bloom_filter_file_path + ".tmp";
+    int fd = open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 00664);
+    if (fd == -1) {
+        ThrowBloomFilterError("create", temp_path);
+    }
+
+    BloomFilterHeader header;
+    header.num_blocks_ = id_bloom_filter_ptr->GetBlockCount();
+    size_t num_bytes = header.num_blocks_ * header.block_words_ * sizeof(uint64_t);
+    bool ok = ::write(fd, &header, sizeof(header)) == sizeof(header) &&
+              ::write(fd, id_bloom_filter_ptr->GetBlocks(), num_bytes) == static_cast<ssize_t>(num_bytes);
+    if (::close(fd) == -1 || !ok) {
+        ThrowBloomFilterError("write", temp_path);
     }
+
+    boost::filesystem::rename(temp_path, bloom_filter_file_path);
 }
 
 void
-DefaultIdBloomFilterFormat::create(const storage::FSHandlerPtr& fs_ptr,
+DefaultIdBloomFilterFormat::create(const storage::FSHandlerPtr& fs_ptr, size_t capacity,
                                    segment::IdBloomFilterPtr& id_bloom_filter_ptr) {
-    std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
-    const std::string bloom_filter_file_path = dir_path + "/" + bloom_filter_filename_;
-    scaling_bloom_t* bloom_filter =
-        new_scaling_bloom(bloom_filter_capacity, bloom_filter_error_rate, bloom_filter_file_path.c_str());
-    if (bloom_filter == nullptr) {
-        std::string err_msg =
-            "Failed to read bloom filter from file: " + bloom_filter_file_path + ". " + std::strerror(errno);
-        LOG_ENGINE_ERROR_ << err_msg;
-        throw Exception(SERVER_UNEXPECTED_ERROR, err_msg);
-    }
-    id_bloom_filter_ptr = std::make_shared<segment::IdBloomFilter>(bloom_filter);
+    id_bloom_filter_ptr = std::make_shared<segment::IdBloomFilter>(capacity);
 }
 
 }  // namespace codec
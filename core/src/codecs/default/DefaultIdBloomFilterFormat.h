@@ -36,8 +36,10 @@ class DefaultIdBloomFilterFormat : public IdBloomFilterFormat {
     void
     write(const storage::FSHandlerPtr& fs_ptr, const segment::IdBloomFilterPtr& id_bloom_filter_ptr) override;
 
+    // a blocked filter sized for capacity ids
     void
-    create(const storage::FSHandlerPtr& fs_ptr, segment::IdBloomFilterPtr& id_bloom_filter_ptr) override;
+    create(const storage::FSHandlerPtr& fs_ptr, size_t capacity,
+           segment::IdBloomFilterPtr& id_bloom_filter_ptr) override;
 
     // No copy and move
     DefaultIdBloomFilterFormat(const DefaultIdBloomFilterFormat&) = delete;
@@ -49,7 +51,8 @@ class DefaultIdBloomFilterFormat : public IdBloomFilterFormat {
     operator=(DefaultIdBloomFilterFormat&&) = delete;
 
  private:
-    const std::string bloom_filter_filename_ = "bloom_filter";
+    const std::string bloom_filter_filename_ = "id_bloom_filter";
+    const std::string legacy_bloom_filter_filename_ = "bloom_filter";
 };
 
 }  // namespace codec
@@ -0,0 +1,129 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "codecs/default/DefaultIdIndexFormat.h"
+
+#include <fcntl.h>
+#include <fiu-local.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define BOOST_NO_CXX11_SCOPED_ENUMS
+#include <boost/filesystem.hpp>
+#undef BOOST_NO_CXX11_SCOPED_ENUMS
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "utils/Exception.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace codec {
+
+namespace {
+
+constexpr uint32_t ID_INDEX_MAGIC = 0x58444949;  // "IIDX"
+constexpr uint32_t ID_INDEX_VERSION = 1;
+
+// followed by count sorted uids, then the offset of every uid in the segment
+struct IdIndexHeader {
+    uint32_t magic_ = ID_INDEX_MAGIC;
+    uint32_t version_ = ID_INDEX_VERSION;
+    uint64_t count_ = 0;
+};
+
+void
+ThrowIdIndexError(const std::string& action, const std::string& path) {
+    std::string err_msg = "Failed to " + action + " id index file: " + path + ". " + std::strerror(errno);
+    LOG_ENGINE_ERROR_ << err_msg;
+    throw Exception(SERVER_UNEXPECTED_ERROR, err_msg);
+}
+
+}  // namespace
+
+void
+DefaultIdIndexFormat::read(const storage::FSHandlerPtr& fs_ptr, segment::IdIndexPtr& id_index_ptr) {
+    std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
+    const std::string id_index_file_path = dir_path + "/" + id_index_filename_;
+
+    id_index_ptr = nullptr;
+    int fd = open(id_index_file_path.c_str(), O_RDONLY);
+    fiu_do_on("DefaultIdIndexFormat.read.open_fail", {
+        if (fd != -1) {
+            ::close(fd);
+        }
+        fd = -1;
+        errno = EIO;
+    });
+    if (fd == -1) {
+        if (errno == ENOENT) {
+            return;  // segments written before the id index
+        }
+        ThrowIdIndexError("open", id_index_file_path);
+    }
+
+    IdIndexHeader header;
+    std::vector<segment::doc_id_t> uids;
+    std::vector<segment::offset_t> offsets;
+    bool valid = ::read(fd, &header, sizeof(header)) == sizeof(header) && header.magic_ == ID_INDEX_MAGIC &&
+                 header.version_ == ID_INDEX_VERSION;
+    if (valid) {
+        uids.resize(header.count_);
+        offsets.resize(header.count_);
+        ssize_t uids_bytes = header.count_ * sizeof(segment::doc_id_t);
+        ssize_t offsets_bytes = header.count_ * sizeof(segment::offset_t);
+        valid = ::read(fd, uids.data(), uids_bytes) == uids_bytes &&
+                ::read(fd, offsets.data(), offsets_bytes) == offsets_bytes;
+    }
+    ::close(fd);
+    if (!valid) {
+        ThrowIdIndexError("read", id_index_file_path);
+    }
+
+    id_index_ptr = std::make_shared<segment::IdIndex>(std::move(uids), std::move(offsets));
+}
+
+void
+DefaultIdIndexFormat::write(const storage::FSHandlerPtr& fs_ptr, const segment::IdIndexPtr& id_index_ptr) {
+    std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
+    const std::string id_index_file_path = dir_path + "/" + id_index_filename_;
+    const std::string temp_path = id_index_file_path + ".tmp";
+
+    int fd = open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 00664);
+    if (fd == -1) {
+        ThrowIdIndexError("create", temp_path);
+    }
+
+    IdIndexHeader header;
+    header.count_ = id_index_ptr->Count();
+    ssize_t uids_bytes = header.count_ * sizeof(segment::doc_id_t);
+    ssize_t offsets_bytes = header.count_ * sizeof(segment::offset_t);
+    bool ok = ::write(fd, &header, sizeof(header)) == sizeof(header) &&
+              ::write(fd, id_index_ptr->GetUids().data(), uids_bytes) == uids_bytes &&
+              ::write(fd, id_index_ptr->GetOffsets().data(), offsets_bytes) == offsets_bytes;
+    if (::close(fd) == -1 || !ok) {
+        ThrowIdIndexError("write", temp_path);
+    }
+
+    boost::filesystem::rename(temp_path, id_index_file_path);
+}
+
+}  // namespace codec
+}  // namespace milvus
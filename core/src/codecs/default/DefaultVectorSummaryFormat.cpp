@@ -0,0 +1,133 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "codecs/default/DefaultVectorSummaryFormat.h"
+
+#include <fcntl.h>
+#include <fiu-local.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define BOOST_NO_CXX11_SCOPED_ENUMS
+#include <boost/filesystem.hpp>
+#undef BOOST_NO_CXX11_SCOPED_ENUMS
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "utils/Exception.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace codec {
+
+namespace {
+
+constexpr uint32_t VECTOR_SUMMARY_MAGIC = 0x4d4d5356;  // "VSMM"
+constexpr uint32_t VECTOR_SUMMARY_VERSION = 1;
+
+// followed by count centroids of dimension floats, then the radius of every centroid
+struct VectorSummaryHeader {
+    uint32_t magic_ = VECTOR_SUMMARY_MAGIC;
+    uint32_t version_ = VECTOR_SUMMARY_VERSION;
+    int64_t dimension_ = 0;
+    uint64_t count_ = 0;
+};
+
+void
+ThrowVectorSummaryError(const std::string& action, const std::string& path) {
+    std::string err_msg = "Failed to " + action + " vector summary file: " + path + ". " + std::strerror(errno);
+    LOG_ENGINE_ERROR_ << err_msg;
+    throw Exception(SERVER_UNEXPECTED_ERROR, err_msg);
+}
+
+}  // namespace
+
+void
+DefaultVectorSummaryFormat::read(const storage::FSHandlerPtr& fs_ptr, segment::VectorSummaryPtr& vector_summary_ptr) {
+    std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
+    const std::string summary_file_path = dir_path + "/" + vector_summary_filename_;
+
+    vector_summary_ptr = nullptr;
+    int fd = open(summary_file_path.c_str(), O_RDONLY);
+    fiu_do_on("DefaultVectorSummaryFormat.read.open_fail", {
+        if (fd != -1) {
+            ::close(fd);
+        }
+        fd = -1;
+        errno = EIO;
+    });
+    if (fd == -1) {
+        if (errno == ENOENT) {
+            return;  // segments of binary vectors, or written before the summary
+        }
+        ThrowVectorSummaryError("open", summary_file_path);
+    }
+
+    VectorSummaryHeader header;
+    std::vector<float> centroids;
+    std::vector<float> radii;
+    bool valid = ::read(fd, &header, sizeof(header)) == sizeof(header) && header.magic_ == VECTOR_SUMMARY_MAGIC &&
+                 header.version_ == VECTOR_SUMMARY_VERSION && header.dimension_ > 0;
+    if (valid) {
+        centroids.resize(header.count_ * header.dimension_);
+        radii.resize(header.count_);
+        ssize_t centroids_bytes = centroids.size() * sizeof(float);
+        ssize_t radii_bytes = radii.size() * sizeof(float);
+        valid = ::read(fd, centroids.data(), centroids_bytes) == centroids_bytes &&
+                ::read(fd, radii.data(), radii_bytes) == radii_bytes;
+    }
+    ::close(fd);
+    if (!valid) {
+        ThrowVectorSummaryError("read", summary_file_path);
+    }
+
+    vector_summary_ptr =
+        std::make_shared<segment::VectorSummary>(header.dimension_, std::move(centroids), std::move(radii));
+}
+
+void
+DefaultVectorSummaryFormat::write(const storage::FSHandlerPtr& fs_ptr,
+                                  const segment::VectorSummaryPtr& vector_summary_ptr) {
+    std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
+    const std::string summary_file_path = dir_path + "/" + vector_summary_filename_;
+    const std::string temp_path = summary_file_path + ".tmp";
+
+    int fd = open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 00664);
+    if (fd == -1) {
+        ThrowVectorSummaryError("create", temp_path);
+    }
+
+    VectorSummaryHeader header;
+    header.dimension_ = vector_summary_ptr->Dimension();
+    header.count_ = vector_summary_ptr->GetRadii().size();
+    ssize_t centroids_bytes = vector_summary_ptr->GetCentroids().size() * sizeof(float);
+    ssize_t radii_bytes = vector_summary_ptr->GetRadii().size() * sizeof(float);
+    bool ok = ::write(fd, &header, sizeof(header)) == sizeof(header) &&
+              ::write(fd, vector_summary_ptr->GetCentroids().data(), centroids_bytes) == centroids_bytes &&
+              ::write(fd, vector_summary_ptr->GetRadii().data(), radii_bytes) == radii_bytes;
+    if (::close(fd) == -1 || !ok) {
+        ThrowVectorSummaryError("write", temp_path);
+    }
+
+    boost::filesystem::rename(temp_path, summary_file_path);
+}
+
+}  // namespace codec
+}  // namespace milvus
@@ -82,6 +82,10 @@ const char* CONFIG_STORAGE_FILE_CLEANUP_TIMEOUT = "file_cleanup_timeout";
 const char* CONFIG_STORAGE_FILE_CLEANUP_TIMEOUT_DEFAULT = "10";
 const int64_t CONFIG_STORAGE_FILE_CLEANUP_TIMEOUT_MIN = 0;
 const int64_t CONFIG_STORAGE_FILE_CLEANUP_TIMEOUT_MAX = 3600;
+const char* CONFIG_STORAGE_AUTO_COMPACT_INTERVAL = "auto_compact_interval";
+const char* CONFIG_STORAGE_AUTO_COMPACT_INTERVAL_DEFAULT = "0";
+const char* CONFIG_STORAGE_AUTO_COMPACT_THRESHOLD = "auto_compact_threshold";
+const char* CONFIG_STORAGE_AUTO_COMPACT_THRESHOLD_DEFAULT = "0.2";
 
 /* cache config */
 const char* CONFIG_CACHE = "cache";
@@ -91,6 +95,10 @@ const char* CONFIG_CACHE_CPU_CACHE_THRESHOLD = "cpu_cache_threshold";
 const char* CONFIG_CACHE_CPU_CACHE_THRESHOLD_DEFAULT = "0.7";
 const char* CONFIG_CACHE_INSERT_BUFFER_SIZE = "insert_buffer_size";
 const char* CONFIG_CACHE_INSERT_BUFFER_SIZE_DEFAULT = "1073741824"; /* 1 GB */
+const char* CONFIG_CACHE_BUILD_INDEX_BUFFER_SIZE = "build_index_buffer_size";
+const char* CONFIG_CACHE_BUILD_INDEX_BUFFER_SIZE_DEFAULT = "1073741824"; /* 1 GB */
+const char* CONFIG_CACHE_SEARCH_RESULT_CACHE_SIZE = "search_result_cache_size";
+const char* CONFIG_CACHE_SEARCH_RESULT_CACHE_SIZE_DEFAULT = "0";
 const char* CONFIG_CACHE_CACHE_INSERT_DATA = "cache_insert_data";
 const char* CONFIG_CACHE_CACHE_INSERT_DATA_DEFAULT = "false";
 const char* CONFIG_CACHE_PRELOAD_COLLECTION = "preload_collection";
@@ -115,6 +123,8 @@ const char* CONFIG_ENGINE_SIMD_TYPE = "simd_type";
 const char* CONFIG_ENGINE_SIMD_TYPE_DEFAULT = "auto";
 const char* CONFIG_ENGINE_SEARCH_COMBINE_MAX_NQ = "search_combine_nq";
 const char* CONFIG_ENGINE_SEARCH_COMBINE_MAX_NQ_DEFAULT = "64";
+const char* CONFIG_ENGINE_SEGMENT_PRUNING = "segment_pruning";
+const char* CONFIG_ENGINE_SEGMENT_PRUNING_DEFAULT = "false";
 
 /* gpu resource config */
 const char* CONFIG_GPU_RESOURCE = "gpu";
@@ -294,6 +304,12 @@ Config::ValidateConfig() {
     int64_t auto_flush_interval;
     STATUS_CHECK(GetStorageConfigAutoFlushInterval(auto_flush_interval));
 
+    int64_t auto_compact_interval;
+    STATUS_CHECK(GetStorageConfigAutoCompactInterval(auto_compact_interval));
+
+    double auto_compact_threshold;
+    STATUS_CHECK(GetStorageConfigAutoCompactThreshold(auto_compact_threshold));
+
     // bool storage_s3_enable;
     // STATUS_CHECK(GetStorageConfigS3Enable(storage_s3_enable));
     // // std::cout << "S3 " << (storage_s3_enable ? "ENABLED !" : "DISABLED !") << std::endl;
@@ -333,6 +349,12 @@ Config::ValidateConfig() {
     int64_t cache_insert_buffer_size;
     STATUS_CHECK(GetCacheConfigInsertBufferSize(cache_insert_buffer_size));
 
+    int64_t cache_build_index_buffer_size;
+    STATUS_CHECK(GetCacheConfigBuildIndexBufferSize(cache_build_index_buffer_size));
+
+    int64_t cache_search_result_cache_size;
+    STATUS_CHECK(GetCacheConfigSearchResultCacheSize(cache_search_result_cache_size));
+
     bool cache_insert_data;
     STATUS_CHECK(GetCacheConfigCacheInsertData(cache_insert_data));
 
@@ -349,6 +371,9 @@ Config::ValidateConfig() {
     std::string engine_simd_type;
     STATUS_CHECK(GetEngineConfigSimdType(engine_simd_type));
 
+    bool engine_segment_pruning;
+    STATUS_CHECK(GetEngineConfigSegmentPruning(engine_segment_pruning));
+
     /* gpu resource config */
 #ifdef MILVUS_GPU_VERSION
     bool gpu_resource_enable;
@@ -433,6 +458,8 @@ Config::ResetDefaultConfig() {
     STATUS_CHECK(SetStorageConfigPath(CONFIG_STORAGE_PATH_DEFAULT));
     STATUS_CHECK(SetStorageConfigAutoFlushInterval(CONFIG_STORAGE_AUTO_FLUSH_INTERVAL_DEFAULT));
     STATUS_CHECK(SetStorageConfigFileCleanupTimeout(CONFIG_STORAGE_FILE_CLEANUP_TIMEOUT_DEFAULT));
+    STATUS_CHECK(SetStorageConfigAutoCompactInterval(CONFIG_STORAGE_AUTO_COMPACT_INTERVAL_DEFAULT));
+    STATUS_CHECK(SetStorageConfigAutoCompactThreshold(CONFIG_STORAGE_AUTO_COMPACT_THRESHOLD_DEFAULT));
     // STATUS_CHECK(SetStorageConfigS3Enable(CONFIG_STORAGE_S3_ENABLE_DEFAULT));
     // STATUS_CHECK(SetStorageConfigS3Address(CONFIG_STORAGE_S3_ADDRESS_DEFAULT));
     // STATUS_CHECK(SetStorageConfigS3Port(CONFIG_STORAGE_S3_PORT_DEFAULT));
@@ -449,6 +476,8 @@ Config::ResetDefaultConfig() {
     STATUS_CHECK(SetCacheConfigCpuCacheCapacity(CONFIG_CACHE_CPU_CACHE_CAPACITY_DEFAULT));
     STATUS_CHECK(SetCacheConfigCpuCacheThreshold(CONFIG_CACHE_CPU_CACHE_THRESHOLD_DEFAULT));
     STATUS_CHECK(SetCacheConfigInsertBufferSize(CONFIG_CACHE_INSERT_BUFFER_SIZE_DEFAULT));
+    STATUS_CHECK(SetCacheConfigBuildIndexBufferSize(CONFIG_CACHE_BUILD_INDEX_BUFFER_SIZE_DEFAULT));
+    STATUS_CHECK(SetCacheConfigSearchResultCacheSize(CONFIG_CACHE_SEARCH_RESULT_CACHE_SIZE_DEFAULT));
     STATUS_CHECK(SetCacheConfigCacheInsertData(CONFIG_CACHE_CACHE_INSERT_DATA_DEFAULT));
     STATUS_CHECK(SetCacheConfigPreloadCollection(CONFIG_CACHE_PRELOAD_COLLECTION_DEFAULT));
 
@@ -457,6 +486,7 @@ Config::ResetDefaultConfig() {
     STATUS_CHECK(SetEngineConfigOmpThreadNum(CONFIG_ENGINE_OMP_THREAD_NUM_DEFAULT));
     STATUS_CHECK(SetEngineConfigSimdType(CONFIG_ENGINE_SIMD_TYPE_DEFAULT));
     STATUS_CHECK(SetEngineSearchCombineMaxNq(CONFIG_ENGINE_SEARCH_COMBINE_MAX_NQ_DEFAULT));
+    STATUS_CHECK(SetEngineConfigSegmentPruning(CONFIG_ENGINE_SEGMENT_PRUNING_DEFAULT));
 
     /* gpu resource config */
 #ifdef MILVUS_GPU_VERSION
@@ -538,6 +568,10 @@ Config::SetConfigCli(const std::string& parent_key, const std::string& child_key
             status = SetStorageConfigPath(value);
         } else if (child_key == CONFIG_STORAGE_AUTO_FLUSH_INTERVAL) {
             status = SetStorageConfigAutoFlushInterval(value);
+        } else if (child_key == CONFIG_STORAGE_AUTO_COMPACT_INTERVAL) {
+            status = SetStorageConfigAutoCompactInterval(value);
+        } else if (child_key == CONFIG_STORAGE_AUTO_COMPACT_THRESHOLD) {
+            status = SetStorageConfigAutoCompactThreshold(value);
             // } else if (child_key == CONFIG_STORAGE_S3_ENABLE) {
             //     status = SetStorageConfigS3Enable(value);
             // } else if (child_key == CONFIG_STORAGE_S3_ADDRESS) {
@@ -572,6 +606,10 @@ Config::SetConfigCli(const std::string& parent_key, const std::string& child_key
             status = SetCacheConfigCacheInsertData(value);
         } else if (child_key == CONFIG_CACHE_INSERT_BUFFER_SIZE) {
             status = SetCacheConfigInsertBufferSize(value);
+        } else if (child_key == CONFIG_CACHE_BUILD_INDEX_BUFFER_SIZE) {
+            status = SetCacheConfigBuildIndexBufferSize(value);
+        } else if (child_key == CONFIG_CACHE_SEARCH_RESULT_CACHE_SIZE) {
+            status = SetCacheConfigSearchResultCacheSize(value);
         } else if (child_key == CONFIG_CACHE_PRELOAD_COLLECTION) {
             status = SetCacheConfigPreloadCollection(value);
         } else {
@@ -586,6 +624,8 @@ Config::SetConfigCli(const std::string& parent_key, const std::string& child_key
             status = SetEngineConfigSimdType(value);
         } else if (child_key == CONFIG_ENGINE_SEARCH_COMBINE_MAX_NQ) {
             status = SetEngineSearchCombineMaxNq(value);
+        } else if (child_key == CONFIG_ENGINE_SEGMENT_PRUNING) {
+            status = SetEngineConfigSegmentPruning(value);
         } else {
             status = Status(SERVER_UNEXPECTED_ERROR, invalid_node_str);
         }
@@ -1065,6 +1105,35 @@ Config::CheckStorageConfigFileCleanupTimeout(const std::string& value) {
     return Status::OK();
 }
 
+Status
+Config::CheckStorageConfigAutoCompactInterval(const std::string& value) {
+    if (!ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid storage configuration auto_compact_interval: " + value +
+                          ". Possible reason: storage.auto_compact_interval is not a natural number.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+
+    return Status::OK();
+}
+
+Status
+Config::CheckStorageConfigAutoCompactThreshold(const std::string& value) {
+    if (!ValidateStringIsFloat(value).ok()) {
+        std::string msg = "Invalid storage configuration auto_compact_threshold: " + value +
+                          ". Possible reason: storage.auto_compact_threshold is not a positive float.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    } else {
+        float threshold = std::stof(value);
+        if (threshold <= 0.0 || threshold > 1.0) {
+            std::string msg = "Invalid storage configuration auto_compact_threshold: " + value +
+                              ". Possible reason: storage.auto_compact_threshold is not in range (0, 1].";
+            return Status(SERVER_INVALID_ARGUMENT, msg);
+        }
+    }
+
+    return Status::OK();
+}
+
 // Status
 // Config::CheckStorageConfigS3Enable(const std::string& value) {
 //    if (!ValidateStringIsBool(value).ok()) {
@@ -1263,6 +1332,50 @@ Config::CheckCacheConfigInsertBufferSize(const std::string& value) {
     return Status::OK();
 }
 
+Status
+Config::CheckCacheConfigBuildIndexBufferSize(const std::string& value) {
+    fiu_return_on("check_config_build_index_buffer_size_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    std::string err;
+    int64_t buffer_size = parse_bytes(value, err);
+    if (not err.empty()) {
+        return Status(SERVER_INVALID_ARGUMENT, err);
+    }
+
+    int64_t total_mem = 0, free_mem = 0;
+    GetSystemMemInfo(total_mem, free_mem);
+    if (buffer_size < 0 || buffer_size >= total_mem) {
+        std::stringstream ss;
+        ss << "Invalid build index buffer size: " << value << ". ";
+        ss << "Possible reason: cache.build_index_buffer_size is negative or exceeds system memory ("
+           << (total_mem >> 30) << "GB).";
+        return Status(SERVER_INVALID_ARGUMENT, ss.str());
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckCacheConfigSearchResultCacheSize(const std::string& value) {
+    fiu_return_on("check_config_search_result_cache_size_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    std::string err;
+    int64_t cache_size = parse_bytes(value, err);
+    if (not err.empty()) {
+        return Status(SERVER_INVALID_ARGUMENT, err);
+    }
+
+    int64_t total_mem = 0, free_mem = 0;
+    GetSystemMemInfo(total_mem, free_mem);
+    if (cache_size < 0 || cache_size >= total_mem) {
+        std::stringstream ss;
+        ss << "Invalid search result cache size: " << value << ". ";
+        ss << "Possible reason: cache.search_result_cache_size is negative or exceeds system memory ("
+           << (total_mem >> 30) << "GB).";
+        return Status(SERVER_INVALID_ARGUMENT, ss.str());
+    }
+    return Status::OK();
+}
+
 Status
 Config::CheckCacheConfigCacheInsertData(const std::string& value) {
     fiu_return_on("check_config_cache_insert_data_fail", Status(SERVER_INVALID_ARGUMENT, ""));
@@ -1364,6 +1477,18 @@ Config::CheckEngineSearchCombineMaxNq(const std::string& value) {
     return Status::OK();
 }
 
+Status
+Config::CheckEngineConfigSegmentPruning(const std::string& value) {
+    fiu_return_on("check_config_segment_pruning_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidateStringIsBool(value).ok()) {
+        std::string msg = "Invalid segment pruning option: " + value +
+                          ". Possible reason: engine_config.segment_pruning is not a boolean.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
 /* gpu resource config */
 #ifdef MILVUS_GPU_VERSION
 Status
@@ -1856,6 +1981,24 @@ Config::GetStorageConfigFileCleanupTimeup(int64_t& value) {
     return Status::OK();
 }
 
+Status
+Config::GetStorageConfigAutoCompactInterval(int64_t& value) {
+    std::string str = GetConfigStr(CONFIG_STORAGE, CONFIG_STORAGE_AUTO_COMPACT_INTERVAL,
+                                   CONFIG_STORAGE_AUTO_COMPACT_INTERVAL_DEFAULT);
+    STATUS_CHECK(CheckStorageConfigAutoCompactInterval(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetStorageConfigAutoCompactThreshold(double& value) {
+    std::string str = GetConfigStr(CONFIG_STORAGE, CONFIG_STORAGE_AUTO_COMPACT_THRESHOLD,
+                                   CONFIG_STORAGE_AUTO_COMPACT_THRESHOLD_DEFAULT);
+    STATUS_CHECK(CheckStorageConfigAutoCompactThreshold(str));
+    value = std::stod(str);
+    return Status::OK();
+}
+
 // Status
 // Config::GetStorageConfigS3Enable(bool& value) {
 //    std::string str = GetConfigStr(CONFIG_STORAGE, CONFIG_STORAGE_S3_ENABLE, CONFIG_STORAGE_S3_ENABLE_DEFAULT);
@@ -1936,6 +2079,26 @@ Config::GetCacheConfigCpuCacheThreshold(float& value) {
     return Status::OK();
 }
 
+Status
+Config::GetCacheConfigBuildIndexBufferSize(int64_t& value) {
+    std::string str = GetConfigStr(CONFIG_CACHE, CONFIG_CACHE_BUILD_INDEX_BUFFER_SIZE,
+                                   CONFIG_CACHE_BUILD_INDEX_BUFFER_SIZE_DEFAULT);
+    STATUS_CHECK(CheckCacheConfigBuildIndexBufferSize(str));
+    std::string err;
+    value = parse_bytes(str, err);
+    return Status::OK();
+}
+
+Status
+Config::GetCacheConfigSearchResultCacheSize(int64_t& value) {
+    std::string str = GetConfigStr(CONFIG_CACHE, CONFIG_CACHE_SEARCH_RESULT_CACHE_SIZE,
+                                   CONFIG_CACHE_SEARCH_RESULT_CACHE_SIZE_DEFAULT);
+    STATUS_CHECK(CheckCacheConfigSearchResultCacheSize(str));
+    std::string err;
+    value = parse_bytes(str, err);
+    return Status::OK();
+}
+
 Status
 Config::GetCacheConfigInsertBufferSize(int64_t& value) {
     std::string str =
@@ -1996,6 +2159,15 @@ Config::GetEngineSearchCombineMaxNq(int64_t& value) {
     return Status::OK();
 }
 
+Status
+Config::GetEngineConfigSegmentPruning(bool& value) {
+    std::string str = GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_SEGMENT_PRUNING, CONFIG_ENGINE_SEGMENT_PRUNING_DEFAULT);
+    STATUS_CHECK(CheckEngineConfigSegmentPruning(str));
+    std::transform(str.begin(), str.end(), str.begin(), ::tolower);
+    value = (str == "true" || str == "on" || str == "yes" || str == "1");
+    return Status::OK();
+}
+
 /* gpu resource config */
 #ifdef MILVUS_GPU_VERSION
 Status
@@ -2280,6 +2452,18 @@ Config::SetStorageConfigFileCleanupTimeout(const std::string& value) {
     return SetConfigValueInMem(CONFIG_STORAGE, CONFIG_STORAGE_FILE_CLEANUP_TIMEOUT, value);
 }
 
+Status
+Config::SetStorageConfigAutoCompactInterval(const std::string& value) {
+    STATUS_CHECK(CheckStorageConfigAutoCompactInterval(value));
+    return SetConfigValueInMem(CONFIG_STORAGE, CONFIG_STORAGE_AUTO_COMPACT_INTERVAL, value);
+}
+
+Status
+Config::SetStorageConfigAutoCompactThreshold(const std::string& value) {
+    STATUS_CHECK(CheckStorageConfigAutoCompactThreshold(value));
+    return SetConfigValueInMem(CONFIG_STORAGE, CONFIG_STORAGE_AUTO_COMPACT_THRESHOLD, value);
+}
+
 // Status
 // Config::SetStorageConfigS3Enable(const std::string& value) {
 //    STATUS_CHECK(CheckStorageConfigS3Enable(value));
@@ -2349,6 +2533,18 @@ Config::SetCacheConfigCpuCacheThreshold(const std::string& value) {
     return SetConfigValueInMem(CONFIG_CACHE, CONFIG_CACHE_CPU_CACHE_THRESHOLD, value);
 }
 
+Status
+Config::SetCacheConfigBuildIndexBufferSize(const std::string& value) {
+    STATUS_CHECK(CheckCacheConfigBuildIndexBufferSize(value));
+    return SetConfigValueInMem(CONFIG_CACHE, CONFIG_CACHE_BUILD_INDEX_BUFFER_SIZE, value);
+}
+
+Status
+Config::SetCacheConfigSearchResultCacheSize(const std::string& value) {
+    STATUS_CHECK(CheckCacheConfigSearchResultCacheSize(value));
+    return SetConfigValueInMem(CONFIG_CACHE, CONFIG_CACHE_SEARCH_RESULT_CACHE_SIZE, value);
+}
+
 Status
 Config::SetCacheConfigInsertBufferSize(const std::string& value) {
     STATUS_CHECK(CheckCacheConfigInsertBufferSize(value));
@@ -2397,6 +2593,12 @@ Config::SetEngineSearchCombineMaxNq(const std::string& value) {
     return ExecCallBacks(CONFIG_ENGINE, CONFIG_ENGINE_SEARCH_COMBINE_MAX_NQ, value);
 }
 
+Status
+Config::SetEngineConfigSegmentPruning(const std::string& value) {
+    STATUS_CHECK(CheckEngineConfigSegmentPruning(value));
+    return SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_SEGMENT_PRUNING, value);
+}
+
 /* gpu resource config */
 #ifdef MILVUS_GPU_VERSION
 
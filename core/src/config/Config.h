@@ -69,6 +69,10 @@ extern const char* CONFIG_STORAGE_AUTO_FLUSH_INTERVAL_DEFAULT;
 extern const char* CONFIG_STORAGE_FILE_CLEANUP_TIMEOUT;
 extern const int64_t CONFIG_STORAGE_FILE_CLEANUP_TIMEOUT_MIN;
 extern const int64_t CONFIG_STORAGE_FILE_CLEANUP_TIMEOUT_MAX;
+extern const char* CONFIG_STORAGE_AUTO_COMPACT_INTERVAL;
+extern const char* CONFIG_STORAGE_AUTO_COMPACT_INTERVAL_DEFAULT;
+extern const char* CONFIG_STORAGE_AUTO_COMPACT_THRESHOLD;
+extern const char* CONFIG_STORAGE_AUTO_COMPACT_THRESHOLD_DEFAULT;
 
 /* cache config */
 extern const char* CONFIG_CACHE;
@@ -78,6 +82,10 @@ extern const char* CONFIG_CACHE_CPU_CACHE_THRESHOLD;
 extern const char* CONFIG_CACHE_CPU_CACHE_THRESHOLD_DEFAULT;
 extern const char* CONFIG_CACHE_INSERT_BUFFER_SIZE;
 extern const char* CONFIG_CACHE_INSERT_BUFFER_SIZE_DEFAULT;
+extern const char* CONFIG_CACHE_BUILD_INDEX_BUFFER_SIZE;
+extern const char* CONFIG_CACHE_BUILD_INDEX_BUFFER_SIZE_DEFAULT;
+extern const char* CONFIG_CACHE_SEARCH_RESULT_CACHE_SIZE;
+extern const char* CONFIG_CACHE_SEARCH_RESULT_CACHE_SIZE_DEFAULT;
 extern const char* CONFIG_CACHE_CACHE_INSERT_DATA;
 extern const char* CONFIG_CACHE_CACHE_INSERT_DATA_DEFAULT;
 extern const char* CONFIG_CACHE_PRELOAD_COLLECTION;
@@ -102,6 +110,8 @@ extern const char* CONFIG_ENGINE_SIMD_TYPE;
 extern const char* CONFIG_ENGINE_SIMD_TYPE_DEFAULT;
 extern const char* CONFIG_ENGINE_SEARCH_COMBINE_MAX_NQ;
 extern const char* CONFIG_ENGINE_SEARCH_COMBINE_MAX_NQ_DEFAULT;
+extern const char* CONFIG_ENGINE_SEGMENT_PRUNING;
+extern const char* CONFIG_ENGINE_SEGMENT_PRUNING_DEFAULT;
 
 /* gpu resource config */
 extern const char* CONFIG_GPU_RESOURCE;
@@ -238,6 +248,10 @@ class Config {
     CheckStorageConfigAutoFlushInterval(const std::string& value);
     Status
     CheckStorageConfigFileCleanupTimeout(const std::string& value);
+    Status
+    CheckStorageConfigAutoCompactInterval(const std::string& value);
+    Status
+    CheckStorageConfigAutoCompactThreshold(const std::string& value);
 
     /* metric config */
     Status
@@ -255,6 +269,10 @@ class Config {
     Status
     CheckCacheConfigInsertBufferSize(const std::string& value);
     Status
+    CheckCacheConfigBuildIndexBufferSize(const std::string& value);
+    Status
+    CheckCacheConfigSearchResultCacheSize(const std::string& value);
+    Status
     CheckCacheConfigCacheInsertData(const std::string& value);
     Status
     CheckCacheConfigPreloadCollection(const std::string& value);
@@ -268,6 +286,8 @@ class Config {
     CheckEngineConfigSimdType(const std::string& value);
     Status
     CheckEngineSearchCombineMaxNq(const std::string& value);
+    Status
+    CheckEngineConfigSegmentPruning(const std::string& value);
 
     /* gpu resource config */
 #ifdef MILVUS_GPU_VERSION
@@ -358,6 +378,10 @@ class Config {
     GetStorageConfigAutoFlushInterval(int64_t& value);
     Status
     GetStorageConfigFileCleanupTimeup(int64_t& value);
+    Status
+    GetStorageConfigAutoCompactInterval(int64_t& value);
+    Status
+    GetStorageConfigAutoCompactThreshold(double& value);
 
     /* metric config */
     Status
@@ -375,6 +399,10 @@ class Config {
     Status
     GetCacheConfigInsertBufferSize(int64_t& value);
     Status
+    GetCacheConfigBuildIndexBufferSize(int64_t& value);
+    Status
+    GetCacheConfigSearchResultCacheSize(int64_t& value);
+    Status
     GetCacheConfigCacheInsertData(bool& value);
     Status
     GetCacheConfigPreloadCollection(std::string& value);
@@ -388,6 +416,8 @@ class Config {
     GetEngineConfigSimdType(std::string& value);
     Status
     GetEngineSearchCombineMaxNq(int64_t& value);
+    Status
+    GetEngineConfigSegmentPruning(bool& value);
 
     /* gpu resource config */
 #ifdef MILVUS_GPU_VERSION
@@ -470,6 +500,10 @@ class Config {
     SetStorageConfigAutoFlushInterval(const std::string& value);
     Status
     SetStorageConfigFileCleanupTimeout(const std::string& value);
+    Status
+    SetStorageConfigAutoCompactInterval(const std::string& value);
+    Status
+    SetStorageConfigAutoCompactThreshold(const std::string& value);
 
     /* metric config */
     Status
@@ -487,6 +521,10 @@ class Config {
     Status
     SetCacheConfigInsertBufferSize(const std::string& value);
     Status
+    SetCacheConfigBuildIndexBufferSize(const std::string& value);
+    Status
+    SetCacheConfigSearchResultCacheSize(const std::string& value);
+    Status
     SetCacheConfigCacheInsertData(const std::string& value);
     Status
     SetCacheConfigPreloadCollection(const std::string& value);
@@ -500,6 +538,8 @@ class Config {
     SetEngineConfigSimdType(const std::string& value);
     Status
     SetEngineSearchCombineMaxNq(const std::string& value);
+    Status
+    SetEngineConfigSegmentPruning(const std::string& value);
 
     /* gpu resource config */
 #ifdef MILVUS_GPU_VERSION
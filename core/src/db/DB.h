@@ -137,6 +137,13 @@ class DB {
           const std::vector<std::string>& partition_tags, uint64_t k, const milvus::json& extra_params,
           VectorsData& vectors, ResultIds& result_ids, ResultDistances& result_distances) = 0;
 
+    // returns every entity within extra_params["radius"], results of query i are in [lims[i], lims[i + 1])
+    virtual Status
+    QueryByRange(const std::shared_ptr<server::Context>& context, const std::string& collection_id,
+                 const std::vector<std::string>& partition_tags, const milvus::json& extra_params,
+                 VectorsData& vectors, ResultLims& result_lims, ResultIds& result_ids,
+                 ResultDistances& result_distances) = 0;
+
     virtual Status
     QueryByFileID(const std::shared_ptr<server::Context>& context, const std::vector<std::string>& file_ids, uint64_t k,
                   const milvus::json& extra_params, VectorsData& vectors, ResultIds& result_ids,
@@ -32,8 +32,11 @@
 #include "Utils.h"
 #include "cache/CpuCacheMgr.h"
 #include "cache/GpuCacheMgr.h"
+#include "config/Config.h"
 #include "config/Utils.h"
 #include "db/IDGenerator.h"
+#include "db/SearchResultCache.h"
+#include "db/SegmentPruner.h"
 #include "db/merge/MergeManagerFactory.h"
 #include "engine/EngineFactory.h"
 #include "index/knowhere/knowhere/index/vector_index/helpers/BuilderSuspend.h"
@@ -48,6 +51,7 @@
 #include "scheduler/job/BuildIndexJob.h"
 #include "scheduler/job/DeleteJob.h"
 #include "scheduler/job/SearchJob.h"
+#include "segment/IdIndex.h"
 #include "segment/SegmentReader.h"
 #include "segment/SegmentWriter.h"
 #include "utils/Exception.h"
@@ -76,10 +80,31 @@ constexpr const char* JSON_DATA_SIZE = "data_size";
 
 static const Status SHUTDOWN_ERROR = Status(DB_ERROR, "Milvus server is shutdown!");
 
+// builds kept in the scheduler, one per build resource and one more loading its data, the rest wait in
+// priority order so a new segment never waits behind a whole batch
+size_t
+IndexBuildWindow() {
+    size_t resource_num = 1;
+#ifdef MILVUS_GPU_VERSION
+    server::Config& config = server::Config::GetInstance();
+    bool gpu_enable = false;
+    std::vector<int64_t> build_resources;
+    if (config.GetGpuResourceConfigEnable(gpu_enable).ok() && gpu_enable &&
+        config.GetGpuResourceConfigBuildIndexResources(build_resources).ok() && !build_resources.empty()) {
+        resource_num = build_resources.size();
+    }
+#endif
+    return resource_num + 1;
+}
+
 }  // namespace
 
 DBImpl::DBImpl(const DBOptions& options)
-    : options_(options), initialized_(false), merge_thread_pool_(1, 1), index_thread_pool_(1, 1) {
+    : options_(options),
+      initialized_(false),
+      merge_thread_pool_(1, 1),
+      index_thread_pool_(1, 1),
+      compact_thread_pool_(std::max<uint64_t>(options.auto_compact_thread_num_, 1)) {
     meta_ptr_ = MetaFactory::Build(options.meta_, options.mode_);
     mem_mgr_ = MemManagerFactory::Build(meta_ptr_, options_);
     merge_mgr_ptr_ = MergeManagerFactory::Build(meta_ptr_, options_);
@@ -93,6 +118,8 @@ DBImpl::DBImpl(const DBOptions& options)
         wal_mgr_ = std::make_shared<wal::WalManager>(mxlog_config);
     }
 
+    SearchResultCache::GetInstance()->Reset(options_.search_result_cache_size_);
+
     SetIdentity("DBImpl");
     AddCacheInsertDataListener();
     AddUseBlasThresholdListener();
@@ -166,6 +193,11 @@ DBImpl::Start() {
     if (options_.mode_ != DBOptions::MODE::CLUSTER_READONLY) {
         // background build index thread
         bg_index_thread_ = std::thread(&DBImpl::BackgroundIndexThread, this);
+
+        // background compact thread
+        if (options_.auto_compact_interval_ > 0) {
+            bg_compact_thread_ = std::thread(&DBImpl::BackgroundCompactThread, this);
+        }
     }
 
     // background metric thread
@@ -203,6 +235,11 @@ DBImpl::Stop() {
 
         WaitMergeFileFinish();
 
+        if (bg_compact_thread_.joinable()) {
+            swn_compact_.Notify();
+            bg_compact_thread_.join();
+        }
+
         swn_index_.Notify();
         bg_index_thread_.join();
 
@@ -567,7 +604,6 @@ DBImpl::ReLoadSegmentsDeletedDocs(const std::string& collection_id, const std::v
 
         segment::DeletedDocsPtr delete_docs = std::make_shared<segment::DeletedDocs>();
         segment_reader.LoadDeletedDocs(delete_docs);
-        auto& docs_offsets = delete_docs->GetDeletedDocs();
 
         faiss::ConcurrentBitsetPtr blacklist = index->GetBlacklist();
         if (nullptr == blacklist) {
@@ -578,11 +614,7 @@ DBImpl::ReLoadSegmentsDeletedDocs(const std::string& collection_id, const std::v
             blacklist = concurrent_bitset_ptr;
         }
 
-        for (auto& i : docs_offsets) {
-            if (!blacklist->test(i)) {
-                blacklist->set(i);
-            }
-        }
+        delete_docs->GetBitset(blacklist);
     }
 
     return Status::OK();
@@ -719,7 +751,9 @@ DBImpl::InsertVectors(const std::string& collection_id, const std::string& parti
             return status;
         }
 
-        if (!vectors.float_data_.empty()) {
+        if (!vectors.rows_.rows_.empty()) {
+            wal_mgr_->Insert(collection_id, partition_tag, vectors.id_array_, vectors.rows_);
+        } else if (!vectors.float_data_.empty()) {
             wal_mgr_->Insert(collection_id, partition_tag, vectors.id_array_, vectors.float_data_);
         } else if (!vectors.binary_data_.empty()) {
             wal_mgr_->Insert(collection_id, partition_tag, vectors.id_array_, vectors.binary_data_);
@@ -732,7 +766,12 @@ DBImpl::InsertVectors(const std::string& collection_id, const std::string& parti
         record.partition_tag = partition_tag;
         record.ids = vectors.id_array_.data();
         record.length = vectors.vector_count_;
-        if (vectors.binary_data_.empty()) {
+        if (!vectors.rows_.rows_.empty()) {
+            record.type = vectors.rows_.binary_ ? wal::MXLogType::InsertBinary : wal::MXLogType::InsertVector;
+            record.data = nullptr;
+            record.rows = vectors.rows_.rows_.data();
+            record.data_size = vectors.rows_.rows_.size() * vectors.rows_.row_size_;
+        } else if (vectors.binary_data_.empty()) {
             record.type = wal::MXLogType::InsertVector;
             record.data = vectors.float_data_.data();
             record.data_size = vectors.float_data_.size() * sizeof(float);
@@ -750,123 +789,86 @@ DBImpl::InsertVectors(const std::string& collection_id, const std::string& parti
     return status;
 }
 
+namespace {
+// Convert one column of the request, which carries integers as int64 and floating points as double, into its
+// field type. The loop has no dependency between rows so the compiler turns it into packed conversions.
+template <typename SrcT, typename DstT>
+void
+NarrowAttr(const uint8_t* src, uint64_t row_num, std::vector<uint8_t>& dst) {
+    dst.resize(row_num * sizeof(DstT));
+    auto in = reinterpret_cast<const SrcT*>(src);
+    auto out = reinterpret_cast<DstT*>(dst.data());
+#pragma omp simd
+    for (uint64_t i = 0; i < row_num; ++i) {
+        out[i] = static_cast<DstT>(in[i]);
+    }
+}
+}  // namespace
+
 Status
-CopyToAttr(std::vector<uint8_t>& record, uint64_t row_num, const std::vector<std::string>& field_names,
-           std::unordered_map<std::string, meta::hybrid::DataType>& attr_types,
-           std::unordered_map<std::string, std::vector<uint8_t>>& attr_datas,
-           std::unordered_map<std::string, uint64_t>& attr_nbytes,
-           std::unordered_map<std::string, uint64_t>& attr_data_size) {
+CopyToAttr(const std::vector<uint8_t>& record, uint64_t row_num, const std::vector<std::string>& field_names,
+           std::unordered_map<std::string, meta::hybrid::DataType>& attr_types, AttrColumns& attrs) {
+    attrs.clear();
+    attrs.reserve(field_names.size());
     uint64_t offset = 0;
-    for (auto name : field_names) {
-        switch (attr_types.at(name)) {
-            case meta::hybrid::DataType::INT8: {
-                std::vector<uint8_t> data;
-                data.resize(row_num * sizeof(int8_t));
-
-                std::vector<int64_t> attr_value(row_num, 0);
-                memcpy(attr_value.data(), record.data() + offset, row_num * sizeof(int64_t));
-
-                std::vector<int8_t> raw_value(row_num, 0);
-                for (uint64_t i = 0; i < row_num; ++i) {
-                    raw_value[i] = attr_value[i];
-                }
-
-                memcpy(data.data(), raw_value.data(), row_num * sizeof(int8_t));
-                attr_datas.insert(std::make_pair(name, data));
-
-                attr_nbytes.insert(std::make_pair(name, sizeof(int8_t)));
-                attr_data_size.insert(std::make_pair(name, row_num * sizeof(int8_t)));
-                offset += row_num * sizeof(int64_t);
+    for (auto& name : field_names) {
+        auto type = attr_types.at(name);
+        uint64_t nbytes = 0;
+        switch (type) {
+            case meta::hybrid::DataType::INT8:
+                nbytes = sizeof(int8_t);
                 break;
-            }
-            case meta::hybrid::DataType::INT16: {
-                std::vector<uint8_t> data;
-                data.resize(row_num * sizeof(int16_t));
-
-                std::vector<int64_t> attr_value(row_num, 0);
-                memcpy(attr_value.data(), record.data() + offset, row_num * sizeof(int64_t));
-
-                std::vector<int16_t> raw_value(row_num, 0);
-                for (uint64_t i = 0; i < row_num; ++i) {
-                    raw_value[i] = attr_value[i];
-                }
-
-                memcpy(data.data(), raw_value.data(), row_num * sizeof(int16_t));
-                attr_datas.insert(std::make_pair(name, data));
-
-                attr_nbytes.insert(std::make_pair(name, sizeof(int16_t)));
-                attr_data_size.insert(std::make_pair(name, row_num * sizeof(int16_t)));
-                offset += row_num * sizeof(int64_t);
+            case meta::hybrid::DataType::INT16:
+                nbytes = sizeof(int16_t);
                 break;
-            }
-            case meta::hybrid::DataType::INT32: {
-                std::vector<uint8_t> data;
-                data.resize(row_num * sizeof(int32_t));
-
-                std::vector<int64_t> attr_value(row_num, 0);
-                memcpy(attr_value.data(), record.data() + offset, row_num * sizeof(int64_t));
-
-                std::vector<int32_t> raw_value(row_num, 0);
-                for (uint64_t i = 0; i < row_num; ++i) {
-                    raw_value[i] = attr_value[i];
-                }
-
-                memcpy(data.data(), raw_value.data(), row_num * sizeof(int32_t));
-                attr_datas.insert(std::make_pair(name, data));
-
-                attr_nbytes.insert(std::make_pair(name, sizeof(int32_t)));
-                attr_data_size.insert(std::make_pair(name, row_num * sizeof(int32_t)));
-                offset += row_num * sizeof(int64_t);
+            case meta::hybrid::DataType::INT32:
+                nbytes = sizeof(int32_t);
                 break;
-            }
-            case meta::hybrid::DataType::INT64: {
-                std::vector<uint8_t> data;
-                data.resize(row_num * sizeof(int64_t));
-                memcpy(data.data(), record.data() + offset, row_num * sizeof(int64_t));
-                attr_datas.insert(std::make_pair(name, data));
-
-                std::vector<int64_t> test_data(row_num);
-                memcpy(test_data.data(), record.data(), row_num * sizeof(int64_t));
-
-                attr_nbytes.insert(std::make_pair(name, sizeof(int64_t)));
-                attr_data_size.insert(std::make_pair(name, row_num * sizeof(int64_t)));
-                offset += row_num * sizeof(int64_t);
+            case meta::hybrid::DataType::INT64:
+                nbytes = sizeof(int64_t);
                 break;
-            }
-            case meta::hybrid::DataType::FLOAT: {
-                std::vector<uint8_t> data;
-                data.resize(row_num * sizeof(float));
-
-                std::vector<double> attr_value(row_num, 0);
-                memcpy(attr_value.data(), record.data() + offset, row_num * sizeof(double));
-
-                std::vector<float> raw_value(row_num, 0);
-                for (uint64_t i = 0; i < row_num; ++i) {
-                    raw_value[i] = attr_value[i];
-                }
+            case meta::hybrid::DataType::FLOAT:
+                nbytes = sizeof(float);
+                break;
+            case meta::hybrid::DataType::DOUBLE:
+                nbytes = sizeof(double);
+                break;
+            default:
+                continue;
+        }
 
-                memcpy(data.data(), raw_value.data(), row_num * sizeof(float));
-                attr_datas.insert(std::make_pair(name, data));
+        // every column of the request is 8 bytes wide, whatever its field type
+        uint64_t column_size = row_num * sizeof(int64_t);
+        if (offset + column_size > record.size()) {
+            return Status(DB_ERROR, "Attribute data of field " + name + " is incomplete");
+        }
 
-                attr_nbytes.insert(std::make_pair(name, sizeof(float)));
-                attr_data_size.insert(std::make_pair(name, row_num * sizeof(float)));
-                offset += row_num * sizeof(double);
+        // build the column in place, the batch holds the only copy of it
+        attrs.emplace_back();
+        auto& attr = attrs.back();
+        attr.name_ = name;
+        attr.nbytes_ = nbytes;
+        auto& data = attr.data_;
+        const uint8_t* src = record.data() + offset;
+        switch (type) {
+            case meta::hybrid::DataType::INT8:
+                NarrowAttr<int64_t, int8_t>(src, row_num, data);
                 break;
-            }
-            case meta::hybrid::DataType::DOUBLE: {
-                std::vector<uint8_t> data;
-                data.resize(row_num * sizeof(double));
-                memcpy(data.data(), record.data() + offset, row_num * sizeof(double));
-                attr_datas.insert(std::make_pair(name, data));
-
-                attr_nbytes.insert(std::make_pair(name, sizeof(double)));
-                attr_data_size.insert(std::make_pair(name, row_num * sizeof(double)));
-                offset += row_num * sizeof(double);
+            case meta::hybrid::DataType::INT16:
+                NarrowAttr<int64_t, int16_t>(src, row_num, data);
+                break;
+            case meta::hybrid::DataType::INT32:
+                NarrowAttr<int64_t, int32_t>(src, row_num, data);
+                break;
+            case meta::hybrid::DataType::FLOAT:
+                NarrowAttr<double, float>(src, row_num, data);
                 break;
-            }
             default:
+                data.assign(src, src + column_size);
                 break;
         }
+
+        offset += column_size;
     }
     return Status::OK();
 }
@@ -889,16 +891,12 @@ DBImpl::InsertEntities(const std::string& collection_id, const std::string& part
     }
 
     Status status;
-    std::unordered_map<std::string, std::vector<uint8_t>> attr_data;
-    std::unordered_map<std::string, uint64_t> attr_nbytes;
-    std::unordered_map<std::string, uint64_t> attr_data_size;
-    status = CopyToAttr(entity.attr_value_, entity.entity_count_, field_names, attr_types, attr_data, attr_nbytes,
-                        attr_data_size);
+    wal::MXLogRecord record;
+    status = CopyToAttr(entity.attr_value_, entity.entity_count_, field_names, attr_types, record.attrs);
     if (!status.ok()) {
         return status;
     }
 
-    wal::MXLogRecord record;
     record.lsn = 0;
     record.collection_id = collection_id;
     record.partition_tag = partition_tag;
@@ -910,9 +908,6 @@ DBImpl::InsertEntities(const std::string& collection_id, const std::string& part
         record.type = wal::MXLogType::Entity;
         record.data = vector_it->second.float_data_.data();
         record.data_size = vector_it->second.float_data_.size() * sizeof(float);
-        record.attr_data = attr_data;
-        record.attr_nbytes = attr_nbytes;
-        record.attr_data_size = attr_data_size;
     } else {
         //        record.type = wal::MXLogType::InsertBinary;
         //        record.data = entities.vector_data_[0].binary_data_.data();
@@ -933,10 +928,10 @@ DBImpl::InsertEntities(const std::string& collection_id, const std::string& part
         auto vector_it = entity.vector_data_.begin();
         if (!vector_it->second.binary_data_.empty()) {
             wal_mgr_->InsertEntities(collection_id, partition_tag, entity.id_array_, vector_it->second.binary_data_,
-                                     attr_nbytes, attr_data);
+                                     record.attrs);
         } else if (!vector_it->second.float_data_.empty()) {
             wal_mgr_->InsertEntities(collection_id, partition_tag, entity.id_array_, vector_it->second.float_data_,
-                                     attr_nbytes, attr_data);
+                                     record.attrs);
         }
         swn_wal_.Notify();
     } else {
@@ -953,9 +948,6 @@ DBImpl::InsertEntities(const std::string& collection_id, const std::string& part
             record.type = wal::MXLogType::Entity;
             record.data = vector_it->second.float_data_.data();
             record.data_size = vector_it->second.float_data_.size() * sizeof(float);
-            record.attr_data = attr_data;
-            record.attr_nbytes = attr_nbytes;
-            record.attr_data_size = attr_data_size;
         } else {
             //        record.type = wal::MXLogType::InsertBinary;
             //        record.data = entities.vector_data_[0].binary_data_.data();
@@ -1101,6 +1093,7 @@ DBImpl::Compact(const std::shared_ptr<server::Context>& context, const std::stri
     collection_array.push_back(collection_schema);
 
     const std::lock_guard<std::mutex> index_lock(build_index_mutex_);
+    FinishBuildIndex(true);
     const std::lock_guard<std::mutex> merge_lock(flush_merge_compact_mutex_);
 
     LOG_ENGINE_DEBUG_ << "Compacting collection: " << collection_id;
@@ -1213,6 +1206,9 @@ DBImpl::CompactFile(const meta::SegmentSchema& file, double threshold, meta::Seg
     std::string new_segment_dir;
     utils::GetParentPath(compacted_file.location_, new_segment_dir);
     auto segment_writer_ptr = std::make_shared<segment::SegmentWriter>(new_segment_dir);
+    if (!utils::IsBinaryMetricType(compacted_file.metric_type_)) {
+        segment_writer_ptr->SummarizeVectors(compacted_file.dimension_);
+    }
 
     LOG_ENGINE_DEBUG_ << "Compacting begin...";
     segment_writer_ptr->Merge(segment_dir_to_merge, compacted_file.file_id_);
@@ -1275,6 +1271,177 @@ DBImpl::CompactFile(const meta::SegmentSchema& file, double threshold, meta::Seg
     return status;
 }
 
+void
+DBImpl::BackgroundCompact() {
+    std::vector<meta::CollectionSchema> collection_array;
+    auto status = meta_ptr_->AllCollections(collection_array, true);
+    if (!status.ok()) {
+        LOG_ENGINE_ERROR_ << "Failed to get collections to compact: " << status.message();
+        return;
+    }
+
+    struct CompactCandidate {
+        meta::SegmentSchema file_;
+        size_t deleted_docs_size_;
+        double reclaimable_;
+    };
+    std::vector<CompactCandidate> candidates;
+
+    // keep the candidates referenced until they are rewritten, so that they are not cleaned up meanwhile
+    meta::FilesHolder candidates_holder;
+    for (auto& collection : collection_array) {
+        if (!initialized_.load(std::memory_order_acquire)) {
+            return;
+        }
+
+        std::vector<meta::CollectionSchema> partition_array;
+        meta_ptr_->ShowPartitions(collection.collection_id_, partition_array);
+        partition_array.push_back(collection);
+
+        // TO_INDEX segments count for the deleted ratio, but are left to the index builder
+        std::vector<int> file_types{meta::SegmentSchema::FILE_TYPE::RAW, meta::SegmentSchema::FILE_TYPE::TO_INDEX,
+                                    meta::SegmentSchema::FILE_TYPE::BACKUP};
+        meta::FilesHolder files_holder;
+        status = meta_ptr_->FilesByTypeEx(partition_array, file_types, files_holder);
+        if (!status.ok()) {
+            LOG_ENGINE_ERROR_ << "Failed to get files to compact: " << status.message();
+            continue;
+        }
+
+        uint64_t total_rows = 0, total_deleted = 0;
+        for (auto& file : files_holder.HoldFiles()) {
+            std::string segment_dir;
+            utils::GetParentPath(file.location_, segment_dir);
+            segment::SegmentReader segment_reader(segment_dir);
+            size_t deleted_docs_size = 0;
+            if (!segment_reader.ReadDeletedDocsSize(deleted_docs_size).ok()) {
+                continue;
+            }
+
+            total_rows += file.row_count_;
+            total_deleted += deleted_docs_size;
+            if (deleted_docs_size == 0 || file.file_type_ == meta::SegmentSchema::FILE_TYPE::TO_INDEX) {
+                continue;
+            }
+
+            double delete_rate = (double)deleted_docs_size / (double)(deleted_docs_size + file.row_count_);
+            if (delete_rate >= options_.auto_compact_threshold_) {
+                candidates_holder.MarkFile(file);
+                candidates.push_back({file, deleted_docs_size, delete_rate * file.file_size_});
+            }
+        }
+
+        double collection_delete_rate =
+            (total_deleted == 0) ? 0.0 : (double)total_deleted / (double)(total_deleted + total_rows);
+        server::Metrics::GetInstance().CollectionDeletedRatioGaugeSet(collection.collection_id_,
+                                                                     collection_delete_rate);
+    }
+
+    if (candidates.empty()) {
+        return;
+    }
+
+    // rewrite the segments freeing most space first, within the size budget of one round
+    std::sort(candidates.begin(), candidates.end(), [](const CompactCandidate& a, const CompactCandidate& b) {
+        return a.reclaimable_ > b.reclaimable_;
+    });
+
+    std::vector<std::future<Status>> compact_results;
+    uint64_t budget = 0;
+    for (auto& candidate : candidates) {
+        if (!compact_results.empty() && budget + candidate.file_.file_size_ > options_.auto_compact_max_size_) {
+            break;
+        }
+        budget += candidate.file_.file_size_;
+        compact_results.push_back(compact_thread_pool_.Enqueue(&DBImpl::AutoCompactFile, this, candidate.file_,
+                                                               candidate.deleted_docs_size_));
+    }
+
+    int64_t compacted = 0;
+    for (auto& result : compact_results) {
+        if (result.get().ok()) {
+            ++compacted;
+        }
+    }
+    LOG_ENGINE_DEBUG_ << "Background compaction rewrote " << compacted << " of " << compact_results.size()
+                      << " segments, " << budget << " bytes";
+
+    // let the index thread rebuild the indexes of compacted segments right away
+    if (compacted > 0) {
+        swn_index_.Notify();
+    }
+}
+
+Status
+DBImpl::AutoCompactFile(const meta::SegmentSchema& file, size_t deleted_docs_size) {
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return Status(DB_ERROR, "Server will shutdown, skip compaction");
+    }
+
+    // the segment is rewritten without holding any lock, and the result is only committed if neither
+    // flush, merge, index build nor another compaction touched the segment meanwhile
+    meta::FilesHolder snapshot_holder;
+    auto status = meta_ptr_->GetCollectionFilesBySegmentId(file.segment_id_, snapshot_holder);
+    if (!status.ok()) {
+        return status;
+    }
+    auto snapshot = snapshot_holder.HoldFiles();
+    snapshot_holder.ReleaseFiles();
+
+    meta::SegmentsSchema files_to_update;
+    status = CompactFile(file, 0.0, files_to_update);
+    if (!status.ok() || files_to_update.empty()) {
+        return status;
+    }
+
+    const std::lock_guard<std::mutex> index_lock(build_index_mutex_);
+    FinishBuildIndex(true);
+    const std::lock_guard<std::mutex> merge_lock(flush_merge_compact_mutex_);
+
+    auto unchanged = [&]() {
+        std::string segment_dir;
+        utils::GetParentPath(file.location_, segment_dir);
+        segment::SegmentReader segment_reader(segment_dir);
+        size_t current_deleted_docs_size = 0;
+        if (!segment_reader.ReadDeletedDocsSize(current_deleted_docs_size).ok() ||
+            current_deleted_docs_size != deleted_docs_size) {
+            return false;
+        }
+
+        meta::FilesHolder current_holder;
+        if (!meta_ptr_->GetCollectionFilesBySegmentId(file.segment_id_, current_holder).ok()) {
+            return false;
+        }
+        auto& current = current_holder.HoldFiles();
+        if (current.size() != snapshot.size()) {
+            return false;
+        }
+        for (auto& snapshot_file : snapshot) {
+            auto iter = std::find_if(current.begin(), current.end(), [&](const meta::SegmentSchema& f) {
+                return f.file_id_ == snapshot_file.file_id_ && f.file_type_ == snapshot_file.file_type_;
+            });
+            if (iter == current.end()) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    auto& compacted_file = files_to_update.front();
+    if (!unchanged()) {
+        LOG_ENGINE_DEBUG_ << "Segment " << file.segment_id_ << " changed during compaction, discard the result";
+        compacted_file.file_type_ = meta::SegmentSchema::TO_DELETE;
+        meta_ptr_->UpdateCollectionFile(compacted_file);
+        return Status(DB_ERROR, "Segment changed during compaction");
+    }
+
+    status = meta_ptr_->UpdateCollectionFiles(files_to_update);
+    if (!status.ok()) {
+        LOG_ENGINE_ERROR_ << "Failed to update meta after compaction: " << status.message();
+    }
+    return status;
+}
+
 Status
 DBImpl::GetVectorsByID(const engine::meta::CollectionSchema& collection, const IDNumbers& id_array,
                        std::vector<engine::VectorsData>& vectors) {
@@ -1284,7 +1451,7 @@ DBImpl::GetVectorsByID(const engine::meta::CollectionSchema& collection, const I
 
     meta::FilesHolder files_holder;
     std::vector<int> file_types{meta::SegmentSchema::FILE_TYPE::RAW, meta::SegmentSchema::FILE_TYPE::TO_INDEX,
-                                meta::SegmentSchema::FILE_TYPE::BACKUP};
+                                meta::SegmentSchema::FILE_TYPE::BACKUP, meta::SegmentSchema::FILE_TYPE::INDEX};
 
     std::vector<meta::CollectionSchema> collection_array;
     auto status = meta_ptr_->ShowPartitions(collection.collection_id_, collection_array);
@@ -1474,12 +1641,28 @@ DBImpl::GetVectorsByIdHelper(const IDNumbers& id_array, std::vector<engine::Vect
 
     vectors.clear();
 
-    IDNumbers temp_ids = id_array;
+    // the raw file and the index file of a segment share its uids and raw vectors, look up every segment once,
+    // through the file whose index is in cache if there is one
+    std::unordered_map<std::string, size_t> segment_pos;
+    milvus::engine::meta::SegmentsSchema segment_files;
     for (auto& file : files) {
+        auto iter = segment_pos.find(file.segment_id_);
+        if (iter == segment_pos.end()) {
+            segment_pos.insert(std::make_pair(file.segment_id_, segment_files.size()));
+            segment_files.push_back(file);
+        } else if (cache::CpuCacheMgr::GetInstance()->ItemExists(file.location_)) {
+            segment_files[iter->second] = file;
+        }
+    }
+
+    // ids are looked up in sorted order, the same way deletes are applied
+    IDNumbers temp_ids = id_array;
+    std::sort(temp_ids.begin(), temp_ids.end());
+    temp_ids.erase(std::unique(temp_ids.begin(), temp_ids.end()), temp_ids.end());
+    for (auto& file : segment_files) {
         if (temp_ids.empty()) {
             break;  // all vectors found, no need to continue
         }
-        // Load bloom filter
         std::string segment_dir;
         engine::utils::GetParentPath(file.location_, segment_dir);
         segment::SegmentReader segment_reader(segment_dir);
@@ -1489,65 +1672,82 @@ DBImpl::GetVectorsByIdHelper(const IDNumbers& id_array, std::vector<engine::Vect
             return status;
         }
 
-        for (IDNumbers::iterator it = temp_ids.begin(); it != temp_ids.end();) {
-            int64_t vector_id = *it;
-            // each id must has a VectorsData
-            // if vector not found for an id, its VectorsData's vector_count = 0, else 1
-            VectorsData& vector_ref = map_id2vector[vector_id];
+        std::vector<segment::doc_id_t> ids_to_check;
+        id_bloom_filter_ptr->Check(temp_ids, ids_to_check);
+        if (ids_to_check.empty()) {
+            files_holder.UnmarkFile(file);
+            continue;
+        }
 
-            // Check if the id is present in bloom filter.
-            if (id_bloom_filter_ptr->Check(vector_id)) {
-                // Load uids and check if the id is indeed present. If yes, find its offset.
-                std::vector<segment::doc_id_t> uids;
-                auto status = segment_reader.LoadUids(uids);
-                if (!status.ok()) {
-                    return status;
-                }
+        // an index in cache holds the uids and the deleted docs of the file, and mostly its raw vectors
+        auto index =
+            std::static_pointer_cast<knowhere::VecIndex>(cache::CpuCacheMgr::GetInstance()->GetIndex(file.location_));
 
-                auto found = std::find(uids.begin(), uids.end(), vector_id);
-                if (found != uids.end()) {
-                    auto offset = std::distance(uids.begin(), found);
+        segment::IdIndexPtr id_index;
+        status = segment_reader.LoadIdIndex(id_index);
+        if (!status.ok()) {
+            return status;
+        }
 
-                    // Check whether the id has been deleted
-                    segment::DeletedDocsPtr deleted_docs_ptr;
-                    status = segment_reader.LoadDeletedDocs(deleted_docs_ptr);
-                    if (!status.ok()) {
-                        LOG_ENGINE_ERROR_ << status.message();
-                        return status;
-                    }
-                    auto& deleted_docs = deleted_docs_ptr->GetDeletedDocs();
+        std::vector<segment::doc_id_t> found_ids;
+        std::vector<segment::offset_t> offsets;
+        id_index->Search(ids_to_check, found_ids, offsets);
+        if (offsets.empty()) {
+            files_holder.UnmarkFile(file);
+            continue;
+        }
 
-                    auto deleted = std::find(deleted_docs.begin(), deleted_docs.end(), offset);
-                    if (deleted == deleted_docs.end()) {
-                        // Load raw vector
-                        bool is_binary = utils::IsBinaryMetricType(file.metric_type_);
-                        size_t single_vector_bytes = is_binary ? file.dimension_ / 8 : file.dimension_ * sizeof(float);
-                        std::vector<uint8_t> raw_vector;
-                        status =
-                            segment_reader.LoadVectors(offset * single_vector_bytes, single_vector_bytes, raw_vector);
-                        if (!status.ok()) {
-                            LOG_ENGINE_ERROR_ << status.message();
-                            return status;
-                        }
+        faiss::ConcurrentBitsetPtr deleted = (index != nullptr) ? index->GetBlacklist() : nullptr;
+        if (deleted == nullptr) {
+            segment::DeletedDocsPtr deleted_docs_ptr;
+            status = segment_reader.LoadDeletedDocs(deleted_docs_ptr);
+            if (!status.ok()) {
+                LOG_ENGINE_ERROR_ << status.message();
+                return status;
+            }
+            deleted = std::make_shared<faiss::ConcurrentBitset>(id_index->Count());
+            deleted_docs_ptr->GetBitset(deleted);
+        }
 
-                        vector_ref.vector_count_ = 1;
-                        if (is_binary) {
-                            vector_ref.binary_data_.swap(raw_vector);
-                        } else {
-                            std::vector<float> float_vector;
-                            float_vector.resize(file.dimension_);
-                            memcpy(float_vector.data(), raw_vector.data(), single_vector_bytes);
-                            vector_ref.float_data_.swap(float_vector);
-                        }
-                        temp_ids.erase(it);
-                        continue;
-                    }
+        bool is_binary = utils::IsBinaryMetricType(file.metric_type_);
+        size_t single_vector_bytes = is_binary ? file.dimension_ / 8 : file.dimension_ * sizeof(float);
+        IDNumbers hit_ids;
+        for (size_t i = 0; i < found_ids.size(); ++i) {
+            // a duplicated uid is served by its first offset which is not deleted
+            if (deleted->test(offsets[i]) || (!hit_ids.empty() && hit_ids.back() == found_ids[i])) {
+                continue;
+            }
+
+            // copy the raw vector from the cached index, read it from disk when the index has no raw vectors
+            std::vector<uint8_t> raw_vector(single_vector_bytes);
+            if (index == nullptr || !index->GetVectorByOffset(offsets[i], raw_vector.data())) {
+                status = segment_reader.LoadVectors(offsets[i] * single_vector_bytes, single_vector_bytes, raw_vector);
+                if (!status.ok()) {
+                    LOG_ENGINE_ERROR_ << status.message();
+                    return status;
                 }
             }
 
-            it++;
+            // each id must has a VectorsData
+            // if vector not found for an id, its VectorsData's vector_count = 0, else 1
+            VectorsData& vector_ref = map_id2vector[found_ids[i]];
+            vector_ref.vector_count_ = 1;
+            if (is_binary) {
+                vector_ref.binary_data_.swap(raw_vector);
+            } else {
+                vector_ref.float_data_.resize(file.dimension_);
+                memcpy(vector_ref.float_data_.data(), raw_vector.data(), single_vector_bytes);
+            }
+            hit_ids.push_back(found_ids[i]);
         }
 
+        // found ids are sorted, drop them from the ids to look up in the next files
+        temp_ids.erase(std::remove_if(temp_ids.begin(), temp_ids.end(),
+                                      [&](int64_t id) {
+                                          return std::binary_search(hit_ids.begin(), hit_ids.end(), id);
+                                      }),
+                       temp_ids.end());
+
         // unmark file, allow the file to be deleted
         files_holder.UnmarkFile(file);
     }
@@ -1750,6 +1950,7 @@ DBImpl::CreateIndex(const std::shared_ptr<server::Context>& context, const std::
 
     {
         std::unique_lock<std::mutex> lock(build_index_mutex_);
+        FinishBuildIndex(true);
 
         // step 2: check index difference
         CollectionIndex old_index;
@@ -2225,8 +2426,123 @@ DBImpl::Query(const std::shared_ptr<server::Context>& context, const std::string
         return SHUTDOWN_ERROR;
     }
 
-    Status status;
     meta::FilesHolder files_holder;
+    auto status = GetFilesToSearch(collection_id, partition_tags, files_holder);
+    if (!status.ok() || files_holder.HoldFiles().empty()) {
+        return status;
+    }
+
+    // the files to search only change when the visible data does, so a cached result of the same version is exact
+    auto result_cache = SearchResultCache::GetInstance();
+    std::string version;
+    if (result_cache->Enabled()) {
+        version = SearchResultCache::Version(files_holder.HoldFiles());
+        if (result_cache->Get(collection_id, partition_tags, k, extra_params, vectors, version, result_ids,
+                              result_distances)) {
+            return Status::OK();
+        }
+    }
+
+    cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info before query
+    ResultLims result_lims;
+    status = QueryAsync(tracer.Context(), files_holder, k, extra_params, vectors, result_lims, result_ids,
+                        result_distances);
+    cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info after query
+
+    if (status.ok() && !version.empty()) {
+        result_cache->Put(collection_id, partition_tags, k, extra_params, vectors, version, result_ids,
+                          result_distances);
+    }
+
+    return status;
+}
+
+Status
+DBImpl::QueryByRange(const std::shared_ptr<server::Context>& context, const std::string& collection_id,
+                     const std::vector<std::string>& partition_tags, const milvus::json& extra_params,
+                     VectorsData& vectors, ResultLims& result_lims, ResultIds& result_ids,
+                     ResultDistances& result_distances) {
+    milvus::server::ContextChild tracer(context, "Query by range");
+
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    // an empty result still carries one (empty) slot per query
+    result_lims.assign(vectors.vector_count_ + 1, 0);
+    result_ids.clear();
+    result_distances.clear();
+
+    meta::FilesHolder files_holder;
+    auto status = GetFilesToSearch(collection_id, partition_tags, files_holder);
+    if (!status.ok() || files_holder.HoldFiles().empty()) {
+        return status;
+    }
+
+    cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info before query
+    ResultLims lims;
+    status = QueryAsync(tracer.Context(), files_holder, 0, extra_params, vectors, lims, result_ids, result_distances);
+    cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info after query
+    if (status.ok() && !lims.empty()) {
+        result_lims.swap(lims);
+    }
+
+    return status;
+}
+
+Status
+DBImpl::QueryByFileID(const std::shared_ptr<server::Context>& context, const std::vector<std::string>& file_ids,
+                      uint64_t k, const milvus::json& extra_params, VectorsData& vectors, ResultIds& result_ids,
+                      ResultDistances& result_distances) {
+    milvus::server::ContextChild tracer(context, "Query by file id");
+
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    // get specified files
+    std::vector<size_t> ids;
+    for (auto& id : file_ids) {
+        std::string::size_type sz;
+        ids.push_back(std::stoul(id, &sz));
+    }
+
+    meta::FilesHolder files_holder;
+    auto status = meta_ptr_->FilesByID(ids, files_holder);
+    if (!status.ok()) {
+        return status;
+    }
+
+    milvus::engine::meta::SegmentsSchema& search_files = files_holder.HoldFiles();
+    if (search_files.empty()) {
+        return Status(DB_ERROR, "Invalid file id");
+    }
+
+    cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info before query
+    ResultLims result_lims;
+    status = QueryAsync(tracer.Context(), files_holder, k, extra_params, vectors, result_lims, result_ids,
+                        result_distances);
+    cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info after query
+
+    return status;
+}
+
+Status
+DBImpl::Size(uint64_t& result) {
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return SHUTDOWN_ERROR;
+    }
+
+    return meta_ptr_->Size(result);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// internal methods
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+Status
+DBImpl::GetFilesToSearch(const std::string& collection_id, const std::vector<std::string>& partition_tags,
+                         meta::FilesHolder& files_holder) {
+    Status status;
     if (partition_tags.empty()) {
 #if 0
         // no partition tag specified, means search in whole collection
@@ -2262,10 +2578,6 @@ DBImpl::Query(const std::shared_ptr<server::Context>& context, const std::string
             return status;
         }
 #endif
-
-        if (files_holder.HoldFiles().empty()) {
-            return Status::OK();  // no files to search
-        }
     } else {
 #if 0
         // get files from specified partitions
@@ -2292,73 +2604,28 @@ DBImpl::Query(const std::shared_ptr<server::Context>& context, const std::string
 
         status = meta_ptr_->FilesToSearchEx(collection_id, partition_ids, files_holder);
 #endif
-        if (files_holder.HoldFiles().empty()) {
-            return Status::OK();  // no files to search
-        }
-    }
-
-    cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info before query
-    status = QueryAsync(tracer.Context(), files_holder, k, extra_params, vectors, result_ids, result_distances);
-    cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info after query
-
-    return status;
-}
-
-Status
-DBImpl::QueryByFileID(const std::shared_ptr<server::Context>& context, const std::vector<std::string>& file_ids,
-                      uint64_t k, const milvus::json& extra_params, VectorsData& vectors, ResultIds& result_ids,
-                      ResultDistances& result_distances) {
-    milvus::server::ContextChild tracer(context, "Query by file id");
-
-    if (!initialized_.load(std::memory_order_acquire)) {
-        return SHUTDOWN_ERROR;
-    }
-
-    // get specified files
-    std::vector<size_t> ids;
-    for (auto& id : file_ids) {
-        std::string::size_type sz;
-        ids.push_back(std::stoul(id, &sz));
     }
 
-    meta::FilesHolder files_holder;
-    auto status = meta_ptr_->FilesByID(ids, files_holder);
-    if (!status.ok()) {
-        return status;
-    }
-
-    milvus::engine::meta::SegmentsSchema& search_files = files_holder.HoldFiles();
-    if (search_files.empty()) {
-        return Status(DB_ERROR, "Invalid file id");
-    }
-
-    cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info before query
-    status = QueryAsync(tracer.Context(), files_holder, k, extra_params, vectors, result_ids, result_distances);
-    cache::CpuCacheMgr::GetInstance()->PrintInfo();  // print cache info after query
-
-    return status;
+    // callers treat an empty holder as nothing to search
+    return Status::OK();
 }
 
-Status
-DBImpl::Size(uint64_t& result) {
-    if (!initialized_.load(std::memory_order_acquire)) {
-        return SHUTDOWN_ERROR;
-    }
-
-    return meta_ptr_->Size(result);
-}
-
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-// internal methods
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 Status
 DBImpl::QueryAsync(const std::shared_ptr<server::Context>& context, meta::FilesHolder& files_holder, uint64_t k,
-                   const milvus::json& extra_params, VectorsData& vectors, ResultIds& result_ids,
-                   ResultDistances& result_distances) {
+                   const milvus::json& extra_params, VectorsData& vectors, ResultLims& result_lims,
+                   ResultIds& result_ids, ResultDistances& result_distances) {
     milvus::server::ContextChild tracer(context, "Query Async");
     server::CollectQueryMetrics metrics(vectors.vector_count_);
 
     milvus::engine::meta::SegmentsSchema& files = files_holder.HoldFiles();
+    std::set<std::string> searched_collections;
+    for (auto& file : files) {
+        searched_collections.insert(file.collection_id_);
+    }
+    for (auto& collection_id : searched_collections) {
+        index_build_queue_.RecordSearch(collection_id);
+    }
+
     if (files.size() > milvus::scheduler::TASK_TABLE_MAX_COUNT) {
         std::string msg =
             "Search files count exceed scheduler limit: " + std::to_string(milvus::scheduler::TASK_TABLE_MAX_COUNT);
@@ -2371,6 +2638,10 @@ DBImpl::QueryAsync(const std::shared_ptr<server::Context>& context, meta::FilesH
     // step 1: construct search job
     LOG_ENGINE_DEBUG_ << LogOut("Engine query begin, index file count: %ld", files.size());
     scheduler::SearchJobPtr job = std::make_shared<scheduler::SearchJob>(tracer.Context(), k, extra_params, vectors);
+    if (options_.segment_pruning_ && !job->range_search()) {
+        return PrunedQueryAsync(tracer.Context(), files_holder, k, extra_params, vectors, result_lims, result_ids,
+                                result_distances);
+    }
     for (auto& file : files) {
         scheduler::SegmentSchemaPtr file_ptr = std::make_shared<meta::SegmentSchema>(file);
         job->AddIndexFile(file_ptr);
@@ -2392,6 +2663,7 @@ DBImpl::QueryAsync(const std::shared_ptr<server::Context>& context, meta::FilesH
     }
 
     // step 3: construct results
+    result_lims = job->GetResultLims();
     result_ids = job->GetResultIds();
     result_distances = job->GetResultDistances();
     rc.ElapseFromBegin("Engine query totally cost");
@@ -2399,6 +2671,62 @@ DBImpl::QueryAsync(const std::shared_ptr<server::Context>& context, meta::FilesH
     return Status::OK();
 }
 
+Status
+DBImpl::PrunedQueryAsync(const std::shared_ptr<server::Context>& context, meta::FilesHolder& files_holder,
+                         uint64_t k, const milvus::json& extra_params, VectorsData& vectors, ResultLims& result_lims,
+                         ResultIds& result_ids, ResultDistances& result_distances) {
+    TimeRecorder rc("");
+
+    // each wave merges into the topk of the waves before it, the pruner drops the segments that cannot improve it
+    SegmentPruner pruner(files_holder.HoldFiles(), vectors, k);
+    result_lims.clear();
+    result_ids.clear();
+    result_distances.clear();
+
+    Status status;
+    size_t searched_count = 0;
+
+    // Suspend builder
+    SuspendIfFirst();
+
+    auto wave = pruner.NextWave(result_ids, result_distances);
+    while (!wave.empty()) {
+        scheduler::SearchJobPtr job = std::make_shared<scheduler::SearchJob>(context, k, extra_params, vectors);
+        for (auto& file : wave) {
+            scheduler::SegmentSchemaPtr file_ptr = std::make_shared<meta::SegmentSchema>(file);
+            job->AddIndexFile(file_ptr);
+        }
+        searched_count += wave.size();
+        job->GetResultIds().swap(result_ids);
+        job->GetResultDistances().swap(result_distances);
+
+        scheduler::JobMgrInst::GetInstance()->Put(job);
+        job->WaitResult();
+
+        job->GetResultIds().swap(result_ids);
+        job->GetResultDistances().swap(result_distances);
+        status = job->GetStatus();
+        if (!status.ok()) {
+            break;
+        }
+        wave = pruner.NextWave(result_ids, result_distances);
+    }
+
+    // Resume builder
+    ResumeIfLast();
+
+    files_holder.ReleaseFiles();
+    if (!status.ok()) {
+        return status;
+    }
+
+    LOG_ENGINE_DEBUG_ << LogOut("Engine query searched %ld index files, pruned %ld", searched_count,
+                                pruner.PrunedCount());
+    rc.ElapseFromBegin("Engine query totally cost");
+
+    return Status::OK();
+}
+
 Status
 DBImpl::HybridQueryAsync(const std::shared_ptr<server::Context>& context, const std::string& collection_id,
                          meta::FilesHolder& files_holder, query::GeneralQueryPtr general_query,
@@ -2516,10 +2844,13 @@ DBImpl::WaitMergeFileFinish() {
 void
 DBImpl::WaitBuildIndexFinish() {
     //    LOG_ENGINE_DEBUG_ << "Begin WaitBuildIndexFinish";
-    std::lock_guard<std::mutex> lck(index_result_mutex_);
-    for (auto& iter : index_thread_results_) {
-        iter.wait();
+    {
+        std::lock_guard<std::mutex> lck(index_result_mutex_);
+        for (auto& iter : index_thread_results_) {
+            iter.wait();
+        }
     }
+    FinishBuildIndex(true);
     //    LOG_ENGINE_DEBUG_ << "End WaitBuildIndexFinish";
 }
 
@@ -2573,7 +2904,7 @@ DBImpl::StartMergeTask(const std::set<std::string>& merge_collection_ids, bool f
         if (merge_thread_results_.empty()) {
             // start merge file thread
             merge_thread_results_.push_back(
-                merge_thread_pool_.enqueue(&DBImpl::BackgroundMerge, this, merge_collection_ids, force_merge_all));
+                merge_thread_pool_.Enqueue(&DBImpl::BackgroundMerge, this, merge_collection_ids, force_merge_all));
         }
     }
 
@@ -2710,6 +3041,9 @@ DBImpl::BackgroundMerge(std::set<std::string> collection_ids, bool force_merge_a
         meta_ptr_->CleanUpFilesWithTTL(ttl);
     }
 
+    // merged files may be ready to index
+    swn_index_.Notify();
+
     // LOG_ENGINE_TRACE_ << " Background merge thread exit";
 }
 
@@ -2730,55 +3064,77 @@ DBImpl::StartBuildIndexTask() {
     {
         std::lock_guard<std::mutex> lck(index_result_mutex_);
         if (index_thread_results_.empty()) {
-            index_thread_results_.push_back(index_thread_pool_.enqueue(&DBImpl::BackgroundBuildIndex, this));
+            index_thread_results_.push_back(index_thread_pool_.Enqueue(&DBImpl::BackgroundBuildIndex, this));
         }
     }
 }
 
 void
 DBImpl::BackgroundBuildIndex() {
+    // step 1: record the builds finished since the last round
+    FinishBuildIndex(false);
+
     std::unique_lock<std::mutex> lock(build_index_mutex_);
+    size_t building = index_build_queue_.BuildingCount();
+    size_t window = IndexBuildWindow();
+    if (building >= window) {
+        return;
+    }
+
     meta::FilesHolder files_holder;
     meta_ptr_->FilesToIndex(files_holder);
 
     milvus::engine::meta::SegmentsSchema to_index_files = files_holder.HoldFiles();
     Status status = index_failed_checker_.IgnoreFailedIndexFiles(to_index_files);
+    index_build_queue_.Prioritize(to_index_files);
+    if (to_index_files.empty()) {
+        return;
+    }
 
-    if (!to_index_files.empty()) {
-        LOG_ENGINE_DEBUG_ << "Background build index thread begin " << to_index_files.size() << " files";
+    // step 2: put the files of highest priority to scheduler, the others wait for the next round
+    for (auto& file : to_index_files) {
+        if (building >= window) {
+            break;
+        }
+        scheduler::BuildIndexJobPtr job = std::make_shared<scheduler::BuildIndexJob>(meta_ptr_, options_);
+        scheduler::SegmentSchemaPtr file_ptr = std::make_shared<meta::SegmentSchema>(file);
+        job->AddToIndexFiles(file_ptr);
+        job->SetFinishCallback([this]() { swn_index_.Notify(); });  // refill without waiting for the interval
+        index_build_queue_.AddBuilding(file_ptr, job);
+        scheduler::JobMgrInst::GetInstance()->Put(job);
+        ++building;
+        LOG_ENGINE_DEBUG_ << "Build index of file " << file.file_id_ << ", " << file.row_count_ << " rows";
+    }
+    LOG_ENGINE_DEBUG_ << "Building index of " << building << " files, " << to_index_files.size()
+                      << " files to index";
+}
 
-        // step 2: put build index task to scheduler
-        std::vector<std::pair<scheduler::BuildIndexJobPtr, scheduler::SegmentSchemaPtr>> job2file_map;
-        for (auto& file : to_index_files) {
-            scheduler::BuildIndexJobPtr job = std::make_shared<scheduler::BuildIndexJob>(meta_ptr_, options_);
-            scheduler::SegmentSchemaPtr file_ptr = std::make_shared<meta::SegmentSchema>(file);
-            job->AddToIndexFiles(file_ptr);
-            scheduler::JobMgrInst::GetInstance()->Put(job);
-            job2file_map.push_back(std::make_pair(job, file_ptr));
-        }
-
-        // step 3: wait build index finished and mark failed files
-        int64_t completed = 0;
-        for (auto iter = job2file_map.begin(); iter != job2file_map.end(); ++iter) {
-            scheduler::BuildIndexJobPtr job = iter->first;
-            meta::SegmentSchema& file_schema = *(iter->second.get());
-            job->WaitBuildIndexFinish();
-            LOG_ENGINE_INFO_ << "Build Index Progress: " << ++completed << " of " << job2file_map.size();
-            if (!job->GetStatus().ok()) {
-                Status status = job->GetStatus();
-                LOG_ENGINE_ERROR_ << "Building index job " << job->id() << " failed: " << status.ToString();
-
-                index_failed_checker_.MarkFailedIndexFile(file_schema, status.message());
-            } else {
-                LOG_ENGINE_DEBUG_ << "Building index job " << job->id() << " succeed.";
+void
+DBImpl::FinishBuildIndex(bool wait_all) {
+    auto finished = index_build_queue_.TakeFinished(wait_all);
+    for (auto& building : finished) {
+        scheduler::BuildIndexJobPtr job = building.job_;
+        meta::SegmentSchema& file_schema = *(building.file_.get());
+        if (!job->GetStatus().ok()) {
+            Status status = job->GetStatus();
+            LOG_ENGINE_ERROR_ << "Building index job " << job->id() << " failed: " << status.ToString();
+
+            index_failed_checker_.MarkFailedIndexFile(file_schema, status.message());
+        } else {
+            LOG_ENGINE_DEBUG_ << "Building index job " << job->id() << " succeed.";
 
-                index_failed_checker_.MarkSucceedIndexFile(file_schema);
-            }
-            status = files_holder.UnmarkFile(file_schema);
-            LOG_ENGINE_DEBUG_ << "Finish build index file " << file_schema.file_id_;
+            index_failed_checker_.MarkSucceedIndexFile(file_schema);
+
+            // the file became TO_INDEX at its last update
+            double seconds = (utils::GetMicroSecTimeStamp() - file_schema.updated_time_) / 1e6;
+            server::Metrics::GetInstance().TimeToIndexedSecondsHistogramObserve(seconds);
+            LOG_ENGINE_DEBUG_ << "File " << file_schema.file_id_ << " indexed " << seconds
+                              << " seconds after it was ready to index";
         }
+        LOG_ENGINE_DEBUG_ << "Finish build index file " << file_schema.file_id_;
+    }
 
-        LOG_ENGINE_DEBUG_ << "Background build index thread finished";
+    if (!finished.empty()) {
         index_req_swn_.Notify();  // notify CreateIndex check circle
     }
 }
@@ -3063,7 +3419,7 @@ DBImpl::ExecWalRecord(const wal::MXLogRecord& record) {
 
             status = mem_mgr_->InsertEntities(
                 target_collection_name, record.length, record.ids, (record.data_size / record.length / sizeof(float)),
-                (const float*)record.data, record.attr_nbytes, record.attr_data_size, record.attr_data, record.lsn);
+                (const float*)record.data, record.attrs, record.lsn);
             force_flush_if_mem_full();
 
             // metrics
@@ -3078,9 +3434,14 @@ DBImpl::ExecWalRecord(const wal::MXLogRecord& record) {
                 return status;
             }
 
-            status = mem_mgr_->InsertVectors(target_collection_name, record.length, record.ids,
-                                             (record.data_size / record.length / sizeof(uint8_t)),
-                                             (const u_int8_t*)record.data, record.lsn);
+            if (record.rows != nullptr) {
+                status = mem_mgr_->InsertVectors(target_collection_name, record.length, record.ids, record.rows,
+                                                 record.data_size / record.length, true, record.lsn);
+            } else {
+                status = mem_mgr_->InsertVectors(target_collection_name, record.length, record.ids,
+                                                 (record.data_size / record.length / sizeof(uint8_t)),
+                                                 (const u_int8_t*)record.data, record.lsn);
+            }
             force_flush_if_mem_full();
 
             // metrics
@@ -3096,9 +3457,14 @@ DBImpl::ExecWalRecord(const wal::MXLogRecord& record) {
                 return status;
             }
 
-            status = mem_mgr_->InsertVectors(target_collection_name, record.length, record.ids,
-                                             (record.data_size / record.length / sizeof(float)),
-                                             (const float*)record.data, record.lsn);
+            if (record.rows != nullptr) {
+                status = mem_mgr_->InsertVectors(target_collection_name, record.length, record.ids, record.rows,
+                                                 record.data_size / record.length, false, record.lsn);
+            } else {
+                status = mem_mgr_->InsertVectors(target_collection_name, record.length, record.ids,
+                                                 (record.data_size / record.length / sizeof(float)),
+                                                 (const float*)record.data, record.lsn);
+            }
             force_flush_if_mem_full();
 
             // metrics
@@ -3279,6 +3645,24 @@ DBImpl::BackgroundFlushThread() {
     }
 }
 
+void
+DBImpl::BackgroundCompactThread() {
+    SetThreadName("compact_thread");
+    server::SystemInfo::GetInstance().Init();
+    while (true) {
+        if (!initialized_.load(std::memory_order_acquire)) {
+            LOG_ENGINE_DEBUG_ << "DB background compact thread exit";
+            break;
+        }
+
+        swn_compact_.Wait_For(std::chrono::seconds(options_.auto_compact_interval_));
+        if (!initialized_.load(std::memory_order_acquire)) {
+            continue;
+        }
+        BackgroundCompact();
+    }
+}
+
 void
 DBImpl::BackgroundMetricThread() {
     SetThreadName("metric_thread");
@@ -25,13 +25,14 @@
 #include "config/handler/CacheConfigHandler.h"
 #include "config/handler/EngineConfigHandler.h"
 #include "db/DB.h"
+#include "db/IndexBuildQueue.h"
 #include "db/IndexFailedChecker.h"
 #include "db/SimpleWaitNotify.h"
 #include "db/Types.h"
 #include "db/insert/MemManager.h"
 #include "db/merge/MergeManager.h"
 #include "db/meta/FilesHolder.h"
-#include "utils/ThreadPool.h"
+#include "utils/TaskExecutor.h"
 #include "wal/WalManager.h"
 
 namespace milvus {
@@ -187,6 +188,12 @@ class DBImpl : public DB, public server::CacheConfigHandler, public server::Engi
           const std::vector<std::string>& partition_tags, uint64_t k, const milvus::json& extra_params,
           VectorsData& vectors, ResultIds& result_ids, ResultDistances& result_distances) override;
 
+    Status
+    QueryByRange(const std::shared_ptr<server::Context>& context, const std::string& collection_id,
+                 const std::vector<std::string>& partition_tags, const milvus::json& extra_params,
+                 VectorsData& vectors, ResultLims& result_lims, ResultIds& result_ids,
+                 ResultDistances& result_distances) override;
+
     Status
     QueryByFileID(const std::shared_ptr<server::Context>& context, const std::vector<std::string>& file_ids, uint64_t k,
                   const milvus::json& extra_params, VectorsData& vectors, ResultIds& result_ids,
@@ -206,11 +213,20 @@ class DBImpl : public DB, public server::CacheConfigHandler, public server::Engi
     OnUseBlasThresholdChanged(int64_t threshold) override;
 
  private:
+    Status
+    GetFilesToSearch(const std::string& collection_id, const std::vector<std::string>& partition_tags,
+                     meta::FilesHolder& files_holder);
+
     Status
     QueryAsync(const std::shared_ptr<server::Context>& context, meta::FilesHolder& files_holder, uint64_t k,
-               const milvus::json& extra_params, VectorsData& vectors, ResultIds& result_ids,
+               const milvus::json& extra_params, VectorsData& vectors, ResultLims& result_lims, ResultIds& result_ids,
                ResultDistances& result_distances);
 
+    Status
+    PrunedQueryAsync(const std::shared_ptr<server::Context>& context, meta::FilesHolder& files_holder, uint64_t k,
+                     const milvus::json& extra_params, VectorsData& vectors, ResultLims& result_lims,
+                     ResultIds& result_ids, ResultDistances& result_distances);
+
     Status
     HybridQueryAsync(const std::shared_ptr<server::Context>& context, const std::string& collection_id,
                      meta::FilesHolder& files_holder, query::GeneralQueryPtr general_query, query::QueryPtr query_ptr,
@@ -243,6 +259,9 @@ class DBImpl : public DB, public server::CacheConfigHandler, public server::Engi
     void
     BackgroundIndexThread();
 
+    void
+    BackgroundCompactThread();
+
     void
     WaitMergeFileFinish();
 
@@ -267,9 +286,19 @@ class DBImpl : public DB, public server::CacheConfigHandler, public server::Engi
     void
     BackgroundBuildIndex();
 
+    // record the result of the finished builds, wait_all waits for every build in flight first
+    void
+    FinishBuildIndex(bool wait_all);
+
     Status
     CompactFile(const meta::SegmentSchema& file, double threshold, meta::SegmentsSchema& files_to_update);
 
+    void
+    BackgroundCompact();
+
+    Status
+    AutoCompactFile(const meta::SegmentSchema& file, size_t deleted_docs_size);
+
     Status
     GetFilesToBuildIndex(const std::string& collection_id, const std::vector<int>& file_types,
                          meta::FilesHolder& files_holder);
@@ -324,24 +353,30 @@ class DBImpl : public DB, public server::CacheConfigHandler, public server::Engi
     std::thread bg_flush_thread_;
     std::thread bg_metric_thread_;
     std::thread bg_index_thread_;
+    std::thread bg_compact_thread_;
 
     SimpleWaitNotify swn_wal_;
     SimpleWaitNotify swn_flush_;
     SimpleWaitNotify swn_metric_;
     SimpleWaitNotify swn_index_;
+    SimpleWaitNotify swn_compact_;
 
     SimpleWaitNotify flush_req_swn_;
     SimpleWaitNotify index_req_swn_;
 
-    ThreadPool merge_thread_pool_;
+    TaskExecutor merge_thread_pool_;
     std::mutex merge_result_mutex_;
     std::list<std::future<void>> merge_thread_results_;
 
-    ThreadPool index_thread_pool_;
+    TaskExecutor index_thread_pool_;
     std::mutex index_result_mutex_;
     std::list<std::future<void>> index_thread_results_;
 
+    TaskExecutor compact_thread_pool_;
+
+    // held while builds are submitted, holders also wait for the builds in flight to stop all builds
     std::mutex build_index_mutex_;
+    IndexBuildQueue index_build_queue_;
 
     IndexFailedChecker index_failed_checker_;
 
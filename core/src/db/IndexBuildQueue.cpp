@@ -0,0 +1,138 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/IndexBuildQueue.h"
+#include "db/Utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <utility>
+
+namespace milvus {
+namespace engine {
+
+void
+IndexBuildQueue::RecordSearch(const std::string& collection_id) {
+    int64_t now_us = utils::GetMicroSecTimeStamp();
+    std::lock_guard<std::mutex> lck(rate_mutex_);
+    auto& stat = search_rates_[collection_id];
+    double elapsed_sec = (now_us - stat.time_us_) / 1e6;
+    stat.rate_ = stat.rate_ * std::exp(-elapsed_sec / SEARCH_RATE_WINDOW_SEC) + 1.0 / SEARCH_RATE_WINDOW_SEC;
+    stat.time_us_ = now_us;
+}
+
+double
+IndexBuildQueue::SearchRate(const std::string& collection_id) {
+    int64_t now_us = utils::GetMicroSecTimeStamp();
+    std::lock_guard<std::mutex> lck(rate_mutex_);
+    auto iter = search_rates_.find(collection_id);
+    if (iter == search_rates_.end()) {
+        return 0.0;
+    }
+    double elapsed_sec = (now_us - iter->second.time_us_) / 1e6;
+    return iter->second.rate_ * std::exp(-elapsed_sec / SEARCH_RATE_WINDOW_SEC);
+}
+
+double
+IndexBuildQueue::Priority(const meta::SegmentSchema& file, double search_rate, int64_t now_us) {
+    // benefit: the brute force rows every search stops scanning, cost: the build time, linear in rows plus the
+    // fixed cost to load and serialize a segment, so big segments of busy collections go first
+    double rows = file.row_count_;
+    double benefit = (1.0 + search_rate) * rows;
+    double cost = rows + INDEX_BUILD_FIXED_COST_ROWS;
+
+    // the file became TO_INDEX at its last update, a waiting segment gains priority so none starves
+    double wait_sec = std::max<int64_t>(now_us - file.updated_time_, 0) / 1e6;
+    return benefit / cost * (1.0 + wait_sec / INDEX_BUILD_AGING_SEC);
+}
+
+void
+IndexBuildQueue::Prioritize(meta::SegmentsSchema& files) {
+    std::set<size_t> building_ids;
+    {
+        std::lock_guard<std::mutex> lck(building_mutex_);
+        for (auto& building : building_) {
+            building_ids.insert(building.file_->id_);
+        }
+    }
+    files.erase(std::remove_if(files.begin(), files.end(),
+                               [&](const meta::SegmentSchema& file) { return building_ids.count(file.id_) > 0; }),
+                files.end());
+
+    int64_t now_us = utils::GetMicroSecTimeStamp();
+    std::unordered_map<std::string, double> rates;
+    std::vector<std::pair<double, size_t>> priorities;
+    for (size_t i = 0; i < files.size(); ++i) {
+        auto& collection_id = files[i].collection_id_;
+        if (rates.find(collection_id) == rates.end()) {
+            rates[collection_id] = SearchRate(collection_id);
+        }
+        priorities.emplace_back(-Priority(files[i], rates[collection_id], now_us), i);
+    }
+    std::sort(priorities.begin(), priorities.end());
+
+    meta::SegmentsSchema sorted_files;
+    sorted_files.reserve(files.size());
+    for (auto& priority : priorities) {
+        sorted_files.emplace_back(std::move(files[priority.second]));
+    }
+    files.swap(sorted_files);
+}
+
+void
+IndexBuildQueue::AddBuilding(const meta::SegmentSchemaPtr& file, const scheduler::BuildIndexJobPtr& job) {
+    Building building;
+    building.file_ = file;
+    building.job_ = job;
+    building.holder_ = std::make_shared<meta::FilesHolder>();
+    building.holder_->MarkFile(*file);
+
+    std::lock_guard<std::mutex> lck(building_mutex_);
+    building_.emplace_back(std::move(building));
+}
+
+size_t
+IndexBuildQueue::BuildingCount() {
+    std::lock_guard<std::mutex> lck(building_mutex_);
+    return building_.size();
+}
+
+std::vector<IndexBuildQueue::Building>
+IndexBuildQueue::TakeFinished(bool wait_all) {
+    if (wait_all) {
+        std::vector<scheduler::BuildIndexJobPtr> jobs;
+        {
+            std::lock_guard<std::mutex> lck(building_mutex_);
+            for (auto& building : building_) {
+                jobs.push_back(building.job_);
+            }
+        }
+        for (auto& job : jobs) {
+            job->WaitBuildIndexFinish();
+        }
+    }
+
+    std::vector<Building> finished;
+    std::lock_guard<std::mutex> lck(building_mutex_);
+    for (auto iter = building_.begin(); iter != building_.end();) {
+        if (iter->job_->IsBuildIndexFinished()) {
+            finished.emplace_back(std::move(*iter));
+            iter = building_.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+    return finished;
+}
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,86 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "db/meta/FilesHolder.h"
+#include "db/meta/Meta.h"
+#include "scheduler/job/BuildIndexJob.h"
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace milvus {
+namespace engine {
+
+// search rates are averaged over this window
+constexpr double SEARCH_RATE_WINDOW_SEC = 60.0;
+// loading and serializing a segment costs about as much as building the index of this many rows
+constexpr double INDEX_BUILD_FIXED_COST_ROWS = 100000.0;
+// the priority of a waiting segment grows linearly with its wait, by its initial value every this many seconds
+constexpr double INDEX_BUILD_AGING_SEC = 60.0;
+
+/*
+ * Segments waiting for an index and the builds in flight. Instead of building every TO_INDEX segment in one batch,
+ * the DB keeps a few builds in the scheduler and refills them with the segments of highest priority as they finish.
+ */
+class IndexBuildQueue {
+ public:
+    struct Building {
+        meta::SegmentSchemaPtr file_;
+        scheduler::BuildIndexJobPtr job_;
+        std::shared_ptr<meta::FilesHolder> holder_;  // keeps the file from being deleted while it is built
+    };
+
+    void
+    RecordSearch(const std::string& collection_id);
+
+    // searches per second of the collection
+    double
+    SearchRate(const std::string& collection_id);
+
+    // drop the files already building and sort the rest, highest priority first
+    void
+    Prioritize(meta::SegmentsSchema& files);
+
+    void
+    AddBuilding(const meta::SegmentSchemaPtr& file, const scheduler::BuildIndexJobPtr& job);
+
+    size_t
+    BuildingCount();
+
+    // remove and return the finished builds, wait_all waits for every build in flight first
+    std::vector<Building>
+    TakeFinished(bool wait_all);
+
+ private:
+    double
+    Priority(const meta::SegmentSchema& file, double search_rate, int64_t now_us);
+
+ private:
+    struct SearchRateStat {
+        double rate_ = 0.0;
+        int64_t time_us_ = 0;
+    };
+
+    std::mutex rate_mutex_;
+    std::unordered_map<std::string, SearchRateStat> search_rates_;
+
+    std::mutex building_mutex_;
+    std::list<Building> building_;
+};
+
+}  // namespace engine
+}  // namespace milvus
@@ -71,9 +71,27 @@ struct DBOptions {
     size_t insert_buffer_size_ = 4 * GB;
     bool insert_cache_immediately_ = false;
 
+    // raw vectors held while an index is built, 0 means the whole segment is loaded
+    int64_t build_index_buffer_size_ = 1 * GB;
+
+    // results of repeated searches, 0 means they are not cached
+    int64_t search_result_cache_size_ = 0;
+
+    // topk searches visit the segments in waves and skip those whose vector summary cannot beat the kth result
+    bool segment_pruning_ = false;
+
     int64_t auto_flush_interval_ = 1;
     int64_t file_cleanup_timeout_ = 10;
 
+    // background compaction, segments whose deleted ratio reaches the threshold are rewritten
+    int64_t auto_compact_interval_ = 0;  // seconds, 0 means disabled
+    double auto_compact_threshold_ = 0.2;
+    uint64_t auto_compact_max_size_ = 1 * GB;  // bytes of segments rewritten per round at most
+    uint64_t auto_compact_thread_num_ = 2;
+
+    // segments deletes are applied to in parallel on flush
+    uint64_t apply_delete_thread_num_ = 4;
+
     bool metric_enable_ = false;
 
     // wal relative configurations
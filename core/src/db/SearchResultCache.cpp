@@ -0,0 +1,159 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/SearchResultCache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <tuple>
+
+#include "metrics/Metrics.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace engine {
+
+namespace {
+
+void
+HashCombine(size_t& seed, size_t value) {
+    seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+}
+
+}  // namespace
+
+SearchResultCache::SearchResultCache() {
+    cache_ = std::make_shared<cache::Cache<cache::DataObjPtr>>(0, 1UL << 32, "[CACHE SEARCH RESULT]");
+}
+
+SearchResultCache*
+SearchResultCache::GetInstance() {
+    static SearchResultCache s_mgr;
+    return &s_mgr;
+}
+
+void
+SearchResultCache::Reset(int64_t capacity) {
+    enabled_ = false;
+    ClearCache();
+    if (capacity > 0) {
+        SetCapacity(capacity);
+        enabled_ = true;
+    }
+    hits_ = 0;
+    misses_ = 0;
+}
+
+std::string
+SearchResultCache::Version(const meta::SegmentsSchema& files) {
+    // a flush or merge adds files, an index swap adds one and retires another, a delete updates the row count, and
+    // every update stamps the file, so the stamps of the newest file and the whole set cover each change
+    std::vector<std::tuple<size_t, int32_t, uint64_t, int64_t>> stamps;
+    stamps.reserve(files.size());
+    int64_t max_updated_time = 0;
+    for (auto& file : files) {
+        stamps.emplace_back(file.id_, file.file_type_, file.row_count_, file.updated_time_);
+        max_updated_time = std::max(max_updated_time, file.updated_time_);
+    }
+    std::sort(stamps.begin(), stamps.end());
+
+    size_t seed = 0;
+    for (auto& stamp : stamps) {
+        HashCombine(seed, std::get<0>(stamp));
+        HashCombine(seed, std::get<1>(stamp));
+        HashCombine(seed, std::get<2>(stamp));
+        HashCombine(seed, std::get<3>(stamp));
+    }
+    return std::to_string(files.size()) + "_" + std::to_string(max_updated_time) + "_" + std::to_string(seed);
+}
+
+bool
+SearchResultCache::Get(const std::string& collection_id, const std::vector<std::string>& partition_tags, uint64_t k,
+                       const milvus::json& extra_params, const VectorsData& vectors, const std::string& version,
+                       ResultIds& result_ids, ResultDistances& result_distances) {
+    if (!enabled_) {
+        return false;
+    }
+
+    auto query = QueryBytes(vectors);
+    auto key = Key(collection_id, partition_tags, k, extra_params, query, version);
+    auto result = std::static_pointer_cast<SearchResult>(GetItem(key));
+
+    // the key only holds a hash of the query, compare the whole of it
+    if (result == nullptr || result->query_ != query) {
+        ++misses_;
+        server::Metrics::GetInstance().SearchResultCacheMissTotalIncrement();
+        return false;
+    }
+
+    result_ids = result->ids_;
+    result_distances = result->distances_;
+    ++hits_;
+    server::Metrics::GetInstance().SearchResultCacheHitTotalIncrement();
+    LOG_ENGINE_DEBUG_ << "Search result cache hit in collection " << collection_id << ", hit rate " << HitRate();
+    return true;
+}
+
+void
+SearchResultCache::Put(const std::string& collection_id, const std::vector<std::string>& partition_tags, uint64_t k,
+                       const milvus::json& extra_params, const VectorsData& vectors, const std::string& version,
+                       const ResultIds& result_ids, const ResultDistances& result_distances) {
+    if (!enabled_) {
+        return;
+    }
+
+    auto result = std::make_shared<SearchResult>();
+    result->query_ = QueryBytes(vectors);
+    result->ids_ = result_ids;
+    result->distances_ = result_distances;
+    if (result->Size() > CacheCapacity()) {
+        return;
+    }
+
+    InsertItem(Key(collection_id, partition_tags, k, extra_params, result->query_, version), result);
+}
+
+double
+SearchResultCache::HitRate() const {
+    int64_t hits = hits_;
+    int64_t total = hits + misses_;
+    return total > 0 ? static_cast<double>(hits) / total : 0.0;
+}
+
+std::string
+SearchResultCache::Key(const std::string& collection_id, const std::vector<std::string>& partition_tags, uint64_t k,
+                       const milvus::json& extra_params, const std::vector<uint8_t>& query,
+                       const std::string& version) {
+    std::string key = collection_id + "|" + std::to_string(k) + "|" + extra_params.dump() + "|";
+    for (auto& tag : partition_tags) {
+        key += tag + ",";
+    }
+    std::string query_str(reinterpret_cast<const char*>(query.data()), query.size());
+    return key + "|" + version + "|" + std::to_string(std::hash<std::string>()(query_str));
+}
+
+std::vector<uint8_t>
+SearchResultCache::QueryBytes(const VectorsData& vectors) {
+    // one flag byte keeps a float query apart from a binary query of the same bytes
+    std::vector<uint8_t> bytes;
+    if (!vectors.float_data_.empty()) {
+        bytes.resize(vectors.float_data_.size() * sizeof(float) + 1, 0);
+        memcpy(bytes.data() + 1, vectors.float_data_.data(), vectors.float_data_.size() * sizeof(float));
+    } else {
+        bytes.resize(vectors.binary_data_.size() + 1, 1);
+        memcpy(bytes.data() + 1, vectors.binary_data_.data(), vectors.binary_data_.size());
+    }
+    return bytes;
+}
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,109 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cache/CacheMgr.h"
+#include "cache/DataObj.h"
+#include "db/Types.h"
+#include "db/meta/MetaTypes.h"
+#include "utils/Json.h"
+
+namespace milvus {
+namespace engine {
+
+// The results of one search, with the query they were computed for
+class SearchResult : public cache::DataObj {
+ public:
+    int64_t
+    Size() override {
+        return query_.size() + ids_.size() * sizeof(ResultIds::value_type) +
+               distances_.size() * sizeof(ResultDistances::value_type);
+    }
+
+ public:
+    std::vector<uint8_t> query_;
+    ResultIds ids_;
+    ResultDistances distances_;
+};
+
+using SearchResultPtr = std::shared_ptr<SearchResult>;
+
+/*
+ * Bounded LRU cache of search results in front of DBImpl::Query. An entry is bound to the version of the segment set
+ * it was searched on: a flush, delete, merge, compaction or index swap changes that set, so a stale entry is never
+ * returned and ages out of the cache instead.
+ */
+class SearchResultCache : public cache::CacheMgr<cache::DataObjPtr> {
+ private:
+    SearchResultCache();
+
+ public:
+    static SearchResultCache*
+    GetInstance();
+
+    // drop every entry and set the capacity, 0 disables the cache
+    void
+    Reset(int64_t capacity);
+
+    bool
+    Enabled() const {
+        return enabled_;
+    }
+
+    // files as returned by FilesToSearch, every file added, removed or updated changes the version
+    static std::string
+    Version(const meta::SegmentsSchema& files);
+
+    bool
+    Get(const std::string& collection_id, const std::vector<std::string>& partition_tags, uint64_t k,
+        const milvus::json& extra_params, const VectorsData& vectors, const std::string& version,
+        ResultIds& result_ids, ResultDistances& result_distances);
+
+    void
+    Put(const std::string& collection_id, const std::vector<std::string>& partition_tags, uint64_t k,
+        const milvus::json& extra_params, const VectorsData& vectors, const std::string& version,
+        const ResultIds& result_ids, const ResultDistances& result_distances);
+
+    int64_t
+    HitCount() const {
+        return hits_;
+    }
+
+    int64_t
+    MissCount() const {
+        return misses_;
+    }
+
+    double
+    HitRate() const;
+
+ private:
+    static std::string
+    Key(const std::string& collection_id, const std::vector<std::string>& partition_tags, uint64_t k,
+        const milvus::json& extra_params, const std::vector<uint8_t>& query, const std::string& version);
+
+    static std::vector<uint8_t>
+    QueryBytes(const VectorsData& vectors);
+
+ private:
+    std::atomic<bool> enabled_{false};
+    std::atomic<int64_t> hits_{0};
+    std::atomic<int64_t> misses_{0};
+};
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,134 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/SegmentPruner.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include "db/Utils.h"
+#include "db/engine/ExecutionEngine.h"
+#include "segment/SegmentReader.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace engine {
+
+SegmentPruner::SegmentPruner(const meta::SegmentsSchema& files, const VectorsData& vectors, uint64_t topk)
+    : nq_(vectors.vector_count_), topk_(topk) {
+    // the files of a collection share its metric, which decides the direction of every bound, but an IP
+    // collection reduces the files of a PQ index as distances, the bounds would not apply to the merged results
+    int32_t metric_type = files.empty() ? 0 : files.front().metric_type_;
+    bool l2 = metric_type == static_cast<int32_t>(MetricType::L2);
+    bool ip = metric_type == static_cast<int32_t>(MetricType::IP);
+    bool bounded = (l2 || ip) && nq_ > 0;
+    for (auto& file : files) {
+        if (file.metric_type_ != metric_type ||
+            (ip && file.engine_type_ == static_cast<int32_t>(EngineType::FAISS_PQ))) {
+            bounded = false;
+        }
+    }
+    ascending_ = !ip;
+
+    std::vector<Candidate> candidates;
+    for (auto& file : files) {
+        segment::VectorSummaryPtr summary;
+        if (bounded && vectors.float_data_.size() == nq_ * file.dimension_) {
+            std::string segment_dir;
+            utils::GetParentPath(file.location_, segment_dir);
+            segment::SegmentReader segment_reader(segment_dir);
+            auto status = segment_reader.LoadVectorSummary(summary);
+            if (!status.ok()) {
+                LOG_ENGINE_WARNING_ << "Segment " << file.segment_id_ << " is searched without pruning";
+            }
+        }
+        if (summary == nullptr || summary->Dimension() != file.dimension_) {
+            unbounded_.push_back(file);
+            continue;
+        }
+
+        Candidate candidate;
+        candidate.file_ = file;
+        candidate.bounds_.resize(nq_);
+        for (uint64_t i = 0; i < nq_; ++i) {
+            const float* query = vectors.float_data_.data() + i * file.dimension_;
+            candidate.bounds_[i] = l2 ? summary->L2LowerBound(query) : summary->IPUpperBound(query);
+        }
+        candidate.best_bound_ = ascending_ ? *std::min_element(candidate.bounds_.begin(), candidate.bounds_.end())
+                                           : *std::max_element(candidate.bounds_.begin(), candidate.bounds_.end());
+        candidates.emplace_back(std::move(candidate));
+    }
+
+    bool ascending = ascending_;
+    std::stable_sort(candidates.begin(), candidates.end(), [ascending](const Candidate& a, const Candidate& b) {
+        return ascending ? a.best_bound_ < b.best_bound_ : a.best_bound_ > b.best_bound_;
+    });
+    candidates_.assign(std::make_move_iterator(candidates.begin()), std::make_move_iterator(candidates.end()));
+}
+
+meta::SegmentsSchema
+SegmentPruner::NextWave(const ResultIds& result_ids, const ResultDistances& result_distances) {
+    meta::SegmentsSchema wave;
+    if (wave_size_ == 0) {
+        // the first wave holds enough rows for a full topk, the later ones double in size
+        wave.swap(unbounded_);
+        uint64_t rows = 0;
+        for (auto iter = candidates_.begin(); iter != candidates_.end() && (rows < topk_ || wave_size_ == 0);) {
+            rows += iter->file_.row_count_;
+            wave.push_back(iter->file_);
+            iter = candidates_.erase(iter);
+            ++wave_size_;
+        }
+        wave_size_ = std::max<size_t>(wave_size_, 1);
+        return wave;
+    }
+
+    for (auto iter = candidates_.begin(); iter != candidates_.end();) {
+        if (CanImprove(*iter, result_ids, result_distances)) {
+            ++iter;
+        } else {
+            iter = candidates_.erase(iter);
+            ++pruned_count_;
+        }
+    }
+
+    wave_size_ *= 2;
+    while (!candidates_.empty() && wave.size() < wave_size_) {
+        wave.push_back(candidates_.front().file_);
+        candidates_.pop_front();
+    }
+    return wave;
+}
+
+bool
+SegmentPruner::CanImprove(const Candidate& candidate, const ResultIds& result_ids,
+                          const ResultDistances& result_distances) const {
+    size_t result_k = (nq_ > 0) ? result_ids.size() / nq_ : 0;
+    if (result_k < topk_) {
+        return true;
+    }
+
+    for (uint64_t i = 0; i < nq_; ++i) {
+        size_t kth = i * result_k + topk_ - 1;
+        if (result_ids[kth] == -1) {
+            return true;  // fewer than topk results
+        }
+        float bound = candidate.bounds_[i];
+        if (ascending_ ? bound < result_distances[kth] : bound > result_distances[kth]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,64 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <list>
+#include <vector>
+
+#include "db/Types.h"
+#include "db/meta/MetaTypes.h"
+
+namespace milvus {
+namespace engine {
+
+/*
+ * Hands out the segments of a topk search in waves, the segments whose vector summaries come closest to the queries
+ * first. Before each wave the segments that cannot improve the current topk of any query are dropped: no vector of a
+ * segment has a smaller L2 distance than its lower bound, nor a larger inner product than its upper bound. Segments
+ * without a summary, and every segment of an IP collection holding a PQ index, are searched in the first wave.
+ */
+class SegmentPruner {
+ public:
+    SegmentPruner(const meta::SegmentsSchema& files, const VectorsData& vectors, uint64_t topk);
+
+    // the next segments to search given the results merged so far, empty once every segment is searched or pruned
+    meta::SegmentsSchema
+    NextWave(const ResultIds& result_ids, const ResultDistances& result_distances);
+
+    size_t
+    PrunedCount() const {
+        return pruned_count_;
+    }
+
+ private:
+    struct Candidate {
+        meta::SegmentSchema file_;
+        std::vector<float> bounds_;  // one per query
+        float best_bound_ = 0.0f;
+    };
+
+    bool
+    CanImprove(const Candidate& candidate, const ResultIds& result_ids, const ResultDistances& result_distances) const;
+
+ private:
+    uint64_t nq_ = 0;
+    uint64_t topk_ = 0;
+    bool ascending_ = true;  // the distances of L2, the similarities of IP are descending
+
+    meta::SegmentsSchema unbounded_;
+    std::list<Candidate> candidates_;  // best bound first
+    size_t wave_size_ = 0;
+    size_t pruned_count_ = 0;
+};
+
+}  // namespace engine
+}  // namespace milvus
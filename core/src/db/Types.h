@@ -35,6 +35,7 @@ typedef std::vector<IDNumber> IDNumbers;
 
 typedef std::vector<faiss::Index::idx_t> ResultIds;
 typedef std::vector<faiss::Index::distance_t> ResultDistances;
+typedef std::vector<int64_t> ResultLims;
 
 struct CollectionIndex {
     int32_t engine_type_ = (int)EngineType::FAISS_IDMAP;
@@ -42,11 +43,20 @@ struct CollectionIndex {
     milvus::json extra_params_ = {{"nlist", 2048}};
 };
 
+// rows of equal size which are read in place, e.g. the records of a grpc insert request
+struct VectorRows {
+    std::vector<const uint8_t*> rows_;
+    size_t row_size_ = 0;
+    bool binary_ = false;
+};
+
 struct VectorsData {
     uint64_t vector_count_ = 0;
     std::vector<float> float_data_;
     std::vector<uint8_t> binary_data_;
     IDNumbers id_array_;
+    // used instead of float_data_/binary_data_ when set, the rows are borrowed and must outlive the insert
+    VectorRows rows_;
 };
 
 struct Entity {
@@ -56,6 +66,16 @@ struct Entity {
     IDNumbers id_array_;
 };
 
+// one column of a batch of entity attributes, the values of a field narrowed to the field type, row after row
+struct AttrColumn {
+    std::string name_;
+    uint64_t nbytes_ = 0;  // size of one value
+    std::vector<uint8_t> data_;
+};
+
+// the attributes of a batch of entities, one column per field in the order of the insert request
+using AttrColumns = std::vector<AttrColumn>;
+
 struct AttrsData {
     uint64_t attr_count_ = 0;
     std::unordered_map<std::string, engine::meta::hybrid::DataType> attr_type_;
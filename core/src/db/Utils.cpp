@@ -152,6 +152,9 @@ DeleteSegment(const DBMetaOptions& options, meta::SegmentSchema& table_file) {
     utils::GetCollectionFilePath(options, table_file);
     std::string segment_dir;
     GetParentPath(table_file.location_, segment_dir);
+    EraseFromCache(GetBloomFilterCacheKey(segment_dir));
+    EraseFromCache(GetIdIndexCacheKey(segment_dir));
+    EraseFromCache(GetVectorSummaryCacheKey(segment_dir));
     boost::filesystem::remove_all(segment_dir);
     return Status::OK();
 }
@@ -258,7 +261,10 @@ GetIndexName(int32_t index_type) {
         {(int32_t)engine::EngineType::FAISS_BIN_IDMAP, "IDMAP"},
         {(int32_t)engine::EngineType::FAISS_BIN_IVFFLAT, "IVFFLAT"},
         {(int32_t)engine::EngineType::HNSW, "HNSW"},
-        {(int32_t)engine::EngineType::ANNOY, "ANNOY"}};
+        {(int32_t)engine::EngineType::ANNOY, "ANNOY"},
+        {(int32_t)engine::EngineType::FAISS_PQ_FASTSCAN, "PQ_FASTSCAN"},
+        {(int32_t)engine::EngineType::HNSW_SQ8, "HNSW_SQ8"},
+        {(int32_t)engine::EngineType::BIN_HNSW, "HNSW"}};
 
     if (index_type_name.find(index_type) == index_type_name.end()) {
         return "Unknow";
@@ -300,6 +306,21 @@ EraseFromCache(const std::string& item_key) {
 #endif
 }
 
+std::string
+GetIdIndexCacheKey(const std::string& segment_dir) {
+    return segment_dir + "/id_index";
+}
+
+std::string
+GetBloomFilterCacheKey(const std::string& segment_dir) {
+    return segment_dir + "/id_bloom_filter";
+}
+
+std::string
+GetVectorSummaryCacheKey(const std::string& segment_dir) {
+    return segment_dir + "/vector_summary";
+}
+
 }  // namespace utils
 }  // namespace engine
 }  // namespace milvus
@@ -82,6 +82,18 @@ ExitOnWriteError(Status& status);
 void
 EraseFromCache(const std::string& item_key);
 
+// cache key of the sorted uid index of a segment
+std::string
+GetIdIndexCacheKey(const std::string& segment_dir);
+
+// cache key of the id bloom filter of a segment
+std::string
+GetBloomFilterCacheKey(const std::string& segment_dir);
+
+// cache key of the vector summary of a segment
+std::string
+GetVectorSummaryCacheKey(const std::string& segment_dir);
+
 }  // namespace utils
 }  // namespace engine
 }  // namespace milvus
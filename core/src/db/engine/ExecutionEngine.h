@@ -47,14 +47,18 @@ enum class EngineType {
     FAISS_BIN_IVFFLAT,
     HNSW,
     ANNOY,
-    MAX_VALUE = ANNOY,
+    FAISS_PQ_FASTSCAN,
+    HNSW_SQ8,
+    BIN_HNSW,
+    MAX_VALUE = BIN_HNSW,
 };
 
 static std::map<std::string, EngineType> s_map_engine_type = {
     {"FLAT", EngineType::FAISS_IDMAP},   {"IVFFLAT", EngineType::FAISS_IVFFLAT}, {"IVFSQ8", EngineType::FAISS_IVFSQ8},
     {"RNSG", EngineType::NSG_MIX},       {"IVFSQ8H", EngineType::FAISS_IVFSQ8H}, {"IVFPQ", EngineType::FAISS_PQ},
     {"SPTAGKDT", EngineType::SPTAG_KDT}, {"SPTAGBKT", EngineType::SPTAG_BKT},    {"HNSW", EngineType::HNSW},
-    {"ANNOY", EngineType::ANNOY},
+    {"ANNOY", EngineType::ANNOY},        {"IVFPQFASTSCAN", EngineType::FAISS_PQ_FASTSCAN},
+    {"HNSWSQ8", EngineType::HNSW_SQ8},   {"BINHNSW", EngineType::BIN_HNSW},
 };
 
 enum class MetricType {
@@ -105,8 +109,10 @@ class ExecutionEngine {
     virtual Status
     Serialize() = 0;
 
+    // search_params are the extra_params of the search that needs this engine, a refine_factor in them
+    // loads the raw vectors along with a quantized index
     virtual Status
-    Load(bool to_cache = true) = 0;
+    Load(bool to_cache = true, const milvus::json& search_params = milvus::json()) = 0;
 
     virtual Status
     LoadAttr(bool to_cache = true) = 0;
@@ -145,9 +151,22 @@ class ExecutionEngine {
     virtual Status
     Search(std::vector<int64_t>& ids, std::vector<float>& distances, scheduler::SearchJobPtr job, bool hybrid) = 0;
 
+    // results of query i are ids/distances in [lims[i], lims[i + 1]), sorted from nearest to farthest
+    virtual Status
+    RangeSearch(std::vector<int64_t>& lims, std::vector<int64_t>& ids, std::vector<float>& distances,
+                scheduler::SearchJobPtr job, bool hybrid) = 0;
+
     virtual std::shared_ptr<ExecutionEngine>
     BuildIndex(const std::string& location, EngineType engine_type) = 0;
 
+    // whether BuildIndexOutOfCore can build engine_type from this engine without loading it
+    virtual bool
+    CanBuildIndexOutOfCore(EngineType engine_type) = 0;
+
+    // stream the raw vectors from disk, holding at most buffer_size bytes of them in memory
+    virtual std::shared_ptr<ExecutionEngine>
+    BuildIndexOutOfCore(const std::string& location, EngineType engine_type, int64_t buffer_size) = 0;
+
     virtual Status
     Cache() = 0;
 
@@ -14,6 +14,8 @@
 #include <faiss/utils/ConcurrentBitset.h>
 #include <fiu-local.h>
 
+#include <algorithm>
+#include <numeric>
 #include <stdexcept>
 #include <unordered_map>
 #include <utility>
@@ -89,7 +91,8 @@ MappingMetricType(MetricType metric_type, milvus::json& conf) {
 
 bool
 IsBinaryIndexType(knowhere::IndexType type) {
-    return type == knowhere::IndexEnum::INDEX_FAISS_BIN_IDMAP || type == knowhere::IndexEnum::INDEX_FAISS_BIN_IVFFLAT;
+    return type == knowhere::IndexEnum::INDEX_FAISS_BIN_IDMAP || type == knowhere::IndexEnum::INDEX_FAISS_BIN_IVFFLAT ||
+           type == knowhere::IndexEnum::INDEX_BIN_HNSW;
 }
 
 bool
@@ -97,6 +100,25 @@ IndexSupportOffset(EngineType type) {
     return type == EngineType::FAISS_IVFFLAT || type == EngineType::HNSW || type == EngineType::NSG_MIX;
 }
 
+// quantized indexes only need raw data when their results are re-ranked,
+// a refine_factor passed at search time overrides the one the index was built with
+bool
+IndexRefineWithRawData(EngineType type, const milvus::json& index_params, const milvus::json& search_params) {
+    if (type != EngineType::FAISS_PQ_FASTSCAN && type != EngineType::HNSW_SQ8) {
+        return false;
+    }
+    for (auto params : {&search_params, &index_params}) {
+        if (params->contains(knowhere::IndexParams::refine_factor)) {
+            return (*params)[knowhere::IndexParams::refine_factor].get<int64_t>() > 1;
+        }
+    }
+    return false;
+}
+
+// faiss k-means samples at most this many training points per centroid, and trains poorly below the minimum
+constexpr int64_t BUILD_INDEX_MAX_TRAIN_ROWS_PER_LIST = 256;
+constexpr int64_t BUILD_INDEX_MIN_TRAIN_ROWS_PER_LIST = 40;
+
 }  // namespace
 
 #ifdef MILVUS_GPU_VERSION
@@ -232,6 +254,18 @@ ExecutionEngineImpl::CreatetVecIndex(EngineType type) {
             index = vec_index_factory.CreateVecIndex(knowhere::IndexEnum::INDEX_ANNOY, mode);
             break;
         }
+        case EngineType::FAISS_PQ_FASTSCAN: {
+            index = vec_index_factory.CreateVecIndex(knowhere::IndexEnum::INDEX_FAISS_IVFPQ_FASTSCAN, mode);
+            break;
+        }
+        case EngineType::HNSW_SQ8: {
+            index = vec_index_factory.CreateVecIndex(knowhere::IndexEnum::INDEX_HNSW_SQ8, mode);
+            break;
+        }
+        case EngineType::BIN_HNSW: {
+            index = vec_index_factory.CreateVecIndex(knowhere::IndexEnum::INDEX_BIN_HNSW, mode);
+            break;
+        }
         default: {
             LOG_ENGINE_ERROR_ << "Unsupported index type " << (int)type;
             return nullptr;
@@ -388,9 +422,15 @@ ExecutionEngineImpl::Serialize() {
 }
 
 Status
-ExecutionEngineImpl::Load(bool to_cache) {
+ExecutionEngineImpl::Load(bool to_cache, const milvus::json& search_params) {
+    bool with_raw_data = IndexRefineWithRawData(index_type_, index_params_, search_params);
     index_ = std::static_pointer_cast<knowhere::VecIndex>(cache::CpuCacheMgr::GetInstance()->GetIndex(location_));
     bool already_in_cache = (index_ != nullptr);
+    if (already_in_cache && with_raw_data && index_->Count() > 0) {
+        // the cached copy was loaded by a search without refinement, reload it with the raw vectors
+        std::vector<uint8_t> vector(index_->Dim() * sizeof(float));
+        already_in_cache = index_->GetVectorByOffset(0, vector.data());
+    }
     if (!already_in_cache) {
         std::string segment_dir;
         utils::GetParentPath(location_, segment_dir);
@@ -421,7 +461,6 @@ ExecutionEngineImpl::Load(bool to_cache) {
             segment::SegmentPtr segment_ptr;
             segment_reader_ptr->GetSegment(segment_ptr);
             auto& vectors = segment_ptr->vectors_ptr_;
-            auto& deleted_docs = segment_ptr->deleted_docs_ptr_->GetDeletedDocs();
 
             auto& vectors_uids = vectors->GetMutableUids();
             auto count = vectors_uids.size();
@@ -431,9 +470,7 @@ ExecutionEngineImpl::Load(bool to_cache) {
             auto& vectors_data = vectors->GetData();
 
             faiss::ConcurrentBitsetPtr concurrent_bitset_ptr = std::make_shared<faiss::ConcurrentBitset>(count);
-            for (auto& offset : deleted_docs) {
-                concurrent_bitset_ptr->set(offset);
-            }
+            segment_ptr->deleted_docs_ptr_->GetBitset(concurrent_bitset_ptr);
 
             auto dataset = knowhere::GenDataset(count, this->dim_, vectors_data.data());
             if (index_type_ == EngineType::FAISS_IDMAP) {
@@ -453,7 +490,7 @@ ExecutionEngineImpl::Load(bool to_cache) {
             try {
                 segment::SegmentPtr segment_ptr;
                 segment_reader_ptr->GetSegment(segment_ptr);
-                if (IndexSupportOffset(index_type_)) {
+                if (IndexSupportOffset(index_type_) || with_raw_data) {
                     auto status =
                         segment_reader_ptr->LoadVectorIndexWithRawData(location_, segment_ptr->vector_index_ptr_);
                 } else {
@@ -483,15 +520,9 @@ ExecutionEngineImpl::Load(bool to_cache) {
                         LOG_ENGINE_ERROR_ << msg;
                         return Status(DB_ERROR, msg);
                     }
-                    auto& deleted_docs = deleted_docs_ptr->GetDeletedDocs();
-
                     faiss::ConcurrentBitsetPtr concurrent_bitset_ptr =
                         std::make_shared<faiss::ConcurrentBitset>(index_->Count());
-                    for (auto& offset : deleted_docs) {
-                        if (!concurrent_bitset_ptr->test(offset)) {
-                            concurrent_bitset_ptr->set(offset);
-                        }
-                    }
+                    deleted_docs_ptr->GetBitset(concurrent_bitset_ptr);
 
                     index_->SetBlacklist(concurrent_bitset_ptr);
 
@@ -763,6 +794,117 @@ ExecutionEngineImpl::BuildIndex(const std::string& location, EngineType engine_t
     return std::make_shared<ExecutionEngineImpl>(to_index, location, engine_type, metric_type_, index_params_);
 }
 
+bool
+ExecutionEngineImpl::CanBuildIndexOutOfCore(EngineType engine_type) {
+    if (index_type_ != EngineType::FAISS_IDMAP) {
+        return false;
+    }
+    if (engine_type != EngineType::FAISS_IVFFLAT && engine_type != EngineType::FAISS_IVFSQ8 &&
+        engine_type != EngineType::FAISS_PQ) {
+        return false;
+    }
+#ifdef MILVUS_GPU_VERSION
+    bool gpu_enable = false;
+    server::Config& config = server::Config::GetInstance();
+    config.GetGpuResourceConfigEnable(gpu_enable);
+    if (gpu_enable) {
+        return false;
+    }
+#endif
+    // raw data already in memory is cheaper to build from
+    return cache::CpuCacheMgr::GetInstance()->GetIndex(location_) == nullptr;
+}
+
+ExecutionEnginePtr
+ExecutionEngineImpl::BuildIndexOutOfCore(const std::string& location, EngineType engine_type, int64_t buffer_size) {
+    LOG_ENGINE_DEBUG_ << "Build index file out of core: " << location << " from: " << location_
+                      << ", buffer size: " << buffer_size;
+    fiu_do_on("ExecutionEngineImpl.BuildIndexOutOfCore.throw_exception", throw Exception(DB_ERROR, ""));
+
+    std::string segment_dir;
+    utils::GetParentPath(location_, segment_dir);
+    segment::SegmentReader segment_reader(segment_dir);
+
+    std::vector<segment::doc_id_t> uids;
+    auto status = segment_reader.LoadUids(uids);
+    if (!status.ok()) {
+        throw Exception(DB_ERROR, "Failed to load uids from " + segment_dir + ": " + status.message());
+    }
+    segment::DeletedDocsPtr deleted_docs_ptr;
+    status = segment_reader.LoadDeletedDocs(deleted_docs_ptr);
+    if (!status.ok()) {
+        throw Exception(DB_ERROR, "Failed to load deleted docs from " + segment_dir + ": " + status.message());
+    }
+    int64_t rows = uids.size();
+
+    auto to_index = CreatetVecIndex(engine_type);
+    if (!to_index) {
+        throw Exception(DB_ERROR, "Unsupported index type");
+    }
+
+    milvus::json conf = index_params_;
+    conf[knowhere::meta::DIM] = dim_;
+    conf[knowhere::meta::ROWS] = rows;
+    conf[knowhere::meta::DEVICEID] = gpu_num_;
+    MappingMetricType(metric_type_, conf);
+    auto adapter = knowhere::AdapterMgr::GetInstance().GetAdapter(to_index->index_type());
+    if (!adapter->CheckTrain(conf, to_index->index_mode())) {
+        throw Exception(DB_ERROR, "Illegal index params");
+    }
+    LOG_ENGINE_DEBUG_ << "Index config: " << conf.dump();
+
+    // the buffer is shared by the training sample and the chunk being read, a buffer too small to train well
+    // is exceeded by the sample
+    int64_t row_size = dim_ * sizeof(float);
+    int64_t chunk_rows = std::max<int64_t>(buffer_size / 2 / row_size, 1);
+    int64_t nlist = conf[knowhere::IndexParams::nlist].get<int64_t>();
+    int64_t sample_rows = std::min({rows, nlist * BUILD_INDEX_MAX_TRAIN_ROWS_PER_LIST,
+                                    std::max(chunk_rows, nlist * BUILD_INDEX_MIN_TRAIN_ROWS_PER_LIST)});
+
+    // step 1: train on rows picked evenly over the whole segment, in one pass
+    std::vector<float> sample(sample_rows * dim_);
+    std::vector<uint8_t> chunk;
+    int64_t picked = 0;
+    for (int64_t start = 0; start < rows && picked < sample_rows; start += chunk_rows) {
+        int64_t n = std::min(chunk_rows, rows - start);
+        status = segment_reader.LoadVectors(start * row_size, n * row_size, chunk);
+        if (!status.ok()) {
+            throw Exception(DB_ERROR, "Failed to load vectors from " + segment_dir + ": " + status.message());
+        }
+        for (; picked < sample_rows; ++picked) {
+            int64_t row = picked * rows / sample_rows;
+            if (row >= start + n) {
+                break;
+            }
+            memcpy(sample.data() + picked * dim_, chunk.data() + (row - start) * row_size, row_size);
+        }
+    }
+    to_index->Train(knowhere::GenDataset(sample_rows, dim_, sample.data()), conf);
+    std::vector<float>().swap(sample);
+
+    // step 2: add the segment chunk by chunk, labeled by offset as the in-memory build does
+    chunk_rows = std::max<int64_t>(buffer_size / row_size, 1);
+    std::vector<int64_t> offsets(std::min(chunk_rows, rows));
+    for (int64_t start = 0; start < rows; start += chunk_rows) {
+        int64_t n = std::min(chunk_rows, rows - start);
+        status = segment_reader.LoadVectors(start * row_size, n * row_size, chunk);
+        if (!status.ok()) {
+            throw Exception(DB_ERROR, "Failed to load vectors from " + segment_dir + ": " + status.message());
+        }
+        std::iota(offsets.begin(), offsets.begin() + n, start);
+        to_index->Add(knowhere::GenDatasetWithIds(n, dim_, chunk.data(), offsets.data()), conf);
+    }
+
+    to_index->SetUids(uids);
+    LOG_ENGINE_DEBUG_ << "Set " << to_index->GetUids().size() << "uids for " << location;
+    faiss::ConcurrentBitsetPtr blacklist = std::make_shared<faiss::ConcurrentBitset>(rows);
+    deleted_docs_ptr->GetBitset(blacklist);
+    to_index->SetBlacklist(blacklist);
+
+    LOG_ENGINE_DEBUG_ << "Finish build index out of core: " << location;
+    return std::make_shared<ExecutionEngineImpl>(to_index, location, engine_type, metric_type_, index_params_);
+}
+
 void
 MapAndCopyResult(const knowhere::DatasetPtr& dataset, const std::vector<milvus::segment::doc_id_t>& uids, int64_t nq,
                  int64_t k, float* distances, int64_t* labels) {
@@ -1295,6 +1437,71 @@ ExecutionEngineImpl::Search(std::vector<int64_t>& ids, std::vector<float>& dista
     return Status::OK();
 }
 
+Status
+ExecutionEngineImpl::RangeSearch(std::vector<int64_t>& lims, std::vector<int64_t>& ids, std::vector<float>& distances,
+                                 scheduler::SearchJobPtr job, bool hybrid) {
+    TimeRecorder rc(LogOut("[%s][%ld] ExecutionEngineImpl::RangeSearch", "search", 0));
+
+    if (index_ == nullptr) {
+        LOG_ENGINE_ERROR_ << LogOut("[%s][%ld] ExecutionEngineImpl: index is null, failed to search", "search", 0);
+        return Status(DB_ERROR, "index is null");
+    }
+
+    double span;
+    uint64_t nq = job->nq();
+    const engine::VectorsData& vectors = job->vectors();
+
+    milvus::json conf = job->extra_params();
+    conf[knowhere::meta::TOPK] = job->topk();
+    auto adapter = knowhere::AdapterMgr::GetInstance().GetAdapter(index_->index_type());
+    if (!adapter->CheckSearch(conf, index_->index_type(), index_->index_mode())) {
+        LOG_ENGINE_ERROR_ << LogOut("[%s][%ld] Illegal search params", "search", 0);
+        throw Exception(DB_ERROR, "Illegal search params");
+    }
+
+    if (hybrid) {
+        HybridLoad();
+    }
+
+    rc.RecordSection("query prepare");
+    knowhere::DatasetPtr dataset;
+    if (!vectors.float_data_.empty()) {
+        dataset = knowhere::GenDataset(nq, index_->Dim(), vectors.float_data_.data());
+    } else {
+        dataset = knowhere::GenDataset(nq, index_->Dim(), vectors.binary_data_.data());
+    }
+    auto result = index_->QueryByRange(dataset, conf);
+    span = rc.RecordSection("query done");
+    job->time_stat().query_time += span / 1000;
+
+    int64_t* res_lims = result->Get<int64_t*>(knowhere::meta::LIMS);
+    int64_t* res_ids = result->Get<int64_t*>(knowhere::meta::IDS);
+    float* res_dist = result->Get<float*>(knowhere::meta::DISTANCE);
+
+    int64_t num = res_lims[nq];
+    lims.assign(res_lims, res_lims + nq + 1);
+    distances.assign(res_dist, res_dist + num);
+    ids.resize(num);
+
+    /* map offsets to ids */
+    auto& uids = index_->GetUids();
+    for (int64_t i = 0; i < num; ++i) {
+        ids[i] = uids[res_ids[i]];
+    }
+
+    free(res_lims);
+    free(res_ids);
+    free(res_dist);
+    span = rc.RecordSection("map uids " + std::to_string(num));
+    job->time_stat().map_uids_time += span / 1000;
+
+    if (hybrid) {
+        HybridUnset();
+    }
+
+    return Status::OK();
+}
+
 #if 0
 Status
 ExecutionEngineImpl::GetVectorByID(const int64_t id, float* vector, bool hybrid) {
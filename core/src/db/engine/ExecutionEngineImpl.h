@@ -54,7 +54,7 @@ class ExecutionEngineImpl : public ExecutionEngine {
     Serialize() override;
 
     Status
-    Load(bool to_cache) override;
+    Load(bool to_cache, const milvus::json& search_params) override;
 
     Status
     LoadAttr(bool to_cache) override;
@@ -87,9 +87,19 @@ class ExecutionEngineImpl : public ExecutionEngine {
     Status
     Search(std::vector<int64_t>& ids, std::vector<float>& distances, scheduler::SearchJobPtr job, bool hybrid) override;
 
+    Status
+    RangeSearch(std::vector<int64_t>& lims, std::vector<int64_t>& ids, std::vector<float>& distances,
+                scheduler::SearchJobPtr job, bool hybrid) override;
+
     ExecutionEnginePtr
     BuildIndex(const std::string& location, EngineType engine_type) override;
 
+    bool
+    CanBuildIndexOutOfCore(EngineType engine_type) override;
+
+    ExecutionEnginePtr
+    BuildIndexOutOfCore(const std::string& location, EngineType engine_type, int64_t buffer_size) override;
+
     Status
     Cache() override;
 
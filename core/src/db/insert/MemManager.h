@@ -33,11 +33,14 @@ class MemManager {
     InsertVectors(const std::string& collection_id, int64_t length, const IDNumber* vector_ids, int64_t dim,
                   const uint8_t* vectors, uint64_t lsn) = 0;
 
+    // rows of row_size bytes each, read in place
+    virtual Status
+    InsertVectors(const std::string& collection_id, int64_t length, const IDNumber* vector_ids,
+                  const uint8_t* const* rows, size_t row_size, bool binary, uint64_t lsn) = 0;
+
     virtual Status
     InsertEntities(const std::string& collection_id, int64_t length, const IDNumber* vector_ids, int64_t dim,
-                   const float* vectors, const std::unordered_map<std::string, uint64_t>& attr_nbytes,
-                   const std::unordered_map<std::string, uint64_t>& attr_size,
-                   const std::unordered_map<std::string, std::vector<uint8_t>>& attr_data, uint64_t lsn) = 0;
+                   const float* vectors, const AttrColumns& attrs, uint64_t lsn) = 0;
 
     virtual Status
     DeleteVector(const std::string& collection_id, IDNumber vector_id, uint64_t lsn) = 0;
@@ -28,20 +28,15 @@ MemManagerImpl::GetMemByTable(const std::string& collection_id) {
         return memIt->second;
     }
 
-    mem_id_map_[collection_id] = std::make_shared<MemTable>(collection_id, meta_, options_);
+    mem_id_map_[collection_id] = std::make_shared<MemTable>(collection_id, meta_, options_, apply_delete_pool_);
     return mem_id_map_[collection_id];
 }
 
 Status
 MemManagerImpl::InsertVectors(const std::string& collection_id, int64_t length, const IDNumber* vector_ids, int64_t dim,
                               const float* vectors, uint64_t lsn) {
-    VectorsData vectors_data;
-    vectors_data.vector_count_ = length;
-    vectors_data.float_data_.resize(length * dim);
-    memcpy(vectors_data.float_data_.data(), vectors, length * dim * sizeof(float));
-    vectors_data.id_array_.resize(length);
-    memcpy(vectors_data.id_array_.data(), vector_ids, length * sizeof(IDNumber));
-    VectorSourcePtr source = std::make_shared<VectorSource>(vectors_data);
+    // the source only borrows the caller's buffers, it is fully consumed before InsertVectorsNoLock returns
+    VectorSourcePtr source = std::make_shared<VectorSource>(length, vector_ids, vectors);
 
     std::unique_lock<std::mutex> lock(mutex_);
 
@@ -51,13 +46,19 @@ MemManagerImpl::InsertVectors(const std::string& collection_id, int64_t length,
 Status
 MemManagerImpl::InsertVectors(const std::string& collection_id, int64_t length, const IDNumber* vector_ids, int64_t dim,
                               const uint8_t* vectors, uint64_t lsn) {
-    VectorsData vectors_data;
-    vectors_data.vector_count_ = length;
-    vectors_data.binary_data_.resize(length * dim);
-    memcpy(vectors_data.binary_data_.data(), vectors, length * dim * sizeof(uint8_t));
-    vectors_data.id_array_.resize(length);
-    memcpy(vectors_data.id_array_.data(), vector_ids, length * sizeof(IDNumber));
-    VectorSourcePtr source = std::make_shared<VectorSource>(vectors_data);
+    // the source only borrows the caller's buffers, it is fully consumed before InsertVectorsNoLock returns
+    VectorSourcePtr source = std::make_shared<VectorSource>(length, vector_ids, vectors);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    return InsertVectorsNoLock(collection_id, source, lsn);
+}
+
+Status
+MemManagerImpl::InsertVectors(const std::string& collection_id, int64_t length, const IDNumber* vector_ids,
+                              const uint8_t* const* rows, size_t row_size, bool binary, uint64_t lsn) {
+    // the rows are gathered into the segment, nothing is copied before that
+    VectorSourcePtr source = std::make_shared<VectorSource>(length, vector_ids, rows, binary);
 
     std::unique_lock<std::mutex> lock(mutex_);
 
@@ -66,18 +67,9 @@ MemManagerImpl::InsertVectors(const std::string& collection_id, int64_t length,
 
 Status
 MemManagerImpl::InsertEntities(const std::string& collection_id, int64_t length, const IDNumber* vector_ids,
-                               int64_t dim, const float* vectors,
-                               const std::unordered_map<std::string, uint64_t>& attr_nbytes,
-                               const std::unordered_map<std::string, uint64_t>& attr_size,
-                               const std::unordered_map<std::string, std::vector<uint8_t>>& attr_data, uint64_t lsn) {
-    VectorsData vectors_data;
-    vectors_data.vector_count_ = length;
-    vectors_data.float_data_.resize(length * dim);
-    memcpy(vectors_data.float_data_.data(), vectors, length * dim * sizeof(float));
-    vectors_data.id_array_.resize(length);
-    memcpy(vectors_data.id_array_.data(), vector_ids, length * sizeof(IDNumber));
-
-    VectorSourcePtr source = std::make_shared<VectorSource>(vectors_data, attr_nbytes, attr_size, attr_data);
+                               int64_t dim, const float* vectors, const AttrColumns& attrs, uint64_t lsn) {
+    // the source borrows the vectors and the attribute columns, like InsertVectors does
+    VectorSourcePtr source = std::make_shared<VectorSource>(length, vector_ids, vectors, attrs);
 
     std::unique_lock<std::mutex> lock(mutex_);
 
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <ctime>
 #include <map>
 #include <memory>
@@ -36,7 +37,10 @@ class MemManagerImpl : public MemManager, public server::CacheConfigHandler {
     using MemIdMap = std::map<std::string, MemTablePtr>;
     using MemList = std::vector<MemTablePtr>;
 
-    MemManagerImpl(const meta::MetaPtr& meta, const DBOptions& options) : meta_(meta), options_(options) {
+    MemManagerImpl(const meta::MetaPtr& meta, const DBOptions& options)
+        : meta_(meta),
+          options_(options),
+          apply_delete_pool_(std::make_shared<TaskExecutor>(std::max<uint64_t>(options.apply_delete_thread_num_, 1))) {
         SetIdentity("MemManagerImpl");
         AddInsertBufferSizeListener();
     }
@@ -49,11 +53,13 @@ class MemManagerImpl : public MemManager, public server::CacheConfigHandler {
     InsertVectors(const std::string& collection_id, int64_t length, const IDNumber* vector_ids, int64_t dim,
                   const uint8_t* vectors, uint64_t lsn) override;
 
+    Status
+    InsertVectors(const std::string& collection_id, int64_t length, const IDNumber* vector_ids,
+                  const uint8_t* const* rows, size_t row_size, bool binary, uint64_t lsn) override;
+
     Status
     InsertEntities(const std::string& collection_id, int64_t length, const IDNumber* vector_ids, int64_t dim,
-                   const float* vectors, const std::unordered_map<std::string, uint64_t>& attr_nbytes,
-                   const std::unordered_map<std::string, uint64_t>& attr_size,
-                   const std::unordered_map<std::string, std::vector<uint8_t>>& attr_data, uint64_t lsn) override;
+                   const float* vectors, const AttrColumns& attrs, uint64_t lsn) override;
 
     Status
     DeleteVector(const std::string& collection_id, IDNumber vector_id, uint64_t lsn) override;
@@ -111,6 +117,7 @@ class MemManagerImpl : public MemManager, public server::CacheConfigHandler {
     DBOptions options_;
     std::mutex mutex_;
     std::mutex serialization_mtx_;
+    TaskExecutorPtr apply_delete_pool_;
 };  // NewMemManager
 
 }  // namespace engine
@@ -10,25 +10,30 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include <algorithm>
-#include <chrono>
+#include <functional>
+#include <future>
 #include <memory>
 #include <string>
-#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "cache/CpuCacheMgr.h"
 #include "db/Utils.h"
 #include "db/insert/MemTable.h"
 #include "db/meta/FilesHolder.h"
 #include "knowhere/index/vector_index/VecIndex.h"
+#include "segment/IdIndex.h"
 #include "segment/SegmentReader.h"
+#include "segment/SegmentWriter.h"
 #include "utils/Log.h"
 #include "utils/TimeRecorder.h"
 
 namespace milvus {
 namespace engine {
 
-MemTable::MemTable(const std::string& collection_id, const meta::MetaPtr& meta, const DBOptions& options)
-    : collection_id_(collection_id), meta_(meta), options_(options) {
+MemTable::MemTable(const std::string& collection_id, const meta::MetaPtr& meta, const DBOptions& options,
+                   TaskExecutorPtr apply_delete_pool)
+    : collection_id_(collection_id), meta_(meta), options_(options), apply_delete_pool_(std::move(apply_delete_pool)) {
     SetIdentity("MemTable");
     AddCacheInsertDataListener();
 }
@@ -193,19 +198,13 @@ MemTable::GetCurrentMem() {
 Status
 MemTable::ApplyDeletes() {
     // Applying deletes to other segments on disk and their corresponding cache:
-    // For each segment in collection:
-    //     Load its bloom filter
-    //     For each id in delete list:
-    //         If present, add the uid to segment's uid list
-    // For each segment
-    //     Get its cache if exists
-    //     Load its uids file.
-    //     Scan the uids, if any uid in segment's uid list exists:
-    //         add its offset to deletedDoc
-    //         remove the id from bloom filter
-    //         set black list in cache
-    //     Serialize segment's deletedDoc TODO(zhiru): append directly to previous file for now, may have duplicates
-    //     Serialize bloom filter
+    // For each segment in collection, in parallel:
+    //     Check the delete ids against its bloom filter (cached), keep the ones it may contain
+    //     Join the sorted delete ids with the segment's sorted uid index (cached)
+    //     Drop the matched offsets already in deletedDoc
+    //     Set black list in cache, one atomic update per bitset word
+    //     Append the new offsets to segment's deletedDoc
+    // Update row count of the touched files in meta
 
     LOG_ENGINE_DEBUG_ << "Applying " << doc_ids_to_delete_.size() << " deletes in collection: " << collection_id_;
 
@@ -224,175 +223,175 @@ MemTable::ApplyDeletes() {
     // attention: here is a copy, not reference, since files_holder.UnmarkFile will change the array internal
     milvus::engine::meta::SegmentsSchema files = files_holder.HoldFiles();
 
-    // which file need to be apply delete
-    std::unordered_map<size_t, std::vector<segment::doc_id_t>> ids_to_check_map;  // file id mapping to delete ids
-    for (auto& file : files) {
-        std::string segment_dir;
-        utils::GetParentPath(file.location_, segment_dir);
-
-        segment::SegmentReader segment_reader(segment_dir);
-        segment::IdBloomFilterPtr id_bloom_filter_ptr;
-        segment_reader.LoadBloomFilter(id_bloom_filter_ptr);
-
-        for (auto& id : doc_ids_to_delete_) {
-            if (id_bloom_filter_ptr->Check(id)) {
-                ids_to_check_map[file.id_].emplace_back(id);
-            }
+    // the set is ordered, so the ids are already sorted for the merge join
+    std::vector<segment::doc_id_t> ids_to_delete(doc_ids_to_delete_.begin(), doc_ids_to_delete_.end());
+
+    std::vector<meta::SegmentsSchema> segment_files_to_update(files.size());
+    std::vector<Status> segment_status(files.size());
+    if (apply_delete_pool_ != nullptr && files.size() > 1) {
+        std::vector<std::future<Status>> futures;
+        futures.reserve(files.size());
+        for (size_t i = 0; i < files.size(); ++i) {
+            futures.emplace_back(apply_delete_pool_->Enqueue(&MemTable::ApplyDeletesToSegment, this,
+                                                             std::cref(files[i]), std::cref(ids_to_delete),
+                                                             std::ref(segment_files_to_update[i])));
         }
-    }
-
-    // release unused files
-    for (auto& file : files) {
-        if (ids_to_check_map.find(file.id_) == ids_to_check_map.end()) {
-            files_holder.UnmarkFile(file);
+        for (size_t i = 0; i < futures.size(); ++i) {
+            segment_status[i] = futures[i].get();
+        }
+    } else {
+        for (size_t i = 0; i < files.size(); ++i) {
+            segment_status[i] = ApplyDeletesToSegment(files[i], ids_to_delete, segment_files_to_update[i]);
         }
     }
 
-    // attention: here is a copy, not reference, since files_holder.UnmarkFile will change the array internal
-    milvus::engine::meta::SegmentsSchema hold_files = files_holder.HoldFiles();
-    recorder.RecordSection("Found " + std::to_string(hold_files.size()) + " segment to apply deletes");
-
     meta::SegmentsSchema files_to_update;
-    for (auto& file : hold_files) {
-        LOG_ENGINE_DEBUG_ << "Applying deletes in segment: " << file.segment_id_;
-
-        TimeRecorder rec("handle segment " + file.segment_id_);
-
-        std::string segment_dir;
-        utils::GetParentPath(file.location_, segment_dir);
-        segment::SegmentReader segment_reader(segment_dir);
-
-        auto& segment_id = file.segment_id_;
-        meta::FilesHolder segment_holder;
-        status = meta_->GetCollectionFilesBySegmentId(segment_id, segment_holder);
-        if (!status.ok()) {
-            break;
-        }
-
-        // Get all index that contains blacklist in cache
-        std::vector<knowhere::VecIndexPtr> indexes;
-        std::vector<faiss::ConcurrentBitsetPtr> blacklists;
-        milvus::engine::meta::SegmentsSchema& segment_files = segment_holder.HoldFiles();
-        for (auto& segment_file : segment_files) {
-            auto data_obj_ptr = cache::CpuCacheMgr::GetInstance()->GetIndex(segment_file.location_);
-            auto index = std::static_pointer_cast<knowhere::VecIndex>(data_obj_ptr);
-            if (index != nullptr) {
-                faiss::ConcurrentBitsetPtr blacklist = index->GetBlacklist();
-                if (blacklist != nullptr) {
-                    indexes.emplace_back(index);
-                    blacklists.emplace_back(blacklist);
-                }
-            }
-        }
-
-        std::vector<segment::doc_id_t> uids;
-        status = segment_reader.LoadUids(uids);
-        if (!status.ok()) {
-            break;
+    size_t segment_count = 0;
+    Status apply_status;
+    for (size_t i = 0; i < files.size(); ++i) {
+        if (!segment_status[i].ok()) {
+            LOG_ENGINE_ERROR_ << "Failed to apply deletes in segment " << files[i].segment_id_ << ": "
+                              << segment_status[i].message();
+            apply_status = segment_status[i];
+        } else if (!segment_files_to_update[i].empty()) {
+            ++segment_count;
+            files_to_update.insert(files_to_update.end(), segment_files_to_update[i].begin(),
+                                   segment_files_to_update[i].end());
         }
-        segment::IdBloomFilterPtr id_bloom_filter_ptr;
-        status = segment_reader.LoadBloomFilter(id_bloom_filter_ptr);
-        if (!status.ok()) {
-            break;
-        }
-
-        auto& ids_to_check = ids_to_check_map[file.id_];
-
-        segment::DeletedDocsPtr deleted_docs = std::make_shared<segment::DeletedDocs>();
+    }
 
-        rec.RecordSection("Loading uids and deleted docs");
+    recorder.RecordSection("Finished " + std::to_string(segment_count) + " segment to apply deletes");
 
-        std::sort(ids_to_check.begin(), ids_to_check.end());
+    // the deleted docs of the applied segments are already written, record them even if some segment failed
+    status = meta_->UpdateCollectionFilesRowCount(files_to_update);
 
-        rec.RecordSection("Sorting " + std::to_string(ids_to_check.size()) + " ids");
+    if (!status.ok()) {
+        std::string err_msg = "Failed to apply deletes: " + status.ToString();
+        LOG_ENGINE_ERROR_ << err_msg;
+        return Status(DB_ERROR, err_msg);
+    }
 
-        size_t delete_count = 0;
-        auto find_diff = std::chrono::duration<double>::zero();
-        auto set_diff = std::chrono::duration<double>::zero();
+    doc_ids_to_delete_.clear();
 
-        for (size_t i = 0; i < uids.size(); ++i) {
-            auto find_start = std::chrono::high_resolution_clock::now();
+    recorder.RecordSection("Update deletes to meta");
+    recorder.ElapseFromBegin("Finished deletes");
 
-            auto found = std::binary_search(ids_to_check.begin(), ids_to_check.end(), uids[i]);
+    if (!apply_status.ok()) {
+        return Status(DB_ERROR, "Failed to apply deletes: " + apply_status.message());
+    }
 
-            auto find_end = std::chrono::high_resolution_clock::now();
-            find_diff += (find_end - find_start);
+    return Status::OK();
+}
 
-            if (found) {
-                auto set_start = std::chrono::high_resolution_clock::now();
+Status
+MemTable::ApplyDeletesToSegment(const meta::SegmentSchema& file, const std::vector<segment::doc_id_t>& ids_to_delete,
+                                meta::SegmentsSchema& files_to_update) {
+    std::string segment_dir;
+    utils::GetParentPath(file.location_, segment_dir);
+    segment::SegmentReader segment_reader(segment_dir);
+
+    segment::IdBloomFilterPtr id_bloom_filter_ptr;
+    auto status = segment_reader.LoadBloomFilter(id_bloom_filter_ptr);
+    if (!status.ok()) {
+        return status;
+    }
 
-                delete_count++;
+    std::vector<segment::doc_id_t> ids_to_check;
+    id_bloom_filter_ptr->Check(ids_to_delete, ids_to_check);
+    if (ids_to_check.empty()) {
+        return Status::OK();
+    }
 
-                deleted_docs->AddDeletedDoc(i);
+    LOG_ENGINE_DEBUG_ << "Applying deletes in segment: " << file.segment_id_;
 
-                if (id_bloom_filter_ptr->Check(uids[i])) {
-                    id_bloom_filter_ptr->Remove(uids[i]);
-                }
+    TimeRecorder rec("handle segment " + file.segment_id_);
 
-                for (auto& blacklist : blacklists) {
-                    if (!blacklist->test(i)) {
-                        blacklist->set(i);
-                    }
-                }
+    segment::IdIndexPtr id_index;
+    status = segment_reader.LoadIdIndex(id_index);
+    if (!status.ok()) {
+        return status;
+    }
 
-                auto set_end = std::chrono::high_resolution_clock::now();
-                set_diff += (set_end - set_start);
-            }
-        }
+    std::vector<segment::doc_id_t> found_ids;
+    std::vector<segment::offset_t> offsets;
+    id_index->Search(ids_to_check, found_ids, offsets);
+    if (offsets.empty()) {
+        return Status::OK();
+    }
 
-        LOG_ENGINE_DEBUG_ << "Finding " << ids_to_check.size() << " uids in " << uids.size() << " uids took "
-                          << find_diff.count() << " s in total";
-        LOG_ENGINE_DEBUG_ << "Setting deleted docs and bloom filter took " << set_diff.count() << " s in total";
+    // the bloom filter keeps deleted uids, skip the offsets deleted before
+    segment::DeletedDocsPtr deleted_docs_ptr;
+    status = segment_reader.LoadDeletedDocs(deleted_docs_ptr);
+    if (!status.ok()) {
+        return status;
+    }
+    auto deleted = std::make_shared<faiss::ConcurrentBitset>(id_index->Count());
+    deleted_docs_ptr->GetBitset(deleted);
+    offsets.erase(std::remove_if(offsets.begin(), offsets.end(),
+                                 [&](segment::offset_t offset) { return deleted->test(offset); }),
+                  offsets.end());
+    if (offsets.empty()) {
+        return Status::OK();
+    }
+    std::sort(offsets.begin(), offsets.end());
 
-        rec.RecordSection("Find uids and set deleted docs and bloom filter");
+    rec.RecordSection("Found " + std::to_string(offsets.size()) + " of " + std::to_string(ids_to_check.size()) +
+                      " uids in " + std::to_string(id_index->Count()) + " uids");
 
-        for (size_t i = 0; i < indexes.size(); ++i) {
-            indexes[i]->SetBlacklist(blacklists[i]);
-        }
+    meta::FilesHolder segment_holder;
+    status = meta_->GetCollectionFilesBySegmentId(file.segment_id_, segment_holder);
+    if (!status.ok()) {
+        return status;
+    }
 
-        segment::Segment tmp_segment;
-        segment::SegmentWriter segment_writer(segment_dir);
-        status = segment_writer.WriteDeletedDocs(deleted_docs);
-        if (!status.ok()) {
-            break;
+    // Set blacklist of every index in cache
+    milvus::engine::meta::SegmentsSchema& segment_files = segment_holder.HoldFiles();
+    for (auto& segment_file : segment_files) {
+        auto data_obj_ptr = cache::CpuCacheMgr::GetInstance()->GetIndex(segment_file.location_);
+        auto index = std::static_pointer_cast<knowhere::VecIndex>(data_obj_ptr);
+        if (index == nullptr) {
+            continue;
         }
-
-        rec.RecordSection("Appended " + std::to_string(deleted_docs->GetSize()) + " offsets to deleted docs");
-
-        status = segment_writer.WriteBloomFilter(id_bloom_filter_ptr);
-        if (!status.ok()) {
-            break;
+        faiss::ConcurrentBitsetPtr blacklist = index->GetBlacklist();
+        if (blacklist == nullptr) {
+            continue;
         }
 
-        rec.RecordSection("Updated bloom filter");
-
-        // Update collection file row count
-        for (auto& segment_file : segment_files) {
-            if (segment_file.file_type_ == meta::SegmentSchema::RAW ||
-                segment_file.file_type_ == meta::SegmentSchema::TO_INDEX ||
-                segment_file.file_type_ == meta::SegmentSchema::INDEX ||
-                segment_file.file_type_ == meta::SegmentSchema::BACKUP) {
-                segment_file.row_count_ -= delete_count;
-                files_to_update.emplace_back(segment_file);
+        // offsets are sorted, fold the bits falling into the same word and set them together
+        auto& words = blacklist->bitset();
+        for (size_t i = 0; i < offsets.size();) {
+            auto word = offsets[i] >> 3;
+            uint8_t mask = 0;
+            for (; i < offsets.size() && (offsets[i] >> 3) == word; ++i) {
+                mask |= (0x1 << (offsets[i] & 0x7));
             }
+            words[word].fetch_or(mask);
         }
-        rec.RecordSection("Update collection file row count in vector");
+        index->SetBlacklist(blacklist);
     }
 
-    recorder.RecordSection("Finished " + std::to_string(ids_to_check_map.size()) + " segment to apply deletes");
-
-    status = meta_->UpdateCollectionFilesRowCount(files_to_update);
+    rec.RecordSection("Set blacklist in cache");
 
+    auto delete_count = offsets.size();
+    segment::DeletedDocsPtr deleted_docs = std::make_shared<segment::DeletedDocs>(offsets);
+    segment::SegmentWriter segment_writer(segment_dir);
+    status = segment_writer.WriteDeletedDocs(deleted_docs);
     if (!status.ok()) {
-        std::string err_msg = "Failed to apply deletes: " + status.ToString();
-        LOG_ENGINE_ERROR_ << err_msg;
-        return Status(DB_ERROR, err_msg);
+        return status;
     }
 
-    doc_ids_to_delete_.clear();
+    rec.RecordSection("Appended " + std::to_string(deleted_docs->GetSize()) + " offsets to deleted docs");
 
-    recorder.RecordSection("Update deletes to meta");
-    recorder.ElapseFromBegin("Finished deletes");
+    // Update collection file row count
+    for (auto& segment_file : segment_files) {
+        if (segment_file.file_type_ == meta::SegmentSchema::RAW ||
+            segment_file.file_type_ == meta::SegmentSchema::TO_INDEX ||
+            segment_file.file_type_ == meta::SegmentSchema::INDEX ||
+            segment_file.file_type_ == meta::SegmentSchema::BACKUP) {
+            segment_file.row_count_ -= delete_count;
+            files_to_update.emplace_back(segment_file);
+        }
+    }
 
     return Status::OK();
 }
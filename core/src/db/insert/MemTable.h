@@ -22,6 +22,7 @@
 #include "db/insert/MemTableFile.h"
 #include "db/insert/VectorSource.h"
 #include "utils/Status.h"
+#include "utils/TaskExecutor.h"
 
 namespace milvus {
 namespace engine {
@@ -30,7 +31,8 @@ class MemTable : public server::CacheConfigHandler {
  public:
     using MemTableFileList = std::vector<MemTableFilePtr>;
 
-    MemTable(const std::string& collection_id, const meta::MetaPtr& meta, const DBOptions& options);
+    MemTable(const std::string& collection_id, const meta::MetaPtr& meta, const DBOptions& options,
+             TaskExecutorPtr apply_delete_pool = nullptr);
 
     Status
     Add(const VectorSourcePtr& source);
@@ -76,6 +78,10 @@ class MemTable : public server::CacheConfigHandler {
     Status
     ApplyDeletes();
 
+    Status
+    ApplyDeletesToSegment(const meta::SegmentSchema& file, const std::vector<segment::doc_id_t>& ids_to_delete,
+                          meta::SegmentsSchema& files_to_update);
+
  private:
     const std::string collection_id_;
 
@@ -90,6 +96,8 @@ class MemTable : public server::CacheConfigHandler {
     std::set<segment::doc_id_t> doc_ids_to_delete_;
 
     std::atomic<uint64_t> lsn_;
+
+    TaskExecutorPtr apply_delete_pool_;
 };  // MemTable
 
 using MemTablePtr = std::shared_ptr<MemTable>;
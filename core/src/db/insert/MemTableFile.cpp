@@ -38,6 +38,9 @@ MemTableFile::MemTableFile(const std::string& collection_id, const meta::MetaPtr
         std::string directory;
         utils::GetParentPath(table_file_schema_.location_, directory);
         segment_writer_ptr_ = std::make_shared<segment::SegmentWriter>(directory);
+        if (!utils::IsBinaryMetricType(table_file_schema_.metric_type_)) {
+            segment_writer_ptr_->SummarizeVectors(table_file_schema_.dimension_);
+        }
     }
 
     SetIdentity("MemTableFile");
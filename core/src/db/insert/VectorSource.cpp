@@ -24,28 +24,58 @@ namespace milvus {
 namespace engine {
 
 VectorSource::VectorSource(VectorsData vectors) : vectors_(std::move(vectors)) {
+    InitView();
     current_num_vectors_added = 0;
 }
 
-VectorSource::VectorSource(milvus::engine::VectorsData vectors,
-                           const std::unordered_map<std::string, uint64_t>& attr_nbytes,
-                           const std::unordered_map<std::string, uint64_t>& attr_size,
-                           const std::unordered_map<std::string, std::vector<uint8_t>>& attr_data)
-    : vectors_(std::move(vectors)), attr_nbytes_(attr_nbytes), attr_size_(attr_size), attr_data_(attr_data) {
+VectorSource::VectorSource(int64_t count, const IDNumber* ids, const float* vectors)
+    : vector_count_(count), id_ptr_(ids), data_ptr_(reinterpret_cast<const uint8_t*>(vectors)), is_binary_(false) {
+    current_num_vectors_added = 0;
+}
+
+VectorSource::VectorSource(int64_t count, const IDNumber* ids, const uint8_t* vectors)
+    : vector_count_(count), id_ptr_(ids), data_ptr_(vectors), is_binary_(true) {
+    current_num_vectors_added = 0;
+}
+
+VectorSource::VectorSource(int64_t count, const IDNumber* ids, const uint8_t* const* rows, bool binary)
+    : vector_count_(count), id_ptr_(ids), rows_ptr_(rows), is_binary_(binary) {
+    current_num_vectors_added = 0;
+}
+
+VectorSource::VectorSource(int64_t count, const IDNumber* ids, const float* vectors, const AttrColumns& attrs)
+    : vector_count_(count),
+      id_ptr_(ids),
+      data_ptr_(reinterpret_cast<const uint8_t*>(vectors)),
+      is_binary_(false),
+      attrs_(&attrs) {
     current_num_vectors_added = 0;
     current_num_attrs_added = 0;
 }
 
+void
+VectorSource::InitView() {
+    vector_count_ = vectors_.vector_count_;
+    id_ptr_ = vectors_.id_array_.empty() ? nullptr : vectors_.id_array_.data();
+    if (!vectors_.float_data_.empty()) {
+        data_ptr_ = reinterpret_cast<const uint8_t*>(vectors_.float_data_.data());
+        is_binary_ = false;
+    } else if (!vectors_.binary_data_.empty()) {
+        data_ptr_ = vectors_.binary_data_.data();
+        is_binary_ = true;
+    }
+}
+
 Status
 VectorSource::Add(const segment::SegmentWriterPtr& segment_writer_ptr, const meta::SegmentSchema& table_file_schema,
                   const size_t& num_vectors_to_add, size_t& num_vectors_added) {
-    uint64_t n = vectors_.vector_count_;
+    uint64_t n = vector_count_;
     server::CollectAddMetrics metrics(n, table_file_schema.dimension_);
 
     num_vectors_added =
         current_num_vectors_added + num_vectors_to_add <= n ? num_vectors_to_add : n - current_num_vectors_added;
     IDNumbers vector_ids_to_add;
-    if (vectors_.id_array_.empty()) {
+    if (id_ptr_ == nullptr) {
         SafeIDGenerator& id_generator = SafeIDGenerator::GetInstance();
         Status status = id_generator.GetNextIDNumbers(num_vectors_added, vector_ids_to_add);
         if (!status.ok()) {
@@ -53,24 +83,23 @@ VectorSource::Add(const segment::SegmentWriterPtr& segment_writer_ptr, const met
             return status;
         }
     } else {
-        vector_ids_to_add.resize(num_vectors_added);
-        for (size_t pos = current_num_vectors_added; pos < current_num_vectors_added + num_vectors_added; pos++) {
-            vector_ids_to_add[pos - current_num_vectors_added] = vectors_.id_array_[pos];
-        }
+        vector_ids_to_add.assign(id_ptr_ + current_num_vectors_added,
+                                 id_ptr_ + current_num_vectors_added + num_vectors_added);
     }
 
     Status status;
-    if (!vectors_.float_data_.empty()) {
-        LOG_ENGINE_DEBUG_ << LogOut("[%s][%ld]", "insert", 0) << "Insert float data into segment";
-        auto size = num_vectors_added * table_file_schema.dimension_ * sizeof(float);
-        float* ptr = vectors_.float_data_.data() + current_num_vectors_added * table_file_schema.dimension_;
-        status = segment_writer_ptr->AddVectors(table_file_schema.file_id_, (uint8_t*)ptr, size, vector_ids_to_add);
-    } else if (!vectors_.binary_data_.empty()) {
-        LOG_ENGINE_DEBUG_ << LogOut("[%s][%ld]", "insert", 0) << "Insert binary data into segment";
-        std::vector<uint8_t> vectors;
-        auto size = num_vectors_added * SingleVectorSize(table_file_schema.dimension_) * sizeof(uint8_t);
-        uint8_t* ptr =
-            vectors_.binary_data_.data() + current_num_vectors_added * SingleVectorSize(table_file_schema.dimension_);
+    if (rows_ptr_ != nullptr) {
+        LOG_ENGINE_DEBUG_ << LogOut("[%s][%ld]", "insert", 0) << "Insert " << (is_binary_ ? "binary" : "float")
+                          << " rows into segment";
+        auto single_size = SingleVectorSize(table_file_schema.dimension_);
+        status = segment_writer_ptr->AddVectors(table_file_schema.file_id_, rows_ptr_ + current_num_vectors_added,
+                                                num_vectors_added, single_size, vector_ids_to_add);
+    } else if (data_ptr_ != nullptr) {
+        LOG_ENGINE_DEBUG_ << LogOut("[%s][%ld]", "insert", 0) << "Insert " << (is_binary_ ? "binary" : "float")
+                          << " data into segment";
+        auto single_size = SingleVectorSize(table_file_schema.dimension_);
+        auto size = num_vectors_added * single_size;
+        auto ptr = data_ptr_ + current_num_vectors_added * single_size;
         status = segment_writer_ptr->AddVectors(table_file_schema.file_id_, ptr, size, vector_ids_to_add);
     }
 
@@ -92,26 +121,32 @@ VectorSource::AddEntities(const milvus::segment::SegmentWriterPtr& segment_write
                           const milvus::engine::meta::SegmentSchema& collection_file_schema,
                           const size_t& num_entities_to_add, size_t& num_entities_added) {
     // TODO: n = vectors_.vector_count_;???
-    uint64_t n = vectors_.vector_count_;
+    uint64_t n = vector_count_;
     num_entities_added =
         current_num_attrs_added + num_entities_to_add <= n ? num_entities_to_add : n - current_num_attrs_added;
     IDNumbers vector_ids_to_add;
-    if (vectors_.id_array_.empty()) {
+    if (id_ptr_ == nullptr) {
         SafeIDGenerator& id_generator = SafeIDGenerator::GetInstance();
         Status status = id_generator.GetNextIDNumbers(num_entities_added, vector_ids_to_add);
         if (!status.ok()) {
             return status;
         }
     } else {
-        vector_ids_to_add.resize(num_entities_added);
-        for (size_t pos = current_num_attrs_added; pos < current_num_attrs_added + num_entities_added; pos++) {
-            vector_ids_to_add[pos - current_num_attrs_added] = vectors_.id_array_[pos];
-        }
+        vector_ids_to_add.assign(id_ptr_ + current_num_attrs_added,
+                                 id_ptr_ + current_num_attrs_added + num_entities_added);
     }
 
+    // append only the rows of this batch, every column is sliced in place
     Status status;
-    status =
-        segment_writer_ptr->AddAttrs(collection_file_schema.collection_id_, attr_size_, attr_data_, vector_ids_to_add);
+    if (attrs_ != nullptr) {
+        for (auto& attr : *attrs_) {
+            auto ptr = attr.data_.data() + current_num_attrs_added * attr.nbytes_;
+            status = segment_writer_ptr->AddAttr(attr.name_, ptr, num_entities_added * attr.nbytes_, vector_ids_to_add);
+            if (!status.ok()) {
+                break;
+            }
+        }
+    }
 
     if (status.ok()) {
         current_num_attrs_added += num_entities_added;
@@ -120,13 +155,10 @@ VectorSource::AddEntities(const milvus::segment::SegmentWriterPtr& segment_write
         return status;
     }
 
-    std::vector<uint8_t> vectors;
     auto size = num_entities_added * collection_file_schema.dimension_ * sizeof(float);
-    vectors.resize(size);
-    memcpy(vectors.data(), vectors_.float_data_.data() + current_num_vectors_added * collection_file_schema.dimension_,
-           size);
+    auto ptr = data_ptr_ + current_num_vectors_added * collection_file_schema.dimension_ * sizeof(float);
     LOG_ENGINE_DEBUG_ << LogOut("[%s][%ld]", "insert", 0) << "Insert into segment";
-    status = segment_writer_ptr->AddVectors(collection_file_schema.file_id_, vectors, vector_ids_to_add);
+    status = segment_writer_ptr->AddVectors(collection_file_schema.file_id_, ptr, size, vector_ids_to_add);
     if (status.ok()) {
         current_num_vectors_added += num_entities_added;
         vector_ids_.insert(vector_ids_.end(), std::make_move_iterator(vector_ids_to_add.begin()),
@@ -149,13 +181,10 @@ VectorSource::GetNumVectorsAdded() {
 
 size_t
 VectorSource::SingleVectorSize(uint16_t dimension) {
-    if (!vectors_.float_data_.empty()) {
-        return dimension * FLOAT_TYPE_SIZE;
-    } else if (!vectors_.binary_data_.empty()) {
-        return dimension / 8;
+    if (data_ptr_ == nullptr && rows_ptr_ == nullptr) {
+        return 0;
     }
-
-    return 0;
+    return is_binary_ ? dimension / 8 : dimension * FLOAT_TYPE_SIZE;
 }
 
 size_t
@@ -163,16 +192,18 @@ VectorSource::SingleEntitySize(uint16_t dimension) {
     // TODO(yukun) add entity type and size compute
     size_t size = 0;
     size += dimension * FLOAT_TYPE_SIZE;
-    auto nbyte_it = attr_nbytes_.begin();
-    for (; nbyte_it != attr_nbytes_.end(); ++nbyte_it) {
-        size += nbyte_it->second;
+    if (attrs_ == nullptr) {
+        return size;
+    }
+    for (auto& attr : *attrs_) {
+        size += attr.nbytes_;
     }
     return size;
 }
 
 bool
 VectorSource::AllAdded() {
-    return (current_num_vectors_added == vectors_.vector_count_);
+    return (current_num_vectors_added == vector_count_);
 }
 
 IDNumbers
@@ -31,9 +31,17 @@ class VectorSource {
  public:
     explicit VectorSource(VectorsData vectors);
 
-    VectorSource(VectorsData vectors, const std::unordered_map<std::string, uint64_t>& attr_nbytes,
-                 const std::unordered_map<std::string, uint64_t>& attr_size,
-                 const std::unordered_map<std::string, std::vector<uint8_t>>& attr_data);
+    // Borrow the caller's buffers instead of copying them. The buffers must outlive the source,
+    // which holds for MemTable::Add since it consumes the whole source before returning.
+    VectorSource(int64_t count, const IDNumber* ids, const float* vectors);
+
+    VectorSource(int64_t count, const IDNumber* ids, const uint8_t* vectors);
+
+    // Borrows count rows, each holding one vector, they are gathered into the segment by Add
+    VectorSource(int64_t count, const IDNumber* ids, const uint8_t* const* rows, bool binary);
+
+    // Borrows the vectors and the attribute columns as well
+    VectorSource(int64_t count, const IDNumber* ids, const float* vectors, const AttrColumns& attrs);
 
     Status
     Add(const segment::SegmentWriterPtr& segment_writer_ptr, const meta::SegmentSchema& table_file_schema,
@@ -58,12 +66,22 @@ class VectorSource {
     IDNumbers
     GetVectorIds();
 
+ private:
+    void
+    InitView();
+
  private:
     VectorsData vectors_;
+
+    // view of the data to add, points into vectors_ or into borrowed buffers
+    int64_t vector_count_ = 0;
+    const IDNumber* id_ptr_ = nullptr;
+    const uint8_t* data_ptr_ = nullptr;
+    const uint8_t* const* rows_ptr_ = nullptr;
+    bool is_binary_ = false;
+
     IDNumbers vector_ids_;
-    const std::unordered_map<std::string, uint64_t> attr_nbytes_;
-    std::unordered_map<std::string, uint64_t> attr_size_;
-    std::unordered_map<std::string, std::vector<uint8_t>> attr_data_;
+    const AttrColumns* attrs_ = nullptr;
 
     size_t current_num_vectors_added;
     size_t current_num_attrs_added;
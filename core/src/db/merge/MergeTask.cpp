@@ -56,6 +56,9 @@ MergeTask::Execute() {
     std::string new_segment_dir;
     utils::GetParentPath(collection_file.location_, new_segment_dir);
     auto segment_writer_ptr = std::make_shared<segment::SegmentWriter>(new_segment_dir);
+    if (!utils::IsBinaryMetricType(collection_file.metric_type_)) {
+        segment_writer_ptr->SummarizeVectors(collection_file.dimension_);
+    }
 
     // attention: here is a copy, not reference, since files_holder.UnmarkFile will change the array internal
     std::string info = "Merge task files size info:";
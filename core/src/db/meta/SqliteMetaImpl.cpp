@@ -47,10 +47,10 @@ namespace {
 
 constexpr uint64_t SQL_BATCH_SIZE = 50;
 
-template <typename T>
+template <typename T, typename E>
 void
-DistributeBatch(const T& id_array, std::vector<std::vector<std::string>>& id_groups) {
-    std::vector<std::string> temp_group;
+DistributeBatch(const T& id_array, std::vector<std::vector<E>>& id_groups) {
+    std::vector<E> temp_group;
     constexpr uint64_t SQL_BATCH_SIZE = 50;
     for (auto& id : id_array) {
         temp_group.push_back(id);
@@ -117,6 +117,9 @@ StoragePrototype(const std::string& path) {
 
 using ConnectorT = decltype(StoragePrototype("table"));
 static std::unique_ptr<ConnectorT> ConnectorPtr;
+// a second connection to the same file for the reads of the search path, in WAL mode a reader sees the last commit
+// and never waits for the writer
+static std::unique_ptr<ConnectorT> ReadConnectorPtr;
 
 SqliteMetaImpl::SqliteMetaImpl(const DBMetaOptions& options) : options_(options) {
     Initialize();
@@ -189,6 +192,9 @@ SqliteMetaImpl::Initialize() {
     ConnectorPtr->open_forever();                          // thread safe option
     ConnectorPtr->pragma.journal_mode(journal_mode::WAL);  // WAL => write ahead log
 
+    ReadConnectorPtr = std::make_unique<ConnectorT>(StoragePrototype(options_.path_ + "/meta.sqlite"));
+    ReadConnectorPtr->open_forever();
+
     CleanUpShadowFiles();
 
     return Status::OK();
@@ -245,10 +251,10 @@ SqliteMetaImpl::DescribeCollection(CollectionSchema& collection_schema) {
     try {
         server::MetricCollector metric;
 
-        // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
-        std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+        // readers share the read connection, they never wait for the writers on meta_mutex_
+        std::lock_guard<std::mutex> read_lock(read_mutex_);
         fiu_do_on("SqliteMetaImpl.DescribeCollection.throw_exception", throw std::exception());
-        auto groups = ConnectorPtr->select(
+        auto groups = ReadConnectorPtr->select(
             columns(&CollectionSchema::id_, &CollectionSchema::state_, &CollectionSchema::dimension_,
                     &CollectionSchema::created_on_, &CollectionSchema::flag_, &CollectionSchema::index_file_size_,
                     &CollectionSchema::engine_type_, &CollectionSchema::index_params_, &CollectionSchema::metric_type_,
@@ -289,20 +295,20 @@ SqliteMetaImpl::HasCollection(const std::string& collection_id, bool& has_or_not
         fiu_do_on("SqliteMetaImpl.HasCollection.throw_exception", throw std::exception());
         server::MetricCollector metric;
 
-        // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
-        std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+        // readers share the read connection, they never wait for the writers on meta_mutex_
+        std::lock_guard<std::mutex> read_lock(read_mutex_);
 
         auto select_columns = columns(&CollectionSchema::id_, &CollectionSchema::owner_collection_);
-        decltype(ConnectorPtr->select(select_columns)) selected;
+        decltype(ReadConnectorPtr->select(select_columns)) selected;
         if (is_root) {
-            selected = ConnectorPtr->select(select_columns,
-                                            where(c(&CollectionSchema::collection_id_) == collection_id and
-                                                  c(&CollectionSchema::state_) != (int)CollectionSchema::TO_DELETE and
-                                                  c(&CollectionSchema::owner_collection_) == ""));
+            selected = ReadConnectorPtr->select(
+                select_columns, where(c(&CollectionSchema::collection_id_) == collection_id and
+                                      c(&CollectionSchema::state_) != (int)CollectionSchema::TO_DELETE and
+                                      c(&CollectionSchema::owner_collection_) == ""));
         } else {
-            selected = ConnectorPtr->select(select_columns,
-                                            where(c(&CollectionSchema::collection_id_) == collection_id and
-                                                  c(&CollectionSchema::state_) != (int)CollectionSchema::TO_DELETE));
+            selected = ReadConnectorPtr->select(
+                select_columns, where(c(&CollectionSchema::collection_id_) == collection_id and
+                                      c(&CollectionSchema::state_) != (int)CollectionSchema::TO_DELETE));
         }
 
         if (selected.size() == 1) {
@@ -493,11 +499,11 @@ SqliteMetaImpl::GetCollectionFiles(const std::string& collection_id, const std::
             columns(&SegmentSchema::id_, &SegmentSchema::segment_id_, &SegmentSchema::file_id_,
                     &SegmentSchema::file_type_, &SegmentSchema::file_size_, &SegmentSchema::row_count_,
                     &SegmentSchema::date_, &SegmentSchema::engine_type_, &SegmentSchema::created_on_);
-        decltype(ConnectorPtr->select(select_columns)) selected;
+        decltype(ReadConnectorPtr->select(select_columns)) selected;
         {
-            // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
-            std::lock_guard<std::mutex> meta_lock(meta_mutex_);
-            selected = ConnectorPtr->select(
+            // readers share the read connection, they never wait for the writers on meta_mutex_
+            std::lock_guard<std::mutex> read_lock(read_mutex_);
+            selected = ReadConnectorPtr->select(
                 select_columns,
                 where(c(&SegmentSchema::collection_id_) == collection_id and in(&SegmentSchema::id_, ids) and
                       c(&SegmentSchema::file_type_) != (int)SegmentSchema::TO_DELETE));
@@ -688,33 +694,53 @@ SqliteMetaImpl::UpdateCollectionFiles(SegmentsSchema& files) {
         server::MetricCollector metric;
         fiu_do_on("SqliteMetaImpl.UpdateCollectionFiles.throw_exception", throw std::exception());
 
+        std::set<std::string> collection_ids;
+        for (auto& file : files) {
+            collection_ids.insert(file.collection_id_);
+        }
+        std::vector<std::vector<std::string>> collection_groups;
+        DistributeBatch(collection_ids, collection_groups);
+
         // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
         std::lock_guard<std::mutex> meta_lock(meta_mutex_);
 
-        std::map<std::string, bool> has_collections;
-        for (auto& file : files) {
-            if (has_collections.find(file.collection_id_) != has_collections.end()) {
-                continue;
-            }
+        std::set<std::string> has_collections;
+        for (auto& group : collection_groups) {
             auto collections =
-                ConnectorPtr->select(columns(&CollectionSchema::id_),
-                                     where(c(&CollectionSchema::collection_id_) == file.collection_id_ and
+                ConnectorPtr->select(columns(&CollectionSchema::collection_id_),
+                                     where(in(&CollectionSchema::collection_id_, group) and
                                            c(&CollectionSchema::state_) != (int)CollectionSchema::TO_DELETE));
-            if (collections.size() >= 1) {
-                has_collections[file.collection_id_] = true;
-            } else {
-                has_collections[file.collection_id_] = false;
+            for (auto& collection : collections) {
+                has_collections.insert(std::get<0>(collection));
+            }
+        }
+
+        // the cleanup only reads the type and time of a TO_DELETE file, merge and compaction retire many files at
+        // once, they are marked by one statement per batch instead of one full row update each
+        auto now = utils::GetMicroSecTimeStamp();
+        std::vector<size_t> to_delete_ids;
+        for (auto& file : files) {
+            if (has_collections.find(file.collection_id_) == has_collections.end()) {
+                file.file_type_ = SegmentSchema::TO_DELETE;
+            }
+            file.updated_time_ = now;
+            if (file.file_type_ == SegmentSchema::TO_DELETE) {
+                to_delete_ids.push_back(file.id_);
             }
         }
+        std::vector<std::vector<size_t>> to_delete_groups;
+        DistributeBatch(to_delete_ids, to_delete_groups);
 
         auto commited = ConnectorPtr->transaction([&]() mutable {
+            for (auto& group : to_delete_groups) {
+                ConnectorPtr->update_all(set(c(&SegmentSchema::file_type_) = (int)SegmentSchema::TO_DELETE,
+                                             c(&SegmentSchema::updated_time_) = now),
+                                         where(in(&SegmentSchema::id_, group)));
+            }
             for (auto& file : files) {
-                if (!has_collections[file.collection_id_]) {
-                    file.file_type_ = SegmentSchema::TO_DELETE;
+                if (file.file_type_ != SegmentSchema::TO_DELETE) {
+                    ConnectorPtr->update(file);
                 }
-
-                file.updated_time_ = utils::GetMicroSecTimeStamp();
-                ConnectorPtr->update(file);
             }
             return true;
         });
@@ -724,7 +750,8 @@ SqliteMetaImpl::UpdateCollectionFiles(SegmentsSchema& files) {
             return HandleException("UpdateCollectionFiles error: sqlite transaction failed");
         }
 
-        LOG_ENGINE_DEBUG_ << "Update " << files.size() << " collection files";
+        LOG_ENGINE_DEBUG_ << "Update " << files.size() << " collection files, " << to_delete_ids.size()
+                          << " of them to delete";
     } catch (std::exception& e) {
         return HandleException("Encounter exception when update collection files", e.what());
     }
@@ -739,11 +766,20 @@ SqliteMetaImpl::UpdateCollectionFilesRowCount(SegmentsSchema& files) {
         // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
         std::lock_guard<std::mutex> meta_lock(meta_mutex_);
 
-        for (auto& file : files) {
-            ConnectorPtr->update_all(set(c(&SegmentSchema::row_count_) = file.row_count_,
-                                         c(&SegmentSchema::updated_time_) = utils::GetMicroSecTimeStamp()),
-                                     where(c(&SegmentSchema::file_id_) == file.file_id_));
-            LOG_ENGINE_DEBUG_ << "Update file " << file.file_id_ << " row count to " << file.row_count_;
+        // one commit for all the files instead of one per file
+        auto now = utils::GetMicroSecTimeStamp();
+        auto commited = ConnectorPtr->transaction([&]() mutable {
+            for (auto& file : files) {
+                ConnectorPtr->update_all(
+                    set(c(&SegmentSchema::row_count_) = file.row_count_, c(&SegmentSchema::updated_time_) = now),
+                    where(c(&SegmentSchema::file_id_) == file.file_id_));
+                LOG_ENGINE_DEBUG_ << "Update file " << file.file_id_ << " row count to " << file.row_count_;
+            }
+            return true;
+        });
+
+        if (!commited) {
+            return HandleException("UpdateCollectionFilesRowCount error: sqlite transaction failed");
         }
     } catch (std::exception& e) {
         return HandleException("Encounter exception when update collection files row count", e.what());
@@ -987,7 +1023,9 @@ SqliteMetaImpl::ShowPartitions(const std::string& collection_id,
         server::MetricCollector metric;
         fiu_do_on("SqliteMetaImpl.ShowPartitions.throw_exception", throw std::exception());
 
-        auto partitions = ConnectorPtr->select(
+        // readers share the read connection, they never wait for the writers on meta_mutex_
+        std::lock_guard<std::mutex> read_lock(read_mutex_);
+        auto partitions = ReadConnectorPtr->select(
             columns(&CollectionSchema::id_, &CollectionSchema::state_, &CollectionSchema::dimension_,
                     &CollectionSchema::created_on_, &CollectionSchema::flag_, &CollectionSchema::index_file_size_,
                     &CollectionSchema::engine_type_, &CollectionSchema::index_params_, &CollectionSchema::metric_type_,
@@ -1073,12 +1111,12 @@ SqliteMetaImpl::FilesToSearch(const std::string& collection_id, FilesHolder& fil
         std::vector<int> file_types = {(int)SegmentSchema::RAW, (int)SegmentSchema::TO_INDEX,
                                        (int)SegmentSchema::INDEX};
         auto match_type = in(&SegmentSchema::file_type_, file_types);
-        decltype(ConnectorPtr->select(select_columns)) selected;
+        decltype(ReadConnectorPtr->select(select_columns)) selected;
         {
-            // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
-            std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+            // readers share the read connection, they never wait for the writers on meta_mutex_
+            std::lock_guard<std::mutex> read_lock(read_mutex_);
             auto filter = where(match_collectionid and match_type);
-            selected = ConnectorPtr->select(select_columns, filter);
+            selected = ReadConnectorPtr->select(select_columns, filter);
         }
 
         Status ret;
@@ -1168,12 +1206,12 @@ SqliteMetaImpl::FilesToSearchEx(const std::string& root_collection, const std::s
             std::vector<int> file_types = {(int)SegmentSchema::RAW, (int)SegmentSchema::TO_INDEX,
                                            (int)SegmentSchema::INDEX};
             auto match_type = in(&SegmentSchema::file_type_, file_types);
-            decltype(ConnectorPtr->select(select_columns)) selected;
+            decltype(ReadConnectorPtr->select(select_columns)) selected;
             {
-                // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
-                std::lock_guard<std::mutex> meta_lock(meta_mutex_);
+                // readers share the read connection, they never wait for the writers on meta_mutex_
+                std::lock_guard<std::mutex> read_lock(read_mutex_);
                 auto filter = where(match_collectionid and match_type);
-                selected = ConnectorPtr->select(select_columns, filter);
+                selected = ReadConnectorPtr->select(select_columns, filter);
             }
 
             for (auto& file : selected) {
@@ -1647,13 +1685,13 @@ SqliteMetaImpl::FilesByID(const std::vector<size_t>& ids, FilesHolder& files_hol
                                       &SegmentSchema::created_on_, &SegmentSchema::updated_time_);
 
         // perform query
-        decltype(ConnectorPtr->select(select_columns)) selected;
+        decltype(ReadConnectorPtr->select(select_columns)) selected;
         auto match_fileid = in(&SegmentSchema::id_, ids);
         auto filter = where(match_fileid);
         {
-            // multi-threads call sqlite update may get exception('bad logic', etc), so we add a lock here
-            std::lock_guard<std::mutex> meta_lock(meta_mutex_);
-            selected = ConnectorPtr->select(select_columns, filter);
+            // readers share the read connection, they never wait for the writers on meta_mutex_
+            std::lock_guard<std::mutex> read_lock(read_mutex_);
+            selected = ReadConnectorPtr->select(select_columns, filter);
         }
 
         std::map<std::string, meta::CollectionSchema> collections;
@@ -1845,6 +1883,7 @@ SqliteMetaImpl::CleanUpFilesWithTTL(uint64_t seconds /*, CleanUpFilter* filter*/
 
         int64_t clean_files = 0;
         auto commited = ConnectorPtr->transaction([&]() mutable {
+            std::vector<size_t> removed_ids;
             SegmentSchema collection_file;
             for (auto& file : files) {
                 collection_file.id_ = std::get<0>(file);
@@ -1869,8 +1908,8 @@ SqliteMetaImpl::CleanUpFilesWithTTL(uint64_t seconds /*, CleanUpFilter* filter*/
                 utils::EraseFromCache(collection_file.location_);
 
                 if (collection_file.file_type_ == (int)SegmentSchema::TO_DELETE) {
-                    // delete file from meta
-                    ConnectorPtr->remove<SegmentSchema>(collection_file.id_);
+                    // delete file from meta, in batches below
+                    removed_ids.push_back(collection_file.id_);
 
                     // delete file from disk storage
                     utils::DeleteCollectionFilePath(options_, collection_file);
@@ -1883,6 +1922,12 @@ SqliteMetaImpl::CleanUpFilesWithTTL(uint64_t seconds /*, CleanUpFilter* filter*/
                     ++clean_files;
                 }
             }
+
+            std::vector<std::vector<size_t>> id_groups;
+            DistributeBatch(removed_ids, id_groups);
+            for (auto& group : id_groups) {
+                ConnectorPtr->remove_all<SegmentSchema>(where(in(&SegmentSchema::id_, group)));
+            }
             return true;
         });
         fiu_do_on("SqliteMetaImpl.CleanUpFilesWithTTL.RemoveFile_FailCommited", commited = false);
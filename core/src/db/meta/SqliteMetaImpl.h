@@ -178,7 +178,8 @@ class SqliteMetaImpl : public Meta {
 
  private:
     const DBMetaOptions options_;
-    std::mutex meta_mutex_;
+    std::mutex meta_mutex_;  // the writers and the reads they depend on
+    std::mutex read_mutex_;  // the reads of the search path, on their own connection
     std::mutex genid_mutex_;
 };  // DBMetaImpl
 
@@ -199,15 +199,11 @@ MXLogBuffer::EntityRecordSize(const milvus::engine::wal::MXLogRecord& record, ui
     attr_header_size += attr_num * sizeof(uint64_t) * 3;
 
     uint32_t name_sizes = 0;
-    for (auto field_name : record.field_names) {
-        field_name_size.emplace_back(field_name.size());
-        name_sizes += field_name.size();
-    }
-
     uint64_t attr_size = 0;
-    auto attr_it = record.attr_data_size.begin();
-    for (; attr_it != record.attr_data_size.end(); attr_it++) {
-        attr_size += attr_it->second;
+    for (auto& attr : record.attrs) {
+        field_name_size.emplace_back(attr.name_.size());
+        name_sizes += attr.name_.size();
+        attr_size += attr.data_.size();
     }
 
     return RecordSize(record) + name_sizes + attr_size + attr_header_size;
@@ -264,7 +260,13 @@ MXLogBuffer::Append(MXLogRecord& record) {
         current_write_offset += record.length * sizeof(IDNumber);
     }
 
-    if (record.data != nullptr && record.data_size > 0) {
+    if (record.rows != nullptr && record.length > 0) {
+        uint32_t row_size = record.data_size / record.length;
+        for (uint32_t i = 0; i < record.length; ++i) {
+            memcpy(current_write_buf + current_write_offset, record.rows[i], row_size);
+            current_write_offset += row_size;
+        }
+    } else if (record.data != nullptr && record.data_size > 0) {
         memcpy(current_write_buf + current_write_offset, record.data, record.data_size);
         current_write_offset += record.data_size;
     }
@@ -286,11 +288,11 @@ MXLogBuffer::AppendEntity(milvus::engine::wal::MXLogRecord& record) {
     std::vector<uint32_t> field_name_size;
     MXLogAttrRecordHeader attr_header;
     attr_header.attr_num = 0;
-    for (auto name : record.field_names) {
+    for (auto& attr : record.attrs) {
         attr_header.attr_num++;
-        attr_header.field_name_size.emplace_back(name.size());
-        attr_header.attr_size.emplace_back(record.attr_data_size.at(name));
-        attr_header.attr_nbytes.emplace_back(record.attr_nbytes.at(name));
+        attr_header.field_name_size.emplace_back(attr.name_.size());
+        attr_header.attr_size.emplace_back(attr.data_.size());
+        attr_header.attr_nbytes.emplace_back(attr.nbytes_);
     }
 
     uint32_t record_size = EntityRecordSize(record, attr_header.attr_num, field_name_size);
@@ -363,19 +365,18 @@ MXLogBuffer::AppendEntity(milvus::engine::wal::MXLogRecord& record) {
     }
 
     // Assign attr names
-    for (auto name : record.field_names) {
-        if (name.size() > 0) {
-            memcpy(current_write_buf + current_write_offset, name.data(), name.size());
-            current_write_offset += name.size();
+    for (auto& attr : record.attrs) {
+        if (attr.name_.size() > 0) {
+            memcpy(current_write_buf + current_write_offset, attr.name_.data(), attr.name_.size());
+            current_write_offset += attr.name_.size();
         }
     }
 
     // Assign attr values
-    for (auto name : record.field_names) {
-        if (record.attr_data_size.at(name) != 0) {
-            memcpy(current_write_buf + current_write_offset, record.attr_data.at(name).data(),
-                   record.attr_data_size.at(name));
-            current_write_offset += record.attr_data_size.at(name);
+    for (auto& attr : record.attrs) {
+        if (!attr.data_.empty()) {
+            memcpy(current_write_buf + current_write_offset, attr.data_.data(), attr.data_.size());
+            current_write_offset += attr.data_.size();
         }
     }
 
@@ -569,34 +570,21 @@ MXLogBuffer::NextEntity(const uint64_t last_applied_lsn, milvus::engine::wal::MX
 
     // Read field names
     auto attr_num = attr_head.attr_num;
-    record.field_names.clear();
-    if (attr_num > 0) {
-        for (auto size : attr_head.field_name_size) {
-            if (size != 0) {
-                std::string name;
-                name.assign(current_read_buf + current_read_offset, size);
-                record.field_names.emplace_back(name);
-                current_read_offset += size;
-            } else {
-                record.field_names.emplace_back("");
-            }
-        }
+    record.attrs.clear();
+    record.attrs.resize(attr_num);
+    for (uint64_t i = 0; i < attr_num; ++i) {
+        auto size = attr_head.field_name_size[i];
+        record.attrs[i].name_.assign(current_read_buf + current_read_offset, size);
+        current_read_offset += size;
     }
 
     // Read attributes data
-    record.attr_data.clear();
-    record.attr_data_size.clear();
-    record.attr_nbytes.clear();
-    if (attr_num > 0) {
-        for (uint64_t i = 0; i < attr_num; ++i) {
-            auto attr_size = attr_head.attr_size[i];
-            record.attr_data_size.insert(std::make_pair(record.field_names[i], attr_size));
-            record.attr_nbytes.insert(std::make_pair(record.field_names[i], attr_head.attr_nbytes[i]));
-            std::vector<uint8_t> data(attr_size);
-            memcpy(data.data(), current_read_buf + current_read_offset, attr_size);
-            record.attr_data.insert(std::make_pair(record.field_names[i], data));
-            current_read_offset += attr_size;
-        }
+    for (uint64_t i = 0; i < attr_num; ++i) {
+        auto attr_size = attr_head.attr_size[i];
+        record.attrs[i].nbytes_ = attr_head.attr_nbytes[i];
+        record.attrs[i].data_.assign(current_read_buf + current_read_offset,
+                                     current_read_buf + current_read_offset + attr_size);
+        current_read_offset += attr_size;
     }
 
     mxlog_buffer_reader_.buf_offset = uint32_t(head->mxl_lsn & LSN_OFFSET_MASK);
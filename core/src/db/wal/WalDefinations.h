@@ -41,12 +41,10 @@ struct MXLogRecord {
     const IDNumber* ids;
     uint32_t data_size;
     const void* data;
-    std::vector<std::string> field_names;
-    //    std::vector<uint32_t> attrs_size;
-    //    std::vector<const void* > attrs_data;
-    std::unordered_map<std::string, uint64_t> attr_nbytes;
-    std::unordered_map<std::string, uint64_t> attr_data_size;
-    std::unordered_map<std::string, std::vector<uint8_t>> attr_data;
+    // if set, data is gathered from length rows of data_size / length bytes each instead
+    const uint8_t* const* rows = nullptr;
+    // attributes of an Entity record, each column holds the values of the length entities
+    AttrColumns attrs;
 };
 
 struct MXLogConfiguration {
@@ -442,14 +442,39 @@ WalManager::Insert(const std::string& collection_id, const std::string& partitio
         return false;
     }
     size_t dim = vectors.size() / vector_num;
-    size_t unit_size = dim * sizeof(T) + sizeof(IDNumber);
-    size_t head_size = SizeOfMXLogRecordHeader + collection_id.length() + partition_tag.length();
 
     MXLogRecord record;
     record.type = log_type;
     record.collection_id = collection_id;
     record.partition_tag = partition_tag;
 
+    return AppendInsert(record, vector_ids, dim * sizeof(T), reinterpret_cast<const uint8_t*>(vectors.data()),
+                        nullptr);
+}
+
+bool
+WalManager::Insert(const std::string& collection_id, const std::string& partition_tag, const IDNumbers& vector_ids,
+                   const VectorRows& rows) {
+    if (vector_ids.empty() || vector_ids.size() != rows.rows_.size()) {
+        LOG_WAL_ERROR_ << LogOut("[%s][%ld] The ids don't match the rows.", "insert", 0);
+        return false;
+    }
+
+    MXLogRecord record;
+    record.type = rows.binary_ ? MXLogType::InsertBinary : MXLogType::InsertVector;
+    record.collection_id = collection_id;
+    record.partition_tag = partition_tag;
+
+    return AppendInsert(record, vector_ids, rows.row_size_, nullptr, rows.rows_.data());
+}
+
+bool
+WalManager::AppendInsert(MXLogRecord& record, const IDNumbers& vector_ids, size_t row_size, const uint8_t* data,
+                         const uint8_t* const* rows) {
+    size_t vector_num = vector_ids.size();
+    size_t unit_size = row_size + sizeof(IDNumber);
+    size_t head_size = SizeOfMXLogRecordHeader + record.collection_id.length() + record.partition_tag.length();
+
     uint64_t new_lsn = 0;
     for (size_t i = 0; i < vector_num; i += record.length) {
         size_t surplus_space = p_buffer_->SurplusSpace();
@@ -467,8 +492,9 @@ WalManager::Insert(const std::string& collection_id, const std::string& partitio
 
         record.length = std::min(vector_num - i, max_rcd_num);
         record.ids = vector_ids.data() + i;
-        record.data_size = record.length * dim * sizeof(T);
-        record.data = vectors.data() + i * dim;
+        record.data_size = record.length * row_size;
+        record.data = (data == nullptr) ? nullptr : data + i * row_size;
+        record.rows = (rows == nullptr) ? nullptr : rows + i;
 
         auto error_code = p_buffer_->Append(record);
         if (error_code != WAL_SUCCESS) {
@@ -479,10 +505,10 @@ WalManager::Insert(const std::string& collection_id, const std::string& partitio
     }
 
     last_applied_lsn_ = new_lsn;
-    PartitionUpdated(collection_id, partition_tag, new_lsn);
+    PartitionUpdated(record.collection_id, record.partition_tag, new_lsn);
 
-    LOG_WAL_INFO_ << LogOut("[%s][%ld]", "insert", 0) << collection_id << " insert in part " << partition_tag
-                  << " with lsn " << new_lsn;
+    LOG_WAL_INFO_ << LogOut("[%s][%ld]", "insert", 0) << record.collection_id << " insert in part "
+                  << record.partition_tag << " with lsn " << new_lsn;
 
     return p_meta_handler_->SetMXLogInternalMeta(new_lsn);
 }
@@ -491,8 +517,7 @@ template <typename T>
 bool
 WalManager::InsertEntities(const std::string& collection_id, const std::string& partition_tag,
                            const milvus::engine::IDNumbers& entity_ids, const std::vector<T>& vectors,
-                           const std::unordered_map<std::string, uint64_t>& attr_nbytes,
-                           const std::unordered_map<std::string, std::vector<uint8_t>>& attrs) {
+                           const AttrColumns& attrs) {
     MXLogType log_type;
     if (std::is_same<T, float>::value) {
         log_type = MXLogType::Entity;
@@ -510,10 +535,11 @@ WalManager::InsertEntities(const std::string& collection_id, const std::string&
     MXLogRecord record;
 
     size_t attr_unit_size = 0;
-    auto attr_it = attr_nbytes.begin();
-    for (; attr_it != attr_nbytes.end(); attr_it++) {
-        record.field_names.emplace_back(attr_it->first);
-        attr_unit_size += attr_it->second;
+    record.attrs.resize(attrs.size());
+    for (size_t j = 0; j < attrs.size(); ++j) {
+        record.attrs[j].name_ = attrs[j].name_;
+        record.attrs[j].nbytes_ = attrs[j].nbytes_;
+        attr_unit_size += attrs[j].nbytes_;
     }
 
     size_t unit_size = dim * sizeof(T) + sizeof(IDNumber) + attr_unit_size;
@@ -524,7 +550,6 @@ WalManager::InsertEntities(const std::string& collection_id, const std::string&
     record.type = log_type;
     record.collection_id = collection_id;
     record.partition_tag = partition_tag;
-    record.attr_nbytes = attr_nbytes;
 
     uint64_t new_lsn = 0;
     for (size_t i = 0; i < entity_num; i += record.length) {
@@ -547,14 +572,9 @@ WalManager::InsertEntities(const std::string& collection_id, const std::string&
         record.data_size = record.length * dim * sizeof(T);
         record.data = vectors.data() + i * dim;
 
-        record.attr_data.clear();
-        record.attr_data_size.clear();
-        for (auto field_name : record.field_names) {
-            size_t attr_size = length * attr_nbytes.at(field_name);
-            record.attr_data_size.insert(std::make_pair(field_name, attr_size));
-            std::vector<uint8_t> attr_data(attr_size, 0);
-            memcpy(attr_data.data(), attrs.at(field_name).data() + i * attr_nbytes.at(field_name), attr_size);
-            record.attr_data.insert(std::make_pair(field_name, attr_data));
+        for (size_t j = 0; j < attrs.size(); ++j) {
+            auto begin = attrs[j].data_.begin() + i * attrs[j].nbytes_;
+            record.attrs[j].data_.assign(begin, begin + length * attrs[j].nbytes_);
         }
 
         auto error_code = p_buffer_->AppendEntity(record);
@@ -682,14 +702,12 @@ WalManager::Insert<uint8_t>(const std::string& collection_id, const std::string&
 template bool
 WalManager::InsertEntities<float>(const std::string& collection_id, const std::string& partition_tag,
                                   const milvus::engine::IDNumbers& entity_ids, const std::vector<float>& vectors,
-                                  const std::unordered_map<std::string, uint64_t>& attr_nbytes,
-                                  const std::unordered_map<std::string, std::vector<uint8_t>>& attrs);
+                                  const AttrColumns& attrs);
 
 template bool
 WalManager::InsertEntities<uint8_t>(const std::string& collection_id, const std::string& partition_tag,
                                     const milvus::engine::IDNumbers& entity_ids, const std::vector<uint8_t>& vectors,
-                                    const std::unordered_map<std::string, uint64_t>& attr_nbytes,
-                                    const std::unordered_map<std::string, std::vector<uint8_t>>& attrs);
+                                    const AttrColumns& attrs);
 
 }  // namespace wal
 }  // namespace engine
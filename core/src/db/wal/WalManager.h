@@ -152,20 +152,30 @@ class WalManager {
     Insert(const std::string& collection_id, const std::string& partition_tag, const IDNumbers& vector_ids,
            const std::vector<T>& vectors);
 
+    /*
+     * Insert
+     * @param collection_id: collection id
+     * @param partition_tag: partition tag
+     * @param vector_ids: vector ids
+     * @param rows: vectors, gathered row by row into the wal buffer
+     */
+    bool
+    Insert(const std::string& collection_id, const std::string& partition_tag, const IDNumbers& vector_ids,
+           const VectorRows& rows);
+
     /*
      * Insert
      * @param collection_id: collection id
      * @param partition_tag: partition tag
      * @param vector_ids: vector ids
      * @param vectors: vectors
-     * @param attrs: attributes
+     * @param attrs: attribute columns
      */
     template <typename T>
     bool
     InsertEntities(const std::string& collection_id, const std::string& partition_tag,
                    const milvus::engine::IDNumbers& entity_ids, const std::vector<T>& vectors,
-                   const std::unordered_map<std::string, uint64_t>& attr_nbytes,
-                   const std::unordered_map<std::string, std::vector<uint8_t>>& attrs);
+                   const AttrColumns& attrs);
 
     /*
      * Insert
@@ -191,6 +201,10 @@ class WalManager {
     WalManager
     operator=(WalManager&);
 
+    bool
+    AppendInsert(MXLogRecord& record, const IDNumbers& vector_ids, size_t row_size, const uint8_t* data,
+                 const uint8_t* const* rows);
+
     MXLogConfiguration mxlog_config_;
 
     MXLogBufferPtr p_buffer_;
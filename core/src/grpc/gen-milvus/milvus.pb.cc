@@ -1129,6 +1129,7 @@ const ::PROTOBUF_NAMESPACE_ID::uint32 TableStruct_milvus_2eproto::offsets[] PROT
   PROTOBUF_FIELD_OFFSET(::milvus::grpc::TopKQueryResult, row_num_),
   PROTOBUF_FIELD_OFFSET(::milvus::grpc::TopKQueryResult, ids_),
   PROTOBUF_FIELD_OFFSET(::milvus::grpc::TopKQueryResult, distances_),
+  PROTOBUF_FIELD_OFFSET(::milvus::grpc::TopKQueryResult, lims_),
   ~0u,  // no _has_bits_
   PROTOBUF_FIELD_OFFSET(::milvus::grpc::StringReply, _internal_metadata_),
   ~0u,  // no _extensions_
@@ -1442,43 +1443,43 @@ static const ::PROTOBUF_NAMESPACE_ID::internal::MigrationSchema schemas[] PROTOB
   { 86, -1, sizeof(::milvus::grpc::SearchByIDParam)},
   { 96, -1, sizeof(::milvus::grpc::ReLoadSegmentsParam)},
   { 103, -1, sizeof(::milvus::grpc::TopKQueryResult)},
-  { 112, -1, sizeof(::milvus::grpc::StringReply)},
-  { 119, -1, sizeof(::milvus::grpc::BoolReply)},
-  { 126, -1, sizeof(::milvus::grpc::CollectionRowCount)},
-  { 133, -1, sizeof(::milvus::grpc::Command)},
-  { 139, -1, sizeof(::milvus::grpc::IndexParam)},
-  { 148, -1, sizeof(::milvus::grpc::FlushParam)},
-  { 154, -1, sizeof(::milvus::grpc::DeleteByIDParam)},
-  { 161, -1, sizeof(::milvus::grpc::CollectionInfo)},
-  { 168, -1, sizeof(::milvus::grpc::VectorsIdentity)},
-  { 175, -1, sizeof(::milvus::grpc::VectorsData)},
-  { 182, -1, sizeof(::milvus::grpc::GetVectorIDsParam)},
-  { 189, -1, sizeof(::milvus::grpc::VectorFieldParam)},
-  { 195, -1, sizeof(::milvus::grpc::FieldType)},
-  { 203, -1, sizeof(::milvus::grpc::FieldParam)},
-  { 212, -1, sizeof(::milvus::grpc::VectorFieldRecord)},
-  { 218, -1, sizeof(::milvus::grpc::FieldValue)},
-  { 229, -1, sizeof(::milvus::grpc::Mapping)},
-  { 238, -1, sizeof(::milvus::grpc::MappingList)},
-  { 245, -1, sizeof(::milvus::grpc::TermQuery)},
-  { 256, -1, sizeof(::milvus::grpc::CompareExpr)},
-  { 263, -1, sizeof(::milvus::grpc::RangeQuery)},
-  { 272, -1, sizeof(::milvus::grpc::VectorQuery)},
-  { 282, -1, sizeof(::milvus::grpc::BooleanQuery)},
-  { 289, -1, sizeof(::milvus::grpc::GeneralQuery)},
-  { 299, -1, sizeof(::milvus::grpc::VectorParam)},
-  { 306, -1, sizeof(::milvus::grpc::HSearchParam)},
-  { 316, -1, sizeof(::milvus::grpc::HSearchParamPB)},
-  { 325, -1, sizeof(::milvus::grpc::HSearchInSegmentsParam)},
-  { 332, -1, sizeof(::milvus::grpc::AttrRecord)},
-  { 339, -1, sizeof(::milvus::grpc::HEntity)},
-  { 351, -1, sizeof(::milvus::grpc::HQueryResult)},
-  { 362, -1, sizeof(::milvus::grpc::HInsertParam)},
-  { 372, -1, sizeof(::milvus::grpc::HEntityIdentity)},
-  { 379, -1, sizeof(::milvus::grpc::HEntityIDs)},
-  { 386, -1, sizeof(::milvus::grpc::HGetEntityIDsParam)},
-  { 393, -1, sizeof(::milvus::grpc::HDeleteByIDParam)},
-  { 400, -1, sizeof(::milvus::grpc::HIndexParam)},
+  { 113, -1, sizeof(::milvus::grpc::StringReply)},
+  { 120, -1, sizeof(::milvus::grpc::BoolReply)},
+  { 127, -1, sizeof(::milvus::grpc::CollectionRowCount)},
+  { 134, -1, sizeof(::milvus::grpc::Command)},
+  { 140, -1, sizeof(::milvus::grpc::IndexParam)},
+  { 149, -1, sizeof(::milvus::grpc::FlushParam)},
+  { 155, -1, sizeof(::milvus::grpc::DeleteByIDParam)},
+  { 162, -1, sizeof(::milvus::grpc::CollectionInfo)},
+  { 169, -1, sizeof(::milvus::grpc::VectorsIdentity)},
+  { 176, -1, sizeof(::milvus::grpc::VectorsData)},
+  { 183, -1, sizeof(::milvus::grpc::GetVectorIDsParam)},
+  { 190, -1, sizeof(::milvus::grpc::VectorFieldParam)},
+  { 196, -1, sizeof(::milvus::grpc::FieldType)},
+  { 204, -1, sizeof(::milvus::grpc::FieldParam)},
+  { 213, -1, sizeof(::milvus::grpc::VectorFieldRecord)},
+  { 219, -1, sizeof(::milvus::grpc::FieldValue)},
+  { 230, -1, sizeof(::milvus::grpc::Mapping)},
+  { 239, -1, sizeof(::milvus::grpc::MappingList)},
+  { 246, -1, sizeof(::milvus::grpc::TermQuery)},
+  { 257, -1, sizeof(::milvus::grpc::CompareExpr)},
+  { 264, -1, sizeof(::milvus::grpc::RangeQuery)},
+  { 273, -1, sizeof(::milvus::grpc::VectorQuery)},
+  { 283, -1, sizeof(::milvus::grpc::BooleanQuery)},
+  { 290, -1, sizeof(::milvus::grpc::GeneralQuery)},
+  { 300, -1, sizeof(::milvus::grpc::VectorParam)},
+  { 307, -1, sizeof(::milvus::grpc::HSearchParam)},
+  { 317, -1, sizeof(::milvus::grpc::HSearchParamPB)},
+  { 326, -1, sizeof(::milvus::grpc::HSearchInSegmentsParam)},
+  { 333, -1, sizeof(::milvus::grpc::AttrRecord)},
+  { 340, -1, sizeof(::milvus::grpc::HEntity)},
+  { 352, -1, sizeof(::milvus::grpc::HQueryResult)},
+  { 363, -1, sizeof(::milvus::grpc::HInsertParam)},
+  { 373, -1, sizeof(::milvus::grpc::HEntityIdentity)},
+  { 380, -1, sizeof(::milvus::grpc::HEntityIDs)},
+  { 387, -1, sizeof(::milvus::grpc::HGetEntityIDsParam)},
+  { 394, -1, sizeof(::milvus::grpc::HDeleteByIDParam)},
+  { 401, -1, sizeof(::milvus::grpc::HIndexParam)},
 };
 
 static ::PROTOBUF_NAMESPACE_ID::Message const * const file_default_instances[] = {
@@ -1570,195 +1571,196 @@ const char descriptor_table_protodef_milvus_2eproto[] PROTOBUF_SECTION_VARIABLE(
   "k\030\004 \001(\003\022/\n\014extra_params\030\005 \003(\0132\031.milvus.g"
   "rpc.KeyValuePair\"H\n\023ReLoadSegmentsParam\022"
   "\027\n\017collection_name\030\001 \001(\t\022\030\n\020segment_id_a"
-  "rray\030\002 \003(\t\"g\n\017TopKQueryResult\022#\n\006status\030"
+  "rray\030\002 \003(\t\"u\n\017TopKQueryResult\022#\n\006status\030"
   "\001 \001(\0132\023.milvus.grpc.Status\022\017\n\007row_num\030\002 "
-  "\001(\003\022\013\n\003ids\030\003 \003(\003\022\021\n\tdistances\030\004 \003(\002\"H\n\013S"
-  "tringReply\022#\n\006status\030\001 \001(\0132\023.milvus.grpc"
-  ".Status\022\024\n\014string_reply\030\002 \001(\t\"D\n\tBoolRep"
-  "ly\022#\n\006status\030\001 \001(\0132\023.milvus.grpc.Status\022"
-  "\022\n\nbool_reply\030\002 \001(\010\"W\n\022CollectionRowCoun"
-  "t\022#\n\006status\030\001 \001(\0132\023.milvus.grpc.Status\022\034"
-  "\n\024collection_row_count\030\002 \001(\003\"\026\n\007Command\022"
-  "\013\n\003cmd\030\001 \001(\t\"\217\001\n\nIndexParam\022#\n\006status\030\001 "
-  "\001(\0132\023.milvus.grpc.Status\022\027\n\017collection_n"
-  "ame\030\002 \001(\t\022\022\n\nindex_type\030\003 \001(\005\022/\n\014extra_p"
-  "arams\030\004 \003(\0132\031.milvus.grpc.KeyValuePair\"+"
-  "\n\nFlushParam\022\035\n\025collection_name_array\030\001 "
-  "\003(\t\"<\n\017DeleteByIDParam\022\027\n\017collection_nam"
-  "e\030\001 \001(\t\022\020\n\010id_array\030\002 \003(\003\"H\n\016CollectionI"
-  "nfo\022#\n\006status\030\001 \001(\0132\023.milvus.grpc.Status"
-  "\022\021\n\tjson_info\030\002 \001(\t\"<\n\017VectorsIdentity\022\027"
-  "\n\017collection_name\030\001 \001(\t\022\020\n\010id_array\030\002 \003("
-  "\003\"`\n\013VectorsData\022#\n\006status\030\001 \001(\0132\023.milvu"
-  "s.grpc.Status\022,\n\014vectors_data\030\002 \003(\0132\026.mi"
-  "lvus.grpc.RowRecord\"B\n\021GetVectorIDsParam"
-  "\022\027\n\017collection_name\030\001 \001(\t\022\024\n\014segment_nam"
-  "e\030\002 \001(\t\"%\n\020VectorFieldParam\022\021\n\tdimension"
-  "\030\001 \001(\003\"w\n\tFieldType\022*\n\tdata_type\030\001 \001(\0162\025"
-  ".milvus.grpc.DataTypeH\000\0225\n\014vector_param\030"
-  "\002 \001(\0132\035.milvus.grpc.VectorFieldParamH\000B\007"
-  "\n\005value\"}\n\nFieldParam\022\n\n\002id\030\001 \001(\004\022\014\n\004nam"
-  "e\030\002 \001(\t\022$\n\004type\030\003 \001(\0132\026.milvus.grpc.Fiel"
-  "dType\022/\n\014extra_params\030\004 \003(\0132\031.milvus.grp"
-  "c.KeyValuePair\":\n\021VectorFieldRecord\022%\n\005v"
-  "alue\030\001 \003(\0132\026.milvus.grpc.RowRecord\"\252\001\n\nF"
-  "ieldValue\022\025\n\013int64_value\030\001 \001(\003H\000\022\026\n\014doub"
-  "le_value\030\002 \001(\001H\000\022\026\n\014string_value\030\003 \001(\tH\000"
-  "\022\024\n\nbool_value\030\004 \001(\010H\000\0226\n\014vector_value\030\005"
-  " \001(\0132\036.milvus.grpc.VectorFieldRecordH\000B\007"
-  "\n\005value\"\207\001\n\007Mapping\022#\n\006status\030\001 \001(\0132\023.mi"
-  "lvus.grpc.Status\022\025\n\rcollection_id\030\002 \001(\004\022"
-  "\027\n\017collection_name\030\003 \001(\t\022\'\n\006fields\030\004 \003(\013"
-  "2\027.milvus.grpc.FieldParam\"^\n\013MappingList"
-  "\022#\n\006status\030\001 \001(\0132\023.milvus.grpc.Status\022*\n"
-  "\014mapping_list\030\002 \003(\0132\024.milvus.grpc.Mappin"
-  "g\"\233\001\n\tTermQuery\022\022\n\nfield_name\030\001 \001(\t\022\021\n\ti"
-  "nt_value\030\002 \003(\003\022\024\n\014double_value\030\003 \003(\001\022\021\n\t"
-  "value_num\030\004 \001(\003\022\r\n\005boost\030\005 \001(\002\022/\n\014extra_"
-  "params\030\006 \003(\0132\031.milvus.grpc.KeyValuePair\""
-  "N\n\013CompareExpr\022.\n\010operator\030\001 \001(\0162\034.milvu"
-  "s.grpc.CompareOperator\022\017\n\007operand\030\002 \001(\t\""
-  "\213\001\n\nRangeQuery\022\022\n\nfield_name\030\001 \001(\t\022)\n\007op"
-  "erand\030\002 \003(\0132\030.milvus.grpc.CompareExpr\022\r\n"
-  "\005boost\030\003 \001(\002\022/\n\014extra_params\030\004 \003(\0132\031.mil"
-  "vus.grpc.KeyValuePair\"\236\001\n\013VectorQuery\022\022\n"
-  "\nfield_name\030\001 \001(\t\022\023\n\013query_boost\030\002 \001(\002\022\'"
-  "\n\007records\030\003 \003(\0132\026.milvus.grpc.RowRecord\022"
-  "\014\n\004topk\030\004 \001(\003\022/\n\014extra_params\030\005 \003(\0132\031.mi"
-  "lvus.grpc.KeyValuePair\"c\n\014BooleanQuery\022!"
-  "\n\005occur\030\001 \001(\0162\022.milvus.grpc.Occur\0220\n\rgen"
-  "eral_query\030\002 \003(\0132\031.milvus.grpc.GeneralQu"
-  "ery\"\333\001\n\014GeneralQuery\0222\n\rboolean_query\030\001 "
-  "\001(\0132\031.milvus.grpc.BooleanQueryH\000\022,\n\nterm"
-  "_query\030\002 \001(\0132\026.milvus.grpc.TermQueryH\000\022."
-  "\n\013range_query\030\003 \001(\0132\027.milvus.grpc.RangeQ"
-  "ueryH\000\0220\n\014vector_query\030\004 \001(\0132\030.milvus.gr"
-  "pc.VectorQueryH\000B\007\n\005query\"G\n\013VectorParam"
-  "\022\014\n\004json\030\001 \001(\t\022*\n\nrow_record\030\002 \003(\0132\026.mil"
-  "vus.grpc.RowRecord\"\262\001\n\014HSearchParam\022\027\n\017c"
-  "ollection_name\030\001 \001(\t\022\033\n\023partition_tag_ar"
-  "ray\030\002 \003(\t\022.\n\014vector_param\030\003 \003(\0132\030.milvus"
-  ".grpc.VectorParam\022\013\n\003dsl\030\004 \001(\t\022/\n\014extra_"
-  "params\030\005 \003(\0132\031.milvus.grpc.KeyValuePair\""
-  "\251\001\n\016HSearchParamPB\022\027\n\017collection_name\030\001 "
-  "\001(\t\022\033\n\023partition_tag_array\030\002 \003(\t\0220\n\rgene"
-  "ral_query\030\003 \001(\0132\031.milvus.grpc.GeneralQue"
-  "ry\022/\n\014extra_params\030\004 \003(\0132\031.milvus.grpc.K"
-  "eyValuePair\"e\n\026HSearchInSegmentsParam\022\030\n"
-  "\020segment_id_array\030\001 \003(\t\0221\n\014search_param\030"
-  "\002 \001(\0132\033.milvus.grpc.HSearchParamPB\"5\n\nAt"
-  "trRecord\022\021\n\tint_value\030\001 \003(\003\022\024\n\014double_va"
-  "lue\030\002 \003(\001\"\363\001\n\007HEntity\022#\n\006status\030\001 \001(\0132\023."
-  "milvus.grpc.Status\022\021\n\tentity_id\030\002 \003(\003\022\023\n"
-  "\013field_names\030\003 \003(\t\022)\n\ndata_types\030\004 \003(\0162\025"
-  ".milvus.grpc.DataType\022\017\n\007row_num\030\005 \001(\003\022*"
-  "\n\tattr_data\030\006 \003(\0132\027.milvus.grpc.AttrReco"
-  "rd\0223\n\013vector_data\030\007 \003(\0132\036.milvus.grpc.Ve"
-  "ctorFieldRecord\"\274\001\n\014HQueryResult\022#\n\006stat"
-  "us\030\001 \001(\0132\023.milvus.grpc.Status\022$\n\006entity\030"
-  "\002 \001(\0132\024.milvus.grpc.HEntity\022\017\n\007row_num\030\003"
-  " \001(\003\022\r\n\005score\030\004 \003(\002\022\020\n\010distance\030\005 \003(\002\022/\n"
-  "\014extra_params\030\006 \003(\0132\031.milvus.grpc.KeyVal"
-  "uePair\"\256\001\n\014HInsertParam\022\027\n\017collection_na"
-  "me\030\001 \001(\t\022\025\n\rpartition_tag\030\002 \001(\t\022$\n\006entit"
-  "y\030\003 \001(\0132\024.milvus.grpc.HEntity\022\027\n\017entity_"
-  "id_array\030\004 \003(\003\022/\n\014extra_params\030\005 \003(\0132\031.m"
-  "ilvus.grpc.KeyValuePair\"6\n\017HEntityIdenti"
-  "ty\022\027\n\017collection_name\030\001 \001(\t\022\n\n\002id\030\002 \003(\003\""
-  "J\n\nHEntityIDs\022#\n\006status\030\001 \001(\0132\023.milvus.g"
-  "rpc.Status\022\027\n\017entity_id_array\030\002 \003(\003\"C\n\022H"
-  "GetEntityIDsParam\022\027\n\017collection_name\030\001 \001"
-  "(\t\022\024\n\014segment_name\030\002 \001(\t\"=\n\020HDeleteByIDP"
-  "aram\022\027\n\017collection_name\030\001 \001(\t\022\020\n\010id_arra"
-  "y\030\002 \003(\003\"\221\001\n\013HIndexParam\022#\n\006status\030\001 \001(\0132"
-  "\023.milvus.grpc.Status\022\027\n\017collection_name\030"
-  "\002 \001(\t\022\023\n\013field_names\030\003 \003(\t\022/\n\014extra_para"
-  "ms\030\004 \003(\0132\031.milvus.grpc.KeyValuePair*\206\001\n\010"
-  "DataType\022\010\n\004NULL\020\000\022\010\n\004INT8\020\001\022\t\n\005INT16\020\002\022"
-  "\t\n\005INT32\020\003\022\t\n\005INT64\020\004\022\n\n\006STRING\020\024\022\010\n\004BOO"
-  "L\020\036\022\t\n\005FLOAT\020(\022\n\n\006DOUBLE\020)\022\n\n\006VECTOR\020d\022\014"
-  "\n\007UNKNOWN\020\217N*C\n\017CompareOperator\022\006\n\002LT\020\000\022"
-  "\007\n\003LTE\020\001\022\006\n\002EQ\020\002\022\006\n\002GT\020\003\022\007\n\003GTE\020\004\022\006\n\002NE\020"
-  "\005*8\n\005Occur\022\013\n\007INVALID\020\000\022\010\n\004MUST\020\001\022\n\n\006SHO"
-  "ULD\020\002\022\014\n\010MUST_NOT\020\0032\256\030\n\rMilvusService\022H\n"
-  "\020CreateCollection\022\035.milvus.grpc.Collecti"
-  "onSchema\032\023.milvus.grpc.Status\"\000\022F\n\rHasCo"
-  "llection\022\033.milvus.grpc.CollectionName\032\026."
-  "milvus.grpc.BoolReply\"\000\022R\n\022DescribeColle"
-  "ction\022\033.milvus.grpc.CollectionName\032\035.mil"
-  "vus.grpc.CollectionSchema\"\000\022Q\n\017CountColl"
-  "ection\022\033.milvus.grpc.CollectionName\032\037.mi"
-  "lvus.grpc.CollectionRowCount\"\000\022J\n\017ShowCo"
-  "llections\022\024.milvus.grpc.Command\032\037.milvus"
-  ".grpc.CollectionNameList\"\000\022P\n\022ShowCollec"
-  "tionInfo\022\033.milvus.grpc.CollectionName\032\033."
-  "milvus.grpc.CollectionInfo\"\000\022D\n\016DropColl"
-  "ection\022\033.milvus.grpc.CollectionName\032\023.mi"
-  "lvus.grpc.Status\"\000\022=\n\013CreateIndex\022\027.milv"
-  "us.grpc.IndexParam\032\023.milvus.grpc.Status\""
-  "\000\022G\n\rDescribeIndex\022\033.milvus.grpc.Collect"
-  "ionName\032\027.milvus.grpc.IndexParam\"\000\022\?\n\tDr"
-  "opIndex\022\033.milvus.grpc.CollectionName\032\023.m"
-  "ilvus.grpc.Status\"\000\022E\n\017CreatePartition\022\033"
-  ".milvus.grpc.PartitionParam\032\023.milvus.grp"
-  "c.Status\"\000\022E\n\014HasPartition\022\033.milvus.grpc"
-  ".PartitionParam\032\026.milvus.grpc.BoolReply\""
-  "\000\022K\n\016ShowPartitions\022\033.milvus.grpc.Collec"
-  "tionName\032\032.milvus.grpc.PartitionList\"\000\022C"
-  "\n\rDropPartition\022\033.milvus.grpc.PartitionP"
-  "aram\032\023.milvus.grpc.Status\"\000\022<\n\006Insert\022\030."
-  "milvus.grpc.InsertParam\032\026.milvus.grpc.Ve"
-  "ctorIds\"\000\022J\n\016GetVectorsByID\022\034.milvus.grp"
-  "c.VectorsIdentity\032\030.milvus.grpc.VectorsD"
-  "ata\"\000\022H\n\014GetVectorIDs\022\036.milvus.grpc.GetV"
-  "ectorIDsParam\032\026.milvus.grpc.VectorIds\"\000\022"
-  "B\n\006Search\022\030.milvus.grpc.SearchParam\032\034.mi"
-  "lvus.grpc.TopKQueryResult\"\000\022J\n\nSearchByI"
-  "D\022\034.milvus.grpc.SearchByIDParam\032\034.milvus"
-  ".grpc.TopKQueryResult\"\000\022P\n\rSearchInFiles"
-  "\022\037.milvus.grpc.SearchInFilesParam\032\034.milv"
-  "us.grpc.TopKQueryResult\"\000\0227\n\003Cmd\022\024.milvu"
-  "s.grpc.Command\032\030.milvus.grpc.StringReply"
-  "\"\000\022A\n\nDeleteByID\022\034.milvus.grpc.DeleteByI"
-  "DParam\032\023.milvus.grpc.Status\"\000\022G\n\021Preload"
-  "Collection\022\033.milvus.grpc.CollectionName\032"
-  "\023.milvus.grpc.Status\"\000\022I\n\016ReloadSegments"
-  "\022 .milvus.grpc.ReLoadSegmentsParam\032\023.mil"
-  "vus.grpc.Status\"\000\0227\n\005Flush\022\027.milvus.grpc"
-  ".FlushParam\032\023.milvus.grpc.Status\"\000\022=\n\007Co"
-  "mpact\022\033.milvus.grpc.CollectionName\032\023.mil"
-  "vus.grpc.Status\"\000\022E\n\026CreateHybridCollect"
-  "ion\022\024.milvus.grpc.Mapping\032\023.milvus.grpc."
-  "Status\"\000\022L\n\023HasHybridCollection\022\033.milvus"
-  ".grpc.CollectionName\032\026.milvus.grpc.BoolR"
-  "eply\"\000\022J\n\024DropHybridCollection\022\033.milvus."
-  "grpc.CollectionName\032\023.milvus.grpc.Status"
-  "\"\000\022O\n\030DescribeHybridCollection\022\033.milvus."
-  "grpc.CollectionName\032\024.milvus.grpc.Mappin"
-  "g\"\000\022W\n\025CountHybridCollection\022\033.milvus.gr"
-  "pc.CollectionName\032\037.milvus.grpc.Collecti"
-  "onRowCount\"\000\022I\n\025ShowHybridCollections\022\024."
-  "milvus.grpc.Command\032\030.milvus.grpc.Mappin"
-  "gList\"\000\022V\n\030ShowHybridCollectionInfo\022\033.mi"
-  "lvus.grpc.CollectionName\032\033.milvus.grpc.C"
-  "ollectionInfo\"\000\022M\n\027PreloadHybridCollecti"
-  "on\022\033.milvus.grpc.CollectionName\032\023.milvus"
-  ".grpc.Status\"\000\022D\n\021CreateHybridIndex\022\030.mi"
-  "lvus.grpc.HIndexParam\032\023.milvus.grpc.Stat"
-  "us\"\000\022D\n\014InsertEntity\022\031.milvus.grpc.HInse"
-  "rtParam\032\027.milvus.grpc.HEntityIDs\"\000\022J\n\016Hy"
-  "bridSearchPB\022\033.milvus.grpc.HSearchParamP"
-  "B\032\031.milvus.grpc.HQueryResult\"\000\022F\n\014Hybrid"
-  "Search\022\031.milvus.grpc.HSearchParam\032\031.milv"
-  "us.grpc.HQueryResult\"\000\022]\n\026HybridSearchIn"
-  "Segments\022#.milvus.grpc.HSearchInSegments"
-  "Param\032\034.milvus.grpc.TopKQueryResult\"\000\022E\n"
-  "\rGetEntityByID\022\034.milvus.grpc.VectorsIden"
-  "tity\032\024.milvus.grpc.HEntity\"\000\022J\n\014GetEntit"
-  "yIDs\022\037.milvus.grpc.HGetEntityIDsParam\032\027."
-  "milvus.grpc.HEntityIDs\"\000\022J\n\022DeleteEntiti"
-  "esByID\022\035.milvus.grpc.HDeleteByIDParam\032\023."
-  "milvus.grpc.Status\"\000b\006proto3"
+  "\001(\003\022\013\n\003ids\030\003 \003(\003\022\021\n\tdistances\030\004 \003(\002\022\014\n\004l"
+  "ims\030\005 \003(\003\"H\n\013StringReply\022#\n\006status\030\001 \001(\013"
+  "2\023.milvus.grpc.Status\022\024\n\014string_reply\030\002 "
+  "\001(\t\"D\n\tBoolReply\022#\n\006status\030\001 \001(\0132\023.milvu"
+  "s.grpc.Status\022\022\n\nbool_reply\030\002 \001(\010\"W\n\022Col"
+  "lectionRowCount\022#\n\006status\030\001 \001(\0132\023.milvus"
+  ".grpc.Status\022\034\n\024collection_row_count\030\002 \001"
+  "(\003\"\026\n\007Command\022\013\n\003cmd\030\001 \001(\t\"\217\001\n\nIndexPara"
+  "m\022#\n\006status\030\001 \001(\0132\023.milvus.grpc.Status\022\027"
+  "\n\017collection_name\030\002 \001(\t\022\022\n\nindex_type\030\003 "
+  "\001(\005\022/\n\014extra_params\030\004 \003(\0132\031.milvus.grpc."
+  "KeyValuePair\"+\n\nFlushParam\022\035\n\025collection"
+  "_name_array\030\001 \003(\t\"<\n\017DeleteByIDParam\022\027\n\017"
+  "collection_name\030\001 \001(\t\022\020\n\010id_array\030\002 \003(\003\""
+  "H\n\016CollectionInfo\022#\n\006status\030\001 \001(\0132\023.milv"
+  "us.grpc.Status\022\021\n\tjson_info\030\002 \001(\t\"<\n\017Vec"
+  "torsIdentity\022\027\n\017collection_name\030\001 \001(\t\022\020\n"
+  "\010id_array\030\002 \003(\003\"`\n\013VectorsData\022#\n\006status"
+  "\030\001 \001(\0132\023.milvus.grpc.Status\022,\n\014vectors_d"
+  "ata\030\002 \003(\0132\026.milvus.grpc.RowRecord\"B\n\021Get"
+  "VectorIDsParam\022\027\n\017collection_name\030\001 \001(\t\022"
+  "\024\n\014segment_name\030\002 \001(\t\"%\n\020VectorFieldPara"
+  "m\022\021\n\tdimension\030\001 \001(\003\"w\n\tFieldType\022*\n\tdat"
+  "a_type\030\001 \001(\0162\025.milvus.grpc.DataTypeH\000\0225\n"
+  "\014vector_param\030\002 \001(\0132\035.milvus.grpc.Vector"
+  "FieldParamH\000B\007\n\005value\"}\n\nFieldParam\022\n\n\002i"
+  "d\030\001 \001(\004\022\014\n\004name\030\002 \001(\t\022$\n\004type\030\003 \001(\0132\026.mi"
+  "lvus.grpc.FieldType\022/\n\014extra_params\030\004 \003("
+  "\0132\031.milvus.grpc.KeyValuePair\":\n\021VectorFi"
+  "eldRecord\022%\n\005value\030\001 \003(\0132\026.milvus.grpc.R"
+  "owRecord\"\252\001\n\nFieldValue\022\025\n\013int64_value\030\001"
+  " \001(\003H\000\022\026\n\014double_value\030\002 \001(\001H\000\022\026\n\014string"
+  "_value\030\003 \001(\tH\000\022\024\n\nbool_value\030\004 \001(\010H\000\0226\n\014"
+  "vector_value\030\005 \001(\0132\036.milvus.grpc.VectorF"
+  "ieldRecordH\000B\007\n\005value\"\207\001\n\007Mapping\022#\n\006sta"
+  "tus\030\001 \001(\0132\023.milvus.grpc.Status\022\025\n\rcollec"
+  "tion_id\030\002 \001(\004\022\027\n\017collection_name\030\003 \001(\t\022\'"
+  "\n\006fields\030\004 \003(\0132\027.milvus.grpc.FieldParam\""
+  "^\n\013MappingList\022#\n\006status\030\001 \001(\0132\023.milvus."
+  "grpc.Status\022*\n\014mapping_list\030\002 \003(\0132\024.milv"
+  "us.grpc.Mapping\"\233\001\n\tTermQuery\022\022\n\nfield_n"
+  "ame\030\001 \001(\t\022\021\n\tint_value\030\002 \003(\003\022\024\n\014double_v"
+  "alue\030\003 \003(\001\022\021\n\tvalue_num\030\004 \001(\003\022\r\n\005boost\030\005"
+  " \001(\002\022/\n\014extra_params\030\006 \003(\0132\031.milvus.grpc"
+  ".KeyValuePair\"N\n\013CompareExpr\022.\n\010operator"
+  "\030\001 \001(\0162\034.milvus.grpc.CompareOperator\022\017\n\007"
+  "operand\030\002 \001(\t\"\213\001\n\nRangeQuery\022\022\n\nfield_na"
+  "me\030\001 \001(\t\022)\n\007operand\030\002 \003(\0132\030.milvus.grpc."
+  "CompareExpr\022\r\n\005boost\030\003 \001(\002\022/\n\014extra_para"
+  "ms\030\004 \003(\0132\031.milvus.grpc.KeyValuePair\"\236\001\n\013"
+  "VectorQuery\022\022\n\nfield_name\030\001 \001(\t\022\023\n\013query"
+  "_boost\030\002 \001(\002\022\'\n\007records\030\003 \003(\0132\026.milvus.g"
+  "rpc.RowRecord\022\014\n\004topk\030\004 \001(\003\022/\n\014extra_par"
+  "ams\030\005 \003(\0132\031.milvus.grpc.KeyValuePair\"c\n\014"
+  "BooleanQuery\022!\n\005occur\030\001 \001(\0162\022.milvus.grp"
+  "c.Occur\0220\n\rgeneral_query\030\002 \003(\0132\031.milvus."
+  "grpc.GeneralQuery\"\333\001\n\014GeneralQuery\0222\n\rbo"
+  "olean_query\030\001 \001(\0132\031.milvus.grpc.BooleanQ"
+  "ueryH\000\022,\n\nterm_query\030\002 \001(\0132\026.milvus.grpc"
+  ".TermQueryH\000\022.\n\013range_query\030\003 \001(\0132\027.milv"
+  "us.grpc.RangeQueryH\000\0220\n\014vector_query\030\004 \001"
+  "(\0132\030.milvus.grpc.VectorQueryH\000B\007\n\005query\""
+  "G\n\013VectorParam\022\014\n\004json\030\001 \001(\t\022*\n\nrow_reco"
+  "rd\030\002 \003(\0132\026.milvus.grpc.RowRecord\"\262\001\n\014HSe"
+  "archParam\022\027\n\017collection_name\030\001 \001(\t\022\033\n\023pa"
+  "rtition_tag_array\030\002 \003(\t\022.\n\014vector_param\030"
+  "\003 \003(\0132\030.milvus.grpc.VectorParam\022\013\n\003dsl\030\004"
+  " \001(\t\022/\n\014extra_params\030\005 \003(\0132\031.milvus.grpc"
+  ".KeyValuePair\"\251\001\n\016HSearchParamPB\022\027\n\017coll"
+  "ection_name\030\001 \001(\t\022\033\n\023partition_tag_array"
+  "\030\002 \003(\t\0220\n\rgeneral_query\030\003 \001(\0132\031.milvus.g"
+  "rpc.GeneralQuery\022/\n\014extra_params\030\004 \003(\0132\031"
+  ".milvus.grpc.KeyValuePair\"e\n\026HSearchInSe"
+  "gmentsParam\022\030\n\020segment_id_array\030\001 \003(\t\0221\n"
+  "\014search_param\030\002 \001(\0132\033.milvus.grpc.HSearc"
+  "hParamPB\"5\n\nAttrRecord\022\021\n\tint_value\030\001 \003("
+  "\003\022\024\n\014double_value\030\002 \003(\001\"\363\001\n\007HEntity\022#\n\006s"
+  "tatus\030\001 \001(\0132\023.milvus.grpc.Status\022\021\n\tenti"
+  "ty_id\030\002 \003(\003\022\023\n\013field_names\030\003 \003(\t\022)\n\ndata"
+  "_types\030\004 \003(\0162\025.milvus.grpc.DataType\022\017\n\007r"
+  "ow_num\030\005 \001(\003\022*\n\tattr_data\030\006 \003(\0132\027.milvus"
+  ".grpc.AttrRecord\0223\n\013vector_data\030\007 \003(\0132\036."
+  "milvus.grpc.VectorFieldRecord\"\274\001\n\014HQuery"
+  "Result\022#\n\006status\030\001 \001(\0132\023.milvus.grpc.Sta"
+  "tus\022$\n\006entity\030\002 \001(\0132\024.milvus.grpc.HEntit"
+  "y\022\017\n\007row_num\030\003 \001(\003\022\r\n\005score\030\004 \003(\002\022\020\n\010dis"
+  "tance\030\005 \003(\002\022/\n\014extra_params\030\006 \003(\0132\031.milv"
+  "us.grpc.KeyValuePair\"\256\001\n\014HInsertParam\022\027\n"
+  "\017collection_name\030\001 \001(\t\022\025\n\rpartition_tag\030"
+  "\002 \001(\t\022$\n\006entity\030\003 \001(\0132\024.milvus.grpc.HEnt"
+  "ity\022\027\n\017entity_id_array\030\004 \003(\003\022/\n\014extra_pa"
+  "rams\030\005 \003(\0132\031.milvus.grpc.KeyValuePair\"6\n"
+  "\017HEntityIdentity\022\027\n\017collection_name\030\001 \001("
+  "\t\022\n\n\002id\030\002 \003(\003\"J\n\nHEntityIDs\022#\n\006status\030\001 "
+  "\001(\0132\023.milvus.grpc.Status\022\027\n\017entity_id_ar"
+  "ray\030\002 \003(\003\"C\n\022HGetEntityIDsParam\022\027\n\017colle"
+  "ction_name\030\001 \001(\t\022\024\n\014segment_name\030\002 \001(\t\"="
+  "\n\020HDeleteByIDParam\022\027\n\017collection_name\030\001 "
+  "\001(\t\022\020\n\010id_array\030\002 \003(\003\"\221\001\n\013HIndexParam\022#\n"
+  "\006status\030\001 \001(\0132\023.milvus.grpc.Status\022\027\n\017co"
+  "llection_name\030\002 \001(\t\022\023\n\013field_names\030\003 \003(\t"
+  "\022/\n\014extra_params\030\004 \003(\0132\031.milvus.grpc.Key"
+  "ValuePair*\206\001\n\010DataType\022\010\n\004NULL\020\000\022\010\n\004INT8"
+  "\020\001\022\t\n\005INT16\020\002\022\t\n\005INT32\020\003\022\t\n\005INT64\020\004\022\n\n\006S"
+  "TRING\020\024\022\010\n\004BOOL\020\036\022\t\n\005FLOAT\020(\022\n\n\006DOUBLE\020)"
+  "\022\n\n\006VECTOR\020d\022\014\n\007UNKNOWN\020\217N*C\n\017CompareOpe"
+  "rator\022\006\n\002LT\020\000\022\007\n\003LTE\020\001\022\006\n\002EQ\020\002\022\006\n\002GT\020\003\022\007"
+  "\n\003GTE\020\004\022\006\n\002NE\020\005*8\n\005Occur\022\013\n\007INVALID\020\000\022\010\n"
+  "\004MUST\020\001\022\n\n\006SHOULD\020\002\022\014\n\010MUST_NOT\020\0032\256\030\n\rMi"
+  "lvusService\022H\n\020CreateCollection\022\035.milvus"
+  ".grpc.CollectionSchema\032\023.milvus.grpc.Sta"
+  "tus\"\000\022F\n\rHasCollection\022\033.milvus.grpc.Col"
+  "lectionName\032\026.milvus.grpc.BoolReply\"\000\022R\n"
+  "\022DescribeCollection\022\033.milvus.grpc.Collec"
+  "tionName\032\035.milvus.grpc.CollectionSchema\""
+  "\000\022Q\n\017CountCollection\022\033.milvus.grpc.Colle"
+  "ctionName\032\037.milvus.grpc.CollectionRowCou"
+  "nt\"\000\022J\n\017ShowCollections\022\024.milvus.grpc.Co"
+  "mmand\032\037.milvus.grpc.CollectionNameList\"\000"
+  "\022P\n\022ShowCollectionInfo\022\033.milvus.grpc.Col"
+  "lectionName\032\033.milvus.grpc.CollectionInfo"
+  "\"\000\022D\n\016DropCollection\022\033.milvus.grpc.Colle"
+  "ctionName\032\023.milvus.grpc.Status\"\000\022=\n\013Crea"
+  "teIndex\022\027.milvus.grpc.IndexParam\032\023.milvu"
+  "s.grpc.Status\"\000\022G\n\rDescribeIndex\022\033.milvu"
+  "s.grpc.CollectionName\032\027.milvus.grpc.Inde"
+  "xParam\"\000\022\?\n\tDropIndex\022\033.milvus.grpc.Coll"
+  "ectionName\032\023.milvus.grpc.Status\"\000\022E\n\017Cre"
+  "atePartition\022\033.milvus.grpc.PartitionPara"
+  "m\032\023.milvus.grpc.Status\"\000\022E\n\014HasPartition"
+  "\022\033.milvus.grpc.PartitionParam\032\026.milvus.g"
+  "rpc.BoolReply\"\000\022K\n\016ShowPartitions\022\033.milv"
+  "us.grpc.CollectionName\032\032.milvus.grpc.Par"
+  "titionList\"\000\022C\n\rDropPartition\022\033.milvus.g"
+  "rpc.PartitionParam\032\023.milvus.grpc.Status\""
+  "\000\022<\n\006Insert\022\030.milvus.grpc.InsertParam\032\026."
+  "milvus.grpc.VectorIds\"\000\022J\n\016GetVectorsByI"
+  "D\022\034.milvus.grpc.VectorsIdentity\032\030.milvus"
+  ".grpc.VectorsData\"\000\022H\n\014GetVectorIDs\022\036.mi"
+  "lvus.grpc.GetVectorIDsParam\032\026.milvus.grp"
+  "c.VectorIds\"\000\022B\n\006Search\022\030.milvus.grpc.Se"
+  "archParam\032\034.milvus.grpc.TopKQueryResult\""
+  "\000\022J\n\nSearchByID\022\034.milvus.grpc.SearchByID"
+  "Param\032\034.milvus.grpc.TopKQueryResult\"\000\022P\n"
+  "\rSearchInFiles\022\037.milvus.grpc.SearchInFil"
+  "esParam\032\034.milvus.grpc.TopKQueryResult\"\000\022"
+  "7\n\003Cmd\022\024.milvus.grpc.Command\032\030.milvus.gr"
+  "pc.StringReply\"\000\022A\n\nDeleteByID\022\034.milvus."
+  "grpc.DeleteByIDParam\032\023.milvus.grpc.Statu"
+  "s\"\000\022G\n\021PreloadCollection\022\033.milvus.grpc.C"
+  "ollectionName\032\023.milvus.grpc.Status\"\000\022I\n\016"
+  "ReloadSegments\022 .milvus.grpc.ReLoadSegme"
+  "ntsParam\032\023.milvus.grpc.Status\"\000\0227\n\005Flush"
+  "\022\027.milvus.grpc.FlushParam\032\023.milvus.grpc."
+  "Status\"\000\022=\n\007Compact\022\033.milvus.grpc.Collec"
+  "tionName\032\023.milvus.grpc.Status\"\000\022E\n\026Creat"
+  "eHybridCollection\022\024.milvus.grpc.Mapping\032"
+  "\023.milvus.grpc.Status\"\000\022L\n\023HasHybridColle"
+  "ction\022\033.milvus.grpc.CollectionName\032\026.mil"
+  "vus.grpc.BoolReply\"\000\022J\n\024DropHybridCollec"
+  "tion\022\033.milvus.grpc.CollectionName\032\023.milv"
+  "us.grpc.Status\"\000\022O\n\030DescribeHybridCollec"
+  "tion\022\033.milvus.grpc.CollectionName\032\024.milv"
+  "us.grpc.Mapping\"\000\022W\n\025CountHybridCollecti"
+  "on\022\033.milvus.grpc.CollectionName\032\037.milvus"
+  ".grpc.CollectionRowCount\"\000\022I\n\025ShowHybrid"
+  "Collections\022\024.milvus.grpc.Command\032\030.milv"
+  "us.grpc.MappingList\"\000\022V\n\030ShowHybridColle"
+  "ctionInfo\022\033.milvus.grpc.CollectionName\032\033"
+  ".milvus.grpc.CollectionInfo\"\000\022M\n\027Preload"
+  "HybridCollection\022\033.milvus.grpc.Collectio"
+  "nName\032\023.milvus.grpc.Status\"\000\022D\n\021CreateHy"
+  "bridIndex\022\030.milvus.grpc.HIndexParam\032\023.mi"
+  "lvus.grpc.Status\"\000\022D\n\014InsertEntity\022\031.mil"
+  "vus.grpc.HInsertParam\032\027.milvus.grpc.HEnt"
+  "ityIDs\"\000\022J\n\016HybridSearchPB\022\033.milvus.grpc"
+  ".HSearchParamPB\032\031.milvus.grpc.HQueryResu"
+  "lt\"\000\022F\n\014HybridSearch\022\031.milvus.grpc.HSear"
+  "chParam\032\031.milvus.grpc.HQueryResult\"\000\022]\n\026"
+  "HybridSearchInSegments\022#.milvus.grpc.HSe"
+  "archInSegmentsParam\032\034.milvus.grpc.TopKQu"
+  "eryResult\"\000\022E\n\rGetEntityByID\022\034.milvus.gr"
+  "pc.VectorsIdentity\032\024.milvus.grpc.HEntity"
+  "\"\000\022J\n\014GetEntityIDs\022\037.milvus.grpc.HGetEnt"
+  "ityIDsParam\032\027.milvus.grpc.HEntityIDs\"\000\022J"
+  "\n\022DeleteEntitiesByID\022\035.milvus.grpc.HDele"
+  "teByIDParam\032\023.milvus.grpc.Status\"\000b\006prot"
+  "o3"
   ;
 static const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable*const descriptor_table_milvus_2eproto_deps[1] = {
   &::descriptor_table_status_2eproto,
@@ -1818,7 +1820,7 @@ static ::PROTOBUF_NAMESPACE_ID::internal::SCCInfoBase*const descriptor_table_mil
 static ::PROTOBUF_NAMESPACE_ID::internal::once_flag descriptor_table_milvus_2eproto_once;
 static bool descriptor_table_milvus_2eproto_initialized = false;
 const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable descriptor_table_milvus_2eproto = {
-  &descriptor_table_milvus_2eproto_initialized, descriptor_table_protodef_milvus_2eproto, "milvus.proto", 8908,
+  &descriptor_table_milvus_2eproto_initialized, descriptor_table_protodef_milvus_2eproto, "milvus.proto", 8922,
   &descriptor_table_milvus_2eproto_once, descriptor_table_milvus_2eproto_sccs, descriptor_table_milvus_2eproto_deps, 50, 1,
   schemas, file_default_instances, TableStruct_milvus_2eproto::offsets,
   file_level_metadata_milvus_2eproto, 51, file_level_enum_descriptors_milvus_2eproto, file_level_service_descriptors_milvus_2eproto,
@@ -6845,7 +6847,8 @@ TopKQueryResult::TopKQueryResult(const TopKQueryResult& from)
   : ::PROTOBUF_NAMESPACE_ID::Message(),
       _internal_metadata_(nullptr),
       ids_(from.ids_),
-      distances_(from.distances_) {
+      distances_(from.distances_),
+      lims_(from.lims_) {
   _internal_metadata_.MergeFrom(from._internal_metadata_);
   if (from.has_status()) {
     status_ = new ::milvus::grpc::Status(*from.status_);
@@ -6889,6 +6892,7 @@ void TopKQueryResult::Clear() {
 
   ids_.Clear();
   distances_.Clear();
+  lims_.Clear();
   if (GetArenaNoVirtual() == nullptr && status_ != nullptr) {
     delete status_;
   }
@@ -6939,6 +6943,16 @@ const char* TopKQueryResult::_InternalParse(const char* ptr, ::PROTOBUF_NAMESPAC
           ptr += sizeof(float);
         } else goto handle_unusual;
         continue;
+      // repeated int64 lims = 5;
+      case 5:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 42)) {
+          ptr = ::PROTOBUF_NAMESPACE_ID::internal::PackedInt64Parser(mutable_lims(), ptr, ctx);
+          CHK_(ptr);
+        } else if (static_cast<::PROTOBUF_NAMESPACE_ID::uint8>(tag) == 40) {
+          add_lims(::PROTOBUF_NAMESPACE_ID::internal::ReadVarint(&ptr));
+          CHK_(ptr);
+        } else goto handle_unusual;
+        continue;
       default: {
       handle_unusual:
         if ((tag & 7) == 4 || tag == 0) {
@@ -7025,6 +7039,22 @@ bool TopKQueryResult::MergePartialFromCodedStream(
         break;
       }
 
+      // repeated int64 lims = 5;
+      case 5: {
+        if (static_cast< ::PROTOBUF_NAMESPACE_ID::uint8>(tag) == (42 & 0xFF)) {
+          DO_((::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::ReadPackedPrimitive<
+                   ::PROTOBUF_NAMESPACE_ID::int64, ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::TYPE_INT64>(
+                 input, this->mutable_lims())));
+        } else if (static_cast< ::PROTOBUF_NAMESPACE_ID::uint8>(tag) == (40 & 0xFF)) {
+          DO_((::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::ReadRepeatedPrimitiveNoInline<
+                   ::PROTOBUF_NAMESPACE_ID::int64, ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::TYPE_INT64>(
+                 1, 42u, input, this->mutable_lims())));
+        } else {
+          goto handle_unusual;
+        }
+        break;
+      }
+
       default: {
       handle_unusual:
         if (tag == 0) {
@@ -7083,6 +7113,17 @@ void TopKQueryResult::SerializeWithCachedSizes(
       this->distances().data(), this->distances_size(), output);
   }
 
+  // repeated int64 lims = 5;
+  if (this->lims_size() > 0) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteTag(5, ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WIRETYPE_LENGTH_DELIMITED, output);
+    output->WriteVarint32(_lims_cached_byte_size_.load(
+        std::memory_order_relaxed));
+  }
+  for (int i = 0, n = this->lims_size(); i < n; i++) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteInt64NoTag(
+      this->lims(i), output);
+  }
+
   if (_internal_metadata_.have_unknown_fields()) {
     ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::SerializeUnknownFields(
         _internal_metadata_.unknown_fields(), output);
@@ -7134,6 +7175,19 @@ void TopKQueryResult::SerializeWithCachedSizes(
       WriteFloatNoTagToArray(this->distances_, target);
   }
 
+  // repeated int64 lims = 5;
+  if (this->lims_size() > 0) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WriteTagToArray(
+      5,
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::WIRETYPE_LENGTH_DELIMITED,
+      target);
+    target = ::PROTOBUF_NAMESPACE_ID::io::CodedOutputStream::WriteVarint32ToArray(
+        _lims_cached_byte_size_.load(std::memory_order_relaxed),
+         target);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      WriteInt64NoTagToArray(this->lims_, target);
+  }
+
   if (_internal_metadata_.have_unknown_fields()) {
     target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::SerializeUnknownFieldsToArray(
         _internal_metadata_.unknown_fields(), target);
@@ -7185,6 +7239,21 @@ size_t TopKQueryResult::ByteSizeLong() const {
     total_size += data_size;
   }
 
+  // repeated int64 lims = 5;
+  {
+    size_t data_size = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      Int64Size(this->lims_);
+    if (data_size > 0) {
+      total_size += 1 +
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::Int32Size(
+            static_cast<::PROTOBUF_NAMESPACE_ID::int32>(data_size));
+    }
+    int cached_size = ::PROTOBUF_NAMESPACE_ID::internal::ToCachedSize(data_size);
+    _lims_cached_byte_size_.store(cached_size,
+                                    std::memory_order_relaxed);
+    total_size += data_size;
+  }
+
   // .milvus.grpc.Status status = 1;
   if (this->has_status()) {
     total_size += 1 +
@@ -7228,6 +7297,7 @@ void TopKQueryResult::MergeFrom(const TopKQueryResult& from) {
 
   ids_.MergeFrom(from.ids_);
   distances_.MergeFrom(from.distances_);
+  lims_.MergeFrom(from.lims_);
   if (from.has_status()) {
     mutable_status()->::milvus::grpc::Status::MergeFrom(from.status());
   }
@@ -7259,6 +7329,7 @@ void TopKQueryResult::InternalSwap(TopKQueryResult* other) {
   _internal_metadata_.Swap(&other->_internal_metadata_);
   ids_.InternalSwap(&other->ids_);
   distances_.InternalSwap(&other->distances_);
+  lims_.InternalSwap(&other->lims_);
   swap(status_, other->status_);
   swap(row_num_, other->row_num_);
 }
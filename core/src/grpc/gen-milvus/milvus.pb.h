@@ -2577,6 +2577,7 @@ class TopKQueryResult :
   enum : int {
     kIdsFieldNumber = 3,
     kDistancesFieldNumber = 4,
+    kLimsFieldNumber = 5,
     kStatusFieldNumber = 1,
     kRowNumFieldNumber = 2,
   };
@@ -2602,6 +2603,17 @@ class TopKQueryResult :
   ::PROTOBUF_NAMESPACE_ID::RepeatedField< float >*
       mutable_distances();
 
+  // repeated int64 lims = 5;
+  int lims_size() const;
+  void clear_lims();
+  ::PROTOBUF_NAMESPACE_ID::int64 lims(int index) const;
+  void set_lims(int index, ::PROTOBUF_NAMESPACE_ID::int64 value);
+  void add_lims(::PROTOBUF_NAMESPACE_ID::int64 value);
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< ::PROTOBUF_NAMESPACE_ID::int64 >&
+      lims() const;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< ::PROTOBUF_NAMESPACE_ID::int64 >*
+      mutable_lims();
+
   // .milvus.grpc.Status status = 1;
   bool has_status() const;
   void clear_status();
@@ -2624,6 +2636,8 @@ class TopKQueryResult :
   mutable std::atomic<int> _ids_cached_byte_size_;
   ::PROTOBUF_NAMESPACE_ID::RepeatedField< float > distances_;
   mutable std::atomic<int> _distances_cached_byte_size_;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< ::PROTOBUF_NAMESPACE_ID::int64 > lims_;
+  mutable std::atomic<int> _lims_cached_byte_size_;
   ::milvus::grpc::Status* status_;
   ::PROTOBUF_NAMESPACE_ID::int64 row_num_;
   mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
@@ -10363,6 +10377,36 @@ TopKQueryResult::mutable_distances() {
   return &distances_;
 }
 
+// repeated int64 lims = 5;
+inline int TopKQueryResult::lims_size() const {
+  return lims_.size();
+}
+inline void TopKQueryResult::clear_lims() {
+  lims_.Clear();
+}
+inline ::PROTOBUF_NAMESPACE_ID::int64 TopKQueryResult::lims(int index) const {
+  // @@protoc_insertion_point(field_get:milvus.grpc.TopKQueryResult.lims)
+  return lims_.Get(index);
+}
+inline void TopKQueryResult::set_lims(int index, ::PROTOBUF_NAMESPACE_ID::int64 value) {
+  lims_.Set(index, value);
+  // @@protoc_insertion_point(field_set:milvus.grpc.TopKQueryResult.lims)
+}
+inline void TopKQueryResult::add_lims(::PROTOBUF_NAMESPACE_ID::int64 value) {
+  lims_.Add(value);
+  // @@protoc_insertion_point(field_add:milvus.grpc.TopKQueryResult.lims)
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< ::PROTOBUF_NAMESPACE_ID::int64 >&
+TopKQueryResult::lims() const {
+  // @@protoc_insertion_point(field_list:milvus.grpc.TopKQueryResult.lims)
+  return lims_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< ::PROTOBUF_NAMESPACE_ID::int64 >*
+TopKQueryResult::mutable_lims() {
+  // @@protoc_insertion_point(field_mutable_list:milvus.grpc.TopKQueryResult.lims)
+  return &lims_;
+}
+
 // -------------------------------------------------------------------
 
 // StringReply
@@ -190,6 +190,42 @@ IVFPQConfAdapter::GetValidMList(int64_t dimension, std::vector<int64_t>& resset)
     }
 }
 
+bool
+IVFPQFastScanConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
+    static int64_t DEFAULT_NBITS = 4;
+    static int64_t MIN_REFINE_FACTOR = 1;
+    static int64_t MAX_REFINE_FACTOR = 32;
+    static std::vector<std::string> METRICS{knowhere::Metric::L2, knowhere::Metric::IP};
+
+    oricfg[knowhere::IndexParams::nbits] = DEFAULT_NBITS;
+
+    CheckStrByValues(knowhere::Metric::TYPE, METRICS);
+    CheckIntByRange(knowhere::meta::DIM, DEFAULT_MIN_DIM, DEFAULT_MAX_DIM);
+    if (oricfg.contains(knowhere::IndexParams::refine_factor)) {
+        CheckIntByRange(knowhere::IndexParams::refine_factor, MIN_REFINE_FACTOR, MAX_REFINE_FACTOR);
+    }
+
+    std::vector<int64_t> resset;
+    int64_t dimension = oricfg[knowhere::meta::DIM].get<int64_t>();
+    IVFPQConfAdapter::GetValidMList(dimension, resset);
+
+    CheckIntByValues(knowhere::IndexParams::m, resset);
+
+    return IVFConfAdapter::CheckTrain(oricfg, mode);
+}
+
+bool
+IVFPQFastScanConfAdapter::CheckSearch(Config& oricfg, const IndexType type, const IndexMode mode) {
+    static int64_t MIN_REFINE_FACTOR = 1;
+    static int64_t MAX_REFINE_FACTOR = 32;
+
+    if (oricfg.contains(knowhere::IndexParams::refine_factor)) {
+        CheckIntByRange(knowhere::IndexParams::refine_factor, MIN_REFINE_FACTOR, MAX_REFINE_FACTOR);
+    }
+
+    return IVFConfAdapter::CheckSearch(oricfg, type, mode);
+}
+
 bool
 NSGConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
     static int64_t MIN_KNNG = 5;
@@ -201,6 +237,7 @@ NSGConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
     static int64_t MIN_CANDIDATE_POOL_SIZE = 50;
     static int64_t MAX_CANDIDATE_POOL_SIZE = 1000;
     static std::vector<std::string> METRICS{knowhere::Metric::L2, knowhere::Metric::IP};
+    static std::vector<std::string> KNNG_BUILDERS{knowhere::KnngBuilder::IVF, knowhere::KnngBuilder::NN_DESCENT};
 
     CheckStrByValues(knowhere::Metric::TYPE, METRICS);
     CheckIntByRange(knowhere::meta::ROWS, DEFAULT_MIN_ROWS, DEFAULT_MAX_ROWS);
@@ -208,6 +245,9 @@ NSGConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
     CheckIntByRange(knowhere::IndexParams::search_length, MIN_SEARCH_LENGTH, MAX_SEARCH_LENGTH);
     CheckIntByRange(knowhere::IndexParams::out_degree, MIN_OUT_DEGREE, MAX_OUT_DEGREE);
     CheckIntByRange(knowhere::IndexParams::candidate, MIN_CANDIDATE_POOL_SIZE, MAX_CANDIDATE_POOL_SIZE);
+    if (oricfg.contains(knowhere::IndexParams::knng_builder)) {
+        CheckStrByValues(knowhere::IndexParams::knng_builder, KNNG_BUILDERS);
+    }
 
     // auto tune params
     oricfg[knowhere::IndexParams::nlist] = MatchNlist(oricfg[knowhere::meta::ROWS].get<int64_t>(), 8192);
@@ -251,6 +291,50 @@ HNSWConfAdapter::CheckSearch(Config& oricfg, const IndexType type, const IndexMo
     return ConfAdapter::CheckSearch(oricfg, type, mode);
 }
 
+bool
+HNSWSQ8ConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
+    static int64_t MIN_REFINE_FACTOR = 1;
+    static int64_t MAX_REFINE_FACTOR = 32;
+    static std::vector<std::string> METRICS{knowhere::Metric::L2, knowhere::Metric::IP};
+
+    CheckStrByValues(knowhere::Metric::TYPE, METRICS);
+    if (oricfg.contains(knowhere::IndexParams::refine_factor)) {
+        CheckIntByRange(knowhere::IndexParams::refine_factor, MIN_REFINE_FACTOR, MAX_REFINE_FACTOR);
+    }
+
+    return HNSWConfAdapter::CheckTrain(oricfg, mode);
+}
+
+bool
+HNSWSQ8ConfAdapter::CheckSearch(Config& oricfg, const IndexType type, const IndexMode mode) {
+    static int64_t MIN_REFINE_FACTOR = 1;
+    static int64_t MAX_REFINE_FACTOR = 32;
+
+    if (oricfg.contains(knowhere::IndexParams::refine_factor)) {
+        CheckIntByRange(knowhere::IndexParams::refine_factor, MIN_REFINE_FACTOR, MAX_REFINE_FACTOR);
+    }
+
+    return HNSWConfAdapter::CheckSearch(oricfg, type, mode);
+}
+
+bool
+BinHNSWConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
+    static int64_t MIN_EFCONSTRUCTION = 8;
+    static int64_t MAX_EFCONSTRUCTION = 512;
+    static int64_t MIN_M = 4;
+    static int64_t MAX_M = 64;
+    static std::vector<std::string> METRICS{knowhere::Metric::HAMMING, knowhere::Metric::JACCARD,
+                                            knowhere::Metric::TANIMOTO};
+
+    CheckIntByRange(knowhere::meta::ROWS, DEFAULT_MIN_ROWS, DEFAULT_MAX_ROWS);
+    CheckIntByRange(knowhere::meta::DIM, DEFAULT_MIN_DIM, DEFAULT_MAX_DIM);
+    CheckStrByValues(knowhere::Metric::TYPE, METRICS);
+    CheckIntByRange(knowhere::IndexParams::efConstruction, MIN_EFCONSTRUCTION, MAX_EFCONSTRUCTION);
+    CheckIntByRange(knowhere::IndexParams::M, MIN_M, MAX_M);
+
+    return true;
+}
+
 bool
 BinIDMAPConfAdapter::CheckTrain(Config& oricfg, const IndexMode mode) {
     static std::vector<std::string> METRICS{knowhere::Metric::HAMMING, knowhere::Metric::JACCARD,
@@ -55,6 +55,15 @@ class IVFPQConfAdapter : public IVFConfAdapter {
     GetValidMList(int64_t dimension, std::vector<int64_t>& resset);
 };
 
+class IVFPQFastScanConfAdapter : public IVFConfAdapter {
+ public:
+    bool
+    CheckTrain(Config& oricfg, const IndexMode mode) override;
+
+    bool
+    CheckSearch(Config& oricfg, const IndexType type, const IndexMode mode) override;
+};
+
 class NSGConfAdapter : public IVFConfAdapter {
  public:
     bool
@@ -85,6 +94,21 @@ class HNSWConfAdapter : public ConfAdapter {
     CheckSearch(Config& oricfg, const IndexType type, const IndexMode mode) override;
 };
 
+class HNSWSQ8ConfAdapter : public HNSWConfAdapter {
+ public:
+    bool
+    CheckTrain(Config& oricfg, const IndexMode mode) override;
+
+    bool
+    CheckSearch(Config& oricfg, const IndexType type, const IndexMode mode) override;
+};
+
+class BinHNSWConfAdapter : public HNSWConfAdapter {
+ public:
+    bool
+    CheckTrain(Config& oricfg, const IndexMode mode) override;
+};
+
 class ANNOYConfAdapter : public ConfAdapter {
  public:
     bool
@@ -0,0 +1,184 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "knowhere/index/vector_index/IndexBinaryHNSW.h"
+
+#include <cmath>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "faiss/BuilderSuspend.h"
+#include "hnswlib/hnswalg.h"
+#include "hnswlib/space_binary.h"
+#include "knowhere/common/Exception.h"
+#include "knowhere/common/Log.h"
+#include "knowhere/index/vector_index/adapter/VectorAdapter.h"
+#include "knowhere/index/vector_index/helpers/FaissIO.h"
+
+namespace milvus {
+namespace knowhere {
+
+namespace {
+constexpr size_t TANIMOTO_METRIC_TYPE = 4;  // hnswlib::TanimotoSpace
+}
+
+BinarySet
+BinaryHNSW::Serialize(const Config& config) {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize or trained");
+    }
+
+    try {
+        MemoryIOWriter writer;
+        index_->saveIndex(writer);
+        std::shared_ptr<uint8_t[]> data(writer.data_);
+
+        BinarySet res_set;
+        res_set.Append("BIN_HNSW", data, writer.rp);
+        return res_set;
+    } catch (std::exception& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    }
+}
+
+void
+BinaryHNSW::Load(const BinarySet& index_binary) {
+    try {
+        auto binary = index_binary.GetByName("BIN_HNSW");
+
+        MemoryIOReader reader;
+        reader.total = binary->size;
+        reader.data_ = binary->data.get();
+
+        hnswlib::SpaceInterface<float>* space = nullptr;
+        index_ = std::make_shared<hnswlib::HierarchicalNSW<float>>(space);
+        index_->loadIndex(reader);
+    } catch (std::exception& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    }
+}
+
+void
+BinaryHNSW::Train(const DatasetPtr& dataset_ptr, const Config& config) {
+    try {
+        GETTENSOR(dataset_ptr)
+
+        hnswlib::SpaceInterface<float>* space;
+        if (config[Metric::TYPE] == Metric::HAMMING) {
+            space = new hnswlib::HammingSpace(dim);
+        } else if (config[Metric::TYPE] == Metric::JACCARD) {
+            space = new hnswlib::JaccardSpace(dim);
+        } else if (config[Metric::TYPE] == Metric::TANIMOTO) {
+            space = new hnswlib::TanimotoSpace(dim);
+        } else {
+            KNOWHERE_THROW_MSG("Metric type not supported by BIN_HNSW");
+        }
+        index_ = std::make_shared<hnswlib::HierarchicalNSW<float>>(space, rows, config[IndexParams::M].get<int64_t>(),
+                                                                   config[IndexParams::efConstruction].get<int64_t>());
+    } catch (std::exception& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    }
+}
+
+void
+BinaryHNSW::Add(const DatasetPtr& dataset_ptr, const Config& config) {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+
+    std::lock_guard<std::mutex> lk(mutex_);
+
+    GETTENSORWITHIDS(dataset_ptr)
+
+    auto code_size = Dim() / 8;
+    index_->addPoint(p_data, p_ids[0]);
+#pragma omp parallel for
+    for (int i = 1; i < rows; ++i) {
+        faiss::BuilderSuspend::check_wait();
+        index_->addPoint(((const uint8_t*)p_data + code_size * i), p_ids[i]);
+    }
+}
+
+DatasetPtr
+BinaryHNSW::Query(const DatasetPtr& dataset_ptr, const Config& config) {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize or trained");
+    }
+    GETTENSOR(dataset_ptr)
+
+    size_t k = config[meta::TOPK].get<int64_t>();
+    auto code_size = Dim() / 8;
+    auto p_id = (int64_t*)malloc(sizeof(int64_t) * k * rows);
+    auto p_dist = (float*)malloc(sizeof(float) * k * rows);
+
+    index_->setEf(config[IndexParams::ef]);
+
+    using P = std::pair<float, int64_t>;
+    auto compare = [](const P& v1, const P& v2) { return v1.first < v2.first; };
+    bool tanimoto = index_->metric_type_ == TANIMOTO_METRIC_TYPE;
+
+    faiss::ConcurrentBitsetPtr blacklist = GetBlacklist();
+#pragma omp parallel for
+    for (unsigned int i = 0; i < rows; ++i) {
+        const uint8_t* single_query = (const uint8_t*)p_data + i * code_size;
+        auto ret = index_->searchKnn(single_query, k, compare, blacklist);
+
+        for (size_t j = 0; j < k; ++j) {
+            if (j < ret.size()) {
+                // the graph is walked on the jaccard distance, tanimoto is reported like binary flat and IVF do
+                p_dist[i * k + j] = tanimoto ? -std::log2(1 - ret[j].first) : ret[j].first;
+                p_id[i * k + j] = ret[j].second;
+            } else {
+                p_dist[i * k + j] = -1;
+                p_id[i * k + j] = -1;
+            }
+        }
+    }
+
+    auto ret_ds = std::make_shared<Dataset>();
+    ret_ds->Set(meta::IDS, p_id);
+    ret_ds->Set(meta::DISTANCE, p_dist);
+    return ret_ds;
+}
+
+int64_t
+BinaryHNSW::Count() {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+    return index_->cur_element_count;
+}
+
+int64_t
+BinaryHNSW::Dim() {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+    return (*(size_t*)index_->dist_func_param_);
+}
+
+bool
+BinaryHNSW::GetVectorByOffset(int64_t offset, uint8_t* data) {
+    if (!index_) {
+        return false;
+    }
+    // the engine builds the graph with the offsets as labels
+    auto iter = index_->label_lookup_.find(offset);
+    if (iter == index_->label_lookup_.end()) {
+        return false;
+    }
+    memcpy(data, index_->getDataByInternalId(iter->second), Dim() / 8);
+    return true;
+}
+
+}  // namespace knowhere
+}  // namespace milvus
@@ -15,6 +15,7 @@
 #include <faiss/MetaIndexes.h>
 #include <faiss/index_factory.h>
 
+#include <cstring>
 #include <string>
 
 #include "knowhere/common/Exception.h"
@@ -160,6 +161,16 @@ BinaryIDMAP::GetRawVectors() {
     }
 }
 
+bool
+BinaryIDMAP::GetVectorByOffset(int64_t offset, uint8_t* data) {
+    if (!index_ || offset < 0 || offset >= Count()) {
+        return false;
+    }
+    auto code_size = Dim() / 8;
+    memcpy(data, GetRawVectors() + offset * code_size, code_size);
+    return true;
+}
+
 const int64_t*
 BinaryIDMAP::GetRawIds() {
     try {
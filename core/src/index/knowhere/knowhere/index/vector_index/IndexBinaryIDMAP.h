@@ -71,6 +71,9 @@ class BinaryIDMAP : public VecIndex, public FaissBaseBinaryIndex {
     GetVectorById(const DatasetPtr& dataset_ptr, const Config& config) override;
 #endif
 
+    bool
+    GetVectorByOffset(int64_t offset, uint8_t* data) override;
+
     virtual const uint8_t*
     GetRawVectors();
 
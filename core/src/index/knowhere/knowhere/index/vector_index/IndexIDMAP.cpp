@@ -16,11 +16,13 @@
 #include <faiss/MetaIndexes.h>
 #include <faiss/clone_index.h>
 #include <faiss/index_factory.h>
+#include <faiss/impl/AuxIndexStructures.h>
 #include <faiss/index_io.h>
 #ifdef MILVUS_GPU_VERSION
 #include <faiss/gpu/GpuCloner.h>
 #endif
 
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -113,6 +115,21 @@ IDMAP::Query(const DatasetPtr& dataset_ptr, const Config& config) {
     return ret_ds;
 }
 
+DatasetPtr
+IDMAP::QueryByRange(const DatasetPtr& dataset_ptr, const Config& config) {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+    GETTENSOR(dataset_ptr)
+
+    float radius = config[IndexParams::radius].get<float>();
+    faiss::RangeSearchResult res(rows);
+    index_->range_search(rows, (float*)p_data, radius, &res, bitset_);
+
+    return GenRangeResultDataset(rows, res.lims, res.labels, res.distances,
+                                 index_->metric_type != faiss::METRIC_INNER_PRODUCT);
+}
+
 #if 0
 DatasetPtr
 IDMAP::QueryById(const DatasetPtr& dataset_ptr, const Config& config) {
@@ -187,6 +204,16 @@ IDMAP::GetRawVectors() {
     }
 }
 
+bool
+IDMAP::GetVectorByOffset(int64_t offset, uint8_t* data) {
+    if (!index_ || offset < 0 || offset >= Count()) {
+        return false;
+    }
+    auto dim = Dim();
+    memcpy(data, GetRawVectors() + offset * dim, dim * sizeof(float));
+    return true;
+}
+
 const int64_t*
 IDMAP::GetRawIds() {
     try {
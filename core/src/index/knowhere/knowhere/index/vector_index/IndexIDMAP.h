@@ -48,6 +48,9 @@ class IDMAP : public VecIndex, public FaissBaseIndex {
     DatasetPtr
     Query(const DatasetPtr&, const Config&) override;
 
+    DatasetPtr
+    QueryByRange(const DatasetPtr&, const Config&) override;
+
 #if 0
     DatasetPtr
     QueryById(const DatasetPtr& dataset, const Config& config) override;
@@ -69,6 +72,9 @@ class IDMAP : public VecIndex, public FaissBaseIndex {
     GetVectorById(const DatasetPtr& dataset, const Config& config) override;
 #endif
 
+    bool
+    GetVectorByOffset(int64_t offset, uint8_t* data) override;
+
     VecIndexPtr
     CopyCpuToGpu(const int64_t, const Config&);
 
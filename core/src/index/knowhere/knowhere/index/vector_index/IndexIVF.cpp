@@ -17,6 +17,7 @@
 #include <faiss/IndexIVFPQ.h>
 #include <faiss/clone_index.h>
 #include <faiss/index_factory.h>
+#include <faiss/impl/AuxIndexStructures.h>
 #include <faiss/index_io.h>
 #ifdef MILVUS_GPU_VERSION
 #include <faiss/gpu/GpuAutoTune.h>
@@ -142,6 +143,33 @@ IVF::Query(const DatasetPtr& dataset_ptr, const Config& config) {
     }
 }
 
+DatasetPtr
+IVF::QueryByRange(const DatasetPtr& dataset_ptr, const Config& config) {
+    if (!index_ || !index_->is_trained) {
+        KNOWHERE_THROW_MSG("index not initialize or trained");
+    }
+
+    GETTENSOR(dataset_ptr)
+
+    try {
+        auto params = GenParams(config);
+        auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_.get());
+        ivf_index->nprobe = params->nprobe;
+        ivf_index->parallel_mode = (params->nprobe > 1 && rows <= 4) ? 1 : 0;
+
+        float radius = config[IndexParams::radius].get<float>();
+        faiss::RangeSearchResult res(rows);
+        ivf_index->range_search(rows, (float*)p_data, radius, &res, bitset_);
+
+        return GenRangeResultDataset(rows, res.lims, res.labels, res.distances,
+                                     ivf_index->metric_type != faiss::METRIC_INNER_PRODUCT);
+    } catch (faiss::FaissException& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    } catch (std::exception& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    }
+}
+
 #if 0
 DatasetPtr
 IVF::QueryById(const DatasetPtr& dataset_ptr, const Config& config) {
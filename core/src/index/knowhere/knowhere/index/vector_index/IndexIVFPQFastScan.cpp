@@ -0,0 +1,411 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "knowhere/index/vector_index/IndexIVFPQFastScan.h"
+
+#include <faiss/FaissHook.h>
+#include <faiss/IndexFlat.h>
+#include <faiss/index_io.h>
+#include <faiss/utils/Heap.h>
+#include <faiss/utils/pq4_fast_scan.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "faiss/BuilderSuspend.h"
+#include "knowhere/common/Exception.h"
+#include "knowhere/common/Log.h"
+#include "knowhere/index/vector_index/adapter/VectorAdapter.h"
+#include "knowhere/index/vector_index/helpers/FaissIO.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
+
+namespace milvus {
+namespace knowhere {
+
+namespace {
+constexpr int64_t PQ4_NBITS = 4;
+constexpr int64_t PQ4_KSUB = 16;
+constexpr int64_t PQ4_MAX_M = 256;  // M * 255 must fit the uint16 accumulators
+}  // namespace
+
+BinarySet
+IVFPQFastScan::Serialize(const Config& config) {
+    if (!index_ || !index_->is_trained) {
+        KNOWHERE_THROW_MSG("index not initialize or trained");
+    }
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    try {
+        MemoryIOWriter quantizer_writer;
+        faiss::write_index(index_.get(), &quantizer_writer);
+        std::shared_ptr<uint8_t[]> quantizer_data(quantizer_writer.data_);
+
+        MemoryIOWriter writer;
+        int64_t nlist = list_ids_.size();
+        writer(&refine_factor_, sizeof(refine_factor_), 1);
+        writer(&nlist, sizeof(nlist), 1);
+        for (int64_t i = 0; i < nlist; ++i) {
+            int64_t list_size = list_ids_[i].size();
+            int64_t codes_size = list_codes_[i].size();
+            writer(&list_size, sizeof(list_size), 1);
+            writer(&codes_size, sizeof(codes_size), 1);
+            writer(list_ids_[i].data(), sizeof(int64_t), list_size);
+            writer(list_codes_[i].data(), sizeof(uint8_t), codes_size);
+        }
+        std::shared_ptr<uint8_t[]> data(writer.data_);
+
+        BinarySet res_set;
+        res_set.Append("IVF", quantizer_data, quantizer_writer.rp);
+        res_set.Append("FASTSCAN", data, writer.rp);
+        return res_set;
+    } catch (std::exception& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    }
+}
+
+void
+IVFPQFastScan::Load(const BinarySet& binary_set) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    try {
+        auto quantizer_binary = binary_set.GetByName("IVF");
+        MemoryIOReader quantizer_reader;
+        quantizer_reader.total = quantizer_binary->size;
+        quantizer_reader.data_ = quantizer_binary->data.get();
+        auto ivfpq = dynamic_cast<faiss::IndexIVFPQ*>(faiss::read_index(&quantizer_reader));
+        if (ivfpq == nullptr) {
+            KNOWHERE_THROW_MSG("Load Error, binary is not an IVFPQ index");
+        }
+        index_.reset(ivfpq);
+
+        auto binary = binary_set.GetByName("FASTSCAN");
+        MemoryIOReader reader;
+        reader.total = binary->size;
+        reader.data_ = binary->data.get();
+
+        int64_t nlist = 0;
+        reader(&refine_factor_, sizeof(refine_factor_), 1);
+        reader(&nlist, sizeof(nlist), 1);
+        list_ids_.resize(nlist);
+        list_codes_.resize(nlist);
+        for (int64_t i = 0; i < nlist; ++i) {
+            int64_t list_size = 0;
+            int64_t codes_size = 0;
+            reader(&list_size, sizeof(list_size), 1);
+            reader(&codes_size, sizeof(codes_size), 1);
+            list_ids_[i].resize(list_size);
+            list_codes_[i].resize(codes_size);
+            reader(list_ids_[i].data(), sizeof(int64_t), list_size);
+            reader(list_codes_[i].data(), sizeof(uint8_t), codes_size);
+        }
+
+        // raw vectors are optional, they are only used to re-rank the candidates
+        auto raw_iter = binary_set.binary_map_.find(RAW_DATA);
+        if (raw_iter != binary_set.binary_map_.end()) {
+            raw_data_ = raw_iter->second->data;
+            raw_rows_ = raw_iter->second->size / (index_->d * sizeof(float));
+        } else {
+            raw_data_ = nullptr;
+            raw_rows_ = 0;
+        }
+    } catch (std::exception& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    }
+}
+
+void
+IVFPQFastScan::Train(const DatasetPtr& dataset_ptr, const Config& config) {
+    GETTENSOR(dataset_ptr)
+
+    int64_t m = config[IndexParams::m].get<int64_t>();
+    if (m > PQ4_MAX_M) {
+        KNOWHERE_THROW_MSG("Train Error, m should not be larger than " + std::to_string(PQ4_MAX_M));
+    }
+    if (config.contains(IndexParams::refine_factor)) {
+        refine_factor_ = config[IndexParams::refine_factor].get<int64_t>();
+    }
+
+    auto metric_type = GetMetricType(config[Metric::TYPE].get<std::string>());
+    faiss::Index* coarse_quantizer = new faiss::IndexFlat(dim, metric_type);
+    auto index = std::make_shared<faiss::IndexIVFPQ>(coarse_quantizer, dim, config[IndexParams::nlist].get<int64_t>(),
+                                                     m, PQ4_NBITS, metric_type);
+    index->own_fields = true;
+    index->train(rows, (float*)p_data);
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    index_ = index;
+    list_ids_.assign(index_->nlist, std::vector<int64_t>());
+    list_codes_.assign(index_->nlist, std::vector<uint8_t>());
+}
+
+void
+IVFPQFastScan::Add(const DatasetPtr& dataset_ptr, const Config& config) {
+    if (!index_ || !index_->is_trained) {
+        KNOWHERE_THROW_MSG("index not initialize or trained");
+    }
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    GETTENSORWITHIDS(dataset_ptr)
+    AddCodes(rows, (const float*)p_data, p_ids);
+}
+
+void
+IVFPQFastScan::AddWithoutIds(const DatasetPtr& dataset_ptr, const Config& config) {
+    if (!index_ || !index_->is_trained) {
+        KNOWHERE_THROW_MSG("index not initialize or trained");
+    }
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    GETTENSOR(dataset_ptr)
+
+    std::vector<int64_t> ids(rows);
+    int64_t ntotal = 0;
+    for (auto& list : list_ids_) {
+        ntotal += list.size();
+    }
+    for (int64_t i = 0; i < rows; ++i) {
+        ids[i] = ntotal + i;
+    }
+    AddCodes(rows, (const float*)p_data, ids.data());
+}
+
+void
+IVFPQFastScan::AddCodes(int64_t rows, const float* data, const int64_t* ids) {
+    size_t M = index_->pq.M;
+    size_t code_size = index_->code_size;
+    size_t block_bytes = faiss::pq4_block_bytes(M);
+
+    std::vector<faiss::Index::idx_t> assign(rows);
+    std::vector<uint8_t> codes(rows * code_size);
+    index_->quantizer->assign(rows, data, assign.data());
+    index_->encode_vectors(rows, data, assign.data(), codes.data());
+
+    // faiss packs 4-bit codes two per byte, sub-quantizer 2i in the low nibble
+    std::vector<uint8_t> unpacked(M);
+    for (int64_t i = 0; i < rows; ++i) {
+        faiss::BuilderSuspend::check_wait();
+        auto list_no = assign[i];
+        if (list_no < 0) {
+            continue;
+        }
+
+        const uint8_t* code = codes.data() + i * code_size;
+        for (size_t m = 0; m < M; ++m) {
+            unpacked[m] = (code[m >> 1] >> ((m & 1) * 4)) & 15;
+        }
+
+        auto& list_ids = list_ids_[list_no];
+        auto& list_codes = list_codes_[list_no];
+        size_t offset = list_ids.size();
+        if (offset % faiss::PQ4_BLOCK_SIZE == 0) {
+            list_codes.resize(list_codes.size() + block_bytes, 0);
+        }
+        uint8_t* block = list_codes.data() + (offset / faiss::PQ4_BLOCK_SIZE) * block_bytes;
+        faiss::pq4_set_block_code(M, block, offset % faiss::PQ4_BLOCK_SIZE, unpacked.data());
+        list_ids.push_back(ids[i]);
+    }
+}
+
+DatasetPtr
+IVFPQFastScan::Query(const DatasetPtr& dataset_ptr, const Config& config) {
+    if (!index_ || !index_->is_trained) {
+        KNOWHERE_THROW_MSG("index not initialize or trained");
+    }
+
+    GETTENSOR(dataset_ptr)
+
+    try {
+        int64_t k = config[meta::TOPK].get<int64_t>();
+        auto elems = rows * k;
+
+        size_t p_id_size = sizeof(int64_t) * elems;
+        size_t p_dist_size = sizeof(float) * elems;
+        auto p_id = (int64_t*)malloc(p_id_size);
+        auto p_dist = (float*)malloc(p_dist_size);
+
+        QueryImpl(rows, (const float*)p_data, k, p_dist, p_id, config);
+
+        auto ret_ds = std::make_shared<Dataset>();
+        ret_ds->Set(meta::IDS, p_id);
+        ret_ds->Set(meta::DISTANCE, p_dist);
+        return ret_ds;
+    } catch (faiss::FaissException& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    } catch (std::exception& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    }
+}
+
+void
+IVFPQFastScan::QueryImpl(int64_t n, const float* data, int64_t k, float* distances, int64_t* labels,
+                         const Config& config) {
+    int64_t nprobe = std::min<int64_t>(config[IndexParams::nprobe].get<int64_t>(), index_->nlist);
+    int64_t refine_factor = refine_factor_;
+    if (config.contains(IndexParams::refine_factor)) {
+        refine_factor = config[IndexParams::refine_factor].get<int64_t>();
+    }
+    bool refine = raw_data_ != nullptr && refine_factor > 1;
+    int64_t k_scan = refine ? k * refine_factor : k;
+
+    std::vector<float> coarse_dis(n * nprobe);
+    std::vector<faiss::Index::idx_t> coarse_ids(n * nprobe);
+    index_->quantizer->search(n, data, nprobe, coarse_dis.data(), coarse_ids.data());
+
+    const auto& pq = index_->pq;
+    size_t M = pq.M;
+    size_t dim = index_->d;
+    size_t block_bytes = faiss::pq4_block_bytes(M);
+    bool is_ip = index_->metric_type == faiss::METRIC_INNER_PRODUCT;
+    faiss::ConcurrentBitsetPtr blacklist = GetBlacklist();
+
+#pragma omp parallel for
+    for (int64_t i = 0; i < n; ++i) {
+        const float* query = data + i * dim;
+        std::vector<float> heap_dis(k_scan);
+        std::vector<int64_t> heap_ids(k_scan);
+        faiss::maxheap_heapify(k_scan, heap_dis.data(), heap_ids.data());
+
+        std::vector<float> residual(dim);
+        std::vector<float> table(M * PQ4_KSUB);
+        std::vector<uint8_t> lut(M * PQ4_KSUB);
+        uint16_t acc[faiss::PQ4_BLOCK_SIZE];
+
+        // every distance below is "smaller is better", inner products are negated
+        if (is_ip) {
+            pq.compute_inner_prod_table(query, table.data());
+            for (auto& t : table) {
+                t = -t;
+            }
+        }
+
+        for (int64_t p = 0; p < nprobe; ++p) {
+            auto list_no = coarse_ids[i * nprobe + p];
+            if (list_no < 0 || list_ids_[list_no].empty()) {
+                continue;
+            }
+
+            float offset = 0;
+            if (is_ip) {
+                offset = -coarse_dis[i * nprobe + p];
+            } else {
+                index_->quantizer->compute_residual(query, residual.data(), list_no);
+                pq.compute_distance_table(residual.data(), table.data());
+            }
+
+            // quantize the table of this list to uint8, one scale shared by all sub-quantizers
+            float max_span = 0;
+            for (size_t m = 0; m < M; ++m) {
+                auto range = std::minmax_element(table.begin() + m * PQ4_KSUB, table.begin() + (m + 1) * PQ4_KSUB);
+                offset += *range.first;
+                max_span = std::max(max_span, *range.second - *range.first);
+            }
+            float scale = max_span > 0 ? 255.0f / max_span : 0.0f;
+            float inv_scale = max_span > 0 ? max_span / 255.0f : 0.0f;
+            for (size_t m = 0; m < M; ++m) {
+                float min_m = *std::min_element(table.begin() + m * PQ4_KSUB, table.begin() + (m + 1) * PQ4_KSUB);
+                for (size_t c = 0; c < PQ4_KSUB; ++c) {
+                    lut[m * PQ4_KSUB + c] = (uint8_t)std::lround((table[m * PQ4_KSUB + c] - min_m) * scale);
+                }
+            }
+
+            const auto& ids = list_ids_[list_no];
+            const uint8_t* codes = list_codes_[list_no].data();
+            for (size_t begin = 0; begin < ids.size(); begin += faiss::PQ4_BLOCK_SIZE) {
+                faiss::pq4_accumulate_block(M, codes + (begin / faiss::PQ4_BLOCK_SIZE) * block_bytes, lut.data(),
+                                            acc);
+                size_t count = std::min(faiss::PQ4_BLOCK_SIZE, ids.size() - begin);
+                for (size_t j = 0; j < count; ++j) {
+                    int64_t id = ids[begin + j];
+                    if (blacklist && blacklist->test(id)) {
+                        continue;
+                    }
+                    float dis = offset + acc[j] * inv_scale;
+                    if (dis < heap_dis[0]) {
+                        faiss::maxheap_swap_top(k_scan, heap_dis.data(), heap_ids.data(), dis, id);
+                    }
+                }
+            }
+        }
+
+        faiss::maxheap_reorder(k_scan, heap_dis.data(), heap_ids.data());
+        if (refine) {
+            Refine(query, k, k_scan, heap_dis.data(), heap_ids.data());
+        }
+
+        for (int64_t j = 0; j < k; ++j) {
+            distances[i * k + j] = is_ip ? -heap_dis[j] : heap_dis[j];
+            labels[i * k + j] = heap_ids[j];
+        }
+    }
+}
+
+void
+IVFPQFastScan::Refine(const float* query, int64_t k, int64_t candidates, float* distances, int64_t* labels) {
+    size_t dim = index_->d;
+    bool is_ip = index_->metric_type == faiss::METRIC_INNER_PRODUCT;
+    auto raw_data = (const float*)raw_data_.get();
+
+    std::vector<std::pair<float, int64_t>> result;
+    result.reserve(candidates);
+    for (int64_t c = 0; c < candidates; ++c) {
+        int64_t id = labels[c];
+        if (id < 0 || id >= raw_rows_) {
+            continue;
+        }
+        const float* vec = raw_data + id * dim;
+        float dis = is_ip ? -faiss::fvec_inner_product(query, vec, dim) : faiss::fvec_L2sqr(query, vec, dim);
+        result.emplace_back(dis, id);
+    }
+
+    size_t count = std::min((size_t)k, result.size());
+    std::partial_sort(result.begin(), result.begin() + count, result.end());
+    for (size_t j = 0; j < (size_t)k; ++j) {
+        distances[j] = j < count ? result[j].first : FLT_MAX;
+        labels[j] = j < count ? result[j].second : -1;
+    }
+}
+
+int64_t
+IVFPQFastScan::Count() {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+    int64_t ntotal = 0;
+    for (auto& list : list_ids_) {
+        ntotal += list.size();
+    }
+    return ntotal;
+}
+
+int64_t
+IVFPQFastScan::Dim() {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+    return index_->d;
+}
+
+bool
+IVFPQFastScan::GetVectorByOffset(int64_t offset, uint8_t* data) {
+    if (!raw_data_ || offset < 0 || offset >= raw_rows_) {
+        return false;
+    }
+    auto vec_size = Dim() * sizeof(float);
+    memcpy(data, raw_data_.get() + offset * vec_size, vec_size);
+    return true;
+}
+
+}  // namespace knowhere
+}  // namespace milvus
@@ -0,0 +1,92 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <faiss/IndexIVFPQ.h>
+
+#include "knowhere/common/Exception.h"
+#include "knowhere/index/vector_index/VecIndex.h"
+
+namespace milvus {
+namespace knowhere {
+
+/*
+ * IVF index with 4-bit PQ codes scanned by SIMD shuffles.
+ *
+ * The faiss IndexIVFPQ (nbits = 4) only provides the coarse quantizer and the product quantizer, the codes of each
+ * inverted list are kept here in blocks of 32 vectors (see faiss/utils/pq4_fast_scan.h) and scored with a uint8
+ * lookup table per list. When the raw vectors are attached to the binary set as RAW_DATA and refine_factor > 1,
+ * topk * refine_factor candidates are re-ranked with exact distances.
+ */
+class IVFPQFastScan : public VecIndex {
+ public:
+    IVFPQFastScan() {
+        index_type_ = IndexEnum::INDEX_FAISS_IVFPQ_FASTSCAN;
+    }
+
+    BinarySet
+    Serialize(const Config& config = Config()) override;
+
+    void
+    Load(const BinarySet& binary_set) override;
+
+    void
+    Train(const DatasetPtr& dataset_ptr, const Config& config) override;
+
+    void
+    Add(const DatasetPtr& dataset_ptr, const Config& config) override;
+
+    void
+    AddWithoutIds(const DatasetPtr& dataset_ptr, const Config& config) override;
+
+    DatasetPtr
+    Query(const DatasetPtr& dataset_ptr, const Config& config) override;
+
+    int64_t
+    Count() override;
+
+    int64_t
+    Dim() override;
+
+    bool
+    GetVectorByOffset(int64_t offset, uint8_t* data) override;
+
+ private:
+    void
+    AddCodes(int64_t rows, const float* data, const int64_t* ids);
+
+    void
+    QueryImpl(int64_t n, const float* data, int64_t k, float* distances, int64_t* labels, const Config& config);
+
+    void
+    Refine(const float* query, int64_t k, int64_t candidates, float* distances, int64_t* labels);
+
+ private:
+    std::mutex mutex_;
+    std::shared_ptr<faiss::IndexIVFPQ> index_ = nullptr;
+    int64_t refine_factor_ = 1;
+
+    std::vector<std::vector<int64_t>> list_ids_;
+    std::vector<std::vector<uint8_t>> list_codes_;  // blocks of 32 vectors, 16 bytes per sub-quantizer
+
+    std::shared_ptr<uint8_t[]> raw_data_ = nullptr;
+    int64_t raw_rows_ = 0;
+};
+
+using IVFPQFastScanPtr = std::shared_ptr<IVFPQFastScan>;
+
+}  // namespace knowhere
+}  // namespace milvus
@@ -19,6 +19,7 @@
 #include "knowhere/index/vector_index/IndexNSG.h"
 #include "knowhere/index/vector_index/IndexType.h"
 #include "knowhere/index/vector_index/adapter/VectorAdapter.h"
+#include "knowhere/index/vector_index/impl/nsg/NNDescent.h"
 #include "knowhere/index/vector_index/impl/nsg/NSG.h"
 #include "knowhere/index/vector_index/impl/nsg/NSGIO.h"
 
@@ -109,30 +110,40 @@ NSG::Query(const DatasetPtr& dataset_ptr, const Config& config) {
 
 void
 NSG::Train(const DatasetPtr& dataset_ptr, const Config& config) {
-    auto idmap = std::make_shared<IDMAP>();
-    idmap->Train(dataset_ptr, config);
-    idmap->AddWithoutIds(dataset_ptr, config);
+    GETTENSOR(dataset_ptr)
     impl::Graph knng;
-    const float* raw_data = idmap->GetRawVectors();
-    const int64_t device_id = config[knowhere::meta::DEVICEID].get<int64_t>();
     const int64_t k = config[IndexParams::knng].get<int64_t>();
+    if (config.contains(IndexParams::knng_builder) &&
+        config[IndexParams::knng_builder].get<std::string>() == KnngBuilder::NN_DESCENT) {
+        // build knng straight from the raw vectors, no IDMAP/IVF copy of the data is needed
+        impl::NNDescentParams nnd_params;
+        nnd_params.k = k;
+        impl::NNDescent builder(dim, rows, config[Metric::TYPE].get<std::string>());
+        builder.Build((const float*)p_data, nnd_params, knng);
+    } else {
+        auto idmap = std::make_shared<IDMAP>();
+        idmap->Train(dataset_ptr, config);
+        idmap->AddWithoutIds(dataset_ptr, config);
+        const float* raw_data = idmap->GetRawVectors();
+        const int64_t device_id = config[knowhere::meta::DEVICEID].get<int64_t>();
 #ifdef MILVUS_GPU_VERSION
-    if (device_id == -1) {
+        if (device_id == -1) {
+            auto preprocess_index = std::make_shared<IVF>();
+            preprocess_index->Train(dataset_ptr, config);
+            preprocess_index->AddWithoutIds(dataset_ptr, config);
+            preprocess_index->GenGraph(raw_data, k, knng, config);
+        } else {
+            auto gpu_idx = cloner::CopyCpuToGpu(idmap, device_id, config);
+            auto gpu_idmap = std::dynamic_pointer_cast<GPUIDMAP>(gpu_idx);
+            gpu_idmap->GenGraph(raw_data, k, knng, config);
+        }
+#else
         auto preprocess_index = std::make_shared<IVF>();
         preprocess_index->Train(dataset_ptr, config);
         preprocess_index->AddWithoutIds(dataset_ptr, config);
         preprocess_index->GenGraph(raw_data, k, knng, config);
-    } else {
-        auto gpu_idx = cloner::CopyCpuToGpu(idmap, device_id, config);
-        auto gpu_idmap = std::dynamic_pointer_cast<GPUIDMAP>(gpu_idx);
-        gpu_idmap->GenGraph(raw_data, k, knng, config);
-    }
-#else
-    auto preprocess_index = std::make_shared<IVF>();
-    preprocess_index->Train(dataset_ptr, config);
-    preprocess_index->AddWithoutIds(dataset_ptr, config);
-    preprocess_index->GenGraph(raw_data, k, knng, config);
 #endif
+    }
 
     impl::BuildParams b_params;
     b_params.candidate_pool_size = config[IndexParams::candidate];
@@ -141,7 +152,6 @@ NSG::Train(const DatasetPtr& dataset_ptr, const Config& config) {
 
     auto p_ids = dataset_ptr->Get<const int64_t*>(meta::IDS);
 
-    GETTENSOR(dataset_ptr)
     index_ = std::make_shared<impl::NsgIndex>(dim, rows, config[Metric::TYPE].get<std::string>());
     index_->SetKnnGraph(knng);
     index_->Build_with_ids(rows, (float*)p_data, (int64_t*)p_ids, b_params);
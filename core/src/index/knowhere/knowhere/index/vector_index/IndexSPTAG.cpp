@@ -13,8 +13,9 @@
 #include <SPTAG/AnnService/inc/Core/VectorSet.h>
 #include <SPTAG/AnnService/inc/Server/QueryParser.h>
 
-#include <array>
-#include <sstream>
+#include <cstring>
+#include <numeric>
+#include <string>
 #include <vector>
 
 #undef mkdir
@@ -40,90 +41,104 @@ CPUSPTAGRNG::CPUSPTAGRNG(const std::string& IndexType) {
     }
 }
 
+namespace {
+
+// the blobs of SaveIndex in order, the metadata blobs are only there when the index has ids
+const char* SPTAG_BLOB_NAMES[] = {"samples", "tree", "graph", "deleteid", "metadata1", "metadata2"};
+
+}  // namespace
+
 BinarySet
 CPUSPTAGRNG::Serialize(const Config& config) {
+    if (!index_ptr_) {
+        KNOWHERE_THROW_MSG("index not initialize or trained");
+    }
+
     std::string index_config;
     std::vector<SPTAG::ByteArray> index_blobs;
+    std::vector<std::shared_ptr<uint8_t[]>> buffers;
 
     std::shared_ptr<std::vector<std::uint64_t>> buffersize = index_ptr_->CalculateBufferSize();
-    std::vector<char*> res(buffersize->size() + 1);
-    for (uint64_t i = 1; i < res.size(); i++) {
-        res[i] = new char[buffersize->at(i - 1)];
-        auto ptr = &res[i][0];
-        index_blobs.emplace_back(SPTAG::ByteArray((std::uint8_t*)ptr, buffersize->at(i - 1), false));
+    for (auto size : *buffersize) {
+        buffers.emplace_back(new uint8_t[size]);
+        index_blobs.emplace_back(buffers.back().get(), size, false);
     }
 
-    index_ptr_->SaveIndex(index_config, index_blobs);
-
-    size_t length = index_config.length();
-    char* cstr = new char[length];
-    snprintf(cstr, length, "%s", index_config.c_str());
+    if (index_ptr_->SaveIndex(index_config, index_blobs) != SPTAG::ErrorCode::Success) {
+        KNOWHERE_THROW_MSG("Failed to serialize SPTAG index");
+    }
 
     BinarySet binary_set;
-    std::shared_ptr<uint8_t[]> sample;
-    sample.reset(static_cast<uint8_t*>(index_blobs[0].Data()));
-    std::shared_ptr<uint8_t[]> tree;
-    tree.reset(static_cast<uint8_t*>(index_blobs[1].Data()));
-    std::shared_ptr<uint8_t[]> graph;
-    graph.reset(static_cast<uint8_t*>(index_blobs[2].Data()));
-    std::shared_ptr<uint8_t[]> deleteid;
-    deleteid.reset(static_cast<uint8_t*>(index_blobs[3].Data()));
-    std::shared_ptr<uint8_t[]> metadata1;
-    metadata1.reset(static_cast<uint8_t*>(index_blobs[4].Data()));
-    std::shared_ptr<uint8_t[]> metadata2;
-    metadata2.reset(static_cast<uint8_t*>(index_blobs[5].Data()));
-    std::shared_ptr<uint8_t[]> x_cfg;
-    x_cfg.reset(static_cast<uint8_t*>((void*)cstr));
-
-    binary_set.Append("samples", sample, index_blobs[0].Length());
-    binary_set.Append("tree", tree, index_blobs[1].Length());
-    binary_set.Append("deleteid", deleteid, index_blobs[3].Length());
-    binary_set.Append("metadata1", metadata1, index_blobs[4].Length());
-    binary_set.Append("metadata2", metadata2, index_blobs[5].Length());
-    binary_set.Append("config", x_cfg, length);
-    binary_set.Append("graph", graph, index_blobs[2].Length());
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        binary_set.Append(SPTAG_BLOB_NAMES[i], buffers[i], index_blobs[i].Length());
+    }
+
+    std::shared_ptr<uint8_t[]> x_cfg(new uint8_t[index_config.length()]);
+    memcpy(x_cfg.get(), index_config.data(), index_config.length());
+    binary_set.Append("config", x_cfg, index_config.length());
 
     return binary_set;
 }
 
 void
 CPUSPTAGRNG::Load(const BinarySet& binary_set) {
-    std::string index_config;
-    std::vector<SPTAG::ByteArray> index_blobs;
-
-    auto samples = binary_set.GetByName("samples");
-    index_blobs.push_back(SPTAG::ByteArray(samples->data.get(), samples->size, false));
+    // SPTAG references the samples, graph and metadata in the blobs, they are kept alive with the index
+    binary_set_ = binary_set;
 
-    auto tree = binary_set.GetByName("tree");
-    index_blobs.push_back(SPTAG::ByteArray(tree->data.get(), tree->size, false));
+    std::vector<SPTAG::ByteArray> index_blobs;
+    for (auto name : SPTAG_BLOB_NAMES) {
+        auto iter = binary_set_.binary_map_.find(name);
+        if (iter == binary_set_.binary_map_.end()) {
+            break;
+        }
+        index_blobs.emplace_back(iter->second->data.get(), iter->second->size, false);
+    }
 
-    auto graph = binary_set.GetByName("graph");
-    index_blobs.push_back(SPTAG::ByteArray(graph->data.get(), graph->size, false));
+    // written with a trailing '\0' by older versions
+    auto config = binary_set_.GetByName("config");
+    auto cfg = reinterpret_cast<const char*>(config->data.get());
+    std::string index_config(cfg, strnlen(cfg, config->size));
 
-    auto deleteid = binary_set.GetByName("deleteid");
-    index_blobs.push_back(SPTAG::ByteArray(deleteid->data.get(), deleteid->size, false));
+    if (index_ptr_->LoadIndex(index_config, index_blobs) != SPTAG::ErrorCode::Success) {
+        KNOWHERE_THROW_MSG("Failed to load SPTAG index");
+    }
+}
 
-    auto metadata1 = binary_set.GetByName("metadata1");
-    index_blobs.push_back(SPTAG::ByteArray(CopyBinary(metadata1), metadata1->size, true));
+void
+CPUSPTAGRNG::Train(const DatasetPtr& origin, const Config& train_config) {
+    SetParameters(train_config);
 
-    auto metadata2 = binary_set.GetByName("metadata2");
-    index_blobs.push_back(SPTAG::ByteArray(metadata2->data.get(), metadata2->size, false));
+    auto vectorset = ConvertToVectorSet(origin);
+    auto metaset = ConvertToMetadataSet(origin);
+    if (index_ptr_->BuildIndex(vectorset, metaset) != SPTAG::ErrorCode::Success) {
+        KNOWHERE_THROW_MSG("Failed to build SPTAG index");
+    }
+}
 
-    auto config = binary_set.GetByName("config");
-    index_config = reinterpret_cast<char*>(config->data.get());
+void
+CPUSPTAGRNG::Add(const DatasetPtr& origin, const Config& add_config) {
+    if (!index_ptr_ || index_ptr_->GetNumSamples() == 0) {
+        KNOWHERE_THROW_MSG("index not initialize or trained");
+    }
 
-    index_ptr_->LoadIndex(index_config, index_blobs);
+    auto vectorset = ConvertToVectorSet(origin);
+    auto metaset = ConvertToMetadataSet(origin);
+    if (index_ptr_->AddIndex(vectorset, metaset) != SPTAG::ErrorCode::Success) {
+        KNOWHERE_THROW_MSG("Failed to add vectors to SPTAG index");
+    }
 }
 
 void
-CPUSPTAGRNG::Train(const DatasetPtr& origin, const Config& train_config) {
-    SetParameters(train_config);
-
-    DatasetPtr dataset = origin;
+CPUSPTAGRNG::AddWithoutIds(const DatasetPtr& origin, const Config& add_config) {
+    if (!index_ptr_ || index_ptr_->GetNumSamples() == 0) {
+        KNOWHERE_THROW_MSG("index not initialize or trained");
+    }
 
-    auto vectorset = ConvertToVectorSet(dataset);
-    auto metaset = ConvertToMetadataSet(dataset);
-    index_ptr_->BuildIndex(vectorset, metaset);
+    // labeled by offset
+    GETTENSOR(origin)
+    std::vector<int64_t> ids(rows);
+    std::iota(ids.begin(), ids.end(), index_ptr_->GetNumSamples());
+    Add(GenDatasetWithIds(rows, dim, p_data, ids.data()), add_config);
 }
 
 void
@@ -177,22 +192,19 @@ CPUSPTAGRNG::SetParameters(const Config& config) {
 
 DatasetPtr
 CPUSPTAGRNG::Query(const DatasetPtr& dataset_ptr, const Config& config) {
-    SetParameters(config);
-
-    float* p_data = (float*)dataset_ptr->Get<const void*>(meta::TENSOR);
-    for (auto i = 0; i < 10; ++i) {
-        for (auto j = 0; j < 10; ++j) {
-            std::cout << p_data[i * 10 + j] << " ";
-        }
-        std::cout << std::endl;
+    if (!index_ptr_) {
+        KNOWHERE_THROW_MSG("index not initialize or trained");
     }
+
     std::vector<SPTAG::QueryResult> query_results = ConvertToQueryResult(dataset_ptr, config);
 
+    // bit i of the blacklist is the point of offset i, which is the sample id in SPTAG
+    faiss::ConcurrentBitsetPtr blacklist = GetBlacklist();
+    const uint8_t* filter = blacklist ? blacklist->data() : nullptr;
+
 #pragma omp parallel for
-    for (auto i = 0; i < query_results.size(); ++i) {
-        auto target = (float*)query_results[i].GetTarget();
-        std::cout << target[0] << ", " << target[1] << ", " << target[2] << std::endl;
-        index_ptr_->SearchIndex(query_results[i]);
+    for (int64_t i = 0; i < static_cast<int64_t>(query_results.size()); ++i) {
+        index_ptr_->SearchIndex(query_results[i], filter);
     }
 
     return ConvertToDataset(query_results);
@@ -214,20 +226,5 @@ CPUSPTAGRNG::Dim() {
     return index_ptr_->GetFeatureDim();
 }
 
-// void
-// CPUSPTAGRNG::Add(const DatasetPtr& origin, const Config& add_config) {
-//     SetParameters(add_config);
-//     DatasetPtr dataset = origin->Clone();
-
-//     // if (index_ptr_->GetDistCalcMethod() == SPTAG::DistCalcMethod::Cosine
-//     //    && preprocessor_) {
-//     //    preprocessor_->Preprocess(dataset);
-//     //}
-
-//     auto vectorset = ConvertToVectorSet(dataset);
-//     auto metaset = ConvertToMetadataSet(dataset);
-//     index_ptr_->AddIndex(vectorset, metaset);
-// }
-
 }  // namespace knowhere
 }  // namespace milvus
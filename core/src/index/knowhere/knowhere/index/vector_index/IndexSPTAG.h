@@ -42,14 +42,10 @@ class CPUSPTAGRNG : public VecIndex {
     Train(const DatasetPtr& dataset_ptr, const Config& config) override;
 
     void
-    Add(const DatasetPtr&, const Config&) override {
-        KNOWHERE_THROW_MSG("Incremental index is not supported");
-    }
+    Add(const DatasetPtr& dataset_ptr, const Config& config) override;
 
     void
-    AddWithoutIds(const DatasetPtr&, const Config&) override {
-        KNOWHERE_THROW_MSG("Incremental index is not supported");
-    }
+    AddWithoutIds(const DatasetPtr& dataset_ptr, const Config& config) override;
 
     DatasetPtr
     Query(const DatasetPtr& dataset_ptr, const Config& config) override;
@@ -66,6 +62,7 @@ class CPUSPTAGRNG : public VecIndex {
 
  private:
     std::shared_ptr<SPTAG::VectorIndex> index_ptr_;
+    BinarySet binary_set_;  // the loaded blobs referenced by index_ptr_
 };
 
 using CPUSPTAGRNGPtr = std::shared_ptr<CPUSPTAGRNG>;
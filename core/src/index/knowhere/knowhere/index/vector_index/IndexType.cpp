@@ -37,8 +37,11 @@ static std::unordered_map<int32_t, std::string> old_index_type_str_map = {
 #endif
     {(int32_t)OldIndexType::HNSW, IndexEnum::INDEX_HNSW},
     {(int32_t)OldIndexType::ANNOY, IndexEnum::INDEX_ANNOY},
+    {(int32_t)OldIndexType::FAISS_IVFPQ_FASTSCAN, IndexEnum::INDEX_FAISS_IVFPQ_FASTSCAN},
+    {(int32_t)OldIndexType::HNSW_SQ8, IndexEnum::INDEX_HNSW_SQ8},
     {(int32_t)OldIndexType::FAISS_BIN_IDMAP, IndexEnum::INDEX_FAISS_BIN_IDMAP},
     {(int32_t)OldIndexType::FAISS_BIN_IVFLAT_CPU, IndexEnum::INDEX_FAISS_BIN_IVFFLAT},
+    {(int32_t)OldIndexType::BIN_HNSW, IndexEnum::INDEX_BIN_HNSW},
 };
 
 static std::unordered_map<std::string, int32_t> str_old_index_type_map = {
@@ -55,8 +58,11 @@ static std::unordered_map<std::string, int32_t> str_old_index_type_map = {
 #endif
     {IndexEnum::INDEX_HNSW, (int32_t)OldIndexType::HNSW},
     {IndexEnum::INDEX_ANNOY, (int32_t)OldIndexType::ANNOY},
+    {IndexEnum::INDEX_FAISS_IVFPQ_FASTSCAN, (int32_t)OldIndexType::FAISS_IVFPQ_FASTSCAN},
+    {IndexEnum::INDEX_HNSW_SQ8, (int32_t)OldIndexType::HNSW_SQ8},
     {IndexEnum::INDEX_FAISS_BIN_IDMAP, (int32_t)OldIndexType::FAISS_BIN_IDMAP},
     {IndexEnum::INDEX_FAISS_BIN_IVFFLAT, (int32_t)OldIndexType::FAISS_BIN_IVFLAT_CPU},
+    {IndexEnum::INDEX_BIN_HNSW, (int32_t)OldIndexType::BIN_HNSW},
 };
 
 /* used in 0.8.0 */
@@ -69,6 +75,7 @@ const char* INDEX_FAISS_IVFSQ8 = "IVF_SQ8";
 const char* INDEX_FAISS_IVFSQ8H = "IVF_SQ8_HYBRID";
 const char* INDEX_FAISS_BIN_IDMAP = "BIN_IDMAP";
 const char* INDEX_FAISS_BIN_IVFFLAT = "BIN_IVF_FLAT";
+const char* INDEX_BIN_HNSW = "BIN_HNSW";
 const char* INDEX_NSG = "NSG";
 #ifdef MILVUS_SUPPORT_SPTAG
 const char* INDEX_SPTAG_KDT_RNT = "SPTAG_KDT_RNT";
@@ -76,6 +83,8 @@ const char* INDEX_SPTAG_BKT_RNT = "SPTAG_BKT_RNT";
 #endif
 const char* INDEX_HNSW = "HNSW";
 const char* INDEX_ANNOY = "ANNOY";
+const char* INDEX_FAISS_IVFPQ_FASTSCAN = "IVF_PQ_FASTSCAN";
+const char* INDEX_HNSW_SQ8 = "HNSW_SQ8";
 }  // namespace IndexEnum
 
 std::string
@@ -35,8 +35,11 @@ enum class OldIndexType {
     SPTAG_BKT_RNT_CPU,
     HNSW,
     ANNOY,
+    FAISS_IVFPQ_FASTSCAN,
+    HNSW_SQ8,
     FAISS_BIN_IDMAP = 100,
     FAISS_BIN_IVFLAT_CPU = 101,
+    BIN_HNSW = 102,
 };
 
 using IndexType = std::string;
@@ -51,6 +54,7 @@ extern const char* INDEX_FAISS_IVFSQ8;
 extern const char* INDEX_FAISS_IVFSQ8H;
 extern const char* INDEX_FAISS_BIN_IDMAP;
 extern const char* INDEX_FAISS_BIN_IVFFLAT;
+extern const char* INDEX_BIN_HNSW;
 extern const char* INDEX_NSG;
 #ifdef MILVUS_SUPPORT_SPTAG
 extern const char* INDEX_SPTAG_KDT_RNT;
@@ -58,6 +62,8 @@ extern const char* INDEX_SPTAG_BKT_RNT;
 #endif
 extern const char* INDEX_HNSW;
 extern const char* INDEX_ANNOY;
+extern const char* INDEX_FAISS_IVFPQ_FASTSCAN;
+extern const char* INDEX_HNSW_SQ8;
 }  // namespace IndexEnum
 
 enum class IndexMode { MODE_CPU = 0, MODE_GPU = 1 };
@@ -54,9 +54,12 @@ class VecIndex : public Index {
     }
 #endif
 
-    // virtual DatasetPtr
-    // QueryByRange(const DatasetPtr&, const Config&) = 0;
-    //
+    // return all the vectors within config[IndexParams::radius] of the queries, see GenRangeResultDataset
+    virtual DatasetPtr
+    QueryByRange(const DatasetPtr& dataset, const Config& config) {
+        KNOWHERE_THROW_MSG("Range search not supported by index " + index_type_);
+    }
+
     // virtual MetricType
     // metric_type() = 0;
 
@@ -83,6 +86,13 @@ class VecIndex : public Index {
     }
 #endif
 
+    // copy the raw vector at offset into data, Dim() floats or Dim() / 8 bytes for binary vectors,
+    // return false when the index keeps no raw vectors in memory
+    virtual bool
+    GetVectorByOffset(int64_t offset, uint8_t* data) {
+        return false;
+    }
+
     faiss::ConcurrentBitsetPtr
     GetBlacklist() {
         return bitset_;
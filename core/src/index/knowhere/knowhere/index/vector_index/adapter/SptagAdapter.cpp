@@ -12,6 +12,8 @@
 #include "knowhere/index/vector_index/adapter/SptagAdapter.h"
 #include "knowhere/index/vector_index/adapter/VectorAdapter.h"
 
+#include <cstring>
+
 namespace milvus {
 namespace knowhere {
 
@@ -20,12 +22,17 @@ ConvertToMetadataSet(const DatasetPtr& dataset_ptr) {
     auto elems = dataset_ptr->Get<int64_t>(meta::ROWS);
     auto p_data = dataset_ptr->Get<const int64_t*>(meta::IDS);
 
-    auto p_offset = (int64_t*)malloc(sizeof(int64_t) * (elems + 1));
-    for (auto i = 0; i <= elems; ++i) p_offset[i] = i * 8;
+    // the index keeps the metadata, so it is copied out of the dataset
+    auto p_meta = new uint8_t[elems * sizeof(int64_t)];
+    memcpy(p_meta, p_data, elems * sizeof(int64_t));
+
+    auto p_offset = new uint8_t[(elems + 1) * sizeof(std::uint64_t)];
+    auto offsets = reinterpret_cast<std::uint64_t*>(p_offset);
+    for (auto i = 0; i <= elems; ++i) offsets[i] = i * sizeof(int64_t);
 
     std::shared_ptr<SPTAG::MetadataSet> metaset(
-        new SPTAG::MemMetadataSet(SPTAG::ByteArray((std::uint8_t*)p_data, elems * sizeof(int64_t), false),
-                                  SPTAG::ByteArray((std::uint8_t*)p_offset, elems * sizeof(int64_t), true), elems));
+        new SPTAG::MemMetadataSet(SPTAG::ByteArray(p_meta, elems * sizeof(int64_t), true),
+                                  SPTAG::ByteArray(p_offset, (elems + 1) * sizeof(std::uint64_t), true), elems));
 
     return metaset;
 }
@@ -54,8 +61,8 @@ ConvertToQueryResult(const DatasetPtr& dataset_ptr, const Config& config) {
 }
 
 DatasetPtr
-ConvertToDataset(std::vector<SPTAG::QueryResult> query_results) {
-    auto k = query_results[0].GetResultNum();
+ConvertToDataset(const std::vector<SPTAG::QueryResult>& query_results) {
+    auto k = query_results.empty() ? 0 : query_results[0].GetResultNum();
     auto elems = query_results.size() * k;
 
     size_t p_id_size = sizeof(int64_t) * elems;
@@ -64,12 +71,16 @@ ConvertToDataset(std::vector<SPTAG::QueryResult> query_results) {
     auto p_dist = (float*)malloc(p_dist_size);
 
 #pragma omp parallel for
-    for (auto i = 0; i < query_results.size(); ++i) {
+    for (int64_t i = 0; i < static_cast<int64_t>(query_results.size()); ++i) {
         auto results = query_results[i].GetResults();
         auto num_result = query_results[i].GetResultNum();
         for (auto j = 0; j < num_result; ++j) {
-            //            p_id[i * k + j] = results[j].VID;
-            p_id[i * k + j] = *(int64_t*)query_results[i].GetMetadata(j).Data();
+            // fewer than k points are found when most of them are filtered
+            if (results[j].VID < 0) {
+                p_id[i * k + j] = -1;
+            } else {
+                p_id[i * k + j] = *(int64_t*)query_results[i].GetMetadata(j).Data();
+            }
             p_dist[i * k + j] = results[j].Dist;
         }
     }
@@ -31,7 +31,7 @@ std::vector<SPTAG::QueryResult>
 ConvertToQueryResult(const DatasetPtr& dataset_ptr, const Config& config);
 
 DatasetPtr
-ConvertToDataset(std::vector<SPTAG::QueryResult> query_results);
+ConvertToDataset(const std::vector<SPTAG::QueryResult>& query_results);
 
 }  // namespace knowhere
 }  // namespace milvus
@@ -9,7 +9,10 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
+#include <algorithm>
 #include <memory>
+#include <numeric>
+#include <vector>
 
 #include "knowhere/common/Dataset.h"
 #include "knowhere/index/vector_index/adapter/VectorAdapter.h"
@@ -37,5 +40,35 @@ GenDataset(const int64_t nb, const int64_t dim, const void* xb) {
     return ret_ds;
 }
 
+DatasetPtr
+GenRangeResultDataset(const int64_t nq, const size_t* lims, const int64_t* ids, const float* distances,
+                      bool ascending) {
+    size_t total = lims[nq];
+    auto p_lims = (int64_t*)malloc(sizeof(int64_t) * (nq + 1));
+    auto p_id = (int64_t*)malloc(sizeof(int64_t) * total);
+    auto p_dist = (float*)malloc(sizeof(float) * total);
+
+    std::vector<size_t> order;
+    for (int64_t i = 0; i < nq; ++i) {
+        p_lims[i] = lims[i];
+        order.resize(lims[i + 1] - lims[i]);
+        std::iota(order.begin(), order.end(), lims[i]);
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return ascending ? distances[a] < distances[b] : distances[a] > distances[b];
+        });
+        for (size_t j = 0; j < order.size(); ++j) {
+            p_id[lims[i] + j] = ids[order[j]];
+            p_dist[lims[i] + j] = distances[order[j]];
+        }
+    }
+    p_lims[nq] = total;
+
+    auto ret_ds = std::make_shared<Dataset>();
+    ret_ds->Set(meta::LIMS, p_lims);
+    ret_ds->Set(meta::IDS, p_id);
+    ret_ds->Set(meta::DISTANCE, p_dist);
+    return ret_ds;
+}
+
 }  // namespace knowhere
 }  // namespace milvus
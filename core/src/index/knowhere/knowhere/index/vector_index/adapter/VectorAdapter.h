@@ -35,5 +35,10 @@ GenDatasetWithIds(const int64_t nb, const int64_t dim, const void* xb, const int
 extern DatasetPtr
 GenDataset(const int64_t nb, const int64_t dim, const void* xb);
 
+// results of a range search, sorted by distance within each query
+extern DatasetPtr
+GenRangeResultDataset(const int64_t nq, const size_t* lims, const int64_t* ids, const float* distances,
+                      bool ascending);
+
 }  // namespace knowhere
 }  // namespace milvus
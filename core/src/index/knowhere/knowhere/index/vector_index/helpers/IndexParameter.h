@@ -23,6 +23,7 @@ constexpr const char* TENSOR = "tensor";
 constexpr const char* ROWS = "rows";
 constexpr const char* IDS = "ids";
 constexpr const char* DISTANCE = "distance";
+constexpr const char* LIMS = "lims";  // range search, results of query i are in [lims[i], lims[i + 1])
 constexpr const char* TOPK = "k";
 constexpr const char* DEVICEID = "gpu_id";
 };  // namespace meta
@@ -33,12 +34,14 @@ constexpr const char* nprobe = "nprobe";
 constexpr const char* nlist = "nlist";
 constexpr const char* m = "m";          // PQ
 constexpr const char* nbits = "nbits";  // PQ/SQ
+constexpr const char* refine_factor = "refine_factor";  // PQ fast scan
 
 // NSG Params
 constexpr const char* knng = "knng";
 constexpr const char* search_length = "search_length";
 constexpr const char* out_degree = "out_degree";
 constexpr const char* candidate = "candidate_pool_size";
+constexpr const char* knng_builder = "knng_builder";
 
 // HNSW Params
 constexpr const char* efConstruction = "efConstruction";
@@ -48,6 +51,9 @@ constexpr const char* ef = "ef";
 // Annoy Params
 constexpr const char* n_trees = "n_trees";
 constexpr const char* search_k = "search_k";
+
+// Range Search Params
+constexpr const char* radius = "radius";
 }  // namespace IndexParams
 
 namespace Metric {
@@ -61,6 +67,11 @@ constexpr const char* SUBSTRUCTURE = "SUBSTRUCTURE";
 constexpr const char* SUPERSTRUCTURE = "SUPERSTRUCTURE";
 }  // namespace Metric
 
+namespace KnngBuilder {
+constexpr const char* IVF = "IVF";
+constexpr const char* NN_DESCENT = "NN_DESCENT";
+}  // namespace KnngBuilder
+
 extern faiss::MetricType
 GetMetricType(const std::string& type);
 
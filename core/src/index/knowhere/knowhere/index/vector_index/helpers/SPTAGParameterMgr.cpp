@@ -9,6 +9,8 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
+#include <omp.h>
+
 #include <mutex>
 
 #include "knowhere/index/vector_index/helpers/SPTAGParameterMgr.h"
@@ -39,7 +41,7 @@ SPTAGParameterMgr::SPTAGParameterMgr() {
     kdt_config_["refineiterations"] = 0;
     kdt_config_["cef"] = 1000;
     kdt_config_["maxcheckforrefinegraph"] = 10000;
-    kdt_config_["numofthreads"] = 1;
+    kdt_config_["numofthreads"] = omp_get_max_threads();
     kdt_config_["maxcheck"] = 8192;
     kdt_config_["thresholdofnumberofcontinuousnobetterpropagation"] = 3;
     kdt_config_["numberofinitialdynamicpivots"] = 50;
@@ -58,7 +60,7 @@ SPTAGParameterMgr::SPTAGParameterMgr() {
     bkt_config_["refineiterations"] = 0;
     bkt_config_["cef"] = 1000;
     bkt_config_["maxcheckforrefinegraph"] = 10000;
-    bkt_config_["numofthreads"] = 1;
+    bkt_config_["numofthreads"] = omp_get_max_threads();
     bkt_config_["maxcheck"] = 8192;
     bkt_config_["thresholdofnumberofcontinuousnobetterpropagation"] = 3;
     bkt_config_["numberofinitialdynamicpivots"] = 50;
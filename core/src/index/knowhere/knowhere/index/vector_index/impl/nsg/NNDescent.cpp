@@ -0,0 +1,233 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "knowhere/index/vector_index/impl/nsg/NNDescent.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <utility>
+
+#include "faiss/BuilderSuspend.h"
+#include "knowhere/common/Exception.h"
+#include "knowhere/common/Log.h"
+#include "knowhere/common/Timer.h"
+
+namespace milvus {
+namespace knowhere {
+namespace impl {
+
+NNDescent::NNDescent(const size_t& dimension, const size_t& n, std::string metric)
+    : dimension(dimension), ntotal(n), distance_(nullptr), mutex_vec_(n) {
+    if (metric == knowhere::Metric::L2) {
+        distance_ = new DistanceL2;
+    } else if (metric == knowhere::Metric::IP) {
+        distance_ = new DistanceIP;
+        negate_ = true;
+    }
+}
+
+NNDescent::~NNDescent() {
+    delete distance_;
+}
+
+void
+NNDescent::Build(const float* data, const NNDescentParams& parameters, Graph& knng) {
+    if (distance_ == nullptr) {
+        KNOWHERE_THROW_MSG("Build Error, unsupported metric type");
+    }
+    if (parameters.k >= ntotal) {
+        KNOWHERE_THROW_MSG("Build Error, knng >= ntotal");
+    }
+
+    params_ = parameters;
+    if (params_.pool_size == 0) {
+        params_.pool_size = params_.k * 3 / 2;
+    }
+    if (params_.sample == 0) {
+        params_.sample = params_.k;
+    }
+    params_.pool_size = std::min(std::max(params_.pool_size, params_.k), ntotal - 1);
+    params_.sample = std::max(params_.sample, (size_t)1);
+
+    TimeRecorder rc("NNDescent", 1);
+    InitRandomPool(data);
+    rc.RecordSection("init");
+
+    auto threshold = static_cast<size_t>(params_.delta * ntotal * params_.k);
+    for (unsigned int round = 0; round < params_.iterations; ++round) {
+        faiss::BuilderSuspend::check_wait();
+        SampleCandidates(round);
+        auto updates = LocalJoin(data);
+        rc.RecordSection("round " + std::to_string(round) + ", updates: " + std::to_string(updates));
+        if (updates <= threshold) {
+            break;
+        }
+    }
+
+    knng.resize(ntotal);
+#pragma omp parallel for
+    for (size_t n = 0; n < ntotal; ++n) {
+        auto& node = knng[n];
+        node.resize(params_.k);
+        for (size_t i = 0; i < params_.k; ++i) {
+            node[i] = pool_[n][i].id;
+        }
+    }
+    rc.ElapseFromBegin("finish");
+
+    std::vector<std::vector<Neighbor>>().swap(pool_);
+    std::vector<std::vector<node_t>>().swap(new_);
+    std::vector<std::vector<node_t>>().swap(old_);
+}
+
+void
+NNDescent::InitRandomPool(const float* data) {
+    pool_.resize(ntotal);
+    new_.resize(ntotal);
+    old_.resize(ntotal);
+
+#pragma omp parallel for schedule(dynamic, 100)
+    for (size_t n = 0; n < ntotal; ++n) {
+        unsigned int seed = n;
+        auto& pool = pool_[n];
+        pool.reserve(params_.pool_size + 1);
+        while (pool.size() < params_.pool_size) {
+            node_t id = rand_r(&seed) % ntotal;
+            if (id == static_cast<node_t>(n)) {
+                continue;
+            }
+            auto duplicate = std::find_if(pool.begin(), pool.end(), [&](const Neighbor& nn) { return nn.id == id; });
+            if (duplicate != pool.end()) {
+                continue;
+            }
+            float dist = Compare(data + dimension * n, data + dimension * id);
+            pool.emplace_back(id, dist, false);
+        }
+        std::sort(pool.begin(), pool.end());
+    }
+}
+
+void
+NNDescent::SampleCandidates(unsigned int round) {
+    std::vector<std::vector<node_t>> reverse_new(ntotal);
+    std::vector<std::vector<node_t>> reverse_old(ntotal);
+
+    // forward candidates: unexplored neighbors are joined once, then kept as old ones
+#pragma omp parallel for schedule(dynamic, 100)
+    for (size_t n = 0; n < ntotal; ++n) {
+        auto& new_ids = new_[n];
+        auto& old_ids = old_[n];
+        new_ids.clear();
+        old_ids.clear();
+
+        LockGuard lk(mutex_vec_[n]);
+        for (auto& nn : pool_[n]) {
+            if (!nn.has_explored) {
+                if (new_ids.size() < params_.sample) {
+                    new_ids.push_back(nn.id);
+                    nn.has_explored = true;
+                }
+            } else {
+                old_ids.push_back(nn.id);
+            }
+        }
+    }
+
+    // reverse candidates
+#pragma omp parallel for schedule(dynamic, 100)
+    for (size_t n = 0; n < ntotal; ++n) {
+        for (auto id : new_[n]) {
+            LockGuard lk(mutex_vec_[id]);
+            reverse_new[id].push_back(n);
+        }
+        for (auto id : old_[n]) {
+            LockGuard lk(mutex_vec_[id]);
+            reverse_old[id].push_back(n);
+        }
+    }
+
+    auto merge = [&](std::vector<node_t>& dst, std::vector<node_t>& reverse, unsigned int& seed) {
+        if (reverse.size() > params_.sample) {
+            for (size_t i = 0; i < params_.sample; ++i) {
+                std::swap(reverse[i], reverse[i + rand_r(&seed) % (reverse.size() - i)]);
+            }
+            reverse.resize(params_.sample);
+        }
+        dst.insert(dst.end(), reverse.begin(), reverse.end());
+        std::sort(dst.begin(), dst.end());
+        dst.erase(std::unique(dst.begin(), dst.end()), dst.end());
+    };
+
+#pragma omp parallel for schedule(dynamic, 100)
+    for (size_t n = 0; n < ntotal; ++n) {
+        unsigned int seed = round * ntotal + n;
+        merge(new_[n], reverse_new[n], seed);
+        merge(old_[n], reverse_old[n], seed);
+    }
+}
+
+size_t
+NNDescent::LocalJoin(const float* data) {
+    size_t updates = 0;
+
+#pragma omp parallel for schedule(dynamic, 100) reduction(+ : updates)
+    for (size_t n = 0; n < ntotal; ++n) {
+        auto& new_ids = new_[n];
+        auto& old_ids = old_[n];
+        for (size_t i = 0; i < new_ids.size(); ++i) {
+            node_t a = new_ids[i];
+            const float* va = data + dimension * a;
+            for (size_t j = i + 1; j < new_ids.size(); ++j) {
+                node_t b = new_ids[j];
+                float dist = Compare(va, data + dimension * b);
+                updates += UpdatePool(a, Neighbor(b, dist, false));
+                updates += UpdatePool(b, Neighbor(a, dist, false));
+            }
+            for (auto b : old_ids) {
+                if (a == b) {
+                    continue;
+                }
+                float dist = Compare(va, data + dimension * b);
+                updates += UpdatePool(a, Neighbor(b, dist, false));
+                updates += UpdatePool(b, Neighbor(a, dist, false));
+            }
+        }
+    }
+    return updates;
+}
+
+float
+NNDescent::Compare(const float* a, const float* b) const {
+    float dist = distance_->Compare(a, b, dimension);
+    return negate_ ? -dist : dist;
+}
+
+bool
+NNDescent::UpdatePool(node_t n, const Neighbor& nn) {
+    auto& pool = pool_[n];
+    LockGuard lk(mutex_vec_[n]);
+    if (nn.distance >= pool.back().distance) {
+        return false;
+    }
+    for (auto& p : pool) {
+        if (p.id == nn.id) {
+            return false;
+        }
+    }
+    pool.insert(std::upper_bound(pool.begin(), pool.end(), nn), nn);
+    pool.pop_back();
+    return true;
+}
+
+}  // namespace impl
+}  // namespace knowhere
+}  // namespace milvus
@@ -0,0 +1,81 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Distance.h"
+#include "NSG.h"
+#include "Neighbor.h"
+
+namespace milvus {
+namespace knowhere {
+namespace impl {
+
+struct NNDescentParams {
+    size_t k;                // out degree of the generated knng
+    size_t pool_size = 0;    // candidates kept per node while iterating, 0 means 1.5 * k
+    size_t sample = 0;       // new candidates joined per node in each round, 0 means k
+    size_t iterations = 12;  // upper bound of join rounds
+    float delta = 0.002;     // stop once updates of a round drop below delta * ntotal * k
+};
+
+/*
+ * Approximate knn graph construction on raw vectors (Dong et al., "Efficient k-nearest neighbor graph
+ * construction for generic similarity measures"). Works directly on the float array, so NSG no longer
+ * needs a preprocess IVF index to produce its knng.
+ */
+class NNDescent {
+ public:
+    explicit NNDescent(const size_t& dimension, const size_t& n, std::string metric = knowhere::Metric::L2);
+
+    ~NNDescent();
+
+    void
+    Build(const float* data, const NNDescentParams& parameters, Graph& knng);
+
+ private:
+    void
+    InitRandomPool(const float* data);
+
+    void
+    SampleCandidates(unsigned int round);
+
+    size_t
+    LocalJoin(const float* data);
+
+    bool
+    UpdatePool(node_t n, const Neighbor& nn);
+
+    // smaller is closer, the inner product is negated
+    float
+    Compare(const float* a, const float* b) const;
+
+ private:
+    size_t dimension;
+    size_t ntotal;
+    Distance* distance_;
+    bool negate_ = false;
+    NNDescentParams params_;
+
+    std::vector<std::vector<Neighbor>> pool_;  // sorted by Compare, has_explored marks joined candidates
+    std::vector<std::vector<node_t>> new_;
+    std::vector<std::vector<node_t>> old_;
+    std::vector<std::mutex> mutex_vec_;
+};
+
+}  // namespace impl
+}  // namespace knowhere
+}  // namespace milvus
@@ -57,6 +57,7 @@ NsgIndex::Build_with_ids(size_t nb, float* data, const int64_t* ids, const Build
     search_length = parameters.search_length;
     out_degree = parameters.out_degree;
     candidate_pool_size = parameters.candidate_pool_size;
+    visited_list_pool_ = std::make_shared<hnswlib::VisitedListPool>(1, ntotal);
 
     TimeRecorder rc("NSG", 1);
     InitNavigationPoint(data);
@@ -106,7 +107,7 @@ NsgIndex::InitNavigationPoint(float* data) {
     // select navigation point
     std::vector<Neighbor> resset;
     navigation_point = rand_r(&seed) % ntotal;  // random initialize navigating point
-    GetNeighbors(center, data, resset, knng);
+    GetNeighbors(center, data, resset, knng, search_length, 1, nullptr);
     navigation_point = resset[0].id;
 
     // Debug code
@@ -324,17 +325,36 @@ NsgIndex::GetNeighbors(const float* query, float* data, std::vector<Neighbor>& r
 
 void
 NsgIndex::GetNeighbors(const float* query, float* data, std::vector<Neighbor>& resset, Graph& graph,
-                       SearchParams* params) {
-    size_t buffer_size = params ? params->search_length : search_length;
+                       size_t search_length, size_t k, const faiss::ConcurrentBitsetPtr& bitset) {
+    size_t buffer_size = search_length;
 
     if (buffer_size > ntotal) {
         KNOWHERE_THROW_MSG("Build Error, search_length > ntotal");
     }
 
-    std::vector<node_t> init_ids(buffer_size);
-    resset.resize(buffer_size);
-    boost::dynamic_bitset<> has_calculated_dist{ntotal, 0};
+    // the pool guides the walk and may hold deleted nodes, only valid nodes enter the topk result
+    std::vector<Neighbor> pool(buffer_size);
+    resset.clear();
+    resset.reserve(k + 1);
+    auto add_result = [&](node_t id, float dist) {
+        if (bitset != nullptr && bitset->test((faiss::ConcurrentBitset::id_type_t)id)) {
+            return;
+        }
+        if (resset.size() >= k && dist >= resset.back().distance) {
+            return;
+        }
+        Neighbor nn(id, dist, true);
+        resset.insert(std::upper_bound(resset.begin(), resset.end(), nn), nn);
+        if (resset.size() > k) {
+            resset.pop_back();
+        }
+    };
 
+    hnswlib::VisitedList* vl = visited_list_pool_->getFreeVisitedList();
+    hnswlib::vl_type* visited = vl->mass;
+    hnswlib::vl_type visited_tag = vl->curV;
+
+    std::vector<node_t> init_ids(buffer_size);
     {
         /*
          * copy navigation-point neighbor,  pick random node if less than buffer size
@@ -344,73 +364,61 @@ NsgIndex::GetNeighbors(const float* query, float* data, std::vector<Neighbor>& r
         // Get all neighbors
         for (size_t i = 0; i < init_ids.size() && i < graph[navigation_point].size(); ++i) {
             init_ids[i] = graph[navigation_point][i];
-            has_calculated_dist[init_ids[i]] = true;
+            visited[init_ids[i]] = visited_tag;
             ++count;
         }
         while (count < buffer_size) {
             node_t id = rand_r(&seed) % ntotal;
-            if (has_calculated_dist[id])
+            if (visited[id] == visited_tag)
                 continue;  // duplicate id
             init_ids[count] = id;
             ++count;
-            has_calculated_dist[id] = true;
+            visited[id] = visited_tag;
         }
     }
 
     {
-        // resset.resize(init_ids.size());
-
-        // init resset and sort by distance
+        // init pool and sort by distance
         for (size_t i = 0; i < init_ids.size(); ++i) {
             node_t id = init_ids[i];
 
             if (id >= static_cast<node_t>(ntotal)) {
+                visited_list_pool_->releaseVisitedList(vl);
                 KNOWHERE_THROW_MSG("Build Index Error, id > ntotal");
             }
 
             float dist = distance_->Compare(data + id * dimension, query, dimension);
-            resset[i] = Neighbor(id, dist, false);
+            pool[i] = Neighbor(id, dist, false);
+            add_result(id, dist);
         }
-        std::sort(resset.begin(), resset.end());  // sort by distance
+        std::sort(pool.begin(), pool.end());  // sort by distance
 
         // search nearest neighbor
         size_t cursor = 0;
         while (cursor < buffer_size) {
             size_t nearest_updated_pos = buffer_size;
 
-            if (!resset[cursor].has_explored) {
-                resset[cursor].has_explored = true;
+            if (!pool[cursor].has_explored) {
+                pool[cursor].has_explored = true;
 
-                node_t start_pos = resset[cursor].id;
+                node_t start_pos = pool[cursor].id;
                 auto& wait_for_search_node_vec = graph[start_pos];
                 for (size_t i = 0; i < wait_for_search_node_vec.size(); ++i) {
                     node_t id = wait_for_search_node_vec[i];
-                    if (has_calculated_dist[id])
+                    if (visited[id] == visited_tag)
                         continue;
-                    has_calculated_dist[id] = true;
+                    visited[id] = visited_tag;
 
                     float dist = distance_->Compare(query, data + dimension * id, dimension);
+                    add_result(id, dist);
 
-                    if (dist >= resset[buffer_size - 1].distance)
+                    if (dist >= pool[buffer_size - 1].distance)
                         continue;
 
-                    //// difference from other GetNeighbors
                     Neighbor nn(id, dist, false);
-                    ///////////////////////////////////////
-
-                    size_t pos = InsertIntoPool(resset.data(), buffer_size, nn);  // replace with a closer node
+                    size_t pos = InsertIntoPool(pool.data(), buffer_size, nn);  // replace with a closer node
                     if (pos < nearest_updated_pos)
                         nearest_updated_pos = pos;
-
-                    //>> Debug code
-                    /////
-                    // std::cout << "pos: " << pos << ", nn: " << nn.id << ":" << nn.distance << ", nup: " <<
-                    // nearest_updated_pos << std::endl;
-                    /////
-
-                    // trick: avoid search query search_length < init_ids.size() ...
-                    if (buffer_size + 1 < resset.size())
-                        ++buffer_size;
                 }
             }
             if (cursor >= nearest_updated_pos) {
@@ -420,6 +428,8 @@ NsgIndex::GetNeighbors(const float* query, float* data, std::vector<Neighbor>& r
             }
         }
     }
+
+    visited_list_pool_->releaseVisitedList(vl);
 }
 
 void
@@ -835,28 +845,39 @@ void
 NsgIndex::Search(const float* query, float* data, const unsigned& nq, const unsigned& dim, const unsigned& k,
                  float* dist, int64_t* ids, SearchParams& params, faiss::ConcurrentBitsetPtr bitset) {
     std::vector<std::vector<Neighbor>> resset(nq);
+    if (visited_list_pool_ == nullptr) {
+        visited_list_pool_ = std::make_shared<hnswlib::VisitedListPool>(1, ntotal);
+    }
+
+    // when many nodes are deleted the walk may end with less than k valid nodes, then search again with a longer
+    // pool, the total work is at most twice the work of the last search
+    auto search_one = [&](const float* single_query, std::vector<Neighbor>& result) {
+        size_t length = std::min(std::max<size_t>(params.search_length, k), ntotal);
+        while (true) {
+            GetNeighbors(single_query, data, result, nsg, length, k, bitset);
+            if (result.size() >= k || length >= ntotal) {
+                break;
+            }
+            length = std::min(length * 2, ntotal);
+        }
+    };
 
     TimeRecorder rc("NsgIndex::search", 1);
     if (nq == 1) {
-        GetNeighbors(query, data, resset[0], nsg, &params);
+        search_one(query, resset[0]);
     } else {
 #pragma omp parallel for
         for (unsigned int i = 0; i < nq; ++i) {
             const float* single_query = query + i * dim;
-            GetNeighbors(single_query, data, resset[i], nsg, &params);
+            search_one(single_query, resset[i]);
         }
     }
     rc.RecordSection("search");
     for (unsigned int i = 0; i < nq; ++i) {
         unsigned int pos = 0;
-        for (unsigned int j = 0; j < resset[i].size(); ++j) {
-            if (pos >= k)
-                break;  // already top k
-            if (!bitset || !bitset->test((faiss::ConcurrentBitset::id_type_t)resset[i][j].id)) {
-                ids[i * k + pos] = ids_[resset[i][j].id];
-                dist[i * k + pos] = resset[i][j].distance;
-                ++pos;
-            }
+        for (; pos < resset[i].size() && pos < k; ++pos) {
+            ids[i * k + pos] = ids_[resset[i][pos].id];
+            dist[i * k + pos] = resset[i][pos].distance;
         }
         // fill with -1
         for (unsigned int j = pos; j < k; ++j) {
@@ -13,12 +13,14 @@
 
 #include <boost/dynamic_bitset.hpp>
 #include <cstddef>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
 
 #include "Distance.h"
 #include "Neighbor.h"
+#include "hnswlib/visited_list_pool.h"
 #include "knowhere/common/Config.h"
 #include "knowhere/index/vector_index/helpers/IndexParameter.h"
 
@@ -64,6 +66,9 @@ class NsgIndex {
     size_t candidate_pool_size;  // search deepth in fullset
     size_t out_degree;
 
+    // visited flags of the search, reset by bumping a tag instead of clearing ntotal bits per query
+    std::shared_ptr<hnswlib::VisitedListPool> visited_list_pool_;
+
  public:
     explicit NsgIndex(const size_t& dimension, const size_t& n, std::string metric = knowhere::Metric::L2);
 
@@ -107,10 +112,10 @@ class NsgIndex {
     void
     GetNeighbors(const float* query, float* data, std::vector<Neighbor>& resset, std::vector<Neighbor>& fullset);
 
-    // navigation-point
+    // navigation-point, walks through the nodes in bitset but returns only the other nodes, the nearest k of them
     void
-    GetNeighbors(const float* query, float* data, std::vector<Neighbor>& resset, Graph& graph,
-                 SearchParams* param = nullptr);
+    GetNeighbors(const float* query, float* data, std::vector<Neighbor>& resset, Graph& graph, size_t search_length,
+                 size_t k, const faiss::ConcurrentBitsetPtr& bitset);
 
     // only for search
     // void
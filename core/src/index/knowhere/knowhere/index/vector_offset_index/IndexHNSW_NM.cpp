@@ -170,6 +170,60 @@ IndexHNSW_NM::Query(const DatasetPtr& dataset_ptr, const Config& config) {
     return ret_ds;
 }
 
+DatasetPtr
+IndexHNSW_NM::QueryByRange(const DatasetPtr& dataset_ptr, const Config& config) {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize or trained");
+    }
+    GETTENSOR(dataset_ptr)
+
+    size_t ef = config[IndexParams::ef].get<int64_t>();
+    index_->setEf(ef);
+
+    // hnswlib keeps 1 - ip as the distance of inner product
+    float radius = config[IndexParams::radius].get<float>();
+    float threshold = normalize ? 1 - radius : radius;
+    size_t count = index_->cur_element_count;
+
+    using P = std::pair<float, int64_t>;
+    auto compare = [](const P& v1, const P& v2) { return v1.first < v2.first; };
+
+    std::vector<std::vector<P>> results(rows);
+    faiss::ConcurrentBitsetPtr blacklist = GetBlacklist();
+#pragma omp parallel for
+    for (unsigned int i = 0; i < rows; ++i) {
+        const float* single_query = (float*)p_data + i * dim;
+
+        // the graph only gives the k nearest neighbors, ask for more while all of them are in range
+        std::vector<P> ret;
+        for (size_t k = ef;; k *= 2) {
+            ret = index_->searchKnn_NM((void*)single_query, k, compare, blacklist, (float*)(data_.get()));
+            if (ret.size() < k || ret.back().first >= threshold || k >= count) {
+                break;
+            }
+        }
+        auto end = std::lower_bound(ret.begin(), ret.end(), threshold,
+                                    [](const P& e, float value) { return e.first < value; });
+        ret.erase(end, ret.end());
+        results[i].swap(ret);
+    }
+
+    std::vector<size_t> lims(rows + 1, 0);
+    for (int64_t i = 0; i < rows; ++i) {
+        lims[i + 1] = lims[i] + results[i].size();
+    }
+    std::vector<int64_t> ids(lims[rows]);
+    std::vector<float> dist(lims[rows]);
+    for (int64_t i = 0; i < rows; ++i) {
+        for (size_t j = 0; j < results[i].size(); ++j) {
+            dist[lims[i] + j] = normalize ? 1 - results[i][j].first : results[i][j].first;
+            ids[lims[i] + j] = results[i][j].second;
+        }
+    }
+
+    return GenRangeResultDataset(rows, lims.data(), ids.data(), dist.data(), !normalize);
+}
+
 int64_t
 IndexHNSW_NM::Count() {
     if (!index_) {
@@ -186,5 +240,15 @@ IndexHNSW_NM::Dim() {
     return (*(size_t*)index_->dist_func_param_);
 }
 
+bool
+IndexHNSW_NM::GetVectorByOffset(int64_t offset, uint8_t* data) {
+    if (!data_ || offset < 0 || offset >= Count()) {
+        return false;
+    }
+    auto vec_size = Dim() * sizeof(float);
+    memcpy(data, data_.get() + offset * vec_size, vec_size);
+    return true;
+}
+
 }  // namespace knowhere
 }  // namespace milvus
@@ -49,12 +49,18 @@ class IndexHNSW_NM : public VecIndex {
     DatasetPtr
     Query(const DatasetPtr& dataset_ptr, const Config& config) override;
 
+    DatasetPtr
+    QueryByRange(const DatasetPtr& dataset_ptr, const Config& config) override;
+
     int64_t
     Count() override;
 
     int64_t
     Dim() override;
 
+    bool
+    GetVectorByOffset(int64_t offset, uint8_t* data) override;
+
  private:
     bool normalize = false;
     std::mutex mutex_;
@@ -0,0 +1,285 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "knowhere/index/vector_offset_index/IndexHNSW_SQ8NM.h"
+
+#include <faiss/FaissHook.h>
+#include <faiss/index_io.h>
+#include <faiss/utils/distances.h>
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "faiss/BuilderSuspend.h"
+#include "hnswlib/space_ip.h"
+#include "hnswlib/space_l2.h"
+#include "knowhere/common/Exception.h"
+#include "knowhere/common/Log.h"
+#include "knowhere/index/vector_index/adapter/VectorAdapter.h"
+#include "knowhere/index/vector_index/helpers/FaissIO.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
+
+namespace milvus {
+namespace knowhere {
+
+namespace {
+// distance of a query to the SQ8 code of a node, in the hnswlib convention: 1 - ip for inner product
+struct SQ8Distance {
+    faiss::DistanceComputer* dc;
+    const uint8_t* codes;
+    size_t code_size;
+    bool ip;
+
+    float
+    operator()(hnswlib::tableint id) const {
+        float dist = (*dc)(id);
+        return ip ? 1 - dist : dist;
+    }
+
+    const char*
+    address(hnswlib::tableint id) const {
+        return (const char*)(codes + id * code_size);
+    }
+};
+}  // namespace
+
+BinarySet
+IndexHNSW_SQ8NM::Serialize(const Config& config) {
+    if (!index_ || !sq_index_) {
+        KNOWHERE_THROW_MSG("index not initialize or trained");
+    }
+
+    try {
+        MemoryIOWriter writer;
+        index_->saveIndex(writer);
+        std::shared_ptr<uint8_t[]> data(writer.data_);
+
+        MemoryIOWriter sq_writer;
+        sq_writer(&refine_factor_, sizeof(refine_factor_), 1);
+        faiss::write_index(sq_index_.get(), &sq_writer);
+        std::shared_ptr<uint8_t[]> sq_data(sq_writer.data_);
+
+        BinarySet res_set;
+        res_set.Append("HNSW", data, writer.rp);
+        res_set.Append("SQ8", sq_data, sq_writer.rp);
+        return res_set;
+    } catch (std::exception& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    }
+}
+
+void
+IndexHNSW_SQ8NM::Load(const BinarySet& index_binary) {
+    try {
+        auto binary = index_binary.GetByName("HNSW");
+
+        MemoryIOReader reader;
+        reader.total = binary->size;
+        reader.data_ = binary->data.get();
+
+        hnswlib::SpaceInterface<float>* space;
+        index_ = std::make_shared<hnswlib::HierarchicalNSW_NM<float>>(space);
+        index_->loadIndex(reader);
+
+        normalize = (index_->metric_type_ == 1);  // 1 == InnerProduct
+
+        auto sq_binary = index_binary.GetByName("SQ8");
+        MemoryIOReader sq_reader;
+        sq_reader.total = sq_binary->size;
+        sq_reader.data_ = sq_binary->data.get();
+        sq_reader(&refine_factor_, sizeof(refine_factor_), 1);
+        auto sq_index = dynamic_cast<faiss::IndexScalarQuantizer*>(faiss::read_index(&sq_reader));
+        if (sq_index == nullptr) {
+            KNOWHERE_THROW_MSG("Load Error, binary is not a scalar quantizer index");
+        }
+        sq_index_.reset(sq_index);
+
+        // raw vectors are optional, they are only used to re-rank the candidates
+        auto raw_iter = index_binary.binary_map_.find(RAW_DATA);
+        raw_data_ = (raw_iter != index_binary.binary_map_.end()) ? raw_iter->second->data : nullptr;
+    } catch (std::exception& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    }
+}
+
+void
+IndexHNSW_SQ8NM::Train(const DatasetPtr& dataset_ptr, const Config& config) {
+    try {
+        GETTENSOR(dataset_ptr)
+
+        hnswlib::SpaceInterface<float>* space;
+        if (config[Metric::TYPE] == Metric::L2) {
+            space = new hnswlib::L2Space(dim);
+        } else if (config[Metric::TYPE] == Metric::IP) {
+            space = new hnswlib::InnerProductSpace(dim);
+            normalize = true;
+        }
+        index_ = std::make_shared<hnswlib::HierarchicalNSW_NM<float>>(
+            space, rows, config[IndexParams::M].get<int64_t>(), config[IndexParams::efConstruction].get<int64_t>());
+
+        auto metric_type = GetMetricType(config[Metric::TYPE].get<std::string>());
+        sq_index_ = std::make_shared<faiss::IndexScalarQuantizer>(dim, faiss::QuantizerType::QT_8bit, metric_type);
+        sq_index_->train(rows, (const float*)p_data);
+
+        if (config.contains(IndexParams::refine_factor)) {
+            refine_factor_ = config[IndexParams::refine_factor].get<int64_t>();
+        }
+    } catch (std::exception& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    }
+}
+
+void
+IndexHNSW_SQ8NM::Add(const DatasetPtr& dataset_ptr, const Config& config) {
+    if (!index_ || !sq_index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+
+    std::lock_guard<std::mutex> lk(mutex_);
+
+    GETTENSORWITHIDS(dataset_ptr)
+
+    // the graph is built on the float vectors, only their codes are kept
+    sq_index_->add(rows, (const float*)p_data);
+
+    auto base = index_->getCurrentElementCount();
+    auto pp_data = const_cast<void*>(p_data);
+    index_->addPoint(pp_data, p_ids[0], base, 0);
+#pragma omp parallel for
+    for (int i = 1; i < rows; ++i) {
+        faiss::BuilderSuspend::check_wait();
+        index_->addPoint(pp_data, p_ids[i], base, i);
+    }
+}
+
+DatasetPtr
+IndexHNSW_SQ8NM::Query(const DatasetPtr& dataset_ptr, const Config& config) {
+    if (!index_ || !sq_index_) {
+        KNOWHERE_THROW_MSG("index not initialize or trained");
+    }
+    GETTENSOR(dataset_ptr)
+
+    size_t k = config[meta::TOPK].get<int64_t>();
+    size_t id_size = sizeof(int64_t) * k;
+    size_t dist_size = sizeof(float) * k;
+    auto p_id = (int64_t*)malloc(id_size * rows);
+    auto p_dist = (float*)malloc(dist_size * rows);
+
+    size_t ef = config[IndexParams::ef].get<int64_t>();
+    index_->setEf(ef);
+
+    int64_t refine_factor = refine_factor_;
+    if (config.contains(IndexParams::refine_factor)) {
+        refine_factor = config[IndexParams::refine_factor].get<int64_t>();
+    }
+    bool refine = raw_data_ != nullptr && refine_factor > 1;
+    // all the ef candidates of the graph search are re-ranked
+    size_t candidates = refine ? std::max(ef, k * refine_factor) : k;
+
+    using P = std::pair<float, int64_t>;
+    auto compare = [](const P& v1, const P& v2) { return v1.first < v2.first; };
+
+    faiss::ConcurrentBitsetPtr blacklist = GetBlacklist();
+#pragma omp parallel for
+    for (unsigned int i = 0; i < rows; ++i) {
+        const float* single_query = (float*)p_data + i * dim;
+
+        std::unique_ptr<faiss::DistanceComputer> dc(sq_index_->get_distance_computer());
+        dc->set_query(single_query);
+        SQ8Distance sq8_distance{dc.get(), sq_index_->codes.data(), sq_index_->code_size, normalize};
+
+        auto queue = index_->searchKnn_NM(sq8_distance, candidates, blacklist);
+        std::vector<P> ret;
+        ret.reserve(queue.size());
+        while (!queue.empty()) {
+            ret.push_back(queue.top());
+            queue.pop();
+        }
+
+        if (refine) {
+            Refine(single_query, k, ret);
+        } else {
+            std::sort(ret.begin(), ret.end(), compare);
+        }
+
+        while (ret.size() < k) {
+            ret.emplace_back(std::make_pair(-1, -1));
+        }
+        std::vector<float> dist;
+        std::vector<int64_t> ids;
+
+        if (normalize) {
+            std::transform(ret.begin(), ret.end(), std::back_inserter(dist),
+                           [](const std::pair<float, int64_t>& e) { return float(1 - e.first); });
+        } else {
+            std::transform(ret.begin(), ret.end(), std::back_inserter(dist),
+                           [](const std::pair<float, int64_t>& e) { return e.first; });
+        }
+        std::transform(ret.begin(), ret.end(), std::back_inserter(ids),
+                       [](const std::pair<float, int64_t>& e) { return e.second; });
+
+        memcpy(p_dist + i * k, dist.data(), dist_size);
+        memcpy(p_id + i * k, ids.data(), id_size);
+    }
+
+    auto ret_ds = std::make_shared<Dataset>();
+    ret_ds->Set(meta::IDS, p_id);
+    ret_ds->Set(meta::DISTANCE, p_dist);
+    return ret_ds;
+}
+
+void
+IndexHNSW_SQ8NM::Refine(const float* query, size_t k, std::vector<std::pair<float, int64_t>>& candidates) {
+    size_t dim = sq_index_->d;
+    auto raw_data = (const float*)raw_data_.get();
+    for (auto& candidate : candidates) {
+        const float* x = raw_data + candidate.second * dim;
+        candidate.first = normalize ? 1 - faiss::fvec_inner_product(query, x, dim) : faiss::fvec_L2sqr(query, x, dim);
+    }
+
+    k = std::min(k, candidates.size());
+    std::partial_sort(candidates.begin(), candidates.begin() + k, candidates.end(),
+                      [](const std::pair<float, int64_t>& v1, const std::pair<float, int64_t>& v2) {
+                          return v1.first < v2.first;
+                      });
+    candidates.resize(k);
+}
+
+int64_t
+IndexHNSW_SQ8NM::Count() {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+    return index_->cur_element_count;
+}
+
+int64_t
+IndexHNSW_SQ8NM::Dim() {
+    if (!sq_index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+    return sq_index_->d;
+}
+
+bool
+IndexHNSW_SQ8NM::GetVectorByOffset(int64_t offset, uint8_t* data) {
+    if (!raw_data_ || offset < 0 || offset >= Count()) {
+        return false;
+    }
+    auto vec_size = Dim() * sizeof(float);
+    memcpy(data, raw_data_.get() + offset * vec_size, vec_size);
+    return true;
+}
+
+}  // namespace knowhere
+}  // namespace milvus
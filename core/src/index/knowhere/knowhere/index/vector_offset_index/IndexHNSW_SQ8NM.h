@@ -0,0 +1,90 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <faiss/IndexScalarQuantizer.h>
+
+#include "hnswlib/hnswalg_nm.h"
+#include "hnswlib/hnswlib.h"
+
+#include "knowhere/common/Exception.h"
+#include "knowhere/index/vector_index/VecIndex.h"
+
+namespace milvus {
+namespace knowhere {
+
+/*
+ * HNSW graph searched on 8-bit scalar quantized vectors.
+ *
+ * The graph is built on the float vectors like IndexHNSW_NM, the codes are kept in a faiss IndexScalarQuantizer and
+ * scored by the SQ8 distance computers selected in FaissHook, so the raw vectors are not needed to search. When they
+ * are attached to the binary set as RAW_DATA and refine_factor > 1, the ef candidates of the graph search are
+ * re-ranked with exact distances.
+ */
+class IndexHNSW_SQ8NM : public VecIndex {
+ public:
+    IndexHNSW_SQ8NM() {
+        index_type_ = IndexEnum::INDEX_HNSW_SQ8;
+    }
+
+    BinarySet
+    Serialize(const Config& config = Config()) override;
+
+    void
+    Load(const BinarySet& index_binary) override;
+
+    void
+    Train(const DatasetPtr& dataset_ptr, const Config& config) override;
+
+    void
+    Add(const DatasetPtr& dataset_ptr, const Config& config) override;
+
+    void
+    AddWithoutIds(const DatasetPtr&, const Config&) override {
+        KNOWHERE_THROW_MSG("Incremental index is not supported");
+    }
+
+    DatasetPtr
+    Query(const DatasetPtr& dataset_ptr, const Config& config) override;
+
+    int64_t
+    Count() override;
+
+    int64_t
+    Dim() override;
+
+    bool
+    GetVectorByOffset(int64_t offset, uint8_t* data) override;
+
+ private:
+    void
+    Refine(const float* query, size_t k, std::vector<std::pair<float, int64_t>>& candidates);
+
+ private:
+    bool normalize = false;
+    std::mutex mutex_;
+    std::shared_ptr<hnswlib::HierarchicalNSW_NM<float>> index_ = nullptr;
+    std::shared_ptr<faiss::IndexScalarQuantizer> sq_index_ = nullptr;
+    int64_t refine_factor_ = 1;
+
+    std::shared_ptr<uint8_t[]> raw_data_ = nullptr;
+};
+
+using IndexHNSW_SQ8NMPtr = std::shared_ptr<IndexHNSW_SQ8NM>;
+
+}  // namespace knowhere
+}  // namespace milvus
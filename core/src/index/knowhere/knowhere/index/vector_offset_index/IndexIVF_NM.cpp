@@ -17,6 +17,7 @@
 #include <faiss/IndexIVFPQ.h>
 #include <faiss/clone_index.h>
 #include <faiss/index_factory.h>
+#include <faiss/impl/AuxIndexStructures.h>
 #include <faiss/index_io.h>
 #ifdef MILVUS_GPU_VERSION
 #include <faiss/gpu/GpuAutoTune.h>
@@ -70,6 +71,7 @@ IVF_NM::Load(const BinarySet& binary_set) {
     auto nb = (size_t)(binary->size / invlists->code_size);
     auto arranged_data = new uint8_t[d * sizeof(float) * nb];
     prefix_sum.resize(invlists->nlist);
+    arranged_offsets_.resize(nb);
     size_t curr_index = 0;
 
 #ifndef MILVUS_GPU_VERSION
@@ -79,6 +81,7 @@ IVF_NM::Load(const BinarySet& binary_set) {
         for (int j = 0; j < list_size; j++) {
             memcpy(arranged_data + d * sizeof(float) * (curr_index + j), original_data + d * ails->ids[i][j],
                    d * sizeof(float));
+            arranged_offsets_[ails->ids[i][j]] = curr_index + j;
         }
         prefix_sum[i] = curr_index;
         curr_index += list_size;
@@ -92,6 +95,7 @@ IVF_NM::Load(const BinarySet& binary_set) {
         for (int j = 0; j < list_size; j++) {
             memcpy(arranged_data + d * sizeof(float) * (curr_index + j), original_data + d * rol_ids[curr_index + j],
                    d * sizeof(float));
+            arranged_offsets_[rol_ids[curr_index + j]] = curr_index + j;
         }
         prefix_sum[i] = curr_index;
         curr_index += list_size;
@@ -100,6 +104,16 @@ IVF_NM::Load(const BinarySet& binary_set) {
     data_ = std::shared_ptr<uint8_t[]>(arranged_data);
 }
 
+bool
+IVF_NM::GetVectorByOffset(int64_t offset, uint8_t* data) {
+    if (!data_ || offset < 0 || offset >= (int64_t)arranged_offsets_.size()) {
+        return false;
+    }
+    auto vec_size = Dim() * sizeof(float);
+    memcpy(data, data_.get() + arranged_offsets_[offset] * vec_size, vec_size);
+    return true;
+}
+
 void
 IVF_NM::Train(const DatasetPtr& dataset_ptr, const Config& config) {
     GETTENSOR(dataset_ptr)
@@ -167,6 +181,34 @@ IVF_NM::Query(const DatasetPtr& dataset_ptr, const Config& config) {
     }
 }
 
+DatasetPtr
+IVF_NM::QueryByRange(const DatasetPtr& dataset_ptr, const Config& config) {
+    if (!index_ || !index_->is_trained) {
+        KNOWHERE_THROW_MSG("index not initialize or trained");
+    }
+
+    GETTENSOR(dataset_ptr)
+
+    try {
+        auto params = GenParams(config);
+        auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_.get());
+        ivf_index->nprobe = params->nprobe;
+        ivf_index->parallel_mode = (params->nprobe > 1 && rows <= 4) ? 1 : 0;
+
+        float radius = config[IndexParams::radius].get<float>();
+        faiss::RangeSearchResult res(rows);
+        ivf_index->range_search_without_codes(rows, (float*)p_data, (const uint8_t*)data_.get(), prefix_sum, radius,
+                                              &res, bitset_);
+
+        return GenRangeResultDataset(rows, res.lims, res.labels, res.distances,
+                                     ivf_index->metric_type != faiss::METRIC_INNER_PRODUCT);
+    } catch (faiss::FaissException& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    } catch (std::exception& e) {
+        KNOWHERE_THROW_MSG(e.what());
+    }
+}
+
 #if 0
 DatasetPtr
 IVF_NM::QueryById(const DatasetPtr& dataset_ptr, const Config& config) {
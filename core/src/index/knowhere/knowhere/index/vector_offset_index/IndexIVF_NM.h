@@ -53,6 +53,9 @@ class IVF_NM : public VecIndex, public OffsetBaseIndex {
     DatasetPtr
     Query(const DatasetPtr&, const Config&) override;
 
+    DatasetPtr
+    QueryByRange(const DatasetPtr&, const Config&) override;
+
 #if 0
     DatasetPtr
     QueryById(const DatasetPtr& dataset, const Config& config) override;
@@ -69,6 +72,9 @@ class IVF_NM : public VecIndex, public OffsetBaseIndex {
     GetVectorById(const DatasetPtr& dataset, const Config& config) override;
 #endif
 
+    bool
+    GetVectorByOffset(int64_t offset, uint8_t* data) override;
+
     virtual void
     Seal();
 
@@ -92,6 +98,8 @@ class IVF_NM : public VecIndex, public OffsetBaseIndex {
     std::mutex mutex_;
     std::shared_ptr<uint8_t[]> data_ = nullptr;
     std::vector<size_t> prefix_sum;
+    // position of every vector in the arranged data, indexed by its offset
+    std::vector<size_t> arranged_offsets_;
 };
 
 using IVFNMPtr = std::shared_ptr<IVF_NM>;
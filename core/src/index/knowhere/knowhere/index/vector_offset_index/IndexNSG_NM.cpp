@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include <fiu-local.h>
+#include <cstring>
 #include <string>
 
 #include "knowhere/common/Exception.h"
@@ -18,6 +19,7 @@
 #include "knowhere/index/vector_index/IndexIVF.h"
 #include "knowhere/index/vector_index/IndexType.h"
 #include "knowhere/index/vector_index/adapter/VectorAdapter.h"
+#include "knowhere/index/vector_index/impl/nsg/NNDescent.h"
 #include "knowhere/index/vector_index/impl/nsg/NSGIO.h"
 #include "knowhere/index/vector_offset_index/IndexNSG_NM.h"
 
@@ -111,30 +113,40 @@ NSG_NM::Query(const DatasetPtr& dataset_ptr, const Config& config) {
 
 void
 NSG_NM::Train(const DatasetPtr& dataset_ptr, const Config& config) {
-    auto idmap = std::make_shared<IDMAP>();
-    idmap->Train(dataset_ptr, config);
-    idmap->AddWithoutIds(dataset_ptr, config);
+    GETTENSOR(dataset_ptr)
     impl::Graph knng;
-    const float* raw_data = idmap->GetRawVectors();
     const int64_t k = config[IndexParams::knng].get<int64_t>();
+    if (config.contains(IndexParams::knng_builder) &&
+        config[IndexParams::knng_builder].get<std::string>() == KnngBuilder::NN_DESCENT) {
+        // build knng straight from the raw vectors, no IDMAP/IVF copy of the data is needed
+        impl::NNDescentParams nnd_params;
+        nnd_params.k = k;
+        impl::NNDescent builder(dim, rows, config[Metric::TYPE].get<std::string>());
+        builder.Build((const float*)p_data, nnd_params, knng);
+    } else {
+        auto idmap = std::make_shared<IDMAP>();
+        idmap->Train(dataset_ptr, config);
+        idmap->AddWithoutIds(dataset_ptr, config);
+        const float* raw_data = idmap->GetRawVectors();
 #ifdef MILVUS_GPU_VERSION
-    const int64_t device_id = config[knowhere::meta::DEVICEID].get<int64_t>();
-    if (device_id == -1) {
+        const int64_t device_id = config[knowhere::meta::DEVICEID].get<int64_t>();
+        if (device_id == -1) {
+            auto preprocess_index = std::make_shared<IVF>();
+            preprocess_index->Train(dataset_ptr, config);
+            preprocess_index->AddWithoutIds(dataset_ptr, config);
+            preprocess_index->GenGraph(raw_data, k, knng, config);
+        } else {
+            auto gpu_idx = cloner::CopyCpuToGpu(idmap, device_id, config);
+            auto gpu_idmap = std::dynamic_pointer_cast<GPUIDMAP>(gpu_idx);
+            gpu_idmap->GenGraph(raw_data, k, knng, config);
+        }
+#else
         auto preprocess_index = std::make_shared<IVF>();
         preprocess_index->Train(dataset_ptr, config);
         preprocess_index->AddWithoutIds(dataset_ptr, config);
         preprocess_index->GenGraph(raw_data, k, knng, config);
-    } else {
-        auto gpu_idx = cloner::CopyCpuToGpu(idmap, device_id, config);
-        auto gpu_idmap = std::dynamic_pointer_cast<GPUIDMAP>(gpu_idx);
-        gpu_idmap->GenGraph(raw_data, k, knng, config);
-    }
-#else
-    auto preprocess_index = std::make_shared<IVF>();
-    preprocess_index->Train(dataset_ptr, config);
-    preprocess_index->AddWithoutIds(dataset_ptr, config);
-    preprocess_index->GenGraph(raw_data, k, knng, config);
 #endif
+    }
 
     impl::BuildParams b_params;
     b_params.candidate_pool_size = config[IndexParams::candidate];
@@ -143,7 +155,6 @@ NSG_NM::Train(const DatasetPtr& dataset_ptr, const Config& config) {
 
     auto p_ids = dataset_ptr->Get<const int64_t*>(meta::IDS);
 
-    GETTENSOR(dataset_ptr)
     index_ = std::make_shared<impl::NsgIndex>(dim, rows, config[Metric::TYPE].get<std::string>());
     index_->SetKnnGraph(knng);
     index_->Build_with_ids(rows, (float*)p_data, (int64_t*)p_ids, b_params);
@@ -165,5 +176,15 @@ NSG_NM::Dim() {
     return index_->dimension;
 }
 
+bool
+NSG_NM::GetVectorByOffset(int64_t offset, uint8_t* data) {
+    if (!data_ || offset < 0 || offset >= Count()) {
+        return false;
+    }
+    auto vec_size = Dim() * sizeof(float);
+    memcpy(data, data_.get() + offset * vec_size, vec_size);
+    return true;
+}
+
 }  // namespace knowhere
 }  // namespace milvus
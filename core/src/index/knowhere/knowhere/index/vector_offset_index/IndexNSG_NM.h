@@ -67,6 +67,9 @@ class NSG_NM : public VecIndex {
     int64_t
     Dim() override;
 
+    bool
+    GetVectorByOffset(int64_t offset, uint8_t* data) override;
+
  private:
     std::mutex mutex_;
     int64_t gpu_;
@@ -184,7 +184,8 @@ namespace SPTAG
                 return true;
             }
 
-            // Functions for loading models from memory mapped files
+            // Functions for loading models from memory mapped files, the memory is referenced
+            // instead of copied and must outlive the dataset
             bool Load(char* pDataPointsMemFile)
             {
                 SizeType R;
@@ -195,8 +196,11 @@ namespace SPTAG
                 C = *((DimensionType*)pDataPointsMemFile);
                 pDataPointsMemFile += sizeof(DimensionType);
 
-                Initialize(R, C, (T*)pDataPointsMemFile, false);
-                std::cout << "Load " << name << " (" << R << ", " << C << ") Finish!" << std::endl;
+                if (ownData) aligned_free(data);
+                rows = R;
+                cols = C;
+                data = (T*)pDataPointsMemFile;
+                ownData = false;
                 return true;
             }
 
@@ -29,6 +29,9 @@ public:
     virtual ErrorCode DeleteIndex(const void* p_vectors, SizeType p_vectorNum) = 0;
 
     virtual ErrorCode SearchIndex(QueryResult& p_results) const = 0;
+
+    // p_filter is a bitmap over the sample ids, the points whose bit is set are not returned
+    virtual ErrorCode SearchIndex(QueryResult& p_results, const std::uint8_t* p_filter) const = 0;
     
     virtual float ComputeDistance(const void* pX, const void* pY) const = 0;
     virtual const void* GetSample(const SizeType idx) const = 0;
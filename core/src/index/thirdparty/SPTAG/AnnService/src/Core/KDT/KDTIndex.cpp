@@ -144,14 +144,31 @@ namespace SPTAG
             Search(;)
         }
 
+        // filtered points are still expanded, so the graph stays connected around them
+        template <typename T>
+        void Index<T>::SearchIndexWithFilter(COMMON::QueryResultSet<T> &p_query, COMMON::WorkSpace &p_space, const std::uint8_t* p_filter) const
+        {
+            bool checkDeleted = m_deletedID.size() > 0;
+            Search(if (!(p_filter[gnode.node >> 3] & (1 << (gnode.node & 7))) && (!checkDeleted || !m_deletedID.contains(gnode.node))))
+        }
+
         template<typename T>
         ErrorCode
             Index<T>::SearchIndex(QueryResult &p_query) const
+        {
+            return SearchIndex(p_query, nullptr);
+        }
+
+        template<typename T>
+        ErrorCode
+            Index<T>::SearchIndex(QueryResult &p_query, const std::uint8_t* p_filter) const
         {
             auto workSpace = m_workSpacePool->Rent();
             workSpace->Reset(m_iMaxCheck);
 
-            if (m_deletedID.size() > 0)
+            if (p_filter != nullptr)
+                SearchIndexWithFilter(*((COMMON::QueryResultSet<T>*)&p_query), *workSpace, p_filter);
+            else if (m_deletedID.size() > 0)
                 SearchIndexWithDeleted(*((COMMON::QueryResultSet<T>*)&p_query), *workSpace, m_deletedID);
             else
                 SearchIndexWithoutDeleted(*((COMMON::QueryResultSet<T>*)&p_query), *workSpace);
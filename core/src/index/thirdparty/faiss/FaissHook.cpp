@@ -13,6 +13,11 @@
 #include <faiss/utils/distances_avx.h>
 #include <faiss/utils/distances_avx512.h>
 #include <faiss/utils/instruction_set.h>
+#include <faiss/utils/pq4_fast_scan.h>
+#include <faiss/utils/pq4_fast_scan_avx.h>
+#include <faiss/utils/popcount.h>
+#include <faiss/utils/popcount_avx.h>
+#include <faiss/utils/popcount_avx512.h>
 
 namespace faiss {
 
@@ -30,6 +35,11 @@ sq_get_distance_computer_func_ptr sq_get_distance_computer = sq_get_distance_com
 sq_sel_quantizer_func_ptr sq_sel_quantizer = sq_select_quantizer_avx;
 sq_sel_inv_list_scanner_func_ptr sq_sel_inv_list_scanner = sq_select_inverted_list_scanner_avx;
 
+pq4_accumulate_func_ptr pq4_accumulate_block = pq4_accumulate_block_avx;
+
+popcount_xor_func_ptr popcount_xor = popcount_xor_avx;
+popcount_and_or_func_ptr popcount_and_or = popcount_and_or_avx;
+
 /*****************************************************************************/
 
 bool support_avx512() {
@@ -41,6 +51,13 @@ bool support_avx512() {
             instruction_set_inst.AVX512BW());
 }
 
+bool support_avx512_vpopcntdq() {
+    if (!support_avx512()) return false;
+
+    InstructionSet& instruction_set_inst = InstructionSet::GetInstance();
+    return (instruction_set_inst.AVX512VPOPCNTDQ());
+}
+
 bool support_avx2() {
     if (!faiss_use_avx2) return false;
 
@@ -71,6 +88,18 @@ bool hook_init(std::string& cpu_flag) {
         sq_sel_quantizer = sq_select_quantizer_avx512;
         sq_sel_inv_list_scanner = sq_select_inverted_list_scanner_avx512;
 
+        /* for IVFPQ fast scan */
+        pq4_accumulate_block = pq4_accumulate_block_avx;
+
+        /* for binary metrics */
+        if (support_avx512_vpopcntdq()) {
+            popcount_xor = popcount_xor_avx512;
+            popcount_and_or = popcount_and_or_avx512;
+        } else {
+            popcount_xor = popcount_xor_avx;
+            popcount_and_or = popcount_and_or_avx;
+        }
+
         cpu_flag = "AVX512";
     } else if (support_avx2()) {
         /* for IVFFLAT */
@@ -84,6 +113,13 @@ bool hook_init(std::string& cpu_flag) {
         sq_sel_quantizer = sq_select_quantizer_avx;
         sq_sel_inv_list_scanner = sq_select_inverted_list_scanner_avx;
 
+        /* for IVFPQ fast scan */
+        pq4_accumulate_block = pq4_accumulate_block_avx;
+
+        /* for binary metrics */
+        popcount_xor = popcount_xor_avx;
+        popcount_and_or = popcount_and_or_avx;
+
         cpu_flag = "AVX2";
     } else if (support_sse()) {
         /* for IVFFLAT */
@@ -97,6 +133,13 @@ bool hook_init(std::string& cpu_flag) {
         sq_sel_quantizer = sq_select_quantizer_ref;
         sq_sel_inv_list_scanner = sq_select_inverted_list_scanner_ref;
 
+        /* for IVFPQ fast scan */
+        pq4_accumulate_block = pq4_accumulate_block_ref;
+
+        /* for binary metrics */
+        popcount_xor = popcount_xor_ref;
+        popcount_and_or = popcount_and_or_ref;
+
         cpu_flag = "SSE42";
     } else {
         cpu_flag = "UNSUPPORTED";
@@ -5,6 +5,7 @@
 
 #include <vector>
 #include <stddef.h>
+#include <stdint.h>
 #include <string>
 #include <faiss/impl/ScalarQuantizer.h>
 #include <faiss/impl/ScalarQuantizerOp.h>
@@ -18,6 +19,11 @@ typedef SQDistanceComputer* (*sq_get_distance_computer_func_ptr)(MetricType, Qua
 typedef Quantizer* (*sq_sel_quantizer_func_ptr)(QuantizerType, size_t, const std::vector<float>&);
 typedef InvertedListScanner* (*sq_sel_inv_list_scanner_func_ptr)(MetricType, const ScalarQuantizer*, const Index*, size_t, bool, bool);
 
+typedef void (*pq4_accumulate_func_ptr)(size_t, const uint8_t*, const uint8_t*, uint16_t*);
+
+typedef size_t (*popcount_xor_func_ptr)(const uint8_t*, const uint8_t*, size_t);
+typedef void (*popcount_and_or_func_ptr)(const uint8_t*, const uint8_t*, size_t, size_t*, size_t*);
+
 extern bool faiss_use_avx512;
 extern bool faiss_use_avx2;
 extern bool faiss_use_sse;
@@ -31,7 +37,13 @@ extern sq_get_distance_computer_func_ptr sq_get_distance_computer;
 extern sq_sel_quantizer_func_ptr sq_sel_quantizer;
 extern sq_sel_inv_list_scanner_func_ptr sq_sel_inv_list_scanner;
 
+extern pq4_accumulate_func_ptr pq4_accumulate_block;
+
+extern popcount_xor_func_ptr popcount_xor;
+extern popcount_and_or_func_ptr popcount_and_or;
+
 extern bool support_avx512();
+extern bool support_avx512_vpopcntdq();
 extern bool support_avx2();
 extern bool support_sse();
 
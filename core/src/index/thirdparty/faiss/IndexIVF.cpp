@@ -807,12 +807,44 @@ void IndexIVF::range_search (idx_t nx, const float *x, float radius,
     indexIVF_stats.search_time += getmillisecs() - t0;
 }
 
+void IndexIVF::range_search_without_codes (idx_t nx, const float *x,
+                                           const uint8_t *arranged_codes, std::vector<size_t> prefix_sum,
+                                           float radius, RangeSearchResult *result,
+                                           ConcurrentBitsetPtr bitset)
+{
+    std::unique_ptr<idx_t[]> keys (new idx_t[nx * nprobe]);
+    std::unique_ptr<float []> coarse_dis (new float[nx * nprobe]);
+
+    double t0 = getmillisecs();
+    quantizer->search (nx, x, nprobe, coarse_dis.get (), keys.get ());
+    indexIVF_stats.quantization_time += getmillisecs() - t0;
+
+    t0 = getmillisecs();
+    invlists->prefetch_lists (keys.get(), nx * nprobe);
+
+    range_search_preassigned_without_codes (nx, x, arranged_codes, prefix_sum, radius, keys.get (),
+                                            coarse_dis.get (), result, bitset);
+
+    indexIVF_stats.search_time += getmillisecs() - t0;
+}
+
 void IndexIVF::range_search_preassigned (
          idx_t nx, const float *x, float radius,
          const idx_t *keys, const float *coarse_dis,
          RangeSearchResult *result,
          ConcurrentBitsetPtr bitset) const
 {
+    range_search_preassigned_without_codes (nx, x, nullptr, std::vector<size_t>(), radius, keys, coarse_dis,
+                                            result, bitset);
+}
+
+void IndexIVF::range_search_preassigned_without_codes (
+         idx_t nx, const float *x,
+         const uint8_t *arranged_codes, const std::vector<size_t> &prefix_sum,
+         float radius, const idx_t *keys, const float *coarse_dis,
+         RangeSearchResult *result,
+         ConcurrentBitsetPtr bitset) const
+{
 
     size_t nlistv = 0, ndis = 0;
     bool store_pairs = false;
@@ -841,13 +873,22 @@ void IndexIVF::range_search_preassigned (
 
             if (list_size == 0) return;
 
-            InvertedLists::ScopedCodes scodes (invlists, key);
+            std::unique_ptr<InvertedLists::ScopedCodes> scodes;
+            const uint8_t *codes;
+            if (arranged_codes) {
+                // codes kept outside of the inverted lists, laid out list after list
+                scodes.reset (new InvertedLists::ScopedCodes (invlists, key, arranged_codes));
+                codes = (const uint8_t *) ((const float *)scodes->get() + d * prefix_sum[key]);
+            } else {
+                scodes.reset (new InvertedLists::ScopedCodes (invlists, key));
+                codes = scodes->get();
+            }
             InvertedLists::ScopedIds ids (invlists, key);
 
             scanner->set_list (key, coarse_dis[i * nprobe + ik]);
             nlistv++;
             ndis += list_size;
-            scanner->scan_codes_range (list_size, scodes.get(),
+            scanner->scan_codes_range (list_size, codes,
                                        ids.get(), radius, qres, bitset);
         };
 
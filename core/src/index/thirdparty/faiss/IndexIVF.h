@@ -232,6 +232,20 @@ struct IndexIVF: Index, Level1Quantizer {
                                   RangeSearchResult *result,
                                   ConcurrentBitsetPtr bitset = nullptr) const;
 
+    /** Similar to range_search, but does not store codes **/
+    void range_search_without_codes (idx_t nx, const float *x,
+                                     const uint8_t *arranged_codes, std::vector<size_t> prefix_sum,
+                                     float radius, RangeSearchResult *result,
+                                     ConcurrentBitsetPtr bitset = nullptr);
+
+    /** Similar to range_search_preassigned, the codes are read from arranged_codes when it is not null **/
+    void range_search_preassigned_without_codes (idx_t nx, const float *x,
+                                                 const uint8_t *arranged_codes,
+                                                 const std::vector<size_t> &prefix_sum,
+                                                 float radius, const idx_t *keys, const float *coarse_dis,
+                                                 RangeSearchResult *result,
+                                                 ConcurrentBitsetPtr bitset = nullptr) const;
+
     /// get a scanner for this index (store_pairs means ignore labels)
     virtual InvertedListScanner *get_InvertedListScanner (
         bool store_pairs=false) const;
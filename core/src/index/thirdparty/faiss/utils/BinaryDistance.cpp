@@ -12,6 +12,7 @@
 #include <faiss/utils/Heap.h>
 #include <faiss/impl/FaissAssert.h>
 #include <faiss/utils/utils.h>
+#include <faiss/utils/popcount.h>
 
 namespace faiss {
 
@@ -143,14 +144,15 @@ void binary_distence_knn_hc (
         binary_distence_knn_hc_jaccard(8);
         binary_distence_knn_hc_jaccard(16);
         binary_distence_knn_hc_jaccard(32);
-        binary_distence_knn_hc_jaccard(64);
-        binary_distence_knn_hc_jaccard(128);
-        binary_distence_knn_hc_jaccard(256);
-        binary_distence_knn_hc_jaccard(512);
 #undef binary_distence_knn_hc_jaccard
         default:
-            binary_distence_knn_hc<faiss::JaccardComputerDefault>
-                    (ncodes, ha, a, b, nb, order, true, bitset);
+            if (ncodes >= POPCOUNT_HOOK_MIN_SIZE) {
+                binary_distence_knn_hc<faiss::JaccardComputerHook>
+                        (ncodes, ha, a, b, nb, order, true, bitset);
+            } else {
+                binary_distence_knn_hc<faiss::JaccardComputerDefault>
+                        (ncodes, ha, a, b, nb, order, true, bitset);
+            }
             break;
         }
         break;
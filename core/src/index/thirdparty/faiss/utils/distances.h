@@ -231,13 +231,15 @@ struct RangeSearchResult;
  * @param y      database vectors, size ny * d
  * @param radius search radius around the x vectors
  * @param result result structure
+ * @param bitset database vectors to skip, may be nullptr
  */
 void range_search_L2sqr (
         const float * x,
         const float * y,
         size_t d, size_t nx, size_t ny,
         float radius,
-        RangeSearchResult *result);
+        RangeSearchResult *result,
+        ConcurrentBitsetPtr bitset = nullptr);
 
 /// same as range_search_L2sqr for the inner product similarity
 void range_search_inner_product (
@@ -245,7 +247,8 @@ void range_search_inner_product (
         const float * y,
         size_t d, size_t nx, size_t ny,
         float radius,
-        RangeSearchResult *result);
+        RangeSearchResult *result,
+        ConcurrentBitsetPtr bitset = nullptr);
 
 
 /***************************************************************************
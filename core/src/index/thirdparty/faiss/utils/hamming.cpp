@@ -36,6 +36,7 @@
 #include <faiss/impl/FaissAssert.h>
 #include <faiss/utils/utils.h>
 #include <faiss/impl/AuxIndexStructures.h>
+#include <faiss/utils/popcount.h>
 
 static const size_t BLOCKSIZE_QUERY = 8192;
 static const size_t size_1M = 1 * 1024 * 1024;
@@ -687,7 +688,10 @@ void hammings_knn_hc (
             (32, ha, a, b, nb, order, true, bitset);
         break;
     default:
-        if(ncodes % 8 == 0) {
+        if (ncodes >= POPCOUNT_HOOK_MIN_SIZE) {
+            hammings_knn_hc<faiss::HammingComputerHook>
+                (ncodes, ha, a, b, nb, order, true, bitset);
+        } else if(ncodes % 8 == 0) {
             hammings_knn_hc<faiss::HammingComputerM8>
                 (ncodes, ha, a, b, nb, order, true, bitset);
         } else {
@@ -733,7 +737,11 @@ void hammings_knn_mc(
         );
         break;
     default:
-        if(ncodes % 8 == 0) {
+        if (ncodes >= POPCOUNT_HOOK_MIN_SIZE) {
+            hammings_knn_mc<faiss::HammingComputerHook>(
+              ncodes, a, b, na, nb, k, distances, labels, bitset
+            );
+        } else if(ncodes % 8 == 0) {
             hammings_knn_mc<faiss::HammingComputerM8>(
               ncodes, a, b, na, nb, k, distances, labels, bitset
             );
@@ -796,7 +804,9 @@ void hamming_range_search (
     case 16: HC(HammingComputer16); break;
     case 32: HC(HammingComputer32); break;
     default:
-        if (code_size % 8 == 0) {
+        if (code_size >= POPCOUNT_HOOK_MIN_SIZE) {
+            HC(HammingComputerHook);
+        } else if (code_size % 8 == 0) {
             HC(HammingComputerM8);
         } else {
             HC(HammingComputerDefault);
@@ -0,0 +1,54 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+// -*- c++ -*-
+
+#include <faiss/utils/popcount.h>
+
+#include <string.h>
+
+namespace faiss {
+
+size_t popcount_xor_ref(const uint8_t* a, const uint8_t* b, size_t n) {
+    size_t accu = 0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint64_t x, y;
+        memcpy(&x, a + i, 8);
+        memcpy(&y, b + i, 8);
+        accu += __builtin_popcountll(x ^ y);
+    }
+    for (; i < n; i++) {
+        accu += __builtin_popcount(a[i] ^ b[i]);
+    }
+    return accu;
+}
+
+void popcount_and_or_ref(const uint8_t* a, const uint8_t* b, size_t n,
+                         size_t* cnt_and, size_t* cnt_or) {
+    size_t accu_and = 0, accu_or = 0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint64_t x, y;
+        memcpy(&x, a + i, 8);
+        memcpy(&y, b + i, 8);
+        accu_and += __builtin_popcountll(x & y);
+        accu_or += __builtin_popcountll(x | y);
+    }
+    for (; i < n; i++) {
+        accu_and += __builtin_popcount(a[i] & b[i]);
+        accu_or += __builtin_popcount(a[i] | b[i]);
+    }
+    *cnt_and = accu_and;
+    *cnt_or = accu_or;
+}
+
+} // namespace faiss
@@ -0,0 +1,90 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+// -*- c++ -*-
+
+/* Bit counting kernels of the binary metrics.
+ *
+ * Each kernel counts the set bits of a bitwise combination of two codes of n
+ * bytes, n needs not be a multiple of the vector width. The SIMD versions are
+ * in popcount_avx.h / popcount_avx512.h and one of them is selected at
+ * startup by hook_init (see FaissHook.h). */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <faiss/FaissHook.h>
+
+namespace faiss {
+
+/// popcount(a ^ b), the hamming distance
+size_t popcount_xor_ref(const uint8_t* a, const uint8_t* b, size_t n);
+
+/// popcount(a & b) and popcount(a | b), the terms of the jaccard distance
+void popcount_and_or_ref(const uint8_t* a, const uint8_t* b, size_t n,
+                         size_t* cnt_and, size_t* cnt_or);
+
+
+/* Computers with the interface of HammingComputerM8 and
+ * JaccardComputerDefault that go through the kernels selected by hook_init.
+ * Shorter codes than POPCOUNT_HOOK_MIN_SIZE bytes stay with the unrolled
+ * scalar computers, the call through the hook does not pay off there. */
+constexpr size_t POPCOUNT_HOOK_MIN_SIZE = 64;
+
+struct HammingComputerHook {
+    const uint8_t *a;
+    size_t n;
+
+    HammingComputerHook () {}
+
+    HammingComputerHook (const uint8_t *a8, int code_size) {
+        set (a8, code_size);
+    }
+
+    void set (const uint8_t *a8, int code_size) {
+        a = a8;
+        n = code_size;
+    }
+
+    int hamming (const uint8_t *b8) const {
+        return popcount_xor (a, b8, n);
+    }
+
+};
+
+struct JaccardComputerHook {
+    const uint8_t *a;
+    size_t n;
+
+    JaccardComputerHook () {}
+
+    JaccardComputerHook (const uint8_t *a8, int code_size) {
+        set (a8, code_size);
+    }
+
+    void set (const uint8_t *a8, int code_size) {
+        a = a8;
+        n = code_size;
+    }
+
+    float compute (const uint8_t *b8) const {
+        size_t accu_num, accu_den;
+        popcount_and_or (a, b8, n, &accu_num, &accu_den);
+        if (accu_num == 0)
+            return 1.0;
+        return 1.0 - (float)(accu_num) / (float)(accu_den);
+    }
+
+};
+
+} // namespace faiss
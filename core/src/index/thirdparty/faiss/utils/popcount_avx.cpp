@@ -0,0 +1,177 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+// -*- c++ -*-
+
+#include <faiss/utils/popcount_avx.h>
+#include <faiss/utils/popcount.h>
+
+#include <immintrin.h>
+
+namespace faiss {
+
+#ifdef __AVX2__
+
+namespace {
+
+struct OpXor {
+    static __m256i op(__m256i x, __m256i y) { return _mm256_xor_si256(x, y); }
+    static uint32_t op(uint8_t x, uint8_t y) { return x ^ y; }
+};
+
+struct OpAnd {
+    static __m256i op(__m256i x, __m256i y) { return _mm256_and_si256(x, y); }
+    static uint32_t op(uint8_t x, uint8_t y) { return x & y; }
+};
+
+struct OpOr {
+    static __m256i op(__m256i x, __m256i y) { return _mm256_or_si256(x, y); }
+    static uint32_t op(uint8_t x, uint8_t y) { return x | y; }
+};
+
+// bit count of each byte, by two 16-entry lookups on the nibbles
+inline __m256i popcount_bytes(__m256i v) {
+    const __m256i lookup = _mm256_setr_epi8(
+            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_mask = _mm256_set1_epi8(0x0f);
+    __m256i lo = _mm256_and_si256(v, low_mask);
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+    return _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo),
+                           _mm256_shuffle_epi8(lookup, hi));
+}
+
+// bit count of each 64-bit lane
+inline __m256i popcount_lanes(__m256i v) {
+    return _mm256_sad_epu8(popcount_bytes(v), _mm256_setzero_si256());
+}
+
+// carry-save adder: h holds the carries and l the sums of a + b + c
+inline void csa(__m256i& h, __m256i& l, __m256i a, __m256i b, __m256i c) {
+    __m256i u = _mm256_xor_si256(a, b);
+    h = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(u, c));
+    l = _mm256_xor_si256(u, c);
+}
+
+template <class Op>
+inline __m256i load_op(const uint8_t* a, const uint8_t* b, size_t i) {
+    return Op::op(_mm256_loadu_si256((const __m256i*)(a + i)),
+                  _mm256_loadu_si256((const __m256i*)(b + i)));
+}
+
+inline size_t reduce_lanes(__m256i v) {
+    __m128i sum = _mm_add_epi64(_mm256_castsi256_si128(v),
+                                _mm256_extracti128_si256(v, 1));
+    return _mm_cvtsi128_si64(sum) + _mm_extract_epi64(sum, 1);
+}
+
+/* Harley-Seal bit count (Mula, Kurz and Lemire, "Faster population counts
+ * using AVX2 instructions"): a tree of carry-save adders reduces 8 vectors
+ * to one vector of weight 8, so only one in 8 vectors goes through the
+ * lookup based count. Returns the number of bytes consumed. */
+template <class Op>
+size_t harley_seal(const uint8_t* a, const uint8_t* b, size_t n, __m256i& total) {
+    __m256i ones = _mm256_setzero_si256();
+    __m256i twos = _mm256_setzero_si256();
+    __m256i fours = _mm256_setzero_si256();
+    __m256i eights_cnt = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for (; i + 8 * 32 <= n; i += 8 * 32) {
+        __m256i twos_a, twos_b, fours_a, fours_b, eights;
+        csa(twos_a, ones, ones, load_op<Op>(a, b, i), load_op<Op>(a, b, i + 32));
+        csa(twos_b, ones, ones, load_op<Op>(a, b, i + 64), load_op<Op>(a, b, i + 96));
+        csa(fours_a, twos, twos, twos_a, twos_b);
+        csa(twos_a, ones, ones, load_op<Op>(a, b, i + 128), load_op<Op>(a, b, i + 160));
+        csa(twos_b, ones, ones, load_op<Op>(a, b, i + 192), load_op<Op>(a, b, i + 224));
+        csa(fours_b, twos, twos, twos_a, twos_b);
+        csa(eights, fours, fours, fours_a, fours_b);
+        eights_cnt = _mm256_add_epi64(eights_cnt, popcount_lanes(eights));
+    }
+
+    total = _mm256_add_epi64(total, _mm256_slli_epi64(eights_cnt, 3));
+    total = _mm256_add_epi64(total, _mm256_slli_epi64(popcount_lanes(fours), 2));
+    total = _mm256_add_epi64(total, _mm256_slli_epi64(popcount_lanes(twos), 1));
+    total = _mm256_add_epi64(total, popcount_lanes(ones));
+    return i;
+}
+
+// codes shorter than 8 vectors, plus the tail of the longer ones
+template <class Op>
+size_t popcount_count(const uint8_t* a, const uint8_t* b, size_t n) {
+    __m256i total = _mm256_setzero_si256();
+    size_t i = 0;
+    if (n >= POPCOUNT_HARLEY_SEAL_MIN_SIZE) {
+        i = harley_seal<Op>(a, b, n, total);
+    }
+
+    // less than 8 vectors left, the byte counters can not overflow
+    __m256i bytes = _mm256_setzero_si256();
+    for (; i + 32 <= n; i += 32) {
+        bytes = _mm256_add_epi8(bytes, popcount_bytes(load_op<Op>(a, b, i)));
+    }
+    total = _mm256_add_epi64(total, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+    size_t accu = reduce_lanes(total);
+
+    for (; i < n; i++) {
+        accu += __builtin_popcount(Op::op(a[i], b[i]));
+    }
+    return accu;
+}
+
+} // namespace
+
+size_t popcount_xor_avx(const uint8_t* a, const uint8_t* b, size_t n) {
+    return popcount_count<OpXor>(a, b, n);
+}
+
+void popcount_and_or_avx(const uint8_t* a, const uint8_t* b, size_t n,
+                         size_t* cnt_and, size_t* cnt_or) {
+    if (n >= POPCOUNT_HARLEY_SEAL_MIN_SIZE) {
+        // the second pass reads the codes from L1
+        *cnt_and = popcount_count<OpAnd>(a, b, n);
+        *cnt_or = popcount_count<OpOr>(a, b, n);
+        return;
+    }
+
+    __m256i bytes_and = _mm256_setzero_si256();
+    __m256i bytes_or = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i y = _mm256_loadu_si256((const __m256i*)(b + i));
+        bytes_and = _mm256_add_epi8(bytes_and, popcount_bytes(_mm256_and_si256(x, y)));
+        bytes_or = _mm256_add_epi8(bytes_or, popcount_bytes(_mm256_or_si256(x, y)));
+    }
+    size_t accu_and = reduce_lanes(_mm256_sad_epu8(bytes_and, _mm256_setzero_si256()));
+    size_t accu_or = reduce_lanes(_mm256_sad_epu8(bytes_or, _mm256_setzero_si256()));
+    for (; i < n; i++) {
+        accu_and += __builtin_popcount(a[i] & b[i]);
+        accu_or += __builtin_popcount(a[i] | b[i]);
+    }
+    *cnt_and = accu_and;
+    *cnt_or = accu_or;
+}
+
+#else
+
+size_t popcount_xor_avx(const uint8_t* a, const uint8_t* b, size_t n) {
+    return popcount_xor_ref(a, b, n);
+}
+
+void popcount_and_or_avx(const uint8_t* a, const uint8_t* b, size_t n,
+                         size_t* cnt_and, size_t* cnt_or) {
+    popcount_and_or_ref(a, b, n, cnt_and, cnt_or);
+}
+
+#endif
+
+} // namespace faiss
@@ -0,0 +1,36 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+// -*- c++ -*-
+
+/* AVX2 versions of the binary metric bit counters.
+ * The actual functions are implemented in popcount_avx.cpp */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace faiss {
+
+/* Codes of this many bytes (2048 bits) and more are counted with the
+ * Harley-Seal carry-save adder tree, shorter ones with one lookup count per
+ * vector. On 512 and 1024 bit codes the adders and the flush of the partial
+ * sums cost more than the lookups they save, see BINARY_HARLEY_SEAL_BENCHMARK
+ * in unittest/metric_alg_benchmark. */
+constexpr size_t POPCOUNT_HARLEY_SEAL_MIN_SIZE = 8 * 32;
+
+size_t popcount_xor_avx(const uint8_t* a, const uint8_t* b, size_t n);
+
+void popcount_and_or_avx(const uint8_t* a, const uint8_t* b, size_t n,
+                         size_t* cnt_and, size_t* cnt_or);
+
+} // namespace faiss
@@ -0,0 +1,93 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+// -*- c++ -*-
+
+#include <faiss/utils/popcount_avx512.h>
+#include <faiss/utils/popcount.h>
+
+#include <immintrin.h>
+
+namespace faiss {
+
+#if defined(__AVX512F__) && defined(__AVX512BW__)
+
+/* VPOPCNTDQ is not part of the flags this file is built with (it is missing
+ * on Skylake-SP), so only these functions are compiled for it. hook_init
+ * selects them after checking the cpu flag. */
+#define FAISS_TARGET_VPOPCNTDQ __attribute__((target("avx512vpopcntdq")))
+
+namespace {
+
+// mask of the first n (< 64) bytes
+inline __mmask64 tail_mask(size_t n) {
+    return n >= 64 ? ~(__mmask64)0 : (((__mmask64)1 << n) - 1);
+}
+
+} // namespace
+
+FAISS_TARGET_VPOPCNTDQ
+size_t popcount_xor_avx512(const uint8_t* a, const uint8_t* b, size_t n) {
+    __m512i accu = _mm512_setzero_si512();
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        __m512i x = _mm512_loadu_si512((const void*)(a + i));
+        __m512i y = _mm512_loadu_si512((const void*)(b + i));
+        accu = _mm512_add_epi64(accu, _mm512_popcnt_epi64(_mm512_xor_si512(x, y)));
+    }
+    if (i < n) {
+        __mmask64 mask = tail_mask(n - i);
+        __m512i x = _mm512_maskz_loadu_epi8(mask, a + i);
+        __m512i y = _mm512_maskz_loadu_epi8(mask, b + i);
+        accu = _mm512_add_epi64(accu, _mm512_popcnt_epi64(_mm512_xor_si512(x, y)));
+    }
+    return _mm512_reduce_add_epi64(accu);
+}
+
+FAISS_TARGET_VPOPCNTDQ
+void popcount_and_or_avx512(const uint8_t* a, const uint8_t* b, size_t n,
+                            size_t* cnt_and, size_t* cnt_or) {
+    __m512i accu_and = _mm512_setzero_si512();
+    __m512i accu_or = _mm512_setzero_si512();
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        __m512i x = _mm512_loadu_si512((const void*)(a + i));
+        __m512i y = _mm512_loadu_si512((const void*)(b + i));
+        accu_and = _mm512_add_epi64(accu_and, _mm512_popcnt_epi64(_mm512_and_si512(x, y)));
+        accu_or = _mm512_add_epi64(accu_or, _mm512_popcnt_epi64(_mm512_or_si512(x, y)));
+    }
+    if (i < n) {
+        __mmask64 mask = tail_mask(n - i);
+        __m512i x = _mm512_maskz_loadu_epi8(mask, a + i);
+        __m512i y = _mm512_maskz_loadu_epi8(mask, b + i);
+        accu_and = _mm512_add_epi64(accu_and, _mm512_popcnt_epi64(_mm512_and_si512(x, y)));
+        accu_or = _mm512_add_epi64(accu_or, _mm512_popcnt_epi64(_mm512_or_si512(x, y)));
+    }
+    *cnt_and = _mm512_reduce_add_epi64(accu_and);
+    *cnt_or = _mm512_reduce_add_epi64(accu_or);
+}
+
+#undef FAISS_TARGET_VPOPCNTDQ
+
+#else
+
+size_t popcount_xor_avx512(const uint8_t* a, const uint8_t* b, size_t n) {
+    return popcount_xor_ref(a, b, n);
+}
+
+void popcount_and_or_avx512(const uint8_t* a, const uint8_t* b, size_t n,
+                            size_t* cnt_and, size_t* cnt_or) {
+    popcount_and_or_ref(a, b, n, cnt_and, cnt_or);
+}
+
+#endif
+
+} // namespace faiss
@@ -0,0 +1,32 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+// -*- c++ -*-
+
+/* AVX-512 versions of the binary metric bit counters, using the VPOPCNTDQ
+ * extension. The actual functions are implemented in popcount_avx512.cpp
+ *
+ * They must only be called when support_avx512_vpopcntdq() is true, other
+ * AVX-512 cpus run the AVX2 versions. */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace faiss {
+
+size_t popcount_xor_avx512(const uint8_t* a, const uint8_t* b, size_t n);
+
+void popcount_and_or_avx512(const uint8_t* a, const uint8_t* b, size_t n,
+                            size_t* cnt_and, size_t* cnt_or);
+
+} // namespace faiss
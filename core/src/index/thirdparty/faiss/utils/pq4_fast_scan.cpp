@@ -0,0 +1,46 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+// -*- c++ -*-
+
+#include <faiss/utils/pq4_fast_scan.h>
+
+#include <cstring>
+
+namespace faiss {
+
+void pq4_set_block_code(size_t M, uint8_t* block, size_t j, const uint8_t* codes) {
+    size_t shift = j < 16 ? 0 : 4;
+    size_t pos = j & 15;
+    for (size_t m = 0; m < M; m++) {
+        block[m * 16 + pos] |= (codes[m] & 15) << shift;
+    }
+}
+
+uint8_t pq4_get_block_code(const uint8_t* block, size_t m, size_t j) {
+    uint8_t c = block[m * 16 + (j & 15)];
+    return j < 16 ? (c & 15) : (c >> 4);
+}
+
+void pq4_accumulate_block_ref(size_t M, const uint8_t* block,
+                              const uint8_t* LUT, uint16_t* dis) {
+    memset(dis, 0, sizeof(uint16_t) * PQ4_BLOCK_SIZE);
+    for (size_t m = 0; m < M; m++) {
+        const uint8_t* c = block + m * 16;
+        const uint8_t* lut = LUT + m * 16;
+        for (size_t j = 0; j < 16; j++) {
+            dis[j] += lut[c[j] & 15];
+            dis[j + 16] += lut[c[j] >> 4];
+        }
+    }
+}
+
+} // namespace faiss
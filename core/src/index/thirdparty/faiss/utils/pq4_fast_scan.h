@@ -0,0 +1,52 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+// -*- c++ -*-
+
+/* 4-bit PQ codes packed for SIMD in-register table lookups.
+ *
+ * Codes are stored in blocks of PQ4_BLOCK_SIZE (32) vectors. For each
+ * sub-quantizer m a block holds 16 bytes: byte j carries the code of vector j
+ * in its low nibble and the code of vector j + 16 in its high nibble, so one
+ * 16-byte shuffle of the (uint8) lookup table of m scores the whole block. */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace faiss {
+
+constexpr size_t PQ4_BLOCK_SIZE = 32;
+
+/// size in bytes of one block of M sub-quantizers
+inline size_t pq4_block_bytes(size_t M) {
+    return M * PQ4_BLOCK_SIZE / 2;
+}
+
+/** store the 4-bit code of vector j (0 <= j < 32) into a zero-initialized block
+ *
+ * @param codes   M codes, one per byte, values in [0, 16)
+ */
+void pq4_set_block_code(size_t M, uint8_t* block, size_t j, const uint8_t* codes);
+
+/// read back the code of sub-quantizer m of vector j from a block
+uint8_t pq4_get_block_code(const uint8_t* block, size_t m, size_t j);
+
+/** accumulate the quantized distances of the 32 vectors of a block
+ *
+ * @param LUT     M * 16 quantized lookup table entries
+ * @param dis     output, 32 sums of M table entries
+ */
+void pq4_accumulate_block_ref(size_t M, const uint8_t* block,
+                              const uint8_t* LUT, uint16_t* dis);
+
+} // namespace faiss
@@ -0,0 +1,58 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+// -*- c++ -*-
+
+#include <faiss/utils/pq4_fast_scan_avx.h>
+#include <faiss/utils/pq4_fast_scan.h>
+
+#include <immintrin.h>
+
+namespace faiss {
+
+#ifdef __AVX2__
+
+void pq4_accumulate_block_avx(size_t M, const uint8_t* block,
+                              const uint8_t* LUT, uint16_t* dis) {
+    const __m128i mask = _mm_set1_epi8(0x0f);
+    __m256i acc_lo = _mm256_setzero_si256();  // vectors 0..15
+    __m256i acc_hi = _mm256_setzero_si256();  // vectors 16..31
+
+    for (size_t m = 0; m < M; m++) {
+        __m128i c = _mm_loadu_si128((const __m128i*)(block + m * 16));
+        __m128i c_lo = _mm_and_si128(c, mask);
+        __m128i c_hi = _mm_and_si128(_mm_srli_epi16(c, 4), mask);
+
+        // the same 16-entry table in both lanes, indexed by the low codes in
+        // lane 0 and the high codes in lane 1
+        __m256i lut = _mm256_broadcastsi128_si256(
+                _mm_loadu_si128((const __m128i*)(LUT + m * 16)));
+        __m256i idx = _mm256_inserti128_si256(_mm256_castsi128_si256(c_lo), c_hi, 1);
+        __m256i d = _mm256_shuffle_epi8(lut, idx);
+
+        acc_lo = _mm256_add_epi16(acc_lo, _mm256_cvtepu8_epi16(_mm256_castsi256_si128(d)));
+        acc_hi = _mm256_add_epi16(acc_hi, _mm256_cvtepu8_epi16(_mm256_extracti128_si256(d, 1)));
+    }
+
+    _mm256_storeu_si256((__m256i*)dis, acc_lo);
+    _mm256_storeu_si256((__m256i*)(dis + 16), acc_hi);
+}
+
+#else
+
+void pq4_accumulate_block_avx(size_t M, const uint8_t* block,
+                              const uint8_t* LUT, uint16_t* dis) {
+    pq4_accumulate_block_ref(M, block, LUT, dis);
+}
+
+#endif
+
+} // namespace faiss
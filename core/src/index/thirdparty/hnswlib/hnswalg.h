@@ -32,6 +32,12 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
             metric_type_ = 0;
         } else if (auto x = dynamic_cast<InnerProductSpace*>(s)) {
             metric_type_ = 1;
+        } else if (auto x = dynamic_cast<HammingSpace*>(s)) {
+            metric_type_ = 2;
+        } else if (auto x = dynamic_cast<TanimotoSpace*>(s)) {
+            metric_type_ = 4;
+        } else if (auto x = dynamic_cast<JaccardSpace*>(s)) {
+            metric_type_ = 3;
         } else {
             metric_type_ = 100;
         }
@@ -101,7 +107,7 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
 
     // linxj: use for free resource
     SpaceInterface<dist_t> *space;
-    size_t metric_type_; // 0:l2, 1:ip
+    size_t metric_type_; // 0:l2, 1:ip, 2:hamming, 3:jaccard, 4:tanimoto
 
     size_t max_elements_;
     size_t cur_element_count;
@@ -627,6 +633,12 @@ class HierarchicalNSW : public AlgorithmInterface<dist_t> {
             space = new hnswlib::L2Space(dim);
         } else if (metric_type_ == 1) {
             space = new hnswlib::InnerProductSpace(dim);
+        } else if (metric_type_ == 2) {
+            space = new hnswlib::HammingSpace(dim);
+        } else if (metric_type_ == 3) {
+            space = new hnswlib::JaccardSpace(dim);
+        } else if (metric_type_ == 4) {
+            space = new hnswlib::TanimotoSpace(dim);
         } else {
             // throw exception
         }
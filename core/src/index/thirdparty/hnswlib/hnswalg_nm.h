@@ -264,9 +264,35 @@ namespace hnswlib {
             return top_candidates;
         }
 
+        // distances of a query to the nodes, computed on the vectors in pdata
+        struct QueryDistance {
+            const HierarchicalNSW_NM *hnsw;
+            const void *query;
+            void *pdata;
+
+            dist_t operator()(tableint id) const {
+                return hnsw->fstdistfunc_(query, hnsw->getDataByInternalId(pdata, id), hnsw->dist_func_param_);
+            }
+
+            const char *address(tableint id) const {
+                return hnsw->getDataByInternalId(pdata, id);
+            }
+        };
+
         template <bool has_deletions>
         std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst>
         searchBaseLayerST(tableint ep_id, const void *data_point, size_t ef, faiss::ConcurrentBitsetPtr bitset, void *pdata) const {
+            return searchBaseLayerST<has_deletions>(ep_id, QueryDistance{this, data_point, pdata}, ef, bitset);
+        }
+
+        /*
+         * DistFunc gives the distance of the query to a node, dist_t operator()(tableint), and the address of the
+         * node's vector for prefetching, const char *address(tableint). It lets the graph be searched on another
+         * representation of the vectors than the one it was built on, such as scalar quantized codes.
+         */
+        template <bool has_deletions, typename DistFunc>
+        std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst>
+        searchBaseLayerST(tableint ep_id, const DistFunc &dist_func, size_t ef, faiss::ConcurrentBitsetPtr bitset) const {
             VisitedList *vl = visited_list_pool_->getFreeVisitedList();
             vl_type *visited_array = vl->mass;
             vl_type visited_array_tag = vl->curV;
@@ -277,7 +303,7 @@ namespace hnswlib {
             dist_t lowerBound;
 //        if (!has_deletions || !isMarkedDeleted(ep_id)) {
             if (!has_deletions || !bitset->test((faiss::ConcurrentBitset::id_type_t)(ep_id))) {
-                dist_t dist = fstdistfunc_(data_point, getDataByInternalId(pdata, ep_id), dist_func_param_);
+                dist_t dist = dist_func(ep_id);
                 lowerBound = dist;
                 top_candidates.emplace(dist, ep_id);
                 candidate_set.emplace(-dist, ep_id);
@@ -306,7 +332,7 @@ namespace hnswlib {
                 _mm_prefetch((char *) (visited_array + *(data + 1)), _MM_HINT_T0);
                 _mm_prefetch((char *) (visited_array + *(data + 1) + 64), _MM_HINT_T0);
 //            _mm_prefetch(data_level0_memory_ + (*(data + 1)) * size_data_per_element_ + offsetData_, _MM_HINT_T0);
-                _mm_prefetch(getDataByInternalId(pdata, *(data + 1)), _MM_HINT_T0);
+                _mm_prefetch(dist_func.address(*(data + 1)), _MM_HINT_T0);
                 _mm_prefetch((char *) (data + 2), _MM_HINT_T0);
 #endif
 
@@ -315,15 +341,14 @@ namespace hnswlib {
                     // if (candidate_id == 0) continue;
 #ifdef USE_SSE
                     _mm_prefetch((char *) (visited_array + *(data + j + 1)), _MM_HINT_T0);
-                    _mm_prefetch(getDataByInternalId(pdata, *(data + j + 1)),
+                    _mm_prefetch(dist_func.address(*(data + j + 1)),
                                  _MM_HINT_T0);////////////
 #endif
                     if (!(visited_array[candidate_id] == visited_array_tag)) {
 
                         visited_array[candidate_id] = visited_array_tag;
 
-                        char *currObj1 = (getDataByInternalId(pdata, candidate_id));
-                        dist_t dist = fstdistfunc_(data_point, currObj1, dist_func_param_);
+                        dist_t dist = dist_func(candidate_id);
 
                         if (top_candidates.size() < ef || lowerBound > dist) {
                             candidate_set.emplace(-dist, candidate_id);
@@ -1111,11 +1136,18 @@ namespace hnswlib {
 
         std::priority_queue<std::pair<dist_t, labeltype >>
         searchKnn_NM(const void *query_data, size_t k, faiss::ConcurrentBitsetPtr bitset, dist_t *pdata) const {
+            return searchKnn_NM(QueryDistance{this, query_data, pdata}, k, bitset);
+        }
+
+        // see searchBaseLayerST for the requirements of DistFunc
+        template <typename DistFunc>
+        std::priority_queue<std::pair<dist_t, labeltype >>
+        searchKnn_NM(const DistFunc &dist_func, size_t k, faiss::ConcurrentBitsetPtr bitset) const {
             std::priority_queue<std::pair<dist_t, labeltype >> result;
             if (cur_element_count == 0) return result;
 
             tableint currObj = enterpoint_node_;
-            dist_t curdist = fstdistfunc_(query_data, getDataByInternalId(pdata, enterpoint_node_), dist_func_param_);
+            dist_t curdist = dist_func(enterpoint_node_);
 
             for (int level = maxlevel_; level > 0; level--) {
                 bool changed = true;
@@ -1130,7 +1162,7 @@ namespace hnswlib {
                         tableint cand = datal[i];
                         if (cand < 0 || cand > max_elements_)
                             throw std::runtime_error("cand error");
-                        dist_t d = fstdistfunc_(query_data, getDataByInternalId(pdata, cand), dist_func_param_);
+                        dist_t d = dist_func(cand);
 
                         if (d < curdist) {
                             curdist = d;
@@ -1144,12 +1176,12 @@ namespace hnswlib {
             std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst> top_candidates;
             if (bitset != nullptr) {
                 std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst>
-                        top_candidates1 = searchBaseLayerST<true>(currObj, query_data, std::max(ef_, k), bitset, pdata);
+                        top_candidates1 = searchBaseLayerST<true>(currObj, dist_func, std::max(ef_, k), bitset);
                 top_candidates.swap(top_candidates1);
             }
             else{
                 std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst>
-                        top_candidates1 = searchBaseLayerST<false>(currObj, query_data, std::max(ef_, k), bitset, pdata);
+                        top_candidates1 = searchBaseLayerST<false>(currObj, dist_func, std::max(ef_, k), bitset);
                 top_candidates.swap(top_candidates1);
             }
             while (top_candidates.size() > k) {
@@ -99,5 +99,6 @@ namespace hnswlib {
 
 #include "space_l2.h"
 #include "space_ip.h"
+#include "space_binary.h"
 #include "bruteforce.h"
 #include "hnswalg.h"
@@ -0,0 +1,66 @@
+#pragma once
+#include "hnswlib.h"
+#include <faiss/FaissHook.h>
+
+namespace hnswlib {
+
+/* Spaces of binary codes, the dimension is in bits. The bits are counted by the popcount kernels that faiss
+ * selects for the cpu, the same as binary flat and IVF search. */
+
+static float
+Hamming(const void *pVect1, const void *pVect2, const void *qty_ptr) {
+    size_t code_size = *((size_t *) qty_ptr) / 8;
+    return (float) faiss::popcount_xor((const uint8_t *) pVect1, (const uint8_t *) pVect2, code_size);
+}
+
+static float
+Jaccard(const void *pVect1, const void *pVect2, const void *qty_ptr) {
+    size_t code_size = *((size_t *) qty_ptr) / 8;
+    size_t cnt_and = 0, cnt_or = 0;
+    faiss::popcount_and_or((const uint8_t *) pVect1, (const uint8_t *) pVect2, code_size, &cnt_and, &cnt_or);
+    return cnt_or == 0 ? 0.0f : 1.0f - (float) cnt_and / (float) cnt_or;
+}
+
+class BinarySpace : public SpaceInterface<float> {
+    DISTFUNC<float> fstdistfunc_;
+    size_t data_size_;
+    size_t dim_;
+ public:
+    BinarySpace(size_t dim, DISTFUNC<float> func) {
+        fstdistfunc_ = func;
+        dim_ = dim;
+        data_size_ = dim / 8;
+    }
+
+    size_t get_data_size() {
+        return data_size_;
+    }
+
+    DISTFUNC<float> get_dist_func() {
+        return fstdistfunc_;
+    }
+
+    void *get_dist_func_param() {
+        return &dim_;
+    }
+
+    ~BinarySpace() {}
+};
+
+class HammingSpace : public BinarySpace {
+ public:
+    HammingSpace(size_t dim) : BinarySpace(dim, Hamming) {}
+};
+
+class JaccardSpace : public BinarySpace {
+ public:
+    JaccardSpace(size_t dim) : BinarySpace(dim, Jaccard) {}
+};
+
+// the graph is built and searched on the jaccard distance, tanimoto is a monotonic function of it
+class TanimotoSpace : public JaccardSpace {
+ public:
+    TanimotoSpace(size_t dim) : JaccardSpace(dim) {}
+};
+
+}
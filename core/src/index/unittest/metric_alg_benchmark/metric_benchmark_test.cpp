@@ -11,12 +11,20 @@
 
 #include <gtest/gtest.h>
 #include <immintrin.h>
+#include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <cmath>
 #include <unordered_map>
 #include <vector>
 
+#include <faiss/utils/instruction_set.h>
+#include <faiss/utils/popcount.h>
+#include <faiss/utils/popcount_avx.h>
+#include <faiss/utils/popcount_avx512.h>
+
 typedef float (*metric_func_ptr)(const float*, const float*, size_t);
+typedef float (*binary_metric_func_ptr)(const uint8_t*, const uint8_t*, size_t);
 
 constexpr int64_t DIM = 512;
 constexpr int64_t NB = 10000;
@@ -57,6 +65,31 @@ CheckResult(const float* result1, const float* result2, const size_t size) {
     }
 }
 
+void
+GenerateBinaryData(const int64_t code_size, const int64_t n, uint8_t* x) {
+    for (int64_t i = 0; i < n * code_size; ++i) {
+        x[i] = lrand48() & 0xff;
+    }
+}
+
+void
+TestBinaryMetricAlg(std::unordered_map<std::string, binary_metric_func_ptr>& func_map, const std::string& key,
+                    int64_t loop, float* distance, const int64_t nb, const uint8_t* xb, const int64_t nq,
+                    const uint8_t* xq, const int64_t code_size) {
+    int64_t diff = 0;
+    for (int64_t i = 0; i < loop; i++) {
+        auto t0 = std::chrono::system_clock::now();
+        for (int64_t i = 0; i < nb; i++) {
+            for (int64_t j = 0; j < nq; j++) {
+                distance[i * NQ + j] = func_map[key](xb + i * code_size, xq + j * code_size, code_size);
+            }
+        }
+        auto t1 = std::chrono::system_clock::now();
+        diff += std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+    }
+    std::cout << key << " (" << code_size * 8 << " bits) takes average " << diff / loop << "ms" << std::endl;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /* from faiss/utils/distances_simd.cpp */
 namespace FAISS {
@@ -379,6 +412,105 @@ InnerProductSIMD16Ext(const float* pVect1v, const float* pVect2v, size_t qty) {
 }
 }  // namespace HNSW
 
+///////////////////////////////////////////////////////////////////////////////
+/* the kernels of faiss/utils/popcount*.cpp, as distances */
+namespace BINARY {
+template <size_t (*popcount_xor)(const uint8_t*, const uint8_t*, size_t)>
+float
+Hamming(const uint8_t* a, const uint8_t* b, size_t n) {
+    return popcount_xor(a, b, n);
+}
+
+template <void (*popcount_and_or)(const uint8_t*, const uint8_t*, size_t, size_t*, size_t*)>
+float
+Jaccard(const uint8_t* a, const uint8_t* b, size_t n) {
+    size_t cnt_and, cnt_or;
+    popcount_and_or(a, b, n, &cnt_and, &cnt_or);
+    return cnt_and == 0 ? 1.0 : 1.0 - (float)cnt_and / (float)cnt_or;
+}
+
+// as IndexBinaryFlat converts the jaccard distance
+template <void (*popcount_and_or)(const uint8_t*, const uint8_t*, size_t, size_t*, size_t*)>
+float
+Tanimoto(const uint8_t* a, const uint8_t* b, size_t n) {
+    return -log2(1.0 - Jaccard<popcount_and_or>(a, b, n));
+}
+}  // namespace BINARY
+
+///////////////////////////////////////////////////////////////////////////////
+/* the Harley-Seal loop of faiss/utils/popcount_avx.cpp, with trees of 4 and 2
+ * vectors added so that it runs on every code of 64 bytes and more */
+namespace HARLEY_SEAL {
+inline __m256i
+popcount_lanes(__m256i v) {
+    const __m256i lookup =
+        _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_mask = _mm256_set1_epi8(0x0f);
+    __m256i lo = _mm256_and_si256(v, low_mask);
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+    __m256i bytes = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), _mm256_shuffle_epi8(lookup, hi));
+    return _mm256_sad_epu8(bytes, _mm256_setzero_si256());
+}
+
+inline void
+csa(__m256i& h, __m256i& l, __m256i a, __m256i b, __m256i c) {
+    __m256i u = _mm256_xor_si256(a, b);
+    h = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(u, c));
+    l = _mm256_xor_si256(u, c);
+}
+
+inline __m256i
+load_xor(const uint8_t* a, const uint8_t* b, size_t i) {
+    return _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(a + i)), _mm256_loadu_si256((const __m256i*)(b + i)));
+}
+
+float
+Hamming(const uint8_t* a, const uint8_t* b, size_t n) {
+    __m256i ones = _mm256_setzero_si256();
+    __m256i twos = _mm256_setzero_si256();
+    __m256i fours = _mm256_setzero_si256();
+    __m256i total = _mm256_setzero_si256();
+    __m256i twos_a, twos_b, fours_a, fours_b, eights;
+    size_t i = 0;
+    for (; i + 8 * 32 <= n; i += 8 * 32) {
+        csa(twos_a, ones, ones, load_xor(a, b, i), load_xor(a, b, i + 32));
+        csa(twos_b, ones, ones, load_xor(a, b, i + 64), load_xor(a, b, i + 96));
+        csa(fours_a, twos, twos, twos_a, twos_b);
+        csa(twos_a, ones, ones, load_xor(a, b, i + 128), load_xor(a, b, i + 160));
+        csa(twos_b, ones, ones, load_xor(a, b, i + 192), load_xor(a, b, i + 224));
+        csa(fours_b, twos, twos, twos_a, twos_b);
+        csa(eights, fours, fours, fours_a, fours_b);
+        total = _mm256_add_epi64(total, _mm256_slli_epi64(popcount_lanes(eights), 3));
+    }
+    if (i + 4 * 32 <= n) {
+        csa(twos_a, ones, ones, load_xor(a, b, i), load_xor(a, b, i + 32));
+        csa(twos_b, ones, ones, load_xor(a, b, i + 64), load_xor(a, b, i + 96));
+        csa(fours_a, twos, twos, twos_a, twos_b);
+        total = _mm256_add_epi64(total, _mm256_slli_epi64(popcount_lanes(fours_a), 2));
+        i += 4 * 32;
+    }
+    if (i + 2 * 32 <= n) {
+        csa(twos_a, ones, ones, load_xor(a, b, i), load_xor(a, b, i + 32));
+        total = _mm256_add_epi64(total, _mm256_slli_epi64(popcount_lanes(_mm256_and_si256(twos, twos_a)), 2));
+        twos = _mm256_xor_si256(twos, twos_a);
+        i += 2 * 32;
+    }
+    total = _mm256_add_epi64(total, _mm256_slli_epi64(popcount_lanes(fours), 2));
+    total = _mm256_add_epi64(total, _mm256_slli_epi64(popcount_lanes(twos), 1));
+    total = _mm256_add_epi64(total, popcount_lanes(ones));
+    for (; i + 32 <= n; i += 32) {
+        total = _mm256_add_epi64(total, popcount_lanes(load_xor(a, b, i)));
+    }
+    int64_t lanes[4];
+    _mm256_storeu_si256((__m256i*)lanes, total);
+    size_t accu = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    for (; i < n; i++) {
+        accu += __builtin_popcount(a[i] ^ b[i]);
+    }
+    return accu;
+}
+}  // namespace HARLEY_SEAL
+
 TEST(METRICTEST, BENCHMARK) {
     std::unordered_map<std::string, metric_func_ptr> func_map;
     func_map["FAISS::L2"] = FAISS::fvec_L2sqr_avx;
@@ -413,3 +545,130 @@ TEST(METRICTEST, BENCHMARK) {
     TestMetricAlg(func_map, "ANNOY::IP", LOOP, distance_annoy.data(), NB, xb.data(), NQ, xq.data(), DIM);
     CheckResult(distance_faiss.data(), distance_annoy.data(), NB * NQ);
 }
+
+TEST(METRICTEST, BINARY_BENCHMARK) {
+    std::unordered_map<std::string, binary_metric_func_ptr> func_map;
+    func_map["REF::HAMMING"] = BINARY::Hamming<faiss::popcount_xor_ref>;
+    func_map["AVX2::HAMMING"] = BINARY::Hamming<faiss::popcount_xor_avx>;
+    func_map["AVX512::HAMMING"] = BINARY::Hamming<faiss::popcount_xor_avx512>;
+
+    func_map["REF::JACCARD"] = BINARY::Jaccard<faiss::popcount_and_or_ref>;
+    func_map["AVX2::JACCARD"] = BINARY::Jaccard<faiss::popcount_and_or_avx>;
+    func_map["AVX512::JACCARD"] = BINARY::Jaccard<faiss::popcount_and_or_avx512>;
+
+    faiss::InstructionSet& instruction_set = faiss::InstructionSet::GetInstance();
+    bool support_avx2 = instruction_set.AVX2();
+    bool support_vpopcntdq = instruction_set.AVX512F() && instruction_set.AVX512BW() &&
+                             instruction_set.AVX512VPOPCNTDQ();
+
+    // 512 and 1024 bits fingerprints, and a size with a tail shorter than a vector
+    for (int64_t code_size : {64, 128, 100}) {
+        std::vector<uint8_t> xb(NB * code_size);
+        std::vector<uint8_t> xq(NQ * code_size);
+        GenerateBinaryData(code_size, NB, xb.data());
+        GenerateBinaryData(code_size, NQ, xq.data());
+
+        std::vector<float> distance_ref(NB * NQ);
+        std::vector<float> distance_simd(NB * NQ);
+
+        for (std::string metric : {"HAMMING", "JACCARD"}) {
+            std::cout << "==========" << std::endl;
+            TestBinaryMetricAlg(func_map, "REF::" + metric, LOOP, distance_ref.data(), NB, xb.data(), NQ, xq.data(),
+                                code_size);
+
+            if (support_avx2) {
+                TestBinaryMetricAlg(func_map, "AVX2::" + metric, LOOP, distance_simd.data(), NB, xb.data(), NQ,
+                                    xq.data(), code_size);
+                CheckResult(distance_ref.data(), distance_simd.data(), NB * NQ);
+            }
+
+            if (support_vpopcntdq) {
+                TestBinaryMetricAlg(func_map, "AVX512::" + metric, LOOP, distance_simd.data(), NB, xb.data(), NQ,
+                                    xq.data(), code_size);
+                CheckResult(distance_ref.data(), distance_simd.data(), NB * NQ);
+            }
+        }
+    }
+}
+
+// the cutoff POPCOUNT_HARLEY_SEAL_MIN_SIZE: the AVX2 kernel of faiss, which counts 512 to 1536 bits codes by lookups,
+// against Harley-Seal on every size
+TEST(METRICTEST, BINARY_HARLEY_SEAL_BENCHMARK) {
+    if (!faiss::InstructionSet::GetInstance().AVX2()) {
+        return;
+    }
+
+    std::unordered_map<std::string, binary_metric_func_ptr> func_map;
+    func_map["AVX2::HAMMING"] = BINARY::Hamming<faiss::popcount_xor_avx>;
+    func_map["HARLEY_SEAL::HAMMING"] = HARLEY_SEAL::Hamming;
+
+    for (int64_t code_size : {64, 128, 192, 256, 512}) {
+        std::vector<uint8_t> xb(NB * code_size);
+        std::vector<uint8_t> xq(NQ * code_size);
+        GenerateBinaryData(code_size, NB, xb.data());
+        GenerateBinaryData(code_size, NQ, xq.data());
+
+        std::vector<float> distance_avx(NB * NQ);
+        std::vector<float> distance_hs(NB * NQ);
+
+        std::cout << "==========" << std::endl;
+        TestBinaryMetricAlg(func_map, "AVX2::HAMMING", LOOP, distance_avx.data(), NB, xb.data(), NQ, xq.data(),
+                            code_size);
+        TestBinaryMetricAlg(func_map, "HARLEY_SEAL::HAMMING", LOOP, distance_hs.data(), NB, xb.data(), NQ, xq.data(),
+                            code_size);
+        CheckResult(distance_avx.data(), distance_hs.data(), NB * NQ);
+    }
+}
+
+TEST(METRICTEST, BINARY_LONG_CODE_TEST) {
+    std::unordered_map<std::string, binary_metric_func_ptr> func_map;
+    func_map["REF::HAMMING"] = BINARY::Hamming<faiss::popcount_xor_ref>;
+    func_map["AVX2::HAMMING"] = BINARY::Hamming<faiss::popcount_xor_avx>;
+    func_map["AVX512::HAMMING"] = BINARY::Hamming<faiss::popcount_xor_avx512>;
+
+    func_map["REF::JACCARD"] = BINARY::Jaccard<faiss::popcount_and_or_ref>;
+    func_map["AVX2::JACCARD"] = BINARY::Jaccard<faiss::popcount_and_or_avx>;
+    func_map["AVX512::JACCARD"] = BINARY::Jaccard<faiss::popcount_and_or_avx512>;
+
+    func_map["REF::TANIMOTO"] = BINARY::Tanimoto<faiss::popcount_and_or_ref>;
+    func_map["AVX2::TANIMOTO"] = BINARY::Tanimoto<faiss::popcount_and_or_avx>;
+    func_map["AVX512::TANIMOTO"] = BINARY::Tanimoto<faiss::popcount_and_or_avx512>;
+
+    faiss::InstructionSet& instruction_set = faiss::InstructionSet::GetInstance();
+    bool support_avx2 = instruction_set.AVX2();
+    bool support_vpopcntdq = instruction_set.AVX512F() && instruction_set.AVX512BW() &&
+                             instruction_set.AVX512VPOPCNTDQ();
+
+    // 2048 and 4096 bits codes go through the Harley-Seal loop of the AVX2 kernels, the last size leaves a tail
+    constexpr int64_t nb = 1000;
+    for (int64_t code_size : {256, 512, 300}) {
+        std::vector<uint8_t> xb(nb * code_size);
+        std::vector<uint8_t> xq(NQ * code_size);
+        GenerateBinaryData(code_size, nb, xb.data());
+        GenerateBinaryData(code_size, NQ, xq.data());
+        // identical and disjoint codes, the extremes of every metric
+        std::copy(xq.begin(), xq.begin() + code_size, xb.begin());
+        std::fill(xb.begin() + code_size, xb.begin() + 2 * code_size, 0);
+
+        std::vector<float> distance_ref(nb * NQ);
+        std::vector<float> distance_simd(nb * NQ);
+
+        for (std::string metric : {"HAMMING", "JACCARD", "TANIMOTO"}) {
+            TestBinaryMetricAlg(func_map, "REF::" + metric, 1, distance_ref.data(), nb, xb.data(), NQ, xq.data(),
+                                code_size);
+            ASSERT_FLOAT_EQ(distance_ref[0], 0);
+
+            if (support_avx2) {
+                TestBinaryMetricAlg(func_map, "AVX2::" + metric, 1, distance_simd.data(), nb, xb.data(), NQ,
+                                    xq.data(), code_size);
+                CheckResult(distance_ref.data(), distance_simd.data(), nb * NQ);
+            }
+
+            if (support_vpopcntdq) {
+                TestBinaryMetricAlg(func_map, "AVX512::" + metric, 1, distance_simd.data(), nb, xb.data(), NQ,
+                                    xq.data(), code_size);
+                CheckResult(distance_ref.data(), distance_simd.data(), nb * NQ);
+            }
+        }
+    }
+}
@@ -0,0 +1,194 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+#include <iostream>
+#include <vector>
+
+#include "knowhere/common/Exception.h"
+#include "knowhere/common/Timer.h"
+#include "knowhere/index/vector_index/IndexBinaryHNSW.h"
+#include "knowhere/index/vector_index/IndexBinaryIDMAP.h"
+#include "knowhere/index/vector_index/IndexBinaryIVF.h"
+#include "knowhere/index/vector_index/adapter/VectorAdapter.h"
+#include "unittest/Helper.h"
+#include "unittest/utils.h"
+
+using ::testing::Combine;
+using ::testing::TestWithParam;
+using ::testing::Values;
+
+class BinaryHNSWTest : public DataGen, public TestWithParam<std::string> {
+ protected:
+    void
+    SetUp() override {
+        std::string MetricType = GetParam();
+        Init_with_default(true);
+        index_ = std::make_shared<milvus::knowhere::BinaryHNSW>();
+
+        milvus::knowhere::Config temp_conf{
+            {milvus::knowhere::meta::DIM, dim},
+            {milvus::knowhere::meta::TOPK, k},
+            {milvus::knowhere::IndexParams::M, 16},
+            {milvus::knowhere::IndexParams::efConstruction, 200},
+            {milvus::knowhere::IndexParams::ef, 100},
+            {milvus::knowhere::Metric::TYPE, MetricType},
+        };
+        conf = temp_conf;
+    }
+
+    void
+    TearDown() override {
+    }
+
+ protected:
+    milvus::knowhere::Config conf;
+    milvus::knowhere::BinaryHNSWPtr index_ = nullptr;
+};
+
+INSTANTIATE_TEST_CASE_P(METRICParameters, BinaryHNSWTest,
+                        Values(std::string("JACCARD"), std::string("TANIMOTO"), std::string("HAMMING")));
+
+TEST_P(BinaryHNSWTest, binaryhnsw_basic) {
+    assert(!xb_bin.empty());
+
+    // null hnsw index
+    {
+        ASSERT_ANY_THROW(index_->Serialize());
+        ASSERT_ANY_THROW(index_->Query(query_dataset, conf));
+        ASSERT_ANY_THROW(index_->Add(nullptr, conf));
+        ASSERT_ANY_THROW(index_->AddWithoutIds(nullptr, conf));
+    }
+
+    index_->BuildAll(base_dataset, conf);
+    EXPECT_EQ(index_->Count(), nb);
+    EXPECT_EQ(index_->Dim(), dim);
+
+    auto result = index_->Query(query_dataset, conf);
+    AssertAnns(result, nq, k);
+
+    std::vector<uint8_t> code(dim / 8);
+    ASSERT_TRUE(index_->GetVectorByOffset(nq, code.data()));
+    EXPECT_EQ(memcmp(code.data(), xb_bin.data() + nq * dim / 8, dim / 8), 0);
+    ASSERT_FALSE(index_->GetVectorByOffset(nb, code.data()));
+
+    faiss::ConcurrentBitsetPtr concurrent_bitset_ptr = std::make_shared<faiss::ConcurrentBitset>(nb);
+    for (int64_t i = 0; i < nq; ++i) {
+        concurrent_bitset_ptr->set(i);
+    }
+    index_->SetBlacklist(concurrent_bitset_ptr);
+
+    auto result2 = index_->Query(query_dataset, conf);
+    AssertAnns(result2, nq, k, CheckMode::CHECK_NOT_EQUAL);
+}
+
+TEST_P(BinaryHNSWTest, binaryhnsw_serialize) {
+    auto serialize = [](const std::string& filename, milvus::knowhere::BinaryPtr& bin, uint8_t* ret) {
+        FileIOWriter writer(filename);
+        writer(static_cast<void*>(bin->data.get()), bin->size);
+
+        FileIOReader reader(filename);
+        reader(ret, bin->size);
+    };
+
+    index_->BuildAll(base_dataset, conf);
+    auto expect = index_->Query(query_dataset, conf);
+
+    auto binaryset = index_->Serialize();
+    auto bin = binaryset.GetByName("BIN_HNSW");
+
+    std::string filename = "/tmp/binaryhnsw_test_serialize.bin";
+    auto load_data = new uint8_t[bin->size];
+    serialize(filename, bin, load_data);
+
+    binaryset.clear();
+    std::shared_ptr<uint8_t[]> data(load_data);
+    binaryset.Append("BIN_HNSW", data, bin->size);
+
+    auto new_index = std::make_shared<milvus::knowhere::BinaryHNSW>();
+    new_index->Load(binaryset);
+    EXPECT_EQ(new_index->Count(), nb);
+    EXPECT_EQ(new_index->Dim(), dim);
+
+    auto result = new_index->Query(query_dataset, conf);
+    AssertAnns(result, nq, k);
+
+    auto expect_ids = expect->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    auto expect_dist = expect->Get<float*>(milvus::knowhere::meta::DISTANCE);
+    auto ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    auto dist = result->Get<float*>(milvus::knowhere::meta::DISTANCE);
+    for (int64_t i = 0; i < nq * k; ++i) {
+        EXPECT_EQ(ids[i], expect_ids[i]);
+        EXPECT_FLOAT_EQ(dist[i], expect_dist[i]);
+    }
+}
+
+namespace {
+// codes at the same distance are interchangeable, a result is a hit when it is no farther than the k-th true neighbor
+double
+Recall(const milvus::knowhere::DatasetPtr& result, const milvus::knowhere::DatasetPtr& ground_truth, int64_t nq,
+       int64_t k) {
+    auto dist = result->Get<float*>(milvus::knowhere::meta::DISTANCE);
+    auto gt_dist = ground_truth->Get<float*>(milvus::knowhere::meta::DISTANCE);
+    int64_t hit = 0;
+    for (int64_t i = 0; i < nq; ++i) {
+        float radius = gt_dist[i * k + k - 1];
+        for (int64_t j = 0; j < k; ++j) {
+            auto d = dist[i * k + j];
+            hit += (d >= 0 && d <= radius + 1e-6) ? 1 : 0;
+        }
+    }
+    return (double)hit / (nq * k);
+}
+}  // namespace
+
+// the qps of BIN_HNSW and BinaryIVF at the first ef or nprobe reaching the target recall
+TEST_P(BinaryHNSWTest, binaryhnsw_vs_binaryivf) {
+    const double target_recall = 0.9;
+    const int64_t bench_nq = 100;
+    Generate(dim, nb, bench_nq, true);
+
+    auto flat = std::make_shared<milvus::knowhere::BinaryIDMAP>();
+    flat->BuildAll(base_dataset, conf);
+    auto ground_truth = flat->Query(query_dataset, conf);
+
+    milvus::knowhere::TimeRecorder rc("binary hnsw vs ivf");
+    index_->BuildAll(base_dataset, conf);
+    rc.RecordSection("BIN_HNSW build");
+
+    auto ivf = std::make_shared<milvus::knowhere::BinaryIVF>();
+    auto ivf_conf = conf;
+    ivf_conf[milvus::knowhere::IndexParams::nlist] = 100;
+    ivf->BuildAll(base_dataset, ivf_conf);
+    rc.RecordSection("BinaryIVF build");
+
+    auto bench = [&](const milvus::knowhere::VecIndexPtr& index, milvus::knowhere::Config& bench_conf,
+                     const std::string& param, const std::vector<int64_t>& values) {
+        double recall = 0.0;
+        for (auto value : values) {
+            bench_conf[param] = value;
+            milvus::knowhere::TimeRecorder tr("query");
+            auto result = index->Query(query_dataset, bench_conf);
+            double span = tr.ElapseFromBegin("done");
+            recall = Recall(result, ground_truth, bench_nq, k);
+            if (recall >= target_recall) {
+                std::cout << index->index_type() << " " << GetParam() << " " << param << "=" << value
+                          << " recall=" << recall << " qps=" << bench_nq * 1e6 / span << std::endl;
+                break;
+            }
+        }
+        return recall;
+    };
+
+    EXPECT_GE(bench(index_, conf, milvus::knowhere::IndexParams::ef, {16, 32, 64, 128, 256, 512}), target_recall);
+    EXPECT_GE(bench(ivf, ivf_conf, milvus::knowhere::IndexParams::nprobe, {1, 2, 4, 8, 16, 32, 64, 100}),
+              target_recall);
+}
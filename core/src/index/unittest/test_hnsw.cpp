@@ -10,11 +10,15 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include <gtest/gtest.h>
+#include <faiss/FaissHook.h>
 #include <knowhere/index/vector_offset_index/IndexHNSW_NM.h>
+#include <knowhere/index/vector_offset_index/IndexHNSW_SQ8NM.h>
 #include <src/index/knowhere/knowhere/index/vector_index/helpers/IndexParameter.h>
 #include <iostream>
 #include <random>
 #include "knowhere/common/Exception.h"
+#include "knowhere/index/vector_index/ConfAdapter.h"
+#include "knowhere/index/vector_index/IndexIDMAP.h"
 #include "unittest/utils.h"
 
 using ::testing::Combine;
@@ -25,10 +29,13 @@ class HNSWTest : public DataGen, public TestWithParam<std::string> {
  protected:
     void
     SetUp() override {
+        std::string cpu_flag;
+        faiss::hook_init(cpu_flag);
+
         IndexType = GetParam();
         std::cout << "IndexType from GetParam() is: " << IndexType << std::endl;
         Generate(64, 10000, 10);  // dim = 64, nb = 10000, nq = 10
-        index_ = std::make_shared<milvus::knowhere::IndexHNSW_NM>();
+        index_ = CreateIndex();
         conf = milvus::knowhere::Config{
             {milvus::knowhere::meta::DIM, 64},        {milvus::knowhere::meta::TOPK, 10},
             {milvus::knowhere::IndexParams::M, 16},   {milvus::knowhere::IndexParams::efConstruction, 200},
@@ -36,13 +43,29 @@ class HNSWTest : public DataGen, public TestWithParam<std::string> {
         };
     }
 
+    milvus::knowhere::VecIndexPtr
+    CreateIndex() {
+        if (IndexType == "HNSW_SQ8") {
+            return std::make_shared<milvus::knowhere::IndexHNSW_SQ8NM>();
+        }
+        return std::make_shared<milvus::knowhere::IndexHNSW_NM>();
+    }
+
+    void
+    AppendRawData(milvus::knowhere::BinarySet& bs) {
+        milvus::knowhere::BinaryPtr bptr = std::make_shared<milvus::knowhere::Binary>();
+        bptr->data = std::shared_ptr<uint8_t[]>((uint8_t*)xb.data(), [&](uint8_t*) {});
+        bptr->size = dim * nb * sizeof(float);
+        bs.Append(RAW_DATA, bptr);
+    }
+
  protected:
     milvus::knowhere::Config conf;
-    std::shared_ptr<milvus::knowhere::IndexHNSW_NM> index_ = nullptr;
+    milvus::knowhere::VecIndexPtr index_ = nullptr;
     std::string IndexType;
 };
 
-INSTANTIATE_TEST_CASE_P(HNSWParameters, HNSWTest, Values("HNSW"));
+INSTANTIATE_TEST_CASE_P(HNSWParameters, HNSWTest, Values("HNSW", "HNSW_SQ8"));
 
 TEST_P(HNSWTest, HNSW_basic) {
     assert(!xb.empty());
@@ -64,15 +87,7 @@ TEST_P(HNSWTest, HNSW_basic) {
 
     // Serialize and Load before Query
     milvus::knowhere::BinarySet bs = index_->Serialize();
-
-    int64_t dim = base_dataset->Get<int64_t>(milvus::knowhere::meta::DIM);
-    int64_t rows = base_dataset->Get<int64_t>(milvus::knowhere::meta::ROWS);
-    auto raw_data = base_dataset->Get<const void*>(milvus::knowhere::meta::TENSOR);
-    milvus::knowhere::BinaryPtr bptr = std::make_shared<milvus::knowhere::Binary>();
-    bptr->data = std::shared_ptr<uint8_t[]>((uint8_t*)raw_data, [&](uint8_t*) {});
-    bptr->size = dim * rows * sizeof(float);
-    bs.Append(RAW_DATA, bptr);
-
+    AppendRawData(bs);
     index_->Load(bs);
 
     auto result = index_->Query(query_dataset, conf);
@@ -94,15 +109,7 @@ TEST_P(HNSWTest, HNSW_delete) {
 
     // Serialize and Load before Query
     milvus::knowhere::BinarySet bs = index_->Serialize();
-
-    int64_t dim = base_dataset->Get<int64_t>(milvus::knowhere::meta::DIM);
-    int64_t rows = base_dataset->Get<int64_t>(milvus::knowhere::meta::ROWS);
-    auto raw_data = base_dataset->Get<const void*>(milvus::knowhere::meta::TENSOR);
-    milvus::knowhere::BinaryPtr bptr = std::make_shared<milvus::knowhere::Binary>();
-    bptr->data = std::shared_ptr<uint8_t[]>((uint8_t*)raw_data, [&](uint8_t*) {});
-    bptr->size = dim * rows * sizeof(float);
-    bs.Append(RAW_DATA, bptr);
-
+    AppendRawData(bs);
     index_->Load(bs);
 
     auto result1 = index_->Query(query_dataset, conf);
@@ -134,6 +141,122 @@ TEST_P(HNSWTest, HNSW_delete) {
     */
 }
 
+TEST_P(HNSWTest, HNSW_refine) {
+    if (IndexType != "HNSW_SQ8") {
+        return;
+    }
+
+    index_->Train(base_dataset, conf);
+    index_->Add(base_dataset, conf);
+
+    // reload without raw data, refine_factor is ignored
+    auto bs = index_->Serialize();
+    auto new_index = CreateIndex();
+    new_index->Load(bs);
+    EXPECT_EQ(new_index->Count(), nb);
+    auto refine_conf = conf;
+    refine_conf[milvus::knowhere::IndexParams::refine_factor] = 4;
+    auto result = new_index->Query(query_dataset, refine_conf);
+    AssertAnns(result, nq, k);
+
+    // reload with raw data, results are re-ranked by exact distances
+    AppendRawData(bs);
+    new_index->Load(bs);
+    result = new_index->Query(query_dataset, refine_conf);
+    AssertAnns(result, nq, k);
+    auto dist = result->Get<float*>(milvus::knowhere::meta::DISTANCE);
+    for (int64_t i = 0; i < nq; ++i) {
+        EXPECT_FLOAT_EQ(dist[i * k], 0.0f);
+    }
+
+    faiss::ConcurrentBitsetPtr bitset = std::make_shared<faiss::ConcurrentBitset>(nb);
+    for (int64_t i = 0; i < nq; ++i) {
+        bitset->set(i);
+    }
+    new_index->SetBlacklist(bitset);
+    result = new_index->Query(query_dataset, refine_conf);
+    AssertAnns(result, nq, k, CheckMode::CHECK_NOT_EQUAL);
+}
+
+TEST_P(HNSWTest, HNSW_refine_ip) {
+    if (IndexType != "HNSW_SQ8") {
+        return;
+    }
+
+    conf[milvus::knowhere::Metric::TYPE] = milvus::knowhere::Metric::IP;
+    conf[milvus::knowhere::IndexParams::refine_factor] = 4;
+    index_->Train(base_dataset, conf);
+    index_->Add(base_dataset, conf);
+
+    auto bs = index_->Serialize();
+    AppendRawData(bs);
+    index_->Load(bs);
+
+    // refine_factor from the build config is used when the search config has none
+    conf.erase(milvus::knowhere::IndexParams::refine_factor);
+    for (auto& with_raw_data : {true, false}) {
+        if (!with_raw_data) {
+            bs.binary_map_.erase(RAW_DATA);
+            index_->Load(bs);
+        }
+        auto result = index_->Query(query_dataset, conf);
+        auto dist = result->Get<float*>(milvus::knowhere::meta::DISTANCE);
+        for (int64_t i = 0; i < nq; ++i) {
+            for (int64_t j = 1; j < k; ++j) {
+                EXPECT_GE(dist[i * k + j - 1], dist[i * k + j]);
+            }
+        }
+    }
+}
+
+TEST_P(HNSWTest, HNSW_conf_adapter) {
+    if (IndexType != "HNSW_SQ8") {
+        return;
+    }
+
+    milvus::knowhere::HNSWSQ8ConfAdapter adapter;
+    auto adapter_conf = conf;
+    adapter_conf[milvus::knowhere::meta::ROWS] = nb;
+    EXPECT_TRUE(adapter.CheckTrain(adapter_conf, milvus::knowhere::IndexMode::MODE_CPU));
+
+    adapter_conf[milvus::knowhere::IndexParams::refine_factor] = 0;
+    EXPECT_FALSE(adapter.CheckTrain(adapter_conf, milvus::knowhere::IndexMode::MODE_CPU));
+
+    adapter_conf[milvus::knowhere::IndexParams::refine_factor] = 4;
+    adapter_conf[milvus::knowhere::Metric::TYPE] = milvus::knowhere::Metric::HAMMING;
+    EXPECT_FALSE(adapter.CheckTrain(adapter_conf, milvus::knowhere::IndexMode::MODE_CPU));
+
+    EXPECT_TRUE(adapter.CheckSearch(adapter_conf, index_->index_type(), milvus::knowhere::IndexMode::MODE_CPU));
+    adapter_conf[milvus::knowhere::IndexParams::refine_factor] = 64;
+    EXPECT_FALSE(adapter.CheckSearch(adapter_conf, index_->index_type(), milvus::knowhere::IndexMode::MODE_CPU));
+}
+
+TEST_P(HNSWTest, HNSW_recall) {
+    Generate(128, 20000, 100);
+    conf[milvus::knowhere::meta::DIM] = dim;
+
+    auto idmap = std::make_shared<milvus::knowhere::IDMAP>();
+    idmap->Train(base_dataset, conf);
+    idmap->AddWithoutIds(base_dataset, conf);
+    auto ground_truth = idmap->Query(query_dataset, conf);
+
+    index_->Train(base_dataset, conf);
+    index_->Add(base_dataset, conf);
+    auto bs = index_->Serialize();
+    AppendRawData(bs);
+    index_->Load(bs);
+    double recall = CalcRecall(index_->Query(query_dataset, conf), ground_truth, nq, k);
+    EXPECT_GE(recall, 0.9);
+
+    if (IndexType == "HNSW_SQ8") {
+        // exact re-ranking of the candidates recovers what the 8-bit codes lose
+        auto refine_conf = conf;
+        refine_conf[milvus::knowhere::IndexParams::refine_factor] = 4;
+        double refine_recall = CalcRecall(index_->Query(query_dataset, refine_conf), ground_truth, nq, k);
+        EXPECT_GE(refine_recall, recall);
+    }
+}
+
 /*
 TEST_P(HNSWTest, HNSW_serialize) {
     auto serialize = [](const std::string& filename, milvus::knowhere::BinaryPtr& bin, uint8_t* ret) {
@@ -102,6 +102,11 @@ TEST_P(IDMAPTest, idmap_basic) {
     AssertAnns(result2, nq, k);
     //    PrintResult(re_result, nq, k);
 
+    std::vector<float> vec(dim);
+    ASSERT_TRUE(new_index->GetVectorByOffset(nb - 1, (uint8_t*)vec.data()));
+    EXPECT_EQ(memcmp(vec.data(), xb.data() + (nb - 1) * dim, dim * sizeof(float)), 0);
+    EXPECT_FALSE(new_index->GetVectorByOffset(nb, (uint8_t*)vec.data()));
+
 #if 0
     auto result3 = new_index->QueryById(id_dataset, conf);
     AssertAnns(result3, nq, k);
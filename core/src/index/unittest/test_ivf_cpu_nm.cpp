@@ -95,6 +95,15 @@ TEST_P(IVFNMCPUTest, ivf_basic_cpu) {
     auto result = index_->Query(query_dataset, conf_);
     AssertAnns(result, nq, k);
 
+    // raw vectors are kept arranged by inverted list, they are still fetched by their offset
+    std::vector<float> vec(dim);
+    std::vector<int64_t> offsets = {0, nb / 2, nb - 1};
+    for (auto offset : offsets) {
+        ASSERT_TRUE(index_->GetVectorByOffset(offset, (uint8_t*)vec.data()));
+        EXPECT_EQ(memcmp(vec.data(), xb.data() + offset * dim, dim * sizeof(float)), 0);
+    }
+    EXPECT_FALSE(index_->GetVectorByOffset(nb, (uint8_t*)vec.data()));
+
     faiss::ConcurrentBitsetPtr concurrent_bitset_ptr = std::make_shared<faiss::ConcurrentBitset>(nb);
     for (int64_t i = 0; i < nq; ++i) {
         concurrent_bitset_ptr->set(i);
@@ -0,0 +1,232 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <faiss/FaissHook.h>
+#include <faiss/utils/instruction_set.h>
+#include <faiss/utils/pq4_fast_scan.h>
+#include <faiss/utils/pq4_fast_scan_avx.h>
+
+#include "knowhere/common/Exception.h"
+#include "knowhere/common/Timer.h"
+#include "knowhere/index/vector_index/ConfAdapter.h"
+#include "knowhere/index/vector_index/IndexIDMAP.h"
+#include "knowhere/index/vector_index/IndexIVFPQ.h"
+#include "knowhere/index/vector_index/IndexIVFPQFastScan.h"
+#include "knowhere/index/vector_index/IndexIVFSQ.h"
+#include "knowhere/index/vector_index/adapter/VectorAdapter.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
+
+#include "unittest/utils.h"
+
+class IVFPQFastScanTest : public DataGen, public ::testing::Test {
+ protected:
+    void
+    SetUp() override {
+        std::string cpu_flag;
+        faiss::hook_init(cpu_flag);
+
+        Generate(128, 10000, 10);
+        index_ = std::make_shared<milvus::knowhere::IVFPQFastScan>();
+        conf_ = milvus::knowhere::Config{
+            {milvus::knowhere::meta::DIM, dim},
+            {milvus::knowhere::meta::TOPK, k},
+            {milvus::knowhere::IndexParams::nlist, 100},
+            {milvus::knowhere::IndexParams::nprobe, 8},
+            {milvus::knowhere::IndexParams::m, 32},
+            {milvus::knowhere::Metric::TYPE, milvus::knowhere::Metric::L2},
+        };
+    }
+
+    void
+    AppendRawData(milvus::knowhere::BinarySet& bs) {
+        milvus::knowhere::BinaryPtr bptr = std::make_shared<milvus::knowhere::Binary>();
+        bptr->data = std::shared_ptr<uint8_t[]>((uint8_t*)xb.data(), [&](uint8_t*) {});
+        bptr->size = dim * nb * sizeof(float);
+        bs.Append(RAW_DATA, bptr);
+    }
+
+ protected:
+    milvus::knowhere::Config conf_;
+    milvus::knowhere::IVFPQFastScanPtr index_ = nullptr;
+};
+
+TEST_F(IVFPQFastScanTest, fastscan_basic) {
+    assert(!xb.empty());
+
+    // null index
+    ASSERT_ANY_THROW(index_->Add(base_dataset, conf_));
+    ASSERT_ANY_THROW(index_->Query(query_dataset, conf_));
+    ASSERT_ANY_THROW(index_->Serialize(conf_));
+
+    index_->Train(base_dataset, conf_);
+    index_->AddWithoutIds(base_dataset, conf_);
+    EXPECT_EQ(index_->Count(), nb);
+    EXPECT_EQ(index_->Dim(), dim);
+
+    auto result = index_->Query(query_dataset, conf_);
+    AssertAnns(result, nq, k);
+
+    // reload without raw data, refine_factor is ignored
+    auto bs = index_->Serialize(conf_);
+    auto new_index = std::make_shared<milvus::knowhere::IVFPQFastScan>();
+    new_index->Load(bs);
+    EXPECT_EQ(new_index->Count(), nb);
+    std::vector<float> vector(dim);
+    EXPECT_FALSE(new_index->GetVectorByOffset(0, (uint8_t*)vector.data()));
+    auto conf = conf_;
+    conf[milvus::knowhere::IndexParams::refine_factor] = 4;
+    result = new_index->Query(query_dataset, conf);
+    AssertAnns(result, nq, k);
+
+    // reload with raw data, results are re-ranked by exact distances
+    AppendRawData(bs);
+    new_index->Load(bs);
+    EXPECT_TRUE(new_index->GetVectorByOffset(1, (uint8_t*)vector.data()));
+    EXPECT_EQ(vector, std::vector<float>(xb.begin() + dim, xb.begin() + 2 * dim));
+    result = new_index->Query(query_dataset, conf);
+    AssertAnns(result, nq, k);
+    auto dist = result->Get<float*>(milvus::knowhere::meta::DISTANCE);
+    for (int64_t i = 0; i < nq; ++i) {
+        EXPECT_FLOAT_EQ(dist[i * k], 0.0f);
+    }
+
+    faiss::ConcurrentBitsetPtr concurrent_bitset_ptr = std::make_shared<faiss::ConcurrentBitset>(nb);
+    for (int64_t i = 0; i < nq; ++i) {
+        concurrent_bitset_ptr->set(i);
+    }
+    new_index->SetBlacklist(concurrent_bitset_ptr);
+    result = new_index->Query(query_dataset, conf);
+    AssertAnns(result, nq, k, CheckMode::CHECK_NOT_EQUAL);
+}
+
+TEST_F(IVFPQFastScanTest, fastscan_ip) {
+    conf_[milvus::knowhere::Metric::TYPE] = milvus::knowhere::Metric::IP;
+    conf_[milvus::knowhere::IndexParams::refine_factor] = 8;
+    index_->Train(base_dataset, conf_);
+    index_->AddWithoutIds(base_dataset, conf_);
+
+    auto bs = index_->Serialize(conf_);
+    AppendRawData(bs);
+    index_->Load(bs);
+
+    // refine_factor from the build config is used when the search config has none
+    conf_.erase(milvus::knowhere::IndexParams::refine_factor);
+    auto result = index_->Query(query_dataset, conf_);
+    auto dist = result->Get<float*>(milvus::knowhere::meta::DISTANCE);
+    for (int64_t i = 0; i < nq; ++i) {
+        for (int64_t j = 1; j < k; ++j) {
+            EXPECT_GE(dist[i * k + j - 1], dist[i * k + j]);
+        }
+    }
+}
+
+TEST_F(IVFPQFastScanTest, fastscan_conf_adapter) {
+    milvus::knowhere::IVFPQFastScanConfAdapter adapter;
+    auto conf = conf_;
+    conf[milvus::knowhere::meta::ROWS] = nb;
+    EXPECT_TRUE(adapter.CheckTrain(conf, milvus::knowhere::IndexMode::MODE_CPU));
+    EXPECT_EQ(conf[milvus::knowhere::IndexParams::nbits].get<int64_t>(), 4);
+
+    conf[milvus::knowhere::IndexParams::m] = 7;
+    EXPECT_FALSE(adapter.CheckTrain(conf, milvus::knowhere::IndexMode::MODE_CPU));
+
+    conf[milvus::knowhere::IndexParams::m] = 32;
+    conf[milvus::knowhere::IndexParams::refine_factor] = 0;
+    EXPECT_FALSE(adapter.CheckTrain(conf, milvus::knowhere::IndexMode::MODE_CPU));
+
+    conf[milvus::knowhere::IndexParams::refine_factor] = 4;
+    EXPECT_TRUE(adapter.CheckSearch(conf, index_->index_type(), milvus::knowhere::IndexMode::MODE_CPU));
+    conf[milvus::knowhere::IndexParams::refine_factor] = 64;
+    EXPECT_FALSE(adapter.CheckSearch(conf, index_->index_type(), milvus::knowhere::IndexMode::MODE_CPU));
+}
+
+TEST_F(IVFPQFastScanTest, fastscan_kernel_test) {
+    if (!faiss::InstructionSet::GetInstance().AVX2()) {
+        return;
+    }
+
+    std::vector<uint16_t> dis_ref(faiss::PQ4_BLOCK_SIZE);
+    std::vector<uint16_t> dis_avx(faiss::PQ4_BLOCK_SIZE);
+    for (size_t M : {1, 8, 32, 64}) {
+        std::vector<uint8_t> LUT(M * 16);
+        for (auto& entry : LUT) {
+            entry = lrand48() & 0xff;
+        }
+        std::vector<uint8_t> block(faiss::pq4_block_bytes(M), 0);
+        std::vector<uint8_t> codes(M);
+        for (size_t j = 0; j < faiss::PQ4_BLOCK_SIZE; ++j) {
+            for (auto& code : codes) {
+                code = lrand48() & 15;
+            }
+            faiss::pq4_set_block_code(M, block.data(), j, codes.data());
+        }
+
+        faiss::pq4_accumulate_block_ref(M, block.data(), LUT.data(), dis_ref.data());
+        faiss::pq4_accumulate_block_avx(M, block.data(), LUT.data(), dis_avx.data());
+        EXPECT_EQ(dis_ref, dis_avx);
+    }
+}
+
+TEST_F(IVFPQFastScanTest, fastscan_compare_test) {
+    Generate(128, 20000, 100);
+
+    auto idmap = std::make_shared<milvus::knowhere::IDMAP>();
+    idmap->Train(base_dataset, conf_);
+    idmap->AddWithoutIds(base_dataset, conf_);
+    auto ground_truth = idmap->Query(query_dataset, conf_);
+
+    auto bench = [&](const std::string& name, const milvus::knowhere::VecIndexPtr& index,
+                     const milvus::knowhere::Config& bench_conf) {
+        milvus::knowhere::TimeRecorder tr(name);
+        auto result = index->Query(query_dataset, bench_conf);
+        double span = tr.ElapseFromBegin("done");
+        AssertAnns(result, nq, k);
+        double recall = CalcRecall(result, ground_truth, nq, k);
+        std::cout << name << " recall@" << k << "=" << recall << " qps=" << nq * 1e6 / span << std::endl;
+        return recall;
+    };
+
+    auto sq8 = std::make_shared<milvus::knowhere::IVFSQ>();
+    auto sq8_conf = conf_;
+    sq8_conf[milvus::knowhere::IndexParams::nbits] = 8;
+    sq8->Train(base_dataset, sq8_conf);
+    sq8->AddWithoutIds(base_dataset, sq8_conf);
+    bench("IVF_SQ8", sq8, sq8_conf);
+
+    auto pq = std::make_shared<milvus::knowhere::IVFPQ>();
+    auto pq_conf = conf_;
+    pq_conf[milvus::knowhere::IndexParams::nbits] = 8;
+    pq->Train(base_dataset, pq_conf);
+    pq->AddWithoutIds(base_dataset, pq_conf);
+    double pq_recall = bench("IVF_PQ", pq, pq_conf);
+
+    index_->Train(base_dataset, conf_);
+    index_->AddWithoutIds(base_dataset, conf_);
+    double fastscan_recall = bench("IVF_PQ_FASTSCAN", index_, conf_);
+    EXPECT_GE(fastscan_recall, 0.3);
+
+    // exact re-ranking of 4 * topk candidates makes up for the 4-bit codes
+    auto bs = index_->Serialize(conf_);
+    AppendRawData(bs);
+    index_->Load(bs);
+    auto refine_conf = conf_;
+    refine_conf[milvus::knowhere::IndexParams::refine_factor] = 4;
+    double refine_recall = bench("IVF_PQ_FASTSCAN refine x4", index_, refine_conf);
+    EXPECT_GT(refine_recall, fastscan_recall);
+    EXPECT_GT(refine_recall, pq_recall * 0.9);
+}
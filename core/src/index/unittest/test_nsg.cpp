@@ -12,9 +12,15 @@
 #include <fiu-control.h>
 #include <fiu-local.h>
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
 #include <memory>
+#include <string>
+#include <unordered_set>
+#include <utility>
 
 #include "knowhere/common/Exception.h"
+#include "knowhere/index/vector_index/IndexIDMAP.h"
 #include "knowhere/index/vector_index/helpers/IndexParameter.h"
 #include "knowhere/index/vector_offset_index/IndexNSG_NM.h"
 #ifdef MILVUS_GPU_VERSION
@@ -24,6 +30,7 @@
 #endif
 
 #include "knowhere/common/Timer.h"
+#include "knowhere/index/vector_index/impl/nsg/NNDescent.h"
 #include "knowhere/index/vector_index/impl/nsg/NSGIO.h"
 
 #include "unittest/utils.h"
@@ -200,3 +207,131 @@ TEST_F(NSGInterfaceTest, delete_test) {
         ASSERT_NE(I_before[i * k], I_after[i * k]);
     }
 }
+
+TEST_F(NSGInterfaceTest, delete_most_test) {
+    assert(!xb.empty());
+
+    train_conf[milvus::knowhere::meta::DEVICEID] = DEVICE_GPU0;
+    index_->Train(base_dataset, train_conf);
+
+    milvus::knowhere::BinarySet bs = index_->Serialize();
+    int64_t dim = base_dataset->Get<int64_t>(milvus::knowhere::meta::DIM);
+    int64_t rows = base_dataset->Get<int64_t>(milvus::knowhere::meta::ROWS);
+    auto raw_data = base_dataset->Get<const void*>(milvus::knowhere::meta::TENSOR);
+    milvus::knowhere::BinaryPtr bptr = std::make_shared<milvus::knowhere::Binary>();
+    bptr->data = std::shared_ptr<uint8_t[]>((uint8_t*)raw_data, [&](uint8_t*) {});
+    bptr->size = dim * rows * sizeof(float);
+    bs.Append(RAW_DATA, bptr);
+    index_->Load(bs);
+
+    // keep one vector of every 50, the search must walk through the deleted ones to find k valid results
+    faiss::ConcurrentBitsetPtr bitset = std::make_shared<faiss::ConcurrentBitset>(nb);
+    for (int64_t i = 0; i < nb; i++) {
+        if (i % 50 != 0) {
+            bitset->set(i);
+        }
+    }
+    index_->SetBlacklist(bitset);
+
+    auto result = index_->Query(query_dataset, search_conf);
+    auto I = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    for (int64_t i = 0; i < nq * k; i++) {
+        ASSERT_NE(I[i], -1);
+        ASSERT_EQ(I[i] % 50, 0);
+    }
+    // the first query is the first base vector, which is kept
+    ASSERT_EQ(I[0], 0);
+}
+
+TEST_F(NSGInterfaceTest, knng_builder_compare_test) {
+    assert(!xb.empty());
+
+    // recall of the NN-descent knng against brute force, over the first nodes
+    const size_t knng_k = 20;
+    const int64_t check_nodes = 100;
+    auto knng_recall = [&](const std::vector<float>& data, const std::string& metric) {
+        milvus::knowhere::impl::NNDescentParams params;
+        params.k = knng_k;
+        milvus::knowhere::impl::Graph knng;
+        milvus::knowhere::impl::NNDescent builder(dim, nb, metric);
+        builder.Build(data.data(), params, knng);
+
+        bool ip = (metric == milvus::knowhere::Metric::IP);
+        int64_t hit = 0;
+        for (int64_t n = 0; n < check_nodes; ++n) {
+            std::vector<std::pair<float, int64_t>> dists;
+            for (int64_t id = 0; id < nb; ++id) {
+                if (id == n) {
+                    continue;
+                }
+                float dist = 0;
+                for (int64_t d = 0; d < dim; ++d) {
+                    float a = data[n * dim + d], b = data[id * dim + d];
+                    dist += ip ? -a * b : (a - b) * (a - b);
+                }
+                dists.emplace_back(dist, id);
+            }
+            std::partial_sort(dists.begin(), dists.begin() + knng_k, dists.end());
+            std::unordered_set<int64_t> gt_set;
+            for (size_t i = 0; i < knng_k; ++i) {
+                gt_set.insert(dists[i].second);
+            }
+            EXPECT_EQ(knng[n].size(), knng_k);
+            for (auto id : knng[n]) {
+                hit += gt_set.count(id);
+            }
+        }
+        return (double)hit / (check_nodes * knng_k);
+    };
+
+    ASSERT_GE(knng_recall(xb, milvus::knowhere::Metric::L2), 0.8);
+
+    // the most similar neighbours under IP, which ranks larger values first
+    std::vector<float> normalized(xb);
+    for (int64_t n = 0; n < nb; ++n) {
+        float norm = std::sqrt(milvus::knowhere::impl::DistanceIP().Compare(&xb[n * dim], &xb[n * dim], dim));
+        for (int64_t d = 0; d < dim; ++d) {
+            normalized[n * dim + d] /= norm;
+        }
+    }
+    ASSERT_GE(knng_recall(normalized, milvus::knowhere::Metric::IP), 0.8);
+
+    // NSG built on the NN-descent knng against NSG built on the IVF knng, both against brute force
+    milvus::knowhere::Config idmap_conf{{milvus::knowhere::meta::DIM, dim},
+                                        {milvus::knowhere::meta::TOPK, k},
+                                        {milvus::knowhere::Metric::TYPE, milvus::knowhere::Metric::L2}};
+    auto idmap = std::make_shared<milvus::knowhere::IDMAP>();
+    idmap->Train(base_dataset, idmap_conf);
+    idmap->AddWithoutIds(base_dataset, idmap_conf);
+    auto ground_truth = idmap->Query(query_dataset, idmap_conf);
+
+    auto build_and_query = [&](const std::string& builder) {
+        auto index = std::make_shared<milvus::knowhere::NSG_NM>();
+        auto conf = train_conf;
+        conf[milvus::knowhere::meta::DEVICEID] = -1;
+        conf[milvus::knowhere::IndexParams::knng_builder] = builder;
+
+        milvus::knowhere::TimeRecorder tc("NSG with " + builder + " knng");
+        index->BuildAll(base_dataset, conf);
+        tc.RecordSection("build");
+
+        milvus::knowhere::BinarySet bs = index->Serialize();
+        milvus::knowhere::BinaryPtr bptr = std::make_shared<milvus::knowhere::Binary>();
+        bptr->data = std::shared_ptr<uint8_t[]>((uint8_t*)xb.data(), [&](uint8_t*) {});
+        bptr->size = dim * nb * sizeof(float);
+        bs.Append(RAW_DATA, bptr);
+        index->Load(bs);
+        auto result = index->Query(query_dataset, search_conf);
+        AssertAnns(result, nq, k);
+
+        double recall = CalcRecall(result, ground_truth, nq, k);
+        tc.RecordSection("search, recall@" + std::to_string(k) + " " + std::to_string(recall));
+        return recall;
+    };
+
+    // build times are reported only, they depend too much on the machine to be asserted
+    double ivf_recall = build_and_query(milvus::knowhere::KnngBuilder::IVF);
+    double nnd_recall = build_and_query(milvus::knowhere::KnngBuilder::NN_DESCENT);
+    ASSERT_GE(nnd_recall, 0.8);
+    ASSERT_GE(nnd_recall, ivf_recall - 0.1);
+}
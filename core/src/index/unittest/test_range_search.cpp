@@ -0,0 +1,179 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <faiss/FaissHook.h>
+#include <faiss/utils/distances.h>
+
+#include "knowhere/common/Exception.h"
+#include "knowhere/index/vector_index/IndexIDMAP.h"
+#include "knowhere/index/vector_index/IndexIVF.h"
+#include "knowhere/index/vector_index/IndexIVFPQ.h"
+#include "knowhere/index/vector_index/IndexIVFSQ.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
+#include "knowhere/index/vector_offset_index/IndexHNSW_NM.h"
+#include "knowhere/index/vector_offset_index/IndexIVF_NM.h"
+
+#include "unittest/utils.h"
+
+class RangeSearchTest : public DataGen, public ::testing::Test {
+ protected:
+    void
+    SetUp() override {
+        std::string cpu_flag;
+        faiss::hook_init(cpu_flag);
+
+        Generate(64, 10000, 10);
+        conf_ = milvus::knowhere::Config{
+            {milvus::knowhere::meta::DIM, dim},
+            {milvus::knowhere::meta::TOPK, k},
+            {milvus::knowhere::IndexParams::nlist, 100},
+            {milvus::knowhere::IndexParams::nprobe, 100},
+            {milvus::knowhere::IndexParams::m, 8},
+            {milvus::knowhere::IndexParams::nbits, 8},
+            {milvus::knowhere::IndexParams::M, 16},
+            {milvus::knowhere::IndexParams::efConstruction, 200},
+            {milvus::knowhere::IndexParams::ef, 64},
+            {milvus::knowhere::Metric::TYPE, milvus::knowhere::Metric::L2},
+        };
+
+        // pick a radius which keeps a few hundred neighbours of every query
+        std::vector<float> dis(nb);
+        faiss::fvec_L2sqr_ny(dis.data(), xq.data(), xb.data(), dim, nb);
+        std::nth_element(dis.begin(), dis.begin() + 200, dis.end());
+        radius_ = dis[200];
+        conf_[milvus::knowhere::IndexParams::radius] = radius_;
+    }
+
+    void
+    AppendRawData(milvus::knowhere::BinarySet& bs) {
+        milvus::knowhere::BinaryPtr bptr = std::make_shared<milvus::knowhere::Binary>();
+        bptr->data = std::shared_ptr<uint8_t[]>((uint8_t*)xb.data(), [&](uint8_t*) {});
+        bptr->size = dim * nb * sizeof(float);
+        bs.Append(RAW_DATA, bptr);
+    }
+
+    // exact answer of every query, as a set of ids
+    std::vector<std::unordered_set<int64_t>>
+    GroundTruth() {
+        std::vector<std::unordered_set<int64_t>> gt(nq);
+        std::vector<float> dis(nb);
+        for (int64_t i = 0; i < nq; ++i) {
+            faiss::fvec_L2sqr_ny(dis.data(), xq.data() + i * dim, xb.data(), dim, nb);
+            for (int64_t j = 0; j < nb; ++j) {
+                if (dis[j] < radius_) {
+                    gt[i].insert(j);
+                }
+            }
+        }
+        return gt;
+    }
+
+    // checks the layout of a range result and returns its recall against the ground truth
+    double
+    CheckRangeResult(const milvus::knowhere::DatasetPtr& result, bool exact) {
+        auto lims = result->Get<int64_t*>(milvus::knowhere::meta::LIMS);
+        auto ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+        auto dist = result->Get<float*>(milvus::knowhere::meta::DISTANCE);
+        auto gt = GroundTruth();
+
+        EXPECT_EQ(lims[0], 0);
+        int64_t hit = 0, total = 0;
+        for (int64_t i = 0; i < nq; ++i) {
+            EXPECT_LE(lims[i], lims[i + 1]);
+            for (int64_t j = lims[i]; j < lims[i + 1]; ++j) {
+                if (exact) {
+                    EXPECT_LT(dist[j], radius_);
+                }
+                if (j > lims[i]) {
+                    EXPECT_LE(dist[j - 1], dist[j]);
+                }
+                hit += gt[i].count(ids[j]);
+            }
+            total += gt[i].size();
+        }
+        return (double)hit / total;
+    }
+
+ protected:
+    milvus::knowhere::Config conf_;
+    float radius_ = 0;
+};
+
+TEST_F(RangeSearchTest, idmap_range) {
+    auto index = std::make_shared<milvus::knowhere::IDMAP>();
+    ASSERT_ANY_THROW(index->QueryByRange(query_dataset, conf_));
+
+    index->Train(base_dataset, conf_);
+    index->AddWithoutIds(base_dataset, conf_);
+    auto result = index->QueryByRange(query_dataset, conf_);
+    EXPECT_DOUBLE_EQ(CheckRangeResult(result, true), 1.0);
+
+    // filtered entities never show up in the result
+    faiss::ConcurrentBitsetPtr concurrent_bitset_ptr = std::make_shared<faiss::ConcurrentBitset>(nb);
+    for (int64_t i = 0; i < nq; ++i) {
+        concurrent_bitset_ptr->set(i);
+    }
+    index->SetBlacklist(concurrent_bitset_ptr);
+    result = index->QueryByRange(query_dataset, conf_);
+    auto lims = result->Get<int64_t*>(milvus::knowhere::meta::LIMS);
+    auto ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    for (int64_t j = 0; j < lims[nq]; ++j) {
+        EXPECT_GE(ids[j], nq);
+    }
+}
+
+TEST_F(RangeSearchTest, ivf_range) {
+    auto ivf = std::make_shared<milvus::knowhere::IVF>();
+    ASSERT_ANY_THROW(ivf->QueryByRange(query_dataset, conf_));
+    ivf->Train(base_dataset, conf_);
+    ivf->AddWithoutIds(base_dataset, conf_);
+    EXPECT_DOUBLE_EQ(CheckRangeResult(ivf->QueryByRange(query_dataset, conf_), true), 1.0);
+
+    auto ivf_nm = std::make_shared<milvus::knowhere::IVF_NM>();
+    ivf_nm->Train(base_dataset, conf_);
+    ivf_nm->AddWithoutIds(base_dataset, conf_);
+    auto bs = ivf_nm->Serialize(conf_);
+    AppendRawData(bs);
+    ivf_nm->Load(bs);
+    EXPECT_DOUBLE_EQ(CheckRangeResult(ivf_nm->QueryByRange(query_dataset, conf_), true), 1.0);
+
+    // quantized codes give approximate distances
+    auto ivf_sq = std::make_shared<milvus::knowhere::IVFSQ>();
+    ivf_sq->Train(base_dataset, conf_);
+    ivf_sq->AddWithoutIds(base_dataset, conf_);
+    EXPECT_GT(CheckRangeResult(ivf_sq->QueryByRange(query_dataset, conf_), false), 0.8);
+
+    auto ivf_pq = std::make_shared<milvus::knowhere::IVFPQ>();
+    ivf_pq->Train(base_dataset, conf_);
+    ivf_pq->AddWithoutIds(base_dataset, conf_);
+    ASSERT_GT(CheckRangeResult(ivf_pq->QueryByRange(query_dataset, conf_), false), 0.0);
+}
+
+TEST_F(RangeSearchTest, hnsw_range) {
+    auto index = std::make_shared<milvus::knowhere::IndexHNSW_NM>();
+    ASSERT_ANY_THROW(index->QueryByRange(query_dataset, conf_));
+    index->Train(base_dataset, conf_);
+    index->Add(base_dataset, conf_);
+    auto bs = index->Serialize(conf_);
+    AppendRawData(bs);
+    index->Load(bs);
+
+    // ef is only the first candidate count, it is enlarged until the radius is covered
+    EXPECT_GT(CheckRangeResult(index->QueryByRange(query_dataset, conf_), true), 0.9);
+}
@@ -10,10 +10,15 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
 #include <iostream>
+#include <numeric>
 #include <sstream>
 
 #include "knowhere/common/Exception.h"
+#include "knowhere/index/vector_index/IndexHNSW.h"
 #include "knowhere/index/vector_index/IndexSPTAG.h"
 #include "knowhere/index/vector_index/adapter/SptagAdapter.h"
 #include "knowhere/index/vector_index/adapter/VectorAdapter.h"
@@ -54,6 +59,26 @@ class SPTAGTest : public DataGen, public TestWithParam<std::string> {
     std::string IndexType;
 };
 
+namespace {
+
+// every row of an fvecs file is its dimension followed by the floats
+std::vector<float>
+ReadFvecs(const std::string& file_name, int64_t& dim, int64_t& rows) {
+    std::vector<float> data;
+    std::ifstream in(file_name, std::ios::binary);
+    int32_t d = 0;
+    while (in.read(reinterpret_cast<char*>(&d), sizeof(d))) {
+        size_t offset = data.size();
+        data.resize(offset + d);
+        in.read(reinterpret_cast<char*>(data.data() + offset), d * sizeof(float));
+    }
+    dim = d;
+    rows = d > 0 ? data.size() / d : 0;
+    return data;
+}
+
+}  // namespace
+
 INSTANTIATE_TEST_CASE_P(SPTAGParameters, SPTAGTest, Values("KDT", "BKT"));
 
 // TODO(lxj): add test about count() and dimension()
@@ -141,3 +166,132 @@ TEST_P(SPTAGTest, sptag_serialize) {
         PrintResult(result, nq, k);
     }
 }
+
+TEST_P(SPTAGTest, sptag_delete) {
+    assert(!xb.empty());
+
+    index_->BuildAll(base_dataset, conf);
+    ASSERT_EQ(index_->Count(), nb);
+
+    auto result1 = index_->Query(query_dataset, conf);
+    AssertAnns(result1, nq, k);
+
+    // the queries are the first nq base vectors
+    faiss::ConcurrentBitsetPtr bitset = std::make_shared<faiss::ConcurrentBitset>(nb);
+    for (auto i = 0; i < nq; ++i) {
+        bitset->set(i);
+    }
+    index_->SetBlacklist(bitset);
+    auto result2 = index_->Query(query_dataset, conf);
+    AssertAnns(result2, nq, k, CheckMode::CHECK_NOT_EQUAL);
+
+    auto ids = result2->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    for (auto i = 0; i < nq * k; ++i) {
+        if (ids[i] != -1) {
+            ASSERT_FALSE(bitset->test(ids[i]));
+        }
+    }
+}
+
+TEST_P(SPTAGTest, sptag_add) {
+    assert(!xb.empty());
+
+    ASSERT_ANY_THROW(index_->AddWithoutIds(base_dataset, conf));
+
+    int64_t half = nb / 2;
+    index_->Train(milvus::knowhere::GenDatasetWithIds(half, dim, xb.data(), ids.data()), conf);
+    ASSERT_EQ(index_->Count(), half);
+    index_->AddWithoutIds(milvus::knowhere::GenDataset(nb - half, dim, xb.data() + half * dim), conf);
+    ASSERT_EQ(index_->Count(), nb);
+
+    auto result = index_->Query(query_dataset, conf);
+    AssertAnns(result, nq, k);
+
+    // the added vectors are labeled by offset
+    auto tail_query = milvus::knowhere::GenDataset(1, dim, xb.data() + (nb - 1) * dim);
+    auto tail_result = index_->Query(tail_query, conf);
+    ASSERT_EQ(tail_result->Get<int64_t*>(milvus::knowhere::meta::IDS)[0], nb - 1);
+}
+
+// QPS and recall@10 of SPTAG against HNSW, run where siftsmall_base.fvecs is
+TEST_P(SPTAGTest, sptag_siftsmall_benchmark) {
+    const char* file_name = "siftsmall_base.fvecs";
+    if (!std::ifstream(file_name).good()) {
+        std::cout << file_name << " not found, skip the benchmark" << std::endl;
+        return;
+    }
+
+    int64_t sift_dim = 0, sift_nb = 0;
+    auto sift_xb = ReadFvecs(file_name, sift_dim, sift_nb);
+    std::vector<int64_t> sift_ids(sift_nb);
+    std::iota(sift_ids.begin(), sift_ids.end(), 0);
+
+    int64_t topk = 10;
+    int64_t sift_nq = 100;
+    std::vector<float> sift_xq(sift_nq * sift_dim);
+    for (int64_t i = 0; i < sift_nq; ++i) {
+        auto row = i * (sift_nb / sift_nq);
+        std::copy_n(sift_xb.data() + row * sift_dim, sift_dim, sift_xq.data() + i * sift_dim);
+    }
+
+    // brute force ground truth
+    std::vector<std::vector<int64_t>> truth(sift_nq);
+    for (int64_t i = 0; i < sift_nq; ++i) {
+        std::vector<std::pair<float, int64_t>> dists(sift_nb);
+        for (int64_t j = 0; j < sift_nb; ++j) {
+            float dist = 0;
+            for (int64_t d = 0; d < sift_dim; ++d) {
+                float diff = sift_xq[i * sift_dim + d] - sift_xb[j * sift_dim + d];
+                dist += diff * diff;
+            }
+            dists[j] = {dist, j};
+        }
+        std::partial_sort(dists.begin(), dists.begin() + topk, dists.end());
+        for (int64_t j = 0; j < topk; ++j) {
+            truth[i].push_back(dists[j].second);
+        }
+    }
+
+    auto base = milvus::knowhere::GenDatasetWithIds(sift_nb, sift_dim, sift_xb.data(), sift_ids.data());
+    auto query = milvus::knowhere::GenDataset(sift_nq, sift_dim, sift_xq.data());
+    auto run = [&](const milvus::knowhere::VecIndexPtr& index, const milvus::knowhere::Config& config,
+                   const std::string& name) {
+        auto start = std::chrono::steady_clock::now();
+        index->BuildAll(base, config);
+        auto built = std::chrono::steady_clock::now();
+        auto result = index->Query(query, config);
+        auto searched = std::chrono::steady_clock::now();
+
+        auto result_ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+        int64_t hit = 0;
+        for (int64_t i = 0; i < sift_nq; ++i) {
+            for (int64_t j = 0; j < topk; ++j) {
+                hit += std::count(truth[i].begin(), truth[i].end(), result_ids[i * topk + j]);
+            }
+        }
+        double recall = 1.0 * hit / (sift_nq * topk);
+        double search_sec = std::chrono::duration<double>(searched - built).count();
+        std::cout << name << ": build " << std::chrono::duration<double>(built - start).count() << "s, qps "
+                  << sift_nq / search_sec << ", recall@" << topk << " " << recall << std::endl;
+        return recall;
+    };
+
+    milvus::knowhere::Config sptag_conf{
+        {milvus::knowhere::meta::DIM, sift_dim},
+        {milvus::knowhere::meta::TOPK, topk},
+        {milvus::knowhere::Metric::TYPE, milvus::knowhere::Metric::L2},
+    };
+    auto sptag_recall = run(index_, sptag_conf, IndexType);
+
+    milvus::knowhere::Config hnsw_conf{
+        {milvus::knowhere::meta::DIM, sift_dim},
+        {milvus::knowhere::meta::TOPK, topk},
+        {milvus::knowhere::IndexParams::M, 16},
+        {milvus::knowhere::IndexParams::efConstruction, 200},
+        {milvus::knowhere::IndexParams::ef, 64},
+        {milvus::knowhere::Metric::TYPE, milvus::knowhere::Metric::L2},
+    };
+    run(std::make_shared<milvus::knowhere::IndexHNSW>(), hnsw_conf, "HNSW");
+
+    ASSERT_GT(sptag_recall, 0.9);
+}
@@ -16,6 +16,7 @@
 #include <math.h>
 #include <memory>
 #include <string>
+#include <unordered_set>
 #include <utility>
 
 INITIALIZE_EASYLOGGINGPP
@@ -230,6 +231,21 @@ PrintResult(const milvus::knowhere::DatasetPtr& result, const int& nq, const int
     std::cout << "dist\n" << ss_dist.str() << std::endl;
 }
 
+double
+CalcRecall(const milvus::knowhere::DatasetPtr& result, const milvus::knowhere::DatasetPtr& ground_truth, const int nq,
+           const int k) {
+    auto ids = result->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    auto gt_ids = ground_truth->Get<int64_t*>(milvus::knowhere::meta::IDS);
+    int64_t hit = 0;
+    for (auto i = 0; i < nq; i++) {
+        std::unordered_set<int64_t> gt_set(gt_ids + i * k, gt_ids + (i + 1) * k);
+        for (auto j = 0; j < k; ++j) {
+            hit += gt_set.count(ids[i * k + j]);
+        }
+    }
+    return (double)hit / (nq * k);
+}
+
 // not used
 #if 0
 void
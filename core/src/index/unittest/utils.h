@@ -83,6 +83,11 @@ AssertBinVec(const milvus::knowhere::DatasetPtr& result, const milvus::knowhere:
 void
 PrintResult(const milvus::knowhere::DatasetPtr& result, const int& nq, const int& k);
 
+// fraction of the topk ids of result that are in the topk ids of ground_truth
+double
+CalcRecall(const milvus::knowhere::DatasetPtr& result, const milvus::knowhere::DatasetPtr& ground_truth, const int nq,
+           const int k);
+
 struct FileIOWriter {
     std::fstream fs;
     std::string name;
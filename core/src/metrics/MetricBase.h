@@ -55,6 +55,10 @@ class MetricsBase {
     BuildIndexDurationSecondsHistogramObserve(double value) {
     }
 
+    virtual void
+    TimeToIndexedSecondsHistogramObserve(double value) {
+    }
+
     virtual void
     CpuCacheUsageGaugeSet(double value) {
     }
@@ -83,6 +87,14 @@ class MetricsBase {
     CacheAccessTotalIncrement(double value = 1) {
     }
 
+    virtual void
+    SearchResultCacheHitTotalIncrement(double value = 1) {
+    }
+
+    virtual void
+    SearchResultCacheMissTotalIncrement(double value = 1) {
+    }
+
     virtual void
     MemTableMergeDurationSecondsHistogramObserve(double value) {
     }
@@ -127,6 +139,10 @@ class MetricsBase {
     DataFileSizeGaugeSet(double value) {
     }
 
+    virtual void
+    CollectionDeletedRatioGaugeSet(const std::string& collection_id, double value) {
+    }
+
     virtual void
     AddVectorsSuccessGaugeSet(double value) {
     }
@@ -94,6 +94,13 @@ class PrometheusMetrics : public MetricsBase {
         }
     }
 
+    void
+    TimeToIndexedSecondsHistogramObserve(double value) override {
+        if (startup_) {
+            time_to_indexed_seconds_histogram_.Observe(value);
+        }
+    }
+
     void
     CpuCacheUsageGaugeSet(double value) override {
         if (startup_) {
@@ -146,6 +153,20 @@ class PrometheusMetrics : public MetricsBase {
         }
     }
 
+    void
+    SearchResultCacheHitTotalIncrement(double value = 1) override {
+        if (startup_) {
+            search_result_cache_hit_total_.Increment(value);
+        }
+    }
+
+    void
+    SearchResultCacheMissTotalIncrement(double value = 1) override {
+        if (startup_) {
+            search_result_cache_miss_total_.Increment(value);
+        }
+    }
+
     void
     MemTableMergeDurationSecondsHistogramObserve(double value) override {
         if (startup_) {
@@ -216,6 +237,13 @@ class PrometheusMetrics : public MetricsBase {
         }
     }
 
+    void
+    CollectionDeletedRatioGaugeSet(const std::string& collection_id, double value) override {
+        if (startup_) {
+            collection_deleted_ratio_.Add({{"collection", collection_id}}).Set(value);
+        }
+    }
+
     void
     AddVectorsSuccessGaugeSet(double value) override {
         if (startup_) {
@@ -431,6 +459,15 @@ class PrometheusMetrics : public MetricsBase {
     prometheus::Histogram& build_index_duration_seconds_histogram_ =
         build_index_duration_seconds_.Add({}, BucketBoundaries{5e5, 2e6, 4e6, 6e6, 8e6, 1e7});
 
+    // record time from a segment becoming TO_INDEX to its index being built
+    prometheus::Family<prometheus::Histogram>& time_to_indexed_seconds_ =
+        prometheus::BuildHistogram()
+            .Name("time_to_indexed_seconds")
+            .Help("histogram of time from a segment waiting for index to its index built")
+            .Register(*registry_);
+    prometheus::Histogram& time_to_indexed_seconds_histogram_ =
+        time_to_indexed_seconds_.Add({}, BucketBoundaries{1, 10, 60, 300, 1800, 3600});
+
     // record processing time for all building index
     prometheus::Family<prometheus::Histogram>& all_build_index_duration_seconds_ =
         prometheus::BuildHistogram()
@@ -543,6 +580,15 @@ class PrometheusMetrics : public MetricsBase {
                                                                  .Register(*registry_);
     prometheus::Counter& cache_access_total_ = cache_access_.Add({});
 
+    // record search result cache hits and misses, the hit rate is hit / (hit + miss)
+    prometheus::Family<prometheus::Counter>& search_result_cache_access_ =
+        prometheus::BuildCounter()
+            .Name("search_result_cache_access_total")
+            .Help("the count of searches looked up in the search result cache")
+            .Register(*registry_);
+    prometheus::Counter& search_result_cache_hit_total_ = search_result_cache_access_.Add({{"result", "hit"}});
+    prometheus::Counter& search_result_cache_miss_total_ = search_result_cache_access_.Add({{"result", "miss"}});
+
     // record CPU cache usage and %
     prometheus::Family<prometheus::Gauge>& cpu_cache_usage_ =
         prometheus::BuildGauge().Name("cache_usage_bytes").Help("current cache usage by bytes").Register(*registry_);
@@ -593,6 +639,11 @@ class PrometheusMetrics : public MetricsBase {
         prometheus::BuildGauge().Name("data_file_size_bytes").Help("data file size by bytes").Register(*registry_);
     prometheus::Gauge& data_file_size_gauge_ = data_file_size_.Add({});
 
+    prometheus::Family<prometheus::Gauge>& collection_deleted_ratio_ = prometheus::BuildGauge()
+                                                                           .Name("collection_deleted_ratio")
+                                                                           .Help("ratio of deleted rows in collection")
+                                                                           .Register(*registry_);
+
     prometheus::Family<prometheus::Gauge>& add_vectors_ =
         prometheus::BuildGauge().Name("add_vectors").Help("current added vectors").Register(*registry_);
     prometheus::Gauge& add_vectors_success_gauge_ = add_vectors_.Add({{"outcome", "success"}});
@@ -45,12 +45,33 @@ BuildIndexJob::WaitBuildIndexFinish() {
     LOG_SERVER_DEBUG_ << "BuildIndexJob " << id() << " all done";
 }
 
+bool
+BuildIndexJob::IsBuildIndexFinished() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return to_index_files_.empty();
+}
+
 void
-BuildIndexJob::BuildIndexDone(size_t to_index_id) {
+BuildIndexJob::SetFinishCallback(std::function<void()> callback) {
     std::unique_lock<std::mutex> lock(mutex_);
-    to_index_files_.erase(to_index_id);
-    cv_.notify_all();
-    LOG_SERVER_DEBUG_ << "BuildIndexJob " << id() << " finish index file: " << to_index_id;
+    finish_callback_ = std::move(callback);
+}
+
+void
+BuildIndexJob::BuildIndexDone(size_t to_index_id) {
+    std::function<void()> callback;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        to_index_files_.erase(to_index_id);
+        cv_.notify_all();
+        LOG_SERVER_DEBUG_ << "BuildIndexJob " << id() << " finish index file: " << to_index_id;
+        if (to_index_files_.empty()) {
+            callback = finish_callback_;
+        }
+    }
+    if (callback) {
+        callback();
+    }
 }
 
 json
@@ -12,6 +12,7 @@
 
 #include <condition_variable>
 #include <deque>
+#include <functional>
 #include <list>
 #include <memory>
 #include <mutex>
@@ -47,6 +48,14 @@ class BuildIndexJob : public Job, public server::CacheConfigHandler {
     void
     WaitBuildIndexFinish();
 
+    // true when every file of the job is built or failed
+    bool
+    IsBuildIndexFinished();
+
+    // called on a scheduler thread when the last file is done, must not block
+    void
+    SetFinishCallback(std::function<void()> callback);
+
     void
     BuildIndexDone(size_t to_index_id);
 
@@ -86,6 +95,7 @@ class BuildIndexJob : public Job, public server::CacheConfigHandler {
     Status status_;
     std::mutex mutex_;
     std::condition_variable cv_;
+    std::function<void()> finish_callback_;
 };
 
 using BuildIndexJobPtr = std::shared_ptr<BuildIndexJob>;
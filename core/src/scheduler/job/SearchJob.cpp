@@ -11,6 +11,7 @@
 
 #include "scheduler/job/SearchJob.h"
 
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
 #include "utils/Log.h"
 
 namespace milvus {
@@ -77,6 +78,16 @@ SearchJob::GetResultDistances() {
     return result_distances_;
 }
 
+ResultLims&
+SearchJob::GetResultLims() {
+    return result_lims_;
+}
+
+bool
+SearchJob::range_search() const {
+    return extra_params_.contains(knowhere::IndexParams::radius);
+}
+
 Status&
 SearchJob::GetStatus() {
     return status_;
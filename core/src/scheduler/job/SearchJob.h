@@ -39,6 +39,7 @@ using Id2IndexMap = std::unordered_map<size_t, SegmentSchemaPtr>;
 
 using ResultIds = engine::ResultIds;
 using ResultDistances = engine::ResultDistances;
+using ResultLims = engine::ResultLims;
 
 struct SearchTimeStat {
     double query_time = 0.0;
@@ -71,6 +72,9 @@ class SearchJob : public Job {
     ResultDistances&
     GetResultDistances();
 
+    ResultLims&
+    GetResultLims();
+
     void
     SetVectors(engine::VectorsData& vectors) {
         vectors_ = vectors;
@@ -101,6 +105,10 @@ class SearchJob : public Job {
         return extra_params_;
     }
 
+    // a radius in the search params asks for every entity within it instead of the topk nearest
+    bool
+    range_search() const;
+
     const engine::VectorsData&
     vectors() const {
         return vectors_;
@@ -153,6 +161,7 @@ class SearchJob : public Job {
     // TODO: column-base better ?
     ResultIds result_ids_;
     ResultDistances result_distances_;
+    ResultLims result_lims_;
     Status status_;
 
     query::GeneralQueryPtr general_query_;
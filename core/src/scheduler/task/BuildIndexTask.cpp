@@ -61,7 +61,13 @@ XBuildIndexTask::Load(milvus::scheduler::LoadType type, uint8_t device_id) {
         auto options = build_index_job->options();
         try {
             if (type == LoadType::DISK2CPU) {
-                stat = to_index_engine_->Load(options.insert_cache_immediately_);
+                if (options.build_index_buffer_size_ > 0 &&
+                    to_index_engine_->CanBuildIndexOutOfCore((EngineType)file_->engine_type_)) {
+                    // raw data is streamed by the build
+                    out_of_core_ = true;
+                } else {
+                    stat = to_index_engine_->Load(options.insert_cache_immediately_);
+                }
                 type_str = "DISK2CPU";
             } else if (type == LoadType::CPU2GPU) {
                 stat = to_index_engine_->CopyToIndexFileToGpu(device_id);
@@ -158,7 +164,12 @@ XBuildIndexTask::Execute() {
         // step 2: build index
         try {
             LOG_ENGINE_DEBUG_ << "Begin build index for file:" + table_file.location_;
-            index = to_index_engine_->BuildIndex(table_file.location_, (EngineType)table_file.engine_type_);
+            if (out_of_core_) {
+                index = to_index_engine_->BuildIndexOutOfCore(table_file.location_, (EngineType)table_file.engine_type_,
+                                                              build_index_job->options().build_index_buffer_size_);
+            } else {
+                index = to_index_engine_->BuildIndex(table_file.location_, (EngineType)table_file.engine_type_);
+            }
             fiu_do_on("XBuildIndexTask.Execute.build_index_fail", index = nullptr);
             if (index == nullptr) {
                 std::string log_msg = "Failed to build index " + table_file.file_id_ + ", reason: source index is null";
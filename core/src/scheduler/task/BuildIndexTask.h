@@ -34,6 +34,7 @@ class XBuildIndexTask : public Task {
     size_t to_index_id_ = 0;
     int to_index_type_ = 0;
     ExecutionEnginePtr to_index_engine_ = nullptr;
+    bool out_of_core_ = false;
 };
 
 }  // namespace scheduler
@@ -155,7 +155,11 @@ XSearchTask::Load(LoadType type, uint8_t device_id) {
     try {
         fiu_do_on("XSearchTask.Load.throw_std_exception", throw std::exception());
         if (type == LoadType::DISK2CPU) {
-            stat = index_engine_->Load();
+            milvus::json search_params;
+            if (auto job = job_.lock()) {
+                search_params = std::static_pointer_cast<scheduler::SearchJob>(job)->extra_params();
+            }
+            stat = index_engine_->Load(true, search_params);
             stat = index_engine_->LoadAttr();
             type_str = "DISK2CPU";
         } else if (type == LoadType::CPU2GPU) {
@@ -221,6 +225,7 @@ XSearchTask::Execute() {
 
     server::CollectDurationMetrics metrics(index_type_);
 
+    std::vector<int64_t> output_lims;
     std::vector<int64_t> output_ids;
     std::vector<float> output_distance;
     double span;
@@ -264,6 +269,8 @@ XSearchTask::Execute() {
                 topk = vector_query->topk;
                 nq = vector_query->query_vector.float_data.size() / file_->dimension_;
                 search_job->vector_count() = nq;
+            } else if (search_job->range_search()) {
+                s = index_engine_->RangeSearch(output_lims, output_ids, output_distance, search_job, hybrid);
             } else {
                 s = index_engine_->Search(output_ids, output_distance, search_job, hybrid);
             }
@@ -278,14 +285,21 @@ XSearchTask::Execute() {
             span = rc.RecordSection("search done");
 
             /* step 3: pick up topk result */
-            auto spec_k = file_->row_count_ < topk ? file_->row_count_ : topk;
-            if (spec_k == 0) {
-                LOG_ENGINE_WARNING_ << LogOut("[%s][%ld] Searching in an empty file. file location = %s", "search", 0,
-                                              file_->location_.c_str());
-            } else {
+            if (search_job->range_search()) {
                 std::unique_lock<std::mutex> lock(search_job->mutex());
-                XSearchTask::MergeTopkToResultSet(output_ids, output_distance, spec_k, nq, topk, ascending_reduce,
-                                                  search_job->GetResultIds(), search_job->GetResultDistances());
+                XSearchTask::MergeRangeToResultSet(output_lims, output_ids, output_distance, nq, ascending_reduce,
+                                                   search_job->GetResultLims(), search_job->GetResultIds(),
+                                                   search_job->GetResultDistances());
+            } else {
+                auto spec_k = file_->row_count_ < topk ? file_->row_count_ : topk;
+                if (spec_k == 0) {
+                    LOG_ENGINE_WARNING_ << LogOut("[%s][%ld] Searching in an empty file. file location = %s", "search",
+                                                  0, file_->location_.c_str());
+                } else {
+                    std::unique_lock<std::mutex> lock(search_job->mutex());
+                    XSearchTask::MergeTopkToResultSet(output_ids, output_distance, spec_k, nq, topk, ascending_reduce,
+                                                      search_job->GetResultIds(), search_job->GetResultDistances());
+                }
             }
 
             span = rc.RecordSection("reduce topk done");
@@ -373,6 +387,51 @@ XSearchTask::MergeTopkToResultSet(const scheduler::ResultIds& src_ids, const sch
     tar_distances.swap(buf_distances);
 }
 
+void
+XSearchTask::MergeRangeToResultSet(const scheduler::ResultLims& src_lims, const scheduler::ResultIds& src_ids,
+                                   const scheduler::ResultDistances& src_distances, size_t nq, bool ascending,
+                                   scheduler::ResultLims& tar_lims, scheduler::ResultIds& tar_ids,
+                                   scheduler::ResultDistances& tar_distances) {
+    if (src_lims.empty()) {
+        LOG_ENGINE_DEBUG_ << LogOut("[%s][%d] Search result is empty.", "search", 0);
+        return;
+    }
+    if (tar_lims.empty()) {
+        tar_lims = src_lims;
+        tar_ids = src_ids;
+        tar_distances = src_distances;
+        return;
+    }
+
+    scheduler::ResultLims buf_lims(nq + 1, 0);
+    scheduler::ResultIds buf_ids(src_ids.size() + tar_ids.size());
+    scheduler::ResultDistances buf_distances(buf_ids.size());
+
+    auto closer = [ascending](float a, float b) { return ascending ? a < b : a > b; };
+
+    size_t buf_idx = 0;
+    for (size_t i = 0; i < nq; i++) {
+        size_t src_idx = src_lims[i], tar_idx = tar_lims[i];
+        while (src_idx < src_lims[i + 1] || tar_idx < tar_lims[i + 1]) {
+            if (tar_idx == tar_lims[i + 1] ||
+                (src_idx < src_lims[i + 1] && closer(src_distances[src_idx], tar_distances[tar_idx]))) {
+                buf_ids[buf_idx] = src_ids[src_idx];
+                buf_distances[buf_idx] = src_distances[src_idx];
+                src_idx++;
+            } else {
+                buf_ids[buf_idx] = tar_ids[tar_idx];
+                buf_distances[buf_idx] = tar_distances[tar_idx];
+                tar_idx++;
+            }
+            buf_idx++;
+        }
+        buf_lims[i + 1] = buf_idx;
+    }
+    tar_lims.swap(buf_lims);
+    tar_ids.swap(buf_ids);
+    tar_distances.swap(buf_distances);
+}
+
 const std::string&
 XSearchTask::GetLocation() const {
     return file_->location_;
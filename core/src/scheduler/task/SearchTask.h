@@ -39,6 +39,13 @@ class XSearchTask : public Task {
                          size_t src_k, size_t nq, size_t topk, bool ascending, scheduler::ResultIds& tar_ids,
                          scheduler::ResultDistances& tar_distances);
 
+    // merges per-query variable length results, tar_lims is empty before the first merge
+    static void
+    MergeRangeToResultSet(const scheduler::ResultLims& src_lims, const scheduler::ResultIds& src_ids,
+                          const scheduler::ResultDistances& src_distances, size_t nq, bool ascending,
+                          scheduler::ResultLims& tar_lims, scheduler::ResultIds& tar_ids,
+                          scheduler::ResultDistances& tar_distances);
+
     //    static void
     //    MergeTopkArray(std::vector<int64_t>& tar_ids, std::vector<float>& tar_distance, uint64_t& tar_input_k,
     //                   const std::vector<int64_t>& src_ids, const std::vector<float>& src_distance, uint64_t
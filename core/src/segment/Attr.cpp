@@ -30,22 +30,20 @@
 namespace milvus {
 namespace segment {
 
-Attr::Attr(const std::vector<uint8_t>& data, size_t nbytes, const std::vector<int64_t> uids, const std::string& name)
+Attr::Attr(std::vector<uint8_t> data, size_t nbytes, std::vector<int64_t> uids, const std::string& name)
     : data_(std::move(data)), nbytes_(nbytes), uids_(std::move(uids)), name_(name) {
 }
 
-// void
-// Attr::AddAttr(const std::vector<uint8_t>& data, size_t nbytes) {
-//    data_.reserve(data_.size() + data.size());
-//    data_.insert(data_.end(), std::make_move_iterator(data.begin()), std::make_move_iterator(data.end()));
-//    nbytes_ += nbytes;
-//}
-//
-// void
-// Attr::AddUids(const std::vector<int64_t>& uids) {
-//    uids_.reserve(uids_.size() + uids.size());
-//    uids_.insert(uids_.end(), std::make_move_iterator(uids.begin()), std::make_move_iterator(uids.end()));
-//}
+void
+Attr::AddAttr(const uint8_t* data, size_t nbytes) {
+    data_.insert(data_.end(), data, data + nbytes);
+    nbytes_ += nbytes;
+}
+
+void
+Attr::AddUids(const std::vector<int64_t>& uids) {
+    uids_.insert(uids_.end(), uids.begin(), uids.end());
+}
 
 // void
 // Attr::SetName(const std::string& name) {
@@ -26,16 +26,16 @@ namespace segment {
 
 class Attr {
  public:
-    Attr(const std::vector<uint8_t>& data, size_t nbytes, const std::vector<int64_t> uids, const std::string& name);
+    Attr(std::vector<uint8_t> data, size_t nbytes, std::vector<int64_t> uids, const std::string& name);
 
     Attr();
 
-    //    void
-    //    AddAttr(const std::vector<uint8_t>& data, size_t nbytes);
-    //
-    //    void
-    //    AddUids(const std::vector<int64_t>& uids);
-    //
+    void
+    AddAttr(const uint8_t* data, size_t nbytes);
+
+    void
+    AddUids(const std::vector<int64_t>& uids);
+
     //    void
     //    SetName(const std::string& name);
 
@@ -17,19 +17,42 @@
 
 #include "segment/DeletedDocs.h"
 
+#include <algorithm>
+#include <utility>
+
 namespace milvus {
 namespace segment {
 
 DeletedDocs::DeletedDocs(const std::vector<offset_t>& deleted_doc_offsets) : deleted_doc_offsets_(deleted_doc_offsets) {
 }
 
+DeletedDocs::DeletedDocs(std::vector<uint8_t>&& bitmap, size_t size) : bitmap_(std::move(bitmap)), bitmap_size_(size) {
+}
+
 void
 DeletedDocs::AddDeletedDoc(offset_t offset) {
+    if (!bitmap_.empty()) {
+        // fall back to the offset list once modified
+        GetDeletedDocs();
+        bitmap_.clear();
+        bitmap_size_ = 0;
+    }
     deleted_doc_offsets_.emplace_back(offset);
 }
 
 const std::vector<offset_t>&
 DeletedDocs::GetDeletedDocs() const {
+    std::call_once(decode_flag_, [this]() {
+        if (bitmap_.empty()) {
+            return;
+        }
+        deleted_doc_offsets_.reserve(bitmap_size_);
+        for (size_t i = 0; i < bitmap_.size(); ++i) {
+            for (uint32_t byte = bitmap_[i]; byte != 0; byte &= byte - 1) {
+                deleted_doc_offsets_.push_back((i << 3) + __builtin_ctz(byte));
+            }
+        }
+    });
     return deleted_doc_offsets_;
 }
 
@@ -40,7 +63,27 @@ DeletedDocs::GetDeletedDocs() const {
 
 size_t
 DeletedDocs::GetSize() const {
-    return deleted_doc_offsets_.size();
+    return bitmap_.empty() ? deleted_doc_offsets_.size() : bitmap_size_;
+}
+
+void
+DeletedDocs::GetBitset(const faiss::ConcurrentBitsetPtr& bitset) const {
+    auto& words = bitset->bitset();
+    if (!bitmap_.empty()) {
+        auto bytes = std::min(bitmap_.size(), words.size());
+        for (size_t i = 0; i < bytes; ++i) {
+            if (bitmap_[i] != 0) {
+                words[i].fetch_or(bitmap_[i]);
+            }
+        }
+        return;
+    }
+
+    for (auto offset : deleted_doc_offsets_) {
+        if (offset >= 0 && static_cast<size_t>(offset) < bitset->capacity()) {
+            bitset->set(offset);
+        }
+    }
 }
 
 }  // namespace segment
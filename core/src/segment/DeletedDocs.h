@@ -18,8 +18,11 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <vector>
 
+#include <faiss/utils/ConcurrentBitset.h>
+
 namespace milvus {
 namespace segment {
 
@@ -29,11 +32,16 @@ class DeletedDocs {
  public:
     explicit DeletedDocs(const std::vector<offset_t>& deleted_doc_offsets);
 
+    // Deleted docs loaded as a bitmap, bit (offset & 7) of byte (offset >> 3) is set for every deleted offset,
+    // size is the number of bits set.
+    DeletedDocs(std::vector<uint8_t>&& bitmap, size_t size);
+
     DeletedDocs() = default;
 
     void
     AddDeletedDoc(offset_t offset);
 
+    // When loaded as a bitmap, the offsets are decoded on the first call, in ascending order.
     const std::vector<offset_t>&
     GetDeletedDocs() const;
 
@@ -44,8 +52,9 @@ class DeletedDocs {
     size_t
     GetSize() const;
 
-    //    void
-    //    GetBitset(faiss::ConcurrentBitsetPtr& bitset);
+    // Sets the bit of every deleted doc in bitset, a loaded bitmap is merged byte by byte.
+    void
+    GetBitset(const faiss::ConcurrentBitsetPtr& bitset) const;
 
     // No copy and move
     DeletedDocs(const DeletedDocs&) = delete;
@@ -57,8 +66,10 @@ class DeletedDocs {
     operator=(DeletedDocs&&) = delete;
 
  private:
-    std::vector<offset_t> deleted_doc_offsets_;
-    //    faiss::ConcurrentBitsetPtr bitset_;
+    mutable std::vector<offset_t> deleted_doc_offsets_;
+    std::vector<uint8_t> bitmap_;
+    size_t bitmap_size_ = 0;
+    mutable std::once_flag decode_flag_;
     //    const std::string name_ = "deleted_docs";
 };
 
@@ -19,11 +19,55 @@
 #include "utils/Log.h"
 #include "utils/Status.h"
 
+#include <algorithm>
+#include <cstring>
 #include <string>
 
 namespace milvus {
 namespace segment {
 
+namespace {
+
+constexpr size_t CACHE_LINE_WORDS = 64 / sizeof(uint64_t);
+
+// odd multipliers picking one bit of every word in a block
+constexpr uint32_t BLOCK_SALT[IdBloomFilter::BLOCK_WORDS] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+                                                           0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+inline uint64_t
+Hash(doc_id_t uid) {
+    // splitmix64 finalizer, consecutive ids spread over all blocks
+    uint64_t x = static_cast<uint64_t>(uid) + 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+inline uint64_t
+BitInWord(uint64_t hash, size_t word) {
+    return 1ULL << ((static_cast<uint32_t>(hash) * BLOCK_SALT[word]) >> 26);
+}
+
+inline bool
+BlockCheck(const uint64_t* block, uint64_t hash) {
+    bool hit = true;
+    for (size_t i = 0; i < IdBloomFilter::BLOCK_WORDS; ++i) {
+        hit &= (block[i] & BitInWord(hash, i)) != 0;
+    }
+    return hit;
+}
+
+}  // namespace
+
+IdBloomFilter::IdBloomFilter(size_t capacity) {
+    Allocate(std::max<uint64_t>((capacity * BITS_PER_ID + BLOCK_WORDS * 64 - 1) / (BLOCK_WORDS * 64), 1));
+}
+
+IdBloomFilter::IdBloomFilter(const uint64_t* blocks, uint64_t num_blocks) {
+    Allocate(num_blocks);
+    memcpy(blocks_, blocks, num_blocks * BLOCK_WORDS * sizeof(uint64_t));
+}
+
 IdBloomFilter::IdBloomFilter(scaling_bloom_t* bloom_filter) : bloom_filter_(bloom_filter) {
 }
 
@@ -34,21 +78,88 @@ IdBloomFilter::~IdBloomFilter() {
     }
 }
 
+void
+IdBloomFilter::Allocate(uint64_t num_blocks) {
+    num_blocks_ = num_blocks;
+    storage_.assign(num_blocks * BLOCK_WORDS + CACHE_LINE_WORDS - 1, 0);
+    auto addr = reinterpret_cast<uintptr_t>(storage_.data());
+    auto aligned = (addr + CACHE_LINE_WORDS * sizeof(uint64_t) - 1) & ~(CACHE_LINE_WORDS * sizeof(uint64_t) - 1);
+    blocks_ = reinterpret_cast<uint64_t*>(aligned);
+}
+
+uint64_t*
+IdBloomFilter::Block(uint64_t hash) const {
+    // the high half picks the block, the low half the bits in it
+    return blocks_ + (((hash >> 32) * num_blocks_) >> 32) * BLOCK_WORDS;
+}
+
 scaling_bloom_t*
 IdBloomFilter::GetBloomFilter() {
     const std::lock_guard<std::mutex> lock(mutex_);
     return bloom_filter_;
 }
 
+const uint64_t*
+IdBloomFilter::GetBlocks() const {
+    return blocks_;
+}
+
+uint64_t
+IdBloomFilter::GetBlockCount() const {
+    return num_blocks_;
+}
+
 bool
 IdBloomFilter::Check(doc_id_t uid) {
+    if (bloom_filter_ == nullptr) {
+        auto hash = Hash(uid);
+        return BlockCheck(Block(hash), hash);
+    }
+
     std::string s = std::to_string(uid);
     const std::lock_guard<std::mutex> lock(mutex_);
     return scaling_bloom_check(bloom_filter_, s.c_str(), s.size());
 }
 
+void
+IdBloomFilter::Check(const std::vector<doc_id_t>& uids, std::vector<doc_id_t>& maybe_present) {
+    if (bloom_filter_ != nullptr) {
+        for (auto uid : uids) {
+            if (Check(uid)) {
+                maybe_present.push_back(uid);
+            }
+        }
+        return;
+    }
+
+    // hash a window ahead and prefetch its blocks, so the cache misses of a batch overlap
+    constexpr size_t PREFETCH_DISTANCE = 16;
+    size_t n = uids.size();
+    for (size_t i = 0; i < std::min(n, PREFETCH_DISTANCE); ++i) {
+        __builtin_prefetch(Block(Hash(uids[i])));
+    }
+    for (size_t i = 0; i < n; ++i) {
+        if (i + PREFETCH_DISTANCE < n) {
+            __builtin_prefetch(Block(Hash(uids[i + PREFETCH_DISTANCE])));
+        }
+        auto hash = Hash(uids[i]);
+        if (BlockCheck(Block(hash), hash)) {
+            maybe_present.push_back(uids[i]);
+        }
+    }
+}
+
 Status
 IdBloomFilter::Add(doc_id_t uid) {
+    if (bloom_filter_ == nullptr) {
+        auto hash = Hash(uid);
+        auto block = Block(hash);
+        for (size_t i = 0; i < BLOCK_WORDS; ++i) {
+            block[i] |= BitInWord(hash, i);
+        }
+        return Status::OK();
+    }
+
     std::string s = std::to_string(uid);
     const std::lock_guard<std::mutex> lock(mutex_);
     if (scaling_bloom_add(bloom_filter_, s.c_str(), s.size(), uid) == -1) {
@@ -61,6 +172,10 @@ IdBloomFilter::Add(doc_id_t uid) {
 
 Status
 IdBloomFilter::Remove(doc_id_t uid) {
+    if (bloom_filter_ == nullptr) {
+        return Status::OK();
+    }
+
     std::string s = std::to_string(uid);
     const std::lock_guard<std::mutex> lock(mutex_);
     if (scaling_bloom_remove(bloom_filter_, s.c_str(), s.size(), uid) == -1) {
@@ -76,8 +191,11 @@ IdBloomFilter::Remove(doc_id_t uid) {
 //    return name_;
 //}
 
-size_t
+int64_t
 IdBloomFilter::Size() {
+    if (bloom_filter_ == nullptr) {
+        return num_blocks_ * BLOCK_WORDS * sizeof(uint64_t);
+    }
     return bloom_filter_->num_bytes;
 }
 
@@ -19,7 +19,9 @@
 
 #include <memory>
 #include <mutex>
+#include <vector>
 
+#include "cache/DataObj.h"
 #include "dablooms/dablooms.h"
 #include "utils/Status.h"
 
@@ -28,26 +30,53 @@ namespace segment {
 
 using doc_id_t = int64_t;
 
-class IdBloomFilter {
+// Segment sized, cache line blocked bloom filter over the uids of a segment. Every uid sets one bit in each
+// 64-bit word of a single 512-bit block, so a probe touches one cache line. The filter is built once when the
+// segment is written and never changes afterwards, checks take no lock.
+// Segments written before keep a dablooms scaling bloom filter, which is still served through this class.
+class IdBloomFilter : public cache::DataObj {
  public:
+    static constexpr size_t BLOCK_WORDS = 8;
+    static constexpr size_t BITS_PER_ID = 16;
+
+    // empty blocked filter sized for capacity ids
+    explicit IdBloomFilter(size_t capacity);
+
+    // blocked filter loaded from num_blocks blocks of BLOCK_WORDS words
+    IdBloomFilter(const uint64_t* blocks, uint64_t num_blocks);
+
+    // legacy scaling bloom filter
     explicit IdBloomFilter(scaling_bloom_t* bloom_filter);
 
     ~IdBloomFilter();
 
+    // nullptr unless the filter is a legacy one
     scaling_bloom_t*
     GetBloomFilter();
 
+    // blocks of a blocked filter, nullptr for a legacy one
+    const uint64_t*
+    GetBlocks() const;
+
+    uint64_t
+    GetBlockCount() const;
+
     bool
     Check(doc_id_t uid);
 
+    // appends the uids which may be present to maybe_present, prefetching the blocks ahead
+    void
+    Check(const std::vector<doc_id_t>& uids, std::vector<doc_id_t>& maybe_present);
+
     Status
     Add(doc_id_t uid);
 
+    // only the legacy filter counts ids, a blocked filter keeps deleted uids and relies on deleted docs
     Status
     Remove(doc_id_t uid);
 
-    size_t
-    Size();
+    int64_t
+    Size() override;
 
     //    const std::string&
     //    GetName() const;
@@ -62,7 +91,19 @@ class IdBloomFilter {
     operator=(IdBloomFilter&&) = delete;
 
  private:
-    scaling_bloom_t* bloom_filter_;
+    void
+    Allocate(uint64_t num_blocks);
+
+    uint64_t*
+    Block(uint64_t hash) const;
+
+ private:
+    // blocks_ points into storage_ at the first cache line boundary
+    std::vector<uint64_t> storage_;
+    uint64_t* blocks_ = nullptr;
+    uint64_t num_blocks_ = 0;
+
+    scaling_bloom_t* bloom_filter_ = nullptr;
     //    const std::string name_ = "bloom_filter";
     std::mutex mutex_;
 };
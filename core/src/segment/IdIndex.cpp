@@ -0,0 +1,88 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "segment/IdIndex.h"
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+namespace milvus {
+namespace segment {
+
+IdIndex::IdIndex(const std::vector<doc_id_t>& uids) : uids_(uids.size()), offsets_(uids.size()) {
+    std::iota(offsets_.begin(), offsets_.end(), 0);
+    std::stable_sort(offsets_.begin(), offsets_.end(), [&](offset_t a, offset_t b) { return uids[a] < uids[b]; });
+    for (size_t i = 0; i < offsets_.size(); ++i) {
+        uids_[i] = uids[offsets_[i]];
+    }
+}
+
+IdIndex::IdIndex(std::vector<doc_id_t>&& uids, std::vector<offset_t>&& offsets)
+    : uids_(std::move(uids)), offsets_(std::move(offsets)) {
+}
+
+void
+IdIndex::Search(const std::vector<doc_id_t>& sorted_ids, std::vector<doc_id_t>& found_ids,
+                std::vector<offset_t>& offsets) const {
+    size_t pos = 0, n = uids_.size();
+    if (n == 0 || sorted_ids.empty() || sorted_ids.back() < uids_.front() || sorted_ids.front() > uids_.back()) {
+        return;
+    }
+    for (auto id : sorted_ids) {
+        if (pos >= n) {
+            break;
+        }
+        if (uids_[pos] < id) {
+            // gallop forward, the sparser the ids the larger the steps over the index
+            size_t step = 1;
+            while (pos + step < n && uids_[pos + step] < id) {
+                step <<= 1;
+            }
+            auto first = uids_.begin() + pos + (step >> 1);
+            auto last = uids_.begin() + std::min(pos + step + 1, n);
+            pos = std::lower_bound(first, last, id) - uids_.begin();
+        }
+        for (; pos < n && uids_[pos] == id; ++pos) {
+            found_ids.push_back(id);
+            offsets.push_back(offsets_[pos]);
+        }
+    }
+}
+
+size_t
+IdIndex::Count() const {
+    return uids_.size();
+}
+
+const std::vector<doc_id_t>&
+IdIndex::GetUids() const {
+    return uids_;
+}
+
+const std::vector<offset_t>&
+IdIndex::GetOffsets() const {
+    return offsets_;
+}
+
+int64_t
+IdIndex::Size() {
+    return uids_.size() * (sizeof(doc_id_t) + sizeof(offset_t));
+}
+
+}  // namespace segment
+}  // namespace milvus
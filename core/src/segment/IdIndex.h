@@ -18,13 +18,54 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
-#include "AttrIndex.h"
+#include "cache/DataObj.h"
+#include "segment/DeletedDocs.h"
+#include "segment/IdBloomFilter.h"
 
 namespace milvus {
 namespace segment {
 
-class IdIndex : public AttrIndex {};
+// Uids of a segment sorted by value, each one paired with its offset in the segment.
+class IdIndex : public cache::DataObj {
+ public:
+    explicit IdIndex(const std::vector<doc_id_t>& uids);
+
+    // uids sorted in ascending order, offsets[i] is the offset of uids[i] in the segment
+    IdIndex(std::vector<doc_id_t>&& uids, std::vector<offset_t>&& offsets);
+
+    // Sort-merge join of sorted_ids against the index. For every uid present in both, its value and
+    // offset are appended to found_ids and offsets, duplicated uids yield one entry per offset.
+    void
+    Search(const std::vector<doc_id_t>& sorted_ids, std::vector<doc_id_t>& found_ids,
+           std::vector<offset_t>& offsets) const;
+
+    size_t
+    Count() const;
+
+    const std::vector<doc_id_t>&
+    GetUids() const;
+
+    const std::vector<offset_t>&
+    GetOffsets() const;
+
+    int64_t
+    Size() override;
+
+    // No copy and move
+    IdIndex(const IdIndex&) = delete;
+    IdIndex(IdIndex&&) = delete;
+
+    IdIndex&
+    operator=(const IdIndex&) = delete;
+    IdIndex&
+    operator=(IdIndex&&) = delete;
+
+ private:
+    std::vector<doc_id_t> uids_;
+    std::vector<offset_t> offsets_;
+};
 
 using IdIndexPtr = std::shared_ptr<IdIndex>;
 
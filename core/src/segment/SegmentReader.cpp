@@ -20,7 +20,9 @@
 #include <memory>
 
 #include "Vectors.h"
+#include "cache/CpuCacheMgr.h"
 #include "codecs/default/DefaultCodec.h"
+#include "db/Utils.h"
 #include "knowhere/index/vector_index/VecIndex.h"
 #include "storage/disk/DiskIOReader.h"
 #include "storage/disk/DiskIOWriter.h"
@@ -142,9 +144,18 @@ SegmentReader::LoadVectorIndexWithRawData(const std::string& location, segment::
 Status
 SegmentReader::LoadBloomFilter(segment::IdBloomFilterPtr& id_bloom_filter_ptr) {
     try {
+        // the filter of a segment never changes once written, it is cached until the segment is deleted
+        auto cache_key = engine::utils::GetBloomFilterCacheKey(fs_ptr_->operation_ptr_->GetDirectory());
+        auto cache_mgr = cache::CpuCacheMgr::GetInstance();
+        id_bloom_filter_ptr = std::static_pointer_cast<segment::IdBloomFilter>(cache_mgr->GetIndex(cache_key));
+        if (id_bloom_filter_ptr != nullptr) {
+            return Status::OK();
+        }
+
         auto& default_codec = codec::DefaultCodec::instance();
         fs_ptr_->operation_ptr_->CreateDirectory();
         default_codec.GetIdBloomFilterFormat()->read(fs_ptr_, id_bloom_filter_ptr);
+        cache_mgr->InsertItem(cache_key, id_bloom_filter_ptr);
     } catch (std::exception& e) {
         std::string err_msg = "Failed to load bloom filter: " + std::string(e.what());
         LOG_ENGINE_ERROR_ << err_msg;
@@ -153,6 +164,58 @@ SegmentReader::LoadBloomFilter(segment::IdBloomFilterPtr& id_bloom_filter_ptr) {
     return Status::OK();
 }
 
+Status
+SegmentReader::LoadIdIndex(segment::IdIndexPtr& id_index_ptr) {
+    try {
+        // the uids of a segment never change, its index is cached until the segment is deleted
+        auto cache_key = engine::utils::GetIdIndexCacheKey(fs_ptr_->operation_ptr_->GetDirectory());
+        auto cache_mgr = cache::CpuCacheMgr::GetInstance();
+        id_index_ptr = std::static_pointer_cast<segment::IdIndex>(cache_mgr->GetIndex(cache_key));
+        if (id_index_ptr != nullptr) {
+            return Status::OK();
+        }
+
+        auto& default_codec = codec::DefaultCodec::instance();
+        fs_ptr_->operation_ptr_->CreateDirectory();
+        default_codec.GetIdIndexFormat()->read(fs_ptr_, id_index_ptr);
+        if (id_index_ptr == nullptr) {
+            std::vector<doc_id_t> uids;
+            default_codec.GetVectorsFormat()->read_uids(fs_ptr_, uids);
+            id_index_ptr = std::make_shared<segment::IdIndex>(uids);
+        }
+        cache_mgr->InsertItem(cache_key, id_index_ptr);
+    } catch (std::exception& e) {
+        std::string err_msg = "Failed to load id index: " + std::string(e.what());
+        LOG_ENGINE_ERROR_ << err_msg;
+        return Status(DB_ERROR, err_msg);
+    }
+    return Status::OK();
+}
+
+Status
+SegmentReader::LoadVectorSummary(segment::VectorSummaryPtr& vector_summary_ptr) {
+    try {
+        // the summary of a segment never changes once written, it is cached until the segment is deleted
+        auto cache_key = engine::utils::GetVectorSummaryCacheKey(fs_ptr_->operation_ptr_->GetDirectory());
+        auto cache_mgr = cache::CpuCacheMgr::GetInstance();
+        vector_summary_ptr = std::static_pointer_cast<segment::VectorSummary>(cache_mgr->GetIndex(cache_key));
+        if (vector_summary_ptr != nullptr) {
+            return Status::OK();
+        }
+
+        auto& default_codec = codec::DefaultCodec::instance();
+        default_codec.GetVectorSummaryFormat()->read(fs_ptr_, vector_summary_ptr);
+        if (vector_summary_ptr != nullptr) {
+            cache_mgr->InsertItem(cache_key, vector_summary_ptr);
+        }
+    } catch (std::exception& e) {
+        std::string err_msg = "Failed to load vector summary: " + std::string(e.what());
+        LOG_ENGINE_ERROR_ << err_msg;
+        return Status(DB_ERROR, err_msg);
+    }
+    return Status::OK();
+}
+
 Status
 SegmentReader::LoadDeletedDocs(segment::DeletedDocsPtr& deleted_docs_ptr) {
     try {
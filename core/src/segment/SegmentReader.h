@@ -21,7 +21,9 @@
 #include <string>
 #include <vector>
 
+#include "segment/IdIndex.h"
 #include "segment/Types.h"
+#include "segment/VectorSummary.h"
 #include "storage/FSHandler.h"
 #include "utils/Status.h"
 
@@ -57,6 +59,14 @@ class SegmentReader {
     Status
     LoadBloomFilter(segment::IdBloomFilterPtr& id_bloom_filter_ptr);
 
+    // the sorted uids of the segment, built from the uids for segments written without one
+    Status
+    LoadIdIndex(segment::IdIndexPtr& id_index_ptr);
+
+    // vector_summary_ptr is nullptr for segments of binary vectors and segments written without one
+    Status
+    LoadVectorSummary(segment::VectorSummaryPtr& vector_summary_ptr);
+
     Status
     LoadDeletedDocs(segment::DeletedDocsPtr& deleted_docs_ptr);
 
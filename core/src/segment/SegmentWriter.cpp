@@ -25,6 +25,8 @@
 #include "Vectors.h"
 #include "codecs/default/DefaultCodec.h"
 #include "db/Utils.h"
+#include "segment/IdIndex.h"
+#include "segment/VectorSummary.h"
 #include "storage/disk/DiskIOReader.h"
 #include "storage/disk/DiskIOWriter.h"
 #include "storage/disk/DiskOperation.h"
@@ -62,6 +64,16 @@ SegmentWriter::AddVectors(const std::string& name, const uint8_t* data, uint64_t
     return Status::OK();
 }
 
+Status
+SegmentWriter::AddVectors(const std::string& name, const uint8_t* const* rows, uint64_t count, uint64_t row_size,
+                          const std::vector<doc_id_t>& uids) {
+    segment_ptr_->vectors_ptr_->AddData(rows, count, row_size);
+    segment_ptr_->vectors_ptr_->AddUids(uids);
+    segment_ptr_->vectors_ptr_->SetName(name);
+
+    return Status::OK();
+}
+
 Status
 SegmentWriter::AddAttrs(const std::string& name, const std::unordered_map<std::string, uint64_t>& attr_nbytes,
                         const std::unordered_map<std::string, std::vector<uint8_t>>& attr_data,
@@ -87,6 +99,22 @@ SegmentWriter::AddAttrs(const std::string& name, const std::unordered_map<std::s
     return Status::OK();
 }
 
+Status
+SegmentWriter::AddAttr(const std::string& field_name, const uint8_t* data, uint64_t size,
+                       const std::vector<doc_id_t>& uids) {
+    auto& attrs = segment_ptr_->attrs_ptr_->attrs;
+    auto attr_it = attrs.find(field_name);
+    if (attr_it == attrs.end()) {
+        AttrPtr attr = std::make_shared<Attr>(std::vector<uint8_t>(data, data + size), size, uids, field_name);
+        attrs.insert(std::make_pair(field_name, attr));
+    } else {
+        attr_it->second->AddAttr(data, size);
+        attr_it->second->AddUids(uids);
+    }
+
+    return Status::OK();
+}
+
 Status
 SegmentWriter::SetAttrsIndex(const std::unordered_map<std::string, knowhere::IndexPtr>& attr_indexes,
                              const std::unordered_map<std::string, int64_t>& attr_sizes,
@@ -110,6 +138,11 @@ SegmentWriter::SetVectorIndex(const milvus::knowhere::VecIndexPtr& index) {
     return Status::OK();
 }
 
+void
+SegmentWriter::SummarizeVectors(int64_t dimension) {
+    summary_dimension_ = dimension;
+}
+
 Status
 SegmentWriter::Serialize() {
     TimeRecorder recorder("SegmentWriter::Serialize");
@@ -122,6 +155,24 @@ SegmentWriter::Serialize() {
 
     recorder.RecordSection("Writing bloom filter done");
 
+    status = WriteIdIndex();
+    if (!status.ok()) {
+        LOG_ENGINE_ERROR_ << status.message();
+        return status;
+    }
+
+    recorder.RecordSection("Writing id index done");
+
+    if (summary_dimension_ > 0) {
+        status = WriteVectorSummary();
+        if (!status.ok()) {
+            LOG_ENGINE_ERROR_ << status.message();
+            return status;
+        }
+
+        recorder.RecordSection("Writing vector summary done");
+    }
+
     status = WriteVectors();
     if (!status.ok()) {
         LOG_ENGINE_ERROR_ << "Write vectors fail: " << status.message();
@@ -225,11 +276,11 @@ SegmentWriter::WriteBloomFilter() {
 
         TimeRecorder recorder("SegmentWriter::WriteBloomFilter");
 
-        default_codec.GetIdBloomFilterFormat()->create(fs_ptr_, segment_ptr_->id_bloom_filter_ptr_);
+        auto& uids = segment_ptr_->vectors_ptr_->GetUids();
+        default_codec.GetIdBloomFilterFormat()->create(fs_ptr_, uids.size(), segment_ptr_->id_bloom_filter_ptr_);
 
         recorder.RecordSection("Initializing bloom filter");
 
-        auto& uids = segment_ptr_->vectors_ptr_->GetUids();
         for (auto& uid : uids) {
             segment_ptr_->id_bloom_filter_ptr_->Add(uid);
         }
@@ -249,6 +300,50 @@ SegmentWriter::WriteBloomFilter() {
     return Status::OK();
 }
 
+Status
+SegmentWriter::WriteIdIndex() {
+    try {
+        auto& default_codec = codec::DefaultCodec::instance();
+        fs_ptr_->operation_ptr_->CreateDirectory();
+        auto id_index_ptr = std::make_shared<IdIndex>(segment_ptr_->vectors_ptr_->GetUids());
+        default_codec.GetIdIndexFormat()->write(fs_ptr_, id_index_ptr);
+    } catch (std::exception& e) {
+        std::string err_msg = "Failed to write id index: " + std::string(e.what());
+        LOG_ENGINE_ERROR_ << err_msg;
+
+        engine::utils::SendExitSignal();
+        return Status(SERVER_WRITE_ERROR, err_msg);
+    }
+    return Status::OK();
+}
+
+Status
+SegmentWriter::WriteVectorSummary() {
+    try {
+        auto& vectors = segment_ptr_->vectors_ptr_;
+        if (vectors->GetCodeLength() != summary_dimension_ * sizeof(float)) {
+            return Status::OK();  // the vectors are not float vectors of that dimension
+        }
+
+        auto vector_summary_ptr = VectorSummary::Build(reinterpret_cast<const float*>(vectors->GetData().data()),
+                                                       vectors->GetCount(), summary_dimension_);
+        if (vector_summary_ptr == nullptr) {
+            return Status::OK();
+        }
+
+        auto& default_codec = codec::DefaultCodec::instance();
+        fs_ptr_->operation_ptr_->CreateDirectory();
+        default_codec.GetVectorSummaryFormat()->write(fs_ptr_, vector_summary_ptr);
+    } catch (std::exception& e) {
+        std::string err_msg = "Failed to write vector summary: " + std::string(e.what());
+        LOG_ENGINE_ERROR_ << err_msg;
+
+        engine::utils::SendExitSignal();
+        return Status(SERVER_WRITE_ERROR, err_msg);
+    }
+    return Status::OK();
+}
+
 Status
 SegmentWriter::WriteDeletedDocs() {
     try {
@@ -40,10 +40,17 @@ class SegmentWriter {
     Status
     AddVectors(const std::string& name, const uint8_t* data, uint64_t size, const std::vector<doc_id_t>& uids);
 
+    Status
+    AddVectors(const std::string& name, const uint8_t* const* rows, uint64_t count, uint64_t row_size,
+               const std::vector<doc_id_t>& uids);
+
     Status
     AddAttrs(const std::string& name, const std::unordered_map<std::string, uint64_t>& attr_nbytes,
              const std::unordered_map<std::string, std::vector<uint8_t>>& attr_data, const std::vector<doc_id_t>& uids);
 
+    Status
+    AddAttr(const std::string& field_name, const uint8_t* data, uint64_t size, const std::vector<doc_id_t>& uids);
+
     Status
     SetVectorIndex(const knowhere::VecIndexPtr& index);
 
@@ -58,6 +65,10 @@ class SegmentWriter {
     Status
     WriteDeletedDocs(const DeletedDocsPtr& deleted_docs);
 
+    // the float vectors of this dimension get a summary for segment pruning when serialized
+    void
+    SummarizeVectors(int64_t dimension);
+
     Status
     Serialize();
 
@@ -92,12 +103,19 @@ class SegmentWriter {
     Status
     WriteBloomFilter();
 
+    Status
+    WriteIdIndex();
+
+    Status
+    WriteVectorSummary();
+
     Status
     WriteDeletedDocs();
 
  private:
     storage::FSHandlerPtr fs_ptr_;
     SegmentPtr segment_ptr_;
+    int64_t summary_dimension_ = 0;
 };
 
 using SegmentWriterPtr = std::shared_ptr<SegmentWriter>;
@@ -0,0 +1,182 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "segment/VectorSummary.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace milvus {
+namespace segment {
+
+namespace {
+
+// distances computed by the search in float may be off by this much relative to the norms involved
+constexpr double DISTANCE_ROUNDING_SLACK = 1e-5;
+
+double
+L2Sqr(const float* x, const float* y, int64_t dimension) {
+    double sum = 0;
+    for (int64_t i = 0; i < dimension; ++i) {
+        double diff = x[i] - y[i];
+        sum += diff * diff;
+    }
+    return sum;
+}
+
+double
+InnerProduct(const float* x, const float* y, int64_t dimension) {
+    double sum = 0;
+    for (int64_t i = 0; i < dimension; ++i) {
+        sum += static_cast<double>(x[i]) * y[i];
+    }
+    return sum;
+}
+
+int64_t
+NearestCentroid(const float* vector, const std::vector<float>& centroids, int64_t dimension, double& distance) {
+    int64_t nearest = 0;
+    distance = std::numeric_limits<double>::max();
+    int64_t count = centroids.size() / dimension;
+    for (int64_t c = 0; c < count; ++c) {
+        double d = L2Sqr(vector, centroids.data() + c * dimension, dimension);
+        if (d < distance) {
+            distance = d;
+            nearest = c;
+        }
+    }
+    return nearest;
+}
+
+}  // namespace
+
+VectorSummary::VectorSummary(int64_t dimension, std::vector<float>&& centroids, std::vector<float>&& radii)
+    : dimension_(dimension), centroids_(std::move(centroids)), radii_(std::move(radii)) {
+}
+
+VectorSummaryPtr
+VectorSummary::Build(const float* vectors, int64_t count, int64_t dimension) {
+    if (vectors == nullptr || count <= 0 || dimension <= 0) {
+        return nullptr;
+    }
+
+    // train on rows taken evenly over the segment, the first centroids are rows evenly spaced among them
+    int64_t train_count = std::min(count, VECTOR_SUMMARY_TRAIN_SIZE);
+    std::vector<const float*> train(train_count);
+    for (int64_t i = 0; i < train_count; ++i) {
+        train[i] = vectors + (i * count / train_count) * dimension;
+    }
+
+    int64_t centroid_count = std::min(train_count, VECTOR_SUMMARY_CENTROIDS);
+    std::vector<float> centroids(centroid_count * dimension);
+    for (int64_t c = 0; c < centroid_count; ++c) {
+        const float* row = train[c * train_count / centroid_count];
+        std::copy(row, row + dimension, centroids.begin() + c * dimension);
+    }
+
+    std::vector<double> sums(centroid_count * dimension);
+    std::vector<int64_t> sizes(centroid_count);
+    for (int64_t iter = 0; iter < VECTOR_SUMMARY_ITERATIONS; ++iter) {
+        std::fill(sums.begin(), sums.end(), 0.0);
+        std::fill(sizes.begin(), sizes.end(), 0);
+        for (auto row : train) {
+            double distance;
+            auto c = NearestCentroid(row, centroids, dimension, distance);
+            for (int64_t i = 0; i < dimension; ++i) {
+                sums[c * dimension + i] += row[i];
+            }
+            ++sizes[c];
+        }
+        // an empty cluster keeps its centroid
+        for (int64_t c = 0; c < centroid_count; ++c) {
+            if (sizes[c] > 0) {
+                for (int64_t i = 0; i < dimension; ++i) {
+                    centroids[c * dimension + i] = static_cast<float>(sums[c * dimension + i] / sizes[c]);
+                }
+            }
+        }
+    }
+
+    // the radius of a cluster reaches its farthest vector in the whole segment
+    std::vector<double> max_distances(centroid_count, 0.0);
+    for (int64_t i = 0; i < count; ++i) {
+        double distance;
+        auto c = NearestCentroid(vectors + i * dimension, centroids, dimension, distance);
+        max_distances[c] = std::max(max_distances[c], distance);
+    }
+
+    std::vector<float> radii(centroid_count);
+    for (int64_t c = 0; c < centroid_count; ++c) {
+        // rounded up, so the radius never falls short of the double distance
+        radii[c] = std::nextafter(static_cast<float>(std::sqrt(max_distances[c])), std::numeric_limits<float>::max());
+    }
+
+    return std::make_shared<VectorSummary>(dimension, std::move(centroids), std::move(radii));
+}
+
+float
+VectorSummary::L2LowerBound(const float* query) const {
+    // |q - x| >= |q - c| - r for every x within r of the centroid c
+    double query_norm = std::sqrt(InnerProduct(query, query, dimension_));
+    double bound = std::numeric_limits<double>::max();
+    for (size_t c = 0; c < radii_.size(); ++c) {
+        const float* centroid = centroids_.data() + c * dimension_;
+        double gap = std::max(std::sqrt(L2Sqr(query, centroid, dimension_)) - radii_[c], 0.0);
+        double scale = query_norm + std::sqrt(InnerProduct(centroid, centroid, dimension_)) + radii_[c];
+        bound = std::min(bound, gap * gap - DISTANCE_ROUNDING_SLACK * scale * scale);
+    }
+    return static_cast<float>(std::max(bound, 0.0));
+}
+
+float
+VectorSummary::IPUpperBound(const float* query) const {
+    // q.x = q.c + q.(x - c) <= q.c + |q| * r for every x within r of the centroid c
+    double query_norm = std::sqrt(InnerProduct(query, query, dimension_));
+    double bound = std::numeric_limits<double>::lowest();
+    for (size_t c = 0; c < radii_.size(); ++c) {
+        const float* centroid = centroids_.data() + c * dimension_;
+        double centroid_norm = std::sqrt(InnerProduct(centroid, centroid, dimension_));
+        double slack = DISTANCE_ROUNDING_SLACK * query_norm * (centroid_norm + radii_[c]);
+        bound = std::max(bound, InnerProduct(query, centroid, dimension_) + query_norm * radii_[c] + slack);
+    }
+    return static_cast<float>(bound);
+}
+
+int64_t
+VectorSummary::Dimension() const {
+    return dimension_;
+}
+
+const std::vector<float>&
+VectorSummary::GetCentroids() const {
+    return centroids_;
+}
+
+const std::vector<float>&
+VectorSummary::GetRadii() const {
+    return radii_;
+}
+
+int64_t
+VectorSummary::Size() {
+    return (centroids_.size() + radii_.size()) * sizeof(float);
+}
+
+}  // namespace segment
+}  // namespace milvus
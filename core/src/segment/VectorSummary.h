@@ -0,0 +1,81 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "cache/DataObj.h"
+
+namespace milvus {
+namespace segment {
+
+constexpr int64_t VECTOR_SUMMARY_CENTROIDS = 8;
+constexpr int64_t VECTOR_SUMMARY_TRAIN_SIZE = 256 * VECTOR_SUMMARY_CENTROIDS;
+constexpr int64_t VECTOR_SUMMARY_ITERATIONS = 10;
+
+class VectorSummary;
+using VectorSummaryPtr = std::shared_ptr<VectorSummary>;
+
+// A few k-means centroids of the float vectors of a segment, each with the radius of its cluster. Every vector
+// of the segment lies within the radius of one centroid, which bounds its distance to any query.
+class VectorSummary : public cache::DataObj {
+ public:
+    VectorSummary(int64_t dimension, std::vector<float>&& centroids, std::vector<float>&& radii);
+
+    // nullptr if there is no vector to summarize
+    static VectorSummaryPtr
+    Build(const float* vectors, int64_t count, int64_t dimension);
+
+    // no vector of the segment has a smaller squared L2 distance to the query
+    float
+    L2LowerBound(const float* query) const;
+
+    // no vector of the segment has a larger inner product with the query
+    float
+    IPUpperBound(const float* query) const;
+
+    int64_t
+    Dimension() const;
+
+    const std::vector<float>&
+    GetCentroids() const;
+
+    const std::vector<float>&
+    GetRadii() const;
+
+    int64_t
+    Size() override;
+
+    // No copy and move
+    VectorSummary(const VectorSummary&) = delete;
+    VectorSummary(VectorSummary&&) = delete;
+
+    VectorSummary&
+    operator=(const VectorSummary&) = delete;
+    VectorSummary&
+    operator=(VectorSummary&&) = delete;
+
+ private:
+    int64_t dimension_;
+    std::vector<float> centroids_;
+    std::vector<float> radii_;
+};
+
+}  // namespace segment
+}  // namespace milvus
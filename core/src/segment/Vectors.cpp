@@ -30,20 +30,28 @@ namespace segment {
 
 void
 Vectors::AddData(const std::vector<uint8_t>& data) {
-    data_.reserve(data_.size() + data.size());
     data_.insert(data_.end(), std::make_move_iterator(data.begin()), std::make_move_iterator(data.end()));
 }
 
 void
 Vectors::AddData(const uint8_t* data, uint64_t size) {
-    int64_t old_size = data_.size();
-    data_.resize(data_.size() + size);
-    memcpy(data_.data() + old_size, data, size);
+    // append without zero-filling first, and keep the geometric growth of the buffer
+    data_.insert(data_.end(), data, data + size);
+}
+
+void
+Vectors::AddData(const uint8_t* const* rows, uint64_t count, uint64_t row_size) {
+    auto required = data_.size() + count * row_size;
+    if (required > data_.capacity()) {
+        data_.reserve(std::max<size_t>(required, data_.capacity() * 2));
+    }
+    for (uint64_t i = 0; i < count; ++i) {
+        data_.insert(data_.end(), rows[i], rows[i] + row_size);
+    }
 }
 
 void
 Vectors::AddUids(const std::vector<doc_id_t>& uids) {
-    uids_.reserve(uids_.size() + uids.size());
     uids_.insert(uids_.end(), std::make_move_iterator(uids.begin()), std::make_move_iterator(uids.end()));
 }
 
@@ -36,6 +36,9 @@ class Vectors {
     void
     AddData(const uint8_t* data, uint64_t size);
 
+    void
+    AddData(const uint8_t* const* rows, uint64_t count, uint64_t row_size);
+
     void
     AddUids(const std::vector<doc_id_t>& uids);
 
@@ -62,6 +62,18 @@ DBWrapper::StartService() {
         return s;
     }
 
+    s = config.GetStorageConfigAutoCompactInterval(opt.auto_compact_interval_);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+
+    s = config.GetStorageConfigAutoCompactThreshold(opt.auto_compact_threshold_);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+
     // metric config
     s = config.GetMetricConfigEnableMonitor(opt.metric_enable_);
     if (!s.ok()) {
@@ -84,6 +96,25 @@ DBWrapper::StartService() {
     }
     opt.insert_buffer_size_ = insert_buffer_size;
 
+    s = config.GetCacheConfigBuildIndexBufferSize(opt.build_index_buffer_size_);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+
+    s = config.GetCacheConfigSearchResultCacheSize(opt.search_result_cache_size_);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+
+    // engine config
+    s = config.GetEngineConfigSegmentPruning(opt.segment_pruning_);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+
     bool cluster_enable = false;
     std::string cluster_role;
     STATUS_CHECK(config.GetClusterConfigEnable(cluster_enable));
@@ -233,6 +233,7 @@ Server::Start() {
             STATUS_CHECK(config.GetLogsLogRotateNum(delete_exceeds));
             InitLog(trace_enable, debug_enable, info_enable, warning_enable, error_enable, fatal_enable, logs_path,
                     max_log_file_size, delete_exceeds);
+            StartAsyncLog();
         }
 
         bool cluster_enable = false;
@@ -405,6 +406,7 @@ Server::StopService() {
     DBWrapper::GetInstance().StopService();
     scheduler::StopSchedulerService();
     engine::KnowhereResource::Finalize();
+    StopAsyncLog();
 }
 
 }  // namespace server
@@ -17,8 +17,10 @@
 #include "utils/StringHelpFunctions.h"
 
 #include <fiu-local.h>
+#include <algorithm>
 #include <limits>
 #include <string>
+#include <vector>
 
 namespace milvus {
 namespace server {
@@ -88,6 +90,63 @@ CheckParameterExistence(const milvus::json& json_params, const std::string& para
     return Status::OK();
 }
 
+Status
+CheckOptionalParameterValues(const milvus::json& json_params, const std::string& param_name,
+                             const std::vector<std::string>& values) {
+    if (json_params.find(param_name) == json_params.end()) {
+        return Status::OK();
+    }
+
+    try {
+        std::string value = json_params[param_name];
+        if (std::find(values.begin(), values.end(), value) == values.end()) {
+            std::string msg = "Invalid " + param_name + " value: " + value + ", must be one of the following values: ";
+            for (size_t i = 0; i < values.size(); i++) {
+                if (i != 0) {
+                    msg += ",";
+                }
+                msg += values[i];
+            }
+            LOG_SERVER_ERROR_ << msg;
+            return Status(SERVER_INVALID_ARGUMENT, msg);
+        }
+    } catch (std::exception& e) {
+        std::string msg = "Invalid " + param_name + ": ";
+        msg += e.what();
+        LOG_SERVER_ERROR_ << msg;
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+
+    return Status::OK();
+}
+
+Status
+CheckRangeSearchParams(const milvus::json& search_params, const engine::meta::CollectionSchema& collection_schema) {
+    switch (collection_schema.engine_type_) {
+        case (int32_t)engine::EngineType::FAISS_IDMAP:
+        case (int32_t)engine::EngineType::FAISS_IVFFLAT:
+        case (int32_t)engine::EngineType::FAISS_IVFSQ8:
+        case (int32_t)engine::EngineType::FAISS_PQ:
+        case (int32_t)engine::EngineType::HNSW:
+            break;
+        default: {
+            std::string msg = "Range search is not supported by index type " +
+                              std::to_string(collection_schema.engine_type_);
+            LOG_SERVER_ERROR_ << msg;
+            return Status(SERVER_INVALID_ARGUMENT, msg);
+        }
+    }
+
+    auto& radius = search_params[knowhere::IndexParams::radius];
+    if (!radius.is_number()) {
+        std::string msg = "Invalid " + std::string(knowhere::IndexParams::radius) + ": " + radius.dump();
+        LOG_SERVER_ERROR_ << msg;
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+
+    return Status::OK();
+}
+
 }  // namespace
 
 Status
@@ -190,12 +249,21 @@ ValidateIndexParams(const milvus::json& index_params, const engine::meta::Collec
             }
             break;
         }
-        case (int32_t)engine::EngineType::FAISS_PQ: {
+        case (int32_t)engine::EngineType::FAISS_PQ:
+        case (int32_t)engine::EngineType::FAISS_PQ_FASTSCAN: {
             auto status = CheckParameterRange(index_params, knowhere::IndexParams::nlist, 1, 999999);
             if (!status.ok()) {
                 return status;
             }
 
+            if (index_type == (int32_t)engine::EngineType::FAISS_PQ_FASTSCAN &&
+                index_params.contains(knowhere::IndexParams::refine_factor)) {
+                status = CheckParameterRange(index_params, knowhere::IndexParams::refine_factor, 1, 32);
+                if (!status.ok()) {
+                    return status;
+                }
+            }
+
             status = CheckParameterExistence(index_params, knowhere::IndexParams::m);
             if (!status.ok()) {
                 return status;
@@ -245,9 +313,16 @@ ValidateIndexParams(const milvus::json& index_params, const engine::meta::Collec
             if (!status.ok()) {
                 return status;
             }
+            status = CheckOptionalParameterValues(index_params, knowhere::IndexParams::knng_builder,
+                                                  {knowhere::KnngBuilder::IVF, knowhere::KnngBuilder::NN_DESCENT});
+            if (!status.ok()) {
+                return status;
+            }
             break;
         }
-        case (int32_t)engine::EngineType::HNSW: {
+        case (int32_t)engine::EngineType::HNSW:
+        case (int32_t)engine::EngineType::HNSW_SQ8:
+        case (int32_t)engine::EngineType::BIN_HNSW: {
             auto status = CheckParameterRange(index_params, knowhere::IndexParams::M, 4, 64);
             if (!status.ok()) {
                 return status;
@@ -256,6 +331,13 @@ ValidateIndexParams(const milvus::json& index_params, const engine::meta::Collec
             if (!status.ok()) {
                 return status;
             }
+            if (index_type == (int32_t)engine::EngineType::HNSW_SQ8 &&
+                index_params.contains(knowhere::IndexParams::refine_factor)) {
+                status = CheckParameterRange(index_params, knowhere::IndexParams::refine_factor, 1, 32);
+                if (!status.ok()) {
+                    return status;
+                }
+            }
             break;
         }
         case (int32_t)engine::EngineType::ANNOY: {
@@ -272,6 +354,13 @@ ValidateIndexParams(const milvus::json& index_params, const engine::meta::Collec
 Status
 ValidateSearchParams(const milvus::json& search_params, const engine::meta::CollectionSchema& collection_schema,
                      int64_t topk) {
+    if (search_params.contains(knowhere::IndexParams::radius)) {
+        auto status = CheckRangeSearchParams(search_params, collection_schema);
+        if (!status.ok()) {
+            return status;
+        }
+    }
+
     switch (collection_schema.engine_type_) {
         case (int32_t)engine::EngineType::FAISS_IDMAP:
         case (int32_t)engine::EngineType::FAISS_BIN_IDMAP: {
@@ -288,6 +377,19 @@ ValidateSearchParams(const milvus::json& search_params, const engine::meta::Coll
             }
             break;
         }
+        case (int32_t)engine::EngineType::FAISS_PQ_FASTSCAN: {
+            auto status = CheckParameterRange(search_params, knowhere::IndexParams::nprobe, 1, 999999);
+            if (!status.ok()) {
+                return status;
+            }
+            if (search_params.contains(knowhere::IndexParams::refine_factor)) {
+                status = CheckParameterRange(search_params, knowhere::IndexParams::refine_factor, 1, 32);
+                if (!status.ok()) {
+                    return status;
+                }
+            }
+            break;
+        }
         case (int32_t)engine::EngineType::NSG_MIX: {
             auto status = CheckParameterRange(search_params, knowhere::IndexParams::search_length, 10, 300);
             if (!status.ok()) {
@@ -295,11 +397,20 @@ ValidateSearchParams(const milvus::json& search_params, const engine::meta::Coll
             }
             break;
         }
-        case (int32_t)engine::EngineType::HNSW: {
+        case (int32_t)engine::EngineType::HNSW:
+        case (int32_t)engine::EngineType::HNSW_SQ8:
+        case (int32_t)engine::EngineType::BIN_HNSW: {
             auto status = CheckParameterRange(search_params, knowhere::IndexParams::ef, topk, 4096);
             if (!status.ok()) {
                 return status;
             }
+            if (collection_schema.engine_type_ == (int32_t)engine::EngineType::HNSW_SQ8 &&
+                search_params.contains(knowhere::IndexParams::refine_factor)) {
+                status = CheckParameterRange(search_params, knowhere::IndexParams::refine_factor, 1, 32);
+                if (!status.ok()) {
+                    return status;
+                }
+            }
             break;
         }
         case (int32_t)engine::EngineType::ANNOY: {
@@ -317,11 +428,27 @@ ValidateSearchParams(const milvus::json& search_params, const engine::meta::Coll
 Status
 ValidateVectorData(const engine::VectorsData& vectors, const engine::meta::CollectionSchema& collection_schema) {
     uint64_t vector_count = vectors.vector_count_;
-    if ((vectors.float_data_.empty() && vectors.binary_data_.empty()) || vector_count == 0) {
+    auto& rows = vectors.rows_;
+    if ((vectors.float_data_.empty() && vectors.binary_data_.empty() && rows.rows_.empty()) || vector_count == 0) {
         return Status(SERVER_INVALID_ROWRECORD_ARRAY,
                       "The vector array is empty. Make sure you have entered vector records.");
     }
 
+    if (!rows.rows_.empty()) {
+        // rows read in place, all of one size
+        if (rows.rows_.size() != vector_count) {
+            return Status(SERVER_INVALID_ROWRECORD_ARRAY,
+                          "The vector dimension must be equal to the collection dimension.");
+        }
+        uint64_t dimension = rows.binary_ ? rows.row_size_ * 8 : rows.row_size_ / sizeof(float);
+        if (rows.binary_ != engine::utils::IsBinaryMetricType(collection_schema.metric_type_) ||
+            dimension != collection_schema.dimension_) {
+            return Status(SERVER_INVALID_VECTOR_DIMENSION,
+                          "The vector dimension must be equal to the collection dimension.");
+        }
+        return Status::OK();
+    }
+
     if (engine::utils::IsBinaryMetricType(collection_schema.metric_type_)) {
         // check prepared binary data
         if (vectors.binary_data_.size() % vector_count != 0) {
@@ -353,6 +480,12 @@ Status
 ValidateVectorDataSize(const engine::VectorsData& vectors, const engine::meta::CollectionSchema& collection_schema) {
     std::string msg =
         "The amount of data inserted each time cannot exceed " + std::to_string(MAX_INSERT_DATA_SIZE / M_BYTE) + " MB";
+    if (!vectors.rows_.rows_.empty()) {
+        if (vectors.rows_.rows_.size() * vectors.rows_.row_size_ > MAX_INSERT_DATA_SIZE) {
+            return Status(SERVER_INVALID_ROWRECORD_ARRAY, msg);
+        }
+        return Status::OK();
+    }
     if (engine::utils::IsBinaryMetricType(collection_schema.metric_type_)) {
         if (vectors.binary_data_.size() > MAX_INSERT_DATA_SIZE) {
             return Status(SERVER_INVALID_ROWRECORD_ARRAY, msg);
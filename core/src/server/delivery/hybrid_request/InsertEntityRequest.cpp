@@ -137,16 +137,20 @@ InsertEntityRequest::OnExecute() {
         engine::Entity entity;
         entity.entity_count_ = row_num_;
 
-        entity.attr_value_ = attr_values_;
-        entity.vector_data_.insert(std::make_pair(vector_datas_it->first, vector_datas_it->second));
+        // lend the request buffers to the entity instead of copying them, they are handed back below
+        entity.attr_value_.swap(attr_values_);
+        auto& entity_vectors = entity.vector_data_[vector_datas_it->first];
+        entity_vectors = std::move(vector_datas_it->second);
 
         rc.RecordSection("prepare vectors data");
         status = DBWrapper::DB()->InsertEntities(collection_name_, partition_tag_, field_names_, entity, field_types);
         fiu_do_on("InsertRequest.OnExecute.insert_fail", status = Status(milvus::SERVER_UNEXPECTED_ERROR, ""));
+        attr_values_.swap(entity.attr_value_);
+        vector_datas_it->second = std::move(entity_vectors);
         if (!status.ok()) {
             return status;
         }
-        vector_datas_it->second.id_array_ = entity.id_array_;
+        vector_datas_it->second.id_array_ = std::move(entity.id_array_);
 
         //        auto ids_size = vectors_data_.id_array_.size();
         //        fiu_do_on("InsertRequest.OnExecute.invalid_ids_size", ids_size = vec_count - 1);
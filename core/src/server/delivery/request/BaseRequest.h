@@ -56,6 +56,8 @@ struct TopKQueryResult {
     int64_t row_num_;
     engine::ResultIds id_list_;
     engine::ResultDistances distance_list_;
+    // only filled by range search, results of row i are in [lims_[i], lims_[i + 1])
+    engine::ResultLims lims_;
 
     TopKQueryResult() {
         row_num_ = 0;
@@ -91,6 +91,8 @@ CreateIndexRequest::OnExecute() {
                 adapter_index_type = static_cast<int32_t>(engine::EngineType::FAISS_BIN_IDMAP);
             } else if (adapter_index_type == static_cast<int32_t>(engine::EngineType::FAISS_IVFFLAT)) {
                 adapter_index_type = static_cast<int32_t>(engine::EngineType::FAISS_BIN_IVFFLAT);
+            } else if (adapter_index_type == static_cast<int32_t>(engine::EngineType::HNSW)) {
+                adapter_index_type = static_cast<int32_t>(engine::EngineType::BIN_HNSW);
             } else {
                 return Status(SERVER_INVALID_INDEX_TYPE, "Invalid index type for collection metric type");
             }
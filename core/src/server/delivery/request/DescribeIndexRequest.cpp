@@ -68,12 +68,14 @@ DescribeIndexRequest::OnExecute() {
             return status;
         }
 
-        // for binary vector, IDMAP and IVFLAT will be treated as BIN_IDMAP and BIN_IVFLAT internally
-        // return IDMAP and IVFLAT for outside caller
+        // for binary vector, IDMAP, IVFLAT and HNSW will be treated as BIN_IDMAP, BIN_IVFLAT and BIN_HNSW internally
+        // return IDMAP, IVFLAT and HNSW for outside caller
         if (index.engine_type_ == (int32_t)engine::EngineType::FAISS_BIN_IDMAP) {
             index.engine_type_ = (int32_t)engine::EngineType::FAISS_IDMAP;
         } else if (index.engine_type_ == (int32_t)engine::EngineType::FAISS_BIN_IVFFLAT) {
             index.engine_type_ = (int32_t)engine::EngineType::FAISS_IVFFLAT;
+        } else if (index.engine_type_ == (int32_t)engine::EngineType::BIN_HNSW) {
+            index.engine_type_ = (int32_t)engine::EngineType::HNSW;
         }
 
         index_param_.collection_name_ = collection_name_;
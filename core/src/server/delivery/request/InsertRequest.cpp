@@ -60,7 +60,8 @@ InsertRequest::OnExecute() {
             LOG_SERVER_ERROR_ << LogOut("[%s][%ld] Invalid collection name: %s", "insert", 0, status.message().c_str());
             return status;
         }
-        if (vectors_data_.float_data_.empty() && vectors_data_.binary_data_.empty()) {
+        if (vectors_data_.float_data_.empty() && vectors_data_.binary_data_.empty() &&
+            vectors_data_.rows_.rows_.empty()) {
             std::string msg = "The vector array is empty. Make sure you have entered vector records.";
             LOG_SERVER_ERROR_ << LogOut("[%s][%ld] Invalid records: %s", "insert", 0, msg.c_str());
             return Status(SERVER_INVALID_ROWRECORD_ARRAY, msg);
@@ -20,6 +20,7 @@
 #include <memory>
 
 #include "config/Config.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
 #include "server/DBWrapper.h"
 #include "server/ValidationUtil.h"
 #include "utils/CommonUtil.h"
@@ -99,6 +100,9 @@ SearchByIDRequest::OnExecute() {
         }
 
         // step 5: check search parameters
+        if (extra_params_.contains(knowhere::IndexParams::radius)) {
+            return Status(SERVER_INVALID_ARGUMENT, "Range search by id is not supported");
+        }
         status = ValidateSearchParams(extra_params_, collection_schema, topk_);
         if (!status.ok()) {
             return status;
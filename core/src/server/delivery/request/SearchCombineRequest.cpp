@@ -11,6 +11,7 @@
 
 #include "server/delivery/request/SearchCombineRequest.h"
 #include "db/Utils.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
 #include "server/DBWrapper.h"
 #include "server/ValidationUtil.h"
 #include "server/context/Context.h"
@@ -148,6 +149,11 @@ SearchCombineRequest::CanCombine(const SearchRequestPtr& request) {
         return false;
     }
 
+    // range search results are not split per topk, leave them alone
+    if (request->ExtraParams().contains(knowhere::IndexParams::radius)) {
+        return false;
+    }
+
     // topk must within certain range
     if (request->TopK() < min_topk_ || request->TopK() > max_topk_) {
         return false;
@@ -189,6 +195,10 @@ SearchCombineRequest::CanCombine(const SearchRequestPtr& left, const SearchReque
         return false;
     }
 
+    if (left->ExtraParams().contains(knowhere::IndexParams::radius)) {
+        return false;
+    }
+
     // topk must within certain range
     if (abs(left->TopK() - right->TopK() > MAX_TOPK_GAP)) {
         return false;
@@ -16,6 +16,7 @@
 #include <fiu-local.h>
 
 #include "db/Utils.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
 #include "server/DBWrapper.h"
 #include "server/ValidationUtil.h"
 #include "utils/CommonUtil.h"
@@ -141,10 +142,20 @@ SearchRequest::OnExecute() {
         ProfilerStart(fname.c_str());
 #endif
 
+        engine::ResultLims result_lims;
         engine::ResultIds result_ids;
         engine::ResultDistances result_distances;
 
-        if (file_id_list_.empty()) {
+        bool range_search = extra_params_.contains(knowhere::IndexParams::radius);
+        if (range_search) {
+            if (!file_id_list_.empty()) {
+                std::string msg = "Range search by file id is not supported";
+                LOG_SERVER_ERROR_ << LogOut("[%s][%ld] %s", "search", 0, msg.c_str());
+                return Status(SERVER_INVALID_ARGUMENT, msg);
+            }
+            status = DBWrapper::DB()->QueryByRange(context_, collection_name_, partition_list_, extra_params_,
+                                                   vectors_data_, result_lims, result_ids, result_distances);
+        } else if (file_id_list_.empty()) {
             status = DBWrapper::DB()->Query(context_, collection_name_, partition_list_, (size_t)topk_, extra_params_,
                                             vectors_data_, result_ids, result_distances);
         } else {
@@ -163,7 +174,7 @@ SearchRequest::OnExecute() {
             return status;
         }
         fiu_do_on("SearchRequest.OnExecute.empty_result_ids", result_ids.clear());
-        if (result_ids.empty()) {
+        if (result_ids.empty() && !range_search) {
             return Status::OK();  // empty collection
         }
 
@@ -172,6 +183,7 @@ SearchRequest::OnExecute() {
         result_.row_num_ = vectors_data_.vector_count_;
         result_.id_list_.swap(result_ids);
         result_.distance_list_.swap(result_distances);
+        result_.lims_.swap(result_lims);
         rc.RecordSection("construct result");
     } catch (std::exception& ex) {
         LOG_SERVER_ERROR_ << LogOut("[%s][%ld] Encounter exception: %s", "search", 0, ex.what());
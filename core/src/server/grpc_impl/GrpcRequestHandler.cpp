@@ -106,27 +106,23 @@ CopyRowRecords(const google::protobuf::RepeatedPtrField<::milvus::grpc::RowRecor
         binary_data_size += record.binary_data().size();
     }
 
-    std::vector<float> float_array(float_data_size, 0.0f);
-    std::vector<uint8_t> binary_array(binary_data_size, 0);
-    int64_t float_offset = 0, binary_offset = 0;
+    std::vector<float> float_array;
+    std::vector<uint8_t> binary_array;
     if (float_data_size > 0) {
+        float_array.reserve(float_data_size);
         for (auto& record : grpc_records) {
-            memcpy(&float_array[float_offset], record.float_data().data(), record.float_data_size() * sizeof(float));
-            float_offset += record.float_data_size();
+            float_array.insert(float_array.end(), record.float_data().begin(), record.float_data().end());
         }
     } else if (binary_data_size > 0) {
+        binary_array.reserve(binary_data_size);
         for (auto& record : grpc_records) {
-            memcpy(&binary_array[binary_offset], record.binary_data().data(), record.binary_data().size());
-            binary_offset += record.binary_data().size();
+            auto& binary = record.binary_data();
+            binary_array.insert(binary_array.end(), binary.begin(), binary.end());
         }
     }
 
     // step 2: copy id array
-    std::vector<int64_t> id_array;
-    if (grpc_id_array.size() > 0) {
-        id_array.resize(grpc_id_array.size());
-        memcpy(id_array.data(), grpc_id_array.data(), grpc_id_array.size() * sizeof(int64_t));
-    }
+    std::vector<int64_t> id_array(grpc_id_array.begin(), grpc_id_array.end());
 
     // step 3: contruct vectors
     vectors.vector_count_ = grpc_records.size();
@@ -135,6 +131,45 @@ CopyRowRecords(const google::protobuf::RepeatedPtrField<::milvus::grpc::RowRecor
     vectors.id_array_.swap(id_array);
 }
 
+// Point the vectors at the records of the request instead of copying them, the request outlives the insert.
+// Returns false when the records are not all of one type and size, those are left to CopyRowRecords.
+bool
+ViewRowRecords(const google::protobuf::RepeatedPtrField<::milvus::grpc::RowRecord>& grpc_records,
+               const google::protobuf::RepeatedField<google::protobuf::int64>& grpc_id_array,
+               engine::VectorsData& vectors) {
+    if (grpc_records.empty()) {
+        return false;
+    }
+
+    engine::VectorRows rows;
+    rows.binary_ = grpc_records.Get(0).float_data_size() == 0;
+    rows.row_size_ = rows.binary_ ? grpc_records.Get(0).binary_data().size()
+                                  : grpc_records.Get(0).float_data_size() * sizeof(float);
+    if (rows.row_size_ == 0) {
+        return false;
+    }
+
+    rows.rows_.reserve(grpc_records.size());
+    for (auto& record : grpc_records) {
+        if (rows.binary_) {
+            if (record.float_data_size() != 0 || record.binary_data().size() != rows.row_size_) {
+                return false;
+            }
+            rows.rows_.push_back(reinterpret_cast<const uint8_t*>(record.binary_data().data()));
+        } else {
+            if (!record.binary_data().empty() || record.float_data_size() * sizeof(float) != rows.row_size_) {
+                return false;
+            }
+            rows.rows_.push_back(reinterpret_cast<const uint8_t*>(record.float_data().data()));
+        }
+    }
+
+    vectors.vector_count_ = grpc_records.size();
+    vectors.rows_ = std::move(rows);
+    vectors.id_array_.assign(grpc_id_array.begin(), grpc_id_array.end());
+    return true;
+}
+
 void
 DeSerialization(const ::milvus::grpc::GeneralQuery& general_query, query::BooleanQueryPtr& boolean_clause,
                 query::QueryPtr& query_ptr) {
@@ -228,6 +263,9 @@ ConstructResults(const TopKQueryResult& result, ::milvus::grpc::TopKQueryResult*
     response->mutable_distances()->Resize(static_cast<int>(result.distance_list_.size()), 0.0);
     memcpy(response->mutable_distances()->mutable_data(), result.distance_list_.data(),
            result.distance_list_.size() * sizeof(float));
+
+    response->mutable_lims()->Resize(static_cast<int>(result.lims_.size()), 0);
+    memcpy(response->mutable_lims()->mutable_data(), result.lims_.data(), result.lims_.size() * sizeof(int64_t));
 }
 
 void
@@ -619,9 +657,11 @@ GrpcRequestHandler::Insert(::grpc::ServerContext* context, const ::milvus::grpc:
     CHECK_NULLPTR_RETURN(request);
     LOG_SERVER_INFO_ << LogOut("Request [%s] %s begin.", GetContext(context)->RequestID().c_str(), __func__);
 
-    // step 1: copy vector data
+    // step 1: read the vector data in place, copy it only when the records differ in type or size
     engine::VectorsData vectors;
-    CopyRowRecords(request->row_record_array(), request->row_id_array(), vectors);
+    if (!ViewRowRecords(request->row_record_array(), request->row_id_array(), vectors)) {
+        CopyRowRecords(request->row_record_array(), request->row_id_array(), vectors);
+    }
 
     // step 2: insert vectors
     Status status =
@@ -23,6 +23,8 @@ const char* NAME_ENGINE_TYPE_RNSG = "RNSG";
 const char* NAME_ENGINE_TYPE_IVFPQ = "IVFPQ";
 const char* NAME_ENGINE_TYPE_HNSW = "HNSW";
 const char* NAME_ENGINE_TYPE_ANNOY = "ANNOY";
+const char* NAME_ENGINE_TYPE_IVFPQFASTSCAN = "IVFPQFASTSCAN";
+const char* NAME_ENGINE_TYPE_HNSWSQ8 = "HNSWSQ8";
 
 const char* NAME_METRIC_TYPE_L2 = "L2";
 const char* NAME_METRIC_TYPE_IP = "IP";
@@ -54,6 +56,8 @@ const std::unordered_map<engine::EngineType, std::string> IndexMap = {
     {engine::EngineType::FAISS_PQ, NAME_ENGINE_TYPE_IVFPQ},
     {engine::EngineType::HNSW, NAME_ENGINE_TYPE_HNSW},
     {engine::EngineType::ANNOY, NAME_ENGINE_TYPE_ANNOY},
+    {engine::EngineType::FAISS_PQ_FASTSCAN, NAME_ENGINE_TYPE_IVFPQFASTSCAN},
+    {engine::EngineType::HNSW_SQ8, NAME_ENGINE_TYPE_HNSWSQ8},
 };
 
 const std::unordered_map<std::string, engine::EngineType> IndexNameMap = {
@@ -65,6 +69,8 @@ const std::unordered_map<std::string, engine::EngineType> IndexNameMap = {
     {NAME_ENGINE_TYPE_IVFPQ, engine::EngineType::FAISS_PQ},
     {NAME_ENGINE_TYPE_HNSW, engine::EngineType::HNSW},
     {NAME_ENGINE_TYPE_ANNOY, engine::EngineType::ANNOY},
+    {NAME_ENGINE_TYPE_IVFPQFASTSCAN, engine::EngineType::FAISS_PQ_FASTSCAN},
+    {NAME_ENGINE_TYPE_HNSWSQ8, engine::EngineType::HNSW_SQ8},
 };
 
 const std::unordered_map<engine::MetricType, std::string> MetricMap = {
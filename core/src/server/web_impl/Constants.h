@@ -28,6 +28,8 @@ extern const char* NAME_ENGINE_TYPE_RNSG;
 extern const char* NAME_ENGINE_TYPE_IVFPQ;
 extern const char* NAME_ENGINE_TYPE_HNSW;
 extern const char* NAME_ENGINE_TYPE_ANNOY;
+extern const char* NAME_ENGINE_TYPE_IVFPQFASTSCAN;
+extern const char* NAME_ENGINE_TYPE_HNSWSQ8;
 
 extern const char* NAME_METRIC_TYPE_L2;
 extern const char* NAME_METRIC_TYPE_IP;
@@ -486,14 +486,17 @@ WebRequestHandler::Search(const std::string& collection_name, const nlohmann::js
         return Status::OK();
     }
 
+    // range search returns a variable number of results per row, described by lims_
     auto step = result.id_list_.size() / result.row_num_;
     nlohmann::json search_result_json;
     for (int64_t i = 0; i < result.row_num_; i++) {
-        nlohmann::json raw_result_json;
-        for (size_t j = 0; j < step; j++) {
+        size_t begin = result.lims_.empty() ? i * step : result.lims_.at(i);
+        size_t end = result.lims_.empty() ? begin + step : result.lims_.at(i + 1);
+        nlohmann::json raw_result_json = nlohmann::json::array();
+        for (size_t j = begin; j < end; j++) {
             nlohmann::json one_result_json;
-            one_result_json["id"] = std::to_string(result.id_list_.at(i * step + j));
-            one_result_json["distance"] = std::to_string(result.distance_list_.at(i * step + j));
+            one_result_json["id"] = std::to_string(result.id_list_.at(j));
+            one_result_json["distance"] = std::to_string(result.distance_list_.at(j));
             raw_result_json.emplace_back(one_result_json);
         }
         search_result_json.emplace_back(raw_result_json);
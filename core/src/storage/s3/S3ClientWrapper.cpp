@@ -10,14 +10,23 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include <aws/core/auth/AWSCredentialsProvider.h>
+#include <aws/s3/model/AbortMultipartUploadRequest.h>
+#include <aws/s3/model/CompleteMultipartUploadRequest.h>
+#include <aws/s3/model/CompletedMultipartUpload.h>
+#include <aws/s3/model/CompletedPart.h>
 #include <aws/s3/model/CreateBucketRequest.h>
+#include <aws/s3/model/CreateMultipartUploadRequest.h>
 #include <aws/s3/model/DeleteBucketRequest.h>
 #include <aws/s3/model/DeleteObjectRequest.h>
 #include <aws/s3/model/GetObjectRequest.h>
+#include <aws/s3/model/HeadObjectRequest.h>
 #include <aws/s3/model/ListObjectsRequest.h>
 #include <aws/s3/model/PutObjectRequest.h>
+#include <aws/s3/model/UploadPartRequest.h>
 #include <fiu-local.h>
+#include <algorithm>
 #include <fstream>
+#include <future>
 #include <iostream>
 #include <memory>
 #include <utility>
@@ -25,6 +34,7 @@
 #include "config/Config.h"
 #include "storage/s3/S3ClientMock.h"
 #include "storage/s3/S3ClientWrapper.h"
+#include "storage/s3/S3DiskCache.h"
 #include "utils/Error.h"
 #include "utils/Log.h"
 
@@ -48,6 +58,10 @@ S3ClientWrapper::StartService() {
     CONFIG_CHECK(config.GetStorageConfigS3SecretKey(s3_secret_key_));
     CONFIG_CHECK(config.GetStorageConfigS3Bucket(s3_bucket_));
 
+    std::string storage_path;
+    CONFIG_CHECK(config.GetStorageConfigPath(storage_path));
+    S3DiskCache::GetInstance()->SetDirectory(storage_path + "/s3_cache");
+
     Aws::InitAPI(options_);
 
     Aws::Client::ClientConfiguration cfg;
@@ -63,6 +77,7 @@ S3ClientWrapper::StartService() {
     if (mock_enable) {
         client_ptr_ = std::make_shared<S3ClientMock>();
     }
+    transfer_pool_ = std::make_shared<TaskExecutor>(S3_TRANSFER_THREAD_NUM);
 
     std::cout << "S3 service connection check ...... " << std::flush;
     Status stat = CreateBucket();
@@ -72,6 +87,8 @@ S3ClientWrapper::StartService() {
 
 void
 S3ClientWrapper::StopService() {
+    S3DiskCache::GetInstance()->ClearCache();
+    transfer_pool_ = nullptr;
     client_ptr_ = nullptr;
     Aws::ShutdownAPI(options_);
 }
@@ -211,6 +228,158 @@ S3ClientWrapper::GetObjectStr(const std::string& object_name, std::string& conte
     return Status::OK();
 }
 
+Status
+S3ClientWrapper::HeadObject(const std::string& object_name, int64_t& size) {
+    Aws::S3::Model::HeadObjectRequest request;
+    request.WithBucket(s3_bucket_).WithKey(object_name);
+
+    auto outcome = client_ptr_->HeadObject(request);
+
+    fiu_do_on("S3ClientWrapper.HeadObject.outcome.fail", outcome = Aws::S3::Model::HeadObjectOutcome());
+    if (!outcome.IsSuccess()) {
+        auto err = outcome.GetError();
+        LOG_STORAGE_ERROR_ << "ERROR: HeadObject: " << err.GetExceptionName() << ": " << err.GetMessage();
+        return Status(SERVER_UNEXPECTED_ERROR, err.GetMessage());
+    }
+
+    size = outcome.GetResult().GetContentLength();
+    return Status::OK();
+}
+
+Status
+S3ClientWrapper::GetPart(const std::string& object_name, int64_t offset, int64_t size, char* buffer) {
+    Aws::S3::Model::GetObjectRequest request;
+    request.WithBucket(s3_bucket_).WithKey(object_name);
+    std::string range = "bytes=" + std::to_string(offset) + "-" + std::to_string(offset + size - 1);
+    request.SetRange(range.c_str());
+
+    auto outcome = client_ptr_->GetObject(request);
+
+    fiu_do_on("S3ClientWrapper.GetPart.outcome.fail", outcome = Aws::S3::Model::GetObjectOutcome());
+    if (!outcome.IsSuccess()) {
+        auto err = outcome.GetError();
+        LOG_STORAGE_ERROR_ << "ERROR: GetObject " << range << ": " << err.GetExceptionName() << ": "
+                           << err.GetMessage();
+        return Status(SERVER_UNEXPECTED_ERROR, err.GetMessage());
+    }
+
+    auto& body = outcome.GetResultWithOwnership().GetBody();
+    body.read(buffer, size);
+    if (body.gcount() != size) {
+        std::string str = "Object '" + object_name + "' is shorter than " + range;
+        LOG_STORAGE_ERROR_ << "ERROR: " << str;
+        return Status(SERVER_UNEXPECTED_ERROR, str);
+    }
+    return Status::OK();
+}
+
+Status
+S3ClientWrapper::GetObjectRange(const std::string& object_name, int64_t offset, int64_t size, void* buffer) {
+    auto data = static_cast<char*>(buffer);
+    if (size <= S3_PART_SIZE) {
+        return GetPart(object_name, offset, size, data);
+    }
+
+    std::vector<std::future<Status>> parts;
+    for (int64_t pos = 0; pos < size; pos += S3_PART_SIZE) {
+        auto part_size = std::min(S3_PART_SIZE, size - pos);
+        parts.emplace_back(transfer_pool_->Enqueue(&S3ClientWrapper::GetPart, this, object_name, offset + pos,
+                                                   part_size, data + pos));
+    }
+
+    Status status;
+    for (auto& part : parts) {
+        auto part_status = part.get();
+        if (!part_status.ok()) {
+            status = part_status;
+        }
+    }
+    return status;
+}
+
+Status
+S3ClientWrapper::CreateMultipartUpload(const std::string& object_name, std::string& upload_id) {
+    Aws::S3::Model::CreateMultipartUploadRequest request;
+    request.WithBucket(s3_bucket_).WithKey(object_name);
+
+    auto outcome = client_ptr_->CreateMultipartUpload(request);
+
+    fiu_do_on("S3ClientWrapper.CreateMultipartUpload.outcome.fail",
+              outcome = Aws::S3::Model::CreateMultipartUploadOutcome());
+    if (!outcome.IsSuccess()) {
+        auto err = outcome.GetError();
+        LOG_STORAGE_ERROR_ << "ERROR: CreateMultipartUpload: " << err.GetExceptionName() << ": " << err.GetMessage();
+        return Status(SERVER_UNEXPECTED_ERROR, err.GetMessage());
+    }
+
+    upload_id = outcome.GetResult().GetUploadId();
+    return Status::OK();
+}
+
+Status
+S3ClientWrapper::UploadPart(const std::string& object_name, const std::string& upload_id, int part_number,
+                            const std::string& data, std::string& etag) {
+    Aws::S3::Model::UploadPartRequest request;
+    request.WithBucket(s3_bucket_).WithKey(object_name).WithUploadId(upload_id).WithPartNumber(part_number);
+
+    const std::shared_ptr<Aws::IOStream> input_data = Aws::MakeShared<Aws::StringStream>("UploadPart");
+    input_data->write(data.data(), data.length());
+    request.SetBody(input_data);
+    request.SetContentLength(data.length());
+
+    auto outcome = client_ptr_->UploadPart(request);
+
+    fiu_do_on("S3ClientWrapper.UploadPart.outcome.fail", outcome = Aws::S3::Model::UploadPartOutcome());
+    if (!outcome.IsSuccess()) {
+        auto err = outcome.GetError();
+        LOG_STORAGE_ERROR_ << "ERROR: UploadPart: " << err.GetExceptionName() << ": " << err.GetMessage();
+        return Status(SERVER_UNEXPECTED_ERROR, err.GetMessage());
+    }
+
+    etag = outcome.GetResult().GetETag();
+    return Status::OK();
+}
+
+Status
+S3ClientWrapper::CompleteMultipartUpload(const std::string& object_name, const std::string& upload_id,
+                                         const std::vector<std::string>& etags) {
+    Aws::S3::Model::CompletedMultipartUpload upload;
+    for (size_t i = 0; i < etags.size(); ++i) {
+        upload.AddParts(Aws::S3::Model::CompletedPart().WithETag(etags[i]).WithPartNumber(i + 1));
+    }
+
+    Aws::S3::Model::CompleteMultipartUploadRequest request;
+    request.WithBucket(s3_bucket_).WithKey(object_name).WithUploadId(upload_id).WithMultipartUpload(upload);
+
+    auto outcome = client_ptr_->CompleteMultipartUpload(request);
+
+    fiu_do_on("S3ClientWrapper.CompleteMultipartUpload.outcome.fail",
+              outcome = Aws::S3::Model::CompleteMultipartUploadOutcome());
+    if (!outcome.IsSuccess()) {
+        auto err = outcome.GetError();
+        LOG_STORAGE_ERROR_ << "ERROR: CompleteMultipartUpload: " << err.GetExceptionName() << ": "
+                           << err.GetMessage();
+        return Status(SERVER_UNEXPECTED_ERROR, err.GetMessage());
+    }
+
+    LOG_STORAGE_DEBUG_ << "Uploaded '" << object_name << "' in " << etags.size() << " parts";
+    return Status::OK();
+}
+
+Status
+S3ClientWrapper::AbortMultipartUpload(const std::string& object_name, const std::string& upload_id) {
+    Aws::S3::Model::AbortMultipartUploadRequest request;
+    request.WithBucket(s3_bucket_).WithKey(object_name).WithUploadId(upload_id);
+
+    auto outcome = client_ptr_->AbortMultipartUpload(request);
+    if (!outcome.IsSuccess()) {
+        auto err = outcome.GetError();
+        LOG_STORAGE_ERROR_ << "ERROR: AbortMultipartUpload: " << err.GetExceptionName() << ": " << err.GetMessage();
+        return Status(SERVER_UNEXPECTED_ERROR, err.GetMessage());
+    }
+    return Status::OK();
+}
+
 Status
 S3ClientWrapper::ListObjects(std::vector<std::string>& object_list, const std::string& marker) {
     Aws::S3::Model::ListObjectsRequest request;
@@ -18,10 +18,15 @@
 #include <vector>
 
 #include "utils/Status.h"
+#include "utils/TaskExecutor.h"
 
 namespace milvus {
 namespace storage {
 
+// objects are read and written in parts of this size, in parallel, S3 requires 5MB at least except the last part
+constexpr int64_t S3_PART_SIZE = 8LL << 20;
+constexpr int64_t S3_TRANSFER_THREAD_NUM = 8;
+
 class S3ClientWrapper {
  public:
     static S3ClientWrapper&
@@ -48,12 +53,37 @@ class S3ClientWrapper {
     Status
     GetObjectStr(const std::string& object_key, std::string& content);
     Status
+    HeadObject(const std::string& object_key, int64_t& size);
+    // reads [offset, offset + size) of an object into buffer, in parts fetched in parallel
+    Status
+    GetObjectRange(const std::string& object_key, int64_t offset, int64_t size, void* buffer);
+    Status
+    CreateMultipartUpload(const std::string& object_key, std::string& upload_id);
+    Status
+    UploadPart(const std::string& object_key, const std::string& upload_id, int part_number, const std::string& data,
+               std::string& etag);
+    Status
+    CompleteMultipartUpload(const std::string& object_key, const std::string& upload_id,
+                            const std::vector<std::string>& etags);
+    Status
+    AbortMultipartUpload(const std::string& object_key, const std::string& upload_id);
+    Status
     ListObjects(std::vector<std::string>& object_list, const std::string& marker = "");
     Status
     DeleteObject(const std::string& object_key);
     Status
     DeleteObjects(const std::string& marker);
 
+    // runs the part transfers of readers and writers
+    const TaskExecutorPtr&
+    GetTransferPool() const {
+        return transfer_pool_;
+    }
+
+ private:
+    Status
+    GetPart(const std::string& object_key, int64_t offset, int64_t size, char* buffer);
+
  private:
     std::shared_ptr<Aws::S3::S3Client> client_ptr_;
     Aws::SDKOptions options_;
@@ -63,6 +93,8 @@ class S3ClientWrapper {
     std::string s3_access_key_;
     std::string s3_secret_key_;
     std::string s3_bucket_;
+
+    TaskExecutorPtr transfer_pool_;
 };
 
 }  // namespace storage
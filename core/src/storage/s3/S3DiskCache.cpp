@@ -0,0 +1,157 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "storage/s3/S3DiskCache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include <fiu-local.h>
+
+#include "storage/s3/S3ClientWrapper.h"
+#include "utils/CommonUtil.h"
+#include "utils/Error.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace storage {
+
+S3CacheFile::S3CacheFile(std::string path, int64_t size) : path_(std::move(path)), size_(size) {
+}
+
+S3CacheFile::~S3CacheFile() {
+    std::remove(path_.c_str());
+}
+
+S3DiskCache::S3DiskCache() {
+    cache_ = std::make_shared<cache::Cache<cache::DataObjPtr>>(S3_DISK_CACHE_CAPACITY, 1UL << 32, "[CACHE S3 DISK]");
+}
+
+S3DiskCache*
+S3DiskCache::GetInstance() {
+    static S3DiskCache s_mgr;
+    return &s_mgr;
+}
+
+Status
+S3DiskCache::SetDirectory(const std::string& path) {
+    ClearCache();
+    CommonUtil::DeleteDirectory(path);
+    auto status = CommonUtil::CreateDirectory(path);
+    if (!status.ok()) {
+        LOG_STORAGE_ERROR_ << "S3 disk cache disabled: " << status.message();
+        directory_.clear();
+        return status;
+    }
+
+    directory_ = path;
+    LOG_STORAGE_INFO_ << "S3 disk cache: " << directory_ << ", capacity: " << (CacheCapacity() >> 20) << "MB";
+    return Status::OK();
+}
+
+Status
+S3DiskCache::Fetch(const std::string& object_name, S3CacheFilePtr& file) {
+    file = std::static_pointer_cast<S3CacheFile>(GetItem(object_name));
+    if (file != nullptr) {
+        return Status::OK();
+    }
+
+    std::promise<Status> promise;
+    std::shared_future<Status> future;
+    bool owner = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = downloading_.find(object_name);
+        if (iter == downloading_.end()) {
+            future = promise.get_future().share();
+            downloading_.insert(std::make_pair(object_name, future));
+            owner = true;
+        } else {
+            future = iter->second;
+        }
+    }
+
+    if (!owner) {
+        STATUS_CHECK(future.get());
+        file = std::static_pointer_cast<S3CacheFile>(GetItem(object_name));
+        if (file != nullptr) {
+            return Status::OK();
+        }
+        // already evicted by a burst of other downloads
+        return Download(object_name, file);
+    }
+
+    auto status = Download(object_name, file);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        downloading_.erase(object_name);
+    }
+    promise.set_value(status);
+    return status;
+}
+
+Status
+S3DiskCache::Download(const std::string& object_name, S3CacheFilePtr& file) {
+    auto& client = S3ClientWrapper::GetInstance();
+
+    int64_t size = 0;
+    STATUS_CHECK(client.HeadObject(object_name, size));
+    if (size > CacheCapacity()) {
+        std::string msg = "Object '" + object_name + "' is larger than the S3 disk cache";
+        return Status(SERVER_UNEXPECTED_ERROR, msg);
+    }
+
+    // a unique name, the evicted copy of the same object may still be open
+    std::string path = directory_ + "/" + std::to_string(std::hash<std::string>()(object_name)) + "_" +
+                       std::to_string(file_seq_++);
+    std::string tmp_path = path + ".tmp";
+
+    std::ofstream fs(tmp_path, std::ios::out | std::ios::binary | std::ios::trunc);
+    fiu_do_on("S3DiskCache.Download.open.fail", fs.close());
+    if (!fs.is_open()) {
+        std::string msg = "Failed to create file " + tmp_path;
+        LOG_STORAGE_ERROR_ << msg;
+        return Status(SERVER_CANNOT_CREATE_FILE, msg);
+    }
+
+    // download in waves of one part per transfer thread, then write the wave out
+    std::vector<char> buffer(std::min(size, S3_PART_SIZE * S3_TRANSFER_THREAD_NUM));
+    Status status;
+    for (int64_t pos = 0; pos < size && status.ok(); pos += buffer.size()) {
+        auto len = std::min(static_cast<int64_t>(buffer.size()), size - pos);
+        status = client.GetObjectRange(object_name, pos, len, buffer.data());
+        if (status.ok() && !fs.write(buffer.data(), len)) {
+            status = Status(SERVER_WRITE_ERROR, "Failed to write file " + tmp_path);
+        }
+    }
+    fs.close();
+
+    if (status.ok() && std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        status = Status(SERVER_WRITE_ERROR, "Failed to rename file " + tmp_path);
+    }
+    if (!status.ok()) {
+        LOG_STORAGE_ERROR_ << "Failed to cache object '" << object_name << "': " << status.message();
+        std::remove(tmp_path.c_str());
+        return status;
+    }
+
+    file = std::make_shared<S3CacheFile>(path, size);
+    InsertItem(object_name, file);
+    LOG_STORAGE_DEBUG_ << "Cached object '" << object_name << "' of " << size << " bytes";
+    return Status::OK();
+}
+
+}  // namespace storage
+}  // namespace milvus
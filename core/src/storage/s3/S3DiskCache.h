@@ -0,0 +1,92 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "cache/CacheMgr.h"
+#include "cache/DataObj.h"
+#include "utils/Status.h"
+
+namespace milvus {
+namespace storage {
+
+constexpr int64_t S3_DISK_CACHE_CAPACITY = 16LL << 30;
+
+// A local copy of an object, the file is removed when the last reader drops it after eviction
+class S3CacheFile : public cache::DataObj {
+ public:
+    S3CacheFile(std::string path, int64_t size);
+
+    ~S3CacheFile();
+
+    const std::string&
+    path() const {
+        return path_;
+    }
+
+    int64_t
+    Size() override {
+        return size_;
+    }
+
+ private:
+    std::string path_;
+    int64_t size_;
+};
+
+using S3CacheFilePtr = std::shared_ptr<S3CacheFile>;
+
+/*
+ * Read-through cache of S3 objects on local disk, between the cpu cache and S3. Objects are downloaded whole with
+ * parallel ranged reads, and evicted in LRU order when the files exceed the capacity.
+ */
+class S3DiskCache : public cache::CacheMgr<cache::DataObjPtr> {
+ private:
+    S3DiskCache();
+
+ public:
+    static S3DiskCache*
+    GetInstance();
+
+    // files left in the directory by a previous run are removed
+    Status
+    SetDirectory(const std::string& path);
+
+    bool
+    Enabled() const {
+        return !directory_.empty() && CacheCapacity() > 0;
+    }
+
+    // concurrent fetches of the same object share one download
+    Status
+    Fetch(const std::string& object_name, S3CacheFilePtr& file);
+
+ private:
+    Status
+    Download(const std::string& object_name, S3CacheFilePtr& file);
+
+ private:
+    std::string directory_;
+    std::atomic<int64_t> file_seq_{0};
+
+    std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_future<Status>> downloading_;
+};
+
+}  // namespace storage
+}  // namespace milvus
@@ -11,6 +11,8 @@
 
 #include "storage/s3/S3IOReader.h"
 #include "storage/s3/S3ClientWrapper.h"
+#include "utils/Exception.h"
+#include "utils/Log.h"
 
 namespace milvus {
 namespace storage {
@@ -19,26 +21,55 @@ bool
 S3IOReader::open(const std::string& name) {
     name_ = name;
     pos_ = 0;
-    return (S3ClientWrapper::GetInstance().GetObjectStr(name_, buffer_).ok());
+
+    auto disk_cache = S3DiskCache::GetInstance();
+    if (disk_cache->Enabled() && disk_cache->Fetch(name_, cache_file_).ok()) {
+        fs_.open(cache_file_->path(), std::ios::in | std::ios::binary);
+        if (fs_.is_open()) {
+            length_ = cache_file_->Size();
+            return true;
+        }
+        cache_file_ = nullptr;
+    }
+
+    return (S3ClientWrapper::GetInstance().HeadObject(name_, length_).ok());
 }
 
 void
 S3IOReader::read(void* ptr, int64_t size) {
-    memcpy(ptr, buffer_.data() + pos_, size);
+    if (cache_file_ != nullptr) {
+        fs_.read(reinterpret_cast<char*>(ptr), size);
+    } else {
+        // the codecs read through the IOReader without a status, a failed range must not look like data
+        auto status = S3ClientWrapper::GetInstance().GetObjectRange(name_, pos_, size, ptr);
+        if (!status.ok()) {
+            std::string err_msg = "Failed to read " + name_ + ": " + status.message();
+            LOG_STORAGE_ERROR_ << err_msg;
+            throw Exception(status.code(), err_msg);
+        }
+    }
+    pos_ += size;
 }
 
 void
 S3IOReader::seekg(int64_t pos) {
     pos_ = pos;
+    if (cache_file_ != nullptr) {
+        fs_.seekg(pos);
+    }
 }
 
 int64_t
 S3IOReader::length() {
-    return buffer_.length();
+    return length_;
 }
 
 void
 S3IOReader::close() {
+    if (fs_.is_open()) {
+        fs_.close();
+    }
+    cache_file_ = nullptr;
 }
 
 }  // namespace storage
@@ -11,9 +11,11 @@
 
 #pragma once
 
+#include <fstream>
 #include <memory>
 #include <string>
 #include "storage/IOReader.h"
+#include "storage/s3/S3DiskCache.h"
 
 namespace milvus {
 namespace storage {
@@ -49,8 +51,12 @@ class S3IOReader : public IOReader {
 
  public:
     std::string name_;
-    std::string buffer_;
-    int64_t pos_;
+    int64_t pos_ = 0;
+    int64_t length_ = 0;
+
+    // reads go to the local copy when the disk cache has one, otherwise to ranged reads of the object
+    S3CacheFilePtr cache_file_;
+    std::ifstream fs_;
 };
 
 using S3IOReaderPtr = std::shared_ptr<S3IOReader>;
@@ -11,6 +11,10 @@
 
 #include "storage/s3/S3IOWriter.h"
 #include "storage/s3/S3ClientWrapper.h"
+#include "storage/s3/S3DiskCache.h"
+#include "utils/Log.h"
+
+#include <utility>
 
 namespace milvus {
 namespace storage {
@@ -20,13 +24,21 @@ S3IOWriter::open(const std::string& name) {
     name_ = name;
     len_ = 0;
     buffer_ = "";
+    upload_id_ = "";
+    multipart_failed_ = false;
+    parts_.clear();
+    etags_.clear();
     return true;
 }
 
 void
 S3IOWriter::write(void* ptr, int64_t size) {
-    buffer_ += std::string(reinterpret_cast<char*>(ptr), size);
+    buffer_.append(reinterpret_cast<char*>(ptr), size);
     len_ += size;
+    // a large chunk is cut into whole parts, the rest waits in the buffer for the next write
+    while (static_cast<int64_t>(buffer_.size()) >= S3_PART_SIZE && !multipart_failed_) {
+        UploadPart();
+    }
 }
 
 int64_t
@@ -36,7 +48,71 @@ S3IOWriter::length() {
 
 void
 S3IOWriter::close() {
-    S3ClientWrapper::GetInstance().PutObjectStr(name_, buffer_);
+    auto& client = S3ClientWrapper::GetInstance();
+    if (upload_id_.empty()) {
+        auto status = client.PutObjectStr(name_, buffer_);
+        if (!status.ok()) {
+            LOG_STORAGE_ERROR_ << "Failed to put " << name_ << ": " << status.message();
+        }
+    } else {
+        // the last part may be smaller than S3_PART_SIZE
+        if (!buffer_.empty()) {
+            UploadPart();
+        }
+        bool ok = WaitParts(0) && client.CompleteMultipartUpload(name_, upload_id_, etags_).ok();
+        if (!ok) {
+            // the uploaded parts are gone with the upload, the object keeps its old content
+            client.AbortMultipartUpload(name_, upload_id_);
+            LOG_STORAGE_ERROR_ << "Multipart upload of " << name_ << " aborted, " << len_ << " bytes are not written";
+        }
+    }
+
+    // the local copy of an overwritten object is stale
+    S3DiskCache::GetInstance()->EraseItem(name_);
+    buffer_ = "";
+}
+
+void
+S3IOWriter::UploadPart() {
+    auto& client = S3ClientWrapper::GetInstance();
+    if (upload_id_.empty() && !client.CreateMultipartUpload(name_, upload_id_).ok()) {
+        // keep buffering, close() puts the whole object
+        upload_id_ = "";
+        multipart_failed_ = true;
+        return;
+    }
+
+    // bound the memory held by the parts in flight
+    WaitParts(S3_TRANSFER_THREAD_NUM);
+
+    std::shared_ptr<std::string> data;
+    if (static_cast<int64_t>(buffer_.size()) > S3_PART_SIZE) {
+        data = std::make_shared<std::string>(buffer_, 0, S3_PART_SIZE);
+        buffer_.erase(0, S3_PART_SIZE);
+    } else {
+        data = std::make_shared<std::string>(std::move(buffer_));
+        buffer_ = "";
+    }
+    int part_number = parts_.size() + 1;
+    auto upload = [&client, data, part_number](const std::string& name, const std::string& upload_id) {
+        std::string etag;
+        client.UploadPart(name, upload_id, part_number, *data, etag);
+        return etag;
+    };
+    parts_.emplace_back(client.GetTransferPool()->Enqueue(upload, name_, upload_id_));
+}
+
+bool
+S3IOWriter::WaitParts(size_t max_pending) {
+    while (parts_.size() - etags_.size() > max_pending) {
+        etags_.emplace_back(parts_[etags_.size()].get());
+    }
+    for (auto& etag : etags_) {
+        if (etag.empty()) {
+            return false;
+        }
+    }
+    return true;
 }
 
 }  // namespace storage
@@ -11,8 +11,10 @@
 
 #pragma once
 
+#include <future>
 #include <memory>
 #include <string>
+#include <vector>
 #include "storage/IOWriter.h"
 
 namespace milvus {
@@ -44,10 +46,25 @@ class S3IOWriter : public IOWriter {
     void
     close() override;
 
+ private:
+    // upload at most S3_PART_SIZE bytes of the buffer as the next part of a multipart upload, started by the first part
+    void
+    UploadPart();
+
+    // wait until at most max_pending parts are in flight, false if a part failed
+    bool
+    WaitParts(size_t max_pending);
+
  public:
     std::string name_;
     int64_t len_;
     std::string buffer_;
+
+    // objects larger than one part are uploaded in parts while they are written
+    std::string upload_id_;
+    bool multipart_failed_ = false;
+    std::vector<std::future<std::string>> parts_;
+    std::vector<std::string> etags_;
 };
 
 using S3IOWriterPtr = std::shared_ptr<S3IOWriter>;
@@ -13,38 +13,51 @@
 
 #include <cstdarg>
 #include <cstdio>
-#include <memory>
 #include <string>
 
 namespace milvus {
 
+std::atomic<uint32_t> enabled_log_levels(UINT32_MAX);
+
+namespace {
+// filled on first use, pthread_getname_np reads procfs
+thread_local std::string thread_name;
+}  // namespace
+
 std::string
 LogOut(const char* pattern, ...) {
-    size_t len = strnlen(pattern, 1024) + 256;
-    auto str_p = std::make_unique<char[]>(len);
-    memset(str_p.get(), 0, len);
-
+    char buffer[256];
     va_list vl;
     va_start(vl, pattern);
-    vsnprintf(str_p.get(), len, pattern, vl);
+    int len = vsnprintf(buffer, sizeof(buffer), pattern, vl);
     va_end(vl);
+    if (len < 0) {
+        return std::string();
+    }
+    if (static_cast<size_t>(len) < sizeof(buffer)) {
+        return std::string(buffer, len);
+    }
 
-    return std::string(str_p.get());
+    std::string str(len, '\0');
+    va_start(vl, pattern);
+    vsnprintf(&str[0], len + 1, pattern, vl);
+    va_end(vl);
+    return str;
 }
 
 void
 SetThreadName(const std::string& name) {
     pthread_setname_np(pthread_self(), name.c_str());
+    thread_name.clear();
 }
 
-std::string
+const std::string&
 GetThreadName() {
-    std::string thread_name = "unamed";
-    char name[16];
-    size_t len = 16;
-    auto err = pthread_getname_np(pthread_self(), name, len);
-    if (not err) {
-        thread_name = name;
+    if (thread_name.empty()) {
+        char name[16];
+        size_t len = 16;
+        auto err = pthread_getname_np(pthread_self(), name, len);
+        thread_name = err ? "unamed" : name;
     }
 
     return thread_name;
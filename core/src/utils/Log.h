@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <string>
 
 #include "easyloggingpp/easylogging++.h"
@@ -20,27 +22,49 @@ namespace milvus {
 /*
  * Please use LOG_MODULE_LEVEL_C macro in member function of class
  * and LOG_MODULE_LEVEL_ macro in other functions.
+ *
+ * The level is checked before anything is formatted, a disabled level costs one atomic load.
  */
 
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// el::Level values are single bits, a level is enabled when its bit is set, see InitLog
+extern std::atomic<uint32_t> enabled_log_levels;
+
+inline bool
+LogLevelEnabled(el::Level level) {
+    return (enabled_log_levels.load(std::memory_order_relaxed) & static_cast<uint32_t>(level)) != 0;
+}
+
+// gives the whole logging expression the type void, so it fits in the ternary below
+struct LogVoidify {
+    template <typename T>
+    void
+    operator&(const T&) {
+    }
+};
+
+#define MILVUS_LOG_(LEVEL, LEVEL_ENUM) \
+    !::milvus::LogLevelEnabled(el::Level::LEVEL_ENUM) ? (void)0 : ::milvus::LogVoidify() & LOG(LEVEL)
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 #define SERVER_MODULE_NAME "SERVER"
 #define SERVER_MODULE_CLASS_FUNCTION \
     LogOut("[%s][%s::%s][%s] ", SERVER_MODULE_NAME, (typeid(*this).name()), __FUNCTION__, GetThreadName().c_str())
 #define SERVER_MODULE_FUNCTION LogOut("[%s][%s][%s] ", SERVER_MODULE_NAME, __FUNCTION__, GetThreadName().c_str())
 
-#define LOG_SERVER_TRACE_C LOG(TRACE) << SERVER_MODULE_CLASS_FUNCTION
-#define LOG_SERVER_DEBUG_C LOG(DEBUG) << SERVER_MODULE_CLASS_FUNCTION
-#define LOG_SERVER_INFO_C LOG(INFO) << SERVER_MODULE_CLASS_FUNCTION
-#define LOG_SERVER_WARNING_C LOG(WARNING) << SERVER_MODULE_CLASS_FUNCTION
-#define LOG_SERVER_ERROR_C LOG(ERROR) << SERVER_MODULE_CLASS_FUNCTION
-#define LOG_SERVER_FATAL_C LOG(FATAL) << SERVER_MODULE_CLASS_FUNCTION
+#define LOG_SERVER_TRACE_C MILVUS_LOG_(TRACE, Trace) << SERVER_MODULE_CLASS_FUNCTION
+#define LOG_SERVER_DEBUG_C MILVUS_LOG_(DEBUG, Debug) << SERVER_MODULE_CLASS_FUNCTION
+#define LOG_SERVER_INFO_C MILVUS_LOG_(INFO, Info) << SERVER_MODULE_CLASS_FUNCTION
+#define LOG_SERVER_WARNING_C MILVUS_LOG_(WARNING, Warning) << SERVER_MODULE_CLASS_FUNCTION
+#define LOG_SERVER_ERROR_C MILVUS_LOG_(ERROR, Error) << SERVER_MODULE_CLASS_FUNCTION
+#define LOG_SERVER_FATAL_C MILVUS_LOG_(FATAL, Fatal) << SERVER_MODULE_CLASS_FUNCTION
 
-#define LOG_SERVER_TRACE_ LOG(TRACE) << SERVER_MODULE_FUNCTION
-#define LOG_SERVER_DEBUG_ LOG(DEBUG) << SERVER_MODULE_FUNCTION
-#define LOG_SERVER_INFO_ LOG(INFO) << SERVER_MODULE_FUNCTION
-#define LOG_SERVER_WARNING_ LOG(WARNING) << SERVER_MODULE_FUNCTION
-#define LOG_SERVER_ERROR_ LOG(ERROR) << SERVER_MODULE_FUNCTION
-#define LOG_SERVER_FATAL_ LOG(FATAL) << SERVER_MODULE_FUNCTION
+#define LOG_SERVER_TRACE_ MILVUS_LOG_(TRACE, Trace) << SERVER_MODULE_FUNCTION
+#define LOG_SERVER_DEBUG_ MILVUS_LOG_(DEBUG, Debug) << SERVER_MODULE_FUNCTION
+#define LOG_SERVER_INFO_ MILVUS_LOG_(INFO, Info) << SERVER_MODULE_FUNCTION
+#define LOG_SERVER_WARNING_ MILVUS_LOG_(WARNING, Warning) << SERVER_MODULE_FUNCTION
+#define LOG_SERVER_ERROR_ MILVUS_LOG_(ERROR, Error) << SERVER_MODULE_FUNCTION
+#define LOG_SERVER_FATAL_ MILVUS_LOG_(FATAL, Fatal) << SERVER_MODULE_FUNCTION
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 #define ENGINE_MODULE_NAME "ENGINE"
@@ -48,19 +72,19 @@ namespace milvus {
     LogOut("[%s][%s::%s][%s] ", ENGINE_MODULE_NAME, (typeid(*this).name()), __FUNCTION__, GetThreadName().c_str())
 #define ENGINE_MODULE_FUNCTION LogOut("[%s][%s][%s] ", ENGINE_MODULE_NAME, __FUNCTION__, GetThreadName().c_str())
 
-#define LOG_ENGINE_TRACE_C LOG(TRACE) << ENGINE_MODULE_CLASS_FUNCTION
-#define LOG_ENGINE_DEBUG_C LOG(DEBUG) << ENGINE_MODULE_CLASS_FUNCTION
-#define LOG_ENGINE_INFO_C LOG(INFO) << ENGINE_MODULE_CLASS_FUNCTION
-#define LOG_ENGINE_WARNING_C LOG(WARNING) << ENGINE_MODULE_CLASS_FUNCTION
-#define LOG_ENGINE_ERROR_C LOG(ERROR) << ENGINE_MODULE_CLASS_FUNCTION
-#define LOG_ENGINE_FATAL_C LOG(FATAL) << ENGINE_MODULE_CLASS_FUNCTION
+#define LOG_ENGINE_TRACE_C MILVUS_LOG_(TRACE, Trace) << ENGINE_MODULE_CLASS_FUNCTION
+#define LOG_ENGINE_DEBUG_C MILVUS_LOG_(DEBUG, Debug) << ENGINE_MODULE_CLASS_FUNCTION
+#define LOG_ENGINE_INFO_C MILVUS_LOG_(INFO, Info) << ENGINE_MODULE_CLASS_FUNCTION
+#define LOG_ENGINE_WARNING_C MILVUS_LOG_(WARNING, Warning) << ENGINE_MODULE_CLASS_FUNCTION
+#define LOG_ENGINE_ERROR_C MILVUS_LOG_(ERROR, Error) << ENGINE_MODULE_CLASS_FUNCTION
+#define LOG_ENGINE_FATAL_C MILVUS_LOG_(FATAL, Fatal) << ENGINE_MODULE_CLASS_FUNCTION
 
-#define LOG_ENGINE_TRACE_ LOG(TRACE) << ENGINE_MODULE_FUNCTION
-#define LOG_ENGINE_DEBUG_ LOG(DEBUG) << ENGINE_MODULE_FUNCTION
-#define LOG_ENGINE_INFO_ LOG(INFO) << ENGINE_MODULE_FUNCTION
-#define LOG_ENGINE_WARNING_ LOG(WARNING) << ENGINE_MODULE_FUNCTION
-#define LOG_ENGINE_ERROR_ LOG(ERROR) << ENGINE_MODULE_FUNCTION
-#define LOG_ENGINE_FATAL_ LOG(FATAL) << ENGINE_MODULE_FUNCTION
+#define LOG_ENGINE_TRACE_ MILVUS_LOG_(TRACE, Trace) << ENGINE_MODULE_FUNCTION
+#define LOG_ENGINE_DEBUG_ MILVUS_LOG_(DEBUG, Debug) << ENGINE_MODULE_FUNCTION
+#define LOG_ENGINE_INFO_ MILVUS_LOG_(INFO, Info) << ENGINE_MODULE_FUNCTION
+#define LOG_ENGINE_WARNING_ MILVUS_LOG_(WARNING, Warning) << ENGINE_MODULE_FUNCTION
+#define LOG_ENGINE_ERROR_ MILVUS_LOG_(ERROR, Error) << ENGINE_MODULE_FUNCTION
+#define LOG_ENGINE_FATAL_ MILVUS_LOG_(FATAL, Fatal) << ENGINE_MODULE_FUNCTION
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 #define WRAPPER_MODULE_NAME "WRAPPER"
@@ -68,19 +92,19 @@ namespace milvus {
     LogOut("[%s][%s::%s][%s] ", WRAPPER_MODULE_NAME, (typeid(*this).name()), __FUNCTION__, GetThreadName().c_str())
 #define WRAPPER_MODULE_FUNCTION LogOut("[%s][%s][%s] ", WRAPPER_MODULE_NAME, __FUNCTION__, GetThreadName().c_str())
 
-#define LOG_WRAPPER_TRACE_C LOG(TRACE) << WRAPPER_MODULE_CLASS_FUNCTION
-#define LOG_WRAPPER_DEBUG_C LOG(DEBUG) << WRAPPER_MODULE_CLASS_FUNCTION
-#define LOG_WRAPPER_INFO_C LOG(INFO) << WRAPPER_MODULE_CLASS_FUNCTION
-#define LOG_WRAPPER_WARNING_C LOG(WARNING) << WRAPPER_MODULE_CLASS_FUNCTION
-#define LOG_WRAPPER_ERROR_C LOG(ERROR) << WRAPPER_MODULE_CLASS_FUNCTION
-#define LOG_WRAPPER_FATAL_C LOG(FATAL) << WRAPPER_MODULE_CLASS_FUNCTION
+#define LOG_WRAPPER_TRACE_C MILVUS_LOG_(TRACE, Trace) << WRAPPER_MODULE_CLASS_FUNCTION
+#define LOG_WRAPPER_DEBUG_C MILVUS_LOG_(DEBUG, Debug) << WRAPPER_MODULE_CLASS_FUNCTION
+#define LOG_WRAPPER_INFO_C MILVUS_LOG_(INFO, Info) << WRAPPER_MODULE_CLASS_FUNCTION
+#define LOG_WRAPPER_WARNING_C MILVUS_LOG_(WARNING, Warning) << WRAPPER_MODULE_CLASS_FUNCTION
+#define LOG_WRAPPER_ERROR_C MILVUS_LOG_(ERROR, Error) << WRAPPER_MODULE_CLASS_FUNCTION
+#define LOG_WRAPPER_FATAL_C MILVUS_LOG_(FATAL, Fatal) << WRAPPER_MODULE_CLASS_FUNCTION
 
-#define LOG_WRAPPER_TRACE_ LOG(TRACE) << WRAPPER_MODULE_FUNCTION
-#define LOG_WRAPPER_DEBUG_ LOG(DEBUG) << WRAPPER_MODULE_FUNCTION
-#define LOG_WRAPPER_INFO_ LOG(INFO) << WRAPPER_MODULE_FUNCTION
-#define LOG_WRAPPER_WARNING_ LOG(WARNING) << WRAPPER_MODULE_FUNCTION
-#define LOG_WRAPPER_ERROR_ LOG(ERROR) << WRAPPER_MODULE_FUNCTION
-#define LOG_WRAPPER_FATAL_ LOG(FATAL) << WRAPPER_MODULE_FUNCTION
+#define LOG_WRAPPER_TRACE_ MILVUS_LOG_(TRACE, Trace) << WRAPPER_MODULE_FUNCTION
+#define LOG_WRAPPER_DEBUG_ MILVUS_LOG_(DEBUG, Debug) << WRAPPER_MODULE_FUNCTION
+#define LOG_WRAPPER_INFO_ MILVUS_LOG_(INFO, Info) << WRAPPER_MODULE_FUNCTION
+#define LOG_WRAPPER_WARNING_ MILVUS_LOG_(WARNING, Warning) << WRAPPER_MODULE_FUNCTION
+#define LOG_WRAPPER_ERROR_ MILVUS_LOG_(ERROR, Error) << WRAPPER_MODULE_FUNCTION
+#define LOG_WRAPPER_FATAL_ MILVUS_LOG_(FATAL, Fatal) << WRAPPER_MODULE_FUNCTION
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 #define STORAGE_MODULE_NAME "STORAGE"
@@ -88,19 +112,19 @@ namespace milvus {
     LogOut("[%s][%s::%s][%s] ", STORAGE_MODULE_NAME, (typeid(*this).name()), __FUNCTION__, GetThreadName().c_str())
 #define STORAGE_MODULE_FUNCTION LogOut("[%s][%s][%s] ", STORAGE_MODULE_NAME, __FUNCTION__, GetThreadName().c_str())
 
-#define LOG_STORAGE_TRACE_C LOG(TRACE) << STORAGE_MODULE_CLASS_FUNCTION
-#define LOG_STORAGE_DEBUG_C LOG(DEBUG) << STORAGE_MODULE_CLASS_FUNCTION
-#define LOG_STORAGE_INFO_C LOG(INFO) << STORAGE_MODULE_CLASS_FUNCTION
-#define LOG_STORAGE_WARNING_C LOG(WARNING) << STORAGE_MODULE_CLASS_FUNCTION
-#define LOG_STORAGE_ERROR_C LOG(ERROR) << STORAGE_MODULE_CLASS_FUNCTION
-#define LOG_STORAGE_FATAL_C LOG(FATAL) << STORAGE_MODULE_CLASS_FUNCTION
+#define LOG_STORAGE_TRACE_C MILVUS_LOG_(TRACE, Trace) << STORAGE_MODULE_CLASS_FUNCTION
+#define LOG_STORAGE_DEBUG_C MILVUS_LOG_(DEBUG, Debug) << STORAGE_MODULE_CLASS_FUNCTION
+#define LOG_STORAGE_INFO_C MILVUS_LOG_(INFO, Info) << STORAGE_MODULE_CLASS_FUNCTION
+#define LOG_STORAGE_WARNING_C MILVUS_LOG_(WARNING, Warning) << STORAGE_MODULE_CLASS_FUNCTION
+#define LOG_STORAGE_ERROR_C MILVUS_LOG_(ERROR, Error) << STORAGE_MODULE_CLASS_FUNCTION
+#define LOG_STORAGE_FATAL_C MILVUS_LOG_(FATAL, Fatal) << STORAGE_MODULE_CLASS_FUNCTION
 
-#define LOG_STORAGE_TRACE_ LOG(TRACE) << STORAGE_MODULE_FUNCTION
-#define LOG_STORAGE_DEBUG_ LOG(DEBUG) << STORAGE_MODULE_FUNCTION
-#define LOG_STORAGE_INFO_ LOG(INFO) << STORAGE_MODULE_FUNCTION
-#define LOG_STORAGE_WARNING_ LOG(WARNING) << STORAGE_MODULE_FUNCTION
-#define LOG_STORAGE_ERROR_ LOG(ERROR) << STORAGE_MODULE_FUNCTION
-#define LOG_STORAGE_FATAL_ LOG(FATAL) << STORAGE_MODULE_FUNCTION
+#define LOG_STORAGE_TRACE_ MILVUS_LOG_(TRACE, Trace) << STORAGE_MODULE_FUNCTION
+#define LOG_STORAGE_DEBUG_ MILVUS_LOG_(DEBUG, Debug) << STORAGE_MODULE_FUNCTION
+#define LOG_STORAGE_INFO_ MILVUS_LOG_(INFO, Info) << STORAGE_MODULE_FUNCTION
+#define LOG_STORAGE_WARNING_ MILVUS_LOG_(WARNING, Warning) << STORAGE_MODULE_FUNCTION
+#define LOG_STORAGE_ERROR_ MILVUS_LOG_(ERROR, Error) << STORAGE_MODULE_FUNCTION
+#define LOG_STORAGE_FATAL_ MILVUS_LOG_(FATAL, Fatal) << STORAGE_MODULE_FUNCTION
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 #define WAL_MODULE_NAME "WAL"
@@ -108,19 +132,19 @@ namespace milvus {
     LogOut("[%s][%s::%s][%s] ", WAL_MODULE_NAME, (typeid(*this).name()), __FUNCTION__, GetThreadName().c_str())
 #define WAL_MODULE_FUNCTION LogOut("[%s][%s][%s] ", WAL_MODULE_NAME, __FUNCTION__, GetThreadName().c_str())
 
-#define LOG_WAL_TRACE_C LOG(TRACE) << WAL_MODULE_CLASS_FUNCTION
-#define LOG_WAL_DEBUG_C LOG(DEBUG) << WAL_MODULE_CLASS_FUNCTION
-#define LOG_WAL_INFO_C LOG(INFO) << WAL_MODULE_CLASS_FUNCTION
-#define LOG_WAL_WARNING_C LOG(WARNING) << WAL_MODULE_CLASS_FUNCTION
-#define LOG_WAL_ERROR_C LOG(ERROR) << WAL_MODULE_CLASS_FUNCTION
-#define LOG_WAL_FATAL_C LOG(FATAL) << WAL_MODULE_CLASS_FUNCTION
+#define LOG_WAL_TRACE_C MILVUS_LOG_(TRACE, Trace) << WAL_MODULE_CLASS_FUNCTION
+#define LOG_WAL_DEBUG_C MILVUS_LOG_(DEBUG, Debug) << WAL_MODULE_CLASS_FUNCTION
+#define LOG_WAL_INFO_C MILVUS_LOG_(INFO, Info) << WAL_MODULE_CLASS_FUNCTION
+#define LOG_WAL_WARNING_C MILVUS_LOG_(WARNING, Warning) << WAL_MODULE_CLASS_FUNCTION
+#define LOG_WAL_ERROR_C MILVUS_LOG_(ERROR, Error) << WAL_MODULE_CLASS_FUNCTION
+#define LOG_WAL_FATAL_C MILVUS_LOG_(FATAL, Fatal) << WAL_MODULE_CLASS_FUNCTION
 
-#define LOG_WAL_TRACE_ LOG(TRACE) << WAL_MODULE_FUNCTION
-#define LOG_WAL_DEBUG_ LOG(DEBUG) << WAL_MODULE_FUNCTION
-#define LOG_WAL_INFO_ LOG(INFO) << WAL_MODULE_FUNCTION
-#define LOG_WAL_WARNING_ LOG(WARNING) << WAL_MODULE_FUNCTION
-#define LOG_WAL_ERROR_ LOG(ERROR) << WAL_MODULE_FUNCTION
-#define LOG_WAL_FATAL_ LOG(FATAL) << WAL_MODULE_FUNCTION
+#define LOG_WAL_TRACE_ MILVUS_LOG_(TRACE, Trace) << WAL_MODULE_FUNCTION
+#define LOG_WAL_DEBUG_ MILVUS_LOG_(DEBUG, Debug) << WAL_MODULE_FUNCTION
+#define LOG_WAL_INFO_ MILVUS_LOG_(INFO, Info) << WAL_MODULE_FUNCTION
+#define LOG_WAL_WARNING_ MILVUS_LOG_(WARNING, Warning) << WAL_MODULE_FUNCTION
+#define LOG_WAL_ERROR_ MILVUS_LOG_(ERROR, Error) << WAL_MODULE_FUNCTION
+#define LOG_WAL_FATAL_ MILVUS_LOG_(FATAL, Fatal) << WAL_MODULE_FUNCTION
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 std::string
@@ -129,7 +153,7 @@ LogOut(const char* pattern, ...);
 void
 SetThreadName(const std::string& name);
 
-std::string
+const std::string&
 GetThreadName();
 
 }  // namespace milvus
@@ -13,8 +13,16 @@
 
 #include <fiu-local.h>
 #include <libgen.h>
+#include <algorithm>
 #include <cctype>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <set>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include <yaml-cpp/yaml.h>
 #include <boost/filesystem.hpp>
@@ -33,6 +41,179 @@ static int error_idx = 0;
 static int fatal_idx = 0;
 static int64_t logs_delete_exceeds = 1;
 static bool enable_log_delete = false;
+
+constexpr const char* ASYNC_LOG_CALLBACK_ID = "AsyncLogDispatchCallback";
+constexpr const char* DEFAULT_LOG_CALLBACK_ID = "DefaultLogDispatchCallback";
+
+class AsyncLogSink {
+ public:
+    static AsyncLogSink&
+    GetInstance() {
+        static AsyncLogSink sink;
+        return sink;
+    }
+
+    ~AsyncLogSink() {
+        StopWorker();
+    }
+
+    bool
+    StartWorker(int64_t capacity) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (running_) {
+            return false;
+        }
+        ring_.resize(std::max<int64_t>(capacity, 1));
+        head_ = 0;
+        size_ = 0;
+        running_ = true;
+        worker_ = std::thread(&AsyncLogSink::Run, this);
+        return true;
+    }
+
+    bool
+    StopWorker() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!running_) {
+                return false;
+            }
+            running_ = false;
+        }
+        not_empty_.notify_one();
+        worker_.join();
+        return true;
+    }
+
+    void
+    Push(el::Logger* logger, el::Level level, std::string&& line) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!running_) {
+                return;
+            }
+            if (size_ == ring_.size()) {
+                ++dropped_;
+                return;
+            }
+            auto& item = ring_[(head_ + size_) % ring_.size()];
+            item.logger_ = logger;
+            item.level_ = level;
+            item.line_ = std::move(line);
+            ++size_;
+            ++pushed_;
+        }
+        not_empty_.notify_one();
+    }
+
+    void
+    Flush() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto target = pushed_;
+        written_cv_.wait(lock, [&] { return written_ >= target || !running_; });
+    }
+
+ private:
+    struct LogLine {
+        el::Logger* logger_ = nullptr;
+        el::Level level_ = el::Level::Unknown;
+        std::string line_;
+    };
+
+    void
+    Run() {
+        SetThreadName("asynclog_thread");
+        std::vector<LogLine> batch;
+        while (true) {
+            int64_t dropped = 0;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                not_empty_.wait(lock, [&] { return size_ > 0 || !running_; });
+                if (size_ == 0) {
+                    break;
+                }
+                batch.clear();
+                for (; size_ > 0; --size_) {
+                    batch.emplace_back(std::move(ring_[head_]));
+                    head_ = (head_ + 1) % ring_.size();
+                }
+                std::swap(dropped, dropped_);
+            }
+
+            Write(batch, dropped);
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                written_ += batch.size();
+            }
+            written_cv_.notify_all();
+        }
+    }
+
+    void
+    Write(std::vector<LogLine>& batch, int64_t dropped) {
+        if (dropped > 0) {
+            LogLine line;
+            line.logger_ = el::Loggers::getLogger("default");
+            line.level_ = el::Level::Warning;
+            line.line_ = "[ASYNC LOG] Queue is full, " + std::to_string(dropped) + " log lines dropped\n";
+            batch.emplace_back(std::move(line));
+        }
+
+        std::set<std::pair<el::Logger*, el::Level>> touched;
+        for (auto& line : batch) {
+            auto typed_configurations = line.logger_->typedConfigurations();
+            if (typed_configurations->toFile(line.level_)) {
+                auto fs = typed_configurations->fileStream(line.level_);
+                if (fs != nullptr) {
+                    fs->write(line.line_.c_str(), line.line_.size());
+                    touched.emplace(line.logger_, line.level_);
+                }
+            }
+            if (typed_configurations->toStandardOutput(line.level_)) {
+                std::cout << line.line_;
+            }
+        }
+
+        // the worker is the only writer, so it also rolls the files over
+        for (auto& item : touched) {
+            auto fs = item.first->typedConfigurations()->fileStream(item.second);
+            if (fs != nullptr) {
+                fs->flush();
+            }
+            el::Helpers::validateFileRolling(item.first, item.second);
+        }
+    }
+
+ private:
+    std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable written_cv_;
+    std::vector<LogLine> ring_;
+    size_t head_ = 0;
+    size_t size_ = 0;
+    uint64_t pushed_ = 0;
+    uint64_t written_ = 0;
+    int64_t dropped_ = 0;
+    bool running_ = false;
+    std::thread worker_;
+};
+
+class AsyncLogDispatchCallback : public el::LogDispatchCallback {
+ protected:
+    void
+    handle(const el::LogDispatchData* data) override {
+        if (data->dispatchAction() != el::base::DispatchAction::NormalLog) {
+            return;
+        }
+        auto message = data->logMessage();
+        auto logger = message->logger();
+        AsyncLogSink::GetInstance().Push(logger, message->level(), logger->logBuilder()->build(message, true));
+        if (message->level() == el::Level::Fatal) {
+            AsyncLogSink::GetInstance().Flush();
+        }
+    }
+};
 }  // namespace
 
 // TODO(yzb) : change the easylogging library to get the log level from parameter rather than filename
@@ -220,9 +401,48 @@ InitLog(bool trace_enable, bool debug_enable, bool info_enable, bool warning_ena
 
     el::Loggers::reconfigureLogger("default", defaultConf);
 
+    uint32_t disabled_levels = 0;
+    disabled_levels |= trace_enable ? 0 : static_cast<uint32_t>(el::Level::Trace);
+    disabled_levels |= debug_enable ? 0 : static_cast<uint32_t>(el::Level::Debug);
+    disabled_levels |= info_enable ? 0 : static_cast<uint32_t>(el::Level::Info);
+    disabled_levels |= warning_enable ? 0 : static_cast<uint32_t>(el::Level::Warning);
+    disabled_levels |= error_enable ? 0 : static_cast<uint32_t>(el::Level::Error);
+    disabled_levels |= fatal_enable ? 0 : static_cast<uint32_t>(el::Level::Fatal);
+    enabled_log_levels.store(~disabled_levels);
+
     return Status::OK();
 }
 
+void
+StartAsyncLog(int64_t queue_capacity) {
+    // dispatching holds the global lock while it walks the callbacks
+    el::base::threading::ScopedLock lock(ELPP->lock());
+    if (!AsyncLogSink::GetInstance().StartWorker(queue_capacity)) {
+        return;
+    }
+    el::Helpers::installLogDispatchCallback<AsyncLogDispatchCallback>(ASYNC_LOG_CALLBACK_ID);
+    el::Helpers::uninstallLogDispatchCallback<el::base::DefaultLogDispatchCallback>(DEFAULT_LOG_CALLBACK_ID);
+    // files are rolled over by the writer thread
+    el::Loggers::removeFlag(el::LoggingFlag::StrictLogFileSizeCheck);
+}
+
+void
+StopAsyncLog() {
+    el::base::threading::ScopedLock lock(ELPP->lock());
+    el::Helpers::uninstallLogDispatchCallback<AsyncLogDispatchCallback>(ASYNC_LOG_CALLBACK_ID);
+    // the queued lines are written before anyone else touches the files
+    if (!AsyncLogSink::GetInstance().StopWorker()) {
+        return;
+    }
+    el::Helpers::installLogDispatchCallback<el::base::DefaultLogDispatchCallback>(DEFAULT_LOG_CALLBACK_ID);
+    el::Loggers::addFlag(el::LoggingFlag::StrictLogFileSizeCheck);
+}
+
+void
+FlushAsyncLog() {
+    AsyncLogSink::GetInstance().Flush();
+}
+
 void
 LogConfigInFile(const std::string& path) {
     // TODO(yhz): Check if file exists
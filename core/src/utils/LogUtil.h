@@ -26,6 +26,19 @@ InitLog(bool trace_enable, bool debug_enable, bool info_enable, bool warning_ena
 void
 RolloutHandler(const char* filename, std::size_t size, el::Level level);
 
+// Log lines are formatted by the calling thread and queued, one background thread writes them to the log files.
+// When the queue is full new lines are dropped and counted, logging never waits for disk.
+void
+StartAsyncLog(int64_t queue_capacity = 8192);
+
+// Writes out the queued lines and switches back to writing in the calling thread.
+void
+StopAsyncLog();
+
+// Waits until the lines queued so far are written.
+void
+FlushAsyncLog();
+
 #define SHOW_LOCATION
 #ifdef SHOW_LOCATION
 #define LOCATION_INFO "[" << sql::server::GetFileName(__FILE__) << ":" << __LINE__ << "] "
@@ -0,0 +1,236 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "utils/TaskExecutor.h"
+#include "utils/Log.h"
+
+#include <fiu-local.h>
+#include <pthread.h>
+#include <sched.h>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace milvus {
+
+namespace {
+
+constexpr int64_t IDLE_SPIN_ROUNDS = 128;
+
+thread_local TaskExecutor* current_executor = nullptr;
+thread_local size_t current_worker = 0;
+
+// cpus of every NUMA node, empty without NUMA information
+std::vector<std::vector<int>>
+NumaNodeCpus() {
+    std::vector<std::vector<int>> nodes;
+    for (int node = 0;; ++node) {
+        std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        if (!file.is_open()) {
+            break;
+        }
+
+        // such as "0-15,32-47"
+        std::string cpu_list, range;
+        std::getline(file, cpu_list);
+        std::stringstream ss(cpu_list);
+        std::vector<int> cpus;
+        while (std::getline(ss, range, ',')) {
+            if (range.empty()) {
+                continue;
+            }
+            auto dash = range.find('-');
+            int first = std::stoi(range.substr(0, dash));
+            int last = (dash == std::string::npos) ? first : std::stoi(range.substr(dash + 1));
+            for (int cpu = first; cpu <= last; ++cpu) {
+                cpus.push_back(cpu);
+            }
+        }
+        if (!cpus.empty()) {
+            nodes.emplace_back(std::move(cpus));
+        }
+    }
+    return nodes;
+}
+
+}  // namespace
+
+TaskExecutor::TaskExecutor(size_t threads, size_t queue_size, bool pin_threads)
+    : max_queue_size_(std::max<size_t>(queue_size, 1)), pin_threads_(pin_threads) {
+    threads = std::max<size_t>(threads, 1);
+    for (size_t i = 0; i < threads; ++i) {
+        workers_.emplace_back(std::make_unique<Worker>());
+    }
+    // every worker may steal from the others, start them when all exist
+    for (size_t i = 0; i < threads; ++i) {
+        workers_[i]->thread_ = std::thread(&TaskExecutor::Run, this, i);
+    }
+}
+
+TaskExecutor::~TaskExecutor() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stop_ = true;
+    }
+    wake_cv_.notify_all();
+    room_cv_.notify_all();
+    for (auto& worker : workers_) {
+        worker->thread_.join();
+    }
+}
+
+void
+TaskExecutor::Push(TaskPriority priority, Task&& task) {
+    fiu_do_on("TaskExecutor.enqueue.stop_is_true", stop_ = true);
+
+    // a worker never waits for room, the room may only be made by itself
+    bool on_worker = (current_executor == this);
+    if (!on_worker && pending_.load() >= max_queue_size_) {
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        ++waiting_producers_;
+        room_cv_.wait(lock, [this] { return stop_.load() || pending_.load() < max_queue_size_; });
+        --waiting_producers_;
+    }
+    // don't allow enqueueing after stopping the executor
+    if (stop_) {
+        throw std::runtime_error("enqueue on stopped TaskExecutor");
+    }
+
+    // counted before it is published, a thief taking it at once must not take pending_ below zero
+    ++pending_;
+    auto index = on_worker ? current_worker : next_worker_.fetch_add(1) % workers_.size();
+    auto& worker = *workers_[index];
+    auto p = static_cast<size_t>(priority);
+    {
+        std::lock_guard<std::mutex> lock(worker.mutex_);
+        worker.tasks_[p].emplace_back(std::move(task));
+        ++worker.sizes_[p];
+    }
+
+    // pairs with the sleeping worker, which counts itself before it checks pending_
+    if (sleeping_.load() > 0) {
+        { std::lock_guard<std::mutex> lock(sleep_mutex_); }
+        wake_cv_.notify_one();
+    }
+}
+
+bool
+TaskExecutor::Take(Worker& worker, size_t priority, bool own, Task& task) {
+    if (worker.sizes_[priority].load() == 0) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(worker.mutex_);
+        auto& tasks = worker.tasks_[priority];
+        if (tasks.empty()) {
+            return false;
+        }
+        if (own) {
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        } else {
+            task = std::move(tasks.back());
+            tasks.pop_back();
+        }
+        --worker.sizes_[priority];
+    }
+
+    // pairs with the producer waiting for room, which counts itself before it checks pending_
+    if (--pending_ < max_queue_size_ && waiting_producers_.load() > 0) {
+        { std::lock_guard<std::mutex> lock(sleep_mutex_); }
+        room_cv_.notify_one();
+    }
+    return true;
+}
+
+bool
+TaskExecutor::Pop(size_t self, Task& task) {
+    // a task of higher priority anywhere goes before the lower ones of this worker
+    for (size_t p = 0; p < TASK_PRIORITY_NUM; ++p) {
+        if (Take(*workers_[self], p, true, task)) {
+            return true;
+        }
+        for (size_t i = 1; i < workers_.size(); ++i) {
+            if (Take(*workers_[(self + i) % workers_.size()], p, false, task)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void
+TaskExecutor::Run(size_t self) {
+    current_executor = this;
+    current_worker = self;
+    if (pin_threads_) {
+        PinThread(self);
+    }
+
+    Task task;
+    while (true) {
+        if (Pop(self, task)) {
+            task();
+            task = nullptr;
+            continue;
+        }
+        if (stop_ && pending_.load() == 0) {
+            return;
+        }
+
+        for (int64_t i = 0; i < IDLE_SPIN_ROUNDS && pending_.load() == 0 && !stop_; ++i) {
+            std::this_thread::yield();
+        }
+        if (pending_.load() > 0 || stop_) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        ++sleeping_;
+        wake_cv_.wait(lock, [this] { return stop_.load() || pending_.load() > 0; });
+        --sleeping_;
+    }
+}
+
+void
+TaskExecutor::PinThread(size_t self) {
+    static const auto nodes = NumaNodeCpus();
+    if (nodes.size() <= 1) {
+        return;
+    }
+
+    // stay inside the cpus this process may use
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        return;
+    }
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (auto cpu : nodes[self % nodes.size()]) {
+        if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed)) {
+            CPU_SET(cpu, &cpu_set);
+        }
+    }
+    if (CPU_COUNT(&cpu_set) == 0) {
+        return;
+    }
+
+    auto err = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+    if (err != 0) {
+        LOG_SERVER_WARNING_ << "Failed to pin executor worker " << self << " to NUMA node "
+                            << self % nodes.size() << ", error " << err;
+    }
+}
+
+}  // namespace milvus
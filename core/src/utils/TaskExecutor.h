@@ -0,0 +1,123 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace milvus {
+
+// Queued tasks of a higher priority run first on every worker, search goes before build
+enum class TaskPriority {
+    HIGH = 0,
+    NORMAL = 1,
+};
+
+constexpr size_t TASK_PRIORITY_NUM = 2;
+
+/*
+ * Every worker owns a deque per priority. A worker runs its own deque in order, and when that is empty it steals
+ * the newest task of another worker. Tasks enqueued by a worker go to its own deque, tasks from other threads are
+ * spread round robin. An idle worker spins for a while before it sleeps.
+ */
+class TaskExecutor {
+ public:
+    using Task = std::function<void()>;
+
+    // queue_size bounds the tasks waiting to run, Enqueue blocks while it is reached, except on a worker.
+    // pin_threads binds the workers to NUMA nodes round robin, each worker may run on any cpu of its node.
+    explicit TaskExecutor(size_t threads, size_t queue_size = 1000, bool pin_threads = false);
+
+    ~TaskExecutor();
+
+    template <class F, class... Args>
+    auto
+    Enqueue(F&& f, Args&&... args) -> std::future<typename std::result_of<F(Args...)>::type> {
+        return EnqueueWithPriority(TaskPriority::NORMAL, std::forward<F>(f), std::forward<Args>(args)...);
+    }
+
+    template <class F, class... Args>
+    auto
+    EnqueueWithPriority(TaskPriority priority, F&& f, Args&&... args)
+        -> std::future<typename std::result_of<F(Args...)>::type> {
+        using return_type = typename std::result_of<F(Args...)>::type;
+
+        auto task = std::make_shared<std::packaged_task<return_type()>>(
+            std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+        std::future<return_type> res = task->get_future();
+        Push(priority, [task]() { (*task)(); });
+        return res;
+    }
+
+    size_t
+    Size() const {
+        return workers_.size();
+    }
+
+    // number of tasks waiting to run
+    size_t
+    Pending() const {
+        return pending_.load();
+    }
+
+ private:
+    struct alignas(64) Worker {
+        std::mutex mutex_;
+        std::deque<Task> tasks_[TASK_PRIORITY_NUM];
+        // lets thieves skip an empty deque without its lock
+        std::atomic<size_t> sizes_[TASK_PRIORITY_NUM] = {};
+        std::thread thread_;
+    };
+
+    void
+    Push(TaskPriority priority, Task&& task);
+
+    bool
+    Pop(size_t self, Task& task);
+
+    bool
+    Take(Worker& worker, size_t priority, bool own, Task& task);
+
+    void
+    Run(size_t self);
+
+    void
+    PinThread(size_t self);
+
+ private:
+    std::vector<std::unique_ptr<Worker>> workers_;
+    size_t max_queue_size_;
+    bool pin_threads_;
+    std::atomic<size_t> pending_{0};
+    std::atomic<size_t> next_worker_{0};
+
+    // idle workers and producers waiting for room sleep here
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_cv_;
+    std::condition_variable room_cv_;
+    std::atomic<size_t> sleeping_{0};
+    std::atomic<size_t> waiting_producers_{0};
+
+    std::atomic<bool> stop_{false};
+};
+
+using TaskExecutorPtr = std::shared_ptr<TaskExecutor>;
+
+}  // namespace milvus
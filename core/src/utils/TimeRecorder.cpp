@@ -30,6 +30,13 @@ TimeRecorder::GetTimeSpanStr(double span) {
 
 void
 TimeRecorder::PrintTimeRecord(const std::string& msg, double span) {
+    static const el::Level levels[] = {el::Level::Trace, el::Level::Debug, el::Level::Info,
+                                       el::Level::Warning, el::Level::Error, el::Level::Fatal};
+    auto level = (log_level_ >= 0 && log_level_ <= 5) ? levels[log_level_] : el::Level::Info;
+    if (!LogLevelEnabled(level)) {
+        return;
+    }
+
     std::string str_log;
     if (!header_.empty())
         str_log += header_ + ": ";
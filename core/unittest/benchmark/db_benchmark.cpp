@@ -0,0 +1,433 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+// End-to-end benchmark of the DB pipeline: insert through the WAL, flush, merge, index build, preload and search
+// through the scheduler, on a sqlite meta in a temp directory. See README.md for the options and the output.
+
+#include <getopt.h>
+#include <opentracing/mocktracer/tracer.h>
+
+#include <algorithm>
+#include <boost/filesystem.hpp>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cache/CpuCacheMgr.h"
+#include "db/DB.h"
+#include "db/DBFactory.h"
+#include "db/engine/ExecutionEngine.h"
+#include "scheduler/ResourceFactory.h"
+#include "scheduler/SchedInst.h"
+#include "server/context/Context.h"
+#include "utils/Json.h"
+#include "utils/Log.h"
+#include "utils/StringHelpFunctions.h"
+
+INITIALIZE_EASYLOGGINGPP
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using milvus::Status;
+
+struct BenchmarkOptions {
+    std::string path = "/tmp/milvus_db_benchmark";
+    std::string data_file;  // fvecs, synthetic data when empty
+    std::string output = "db_benchmark.json";
+    int64_t nb = 100000;
+    int64_t dim = 128;
+    int64_t batch = 10000;
+    int64_t segment_size = 1024;  // MB
+    int64_t rounds = 100;
+    std::vector<std::string> index_types = {"FLAT", "IVFFLAT", "IVFSQ8", "HNSW"};
+    std::vector<int64_t> nqs = {1, 10, 100};
+    std::vector<int64_t> topks = {10, 100};
+};
+
+// build and search parameters of every index type the benchmark knows
+struct IndexParams {
+    milvus::engine::EngineType engine_type;
+    milvus::json build_params;
+};
+
+const std::map<std::string, IndexParams> INDEX_PARAMS = {
+    {"FLAT", {milvus::engine::EngineType::FAISS_IDMAP, {}}},
+    {"IVFFLAT", {milvus::engine::EngineType::FAISS_IVFFLAT, {{"nlist", 1024}}}},
+    {"IVFSQ8", {milvus::engine::EngineType::FAISS_IVFSQ8, {{"nlist", 1024}}}},
+    {"IVFPQ", {milvus::engine::EngineType::FAISS_PQ, {{"nlist", 1024}, {"m", 16}}}},
+    {"HNSW", {milvus::engine::EngineType::HNSW, {{"M", 16}, {"efConstruction", 200}}}},
+};
+
+milvus::json
+SearchParams(milvus::engine::EngineType engine_type, int64_t topk) {
+    switch (engine_type) {
+        case milvus::engine::EngineType::HNSW:
+            return {{"ef", std::max<int64_t>(64, topk)}};
+        case milvus::engine::EngineType::FAISS_IDMAP:
+            return milvus::json::object();
+        default:
+            return {{"nprobe", 16}};
+    }
+}
+
+double
+ElapsedMs(const Clock::time_point& start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+double
+Percentile(const std::vector<double>& sorted_ms, double p) {
+    if (sorted_ms.empty()) {
+        return 0;
+    }
+    auto rank = static_cast<size_t>(std::ceil(p * sorted_ms.size()));
+    return sorted_ms[std::max<size_t>(rank, 1) - 1];
+}
+
+void
+PrintUsage(const char* app) {
+    std::cout << "Usage: " << app << " [options]" << std::endl
+              << "  --path=DIR          db directory, removed at exit (" << BenchmarkOptions().path << ")" << std::endl
+              << "  --data=FILE         fvecs file, synthetic vectors when omitted" << std::endl
+              << "  --output=FILE       json report (" << BenchmarkOptions().output << ")" << std::endl
+              << "  --nb=N              vectors to insert" << std::endl
+              << "  --dim=N             dimension of synthetic vectors" << std::endl
+              << "  --batch=N           vectors per insert call" << std::endl
+              << "  --segment_size=MB   index file size of the collections" << std::endl
+              << "  --rounds=N          searches per nq and topk" << std::endl
+              << "  --index=A,B         index types, FLAT IVFFLAT IVFSQ8 IVFPQ HNSW" << std::endl
+              << "  --nq=A,B            query batch sizes" << std::endl
+              << "  --topk=A,B          topk values" << std::endl;
+}
+
+std::vector<int64_t>
+ParseIntList(const std::string& str) {
+    std::vector<std::string> items;
+    milvus::StringHelpFunctions::SplitStringByDelimeter(str, ",", items);
+    std::vector<int64_t> values;
+    for (auto& item : items) {
+        values.push_back(std::stoll(item));
+    }
+    return values;
+}
+
+bool
+ParseOptions(int argc, char* argv[], BenchmarkOptions& options) {
+    static struct option long_options[] = {{"path", required_argument, nullptr, 'p'},
+                                           {"data", required_argument, nullptr, 'd'},
+                                           {"output", required_argument, nullptr, 'o'},
+                                           {"nb", required_argument, nullptr, 'n'},
+                                           {"dim", required_argument, nullptr, 'm'},
+                                           {"batch", required_argument, nullptr, 'b'},
+                                           {"segment_size", required_argument, nullptr, 's'},
+                                           {"rounds", required_argument, nullptr, 'r'},
+                                           {"index", required_argument, nullptr, 'i'},
+                                           {"nq", required_argument, nullptr, 'q'},
+                                           {"topk", required_argument, nullptr, 'k'},
+                                           {"help", no_argument, nullptr, 'h'},
+                                           {nullptr, 0, nullptr, 0}};
+    int value;
+    while ((value = getopt_long(argc, argv, "h", long_options, nullptr)) != -1) {
+        switch (value) {
+            case 'p':
+                options.path = optarg;
+                break;
+            case 'd':
+                options.data_file = optarg;
+                break;
+            case 'o':
+                options.output = optarg;
+                break;
+            case 'n':
+                options.nb = std::stoll(optarg);
+                break;
+            case 'm':
+                options.dim = std::stoll(optarg);
+                break;
+            case 'b':
+                options.batch = std::stoll(optarg);
+                break;
+            case 's':
+                options.segment_size = std::stoll(optarg);
+                break;
+            case 'r':
+                options.rounds = std::stoll(optarg);
+                break;
+            case 'i':
+                options.index_types.clear();
+                milvus::StringHelpFunctions::SplitStringByDelimeter(optarg, ",", options.index_types);
+                break;
+            case 'q':
+                options.nqs = ParseIntList(optarg);
+                break;
+            case 'k':
+                options.topks = ParseIntList(optarg);
+                break;
+            default:
+                return false;
+        }
+    }
+
+    for (auto& index_type : options.index_types) {
+        if (INDEX_PARAMS.find(index_type) == INDEX_PARAMS.end()) {
+            std::cerr << "Unknown index type " << index_type << std::endl;
+            return false;
+        }
+    }
+    return options.nb > 0 && options.dim > 0 && options.batch > 0 && options.rounds > 0;
+}
+
+// reads at most nb vectors of an fvecs file, every vector is prefixed by its dimension
+bool
+ReadFvecs(const std::string& file, int64_t& nb, int64_t& dim, std::vector<float>& data) {
+    std::ifstream in(file, std::ios::binary);
+    int32_t d = 0;
+    if (!in.read(reinterpret_cast<char*>(&d), sizeof(d)) || d <= 0) {
+        return false;
+    }
+    in.seekg(0, std::ios::end);
+    int64_t count = in.tellg() / (sizeof(int32_t) + d * sizeof(float));
+    in.seekg(0, std::ios::beg);
+
+    nb = std::min(nb, count);
+    dim = d;
+    data.resize(nb * dim);
+    for (int64_t i = 0; i < nb; ++i) {
+        in.read(reinterpret_cast<char*>(&d), sizeof(d));
+        in.read(reinterpret_cast<char*>(data.data() + i * dim), dim * sizeof(float));
+    }
+    return static_cast<bool>(in);
+}
+
+void
+GenerateVectors(int64_t nb, int64_t dim, std::vector<float>& data) {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> dis(0.0f, 1.0f);
+    data.resize(nb * dim);
+    for (auto& value : data) {
+        value = dis(gen);
+    }
+}
+
+void
+StartScheduler() {
+    auto res_mgr = milvus::scheduler::ResMgrInst::GetInstance();
+    res_mgr->Clear();
+    res_mgr->Add(milvus::scheduler::ResourceFactory::Create("disk", "DISK", 0, false));
+    res_mgr->Add(milvus::scheduler::ResourceFactory::Create("cpu", "CPU", 0));
+    auto io_conn = milvus::scheduler::Connection("IO", 500.0);
+    res_mgr->Connect("disk", "cpu", io_conn);
+    res_mgr->Start();
+    milvus::scheduler::SchedInst::GetInstance()->Start();
+    milvus::scheduler::JobMgrInst::GetInstance()->Start();
+    milvus::scheduler::CPUBuilderInst::GetInstance()->Start();
+}
+
+void
+StopScheduler() {
+    milvus::scheduler::JobMgrInst::GetInstance()->Stop();
+    milvus::scheduler::SchedInst::GetInstance()->Stop();
+    milvus::scheduler::CPUBuilderInst::GetInstance()->Stop();
+    milvus::scheduler::ResMgrInst::GetInstance()->Stop();
+    milvus::scheduler::ResMgrInst::GetInstance()->Clear();
+}
+
+std::shared_ptr<milvus::server::Context>
+CreateContext() {
+    auto context = std::make_shared<milvus::server::Context>("db_benchmark");
+    opentracing::mocktracer::MockTracerOptions tracer_options;
+    auto mock_tracer =
+        std::shared_ptr<opentracing::Tracer>{new opentracing::mocktracer::MockTracer{std::move(tracer_options)}};
+    auto mock_span = mock_tracer->StartSpan("mock_span");
+    context->SetTraceContext(std::make_shared<milvus::tracing::TraceContext>(mock_span));
+    return context;
+}
+
+Status
+RunIndexType(const BenchmarkOptions& options, const std::string& index_type, const std::vector<float>& xb,
+             int64_t nb, int64_t dim, milvus::json& report) {
+    auto db_options = milvus::engine::DBFactory::BuildOption();
+    db_options.meta_.path_ = options.path + "/" + index_type;
+    db_options.meta_.backend_uri_ = "sqlite://:@:/";
+    db_options.wal_enable_ = true;
+    db_options.mxlog_path_ = db_options.meta_.path_ + "/wal/";
+    db_options.auto_flush_interval_ = 0;  // flushes are timed explicitly
+    auto db = milvus::engine::DBFactory::Build(db_options);
+    auto context = CreateContext();
+    auto& params = INDEX_PARAMS.at(index_type);
+
+    milvus::engine::meta::CollectionSchema collection;
+    collection.collection_id_ = "benchmark_" + index_type;
+    collection.dimension_ = dim;
+    collection.index_file_size_ = options.segment_size;
+    collection.metric_type_ = (int32_t)milvus::engine::MetricType::L2;
+    STATUS_CHECK(db->CreateCollection(collection));
+
+    // insert
+    auto start = Clock::now();
+    for (int64_t offset = 0; offset < nb; offset += options.batch) {
+        auto count = std::min(options.batch, nb - offset);
+        milvus::engine::VectorsData vectors;
+        vectors.vector_count_ = count;
+        vectors.float_data_.assign(xb.begin() + offset * dim, xb.begin() + (offset + count) * dim);
+        for (int64_t i = 0; i < count; ++i) {
+            vectors.id_array_.push_back(offset + i);
+        }
+        STATUS_CHECK(db->InsertVectors(collection.collection_id_, "", vectors));
+    }
+    double insert_ms = ElapsedMs(start);
+
+    // searchable once flushed, indexed and loaded
+    auto searchable_start = Clock::now();
+    start = Clock::now();
+    STATUS_CHECK(db->Flush(collection.collection_id_));
+    double flush_ms = ElapsedMs(start);
+
+    double build_ms = 0;
+    if (params.engine_type != milvus::engine::EngineType::FAISS_IDMAP) {
+        milvus::engine::CollectionIndex index;
+        index.engine_type_ = (int32_t)params.engine_type;
+        index.extra_params_ = params.build_params;
+        start = Clock::now();
+        STATUS_CHECK(db->CreateIndex(context, collection.collection_id_, index));
+        build_ms = ElapsedMs(start);
+    }
+
+    start = Clock::now();
+    STATUS_CHECK(db->PreloadCollection(context, collection.collection_id_));
+    double preload_ms = ElapsedMs(start);
+    double searchable_ms = ElapsedMs(searchable_start);
+
+    milvus::json result;
+    result["index_type"] = index_type;
+    result["build_params"] = params.build_params;
+    result["insert_rate"] = nb * 1000.0 / std::max(insert_ms, 1e-3);
+    result["insert_ms"] = insert_ms;
+    result["flush_ms"] = flush_ms;
+    result["build_index_ms"] = build_ms;
+    result["preload_ms"] = preload_ms;
+    result["time_to_searchable_ms"] = searchable_ms;
+    std::cout << index_type << ": insert " << result["insert_rate"].get<double>() << " vectors/s, flush " << flush_ms
+              << " ms, build " << build_ms << " ms, preload " << preload_ms << " ms" << std::endl;
+
+    // queries are inserted vectors picked at random
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int64_t> pick(0, nb - 1);
+    std::vector<std::string> tags;
+    for (auto nq : options.nqs) {
+        for (auto topk : options.topks) {
+            auto search_params = SearchParams(params.engine_type, topk);
+            std::vector<double> latencies;
+            auto search_start = Clock::now();
+            for (int64_t round = 0; round < options.rounds; ++round) {
+                milvus::engine::VectorsData queries;
+                queries.vector_count_ = nq;
+                queries.float_data_.resize(nq * dim);
+                for (int64_t i = 0; i < nq; ++i) {
+                    auto id = pick(gen);
+                    std::copy(xb.begin() + id * dim, xb.begin() + (id + 1) * dim,
+                              queries.float_data_.begin() + i * dim);
+                }
+
+                milvus::engine::ResultIds result_ids;
+                milvus::engine::ResultDistances result_distances;
+                start = Clock::now();
+                STATUS_CHECK(db->Query(context, collection.collection_id_, tags, topk, search_params, queries,
+                                       result_ids, result_distances));
+                latencies.push_back(ElapsedMs(start));
+            }
+            double total_ms = ElapsedMs(search_start);
+            std::sort(latencies.begin(), latencies.end());
+
+            milvus::json search;
+            search["nq"] = nq;
+            search["topk"] = topk;
+            search["search_params"] = search_params;
+            search["qps"] = nq * options.rounds * 1000.0 / std::max(total_ms, 1e-3);
+            search["latency_ms"] = {{"p50", Percentile(latencies, 0.5)},
+                                    {"p90", Percentile(latencies, 0.9)},
+                                    {"p99", Percentile(latencies, 0.99)},
+                                    {"max", latencies.back()}};
+            result["search"].push_back(search);
+            std::cout << "  nq " << nq << " topk " << topk << ": qps " << search["qps"].get<double>() << ", p50 "
+                      << Percentile(latencies, 0.5) << " ms, p99 " << Percentile(latencies, 0.99) << " ms"
+                      << std::endl;
+        }
+    }
+    report["results"].push_back(result);
+
+    db->Stop();
+    db->DropAll();
+    milvus::cache::CpuCacheMgr::GetInstance()->ClearCache();
+    return Status::OK();
+}
+
+}  // namespace
+
+int
+main(int argc, char* argv[]) {
+    BenchmarkOptions options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // only problems are logged, formatting debug lines would be measured otherwise
+    el::Configurations log_conf;
+    log_conf.setToDefault();
+    log_conf.setGlobally(el::ConfigurationType::ToFile, "false");
+    el::Loggers::reconfigureLogger("default", log_conf);
+    milvus::enabled_log_levels = static_cast<uint32_t>(el::Level::Warning) | static_cast<uint32_t>(el::Level::Error) |
+                                 static_cast<uint32_t>(el::Level::Fatal);
+
+    int64_t nb = options.nb, dim = options.dim;
+    std::vector<float> xb;
+    if (options.data_file.empty()) {
+        GenerateVectors(nb, dim, xb);
+    } else if (!ReadFvecs(options.data_file, nb, dim, xb)) {
+        std::cerr << "Failed to read " << options.data_file << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    milvus::json report;
+    report["data"] = options.data_file.empty() ? "synthetic" : options.data_file;
+    report["nb"] = nb;
+    report["dim"] = dim;
+    report["batch"] = options.batch;
+    report["segment_size_mb"] = options.segment_size;
+    report["rounds"] = options.rounds;
+
+    StartScheduler();
+    int ret = EXIT_SUCCESS;
+    for (auto& index_type : options.index_types) {
+        auto status = RunIndexType(options, index_type, xb, nb, dim, report);
+        if (!status.ok()) {
+            std::cerr << index_type << " failed: " << status.message() << std::endl;
+            ret = EXIT_FAILURE;
+            break;
+        }
+    }
+    StopScheduler();
+    boost::filesystem::remove_all(options.path);
+
+    std::ofstream out(options.output);
+    out << report.dump(4) << std::endl;
+    std::cout << "Report written to " << options.output << std::endl;
+    return ret;
+}
@@ -0,0 +1,253 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+// Throughput of the sqlite meta: file creation, multi-row updates, TTL cleanup, and FilesToSearch latency while a
+// writer keeps updating files. See README.md for the options and the output.
+
+#include <getopt.h>
+
+#include <algorithm>
+#include <atomic>
+#include <boost/filesystem.hpp>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "db/meta/FilesHolder.h"
+#include "db/meta/SqliteMetaImpl.h"
+#include "utils/Json.h"
+#include "utils/Log.h"
+
+INITIALIZE_EASYLOGGINGPP
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using milvus::Status;
+using milvus::engine::meta::SegmentSchema;
+using milvus::engine::meta::SegmentsSchema;
+
+struct BenchmarkOptions {
+    std::string path = "/tmp/milvus_meta_benchmark";
+    std::string output = "meta_benchmark.json";
+    int64_t files = 2000;
+    int64_t batch = 100;  // files per UpdateCollectionFiles call
+    int64_t readers = 4;
+    int64_t seconds = 10;  // duration of the mixed read and write phase
+};
+
+double
+ElapsedMs(const Clock::time_point& start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+double
+Percentile(const std::vector<double>& sorted_ms, double p) {
+    if (sorted_ms.empty()) {
+        return 0;
+    }
+    auto rank = static_cast<size_t>(std::ceil(p * sorted_ms.size()));
+    return sorted_ms[std::max<size_t>(rank, 1) - 1];
+}
+
+void
+PrintUsage(const char* app) {
+    std::cout << "Usage: " << app << " [options]" << std::endl
+              << "  --path=DIR          meta directory, removed at exit (" << BenchmarkOptions().path << ")"
+              << std::endl
+              << "  --output=FILE       json report (" << BenchmarkOptions().output << ")" << std::endl
+              << "  --files=N           files in the collection" << std::endl
+              << "  --batch=N           files per update call" << std::endl
+              << "  --readers=N         threads calling FilesToSearch in the mixed phase" << std::endl
+              << "  --seconds=N         duration of the mixed phase" << std::endl;
+}
+
+bool
+ParseOptions(int argc, char* argv[], BenchmarkOptions& options) {
+    static struct option long_options[] = {{"path", required_argument, nullptr, 'p'},
+                                           {"output", required_argument, nullptr, 'o'},
+                                           {"files", required_argument, nullptr, 'f'},
+                                           {"batch", required_argument, nullptr, 'b'},
+                                           {"readers", required_argument, nullptr, 'r'},
+                                           {"seconds", required_argument, nullptr, 's'},
+                                           {"help", no_argument, nullptr, 'h'},
+                                           {nullptr, 0, nullptr, 0}};
+    int value;
+    while ((value = getopt_long(argc, argv, "h", long_options, nullptr)) != -1) {
+        switch (value) {
+            case 'p':
+                options.path = optarg;
+                break;
+            case 'o':
+                options.output = optarg;
+                break;
+            case 'f':
+                options.files = std::stoll(optarg);
+                break;
+            case 'b':
+                options.batch = std::stoll(optarg);
+                break;
+            case 'r':
+                options.readers = std::stoll(optarg);
+                break;
+            case 's':
+                options.seconds = std::stoll(optarg);
+                break;
+            default:
+                return false;
+        }
+    }
+    return options.files > 0 && options.batch > 0 && options.readers >= 0 && options.seconds > 0;
+}
+
+// updates the files batch by batch, returns the rows updated per second
+Status
+UpdateInBatches(milvus::engine::meta::SqliteMetaImpl& meta, SegmentsSchema& files, int64_t batch, double& rate) {
+    auto start = Clock::now();
+    for (size_t offset = 0; offset < files.size(); offset += batch) {
+        SegmentsSchema group(files.begin() + offset, files.begin() + std::min(files.size(), offset + batch));
+        STATUS_CHECK(meta.UpdateCollectionFiles(group));
+    }
+    rate = files.size() * 1000.0 / std::max(ElapsedMs(start), 1e-3);
+    return Status::OK();
+}
+
+Status
+Run(const BenchmarkOptions& options, milvus::json& report) {
+    milvus::engine::DBMetaOptions meta_options;
+    meta_options.path_ = options.path;
+    milvus::engine::meta::SqliteMetaImpl meta(meta_options);
+
+    milvus::engine::meta::CollectionSchema collection;
+    collection.collection_id_ = "meta_benchmark";
+    collection.dimension_ = 128;
+    STATUS_CHECK(meta.CreateCollection(collection));
+
+    // create
+    SegmentsSchema files;
+    auto start = Clock::now();
+    for (int64_t i = 0; i < options.files; ++i) {
+        SegmentSchema file;
+        file.collection_id_ = collection.collection_id_;
+        STATUS_CHECK(meta.CreateCollectionFile(file));
+        files.push_back(file);
+    }
+    report["create_rate"] = options.files * 1000.0 / std::max(ElapsedMs(start), 1e-3);
+
+    // full row updates, like a flush
+    double rate = 0;
+    for (auto& file : files) {
+        file.file_type_ = SegmentSchema::RAW;
+        file.row_count_ = 1000;
+    }
+    STATUS_CHECK(UpdateInBatches(meta, files, options.batch, rate));
+    report["update_rate"] = rate;
+
+    // readers search while a writer flips the files between RAW and INDEX
+    std::atomic<bool> stop{false};
+    std::vector<std::vector<double>> latencies(options.readers);
+    std::vector<std::thread> readers;
+    for (int64_t r = 0; r < options.readers; ++r) {
+        readers.emplace_back([&, r]() {
+            while (!stop) {
+                milvus::engine::meta::FilesHolder files_holder;
+                auto query_start = Clock::now();
+                meta.FilesToSearch(collection.collection_id_, files_holder);
+                latencies[r].push_back(ElapsedMs(query_start));
+            }
+        });
+    }
+
+    int64_t updated = 0;
+    auto mixed_start = Clock::now();
+    while (ElapsedMs(mixed_start) < options.seconds * 1000.0) {
+        for (auto& file : files) {
+            file.file_type_ = (file.file_type_ == SegmentSchema::RAW) ? SegmentSchema::INDEX : SegmentSchema::RAW;
+        }
+        STATUS_CHECK(UpdateInBatches(meta, files, options.batch, rate));
+        updated += files.size();
+    }
+    double mixed_ms = ElapsedMs(mixed_start);
+    stop = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    std::vector<double> all_latencies;
+    for (auto& reader_latencies : latencies) {
+        all_latencies.insert(all_latencies.end(), reader_latencies.begin(), reader_latencies.end());
+    }
+    std::sort(all_latencies.begin(), all_latencies.end());
+    report["mixed_update_rate"] = updated * 1000.0 / std::max(mixed_ms, 1e-3);
+    report["files_to_search_qps"] = all_latencies.size() * 1000.0 / std::max(mixed_ms, 1e-3);
+    report["files_to_search_latency_ms"] = {{"p50", Percentile(all_latencies, 0.5)},
+                                            {"p90", Percentile(all_latencies, 0.9)},
+                                            {"p99", Percentile(all_latencies, 0.99)},
+                                            {"max", all_latencies.empty() ? 0 : all_latencies.back()}};
+
+    // state transitions, like merge and compaction retiring their source files
+    for (auto& file : files) {
+        file.file_type_ = SegmentSchema::TO_DELETE;
+    }
+    STATUS_CHECK(UpdateInBatches(meta, files, options.batch, rate));
+    report["to_delete_rate"] = rate;
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    start = Clock::now();
+    STATUS_CHECK(meta.CleanUpFilesWithTTL(0));
+    report["cleanup_rate"] = options.files * 1000.0 / std::max(ElapsedMs(start), 1e-3);
+
+    meta.DropAll();
+    return Status::OK();
+}
+
+}  // namespace
+
+int
+main(int argc, char* argv[]) {
+    BenchmarkOptions options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // only problems are logged, formatting debug lines would be measured otherwise
+    el::Configurations log_conf;
+    log_conf.setToDefault();
+    log_conf.setGlobally(el::ConfigurationType::ToFile, "false");
+    el::Loggers::reconfigureLogger("default", log_conf);
+    milvus::enabled_log_levels = static_cast<uint32_t>(el::Level::Error) | static_cast<uint32_t>(el::Level::Fatal);
+
+    milvus::json report;
+    report["files"] = options.files;
+    report["batch"] = options.batch;
+    report["readers"] = options.readers;
+    report["seconds"] = options.seconds;
+
+    boost::filesystem::remove_all(options.path);
+    auto status = Run(options, report);
+    boost::filesystem::remove_all(options.path);
+    if (!status.ok()) {
+        std::cerr << "Meta benchmark failed: " << status.message() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << report.dump(4) << std::endl;
+    std::ofstream out(options.output);
+    out << report.dump(4) << std::endl;
+    std::cout << "Report written to " << options.output << std::endl;
+    return EXIT_SUCCESS;
+}
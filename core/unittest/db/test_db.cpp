@@ -24,8 +24,11 @@
 #include "db/DBFactory.h"
 #include "db/DBImpl.h"
 #include "db/IDGenerator.h"
+#include "db/SearchResultCache.h"
+#include "db/SegmentPruner.h"
 #include "db/meta/MetaConsts.h"
 #include "db/utils.h"
+#include "segment/VectorSummary.h"
 #include "utils/CommonUtil.h"
 
 namespace {
@@ -104,6 +107,47 @@ ConvertTimeRangeToDBDates(const std::string& start_value, const std::string& end
     }
 }
 
+void
+BuildClusteredPartitions(const milvus::engine::DBPtr& db, int64_t batch_count, int64_t batch_size,
+                         std::vector<milvus::engine::VectorsData>& batches) {
+    // one partition per batch keeps the segments apart from merges, each batch far from the others
+    batches.resize(batch_count);
+    for (int64_t b = 0; b < batch_count; ++b) {
+        std::string tag = std::to_string(b);
+        auto stat = db->CreatePartition(COLLECTION_NAME, COLLECTION_NAME + std::string("_") + tag, tag);
+        ASSERT_TRUE(stat.ok());
+
+        BuildVectors(batch_size, b, batches[b]);
+        for (auto& value : batches[b].float_data_) {
+            value += b * 10;
+        }
+        stat = db->InsertVectors(COLLECTION_NAME, tag, batches[b]);
+        ASSERT_TRUE(stat.ok());
+        stat = db->Flush();
+        ASSERT_TRUE(stat.ok());
+    }
+}
+
+// the segments under the db path that hold a vector summary, as the search would list them
+milvus::engine::meta::SegmentsSchema
+SummarizedSegments(const std::string& db_path, int32_t metric_type, int32_t engine_type, uint64_t row_count) {
+    milvus::engine::meta::SegmentsSchema files;
+    boost::filesystem::recursive_directory_iterator iter(db_path), end;
+    for (; iter != end; ++iter) {
+        if (iter->path().filename() == "vector_summary") {
+            milvus::engine::meta::SegmentSchema file;
+            file.segment_id_ = iter->path().parent_path().filename().string();
+            file.location_ = iter->path().parent_path().string() + "/" + file.segment_id_;
+            file.dimension_ = COLLECTION_DIM;
+            file.metric_type_ = metric_type;
+            file.engine_type_ = engine_type;
+            file.row_count_ = row_count;
+            files.push_back(file);
+        }
+    }
+    return files;
+}
+
 }  // namespace
 
 TEST_F(DBTest, CONFIG_TEST) {
@@ -751,6 +795,298 @@ TEST_F(DBTest, INDEX_TEST) {
     ASSERT_TRUE(stat.ok());
 }
 
+TEST_F(DBTest, BUILD_INDEX_OUT_OF_CORE_TEST) {
+    // stream the raw data through a buffer of 100 vectors
+    auto options = GetOptions();
+    options.build_index_buffer_size_ = 100 * COLLECTION_DIM * sizeof(float);
+    BuildDB(options);
+
+    milvus::engine::meta::CollectionSchema collection_info = BuildCollectionSchema();
+    auto stat = db_->CreateCollection(collection_info);
+    ASSERT_TRUE(stat.ok());
+
+    uint64_t nb = VECTOR_COUNT;
+    milvus::engine::VectorsData xb;
+    BuildVectors(nb, 0, xb);
+    stat = db_->InsertVectors(COLLECTION_NAME, "", xb);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->Flush();
+    ASSERT_TRUE(stat.ok());
+
+    int64_t nlist = 16;
+    std::vector<milvus::engine::EngineType> engine_types = {milvus::engine::EngineType::FAISS_IVFFLAT,
+                                                            milvus::engine::EngineType::FAISS_IVFSQ8};
+    for (auto engine_type : engine_types) {
+        milvus::engine::CollectionIndex index;
+        index.engine_type_ = (int)engine_type;
+        index.extra_params_ = {{"nlist", nlist}};
+
+        // the build fails when it goes through the out-of-core path
+        fiu_init(0);
+        fiu_enable("ExecutionEngineImpl.BuildIndexOutOfCore.throw_exception", 1, NULL, 0);
+        stat = db_->CreateIndex(dummy_context_, COLLECTION_NAME, index);
+        fiu_disable("ExecutionEngineImpl.BuildIndexOutOfCore.throw_exception");
+        ASSERT_FALSE(stat.ok());
+        stat = db_->DropIndex(COLLECTION_NAME);
+        ASSERT_TRUE(stat.ok());
+
+        stat = db_->CreateIndex(dummy_context_, COLLECTION_NAME, index);
+        ASSERT_TRUE(stat.ok());
+
+        // every list is probed, so each vector finds itself
+        milvus::engine::VectorsData xq;
+        xq.vector_count_ = 1;
+        int64_t row = nb / 3;
+        xq.float_data_.assign(xb.float_data_.begin() + row * COLLECTION_DIM,
+                              xb.float_data_.begin() + (row + 1) * COLLECTION_DIM);
+        milvus::json json_params = {{"nprobe", nlist}};
+        std::vector<std::string> tags;
+        milvus::engine::ResultIds result_ids;
+        milvus::engine::ResultDistances result_distances;
+        stat = db_->Query(dummy_context_, COLLECTION_NAME, tags, 1, json_params, xq, result_ids, result_distances);
+        ASSERT_TRUE(stat.ok());
+        ASSERT_EQ(result_ids[0], xb.id_array_[row]);
+
+        stat = db_->DropIndex(COLLECTION_NAME);
+        ASSERT_TRUE(stat.ok());
+    }
+}
+
+TEST_F(DBTest, SEARCH_RESULT_CACHE_TEST) {
+    auto options = GetOptions();
+    options.search_result_cache_size_ = 64 * 1024 * 1024;
+    BuildDB(options);
+    auto result_cache = milvus::engine::SearchResultCache::GetInstance();
+
+    milvus::engine::meta::CollectionSchema collection_info = BuildCollectionSchema();
+    auto stat = db_->CreateCollection(collection_info);
+    ASSERT_TRUE(stat.ok());
+
+    uint64_t nb = VECTOR_COUNT;
+    milvus::engine::VectorsData xb;
+    BuildVectors(nb, 0, xb);
+    stat = db_->InsertVectors(COLLECTION_NAME, "", xb);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->Flush();
+    ASSERT_TRUE(stat.ok());
+
+    int64_t row = nb / 2;
+    milvus::engine::VectorsData xq;
+    xq.vector_count_ = 1;
+    xq.float_data_.assign(xb.float_data_.begin() + row * COLLECTION_DIM,
+                          xb.float_data_.begin() + (row + 1) * COLLECTION_DIM);
+    milvus::json json_params = {{"nprobe", 1}};
+    std::vector<std::string> tags;
+    int64_t k = 10;
+
+    auto search = [&](milvus::engine::ResultIds& result_ids, milvus::engine::ResultDistances& result_distances) {
+        auto status = db_->Query(dummy_context_, COLLECTION_NAME, tags, k, json_params, xq, result_ids,
+                                 result_distances);
+        ASSERT_TRUE(status.ok());
+        ASSERT_EQ(result_ids.size(), (size_t)k);
+    };
+
+    // the same search twice, the second one is served from the cache
+    milvus::engine::ResultIds ids_1, ids_2, ids_3, ids_4;
+    milvus::engine::ResultDistances distances_1, distances_2, distances_3, distances_4;
+    search(ids_1, distances_1);
+    ASSERT_EQ(result_cache->MissCount(), 1);
+    ASSERT_EQ(ids_1[0], xb.id_array_[row]);
+    search(ids_2, distances_2);
+    ASSERT_EQ(result_cache->HitCount(), 1);
+    ASSERT_EQ(ids_1, ids_2);
+    ASSERT_EQ(distances_1, distances_2);
+
+    // other parameters are another entry
+    k = 5;
+    search(ids_3, distances_3);
+    ASSERT_EQ(result_cache->MissCount(), 2);
+    k = 10;
+
+    // a delete changes the segment, the nearest vector is gone
+    stat = db_->DeleteVectors(COLLECTION_NAME, {xb.id_array_[row]});
+    ASSERT_TRUE(stat.ok());
+    stat = db_->Flush();
+    ASSERT_TRUE(stat.ok());
+    search(ids_3, distances_3);
+    ASSERT_EQ(result_cache->MissCount(), 3);
+    ASSERT_NE(ids_3[0], xb.id_array_[row]);
+    search(ids_3, distances_3);
+    ASSERT_EQ(result_cache->HitCount(), 2);
+
+    // a new segment is flushed, and the index replaces the raw segments
+    milvus::engine::VectorsData xb_2;
+    BuildVectors(nb, 1, xb_2);
+    stat = db_->InsertVectors(COLLECTION_NAME, "", xb_2);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->Flush();
+    ASSERT_TRUE(stat.ok());
+    search(ids_4, distances_4);
+    ASSERT_EQ(result_cache->MissCount(), 4);
+
+    milvus::engine::CollectionIndex index;
+    index.engine_type_ = (int)milvus::engine::EngineType::FAISS_IVFFLAT;
+    index.extra_params_ = {{"nlist", 16}};
+    stat = db_->CreateIndex(dummy_context_, COLLECTION_NAME, index);
+    ASSERT_TRUE(stat.ok());
+    search(ids_4, distances_4);
+    ASSERT_EQ(result_cache->MissCount(), 5);
+    ASSERT_EQ(result_cache->HitCount(), 2);
+    ASSERT_GT(result_cache->HitRate(), 0.0);
+
+    // a DB without the cache searches every time
+    BuildDB(GetOptions());
+    ASSERT_FALSE(result_cache->Enabled());
+    search(ids_4, distances_4);
+    ASSERT_EQ(result_cache->HitCount(), 0);
+    ASSERT_EQ(result_cache->MissCount(), 0);
+}
+
+TEST_F(DBTest, SEGMENT_PRUNING_TEST) {
+    auto options = GetOptions();
+    options.segment_pruning_ = true;
+    BuildDB(options);
+
+    milvus::engine::meta::CollectionSchema collection_info = BuildCollectionSchema();
+    auto stat = db_->CreateCollection(collection_info);
+    ASSERT_TRUE(stat.ok());
+
+    const int64_t BATCH_COUNT = 4;
+    const int64_t BATCH_SIZE = 1000;
+    std::vector<milvus::engine::VectorsData> batches;
+    BuildClusteredPartitions(db_, BATCH_COUNT, BATCH_SIZE, batches);
+
+    // the summary bounds every vector of its batch
+    auto summary = milvus::segment::VectorSummary::Build(batches[0].float_data_.data(), BATCH_SIZE, COLLECTION_DIM);
+    ASSERT_NE(summary, nullptr);
+    const float* query = batches[1].float_data_.data();
+    float l2_bound = summary->L2LowerBound(query);
+    float ip_bound = summary->IPUpperBound(query);
+    for (int64_t i = 0; i < BATCH_SIZE; ++i) {
+        const float* row = batches[0].float_data_.data() + i * COLLECTION_DIM;
+        double l2 = 0, ip = 0;
+        for (int64_t j = 0; j < COLLECTION_DIM; ++j) {
+            l2 += (query[j] - row[j]) * (query[j] - row[j]);
+            ip += query[j] * row[j];
+        }
+        ASSERT_LE(l2_bound, l2);
+        ASSERT_GE(ip_bound, ip);
+    }
+
+    int64_t row = BATCH_SIZE / 2;
+    milvus::engine::VectorsData xq;
+    xq.vector_count_ = 2;
+    for (auto b : {1, 3}) {
+        auto& data = batches[b].float_data_;
+        xq.float_data_.insert(xq.float_data_.end(), data.begin() + row * COLLECTION_DIM,
+                              data.begin() + (row + 1) * COLLECTION_DIM);
+    }
+    milvus::json json_params = {{"nprobe", 1}};
+    std::vector<std::string> tags;
+    int64_t k = 10;
+
+    milvus::engine::ResultIds pruned_ids, ids;
+    milvus::engine::ResultDistances pruned_distances, distances;
+    stat = db_->Query(dummy_context_, COLLECTION_NAME, tags, k, json_params, xq, pruned_ids, pruned_distances);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(pruned_ids.size(), (size_t)(xq.vector_count_ * k));
+    ASSERT_EQ(pruned_ids[0], batches[1].id_array_[row]);
+    ASSERT_EQ(pruned_ids[k], batches[3].id_array_[row]);
+
+    // the batch of each query is searched, the other two cannot beat the kth result and are skipped
+    auto files = SummarizedSegments(options.meta_.path_, (int32_t)milvus::engine::MetricType::L2,
+                                    (int32_t)milvus::engine::EngineType::FAISS_IDMAP, BATCH_SIZE);
+    ASSERT_EQ(files.size(), (size_t)BATCH_COUNT);
+    milvus::engine::SegmentPruner pruner(files, xq, k);
+    milvus::engine::ResultIds no_ids;
+    milvus::engine::ResultDistances no_distances;
+    ASSERT_EQ(pruner.NextWave(no_ids, no_distances).size(), 1);
+    ASSERT_EQ(pruner.NextWave(pruned_ids, pruned_distances).size(), 1);
+    ASSERT_TRUE(pruner.NextWave(pruned_ids, pruned_distances).empty());
+    ASSERT_EQ(pruner.PrunedCount(), 2);
+
+    // the pruned search finds what searching every segment finds
+    BuildDB(GetOptions());
+    stat = db_->Query(dummy_context_, COLLECTION_NAME, tags, k, json_params, xq, ids, distances);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(pruned_ids, ids);
+    ASSERT_EQ(pruned_distances, distances);
+}
+
+TEST_F(DBTest, SEGMENT_PRUNING_IP_TEST) {
+    auto options = GetOptions();
+    options.segment_pruning_ = true;
+    BuildDB(options);
+
+    milvus::engine::meta::CollectionSchema collection_info = BuildCollectionSchema();
+    collection_info.metric_type_ = (int32_t)milvus::engine::MetricType::IP;
+    auto stat = db_->CreateCollection(collection_info);
+    ASSERT_TRUE(stat.ok());
+
+    const int64_t BATCH_COUNT = 3;
+    const int64_t BATCH_SIZE = 1000;
+    std::vector<milvus::engine::VectorsData> batches;
+    BuildClusteredPartitions(db_, BATCH_COUNT, BATCH_SIZE, batches);
+
+    milvus::engine::VectorsData xq;
+    xq.vector_count_ = 1;
+    xq.float_data_.assign(batches[0].float_data_.begin(), batches[0].float_data_.begin() + COLLECTION_DIM);
+    milvus::json json_params = {{"nprobe", 1}};
+    std::vector<std::string> tags;
+    int64_t k = 10;
+
+    // the largest inner products are all in the last batch, the bounds of the others fall below its kth
+    milvus::engine::ResultIds pruned_ids, ids;
+    milvus::engine::ResultDistances pruned_distances, distances;
+    stat = db_->Query(dummy_context_, COLLECTION_NAME, tags, k, json_params, xq, pruned_ids, pruned_distances);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(pruned_ids.size(), (size_t)k);
+
+    auto files = SummarizedSegments(options.meta_.path_, (int32_t)milvus::engine::MetricType::IP,
+                                    (int32_t)milvus::engine::EngineType::FAISS_IDMAP, BATCH_SIZE);
+    ASSERT_EQ(files.size(), (size_t)BATCH_COUNT);
+    {
+        milvus::engine::SegmentPruner pruner(files, xq, k);
+        milvus::engine::ResultIds no_ids;
+        milvus::engine::ResultDistances no_distances;
+        ASSERT_EQ(pruner.NextWave(no_ids, no_distances).size(), 1);
+        ASSERT_TRUE(pruner.NextWave(pruned_ids, pruned_distances).empty());
+        ASSERT_EQ(pruner.PrunedCount(), 2);
+    }
+
+    BuildDB(GetOptions());
+    stat = db_->Query(dummy_context_, COLLECTION_NAME, tags, k, json_params, xq, ids, distances);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(pruned_ids, ids);
+    ASSERT_EQ(pruned_distances, distances);
+
+    // a PQ index reduces IP results as distances, a collection holding one is searched without bounds whichever
+    // file comes last
+    milvus::engine::CollectionIndex index;
+    index.engine_type_ = (int)milvus::engine::EngineType::FAISS_PQ;
+    index.metric_type_ = (int)milvus::engine::MetricType::IP;
+    index.extra_params_ = {{"nlist", 16}, {"m", 16}};
+    stat = db_->CreateIndex(dummy_context_, COLLECTION_NAME, index);
+    ASSERT_TRUE(stat.ok());
+
+    for (auto last : {milvus::engine::EngineType::FAISS_PQ, milvus::engine::EngineType::FAISS_IDMAP}) {
+        auto mixed = files;
+        mixed.front().engine_type_ = (int32_t)milvus::engine::EngineType::FAISS_PQ;
+        mixed.back().engine_type_ = (int32_t)last;
+        milvus::engine::SegmentPruner pruner(mixed, xq, k);
+        milvus::engine::ResultIds no_ids;
+        milvus::engine::ResultDistances no_distances;
+        ASSERT_EQ(pruner.NextWave(no_ids, no_distances).size(), mixed.size());
+        ASSERT_TRUE(pruner.NextWave(pruned_ids, pruned_distances).empty());
+        ASSERT_EQ(pruner.PrunedCount(), 0);
+    }
+
+    BuildDB(options);
+    stat = db_->Query(dummy_context_, COLLECTION_NAME, tags, k, json_params, xq, ids, distances);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(ids.size(), (size_t)k);
+}
+
 TEST_F(DBTest, PARTITION_TEST) {
     milvus::engine::meta::CollectionSchema collection_info = BuildCollectionSchema();
     auto stat = db_->CreateCollection(collection_info);
@@ -16,6 +16,7 @@
 #include <iostream>
 #include <limits>
 #include <random>
+#include <set>
 #include <thread>
 
 #include "db/Constants.h"
@@ -28,6 +29,12 @@
 #include "db/utils.h"
 #include "gtest/gtest.h"
 #include "metrics/Metrics.h"
+#include "segment/IdBloomFilter.h"
+#include "segment/IdIndex.h"
+#include "segment/SegmentReader.h"
+#include "segment/SegmentWriter.h"
+#include "utils/Json.h"
+#include "utils/TimeRecorder.h"
 
 namespace {
 
@@ -711,6 +718,253 @@ TEST_F(DeleteTest, delete_add_auto_flush) {
     ASSERT_EQ(result_distances[0], std::numeric_limits<float>::max());
 }
 
+TEST_F(DeleteTest, delete_id_index) {
+    std::vector<milvus::segment::doc_id_t> uids = {7, 3, 9, 3, 1, 100, 42};
+    milvus::segment::IdIndex id_index(uids);
+    ASSERT_EQ(id_index.Count(), uids.size());
+
+    std::vector<milvus::segment::doc_id_t> found_ids;
+    std::vector<milvus::segment::offset_t> offsets;
+    id_index.Search({0, 3, 8, 42, 100, 200}, found_ids, offsets);
+    std::vector<milvus::segment::doc_id_t> expect_ids = {3, 3, 42, 100};
+    std::vector<milvus::segment::offset_t> expect_offsets = {1, 3, 6, 5};
+    ASSERT_EQ(found_ids, expect_ids);
+    ASSERT_EQ(offsets, expect_offsets);
+}
+
+TEST_F(DeleteTest, id_index_format) {
+    std::string segment_dir = GetOptions().meta_.path_ + "/id_index_test";
+    boost::filesystem::create_directories(segment_dir);
+
+    std::vector<milvus::segment::doc_id_t> uids = {7, 3, 9, 3, 1, 100, 42};
+    std::vector<uint8_t> vectors(uids.size() * sizeof(float), 0);
+    milvus::segment::SegmentWriter segment_writer(segment_dir);
+    ASSERT_TRUE(segment_writer.AddVectors("id_index_test", vectors, uids).ok());
+    ASSERT_TRUE(segment_writer.Serialize().ok());
+    ASSERT_TRUE(boost::filesystem::exists(segment_dir + "/id_index"));
+
+    std::vector<milvus::segment::doc_id_t> expect_ids = {3, 3, 42, 100};
+    std::vector<milvus::segment::offset_t> expect_offsets = {1, 3, 6, 5};
+    auto check = [&]() {
+        milvus::segment::SegmentReader segment_reader(segment_dir);
+        milvus::segment::IdIndexPtr id_index;
+        ASSERT_TRUE(segment_reader.LoadIdIndex(id_index).ok());
+        ASSERT_EQ(id_index->Count(), uids.size());
+
+        std::vector<milvus::segment::doc_id_t> found_ids;
+        std::vector<milvus::segment::offset_t> offsets;
+        id_index->Search({0, 3, 8, 42, 100, 200}, found_ids, offsets);
+        ASSERT_EQ(found_ids, expect_ids);
+        ASSERT_EQ(offsets, expect_offsets);
+    };
+    check();
+
+    // segments written before the id index build it from the uids
+    milvus::engine::utils::EraseFromCache(milvus::engine::utils::GetIdIndexCacheKey(segment_dir));
+    boost::filesystem::remove(segment_dir + "/id_index");
+    check();
+}
+
+TEST_F(DeleteTest, deleted_docs_format) {
+    std::string segment_dir = GetOptions().meta_.path_ + "/deleted_docs_test";
+    boost::filesystem::create_directories(segment_dir);
+
+    // a segment written by the offset list format
+    std::vector<milvus::segment::offset_t> legacy_offsets = {7, 3, 70000};
+    {
+        std::ofstream legacy(segment_dir + "/deleted_docs", std::ios::binary);
+        size_t num_bytes = legacy_offsets.size() * sizeof(milvus::segment::offset_t);
+        legacy.write(reinterpret_cast<const char*>(&num_bytes), sizeof(size_t));
+        legacy.write(reinterpret_cast<const char*>(legacy_offsets.data()), num_bytes);
+    }
+
+    milvus::segment::SegmentReader segment_reader(segment_dir);
+    milvus::segment::DeletedDocsPtr deleted_docs;
+    ASSERT_TRUE(segment_reader.LoadDeletedDocs(deleted_docs).ok());
+    ASSERT_EQ(deleted_docs->GetDeletedDocs(), legacy_offsets);
+
+    // small batches are appended, large ones fold everything into a new bitmap
+    std::set<milvus::segment::offset_t> expect(legacy_offsets.begin(), legacy_offsets.end());
+    milvus::segment::SegmentWriter segment_writer(segment_dir);
+    std::default_random_engine e;
+    std::uniform_int_distribution<milvus::segment::offset_t> u(0, 100000);
+    for (int64_t batch_size : {1, 10, 100, 50000, 10}) {
+        std::vector<milvus::segment::offset_t> offsets;
+        for (int64_t i = 0; i < batch_size; ++i) {
+            offsets.emplace_back(u(e));
+        }
+        expect.insert(offsets.begin(), offsets.end());
+        ASSERT_TRUE(segment_writer.WriteDeletedDocs(std::make_shared<milvus::segment::DeletedDocs>(offsets)).ok());
+
+        ASSERT_TRUE(segment_reader.LoadDeletedDocs(deleted_docs).ok());
+        ASSERT_EQ(deleted_docs->GetSize(), expect.size());
+        std::vector<milvus::segment::offset_t> expect_offsets(expect.begin(), expect.end());
+        ASSERT_EQ(deleted_docs->GetDeletedDocs(), expect_offsets);
+
+        auto bitset = std::make_shared<faiss::ConcurrentBitset>(100001);
+        deleted_docs->GetBitset(bitset);
+        for (auto offset : expect) {
+            ASSERT_TRUE(bitset->test(offset));
+        }
+
+        size_t deleted_docs_size = 0;
+        ASSERT_TRUE(segment_reader.ReadDeletedDocsSize(deleted_docs_size).ok());
+        ASSERT_EQ(deleted_docs_size, expect.size());
+    }
+    ASSERT_FALSE(boost::filesystem::exists(segment_dir + "/deleted_docs"));
+
+    // offsets deleted again are appended as a delta but counted once
+    std::vector<milvus::segment::offset_t> again(expect.begin(), std::next(expect.begin(), 5));
+    again.insert(again.end(), again.begin(), again.end());
+    ASSERT_TRUE(segment_writer.WriteDeletedDocs(std::make_shared<milvus::segment::DeletedDocs>(again)).ok());
+    ASSERT_TRUE(segment_writer.WriteDeletedDocs(std::make_shared<milvus::segment::DeletedDocs>(again)).ok());
+    size_t deleted_docs_size = 0;
+    ASSERT_TRUE(segment_reader.ReadDeletedDocsSize(deleted_docs_size).ok());
+    ASSERT_EQ(deleted_docs_size, expect.size());
+    ASSERT_TRUE(segment_reader.LoadDeletedDocs(deleted_docs).ok());
+    ASSERT_EQ(deleted_docs->GetSize(), expect.size());
+}
+
+TEST_F(DeleteTest, id_bloom_filter) {
+    std::string segment_dir = GetOptions().meta_.path_ + "/id_bloom_filter_test";
+    boost::filesystem::create_directories(segment_dir);
+
+    int64_t nb = 100000;
+    std::default_random_engine e;
+    std::uniform_int_distribution<milvus::segment::doc_id_t> u(0, std::numeric_limits<int64_t>::max());
+    auto bloom_filter = std::make_shared<milvus::segment::IdBloomFilter>(nb);
+    std::vector<milvus::segment::doc_id_t> uids;
+    for (int64_t i = 0; i < nb; ++i) {
+        uids.emplace_back(u(e));
+        bloom_filter->Add(uids.back());
+    }
+
+    milvus::segment::SegmentWriter segment_writer(segment_dir);
+    ASSERT_TRUE(segment_writer.WriteBloomFilter(bloom_filter).ok());
+    milvus::segment::SegmentReader segment_reader(segment_dir);
+    milvus::segment::IdBloomFilterPtr loaded;
+    ASSERT_TRUE(segment_reader.LoadBloomFilter(loaded).ok());
+    ASSERT_EQ(loaded->GetBlockCount(), bloom_filter->GetBlockCount());
+
+    // no false negatives, and sized to keep the false positive rate low
+    for (auto uid : uids) {
+        ASSERT_TRUE(loaded->Check(uid));
+    }
+    std::vector<milvus::segment::doc_id_t> queries;
+    for (int64_t i = 0; i < nb; ++i) {
+        queries.emplace_back(u(e));
+    }
+    milvus::TimeRecorder rc("id_bloom_filter");
+    int64_t false_positives = 0;
+    for (auto uid : queries) {
+        false_positives += loaded->Check(uid) ? 1 : 0;
+    }
+    rc.RecordSection("single check");
+    std::vector<milvus::segment::doc_id_t> maybe_present;
+    loaded->Check(queries, maybe_present);
+    rc.RecordSection("batched check");
+    ASSERT_EQ(maybe_present.size(), false_positives);
+    ASSERT_LT(false_positives, nb / 100);
+}
+
+TEST_F(DeleteTest, delete_many_segments) {
+    milvus::engine::meta::CollectionSchema collection_info = BuildCollectionSchema();
+    auto stat = db_->CreateCollection(collection_info);
+    ASSERT_TRUE(stat.ok());
+
+    // every flush seals a segment, a quarter of the rows of every segment is deleted in one call
+    int64_t nb = 1000;
+    int segment_count = 10;
+    std::vector<milvus::engine::IDNumber> ids_to_delete, ids_to_keep;
+    std::vector<milvus::engine::VectorsData> batches(segment_count);
+    for (auto& xb : batches) {
+        BuildVectors(nb, xb);
+        stat = db_->InsertVectors(collection_info.collection_id_, "", xb);
+        ASSERT_TRUE(stat.ok());
+        stat = db_->Flush();
+        ASSERT_TRUE(stat.ok());
+
+        for (int64_t j = 0; j < nb; ++j) {
+            (j % 4 == 0 ? ids_to_delete : ids_to_keep).emplace_back(xb.id_array_[j]);
+        }
+    }
+
+    stat = db_->DeleteVectors(collection_info.collection_id_, ids_to_delete);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->Flush();
+    ASSERT_TRUE(stat.ok());
+
+    uint64_t row_count;
+    stat = db_->GetCollectionRowCount(collection_info.collection_id_, row_count);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(row_count, nb * segment_count - ids_to_delete.size());
+    ASSERT_EQ(row_count, ids_to_keep.size());
+
+    std::vector<milvus::engine::VectorsData> vectors;
+    stat = db_->GetVectorsByID(collection_info, ids_to_delete, vectors);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(vectors.size(), ids_to_delete.size());
+    for (auto& vector : vectors) {
+        ASSERT_TRUE(vector.float_data_.empty());
+    }
+
+    // the rows left in every segment keep their data
+    stat = db_->GetVectorsByID(collection_info, ids_to_keep, vectors);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(vectors.size(), ids_to_keep.size());
+    size_t k = 0;
+    for (auto& xb : batches) {
+        for (int64_t j = 0; j < nb; ++j) {
+            if (j % 4 == 0) {
+                continue;
+            }
+            ASSERT_EQ(vectors[k].float_data_.size(), COLLECTION_DIM);
+            ASSERT_EQ(memcmp(vectors[k].float_data_.data(), xb.float_data_.data() + j * COLLECTION_DIM,
+                             COLLECTION_DIM * sizeof(float)),
+                      0);
+            ++k;
+        }
+    }
+}
+
+TEST_F(DeleteTest, delete_throughput) {
+    milvus::engine::meta::CollectionSchema collection_info = BuildCollectionSchema();
+    auto stat = db_->CreateCollection(collection_info);
+    ASSERT_TRUE(stat.ok());
+
+    // every flush seals a segment
+    int64_t nb = 5000;
+    int segment_count = 40;
+    std::vector<milvus::engine::IDNumber> ids_to_delete;
+    for (int i = 0; i < segment_count; ++i) {
+        milvus::engine::VectorsData xb;
+        BuildVectors(nb, xb);
+        stat = db_->InsertVectors(collection_info.collection_id_, "", xb);
+        ASSERT_TRUE(stat.ok());
+        stat = db_->Flush();
+        ASSERT_TRUE(stat.ok());
+
+        for (int64_t j = 0; j < nb; j += 4) {
+            ids_to_delete.emplace_back(xb.id_array_[j]);
+        }
+    }
+
+    milvus::TimeRecorder rc("delete throughput");
+    stat = db_->DeleteVectors(collection_info.collection_id_, ids_to_delete);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->Flush();
+    ASSERT_TRUE(stat.ok());
+    double elapsed_us = rc.ElapseFromBegin("done");
+    std::cout << "delete " << ids_to_delete.size() << " ids over " << segment_count << " segments in "
+              << elapsed_us / 1000 << " ms, " << ids_to_delete.size() / (elapsed_us / 1000000) << " ids/s"
+              << std::endl;
+
+    uint64_t row_count;
+    stat = db_->GetCollectionRowCount(collection_info.collection_id_, row_count);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(row_count, nb * segment_count - ids_to_delete.size());
+}
+
 TEST_F(CompactTest, compact_basic) {
     milvus::engine::meta::CollectionSchema collection_info = BuildCollectionSchema();
     auto stat = db_->CreateCollection(collection_info);
@@ -768,6 +1022,70 @@ TEST_F(CompactTest, compact_basic) {
     ASSERT_EQ(result_distances[0], std::numeric_limits<float>::max());
 }
 
+TEST_F(CompactTest, compact_background) {
+    FreeDB();
+    auto options = GetOptions();
+    options.auto_compact_interval_ = 1;
+    options.auto_compact_threshold_ = 0.1;
+    BuildDB(options);
+
+    milvus::engine::meta::CollectionSchema collection_info = BuildCollectionSchema();
+    auto stat = db_->CreateCollection(collection_info);
+    ASSERT_TRUE(stat.ok());
+
+    int64_t nb = 100;
+    milvus::engine::VectorsData xb;
+    BuildVectors(nb, xb);
+
+    stat = db_->InsertVectors(collection_info.collection_id_, "", xb);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->Flush();
+    ASSERT_TRUE(stat.ok());
+
+    auto segment_names = [&]() {
+        std::string info;
+        db_->GetCollectionInfo(collection_info.collection_id_, info);
+        std::set<std::string> names;
+        auto json = milvus::json::parse(info);
+        for (auto& partition : json["partitions"]) {
+            for (auto& segment : partition["segments"]) {
+                names.insert(segment["name"].get<std::string>());
+            }
+        }
+        return names;
+    };
+    auto origin_segments = segment_names();
+    ASSERT_FALSE(origin_segments.empty());
+
+    std::vector<milvus::engine::IDNumber> ids_to_delete(xb.id_array_.begin(), xb.id_array_.begin() + 20);
+    stat = db_->DeleteVectors(collection_info.collection_id_, ids_to_delete);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->Flush();
+    ASSERT_TRUE(stat.ok());
+
+    // deleted ratio 0.2 exceeds the threshold, the segment is rewritten without an explicit Compact() call
+    for (int i = 0; i < 100 && segment_names() == origin_segments; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    ASSERT_NE(segment_names(), origin_segments);
+
+    uint64_t row_count;
+    stat = db_->GetCollectionRowCount(collection_info.collection_id_, row_count);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(row_count, nb - ids_to_delete.size());
+
+    milvus::json json_params = {{"nprobe", 1}};
+    std::vector<std::string> tags;
+    milvus::engine::ResultIds result_ids;
+    milvus::engine::ResultDistances result_distances;
+    stat = db_->QueryByIDs(dummy_context_, collection_info.collection_id_, tags, 1, json_params, ids_to_delete,
+                           result_ids, result_distances);
+    ASSERT_TRUE(stat.ok());
+    for (auto id : result_ids) {
+        ASSERT_EQ(id, -1);
+    }
+}
+
 TEST_F(CompactTest, compact_with_index) {
     milvus::engine::meta::CollectionSchema collection_info = BuildCollectionSchema();
     collection_info.index_file_size_ = milvus::engine::KB;
@@ -30,6 +30,7 @@
 #include "db/utils.h"
 #include "gtest/gtest.h"
 #include "metrics/Metrics.h"
+#include "utils/TimeRecorder.h"
 
 namespace {
 
@@ -109,6 +110,155 @@ TEST_F(MemManagerTest, VECTOR_SOURCE_TEST) {
     ASSERT_EQ(vectors.id_array_.size(), 100);
 }
 
+TEST_F(MemManagerTest, VECTOR_SOURCE_VIEW_TEST) {
+    milvus::engine::meta::CollectionSchema collection_schema = BuildCollectionSchema();
+    auto status = impl_->CreateCollection(collection_schema);
+    ASSERT_TRUE(status.ok());
+
+    milvus::engine::meta::SegmentSchema table_file_schema;
+    table_file_schema.collection_id_ = GetCollectionName();
+    status = impl_->CreateCollectionFile(table_file_schema);
+    ASSERT_TRUE(status.ok());
+
+    int64_t n = 100;
+    milvus::engine::VectorsData vectors;
+    BuildVectors(n, vectors);
+    vectors.id_array_.resize(n);
+    for (int64_t i = 0; i < n; i++) {
+        vectors.id_array_[i] = i + 1000;
+    }
+
+    // the source reads the caller's buffers in place
+    milvus::engine::VectorSource source(n, vectors.id_array_.data(), vectors.float_data_.data());
+    ASSERT_EQ(source.SingleVectorSize(COLLECTION_DIM), COLLECTION_DIM * sizeof(float));
+
+    std::string directory;
+    milvus::engine::utils::GetParentPath(table_file_schema.location_, directory);
+    auto segment_writer_ptr = std::make_shared<milvus::segment::SegmentWriter>(directory);
+
+    size_t num_vectors_added;
+    status = source.Add(segment_writer_ptr, table_file_schema, 60, num_vectors_added);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(num_vectors_added, 60);
+    status = source.Add(segment_writer_ptr, table_file_schema, 60, num_vectors_added);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(num_vectors_added, 40);
+    ASSERT_TRUE(source.AllAdded());
+    ASSERT_EQ(source.GetVectorIds(), vectors.id_array_);
+
+    milvus::segment::SegmentPtr segment_ptr;
+    segment_writer_ptr->GetSegment(segment_ptr);
+    auto& data = segment_ptr->vectors_ptr_->GetData();
+    ASSERT_EQ(data.size(), n * COLLECTION_DIM * sizeof(float));
+    ASSERT_EQ(memcmp(data.data(), vectors.float_data_.data(), data.size()), 0);
+    ASSERT_EQ(segment_ptr->vectors_ptr_->GetUids(), vectors.id_array_);
+}
+
+TEST_F(MemManagerTest, VECTOR_SOURCE_ROWS_TEST) {
+    milvus::engine::meta::CollectionSchema collection_schema = BuildCollectionSchema();
+    auto status = impl_->CreateCollection(collection_schema);
+    ASSERT_TRUE(status.ok());
+
+    milvus::engine::meta::SegmentSchema table_file_schema;
+    table_file_schema.collection_id_ = GetCollectionName();
+    status = impl_->CreateCollectionFile(table_file_schema);
+    ASSERT_TRUE(status.ok());
+
+    int64_t n = 100;
+    milvus::engine::VectorsData vectors;
+    BuildVectors(n, vectors);
+    milvus::engine::IDNumbers ids(n);
+    std::vector<const uint8_t*> rows(n);
+    for (int64_t i = 0; i < n; i++) {
+        ids[i] = i + 1000;
+        rows[i] = reinterpret_cast<const uint8_t*>(vectors.float_data_.data() + (n - 1 - i) * COLLECTION_DIM);
+    }
+
+    // the rows are gathered into the segment in the order given
+    milvus::engine::VectorSource source(n, ids.data(), rows.data(), false);
+    ASSERT_EQ(source.SingleVectorSize(COLLECTION_DIM), COLLECTION_DIM * sizeof(float));
+
+    std::string directory;
+    milvus::engine::utils::GetParentPath(table_file_schema.location_, directory);
+    auto segment_writer_ptr = std::make_shared<milvus::segment::SegmentWriter>(directory);
+
+    size_t num_vectors_added;
+    status = source.Add(segment_writer_ptr, table_file_schema, 60, num_vectors_added);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(num_vectors_added, 60);
+    status = source.Add(segment_writer_ptr, table_file_schema, 60, num_vectors_added);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(num_vectors_added, 40);
+    ASSERT_TRUE(source.AllAdded());
+
+    milvus::segment::SegmentPtr segment_ptr;
+    segment_writer_ptr->GetSegment(segment_ptr);
+    auto& data = segment_ptr->vectors_ptr_->GetData();
+    size_t row_size = COLLECTION_DIM * sizeof(float);
+    ASSERT_EQ(data.size(), n * row_size);
+    for (int64_t i = 0; i < n; i++) {
+        ASSERT_EQ(memcmp(data.data() + i * row_size, rows[i], row_size), 0);
+    }
+    ASSERT_EQ(segment_ptr->vectors_ptr_->GetUids(), ids);
+}
+
+TEST_F(MemManagerTest, ENTITY_SOURCE_TEST) {
+    milvus::engine::meta::CollectionSchema collection_schema = BuildCollectionSchema();
+    auto status = impl_->CreateCollection(collection_schema);
+    ASSERT_TRUE(status.ok());
+
+    milvus::engine::meta::SegmentSchema table_file_schema;
+    table_file_schema.collection_id_ = GetCollectionName();
+    status = impl_->CreateCollectionFile(table_file_schema);
+    ASSERT_TRUE(status.ok());
+
+    int64_t n = 100;
+    milvus::engine::VectorsData vectors;
+    BuildVectors(n, vectors);
+    vectors.id_array_.resize(n);
+    milvus::engine::AttrColumns attr_columns(2);
+    attr_columns[0].name_ = "field_0";
+    attr_columns[0].nbytes_ = sizeof(int32_t);
+    attr_columns[0].data_.resize(n * sizeof(int32_t));
+    attr_columns[1].name_ = "field_1";
+    attr_columns[1].nbytes_ = sizeof(double);
+    attr_columns[1].data_.resize(n * sizeof(double));
+    for (int64_t i = 0; i < n; i++) {
+        vectors.id_array_[i] = i;
+        reinterpret_cast<int32_t*>(attr_columns[0].data_.data())[i] = i;
+        reinterpret_cast<double*>(attr_columns[1].data_.data())[i] = i / 2.0;
+    }
+
+    milvus::engine::VectorSource source(n, vectors.id_array_.data(), vectors.float_data_.data(), attr_columns);
+    ASSERT_EQ(source.SingleEntitySize(COLLECTION_DIM), COLLECTION_DIM * sizeof(float) + 12);
+
+    std::string directory;
+    milvus::engine::utils::GetParentPath(table_file_schema.location_, directory);
+    auto segment_writer_ptr = std::make_shared<milvus::segment::SegmentWriter>(directory);
+
+    // every batch appends its own rows to the columns
+    size_t num_entities_added;
+    status = source.AddEntities(segment_writer_ptr, table_file_schema, 60, num_entities_added);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(num_entities_added, 60);
+    status = source.AddEntities(segment_writer_ptr, table_file_schema, 60, num_entities_added);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(num_entities_added, 40);
+    ASSERT_TRUE(source.AllAdded());
+
+    milvus::segment::SegmentPtr segment_ptr;
+    segment_writer_ptr->GetSegment(segment_ptr);
+    auto& attrs = segment_ptr->attrs_ptr_->attrs;
+    ASSERT_EQ(attrs.size(), 2);
+    for (auto& column : attr_columns) {
+        auto& attr = attrs.at(column.name_);
+        ASSERT_EQ(attr->GetNbytes(), column.data_.size());
+        ASSERT_EQ(attr->GetData(), column.data_);
+        ASSERT_EQ(attr->GetUids(), vectors.id_array_);
+    }
+    ASSERT_EQ(segment_ptr->vectors_ptr_->GetCount(), n);
+}
+
 TEST_F(MemManagerTest, MEM_TABLE_FILE_TEST) {
     auto options = GetOptions();
     fiu_init(0);
@@ -329,6 +479,106 @@ TEST_F(MemManagerTest2, INSERT_TEST) {
     }
 }
 
+TEST_F(MemManagerTest2, INSERT_ROWS_TEST) {
+    milvus::engine::meta::CollectionSchema collection_info = BuildCollectionSchema();
+    auto stat = db_->CreateCollection(collection_info);
+    ASSERT_TRUE(stat.ok());
+
+    // the rows are read in place like the records of a grpc request, every batch is inserted in reverse row order
+    int64_t nb = 1000;
+    int insert_loop = 5;
+    std::vector<milvus::engine::VectorsData> batches(insert_loop);
+    milvus::engine::IDNumbers vector_ids;
+    std::vector<const float*> expected;
+    for (auto& xb : batches) {
+        BuildVectors(nb, xb);
+        milvus::engine::VectorsData rows_data;
+        rows_data.vector_count_ = nb;
+        rows_data.rows_.row_size_ = COLLECTION_DIM * sizeof(float);
+        for (int64_t i = nb - 1; i >= 0; --i) {
+            auto row = xb.float_data_.data() + i * COLLECTION_DIM;
+            rows_data.rows_.rows_.push_back(reinterpret_cast<const uint8_t*>(row));
+            expected.push_back(row);
+        }
+
+        stat = db_->InsertVectors(GetCollectionName(), "", rows_data);
+        ASSERT_TRUE(stat.ok());
+        ASSERT_EQ(rows_data.id_array_.size(), nb);
+        vector_ids.insert(vector_ids.end(), rows_data.id_array_.begin(), rows_data.id_array_.end());
+    }
+
+    stat = db_->Flush();
+    ASSERT_TRUE(stat.ok());
+    uint64_t row_count = 0;
+    stat = db_->GetCollectionRowCount(GetCollectionName(), row_count);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(row_count, static_cast<uint64_t>(nb * insert_loop));
+
+    std::vector<milvus::engine::VectorsData> vectors;
+    stat = db_->GetVectorsByID(collection_info, vector_ids, vectors);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(vectors.size(), vector_ids.size());
+    for (size_t i = 0; i < vectors.size(); ++i) {
+        ASSERT_EQ(vectors[i].float_data_.size(), COLLECTION_DIM);
+        ASSERT_EQ(memcmp(vectors[i].float_data_.data(), expected[i], COLLECTION_DIM * sizeof(float)), 0);
+    }
+}
+
+TEST_F(MemManagerTest2, INSERT_THROUGHPUT_TEST) {
+    milvus::engine::meta::CollectionSchema collection_info = BuildCollectionSchema();
+    auto stat = db_->CreateCollection(collection_info);
+    ASSERT_TRUE(stat.ok());
+
+    // the records of a request sit in separate buffers, like the rows of a grpc request
+    int64_t nb = 4096;
+    int insert_loop = 20;
+    std::vector<milvus::engine::VectorsData> batches(insert_loop);
+    for (auto& xb : batches) {
+        BuildVectors(nb, xb);
+    }
+    size_t row_size = COLLECTION_DIM * sizeof(float);
+
+    // before: the rows are flattened into one array first, as the handler used to do
+    milvus::TimeRecorder rc("insert throughput");
+    for (auto& xb : batches) {
+        milvus::engine::VectorsData copied;
+        copied.vector_count_ = nb;
+        copied.float_data_.reserve(nb * COLLECTION_DIM);
+        for (int64_t i = 0; i < nb; ++i) {
+            auto row = xb.float_data_.data() + i * COLLECTION_DIM;
+            copied.float_data_.insert(copied.float_data_.end(), row, row + COLLECTION_DIM);
+        }
+        stat = db_->InsertVectors(GetCollectionName(), "", copied);
+        ASSERT_TRUE(stat.ok());
+    }
+    double copy_us = rc.RecordSection("copied rows");
+
+    // after: the rows are read in place
+    for (auto& xb : batches) {
+        milvus::engine::VectorsData rows_data;
+        rows_data.vector_count_ = nb;
+        rows_data.rows_.row_size_ = row_size;
+        for (int64_t i = 0; i < nb; ++i) {
+            rows_data.rows_.rows_.push_back(reinterpret_cast<const uint8_t*>(xb.float_data_.data()) + i * row_size);
+        }
+        stat = db_->InsertVectors(GetCollectionName(), "", rows_data);
+        ASSERT_TRUE(stat.ok());
+    }
+    double view_us = rc.RecordSection("rows in place");
+
+    int64_t total = nb * insert_loop;
+    std::cout << "insert " << total << " vectors of dim " << COLLECTION_DIM << ": " << total / (copy_us / 1000000)
+              << " vectors/s with copied rows, " << total / (view_us / 1000000) << " vectors/s with rows in place"
+              << std::endl;
+
+    stat = db_->Flush();
+    ASSERT_TRUE(stat.ok());
+    uint64_t row_count = 0;
+    stat = db_->GetCollectionRowCount(GetCollectionName(), row_count);
+    ASSERT_TRUE(stat.ok());
+    ASSERT_EQ(row_count, static_cast<uint64_t>(2 * total));
+}
+
 TEST_F(MemManagerTest2, INSERT_BINARY_TEST) {
     milvus::engine::meta::CollectionSchema collection_info;
     collection_info.dimension_ = COLLECTION_DIM;
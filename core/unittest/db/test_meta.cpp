@@ -21,6 +21,8 @@
 #include <stdlib.h>
 #include <time.h>
 #include <boost/filesystem/operations.hpp>
+#include <chrono>
+#include <thread>
 
 TEST_F(MetaTest, COLLECTION_TEST) {
     auto collection_id = "meta_test_table";
@@ -465,6 +467,66 @@ TEST_F(MetaTest, COLLECTION_FILE_ROW_COUNT_TEST) {
     ASSERT_EQ(table_file.flush_lsn_, schemas[0].flush_lsn_);
 }
 
+TEST_F(MetaTest, COLLECTION_FILES_BATCH_UPDATE_TEST) {
+    auto collection_id = "batch_update_test_table";
+
+    milvus::engine::meta::CollectionSchema collection;
+    collection.collection_id_ = collection_id;
+    collection.dimension_ = 256;
+    auto status = impl_->CreateCollection(collection);
+    ASSERT_TRUE(status.ok());
+
+    // more files than one sql batch
+    const size_t files_cnt = 120, to_delete_cnt = 100;
+    milvus::engine::meta::SegmentsSchema files;
+    for (size_t i = 0; i < files_cnt; ++i) {
+        milvus::engine::meta::SegmentSchema table_file;
+        table_file.collection_id_ = collection_id;
+        status = impl_->CreateCollectionFile(table_file);
+        ASSERT_TRUE(status.ok());
+        table_file.file_type_ = milvus::engine::meta::SegmentSchema::RAW;
+        table_file.row_count_ = 1;
+        files.push_back(table_file);
+    }
+    status = impl_->UpdateCollectionFiles(files);
+    ASSERT_TRUE(status.ok());
+
+    uint64_t cnt = 0;
+    status = impl_->Count(collection_id, cnt);
+    ASSERT_EQ(cnt, files_cnt);
+
+    // retire most of the files and index the others in one update
+    for (size_t i = 0; i < files_cnt; ++i) {
+        files[i].file_type_ = (i < to_delete_cnt) ? (int)milvus::engine::meta::SegmentSchema::TO_DELETE
+                                                  : (int)milvus::engine::meta::SegmentSchema::INDEX;
+        files[i].row_count_ = 2;
+    }
+    status = impl_->UpdateCollectionFiles(files);
+    ASSERT_TRUE(status.ok());
+
+    milvus::engine::meta::FilesHolder files_holder;
+    status = impl_->FilesToSearch(collection_id, files_holder);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(files_holder.HoldFiles().size(), files_cnt - to_delete_cnt);
+    for (auto& file : files_holder.HoldFiles()) {
+        ASSERT_EQ(file.file_type_, milvus::engine::meta::SegmentSchema::INDEX);
+        ASSERT_EQ(file.row_count_, 2UL);
+    }
+
+    files_holder.ReleaseFiles();
+    std::vector<int> file_types = {milvus::engine::meta::SegmentSchema::TO_DELETE};
+    status = impl_->FilesByType(collection_id, file_types, files_holder);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(files_holder.HoldFiles().size(), to_delete_cnt);
+
+    files_holder.ReleaseFiles();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    status = impl_->CleanUpFilesWithTTL(0UL);
+    ASSERT_TRUE(status.ok());
+    status = impl_->FilesByType(collection_id, file_types, files_holder);
+    ASSERT_TRUE(files_holder.HoldFiles().empty());
+}
+
 TEST_F(MetaTest, ARCHIVE_TEST_DAYS) {
     srand(time(0));
     milvus::engine::DBMetaOptions options;
@@ -16,6 +16,7 @@
 #include <vector>
 
 #include "db/IDGenerator.h"
+#include "db/IndexBuildQueue.h"
 #include "db/IndexFailedChecker.h"
 #include "db/Options.h"
 #include "db/Utils.h"
@@ -192,6 +193,58 @@ TEST(DBMiscTest, CHECKER_TEST) {
     }
 }
 
+TEST(DBMiscTest, INDEX_BUILD_QUEUE_TEST) {
+    milvus::engine::IndexBuildQueue queue;
+    int64_t now = milvus::engine::utils::GetMicroSecTimeStamp();
+
+    auto make_file = [&](size_t id, const std::string& collection_id, int64_t rows, int64_t wait_sec) {
+        milvus::engine::meta::SegmentSchema file;
+        file.id_ = id;
+        file.collection_id_ = collection_id;
+        file.file_id_ = std::to_string(id);
+        file.row_count_ = rows;
+        file.updated_time_ = now - wait_sec * 1000000;
+        return file;
+    };
+
+    // larger segments go first
+    milvus::engine::meta::SegmentsSchema files = {make_file(1, "aaa", 1000, 0), make_file(2, "aaa", 500000, 0)};
+    queue.Prioritize(files);
+    ASSERT_EQ(files[0].id_, 2);
+
+    // a segment waiting long enough overtakes a larger new one
+    files = {make_file(1, "aaa", 500000, 0), make_file(2, "aaa", 400000, 600)};
+    queue.Prioritize(files);
+    ASSERT_EQ(files[0].id_, 2);
+
+    // segments of a searched collection go first
+    ASSERT_EQ(queue.SearchRate("bbb"), 0.0);
+    for (int i = 0; i < 600; ++i) {
+        queue.RecordSearch("bbb");
+    }
+    ASSERT_GT(queue.SearchRate("bbb"), 5.0);
+    files = {make_file(1, "aaa", 500000, 0), make_file(2, "bbb", 200000, 0)};
+    queue.Prioritize(files);
+    ASSERT_EQ(files[0].id_, 2);
+
+    // files building are dropped until their job is finished
+    auto file_ptr = std::make_shared<milvus::engine::meta::SegmentSchema>(files[0]);
+    auto job = std::make_shared<milvus::scheduler::BuildIndexJob>(nullptr, milvus::engine::DBOptions());
+    job->AddToIndexFiles(file_ptr);
+    queue.AddBuilding(file_ptr, job);
+    ASSERT_EQ(queue.BuildingCount(), 1);
+    queue.Prioritize(files);
+    ASSERT_EQ(files.size(), 1);
+    ASSERT_EQ(files[0].id_, 1);
+
+    ASSERT_TRUE(queue.TakeFinished(false).empty());
+    job->BuildIndexDone(file_ptr->id_);
+    auto finished = queue.TakeFinished(true);
+    ASSERT_EQ(finished.size(), 1);
+    ASSERT_EQ(finished[0].file_->id_, 2);
+    ASSERT_EQ(queue.BuildingCount(), 0);
+}
+
 TEST(DBMiscTest, IDGENERATOR_TEST) {
     milvus::engine::SimpleIDGenerator gen;
     size_t n = 1000000;
@@ -16,7 +16,7 @@
 #include "scheduler/job/SearchJob.h"
 #include "scheduler/task/SearchTask.h"
 #include "utils/TimeRecorder.h"
-#include "utils/ThreadPool.h"
+#include "utils/TaskExecutor.h"
 
 namespace {
 
@@ -162,6 +162,60 @@ TEST(DBSearchTest, MERGE_RESULT_SET_TEST) {
     MergeTopkToResultSetTest(TOP_K / 2, TOP_K / 3, NQ, TOP_K, false);
 }
 
+void
+BuildRangeResult(ms::ResultLims& lims, ms::ResultIds& ids, ms::ResultDistances& distances, size_t nq, int64_t id_base,
+                 bool ascending) {
+    lims.assign(1, 0);
+    ids.clear();
+    distances.clear();
+    for (size_t i = 0; i < nq; i++) {
+        // query i gets i results, so the first query is empty
+        for (size_t j = 0; j < i; j++) {
+            ids.push_back(id_base + i * 1000 + j);
+            float dist = (float)(j * 2 + id_base % 2);
+            distances.push_back(ascending ? dist : -dist);
+        }
+        lims.push_back(ids.size());
+    }
+}
+
+TEST(DBSearchTest, MERGE_RANGE_RESULT_SET_TEST) {
+    size_t NQ = 15;
+
+    for (bool ascending : {true, false}) {
+        ms::ResultLims lims1, lims2, result_lims;
+        ms::ResultIds ids1, ids2, result_ids;
+        ms::ResultDistances dist1, dist2, result_distances;
+        BuildRangeResult(lims1, ids1, dist1, NQ, 0, ascending);
+        BuildRangeResult(lims2, ids2, dist2, NQ, 1, ascending);
+
+        /* an empty source leaves the result untouched */
+        ms::XSearchTask::MergeRangeToResultSet(ms::ResultLims(), ms::ResultIds(), ms::ResultDistances(), NQ,
+                                               ascending, result_lims, result_ids, result_distances);
+        ASSERT_TRUE(result_lims.empty());
+
+        ms::XSearchTask::MergeRangeToResultSet(lims1, ids1, dist1, NQ, ascending, result_lims, result_ids,
+                                               result_distances);
+        ASSERT_EQ(result_lims, lims1);
+        ASSERT_EQ(result_ids, ids1);
+
+        ms::XSearchTask::MergeRangeToResultSet(lims2, ids2, dist2, NQ, ascending, result_lims, result_ids,
+                                               result_distances);
+        ASSERT_EQ(result_lims.size(), NQ + 1);
+        ASSERT_EQ(result_ids.size(), ids1.size() + ids2.size());
+        for (size_t i = 0; i < NQ; i++) {
+            ASSERT_EQ(result_lims[i + 1] - result_lims[i], 2 * i);
+            for (int64_t j = result_lims[i] + 1; j < result_lims[i + 1]; j++) {
+                if (ascending) {
+                    ASSERT_LE(result_distances[j - 1], result_distances[j]);
+                } else {
+                    ASSERT_GE(result_distances[j - 1], result_distances[j]);
+                }
+            }
+        }
+    }
+}
+
 //void MergeTopkArrayTest(size_t topk_1, size_t topk_2, size_t nq, size_t topk, bool ascending) {
 //    std::vector<int64_t> ids1, ids2;
 //    std::vector<float> dist1, dist2;
@@ -245,7 +299,7 @@ TEST(DBSearchTest, REDUCE_PERF_TEST) {
     }
 
     for (int32_t max_thread_num : thread_vec) {
-        milvus::ThreadPool threadPool(max_thread_num);
+        milvus::TaskExecutor threadPool(max_thread_num);
         std::list<std::future<void>> threads_list;
 
         for (int32_t nq : nq_vec) {
@@ -9,6 +9,7 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
+#include <algorithm>
 #include <boost/filesystem.hpp>
 #include <chrono>
 #include <cmath>
@@ -476,6 +477,69 @@ TEST_F(GetVectorByIdTest, WITH_DELETE_TEST) {
     }
 }
 
+TEST_F(GetVectorByIdTest, CACHED_TEST) {
+    milvus::engine::meta::CollectionSchema collection_info = BuildCollectionSchema();
+    auto stat = db_->CreateCollection(collection_info);
+    ASSERT_TRUE(stat.ok());
+
+    int64_t nb = 5000;
+    milvus::engine::VectorsData xb;
+    BuildVectors(nb, xb);
+    for (int64_t i = 0; i < nb; i++) {
+        xb.id_array_.push_back(i);
+    }
+
+    stat = db_->InsertVectors(collection_info.collection_id_, "", xb);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->Flush();
+    ASSERT_TRUE(stat.ok());
+
+    // unordered and duplicated ids, the last one does not exist
+    std::vector<int64_t> ids_to_search = {4999, 7, 2500, 7, 0, nb + 1};
+    auto check_vectors = [&](const std::vector<int64_t>& deleted_ids) {
+        std::vector<milvus::engine::VectorsData> vectors;
+        auto status = db_->GetVectorsByID(collection_info, ids_to_search, vectors);
+        ASSERT_TRUE(status.ok());
+        ASSERT_EQ(vectors.size(), ids_to_search.size());
+        for (size_t i = 0; i < ids_to_search.size(); ++i) {
+            auto id = ids_to_search[i];
+            if (id >= nb || std::find(deleted_ids.begin(), deleted_ids.end(), id) != deleted_ids.end()) {
+                ASSERT_EQ(vectors[i].vector_count_, 0);
+                continue;
+            }
+            ASSERT_EQ(vectors[i].vector_count_, 1);
+            ASSERT_EQ(vectors[i].float_data_.size(), COLLECTION_DIM);
+            ASSERT_EQ(memcmp(vectors[i].float_data_.data(), xb.float_data_.data() + id * COLLECTION_DIM,
+                             COLLECTION_DIM * sizeof(float)),
+                      0);
+        }
+    };
+
+    // read from disk, then from the raw vectors of the cached index
+    check_vectors({});
+    stat = db_->PreloadCollection(dummy_context_, collection_info.collection_id_);
+    ASSERT_TRUE(stat.ok());
+    check_vectors({});
+
+    // deletes reach the blacklist of the cached index
+    milvus::engine::IDNumbers ids_to_delete = {7, 4999};
+    stat = db_->DeleteVectors(collection_info.collection_id_, ids_to_delete);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->Flush();
+    ASSERT_TRUE(stat.ok());
+    check_vectors(ids_to_delete);
+
+    // IVF_FLAT keeps the raw vectors arranged by inverted list
+    milvus::engine::CollectionIndex index;
+    index.extra_params_ = {{"nlist", 10}};
+    index.engine_type_ = (int)milvus::engine::EngineType::FAISS_IVFFLAT;
+    stat = db_->CreateIndex(dummy_context_, collection_info.collection_id_, index);
+    ASSERT_TRUE(stat.ok());
+    stat = db_->PreloadCollection(dummy_context_, collection_info.collection_id_);
+    ASSERT_TRUE(stat.ok());
+    check_vectors(ids_to_delete);
+}
+
 TEST_F(SearchByIdTest, BINARY_TEST) {
     milvus::engine::meta::CollectionSchema collection_info = BuildCollectionSchema();
     collection_info.engine_type_ = (int)milvus::engine::EngineType::FAISS_BIN_IDMAP;
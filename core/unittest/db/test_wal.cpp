@@ -437,13 +437,11 @@ TEST(WalTest, HYBRID_BUFFFER_TEST) {
     record[0].ids = (milvus::engine::IDNumber*)malloc(record[0].length * sizeof(milvus::engine::IDNumber));
     record[0].data_size = record[0].length * sizeof(float);
     record[0].data = malloc(record[0].data_size);
-    record[0].field_names.resize(2);
-    record[0].field_names[0] = "field_0";
-    record[0].field_names[1] = "field_1";
-    record[0].attr_data_size.insert(std::make_pair("field_0", length * sizeof(int64_t)));
-    record[0].attr_data_size.insert(std::make_pair("field_1", length * sizeof(float)));
-    record[0].attr_nbytes.insert(std::make_pair("field_0", sizeof(uint64_t)));
-    record[0].attr_nbytes.insert(std::make_pair("field_1", sizeof(float)));
+    record[0].attrs.resize(2);
+    record[0].attrs[0].name_ = "field_0";
+    record[0].attrs[0].nbytes_ = sizeof(int64_t);
+    record[0].attrs[1].name_ = "field_1";
+    record[0].attrs[1].nbytes_ = sizeof(float);
 
     std::vector<int64_t> data_0(length);
     std::default_random_engine e;
@@ -453,7 +451,7 @@ TEST(WalTest, HYBRID_BUFFFER_TEST) {
     }
     std::vector<uint8_t> attr_data_0(length * sizeof(int64_t));
     memcpy(attr_data_0.data(), data_0.data(), length * sizeof(int64_t));
-    record[0].attr_data.insert(std::make_pair("field_0", attr_data_0));
+    record[0].attrs[0].data_ = attr_data_0;
 
     std::vector<float> data_1(length);
     std::default_random_engine e1;
@@ -463,7 +461,7 @@ TEST(WalTest, HYBRID_BUFFFER_TEST) {
     }
     std::vector<uint8_t> attr_data_1(length * sizeof(float));
     memcpy(attr_data_1.data(), data_1.data(), length * sizeof(float));
-    record[0].attr_data.insert(std::make_pair("field_1", attr_data_1));
+    record[0].attrs[1].data_ = attr_data_1;
 
     ASSERT_EQ(buffer.AppendEntity(record[0]), milvus::WAL_SUCCESS);
     uint32_t new_file_no = uint32_t(record[0].lsn >> 32);
@@ -478,13 +476,11 @@ TEST(WalTest, HYBRID_BUFFFER_TEST) {
     record[1].ids = (milvus::engine::IDNumber*)malloc(record[0].length * sizeof(milvus::engine::IDNumber));
     record[1].data_size = 0;
     record[1].data = nullptr;
-    record[1].field_names.resize(2);
-    record[1].field_names[0] = "field_0";
-    record[1].field_names[1] = "field_1";
-    record[1].attr_data_size.insert(std::make_pair("field_0", length * sizeof(int64_t)));
-    record[1].attr_data_size.insert(std::make_pair("field_1", length * sizeof(float)));
-    record[1].attr_nbytes.insert(std::make_pair("field_0", sizeof(uint64_t)));
-    record[1].attr_nbytes.insert(std::make_pair("field_1", sizeof(float)));
+    record[1].attrs.resize(2);
+    record[1].attrs[0].name_ = "field_0";
+    record[1].attrs[0].nbytes_ = sizeof(int64_t);
+    record[1].attrs[1].name_ = "field_1";
+    record[1].attrs[1].nbytes_ = sizeof(float);
 
     std::vector<int64_t> data1_0(length);
     for (uint64_t i = 0; i < length; ++i) {
@@ -492,7 +488,7 @@ TEST(WalTest, HYBRID_BUFFFER_TEST) {
     }
     std::vector<uint8_t> attr_data1_0(length * sizeof(int64_t));
     memcpy(attr_data1_0.data(), data1_0.data(), length * sizeof(int64_t));
-    record[1].attr_data.insert(std::make_pair("field_0", attr_data1_0));
+    record[1].attrs[0].data_ = attr_data1_0;
 
     std::vector<float> data1_1(length);
     for (uint64_t i = 0; i < length; ++i) {
@@ -500,7 +496,7 @@ TEST(WalTest, HYBRID_BUFFFER_TEST) {
     }
     std::vector<uint8_t> attr_data1_1(length * sizeof(float));
     memcpy(attr_data1_1.data(), data1_1.data(), length * sizeof(float));
-    record[1].attr_data.insert(std::make_pair("field_1", attr_data1_1));
+    record[1].attrs[1].data_ = attr_data1_1;
     ASSERT_EQ(buffer.AppendEntity(record[1]), milvus::WAL_SUCCESS);
     new_file_no = uint32_t(record[1].lsn >> 32);
     ASSERT_EQ(new_file_no, file_no);
@@ -514,10 +510,10 @@ TEST(WalTest, HYBRID_BUFFFER_TEST) {
     ASSERT_EQ(memcmp(read_rst.ids, record[0].ids, read_rst.length * sizeof(milvus::engine::IDNumber)), 0);
     ASSERT_EQ(read_rst.data_size, record[0].data_size);
     ASSERT_EQ(memcmp(read_rst.data, record[0].data, read_rst.data_size), 0);
-    ASSERT_EQ(read_rst.field_names.size(), record[0].field_names.size());
-    ASSERT_EQ(read_rst.field_names[0], record[0].field_names[0]);
-    ASSERT_EQ(read_rst.attr_data.at("field_0").size(), record[0].attr_data.at("field_0").size());
-    ASSERT_EQ(read_rst.attr_nbytes.at("field_0"), record[0].attr_nbytes.at("field_0"));
+    ASSERT_EQ(read_rst.attrs.size(), record[0].attrs.size());
+    ASSERT_EQ(read_rst.attrs[0].name_, record[0].attrs[0].name_);
+    ASSERT_EQ(read_rst.attrs[0].data_, record[0].attrs[0].data_);
+    ASSERT_EQ(read_rst.attrs[0].nbytes_, record[0].attrs[0].nbytes_);
 
     // read 1
     ASSERT_EQ(buffer.NextEntity(record[1].lsn, read_rst), milvus::WAL_SUCCESS);
@@ -528,10 +524,10 @@ TEST(WalTest, HYBRID_BUFFFER_TEST) {
     ASSERT_EQ(memcmp(read_rst.ids, record[1].ids, read_rst.length * sizeof(milvus::engine::IDNumber)), 0);
     ASSERT_EQ(read_rst.data_size, 0);
     ASSERT_EQ(read_rst.data, nullptr);
-    ASSERT_EQ(read_rst.field_names.size(), record[1].field_names.size());
-    ASSERT_EQ(read_rst.field_names[1], record[1].field_names[1]);
-    ASSERT_EQ(read_rst.attr_data.at("field_1").size(), record[1].attr_data.at("field_1").size());
-    ASSERT_EQ(read_rst.attr_nbytes.at("field_0"), record[1].attr_nbytes.at("field_0"));
+    ASSERT_EQ(read_rst.attrs.size(), record[1].attrs.size());
+    ASSERT_EQ(read_rst.attrs[1].name_, record[1].attrs[1].name_);
+    ASSERT_EQ(read_rst.attrs[1].data_, record[1].attrs[1].data_);
+    ASSERT_EQ(read_rst.attrs[0].nbytes_, record[1].attrs[0].nbytes_);
 
     // read empty
     ASSERT_EQ(buffer.NextEntity(record[1].lsn, read_rst), milvus::WAL_SUCCESS);
@@ -547,16 +543,7 @@ TEST(WalTest, HYBRID_BUFFFER_TEST) {
     record[2].data_size = record[2].length * sizeof(float);
     record[2].data = malloc(record[2].data_size);
 
-    record[2].field_names.resize(2);
-    record[2].field_names[0] = "field_0";
-    record[2].field_names[1] = "field_1";
-    record[2].attr_data_size.insert(std::make_pair("field_0", length * sizeof(int64_t)));
-    record[2].attr_data_size.insert(std::make_pair("field_1", length * sizeof(float)));
-
-    record[2].attr_data.insert(std::make_pair("field_0", attr_data_0));
-    record[2].attr_data.insert(std::make_pair("field_1", attr_data_1));
-    record[2].attr_nbytes.insert(std::make_pair("field_0", sizeof(uint64_t)));
-    record[2].attr_nbytes.insert(std::make_pair("field_1", sizeof(float)));
+    record[2].attrs = record[0].attrs;
 
     ASSERT_EQ(buffer.AppendEntity(record[2]), milvus::WAL_SUCCESS);
     new_file_no = uint32_t(record[2].lsn >> 32);
@@ -571,16 +558,7 @@ TEST(WalTest, HYBRID_BUFFFER_TEST) {
     record[3].data_size = record[3].length * sizeof(uint8_t);
     record[3].data = malloc(record[3].data_size);
 
-    record[3].field_names.resize(2);
-    record[3].field_names[0] = "field_0";
-    record[3].field_names[1] = "field_1";
-    record[3].attr_data_size.insert(std::make_pair("field_0", length * sizeof(int64_t)));
-    record[3].attr_data_size.insert(std::make_pair("field_1", length * sizeof(float)));
-
-    record[3].attr_data.insert(std::make_pair("field_0", attr_data1_0));
-    record[3].attr_data.insert(std::make_pair("field_1", attr_data1_1));
-    record[3].attr_nbytes.insert(std::make_pair("field_0", sizeof(uint64_t)));
-    record[3].attr_nbytes.insert(std::make_pair("field_1", sizeof(float)));
+    record[3].attrs = record[1].attrs;
     ASSERT_EQ(buffer.AppendEntity(record[3]), milvus::WAL_SUCCESS);
     new_file_no = uint32_t(record[3].lsn >> 32);
     ASSERT_EQ(new_file_no, ++file_no);
@@ -604,10 +582,10 @@ TEST(WalTest, HYBRID_BUFFFER_TEST) {
     ASSERT_EQ(read_rst.data_size, record[2].data_size);
     ASSERT_EQ(memcmp(read_rst.data, record[2].data, read_rst.data_size), 0);
 
-    ASSERT_EQ(read_rst.field_names.size(), record[2].field_names.size());
-    ASSERT_EQ(read_rst.field_names[1], record[2].field_names[1]);
-    ASSERT_EQ(read_rst.attr_data.at("field_1").size(), record[2].attr_data.at("field_1").size());
-    ASSERT_EQ(read_rst.attr_nbytes.at("field_0"), record[2].attr_nbytes.at("field_0"));
+    ASSERT_EQ(read_rst.attrs.size(), record[2].attrs.size());
+    ASSERT_EQ(read_rst.attrs[1].name_, record[2].attrs[1].name_);
+    ASSERT_EQ(read_rst.attrs[1].data_, record[2].attrs[1].data_);
+    ASSERT_EQ(read_rst.attrs[0].nbytes_, record[2].attrs[0].nbytes_);
 
     // read 3
     ASSERT_EQ(buffer.NextEntity(record[3].lsn, read_rst), milvus::WAL_SUCCESS);
@@ -619,9 +597,9 @@ TEST(WalTest, HYBRID_BUFFFER_TEST) {
     ASSERT_EQ(read_rst.data_size, record[3].data_size);
     ASSERT_EQ(memcmp(read_rst.data, record[3].data, read_rst.data_size), 0);
 
-    ASSERT_EQ(read_rst.field_names.size(), record[3].field_names.size());
-    ASSERT_EQ(read_rst.field_names[1], record[3].field_names[1]);
-    ASSERT_EQ(read_rst.attr_nbytes.at("field_0"), record[3].attr_nbytes.at("field_0"));
+    ASSERT_EQ(read_rst.attrs.size(), record[3].attrs.size());
+    ASSERT_EQ(read_rst.attrs[1].name_, record[3].attrs[1].name_);
+    ASSERT_EQ(read_rst.attrs[0].nbytes_, record[3].attrs[0].nbytes_);
 
     // test an empty record
     milvus::engine::wal::MXLogRecord empty;
@@ -888,6 +866,69 @@ TEST(WalTest, MANAGER_TEST) {
     ASSERT_TRUE(record.collection_id.empty());
 }
 
+TEST(WalTest, MANAGER_ROWS_TEST) {
+    MakeEmptyTestPath();
+
+    milvus::engine::DBMetaOptions opt = {WAL_GTEST_PATH};
+    milvus::engine::meta::MetaPtr meta = std::make_shared<milvus::engine::meta::TestWalMeta>(opt);
+
+    milvus::engine::wal::MXLogConfiguration wal_config;
+    wal_config.mxlog_path = WAL_GTEST_PATH;
+    wal_config.buffer_size = 64;
+    wal_config.recovery_error_ignore = true;
+
+    std::shared_ptr<milvus::engine::wal::WalManager> manager =
+        std::make_shared<milvus::engine::wal::WalManager>(wal_config);
+    ASSERT_EQ(manager->Init(meta), milvus::WAL_SUCCESS);
+
+    // a small buffer splits the rows over several records
+    manager->mxlog_config_.buffer_size = 8049;
+    manager->p_buffer_->mxlog_buffer_size_ = 8049;
+
+    const int64_t dim = 16, nb = 300;
+    std::vector<float> data_float(nb * dim);
+    for (size_t i = 0; i < data_float.size(); i++) {
+        data_float[i] = static_cast<float>(i);
+    }
+    std::vector<int64_t> ids(nb);
+    milvus::engine::VectorRows rows;
+    rows.row_size_ = dim * sizeof(float);
+    for (int64_t i = 0; i < nb; i++) {
+        ids[i] = i;
+        rows.rows_.push_back(reinterpret_cast<const uint8_t*>(data_float.data() + (nb - 1 - i) * dim));
+    }
+
+    std::string table_id = "table1";
+    manager->CreateCollection(table_id);
+    ASSERT_TRUE(manager->Insert(table_id, "", ids, rows));
+    auto flush_lsn = manager->Flush(table_id);
+    ASSERT_NE(flush_lsn, 0);
+
+    // the records hold the rows gathered in the given order
+    milvus::engine::wal::MXLogRecord record;
+    std::vector<int64_t> read_ids;
+    std::vector<uint8_t> read_data;
+    int record_count = 0;
+    while (1) {
+        ASSERT_EQ(manager->GetNextRecord(record), milvus::WAL_SUCCESS);
+        if (record.type == milvus::engine::wal::MXLogType::Flush) {
+            break;
+        }
+        ASSERT_EQ(record.type, milvus::engine::wal::MXLogType::InsertVector);
+        ASSERT_EQ(record.data_size, record.length * rows.row_size_);
+        read_ids.insert(read_ids.end(), record.ids, record.ids + record.length);
+        auto data = static_cast<const uint8_t*>(record.data);
+        read_data.insert(read_data.end(), data, data + record.data_size);
+        record_count++;
+    }
+    ASSERT_GT(record_count, 1);
+    ASSERT_EQ(read_ids, ids);
+    ASSERT_EQ(read_data.size(), nb * rows.row_size_);
+    for (int64_t i = 0; i < nb; i++) {
+        ASSERT_EQ(memcmp(read_data.data() + i * rows.row_size_, rows.rows_[i], rows.row_size_), 0);
+    }
+}
+
 TEST(WalTest, MANAGER_SAME_NAME_COLLECTION) {
     MakeEmptyTestPath();
 
@@ -32,6 +32,8 @@ TEST(MetricbaseTest, METRICBASE_TEST) {
     instance.FaissDiskLoadSizeBytesHistogramObserve(1.0);
     instance.FaissDiskLoadIOSpeedGaugeSet(1.0);
     instance.CacheAccessTotalIncrement();
+    instance.SearchResultCacheHitTotalIncrement();
+    instance.SearchResultCacheMissTotalIncrement();
     instance.MemTableMergeDurationSecondsHistogramObserve(1.0);
     instance.SearchIndexDataDurationSecondsHistogramObserve(1.0);
     instance.SearchRawDataDurationSecondsHistogramObserve(1.0);
@@ -167,6 +167,7 @@ TEST_F(ConfigTest, SERVER_CONFIG_VALID_TEST) {
     std::string str_val;
     int64_t int64_val;
     float float_val;
+    double double_val;
     bool bool_val;
 
     /* server config */
@@ -216,6 +217,17 @@ TEST_F(ConfigTest, SERVER_CONFIG_VALID_TEST) {
     ASSERT_TRUE(config.GetStorageConfigAutoFlushInterval(int64_val).ok());
     ASSERT_TRUE(int64_val == db_auto_flush_interval);
 
+    int64_t db_auto_compact_interval = 30;
+    ASSERT_TRUE(config.SetStorageConfigAutoCompactInterval(std::to_string(db_auto_compact_interval)).ok());
+    ASSERT_TRUE(config.GetStorageConfigAutoCompactInterval(int64_val).ok());
+    ASSERT_TRUE(int64_val == db_auto_compact_interval);
+
+    double db_auto_compact_threshold = 0.5;
+    ASSERT_TRUE(config.SetStorageConfigAutoCompactThreshold(std::to_string(db_auto_compact_threshold)).ok());
+    ASSERT_TRUE(config.GetStorageConfigAutoCompactThreshold(double_val).ok());
+    ASSERT_TRUE(double_val == db_auto_compact_threshold);
+    ASSERT_FALSE(config.SetStorageConfigAutoCompactThreshold("1.5").ok());
+
     /* storage config */
     std::string storage_primary_path = "/home/zilliz";
     ASSERT_TRUE(config.SetStorageConfigPath(storage_primary_path).ok());
@@ -284,6 +296,21 @@ TEST_F(ConfigTest, SERVER_CONFIG_VALID_TEST) {
     ASSERT_TRUE(config.GetCacheConfigInsertBufferSize(int64_val).ok());
     ASSERT_TRUE(int64_val == cache_insert_buffer_size);
 
+    int64_t cache_build_index_buffer_size = 0;
+    ASSERT_TRUE(config.SetCacheConfigBuildIndexBufferSize(std::to_string(cache_build_index_buffer_size)).ok());
+    ASSERT_TRUE(config.GetCacheConfigBuildIndexBufferSize(int64_val).ok());
+    ASSERT_TRUE(int64_val == cache_build_index_buffer_size);
+    ASSERT_TRUE(config.SetCacheConfigBuildIndexBufferSize("256MB").ok());
+    ASSERT_TRUE(config.GetCacheConfigBuildIndexBufferSize(int64_val).ok());
+    ASSERT_TRUE(int64_val == 256 * 1024 * 1024);
+
+    ASSERT_TRUE(config.SetCacheConfigSearchResultCacheSize("0").ok());
+    ASSERT_TRUE(config.GetCacheConfigSearchResultCacheSize(int64_val).ok());
+    ASSERT_TRUE(int64_val == 0);
+    ASSERT_TRUE(config.SetCacheConfigSearchResultCacheSize("64MB").ok());
+    ASSERT_TRUE(config.GetCacheConfigSearchResultCacheSize(int64_val).ok());
+    ASSERT_TRUE(int64_val == 64 * 1024 * 1024);
+
     bool cache_insert_data = true;
     ASSERT_TRUE(config.SetCacheConfigCacheInsertData(std::to_string(cache_insert_data)).ok());
     ASSERT_TRUE(config.GetCacheConfigCacheInsertData(bool_val).ok());
@@ -329,6 +356,11 @@ TEST_F(ConfigTest, SERVER_CONFIG_VALID_TEST) {
     ASSERT_TRUE(config.GetEngineConfigSimdType(str_val).ok());
     ASSERT_TRUE(str_val == engine_simd_type);
 
+    bool engine_segment_pruning = true;
+    ASSERT_TRUE(config.SetEngineConfigSegmentPruning(std::to_string(engine_segment_pruning)).ok());
+    ASSERT_TRUE(config.GetEngineConfigSegmentPruning(bool_val).ok());
+    ASSERT_TRUE(bool_val == engine_segment_pruning);
+
 #ifdef MILVUS_GPU_VERSION
     int64_t engine_gpu_search_threshold = 800;
     auto status = config.SetGpuResourceConfigGpuSearchThreshold(std::to_string(engine_gpu_search_threshold));
@@ -725,6 +757,14 @@ TEST_F(ConfigTest, SERVER_CONFIG_INVALID_TEST) {
     ASSERT_FALSE(config.SetCacheConfigInsertBufferSize("2048GB").ok());
     ASSERT_FALSE(config.SetCacheConfigInsertBufferSize("-1").ok());
 
+    ASSERT_FALSE(config.SetCacheConfigBuildIndexBufferSize("a").ok());
+    ASSERT_FALSE(config.SetCacheConfigBuildIndexBufferSize("2048GB").ok());
+    ASSERT_FALSE(config.SetCacheConfigBuildIndexBufferSize("-1").ok());
+
+    ASSERT_FALSE(config.SetCacheConfigSearchResultCacheSize("a").ok());
+    ASSERT_FALSE(config.SetCacheConfigSearchResultCacheSize("2048GB").ok());
+    ASSERT_FALSE(config.SetCacheConfigSearchResultCacheSize("-1").ok());
+
     ASSERT_FALSE(config.SetCacheConfigCacheInsertData("N").ok());
 
     /* engine config */
@@ -736,6 +776,8 @@ TEST_F(ConfigTest, SERVER_CONFIG_INVALID_TEST) {
 
     ASSERT_FALSE(config.SetEngineConfigSimdType("None").ok());
 
+    ASSERT_FALSE(config.SetEngineConfigSegmentPruning("N").ok());
+
 #ifdef MILVUS_GPU_VERSION
     ASSERT_FALSE(config.SetGpuResourceConfigGpuSearchThreshold("-1").ok());
 #endif
@@ -891,6 +933,11 @@ TEST_F(ConfigTest, SERVER_CONFIG_VALID_FAIL_TEST) {
     ASSERT_FALSE(s.ok());
     fiu_disable("check_config_simd_type_fail");
 
+    fiu_enable("check_config_segment_pruning_fail", 1, NULL, 0);
+    s = config.ValidateConfig();
+    ASSERT_FALSE(s.ok());
+    fiu_disable("check_config_segment_pruning_fail");
+
 #ifdef MILVUS_GPU_VERSION
     fiu_enable("check_config_gpu_search_threshold_fail", 1, NULL, 0);
     s = config.ValidateConfig();
@@ -16,16 +16,25 @@
 #include "utils/CommonUtil.h"
 #include "utils/Error.h"
 #include "utils/Exception.h"
+#include "utils/Log.h"
 #include "utils/LogUtil.h"
 #include "utils/SignalHandler.h"
 #include "utils/StringHelpFunctions.h"
+#include "utils/TaskExecutor.h"
 #include "utils/TimeRecorder.h"
-#include "utils/ThreadPool.h"
 
 #include <gtest/gtest.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <boost/filesystem.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <mutex>
+#include <queue>
 #include <thread>
 
 #include <fiu-local.h>
@@ -40,6 +49,100 @@ CopyStatus(milvus::Status& st1, milvus::Status& st2) {
     st1 = st2;
 }
 
+// the single-queue pool TaskExecutor replaced, kept as the baseline of the throughput test
+class LegacyThreadPool {
+ public:
+    LegacyThreadPool(size_t threads, size_t queue_size) : max_queue_size_(queue_size) {
+        for (size_t i = 0; i < threads; ++i) {
+            workers_.emplace_back([this] {
+                for (;;) {
+                    std::function<void()> task;
+                    {
+                        std::unique_lock<std::mutex> lock(queue_mutex_);
+                        condition_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+                        if (stop_ && tasks_.empty()) {
+                            return;
+                        }
+                        task = std::move(tasks_.front());
+                        tasks_.pop();
+                    }
+                    condition_.notify_all();
+                    task();
+                }
+            });
+        }
+    }
+
+    ~LegacyThreadPool() {
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            stop_ = true;
+        }
+        condition_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    template <class F>
+    std::future<void>
+    Enqueue(F&& f) {
+        auto task = std::make_shared<std::packaged_task<void()>>(std::forward<F>(f));
+        auto res = task->get_future();
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            condition_.wait(lock, [this] { return tasks_.size() < max_queue_size_; });
+            tasks_.emplace([task]() { (*task)(); });
+        }
+        condition_.notify_all();
+        return res;
+    }
+
+ private:
+    std::vector<std::thread> workers_;
+    std::queue<std::function<void()>> tasks_;
+    size_t max_queue_size_;
+    std::mutex queue_mutex_;
+    std::condition_variable condition_;
+    bool stop_ = false;
+};
+
+// tasks/s of task_num tasks submitted from outside the pool, and of as many tasks fanned out by the workers
+template <typename Pool>
+void
+MeasureThroughput(Pool& pool, int64_t task_num, double& external_rate, double& nested_rate) {
+    std::atomic<int64_t> done(0);
+    milvus::TimeRecorder rc("task throughput");
+    std::vector<std::future<void>> futures;
+    futures.reserve(task_num);
+    for (int64_t i = 0; i < task_num; ++i) {
+        futures.emplace_back(pool.Enqueue([&done]() { ++done; }));
+    }
+    for (auto& future : futures) {
+        future.get();
+    }
+    external_rate = task_num / (rc.ElapseFromBegin("external") / 1000000);
+    ASSERT_EQ(done.load(), task_num);
+
+    const int64_t fan_out = 100;
+    rc.RecordSection("");
+    std::vector<std::future<void>> parents;
+    for (int64_t i = 0; i < task_num / fan_out; ++i) {
+        parents.emplace_back(pool.Enqueue([&pool, &done, fan_out]() {
+            for (int64_t j = 0; j < fan_out; ++j) {
+                pool.Enqueue([&done]() { ++done; });
+            }
+        }));
+    }
+    for (auto& parent : parents) {
+        parent.get();
+    }
+    while (done.load() < 2 * task_num) {
+        std::this_thread::yield();
+    }
+    nested_rate = task_num / (rc.RecordSection("nested") / 1000000);
+}
+
 }  // namespace
 
 TEST(UtilTest, EXCEPTION_TEST) {
@@ -296,6 +399,55 @@ TEST(UtilTest, LOG_TEST) {
     boost::filesystem::remove("/tmp/config.yaml");
 }
 
+TEST(UtilTest, LOG_OVERHEAD_TEST) {
+    using milvus::GetThreadName;
+    using milvus::LogOut;
+
+    // the lines a search writes in the engine, scheduler and cache
+    auto search = [](int64_t nq) {
+        for (int i = 0; i < 8; ++i) {
+            LOG_ENGINE_DEBUG_ << "Search nq " << nq << ", step " << i;
+        }
+    };
+    const int64_t rounds = 20000;
+
+    auto status = milvus::InitLog(true, false, true, true, true, true, "/tmp/test_util", 1024 * 1024 * 1024, 10);
+    ASSERT_TRUE(status.ok()) << status.message();
+    ASSERT_FALSE(milvus::LogLevelEnabled(el::Level::Debug));
+    ASSERT_TRUE(milvus::LogLevelEnabled(el::Level::Info));
+
+    // a disabled level must not format the prefix
+    int64_t formatted = 0;
+    auto count_format = [&]() {
+        ++formatted;
+        return "";
+    };
+    LOG_ENGINE_DEBUG_ << count_format();
+    ASSERT_EQ(formatted, 0);
+    LOG_ENGINE_INFO_ << count_format();
+    ASSERT_EQ(formatted, 1);
+
+    auto time_searches = [&](const std::string& name) {
+        auto start = std::chrono::steady_clock::now();
+        for (int64_t i = 0; i < rounds; ++i) {
+            search(i);
+        }
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        std::cout << name << ": " << ns.count() / rounds << " ns logging per search" << std::endl;
+    };
+    time_searches("debug disabled");
+
+    status = milvus::InitLog(true, true, true, true, true, true, "/tmp/test_util", 1024 * 1024 * 1024, 10);
+    ASSERT_TRUE(status.ok()) << status.message();
+    time_searches("debug enabled, sync");
+
+    milvus::StartAsyncLog();
+    time_searches("debug enabled, async");
+    milvus::FlushAsyncLog();
+    milvus::StopAsyncLog();
+    LOG_ENGINE_DEBUG_ << "back to sync logging";
+}
+
 TEST(UtilTest, TIMERECORDER_TEST) {
     for (int64_t log_level = 0; log_level <= 6; log_level++) {
         if (log_level == 5) {
@@ -849,23 +1001,134 @@ TEST(UtilTest, ROLLOUTHANDLER_TEST) {
     boost::filesystem::remove_all(dir2);
 }
 
-TEST(UtilTest, THREADPOOL_TEST) {
-    auto thread_pool_ptr = std::make_unique<milvus::ThreadPool>(3);
+TEST(UtilTest, TASK_EXECUTOR_TEST) {
+    auto executor_ptr = std::make_unique<milvus::TaskExecutor>(3);
     auto fun = [](int i) {
         std::this_thread::sleep_for(std::chrono::milliseconds(50));
     };
     for (int i = 0; i < 10; ++i) {
-        thread_pool_ptr->enqueue(fun, i);
+        executor_ptr->Enqueue(fun, i);
     }
 
     fiu_init(0);
-    fiu_enable("ThreadPool.enqueue.stop_is_true", 1, NULL, 0);
+    fiu_enable("TaskExecutor.enqueue.stop_is_true", 1, NULL, 0);
     try {
-        thread_pool_ptr->enqueue(fun, -1);
+        executor_ptr->Enqueue(fun, -1);
     } catch (std::exception& err) {
         std::cout << "catch an error here" << std::endl;
     }
-    fiu_disable("ThreadPool.enqueue.stop_is_true");
+    fiu_disable("TaskExecutor.enqueue.stop_is_true");
+
+    executor_ptr.reset();
+}
+
+TEST(UtilTest, TASK_EXECUTOR_PRIORITY_TEST) {
+    milvus::TaskExecutor executor(1);
+
+    // hold the only worker until every task is queued
+    std::promise<void> started, gate;
+    auto gate_future = gate.get_future().share();
+    auto blocker = executor.Enqueue([&started, gate_future]() {
+        started.set_value();
+        gate_future.wait();
+    });
+    started.get_future().wait();
+
+    std::mutex mutex;
+    std::vector<std::string> order;
+    auto record = [&](const std::string& name) {
+        std::lock_guard<std::mutex> lock(mutex);
+        order.push_back(name);
+    };
+    auto build = executor.Enqueue(record, "build");
+    auto search = executor.EnqueueWithPriority(milvus::TaskPriority::HIGH, record, "search");
+    ASSERT_EQ(executor.Pending(), 2);
+    gate.set_value();
+    build.get();
+    search.get();
+    ASSERT_EQ(order, std::vector<std::string>({"search", "build"}));
+
+    // a worker enqueues past the queue size without waiting for itself
+    milvus::TaskExecutor small(1, 1);
+    auto nested = small.Enqueue([&small]() {
+        std::vector<std::future<int>> futures;
+        for (int i = 0; i < 10; ++i) {
+            futures.emplace_back(small.Enqueue([i]() { return i; }));
+        }
+        return futures.size();
+    });
+    ASSERT_EQ(nested.get(), 10);
 
-    thread_pool_ptr.reset();
+    auto failed = executor.Enqueue([]() { throw std::runtime_error("task error"); });
+    ASSERT_ANY_THROW(failed.get());
+}
+
+TEST(UtilTest, TASK_EXECUTOR_THROUGHPUT_TEST) {
+    const int64_t task_num = 200000;
+    std::vector<size_t> thread_nums = {1, 4, std::max<size_t>(std::thread::hardware_concurrency(), 1)};
+    for (auto thread_num : thread_nums) {
+        // both queues hold every task, so a worker fanning out never waits for room
+        double pool_external = 0, pool_nested = 0;
+        {
+            LegacyThreadPool pool(thread_num, 2 * task_num);
+            MeasureThroughput(pool, task_num, pool_external, pool_nested);
+        }
+        double executor_external = 0, executor_nested = 0;
+        {
+            milvus::TaskExecutor executor(thread_num, 2 * task_num);
+            MeasureThroughput(executor, task_num, executor_external, executor_nested);
+        }
+
+        std::cout << thread_num << " threads, external tasks/s: ThreadPool " << static_cast<int64_t>(pool_external)
+                  << ", TaskExecutor " << static_cast<int64_t>(executor_external)
+                  << "; nested tasks/s: ThreadPool " << static_cast<int64_t>(pool_nested) << ", TaskExecutor "
+                  << static_cast<int64_t>(executor_nested) << std::endl;
+    }
+}
+
+TEST(UtilTest, TASK_EXECUTOR_STEAL_TEST) {
+    const int64_t task_num = 20000;
+    const int64_t producer_num = 4;
+    const int64_t fan_out = 100;
+    std::vector<size_t> thread_nums = {1, 4, std::max<size_t>(std::thread::hardware_concurrency(), 1)};
+    for (auto thread_num : thread_nums) {
+        std::atomic<int64_t> done(0);
+        {
+            // a queue this small keeps the producers waiting for room while the workers steal
+            milvus::TaskExecutor executor(thread_num, 4);
+
+            std::vector<std::thread> producers;
+            for (int64_t p = 0; p < producer_num; ++p) {
+                producers.emplace_back([&executor, &done, task_num]() {
+                    std::vector<std::future<void>> futures;
+                    for (int64_t i = 0; i < task_num; ++i) {
+                        futures.emplace_back(executor.Enqueue([&done]() { ++done; }));
+                    }
+                    for (auto& future : futures) {
+                        future.get();
+                    }
+                });
+            }
+            for (auto& producer : producers) {
+                producer.join();
+            }
+            ASSERT_EQ(done.load(), producer_num * task_num);
+
+            // tasks fanned out by the workers, spread by stealing
+            std::vector<std::future<void>> parents;
+            for (int64_t i = 0; i < task_num / fan_out; ++i) {
+                parents.emplace_back(executor.Enqueue([&executor, &done, fan_out]() {
+                    for (int64_t j = 0; j < fan_out; ++j) {
+                        executor.Enqueue([&done]() { ++done; });
+                    }
+                }));
+            }
+            for (auto& parent : parents) {
+                parent.get();
+            }
+        }
+
+        // the executor runs every queued task before it stops
+        ASSERT_EQ(done.load(), (producer_num + 1) * task_num);
+    }
 }
@@ -13,18 +13,19 @@
 #include <gtest/gtest.h>
 #include <fstream>
 #include <memory>
+#include <string>
+#include <vector>
 #include <fiu-local.h>
 #include <fiu-control.h>
 
 #include "config/Config.h"
 #include "easyloggingpp/easylogging++.h"
 #include "storage/s3/S3ClientWrapper.h"
+#include "storage/s3/S3DiskCache.h"
 #include "storage/s3/S3IOReader.h"
 #include "storage/s3/S3IOWriter.h"
 #include "storage/utils.h"
 
-INITIALIZE_EASYLOGGINGPP
-
 TEST_F(StorageTest, S3_CLIENT_TEST) {
     fiu_init(0);
 
@@ -199,3 +200,183 @@ TEST_F(StorageTest, S3_FAIL_TEST) {
 
     storage_inst.StopService();
 }
+
+TEST_F(StorageTest, S3_MULTIPART_TEST) {
+    fiu_init(0);
+
+    const std::string index_name = "/tmp/test_index_multipart";
+
+    auto& storage_inst = milvus::storage::S3ClientWrapper::GetInstance();
+    fiu_enable("S3ClientWrapper.StartService.mock_enable", 1, NULL, 0);
+    ASSERT_TRUE(storage_inst.StartService().ok());
+    auto disk_cache = milvus::storage::S3DiskCache::GetInstance();
+
+    // two and a half parts, written in odd sized chunks
+    int64_t size = milvus::storage::S3_PART_SIZE * 5 / 2;
+    std::string content(size, 0);
+    for (int64_t i = 0; i < size; ++i) {
+        content[i] = static_cast<char>(i * 31 % 251);
+    }
+
+    {
+        milvus::storage::S3IOWriter writer;
+        writer.open(index_name);
+        for (int64_t pos = 0; pos < size; pos += 1000003) {
+            writer.write((void*)(content.data() + pos), std::min<int64_t>(1000003, size - pos));
+        }
+        ASSERT_EQ(writer.length(), size);
+        writer.close();
+        ASSERT_FALSE(writer.upload_id_.empty());
+        ASSERT_EQ(writer.etags_.size(), 3);
+    }
+
+    std::string content_out;
+    ASSERT_TRUE(storage_inst.GetObjectStr(index_name, content_out).ok());
+    ASSERT_TRUE(content_out == content);
+
+    /* one chunk larger than a part is cut into parts */
+    {
+        milvus::storage::S3IOWriter writer;
+        writer.open(index_name);
+        writer.write((void*)(content.data()), size);
+        ASSERT_EQ(static_cast<int64_t>(writer.buffer_.size()), size - 2 * milvus::storage::S3_PART_SIZE);
+        writer.close();
+        ASSERT_EQ(writer.etags_.size(), 3);
+    }
+    ASSERT_TRUE(storage_inst.GetObjectStr(index_name, content_out).ok());
+    ASSERT_TRUE(content_out == content);
+
+    int64_t object_size = 0;
+    ASSERT_TRUE(storage_inst.HeadObject(index_name, object_size).ok());
+    ASSERT_EQ(object_size, size);
+
+    /* ranged reads inside one part and across parts */
+    {
+        std::vector<std::pair<int64_t, int64_t>> ranges = {
+            {0, 100}, {milvus::storage::S3_PART_SIZE - 10, 20}, {1, size - 2}, {size - 5, 5}};
+        for (auto& range : ranges) {
+            std::string buffer(range.second, 0);
+            ASSERT_TRUE(storage_inst.GetObjectRange(index_name, range.first, range.second, &buffer[0]).ok());
+            ASSERT_TRUE(buffer == content.substr(range.first, range.second));
+        }
+
+        std::string buffer(10, 0);
+        fiu_enable("S3ClientWrapper.GetPart.outcome.fail", 1, NULL, 0);
+        ASSERT_FALSE(storage_inst.GetObjectRange(index_name, 0, 10, &buffer[0]).ok());
+        fiu_disable("S3ClientWrapper.GetPart.outcome.fail");
+    }
+
+    /* the reader goes through the disk cache */
+    {
+        milvus::storage::S3IOReader reader;
+        ASSERT_TRUE(reader.open(index_name));
+        ASSERT_NE(reader.cache_file_, nullptr);
+        ASSERT_EQ(reader.length(), size);
+
+        std::string buffer(1000, 0);
+        reader.seekg(milvus::storage::S3_PART_SIZE - 500);
+        reader.read(&buffer[0], 1000);
+        ASSERT_TRUE(buffer == content.substr(milvus::storage::S3_PART_SIZE - 500, 1000));
+        reader.read(&buffer[0], 1000);
+        ASSERT_TRUE(buffer == content.substr(milvus::storage::S3_PART_SIZE + 500, 1000));
+        reader.close();
+    }
+    ASSERT_TRUE(disk_cache->ItemExists(index_name));
+
+    /* a failed part aborts the upload, the old object stays */
+    {
+        fiu_enable("S3ClientWrapper.UploadPart.outcome.fail", 1, NULL, 0);
+        milvus::storage::S3IOWriter writer;
+        writer.open(index_name);
+        writer.write((void*)(content.data()), size);
+        writer.close();
+        fiu_disable("S3ClientWrapper.UploadPart.outcome.fail");
+
+        ASSERT_FALSE(disk_cache->ItemExists(index_name));
+        ASSERT_TRUE(storage_inst.GetObjectStr(index_name, content_out).ok());
+        ASSERT_TRUE(content_out == content);
+    }
+
+    /* without multipart the object is put whole */
+    {
+        fiu_enable("S3ClientWrapper.CreateMultipartUpload.outcome.fail", 1, NULL, 0);
+        milvus::storage::S3IOWriter writer;
+        writer.open(index_name);
+        writer.write((void*)(content.data() + 1), size - 1);
+        writer.close();
+        fiu_disable("S3ClientWrapper.CreateMultipartUpload.outcome.fail");
+
+        ASSERT_TRUE(writer.upload_id_.empty());
+        ASSERT_TRUE(storage_inst.GetObjectStr(index_name, content_out).ok());
+        ASSERT_TRUE(content_out == content.substr(1));
+    }
+
+    ASSERT_TRUE(storage_inst.DeleteObject(index_name).ok());
+    storage_inst.StopService();
+}
+
+TEST_F(StorageTest, S3_DISK_CACHE_TEST) {
+    fiu_init(0);
+
+    auto& storage_inst = milvus::storage::S3ClientWrapper::GetInstance();
+    fiu_enable("S3ClientWrapper.StartService.mock_enable", 1, NULL, 0);
+    ASSERT_TRUE(storage_inst.StartService().ok());
+
+    auto disk_cache = milvus::storage::S3DiskCache::GetInstance();
+    ASSERT_TRUE(disk_cache->Enabled());
+    int64_t capacity = disk_cache->CacheCapacity();
+    disk_cache->SetCapacity(2500);
+
+    const std::string content(1000, 'a');
+    std::vector<std::string> names = {"/tmp/test_cache_0", "/tmp/test_cache_1", "/tmp/test_cache_2"};
+    for (auto& name : names) {
+        ASSERT_TRUE(storage_inst.PutObjectStr(name, content).ok());
+    }
+
+    milvus::storage::S3CacheFilePtr first;
+    ASSERT_TRUE(disk_cache->Fetch(names[0], first).ok());
+    ASSERT_TRUE(std::ifstream(first->path()).good());
+
+    milvus::storage::S3CacheFilePtr file;
+    ASSERT_TRUE(disk_cache->Fetch(names[0], file).ok());
+    ASSERT_EQ(file, first);
+
+    // the third object evicts the least recently used one, its file goes with the last reference
+    ASSERT_TRUE(disk_cache->Fetch(names[1], file).ok());
+    ASSERT_TRUE(disk_cache->Fetch(names[2], file).ok());
+    ASSERT_FALSE(disk_cache->ItemExists(names[0]));
+    ASSERT_TRUE(disk_cache->ItemExists(names[2]));
+    std::string path = first->path();
+    ASSERT_TRUE(std::ifstream(path).good());
+    first = nullptr;
+    ASSERT_FALSE(std::ifstream(path).good());
+
+    // larger than the whole cache, read from S3 directly
+    ASSERT_TRUE(storage_inst.PutObjectStr(names[0], std::string(3000, 'b')).ok());
+    ASSERT_FALSE(disk_cache->Fetch(names[0], file).ok());
+    {
+        milvus::storage::S3IOReader reader;
+        ASSERT_TRUE(reader.open(names[0]));
+        ASSERT_EQ(reader.cache_file_, nullptr);
+        std::string buffer(3000, 0);
+        reader.read(&buffer[0], 3000);
+        ASSERT_TRUE(buffer == std::string(3000, 'b'));
+
+        reader.seekg(0);
+        fiu_enable("S3ClientWrapper.GetPart.outcome.fail", 1, NULL, 0);
+        ASSERT_ANY_THROW(reader.read(&buffer[0], 3000));
+        fiu_disable("S3ClientWrapper.GetPart.outcome.fail");
+        reader.close();
+    }
+
+    disk_cache->EraseItem(names[1]);
+    fiu_enable("S3DiskCache.Download.open.fail", 1, NULL, 0);
+    ASSERT_FALSE(disk_cache->Fetch(names[1], file).ok());
+    fiu_disable("S3DiskCache.Download.open.fail");
+
+    for (auto& name : names) {
+        ASSERT_TRUE(storage_inst.DeleteObject(name).ok());
+    }
+    disk_cache->SetCapacity(capacity);
+    storage_inst.StopService();
+}